@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Sliding-window transmit duty-cycle budget
+ *
+ * Tracks airtime in SLOTS + 1 time slots covering the last `windowMs`, so
+ * the sum always includes every transmission of the last full window
+ * (errs on the safe side by up to one slot). EU868 sub-band 868.0-868.6
+ * MHz allows 1 % - 36 s of airtime in any hour.
+ *
+ * Time is millis(): across the 49-day wrap the older slots are forgotten
+ * early, once.
+ */
+class AirtimeBudget {
+public:
+  static constexpr size_t SLOTS = 60;
+  static constexpr uint32_t NEVER = UINT32_MAX;
+
+  AirtimeBudget(uint32_t windowMs, uint32_t budgetUs)
+    : slotMs(windowMs / SLOTS), budgetUs(budgetUs) {
+    for (size_t i = 0; i < SLOTS + 1; i++) {
+      slots[i].epoch = 0;
+      slots[i].airtimeUs = 0;
+    }
+  }
+
+  uint32_t getBudgetUs() const { return budgetUs; }
+
+  // Airtime spent within the window ending at nowMs
+  uint32_t usedUs(uint32_t nowMs) const {
+    uint32_t current = nowMs / slotMs;
+    uint32_t used = 0;
+    for (size_t i = 0; i < SLOTS + 1; i++) {
+      if (live(slots[i], current)) used += slots[i].airtimeUs;
+    }
+    return used;
+  }
+
+  bool canSend(uint32_t nowMs, uint32_t airtimeUs) const {
+    return usedUs(nowMs) + (uint64_t)airtimeUs <= budgetUs;
+  }
+
+  void record(uint32_t nowMs, uint32_t airtimeUs) {
+    uint32_t current = nowMs / slotMs;
+    Slot& slot = slots[current % (SLOTS + 1)];
+    if (slot.epoch != current) {
+      slot.epoch = current;
+      slot.airtimeUs = 0;
+    }
+    slot.airtimeUs += airtimeUs;
+  }
+
+  // Wait until a packet of airtimeUs fits (0 = now, NEVER = larger than the budget)
+  uint32_t msUntilAvailable(uint32_t nowMs, uint32_t airtimeUs) const {
+    if (airtimeUs > budgetUs) return NEVER;
+    uint32_t current = nowMs / slotMs;
+    uint64_t used = usedUs(nowMs);
+    if (used + airtimeUs <= budgetUs) return 0;
+
+    // Expire slots oldest first until enough airtime is freed
+    for (uint32_t age = SLOTS; ; age--) {
+      const Slot& slot = slots[(current - age) % (SLOTS + 1)];
+      if (live(slot, current) && slot.epoch == current - age) {
+        used -= slot.airtimeUs;
+        if (used + airtimeUs <= budgetUs) {
+          // Slot `epoch` leaves the window when slot epoch + SLOTS + 1 begins
+          return (slot.epoch + SLOTS + 1) * slotMs - nowMs;
+        }
+      }
+      if (age == 0) break;
+    }
+    return NEVER;  // Unreachable: the current slot alone is within budget
+  }
+
+private:
+  struct Slot {
+    uint32_t epoch;      // nowMs / slotMs when the slot was last written
+    uint32_t airtimeUs;
+  };
+
+  static bool live(const Slot& slot, uint32_t current) {
+    return slot.airtimeUs > 0 && current - slot.epoch <= SLOTS;
+  }
+
+  Slot slots[SLOTS + 1];
+  uint32_t slotMs;
+  uint32_t budgetUs;
+};
@@ -2,13 +2,17 @@
 
 #include "common.h"
 #include "ITimerDevice.h"
+#include "LoRaDataRate.h"
 #include "LoRaTransmitter.h"
 #include "LoRaReceiver.h"
+#include "LoRaSourceTable.h"
 #include "SpecialPieBleServer.h"
 #include "BridgeOledDisplay.h"
 #include "BridgeWiFiConfig.h"
 #include "MqttManager.h"
 #include "Logger.h"
+#include "LoopScheduler.h"
+#include "ShotTrace.h"
 #include <memory>
 
 /**
@@ -18,7 +22,14 @@
  * and instantiates the correct component graph.
  *
  * Transmitter: ITimerDevice* → callbacks → LoRaTransmitter → SX1276 TX
- * Receiver:    SX1276 RX → LoRaReceiver → callbacks → MqttManager | SpecialPieBleServer
+ * Receiver:    SX1276 RX → LoRaReceiver → callbacks → LoRaSourceTable → MqttManager | SpecialPieBleServer
+ *
+ * A receiver serves any number of transmitters (LORA_MAX_SOURCES tracked):
+ * MQTT events are published under each transmitter's own timer/<sourceId>/
+ * topics, and repeated shots are filtered per source.
+ *
+ * With LORA_ADAPTIVE_RATE the receiver also picks the link's data rate
+ * (LoRaRateController) from the signal each source arrives with.
  */
 class BridgeApplication {
 public:
@@ -46,6 +57,11 @@ private:
 
   // ─── Receiver components ───
   LoRaReceiver loraRx;
+  LoRaSourceTable<LORA_MAX_SOURCES> loraSources;
+  LoRaSource* packetSource = nullptr;  // Set by onLoRaPacket() for the handlers
+#if LORA_ADAPTIVE_RATE
+  LoRaRateController rateController;
+#endif
   std::unique_ptr<MqttManager> mqttManager;
   SpecialPieBleServer bleServer;
 
@@ -53,8 +69,15 @@ private:
   OledDisplay oled;
   BridgeStatus bridgeStatus;
 
+  // Main loop wake-ups (LoRa DIO0, BLE callbacks, deadlines)
+  LoopScheduler scheduler;
+
   // Health
   unsigned long lastActivityTime = 0;
+  unsigned long lastLoopStatsLog = 0;
+  uint32_t lastReportedTraceSamples = 0;
+  uint32_t lastReportedRxOverruns = 0;
+  uint32_t lastReportedTxLosses = 0;
 
   // ─── Transmitter helpers ───
   void initTransmitter();
@@ -76,6 +99,18 @@ private:
   void initReceiver();
   void runReceiver();
   void setupLoRaCallbacks();
+  bool onLoRaPacket(LoRaProtocol::ParsedPacket& pkt);  // Every packet, before its handler
+  void resolveSource(LoRaProtocol::ParsedPacket& pkt);
+  LoRaSource& touchSource(const LoRaProtocol::ParsedPacket& pkt);
+#if LORA_RELIABLE
+  void sendDueAcks();
+#endif
+#if LORA_ADAPTIVE_RATE
+  void adaptDataRate();
+#endif
+  void expireSources();
+  void publishSourceOffline(const LoRaSource& source);  // Expired or evicted
+  void logSources();
 
   // LoRa event handlers (Receiver)
   void onLoRaShotReceived(const LoRaProtocol::ParsedPacket& pkt);
@@ -86,4 +121,5 @@ private:
   void onLoRaSessionResumed(const LoRaProtocol::ParsedPacket& pkt);
 
   void updateOledStatus();
+  void waitForNextEvent();
 };
@@ -4,6 +4,7 @@
 #include <Wire.h>
 #include <SSD1306Wire.h>
 #include "common.h"
+#include "LoRaDataRate.h"
 #include "Logger.h"
 
 /**
@@ -18,6 +19,10 @@ struct BridgeStatus {
   bool bleConnected = false;
   bool bleScanning = false;
   uint32_t shotsTx = 0;
+  uint8_t txQueueDepth = 0;        // Packets queued or on air
+  uint32_t txDrops = 0;            // Queue full / over budget
+  uint32_t airtimeUsedMs = 0;      // In the duty-cycle window
+  uint32_t airtimeBudgetMs = 0;
 
   // Receiver fields
   int lastRssi = 0;
@@ -28,8 +33,12 @@ struct BridgeStatus {
   bool hasLastShot = false;
   uint16_t lastShotNumber = 0;
   uint32_t lastShotTimeMs = 0;
+  uint8_t sourcesOnline = 0;       // LoRa transmitters heard recently
+  uint8_t sourcesKnown = 0;
+  uint32_t duplicates = 0;         // Shots received more than once, not republished
 
   // Common
+  LoRaDataRate dataRate = {0, 0};  // Current link rate; spreadingFactor 0 = not known yet
   bool wifiConnected = false;
   uint32_t uptimeMs = 0;
 };
@@ -59,5 +68,6 @@ private:
   void drawTransmitterView(const BridgeStatus& status);
   void drawReceiverView(const BridgeStatus& status);
   void drawCommonFooter(const BridgeStatus& status);
+  void drawDataRate(int16_t y, const LoRaDataRate& rate);
   bool statusChanged(const BridgeStatus& a, const BridgeStatus& b) const;
 };
@@ -49,6 +49,7 @@ public:
   static bool isInitialized();
   static void update();
   static bool isConnected();
+  static bool isPortalActive();
   static String getLocalIP();
   static void startConfigPortal();
   static void resetSettings();
@@ -76,6 +77,7 @@ public:
   static bool isInitialized()   { return BridgeWiFiConfig::isInitialized(); }
   static void update()          { BridgeWiFiConfig::update(); }
   static bool isConnected()     { return BridgeWiFiConfig::isConnected(); }
+  static bool isPortalActive()  { return BridgeWiFiConfig::isPortalActive(); }
   static String getLocalIP()    { return BridgeWiFiConfig::getLocalIP(); }
 
   static const char* getMqttServer()   { return BridgeWiFiConfig::getMqttServer(); }
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "LoRaTxQueue.h"
+#include <cstddef>
+#include <cstdint>
+
+// Selective-repeat ARQ for the reliable LoRa link (LORA_RELIABLE). The
+// transmitter numbers shot and session packets per source; the receiver
+// tracks them in a LoRaRxWindow and answers with ACK packets; the
+// transmitter resends from its LoRaTxHistory what was NACKed or not
+// acknowledged in time. Sequence numbers are 16-bit and wrap.
+
+namespace LoRaArq {
+
+// Bits in an ACK's selective mask
+static constexpr uint16_t WINDOW = 32;
+
+// a - b in sequence space (negative: a is older)
+inline int16_t seqDiff(uint16_t a, uint16_t b) {
+  return (int16_t)(uint16_t)(a - b);
+}
+
+}  // namespace LoRaArq
+
+/**
+ * @brief Receiver-side record of one transmitter's sequence numbers
+ *
+ * `base` is the oldest sequence number not yet received; mask bit i set
+ * means base + 1 + i was received. These are exactly the fields of the
+ * ACK packet.
+ *
+ * A transmitter flags its packets SYNC until its first ACK (e.g. after a
+ * reboot, when it starts from a random sequence number). A SYNC packet
+ * restarts the window unless it lies within WINDOW after the sequence
+ * number the window was last restarted at - so a resent SYNC packet is
+ * still recognised as a duplicate.
+ */
+struct LoRaRxWindow {
+  bool started;
+  uint16_t base;
+  uint32_t mask;
+  uint16_t startSeq;  // Where the window was last restarted
+
+  void reset() {
+    started = false;
+    base = 0;
+    mask = 0;
+    startSeq = 0;
+  }
+
+  /**
+   * Records `seq`. Besides SYNC, a packet more than WINDOW away from base
+   * restarts the window there (everything in between is past the
+   * transmitter's retry limit).
+   * @return true if seq is new, false for a duplicate
+   */
+  bool accept(uint16_t seq, bool sync) {
+    const int16_t window = (int16_t)LoRaArq::WINDOW;
+    int16_t ahead = LoRaArq::seqDiff(seq, base);
+    int16_t sinceStart = LoRaArq::seqDiff(seq, startSeq);
+    bool restart = !started
+                || ahead < -window || ahead > window
+                || (sync && (sinceStart < 0 || sinceStart > window));
+    if (restart) {
+      started = true;
+      base = seq;
+      mask = 0;
+      startSeq = seq;
+      ahead = 0;
+    }
+
+    if (ahead < 0) return false;  // Already below base
+    if (ahead > 0) {
+      uint32_t bit = 1u << (ahead - 1);
+      if (mask & bit) return false;
+      mask |= bit;
+      return true;
+    }
+
+    // seq == base: advance past it and everything contiguous after it
+    base++;
+    while (mask & 1) {
+      mask >>= 1;
+      base++;
+    }
+    mask >>= 1;
+    return true;
+  }
+};
+
+/**
+ * @brief Transmitter-side copies of sequenced packets awaiting an ACK
+ *
+ * Fixed depth, no heap. Main loop only (not thread-safe).
+ */
+template <size_t Depth>
+class LoRaTxHistory {
+public:
+  struct Entry {
+    TxPacket packet;       // As sent, sequence number included
+    uint16_t seq;
+    uint32_t sentAtMs;     // Last transmission
+    uint8_t transmissions;
+    bool nacked;           // A later packet was acknowledged, this one not
+  };
+
+  LoRaTxHistory(uint32_t timeoutMs, uint8_t maxTransmissions)
+    : timeoutMs(timeoutMs), maxTransmissions(maxTransmissions),
+      head(0), count(0), lost(0), retransmits(0) {}
+
+  // Records a packet just put on air. When full, the oldest is given up.
+  void sent(const TxPacket& packet, uint16_t seq, uint32_t nowMs) {
+    if (count == Depth) {
+      removeAt(0);
+      lost++;
+    }
+    Entry& entry = at(count++);
+    entry.packet = packet;
+    entry.seq = seq;
+    entry.sentAtMs = nowMs;
+    entry.transmissions = 1;
+    entry.nacked = false;
+  }
+
+  // Applies an ACK. @return packets newly confirmed
+  size_t acknowledge(uint16_t base, uint32_t mask) {
+    // Newest sequence number the receiver has
+    uint16_t newest = (uint16_t)(base - 1);
+    for (int bit = LoRaArq::WINDOW - 1; bit >= 0; bit--) {
+      if (mask & (1u << bit)) {
+        newest = (uint16_t)(base + 1 + bit);
+        break;
+      }
+    }
+
+    size_t confirmed = 0;
+    for (size_t i = 0; i < count; ) {
+      Entry& entry = at(i);
+      int16_t ahead = LoRaArq::seqDiff(entry.seq, base);
+      bool received = ahead < 0
+                   || (ahead > 0 && ahead <= (int16_t)LoRaArq::WINDOW && (mask & (1u << (ahead - 1))));
+      if (received) {
+        removeAt(i);
+        confirmed++;
+        continue;
+      }
+      if (LoRaArq::seqDiff(entry.seq, newest) < 0) entry.nacked = true;
+      i++;
+    }
+    return confirmed;
+  }
+
+  /**
+   * Next packet to resend: the oldest NACKed or unacknowledged for the
+   * timeout. Packets out of transmissions are given up first.
+   * @return nullptr if nothing is due
+   */
+  Entry* due(uint32_t nowMs) {
+    for (size_t i = 0; i < count; ) {
+      Entry& entry = at(i);
+      if (!expired(entry, nowMs)) {
+        i++;
+        continue;
+      }
+      if (entry.transmissions >= maxTransmissions) {
+        removeAt(i);
+        lost++;
+        continue;
+      }
+      return &entry;
+    }
+    return nullptr;
+  }
+
+  // The oldest entry due() would consider, without giving any up (for
+  // computing when to wake)
+  const Entry* peekDue(uint32_t nowMs) const {
+    for (size_t i = 0; i < count; i++) {
+      if (expired(at(i), nowMs)) return &at(i);
+    }
+    return nullptr;
+  }
+
+  // Call after putting a due() entry back on air
+  void resent(Entry& entry, uint32_t nowMs) {
+    entry.sentAtMs = nowMs;
+    entry.transmissions++;
+    entry.nacked = false;
+    retransmits++;
+  }
+
+  // Time until due() may return a packet (UINT32_MAX if none is waiting)
+  uint32_t msUntilDue(uint32_t nowMs) const {
+    uint32_t next = UINT32_MAX;
+    for (size_t i = 0; i < count; i++) {
+      const Entry& entry = at(i);
+      if (entry.nacked) return 0;
+      uint32_t elapsed = nowMs - entry.sentAtMs;
+      uint32_t left = elapsed >= timeoutMs ? 0 : timeoutMs - elapsed;
+      if (left < next) next = left;
+    }
+    return next;
+  }
+
+  // Applies to packets already waiting too (the data rate changed)
+  void setTimeoutMs(uint32_t ms) { timeoutMs = ms; }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  uint32_t getLost() const { return lost; }
+  uint32_t getRetransmits() const { return retransmits; }
+
+private:
+  bool expired(const Entry& entry, uint32_t nowMs) const {
+    return entry.nacked || nowMs - entry.sentAtMs >= timeoutMs;
+  }
+
+  Entry& at(size_t i) { return entries[(head + i) % Depth]; }
+  const Entry& at(size_t i) const { return entries[(head + i) % Depth]; }
+
+  // Keeps the remaining entries in send order
+  void removeAt(size_t i) {
+    for (size_t j = i; j > 0; j--) at(j) = at(j - 1);
+    head = (head + 1) % Depth;
+    count--;
+  }
+
+  Entry entries[Depth];
+  uint32_t timeoutMs;
+  uint8_t maxTransmissions;
+  size_t head;
+  size_t count;
+  uint32_t lost;
+  uint32_t retransmits;
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "LoRaFec.h"
+#include "LoRaPacket.h"
+#include "LoRaSourceTable.h"
+#include "common.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Spreading factor and bandwidth the link runs at
+ *
+ * Coding rate, preamble and sync word stay as configured in common.h.
+ */
+struct LoRaDataRate {
+  uint8_t spreadingFactor;
+  uint32_t bandwidthHz;
+};
+
+// Data rates for adaptive rate control (LORA_ADAPTIVE_RATE), fastest first.
+// Each step buys about 2.5 dB (one SF) or 3 dB (half the bandwidth) of
+// link budget for roughly twice the time on air.
+namespace LoRaRate {
+
+static constexpr LoRaDataRate TABLE[] = {
+  { 7, 500000},
+  { 8, 500000},
+  { 9, 250000},
+  {10, 250000},
+  {11, 125000},
+  {12, 125000},
+};
+static constexpr uint8_t COUNT = sizeof(TABLE) / sizeof(TABLE[0]);
+
+// SX1276 sensitivity at each rate in 0.1 dBm: -174 + 10log10(BW) + 6 dB
+// noise figure + the demodulator's SNR floor (-7.5 dB at SF7 down to -20 dB
+// at SF12)
+static constexpr int16_t SENSITIVITY_DBM10[COUNT] = {
+  -1185, -1210, -1265, -1290, -1345, -1370,
+};
+
+// The rate common.h configures (LORA_SPREADING_FACTOR / LORA_BANDWIDTH)
+inline LoRaDataRate configured() {
+  LoRaDataRate rate = {(uint8_t)LORA_SPREADING_FACTOR, (uint32_t)LORA_BANDWIDTH};
+  return rate;
+}
+
+// Time on air of a serialized frame of `length` bytes (plus LORA_FEC check bytes)
+inline uint32_t airtimeUs(const LoRaDataRate& rate, size_t length) {
+  return LoRaProtocol::timeOnAirUs(length + LoRaFec::PARITY, rate.spreadingFactor, rate.bandwidthHz,
+                                   LORA_CODING_RATE, LORA_PREAMBLE_LENGTH);
+}
+
+/**
+ * Received signal power in 0.1 dBm. Below the noise floor (negative SNR)
+ * the SX1276 packet RSSI mostly measures noise; the datasheet corrects it
+ * by adding the SNR.
+ */
+inline int16_t signalDbm10(int rssi, float snr) {
+  float signal = (float)rssi + (snr < 0.0f ? snr : 0.0f);
+  return (int16_t)(signal * 10.0f + (signal < 0.0f ? -0.5f : 0.5f));
+}
+
+/**
+ * What a shot waits between the BLE notification and the receiver: the
+ * coalescing window (LORA_SHOT_BATCHING) plus the time on air of a
+ * one-shot packet. Queueing and retransmissions come on top.
+ */
+inline uint32_t shotLatencyMs(const LoRaDataRate& rate) {
+  size_t length = LORA_FRAME_VERSION == 2
+    ? LoRaProtocol::HEADER_SIZE_V2 + LoRaProtocol::PAYLOAD_SHOT_DETECTED_V2_MAX + LoRaProtocol::CRC_SIZE
+    : LoRaProtocol::HEADER_SIZE + LoRaProtocol::PAYLOAD_SHOT_DETECTED + LoRaProtocol::CRC_SIZE;
+  if (LORA_RELIABLE) length += LoRaProtocol::SEQ_SIZE;
+  uint32_t windowMs = LORA_SHOT_BATCHING ? LORA_SHOT_BATCH_WINDOW_MS : 0;
+  return windowMs + (airtimeUs(rate, length) + 999) / 1000;
+}
+
+}  // namespace LoRaRate
+
+/**
+ * @brief Receiver-side choice of the link's data rate
+ *
+ * The receiver has one radio, so every transmitter shares its rate: the
+ * controller picks it for the weakest online source. Each packet's signal
+ * power goes into a per-source moving average (LoRaSource::signalDbm10);
+ * its margin over the SENSITIVITY_DBM10 of a rate decides:
+ *
+ * - slower as soon as any online source with MIN_SAMPLES at the current
+ *   rate has less than `marginDb10` left
+ * - faster only after `holdMs` at the current rate, when every online
+ *   source has MIN_SAMPLES and would keep `marginDb10 + hysteresisDb10` at
+ *   the faster rate
+ *
+ * A source that is online but silent for `fallbackMs` after a change may
+ * not have heard it: fallbackDue() tells the owner to return to the
+ * rendezvous rate, where transmitters that lose the link go too.
+ *
+ * Main loop only (not thread-safe). Times are millis().
+ */
+class LoRaRateController {
+public:
+  static constexpr uint8_t MIN_SAMPLES = 4;  // Per source, at the current rate
+  static constexpr int NO_CHANGE = -1;
+
+  LoRaRateController(uint8_t rendezvous, int16_t marginDb10, int16_t hysteresisDb10,
+                     uint32_t holdMs, uint32_t fallbackMs)
+    : rendezvous(rendezvous), rate(rendezvous), marginDb10(marginDb10),
+      hysteresisDb10(hysteresisDb10), holdMs(holdMs), fallbackMs(fallbackMs), changedAtMs(0) {}
+
+  uint8_t current() const { return rate; }
+  uint8_t getRendezvous() const { return rendezvous; }
+
+  // Adds a packet's RSSI / SNR to the source's moving average (1/4 weight)
+  static void record(LoRaSource& source, int rssi, float snr) {
+    int16_t signal = LoRaRate::signalDbm10(rssi, snr);
+    if (!source.hasSignal) {
+      source.hasSignal = true;
+      source.signalDbm10 = signal;
+    } else {
+      source.signalDbm10 = (int16_t)(source.signalDbm10 + (signal - source.signalDbm10) / 4);
+    }
+    if (source.linkSamples < UINT8_MAX) source.linkSamples++;
+  }
+
+  // Margin of `source` over the sensitivity at rate `index`, in 0.1 dB
+  static int16_t marginAt(const LoRaSource& source, uint8_t index) {
+    return (int16_t)(source.signalDbm10 - LoRaRate::SENSITIVITY_DBM10[index]);
+  }
+
+  /**
+   * The rate the link should move to.
+   * @return a TABLE index, or NO_CHANGE
+   */
+  template <size_t Capacity>
+  int decide(const LoRaSourceTable<Capacity>& sources, uint32_t nowMs) const {
+    bool anyOnline = false;
+    bool allSampled = true;
+    int16_t worstNow = INT16_MAX;     // Sampled sources only
+    int16_t worstFaster = INT16_MAX;
+    for (size_t i = 0; i < sources.size(); i++) {
+      const LoRaSource& source = sources.at(i);
+      if (!source.online) continue;
+      anyOnline = true;
+      if (source.linkSamples < MIN_SAMPLES) {
+        allSampled = false;
+        continue;
+      }
+      int16_t margin = marginAt(source, rate);
+      if (margin < worstNow) worstNow = margin;
+      if (rate > 0) {
+        int16_t faster = marginAt(source, rate - 1);
+        if (faster < worstFaster) worstFaster = faster;
+      }
+    }
+    if (!anyOnline) return NO_CHANGE;
+
+    if (worstNow < marginDb10 && rate + 1 < LoRaRate::COUNT) return rate + 1;
+    if (rate > 0 && allSampled && nowMs - changedAtMs >= holdMs &&
+        worstFaster >= marginDb10 + hysteresisDb10) {
+      return rate - 1;
+    }
+    return NO_CHANGE;
+  }
+
+  // Call once the link has moved to `index`; samples start over there
+  template <size_t Capacity>
+  void changed(LoRaSourceTable<Capacity>& sources, uint8_t index, uint32_t nowMs) {
+    rate = index;
+    changedAtMs = nowMs;
+    for (size_t i = 0; i < sources.size(); i++) sources.at(i).linkSamples = 0;
+  }
+
+  // True if an online source has been silent for fallbackMs since the last change
+  template <size_t Capacity>
+  bool fallbackDue(const LoRaSourceTable<Capacity>& sources, uint32_t nowMs) const {
+    return msUntilFallback(sources, nowMs) == 0;
+  }
+
+  // Time until fallbackDue() (UINT32_MAX if at the rendezvous rate or nobody is online)
+  template <size_t Capacity>
+  uint32_t msUntilFallback(const LoRaSourceTable<Capacity>& sources, uint32_t nowMs) const {
+    if (rate == rendezvous) return UINT32_MAX;
+    uint32_t due = UINT32_MAX;
+    for (size_t i = 0; i < sources.size(); i++) {
+      const LoRaSource& source = sources.at(i);
+      if (!source.online) continue;
+      // Silent since it was last heard, or since the change if that is later (wrap-safe)
+      uint32_t since = (int32_t)(source.lastHeardMs - changedAtMs) > 0 ? source.lastHeardMs : changedAtMs;
+      uint32_t silent = nowMs - since;
+      uint32_t left = silent >= fallbackMs ? 0 : fallbackMs - silent;
+      if (left < due) due = left;
+    }
+    return due;
+  }
+
+private:
+  uint8_t rendezvous;
+  uint8_t rate;
+  int16_t marginDb10;
+  int16_t hysteresisDb10;
+  uint32_t holdMs;
+  uint32_t fallbackMs;
+  uint32_t changedAtMs;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "LoRaPacket.h"
+#include "ReedSolomon.h"
+#include "common.h"
+#include <cstddef>
+#include <cstdint>
+
+// Forward error correction for every frame on air (LORA_FEC): LORA_FEC_PARITY
+// Reed-Solomon check bytes follow the serialized frame, CRC-16 included, so
+// up to LORA_FEC_PARITY / 2 corrupted bytes anywhere in it are repaired
+// before LoRaProtocol::deserialize() checks the CRC. With LORA_FEC 0 both
+// calls pass the frame through and PARITY is 0.
+namespace LoRaFec {
+
+static constexpr size_t PARITY = LORA_FEC ? LORA_FEC_PARITY : 0;
+static constexpr size_t MAX_FRAME_SIZE = LoRaProtocol::MAX_PACKET_SIZE + PARITY;
+
+inline const ReedSolomon::Codec<LORA_FEC_PARITY>& codec() {
+  static const ReedSolomon::Codec<LORA_FEC_PARITY> instance;
+  return instance;
+}
+
+// Check bytes for a serialized frame, sent right after it (PARITY bytes)
+inline void encode(const uint8_t* frame, size_t len, uint8_t* parity) {
+  if (LORA_FEC) codec().encode(frame, len, parity);
+}
+
+/**
+ * Repairs a received frame in place.
+ * @param corrected  bytes repaired
+ * @return length of the frame without the check bytes, or 0 if it is
+ *         beyond repair
+ */
+inline size_t decode(uint8_t* data, size_t len, int& corrected) {
+  corrected = 0;
+  if (!LORA_FEC) return len;
+  int result = codec().decode(data, len);
+  if (result < 0) return 0;
+  corrected = result;
+  return len - PARITY;
+}
+
+}  // namespace LoRaFec
@@ -6,10 +6,18 @@
 // =============================================================================
 // LoRa Packet Protocol — Binary format with CRC-16/CCITT
 //
-// Frame layout:
-//   [MAGIC 2B][TYPE 1B][SOURCE_ID 6B][PAYLOAD variable][CRC16 2B]
+// Frame layout, v1:
+//   [MAGIC 2B][TYPE 1B][SOURCE_ID 6B][SEQ 2B, if flagged][PAYLOAD variable][CRC16 2B]
+// v2 (compact):
+//   [MAGIC_0 1B][VERSION 1B][TYPE 1B][SOURCE_HASH 2B][SEQ 2B, if flagged][PAYLOAD variable][CRC16 2B]
 //
-// Magic bytes: 0x50 0x57 ("PW" — PewPew)
+// Magic bytes: 0x50 0x57 ("PW" — PewPew). The high nibble of byte 1 is the
+// frame version: 0x5 (the 'W') is v1, 0x2 is v2 with a 2-byte hash of the
+// sourceId, varint times and counts, and no device model (DEVICE_INFO
+// carries it once). deserialize() accepts both.
+// TYPE bits 0-5 are the PacketType; bit 7 (SEQ_FLAG) marks a sequenced
+// packet (LORA_RELIABLE) and bit 6 (SYNC_FLAG) asks the receiver to restart
+// its window for this source at SEQ.
 // All multi-byte fields are little-endian.
 // CRC-16/CCITT (polynomial 0x1021, init 0xFFFF) covers entire packet
 // excluding the trailing CRC bytes.
@@ -21,6 +29,11 @@ namespace LoRaProtocol {
 static constexpr uint8_t MAGIC_0 = 0x50;  // 'P'
 static constexpr uint8_t MAGIC_1 = 0x57;  // 'W'
 
+// Frame versions (LORA_FRAME_VERSION); v2 replaces MAGIC_1 with VERSION_V2
+static constexpr uint8_t FRAME_V1   = 1;
+static constexpr uint8_t FRAME_V2   = 2;
+static constexpr uint8_t VERSION_V2 = 0x20;  // High nibble 2, low nibble reserved (0)
+
 // Packet type identifiers
 enum class PacketType : uint8_t {
   SHOT_DETECTED       = 0x01,
@@ -29,19 +42,35 @@ enum class PacketType : uint8_t {
   COUNTDOWN_COMPLETE  = 0x04,
   SESSION_SUSPENDED   = 0x05,
   SESSION_RESUMED     = 0x06,
-  HEARTBEAT           = 0x07
+  HEARTBEAT           = 0x07,
+  SHOT_BATCH          = 0x08,
+  ACK                 = 0x09,  // Receiver → transmitter, never sequenced
+  RATE_CHANGE         = 0x0A,  // Receiver → transmitters, never sequenced
+  DEVICE_INFO         = 0x0B   // v2 only: full sourceId and device model
 };
 
+// TYPE byte flags (LORA_RELIABLE)
+static constexpr uint8_t TYPE_MASK = 0x3F;
+static constexpr uint8_t SEQ_FLAG  = 0x80;
+static constexpr uint8_t SYNC_FLAG = 0x40;
+
 // Header common to all packets: magic(2) + type(1) + sourceId(6) = 9 bytes
 static constexpr size_t HEADER_SIZE     = 9;
+// v2: magic(1) + version(1) + type(1) + sourceHash(2) = 5 bytes
+static constexpr size_t HEADER_SIZE_V2  = 5;
 static constexpr size_t CRC_SIZE        = 2;
 static constexpr size_t SOURCE_ID_LEN   = 6;
+static constexpr size_t SEQ_SIZE        = 2;
 
-// Maximum payload size (shot packet is largest)
-static constexpr size_t MAX_PAYLOAD_SIZE = 31;  // shot: 4+2+4+4+1+16 = 31
+// Shots per SHOT_BATCH packet
+static constexpr size_t MAX_BATCH_SHOTS = 12;
 
-// Maximum total packet size: header + max payload + CRC
-static constexpr size_t MAX_PACKET_SIZE = HEADER_SIZE + MAX_PAYLOAD_SIZE + CRC_SIZE;
+// Maximum payload size (a full shot batch with the widest deltas is largest)
+static constexpr size_t MAX_PAYLOAD_SIZE = 99;  // batch: 4+1+1+16 + 2+4+5 + 11*(1+5) = 99
+
+// Maximum total packet size: header + sequence number + max payload + CRC.
+// A v2 packet is never longer than the same packet in v1.
+static constexpr size_t MAX_PACKET_SIZE = HEADER_SIZE + SEQ_SIZE + MAX_PAYLOAD_SIZE + CRC_SIZE;
 
 // Payload sizes per packet type
 static constexpr size_t PAYLOAD_SHOT_DETECTED      = 31;  // sessionId(4)+shotNum(2)+absMs(4)+splitMs(4)+isFirst(1)+model(16)
@@ -51,6 +80,72 @@ static constexpr size_t PAYLOAD_COUNTDOWN_COMPLETE  = 4;   // sessionId(4)
 static constexpr size_t PAYLOAD_SESSION_SUSPENDED   = 4;   // sessionId(4)
 static constexpr size_t PAYLOAD_SESSION_RESUMED     = 4;   // sessionId(4)
 static constexpr size_t PAYLOAD_HEARTBEAT           = 4;   // uptimeMs(4)
+static constexpr size_t PAYLOAD_ACK                 = 12;  // destId(6)+base(2)+mask(4)
+static constexpr size_t PAYLOAD_RATE_CHANGE         = 7;   // destId(6)+rate(1)
+
+// v2 payloads. Varints are unsigned LEB128 (see SHOT_BATCH), `hash` is
+// sourceHash() of the id:
+//   SHOT_DETECTED      sessionId(4) shotNumber<<1|isFirst(varint) absMs(varint) splitMs(varint)
+//   SHOT_BATCH         as v1 without modelLen and model; the first shot's
+//                      shotNumber and absMs are varints
+//   SESSION_STOPPED    sessionId(4) totalShots(varint) lastShotMs(varint)
+//   HEARTBEAT          uptimeMs(varint)
+//   ACK                destHash(2) base(2) mask(varint)
+//   RATE_CHANGE        destHash(2) rate(1)
+//   DEVICE_INFO        sourceId(6) modelLen(1) model(modelLen, max 16)
+//   others             as v1
+// The receiver takes the model of a v2 shot from the source's last
+// DEVICE_INFO.
+static constexpr size_t PAYLOAD_SHOT_DETECTED_V2_MAX = 17;  // 4 + 3 + 5 + 5
+static constexpr size_t PAYLOAD_DEVICE_INFO_MIN      = 7;   // sourceId(6)+modelLen(1)
+
+// ACK: `base` is the next sequence number the receiver is missing (all
+// earlier ones arrived); mask bit i set = base + 1 + i arrived. A clear bit
+// below the highest set one is a NACK.
+//
+// RATE_CHANGE (LORA_ADAPTIVE_RATE): `rate` is the LoRaRate::TABLE index the
+// receiver listens at from now on. An all-zero destId addresses every
+// transmitter.
+
+// SHOT_BATCH payload — session and model once, then delta-encoded shots:
+//   sessionId(4) countFlags(1) modelLen(1) model(modelLen, max 16)
+//   first:  shotNumber(2) absMs(4) splitMs(varint)
+//   others: shotNumber delta(1, 1..255) absMs delta(varint)
+// countFlags: bits 0-6 shot count (1..MAX_BATCH_SHOTS), bit 7 = first shot
+// is the session's first shot. Varints are unsigned LEB128 (7 bits per byte,
+// low group first). Every batched shot after the first has
+// splitTimeMs == its absMs delta, so the split is not sent again.
+static constexpr size_t PAYLOAD_SHOT_BATCH_MIN      = 13;  // one shot, no model, 1-byte split
+static constexpr uint8_t BATCH_FIRST_SHOT_FLAG      = 0x80;
+static constexpr size_t MODEL_LEN                   = 16;
+
+/**
+ * @brief Shots waiting to go out as one SHOT_BATCH packet
+ *
+ * add() only accepts a shot that can be delta-encoded after the previous
+ * one (same session and model, next shot number within 255, split equal
+ * to the time delta) and still fits in MAX_PAYLOAD_SIZE. On false the
+ * caller sends the batch and starts a new one with the rejected shot.
+ */
+class ShotBatch {
+public:
+  ShotBatch() { clear(); }
+
+  bool add(const NormalizedShotData& shot);
+  void clear();
+
+  size_t count() const { return shotCount; }
+  bool empty() const { return shotCount == 0; }
+  bool full() const { return shotCount == MAX_BATCH_SHOTS; }
+  const NormalizedShotData& shot(size_t index) const { return shots[index]; }
+
+  size_t payloadSize() const { return encodedSize; }
+
+private:
+  NormalizedShotData shots[MAX_BATCH_SHOTS];
+  size_t shotCount;
+  size_t encodedSize;
+};
 
 // ─── Serialization helpers ──────────────────────────────────
 
@@ -60,14 +155,25 @@ static constexpr size_t PAYLOAD_HEARTBEAT           = 4;   // uptimeMs(4)
  */
 size_t serializeShotDetected(uint8_t* buf, size_t bufLen,
                              const char* sourceId,
-                             const NormalizedShotData& shot);
+                             const NormalizedShotData& shot,
+                             uint8_t version = FRAME_V1);
+
+/**
+ * Build a SHOT_BATCH packet from the shots in `batch`.
+ * @return total bytes written, or 0 if the batch is empty or `buf` too small.
+ */
+size_t serializeShotBatch(uint8_t* buf, size_t bufLen,
+                          const char* sourceId,
+                          const ShotBatch& batch,
+                          uint8_t version = FRAME_V1);
 
 /**
  * Build a SESSION_STARTED packet.
  */
 size_t serializeSessionStarted(uint8_t* buf, size_t bufLen,
                                const char* sourceId,
-                               uint32_t sessionId, float startDelaySeconds);
+                               uint32_t sessionId, float startDelaySeconds,
+                               uint8_t version = FRAME_V1);
 
 /**
  * Build a SESSION_STOPPED packet.
@@ -75,35 +181,83 @@ size_t serializeSessionStarted(uint8_t* buf, size_t bufLen,
 size_t serializeSessionStopped(uint8_t* buf, size_t bufLen,
                                const char* sourceId,
                                uint32_t sessionId, uint16_t totalShots,
-                               uint32_t lastShotTimeMs);
+                               uint32_t lastShotTimeMs, uint8_t version = FRAME_V1);
 
 /**
  * Build a COUNTDOWN_COMPLETE packet.
  */
 size_t serializeCountdownComplete(uint8_t* buf, size_t bufLen,
                                   const char* sourceId,
-                                  uint32_t sessionId);
+                                  uint32_t sessionId, uint8_t version = FRAME_V1);
 
 /**
  * Build a SESSION_SUSPENDED packet.
  */
 size_t serializeSessionSuspended(uint8_t* buf, size_t bufLen,
                                  const char* sourceId,
-                                 uint32_t sessionId);
+                                 uint32_t sessionId, uint8_t version = FRAME_V1);
 
 /**
  * Build a SESSION_RESUMED packet.
  */
 size_t serializeSessionResumed(uint8_t* buf, size_t bufLen,
                                const char* sourceId,
-                               uint32_t sessionId);
+                               uint32_t sessionId, uint8_t version = FRAME_V1);
 
 /**
  * Build a HEARTBEAT packet.
  */
 size_t serializeHeartbeat(uint8_t* buf, size_t bufLen,
                           const char* sourceId,
-                          uint32_t uptimeMs);
+                          uint32_t uptimeMs, uint8_t version = FRAME_V1);
+
+/**
+ * Build a DEVICE_INFO packet (always v2): the full `sourceId` behind the
+ * frames' source hash, and the timer model v2 shots leave out.
+ */
+size_t serializeDeviceInfo(uint8_t* buf, size_t bufLen,
+                           const char* sourceId, const char* deviceModel);
+
+/**
+ * Build an ACK packet from the receiver `sourceId` to transmitter `destId`.
+ */
+size_t serializeAck(uint8_t* buf, size_t bufLen,
+                    const char* sourceId, const char* destId,
+                    uint16_t base, uint32_t mask, uint8_t version = FRAME_V1);
+
+/**
+ * Build a RATE_CHANGE packet from the receiver `sourceId`. `destId` nullptr
+ * addresses every transmitter.
+ */
+size_t serializeRateChange(uint8_t* buf, size_t bufLen,
+                           const char* sourceId, const char* destId, uint8_t rate,
+                           uint8_t version = FRAME_V1);
+
+/**
+ * Turn a serialized packet of `len` bytes into a sequenced one: sets
+ * SEQ_FLAG (and SYNC_FLAG if `sync`), inserts `seq` after the header and
+ * recomputes the CRC.
+ * @return the new length (len + SEQ_SIZE), or 0 if `bufLen` is too small
+ *         or the packet is already sequenced.
+ */
+size_t addSequence(uint8_t* buf, size_t len, size_t bufLen, uint16_t seq, bool sync);
+
+// ─── Source addressing (v2) ──────────────────────────────────
+
+/**
+ * 2-byte address of `sourceId` in v2 frames: CRC-16 of the zero-padded
+ * 6-byte id, never 0 (0 addresses every transmitter). A placeholderId()
+ * maps back to the hash it stands for.
+ */
+uint16_t sourceHash(const char* sourceId);
+
+static constexpr char PLACEHOLDER_PREFIX = '~';  // Not in a DeviceId
+
+/**
+ * Writes the id a v2 sender goes by until its DEVICE_INFO arrives:
+ * "~" and the hash in 4 hex digits. `out` holds SOURCE_ID_LEN + 1 bytes.
+ */
+void placeholderId(uint16_t hash, char* out);
 
 // ─── Deserialization ─────────────────────────────────────────
 
@@ -111,11 +265,18 @@ size_t serializeHeartbeat(uint8_t* buf, size_t bufLen,
  * Parsed packet container returned by deserialize().
  */
 struct ParsedPacket {
-  PacketType type;
-  char sourceId[SOURCE_ID_LEN + 1];  // null-terminated
+  PacketType type;                   // Without the TYPE flags
+  uint8_t version;                   // FRAME_V1 or FRAME_V2
+  char sourceId[SOURCE_ID_LEN + 1];  // null-terminated; v2: placeholderId() except in DEVICE_INFO
+  uint16_t sourceHash;               // sourceHash(), sent in v2 and computed for v1
+
+  // Sequenced packets (LORA_RELIABLE)
+  bool sequenced;
+  bool sync;
+  uint16_t seq;
 
   // Union-like fields — only the set matching `type` is valid
-  // SHOT_DETECTED
+  // SHOT_DETECTED (v2: no deviceModel), DEVICE_INFO (shot.deviceModel only)
   NormalizedShotData shot;
 
   // SESSION_STARTED
@@ -128,6 +289,24 @@ struct ParsedPacket {
 
   // HEARTBEAT
   uint32_t uptimeMs;
+
+  // ACK, RATE_CHANGE — use addressedTo()
+  char destId[SOURCE_ID_LEN + 1];     // null-terminated; "" = every transmitter; v2: placeholderId()
+  uint16_t destHash;                  // 0 = every transmitter
+  uint16_t ackBase;
+  uint32_t ackMask;
+  uint8_t rate;
+
+  // SHOT_BATCH — sessionId and shot.deviceModel hold the shared fields;
+  // use batchShot() to expand each entry into a full shot
+  struct BatchEntry {
+    uint16_t shotNumber;
+    uint32_t absoluteTimeMs;
+    uint32_t splitTimeMs;
+  };
+  uint8_t batchCount;
+  bool batchStartsSession;
+  BatchEntry batch[MAX_BATCH_SHOTS];
 };
 
 /**
@@ -139,6 +318,30 @@ struct ParsedPacket {
  */
 bool deserialize(const uint8_t* data, size_t len, ParsedPacket& out);
 
+/**
+ * Expand entry `index` of a deserialized SHOT_BATCH into a shot, as if it
+ * had arrived in its own SHOT_DETECTED packet.
+ */
+NormalizedShotData batchShot(const ParsedPacket& pkt, size_t index);
+
+/**
+ * True if an ACK / RATE_CHANGE is for transmitter `sourceId` (v1: the id,
+ * v2: its hash). Broadcasts (empty destId) are not.
+ */
+bool addressedTo(const ParsedPacket& pkt, const char* sourceId);
+
+// ─── Airtime ─────────────────────────────────────────────────
+
+/**
+ * LoRa time on air for a packet of `length` bytes (Semtech SX1276
+ * datasheet §4.1.1.7): explicit header, radio CRC on, low data rate
+ * optimisation when a symbol exceeds 16 ms.
+ * @param bandwidthHz  e.g. 500000
+ * @param codingRate   denominator of 4/x (5..8)
+ */
+uint32_t timeOnAirUs(size_t length, uint8_t spreadingFactor, uint32_t bandwidthHz,
+                     uint8_t codingRate, uint16_t preambleLength);
+
 // ─── CRC utility ─────────────────────────────────────────────
 
 /**
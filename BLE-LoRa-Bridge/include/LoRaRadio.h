@@ -2,6 +2,7 @@
 
 #include <LoRa.h>
 #include <SPI.h>
+#include "LoRaDataRate.h"
 #include "common.h"
 
 namespace LoRaRadio {
@@ -29,8 +30,87 @@ inline bool initialize(int txPower = -1) {
   }
   LoRa.setSyncWord(LORA_SYNC_WORD);
   LoRa.setPreambleLength(LORA_PREAMBLE_LENGTH);
+#if LORA_FEC
+  // A payload CRC error would make the radio drop what LoRaFec can repair;
+  // the receiver follows the transmitter's header, so both ends switch it off
+  LoRa.disableCrc();
+#else
   LoRa.enableCrc();
+#endif
   return true;
 }
 
+// Switches spreading factor and bandwidth (LORA_ADAPTIVE_RATE). The library
+// sets the low data rate optimisation to match. Call in standby; the caller
+// returns to RX or TX afterwards.
+inline void applyDataRate(const LoRaDataRate& rate) {
+  LoRa.setSignalBandwidth(rate.bandwidthHz);
+  LoRa.setSpreadingFactor(rate.spreadingFactor);
+}
+
+// ─── Direct register access ─────────────────────────────────
+// The LoRa library keeps its SPI helpers private and reads the FIFO one
+// byte per SPI transaction. The interrupt-driven receive path uses these
+// instead, with the same bus settings; the transmitter uses them to map
+// DIO0 to TxDone, clear the flag and (LORA_RELIABLE) read ACKs. Only one task may use the radio at a
+// time.
+
+namespace Reg {
+  constexpr uint8_t FIFO                 = 0x00;
+  constexpr uint8_t OP_MODE              = 0x01;
+  constexpr uint8_t FIFO_ADDR_PTR        = 0x0D;
+  constexpr uint8_t FIFO_RX_CURRENT_ADDR = 0x10;
+  constexpr uint8_t IRQ_FLAGS            = 0x12;
+  constexpr uint8_t RX_NB_BYTES          = 0x13;
+  constexpr uint8_t RX_PACKET_CNT_MSB    = 0x16;  // Valid packets since entering RX (16-bit, MSB first)
+  constexpr uint8_t DIO_MAPPING_1        = 0x40;
+}
+
+namespace Irq {
+  constexpr uint8_t RX_DONE           = 0x40;
+  constexpr uint8_t PAYLOAD_CRC_ERROR = 0x20;
+  constexpr uint8_t TX_DONE           = 0x08;
+}
+
+constexpr uint8_t DIO0_RX_DONE = 0x00;  // DIO_MAPPING_1 bits 7-6
+constexpr uint8_t DIO0_TX_DONE = 0x40;
+
+constexpr uint32_t SPI_FREQUENCY = 8000000;  // LoRa library default
+
+// Burst read: the SX1276 auto-increments the address (the FIFO pointer for Reg::FIFO)
+inline void readRegisters(uint8_t address, uint8_t* out, size_t length) {
+  memset(out, 0, length);
+  SPI.beginTransaction(SPISettings(SPI_FREQUENCY, MSBFIRST, SPI_MODE0));
+  digitalWrite(LORA_CS_PIN, LOW);
+  SPI.transfer(address & 0x7F);
+  SPI.transfer(out, length);
+  digitalWrite(LORA_CS_PIN, HIGH);
+  SPI.endTransaction();
+}
+
+inline uint8_t readRegister(uint8_t address) {
+  uint8_t value;
+  readRegisters(address, &value, 1);
+  return value;
+}
+
+inline void writeRegister(uint8_t address, uint8_t value) {
+  SPI.beginTransaction(SPISettings(SPI_FREQUENCY, MSBFIRST, SPI_MODE0));
+  digitalWrite(LORA_CS_PIN, LOW);
+  SPI.transfer(address | 0x80);
+  SPI.transfer(value);
+  digitalWrite(LORA_CS_PIN, HIGH);
+  SPI.endTransaction();
+}
+
+// Copies the packet the radio just received (RxDone) out of the FIFO.
+// Returns its length, or 0 if it is empty or longer than maxLength.
+inline size_t readPacket(uint8_t* out, size_t maxLength) {
+  uint8_t length = readRegister(Reg::RX_NB_BYTES);
+  if (length == 0 || length > maxLength) return 0;
+  writeRegister(Reg::FIFO_ADDR_PTR, readRegister(Reg::FIFO_RX_CURRENT_ADDR));
+  readRegisters(Reg::FIFO, out, length);
+  return length;
+}
+
 }  // namespace LoRaRadio
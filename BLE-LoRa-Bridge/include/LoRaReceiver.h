@@ -1,21 +1,56 @@
 #pragma once
 
+#include "AirtimeBudget.h"
+#include "LoRaDataRate.h"
+#include "LoRaFec.h"
 #include "LoRaPacket.h"
 #include "Logger.h"
+#include "LoopScheduler.h"
+#include "SpscRing.h"
+#include "common.h"
+#include <atomic>
 #include <functional>
 
 /**
  * @brief LoRa receiver for Device 2 (LoRa → MQTT or LoRa → BLE)
  *
- * Polls the SX1276 radio for incoming packets, validates CRC,
- * deserializes, and fires callbacks for each event type.
+ * LORA_RX_INTERRUPT_DRIVEN (default): the radio stays in continuous RX.
+ * The DIO0 (RxDone) ISR wakes a drain task, which burst-reads each packet
+ * out of the SX1276 FIFO into a lock-free ring and signals the main loop.
+ * update() then validates CRC, deserializes, and fires the callbacks on the
+ * main loop, so MQTT / BLE outputs keep a single owner.
+ *
+ * Producer: drain task (owns the radio SPI bus while receiving)
+ * Consumer: main loop (update())
+ *
+ * Legacy (LORA_RX_INTERRUPT_DRIVEN 0): update() polls parsePacket() in
+ * RX_SINGLE and reads the FIFO byte by byte.
+ *
+ * LORA_RELIABLE: sendAck() answers a transmitter. The drain task puts the
+ * ACK on air (it owns the radio) and returns to RX on TxDone; the main loop
+ * only fills a one-packet mailbox. ACKs count against their own
+ * duty-cycle budget.
+ *
+ * LORA_ADAPTIVE_RATE: announceDataRate() sends RATE_CHANGE through the
+ * same mailbox, LORA_RATE_ANNOUNCEMENTS times at the old rate, and the
+ * drain task switches the radio after the last one; setDataRate() switches
+ * without announcing. Which rate to use is the owner's choice
+ * (LoRaRateController).
  */
 class LoRaReceiver {
 public:
-  bool initialize();
-  void update();  // Poll for incoming packets — call every loop iteration
+  LoRaReceiver();
+  ~LoRaReceiver();
 
-  // Callback registration
+  // scheduler is signalled (LoopEvent::LORA_RX) when packets are queued; may be nullptr
+  bool initialize(LoopScheduler* scheduler = nullptr);
+  void update();  // Decode and dispatch received packets — call every loop iteration
+
+  // Callback registration. onPacketReceived runs first, for every valid
+  // packet; returning false drops it before the type callbacks (e.g. a
+  // retransmission already handled). It may fill in what a v2 frame leaves
+  // out (the sourceId and device model from the source's DEVICE_INFO).
+  void onPacketReceived(std::function<bool(LoRaProtocol::ParsedPacket&)> cb) { packetCallback = cb; }
   void onShotReceived(std::function<void(const LoRaProtocol::ParsedPacket&)> cb) { shotCallback = cb; }
   void onSessionStarted(std::function<void(const LoRaProtocol::ParsedPacket&)> cb) { sessionStartedCallback = cb; }
   void onSessionStopped(std::function<void(const LoRaProtocol::ParsedPacket&)> cb) { sessionStoppedCallback = cb; }
@@ -24,11 +59,45 @@ public:
   void onSessionResumed(std::function<void(const LoRaProtocol::ParsedPacket&)> cb) { resumedCallback = cb; }
   void onHeartbeatReceived(std::function<void(const LoRaProtocol::ParsedPacket&)> cb) { heartbeatCallback = cb; }
 
+#if LORA_RELIABLE
+  // False while the previous ACK or rate change is still going out (the
+  // drain task signals LoopEvent::LORA_TX when it is done)
+  bool canTransmit() const;
+  // Queues an ACK to transmitter destId, in the frame version it sends.
+  // Returns false if the mailbox is busy or the duty-cycle budget has no room.
+  bool sendAck(const char* destId, uint16_t base, uint32_t mask, uint8_t version);
+  uint32_t getAcksSent() const { return acksSent; }
+#endif
+#if LORA_ADAPTIVE_RATE
+  // Broadcasts RATE_CHANGE, then moves to LoRaRate::TABLE[index]. Same
+  // conditions as sendAck().
+  bool announceDataRate(uint8_t index);
+  // Moves to LoRaRate::TABLE[index] without announcing (fallback). Returns
+  // false if the mailbox is busy.
+  bool setDataRate(uint8_t index);
+#endif
+  // The rate ACKs and announcements are sent at; the radio follows once
+  // the mailbox is done
+  LoRaDataRate getDataRate() const { return dataRate; }
+
   int getLastRssi() const { return lastRssi; }
+  float getLastSnr() const { return lastSnr; }
   uint32_t getPacketsReceived() const { return packetsReceived; }
-  uint32_t getCrcErrors() const { return crcErrors; }
+  uint32_t getCrcErrors() const { return crcErrors + radioCrcErrors.load(); }
+#if LORA_FEC
+  // Packets that passed the CRC-16 only after repair, and the bytes repaired
+  uint32_t getFecRepairs() const { return fecRepairs; }
+  uint32_t getFecBytesCorrected() const { return fecBytesCorrected; }
+#endif
+
+  // Packets lost before decode. Always 0 in legacy mode: RX_SINGLE stops
+  // listening after each packet, so losses there are packets never heard
+  // (compare the transmitter's packetsSent with getPacketsReceived())
+  uint32_t getFifoOverruns() const { return fifoOverruns.load(); }  // Overwritten in the SX1276 FIFO
+  uint32_t getRingOverruns() const { return ringOverruns.load(); }  // Drained but the ring was full
 
 private:
+  std::function<bool(LoRaProtocol::ParsedPacket&)> packetCallback;
   std::function<void(const LoRaProtocol::ParsedPacket&)> shotCallback;
   std::function<void(const LoRaProtocol::ParsedPacket&)> sessionStartedCallback;
   std::function<void(const LoRaProtocol::ParsedPacket&)> sessionStoppedCallback;
@@ -37,8 +106,58 @@ private:
   std::function<void(const LoRaProtocol::ParsedPacket&)> resumedCallback;
   std::function<void(const LoRaProtocol::ParsedPacket&)> heartbeatCallback;
 
-  uint8_t rxBuffer[LoRaProtocol::MAX_PACKET_SIZE];
   int lastRssi = 0;
+  float lastSnr = 0.0f;
+  LoRaDataRate dataRate;  // Main loop
   uint32_t packetsReceived = 0;
-  uint32_t crcErrors = 0;
+  uint32_t crcErrors = 0;                  // Application CRC-16 / parse failures (FEC: beyond repair too)
+#if LORA_FEC
+  uint32_t fecRepairs = 0;
+  uint32_t fecBytesCorrected = 0;
+#endif
+  std::atomic<uint32_t> radioCrcErrors;    // SX1276 payload CRC failures (never reach update())
+  std::atomic<uint32_t> fifoOverruns;
+  std::atomic<uint32_t> ringOverruns;
+
+  void dispatch(uint8_t* data, size_t length);  // Repairs (LORA_FEC) in place
+
+#if LORA_RELIABLE
+  char sourceId[LoRaProtocol::SOURCE_ID_LEN + 1] = {0};  // From DeviceId, for ACKs
+  AirtimeBudget airtime;
+  uint32_t acksSent = 0;
+
+  // Mailbox: one packet, sent txRepeats times, then a rate switch if txNextRate >= 0
+  uint8_t txBuffer[LoRaFec::MAX_FRAME_SIZE];  // Frame + LORA_FEC check bytes
+  uint8_t txLength = 0;           // 0: only the rate switch
+  uint8_t txRepeats = 0;
+  int8_t txNextRate = -1;
+  bool queueTx(size_t len, uint8_t repeats, int8_t nextRate);
+#endif
+
+#if LORA_RX_INTERRUPT_DRIVEN
+  struct RawPacket {
+    int16_t rssi;
+    float snr;
+    uint8_t length;
+    uint8_t data[LoRaFec::MAX_FRAME_SIZE];
+  };
+
+  SpscRing<RawPacket, LORA_RX_RING_SIZE> ring;
+  TaskHandle_t taskHandle;
+  LoopScheduler* scheduler;
+  uint16_t validPacketsHandled;  // Compared with the radio's RX packet counter (wraps with it)
+
+  void drainFifo();  // Drain task
+#if LORA_RELIABLE
+  std::atomic<bool> txPending;   // The mailbox is the drain task's until it clears this
+  bool txOnAir;                  // Drain task only
+  uint8_t txSent;
+  uint32_t txStartedAt;
+  uint32_t txTimeoutMs;
+  void serviceTx();              // Drain task
+#endif
+  static void taskEntry(void* param);
+#else
+  uint8_t rxBuffer[LoRaFec::MAX_FRAME_SIZE];
+#endif
 };
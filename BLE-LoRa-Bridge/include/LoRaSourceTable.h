@@ -0,0 +1,246 @@
+#pragma once
+
+#include "LoRaArq.h"
+#include "LoRaPacket.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief What the receiver knows about one LoRa transmitter
+ */
+struct LoRaSource {
+  char id[LoRaProtocol::SOURCE_ID_LEN + 1];  // null-terminated; "" = free entry
+  bool online;             // Set by the owner once announced, cleared by expire()
+
+  // Frame format (LORA_FRAME_VERSION), set by the owner. A v2 source goes
+  // by LoRaProtocol::placeholderId() until its DEVICE_INFO names it.
+  uint16_t hash;           // LoRaProtocol::sourceHash() of id
+  uint8_t frameVersion;    // Of its last packet; ACKs answer in it
+  char model[LoRaProtocol::MODEL_LEN + 1];  // From DEVICE_INFO; v2 shots leave it out
+
+  uint32_t sessionId;
+  bool hasShot;            // lastShotNumber / shotWindow are valid
+  uint16_t lastShotNumber; // Highest shot number accepted in the session
+  uint32_t lastShotTimeMs;
+  uint32_t shotWindow;     // Bit i set: shot lastShotNumber - i accepted
+
+  int16_t lastRssi;
+  uint32_t lastHeardMs;     // Any packet
+  uint32_t lastHeartbeatMs; // 0 until the first heartbeat
+  uint32_t uptimeMs;        // Transmitter uptime from its last heartbeat
+
+  // Link quality (LORA_ADAPTIVE_RATE), see LoRaRateController
+  bool hasSignal;           // signalDbm10 is valid
+  int16_t signalDbm10;      // Moving average of RSSI + negative SNR, 0.1 dBm
+  uint8_t linkSamples;      // Packets averaged since the last rate change
+
+  // Sequenced packets (LORA_RELIABLE)
+  LoRaRxWindow rxWindow;   // Also the content of the next ACK
+  bool ackDue;             // A sequenced packet arrived since the last ACK
+
+  uint32_t packets;
+  uint32_t shots;
+  uint32_t duplicates;     // Shots and retransmitted packets already handled
+};
+
+/**
+ * @brief Fixed-capacity table of LoRa transmitters, keyed by sourceId
+ *
+ * Lets one receiver serve several remote bays: each transmitter gets its
+ * own session state, shot de-duplication and liveness. Entries live in a
+ * plain array - no heap. When a new source arrives and the table is full,
+ * the offline source heard from least recently is evicted, or the least
+ * recently heard online one if all are online.
+ *
+ * Main loop only (not thread-safe). Times are millis().
+ */
+template <size_t Capacity>
+class LoRaSourceTable {
+public:
+  // Shots this far behind the newest one are treated as duplicates
+  static constexpr uint16_t SHOT_WINDOW = 32;
+
+  LoRaSourceTable() : count(0), evictions(0) {}
+
+  // Source with this id, or nullptr
+  LoRaSource* find(const char* sourceId) {
+    for (size_t i = 0; i < count; i++) {
+      if (strncmp(entries[i].id, sourceId, LoRaProtocol::SOURCE_ID_LEN) == 0) return &entries[i];
+    }
+    return nullptr;
+  }
+
+  // Named source with this hash (not a placeholder), or nullptr. Two ids
+  // with the same hash resolve to the first.
+  LoRaSource* findByHash(uint16_t hash) {
+    for (size_t i = 0; i < count; i++) {
+      if (entries[i].hash == hash && entries[i].id[0] != LoRaProtocol::PLACEHOLDER_PREFIX) return &entries[i];
+    }
+    return nullptr;
+  }
+
+  /**
+   * Gives source `from` the id `to`, keeping its state (a v2 placeholder
+   * once DEVICE_INFO arrives).
+   * @return false if there is no `from` or `to` is taken
+   */
+  bool rename(const char* from, const char* to) {
+    LoRaSource* source = find(from);
+    if (!source || find(to)) return false;
+    strncpy(source->id, to, LoRaProtocol::SOURCE_ID_LEN);
+    source->id[LoRaProtocol::SOURCE_ID_LEN] = '\0';
+    return true;
+  }
+
+  // Finds or adds the source and records a packet from it
+  LoRaSource& touch(const char* sourceId, uint32_t nowMs, int rssi) {
+    return touch(sourceId, nowMs, rssi, IgnoreEviction());
+  }
+
+  /**
+   * As above; when adding the source evicts another, calls
+   * onEvicted(const LoRaSource&) with it first. An evicted source that was
+   * online goes offline here instead of through expire().
+   */
+  template <typename Callback>
+  LoRaSource& touch(const char* sourceId, uint32_t nowMs, int rssi, Callback onEvicted) {
+    LoRaSource* source = find(sourceId);
+    if (!source) {
+      source = allocate(onEvicted);
+      strncpy(source->id, sourceId, LoRaProtocol::SOURCE_ID_LEN);
+      source->id[LoRaProtocol::SOURCE_ID_LEN] = '\0';
+    }
+    source->lastHeardMs = nowMs;
+    source->lastRssi = (int16_t)rssi;
+    source->packets++;
+    return *source;
+  }
+
+  static void recordHeartbeat(LoRaSource& source, uint32_t nowMs, uint32_t uptimeMs) {
+    source.lastHeartbeatMs = nowMs;
+    source.uptimeMs = uptimeMs;
+  }
+
+  // SESSION_STARTED: shot numbers start over
+  static void startSession(LoRaSource& source, uint32_t sessionId) {
+    source.sessionId = sessionId;
+    source.hasShot = false;
+    source.shotWindow = 0;
+  }
+
+  /**
+   * Records a shot unless it was already accepted (a retransmission, or the
+   * same packet heard twice). A new sessionId starts over, as does a first
+   * shot numbered below the newest one (a new string whose SESSION_STARTED
+   * was lost).
+   * @return true if the shot is new and should be published
+   */
+  static bool acceptShot(LoRaSource& source, const NormalizedShotData& shot) {
+    bool restart = !source.hasShot
+                || shot.sessionId != source.sessionId
+                || (shot.isFirstShot && shot.shotNumber < source.lastShotNumber);
+    if (restart) {
+      source.sessionId = shot.sessionId;
+      source.hasShot = true;
+      source.shotWindow = 1;
+      return recordNewest(source, shot);
+    }
+
+    int16_t ahead = (int16_t)(uint16_t)(shot.shotNumber - source.lastShotNumber);
+    if (ahead > 0) {
+      source.shotWindow = ahead >= (int16_t)SHOT_WINDOW ? 1 : (source.shotWindow << ahead) | 1;
+      return recordNewest(source, shot);
+    }
+
+    uint16_t behind = (uint16_t)(-ahead);
+    uint32_t bit = behind < SHOT_WINDOW ? (1u << behind) : 0;
+    if (bit == 0 || (source.shotWindow & bit)) {
+      source.duplicates++;
+      return false;
+    }
+    source.shotWindow |= bit;  // Late but new
+    source.shots++;
+    return true;
+  }
+
+  /**
+   * Marks online sources silent for timeoutMs as offline, calling
+   * onOffline(const LoRaSource&) for each.
+   * @return number of sources that went offline
+   */
+  template <typename Callback>
+  size_t expire(uint32_t nowMs, uint32_t timeoutMs, Callback onOffline) {
+    size_t expired = 0;
+    for (size_t i = 0; i < count; i++) {
+      LoRaSource& source = entries[i];
+      if (source.online && nowMs - source.lastHeardMs >= timeoutMs) {
+        source.online = false;
+        onOffline(source);
+        expired++;
+      }
+    }
+    return expired;
+  }
+
+  // Time until expire() has an online source to time out (UINT32_MAX if none)
+  uint32_t msUntilExpiry(uint32_t nowMs, uint32_t timeoutMs) const {
+    uint32_t due = UINT32_MAX;
+    for (size_t i = 0; i < count; i++) {
+      if (!entries[i].online) continue;
+      uint32_t silent = nowMs - entries[i].lastHeardMs;
+      uint32_t left = silent >= timeoutMs ? 0 : timeoutMs - silent;
+      if (left < due) due = left;
+    }
+    return due;
+  }
+
+  size_t size() const { return count; }
+  size_t onlineCount() const {
+    size_t online = 0;
+    for (size_t i = 0; i < count; i++) online += entries[i].online ? 1 : 0;
+    return online;
+  }
+  LoRaSource& at(size_t i) { return entries[i]; }
+  const LoRaSource& at(size_t i) const { return entries[i]; }
+  uint32_t getEvictions() const { return evictions; }
+
+private:
+  static bool recordNewest(LoRaSource& source, const NormalizedShotData& shot) {
+    source.lastShotNumber = shot.shotNumber;
+    source.lastShotTimeMs = shot.absoluteTimeMs;
+    source.shots++;
+    return true;
+  }
+
+  struct IgnoreEviction {
+    void operator()(const LoRaSource&) const {}
+  };
+
+  template <typename Callback>
+  LoRaSource* allocate(Callback& onEvicted) {
+    size_t slot = count;
+    if (count < Capacity) {
+      count++;
+    } else {
+      slot = 0;
+      for (size_t i = 1; i < Capacity; i++) {
+        const LoRaSource& candidate = entries[i];
+        const LoRaSource& best = entries[slot];
+        if (candidate.online != best.online) {
+          if (!candidate.online) slot = i;  // Offline first
+        } else if (candidate.lastHeardMs - best.lastHeardMs > INT32_MAX) {
+          slot = i;  // Older (wrap-safe)
+        }
+      }
+      evictions++;
+      onEvicted(entries[slot]);
+    }
+    memset(&entries[slot], 0, sizeof(LoRaSource));
+    return &entries[slot];
+  }
+
+  LoRaSource entries[Capacity];
+  size_t count;
+  uint32_t evictions;
+};
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "AirtimeBudget.h"
+#include "LoRaArq.h"
+#include "LoRaDataRate.h"
 #include "LoRaPacket.h"
+#include "LoRaTxQueue.h"
 #include "Logger.h"
+#include "LoopScheduler.h"
+#include "common.h"
 #include <functional>
 
 /**
@@ -9,13 +15,52 @@
  *
  * Serializes NormalizedShotData and session events into LoRa packets
  * and transmits them via the SX1276 radio.
+ *
+ * The send*() methods only queue: packets wait in a LoRaTxQueue (shots and
+ * session events in order, then the heartbeat) and update() starts the next one when the
+ * radio is idle and the EU868 duty-cycle budget (AirtimeBudget) has room
+ * for its computed time on air. With LORA_TX_ASYNC, the DIO0 (TxDone) ISR
+ * wakes the main loop when the transmission ends, so the loop never
+ * blocks for the time on air.
+ *
+ * With LORA_SHOT_BATCHING, sendShotDetected() adds the shot to a pending
+ * ShotBatch instead; the batch is queued once the coalescing window
+ * closes, as soon as it is full, or ahead of any session event so the
+ * receiver sees the original order.
+ *
+ * With LORA_RELIABLE, shot and session packets are numbered as they go on
+ * air and kept in a LoRaTxHistory. Between packets the radio listens: the
+ * receiver answers each numbered packet with an ACK, and the next packet
+ * waits for it (up to LORA_ACK_TIMEOUT_MS, plus the ACK's time on air with
+ * LORA_ADAPTIVE_RATE) since the radio is half-duplex.
+ * Packets the ACK reports missing, or that stay unacknowledged, are resent
+ * before anything new.
+ *
+ * With LORA_ADAPTIVE_RATE the receiver sets the data rate: a RATE_CHANGE
+ * heard between packets switches the radio. The heartbeat is numbered too,
+ * so an idle transmitter notices a lost link: after
+ * LORA_RATE_FALLBACK_MISSES missed ACKs in a row it returns to the
+ * rendezvous rate, and if the ACKs still do not come it tries each rate in
+ * turn until one is acknowledged.
+ *
+ * With LORA_FRAME_VERSION 2 frames carry a hash of the sourceId and shots
+ * leave out the device model: a DEVICE_INFO with both goes out at start,
+ * ahead of each SESSION_STARTED and of the first shot from a new model,
+ * and every LORA_DEVICE_INFO_INTERVAL_MS for receivers that restarted.
  */
 class LoRaTransmitter {
 public:
-  bool initialize();
-  void update();  // Sends periodic heartbeat
+  LoRaTransmitter();
+
+  // scheduler is signalled (LoopEvent::LORA_TX) on TxDone; may be nullptr
+  bool initialize(LoopScheduler* scheduler = nullptr);
+  void update();  // Completes and starts transmissions, queues due shot batches and the heartbeat
 
-  // Event transmitters — called by BridgeApplication when BLE callbacks fire
+  // Time until update() has work to do (LoopScheduler::NO_DEADLINE if none)
+  uint32_t getMsUntilDue() const;
+
+  // Event transmitters — called by BridgeApplication when BLE callbacks fire.
+  // Return false if the packet was dropped (queue full).
   bool sendShotDetected(const NormalizedShotData& shot);
   bool sendSessionStarted(uint32_t sessionId, float startDelaySeconds);
   bool sendSessionStopped(uint32_t sessionId, uint16_t totalShots, uint32_t lastShotTimeMs);
@@ -24,13 +69,72 @@ public:
   bool sendSessionResumed(uint32_t sessionId);
 
   uint32_t getPacketsSent() const { return packetsSent; }
+  uint32_t getTxFailures() const { return txFailures; }
+  size_t getQueueDepth() const;
+  uint32_t getDrops() const;
+  uint32_t getAirtimeUsedMs() const { return airtime.usedUs(millis()) / 1000; }
+  uint32_t getAirtimeBudgetMs() const { return airtime.getBudgetUs() / 1000; }
+  LoRaDataRate getDataRate() const { return dataRate; }
+#if LORA_RELIABLE
+  uint32_t getRetransmits() const { return history.getRetransmits(); }
+  uint32_t getLost() const { return history.getLost(); }  // Given up unacknowledged
+  size_t getUnacknowledged() const { return history.size(); }
+#endif
 
 private:
-  bool transmitPacket(const uint8_t* data, size_t len);
+  bool enqueue(TxPriority priority, TxPacket& packet, size_t len);
+  bool flushShotBatch();
+#if LORA_FRAME_VERSION == 2
+  bool queueDeviceInfo(TxPriority priority);
+  bool announceModel(const char* model);
+#endif
+  void startNextTransmit(unsigned long now);
+  void transmit(unsigned long now);
+  void finishTransmit(bool success);
+#if LORA_RELIABLE
+  void receiveControl();  // ACK or RATE_CHANGE heard between transmissions
+#endif
+#if LORA_ADAPTIVE_RATE
+  void switchDataRate(uint8_t index);
+  void ackMissed();
+#endif
 
   char sourceId[7] = {0};  // Populated from DeviceId at initialize()
-  uint8_t txBuffer[LoRaProtocol::MAX_PACKET_SIZE];
+
+  LoRaTxQueue<LORA_TX_QUEUE_DEPTH> txQueue;
+  AirtimeBudget airtime;
+  LoopScheduler* scheduler = nullptr;
+  LoRaDataRate dataRate;  // Written under txLock (send*() read it for the airtime estimate)
+
+  // Packet on air
+  TxPacket inFlight;
+  bool transmitting = false;
+  unsigned long txStartedAt = 0;
+  uint32_t txTimeoutMs = 0;
+
+#if LORA_RELIABLE
+  LoRaTxHistory<LORA_TX_HISTORY_DEPTH> history;
+  uint16_t nextSeq = 0;             // Random at initialize()
+  bool synced = false;              // Packets carry SYNC_FLAG until the first ACK
+  bool awaitingAck = false;         // Listening for the ACK to the last packet
+  unsigned long ackWaitStartedAt = 0;
+  uint32_t ackTimeoutMs = LORA_ACK_TIMEOUT_MS;  // Longer at slow rates (LORA_ADAPTIVE_RATE)
+#endif
+#if LORA_ADAPTIVE_RATE
+  uint8_t rateIndex = LORA_RATE_RENDEZVOUS;  // LoRaRate::TABLE
+  uint8_t ackMisses = 0;                     // In a row
+  bool hunting = false;                      // Trying each rate until one is acknowledged
+#endif
+
+#if LORA_FRAME_VERSION == 2
+  char deviceModel[LoRaProtocol::MODEL_LEN + 1] = {0};  // Last sent in DEVICE_INFO
+  unsigned long deviceInfoSentAt = 0;
+#endif
+
+  LoRaProtocol::ShotBatch shotBatch;
+  unsigned long batchOpenedAt = 0;
 
   uint32_t packetsSent = 0;
+  uint32_t txFailures = 0;
   unsigned long lastHeartbeat = 0;
 };
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "LoRaPacket.h"
+#include <cstddef>
+#include <cstdint>
+
+// Transmit class. Shots and session events leave in the order they were
+// queued, so a SESSION_STARTED is never overtaken by the shots of the
+// session it starts (and the transmitter flushes its pending shot batch
+// before queuing a session event). Each class has its own depth, so a
+// session backlog cannot crowd out shots. The heartbeat waits until both
+// are empty.
+enum class TxPriority : uint8_t {
+  SHOT      = 0,
+  SESSION   = 1,
+  HEARTBEAT = 2
+};
+
+/**
+ * @brief A serialized packet waiting for the radio
+ */
+struct TxPacket {
+  uint8_t length;
+  uint8_t data[LoRaProtocol::MAX_PACKET_SIZE];
+  uint32_t airtimeUs;       // Includes the sequence number if `sequenced`
+  bool sequenced;           // Numbered and kept for retransmission when sent (LORA_RELIABLE)
+  // Shots in the packet; TraceStage::LORA_TX is recorded for each on TxDone
+  uint8_t traceCount;
+  int64_t traceOriginUs[LoRaProtocol::MAX_BATCH_SHOTS];
+};
+
+/**
+ * @brief Fixed-depth transmit queue, one FIFO per TxPriority
+ *
+ * Not thread-safe: LoRaTransmitter pushes from the BLE stack task and pops
+ * on the main loop, both under its txLock. A push onto a full level is
+ * dropped and counted; packets already queued are never displaced.
+ */
+template <size_t Depth>
+class LoRaTxQueue {
+public:
+  static constexpr size_t LEVELS = 3;
+
+  LoRaTxQueue() : nextOrder(0), drops(0) {
+    for (size_t i = 0; i < LEVELS; i++) {
+      levels[i].head = 0;
+      levels[i].count = 0;
+    }
+  }
+
+  bool push(TxPriority priority, const TxPacket& packet) {
+    Level& level = levels[(size_t)priority];
+    if (level.count == Depth) {
+      drops++;
+      return false;
+    }
+    size_t slot = (level.head + level.count) % Depth;
+    level.slots[slot] = packet;
+    level.order[slot] = nextOrder++;
+    level.count++;
+    return true;
+  }
+
+  // Oldest shot or session packet, else the heartbeat; nullptr when empty
+  const TxPacket* front() const {
+    size_t i = frontLevel();
+    return i < LEVELS ? &levels[i].slots[levels[i].head] : nullptr;
+  }
+
+  // Removes front()
+  void pop() {
+    size_t i = frontLevel();
+    if (i < LEVELS) {
+      levels[i].head = (levels[i].head + 1) % Depth;
+      levels[i].count--;
+    }
+  }
+
+  // Removes front() without sending it (e.g. it can never fit the budget)
+  void dropFront() {
+    if (front()) {
+      pop();
+      drops++;
+    }
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < LEVELS; i++) total += levels[i].count;
+    return total;
+  }
+  size_t size(TxPriority priority) const { return levels[(size_t)priority].count; }
+  uint32_t getDrops() const { return drops; }
+
+private:
+  struct Level {
+    TxPacket slots[Depth];
+    uint32_t order[Depth];  // Push order across levels (wraps)
+    size_t head;
+    size_t count;
+  };
+
+  Level levels[LEVELS];
+  uint32_t nextOrder;
+  uint32_t drops;
+
+  // Level front() comes from; LEVELS when empty
+  size_t frontLevel() const {
+    size_t best = LEVELS;
+    for (size_t i = 0; i < (size_t)TxPriority::HEARTBEAT; i++) {
+      if (levels[i].count == 0) continue;
+      if (best == LEVELS ||
+          (int32_t)(levels[i].order[levels[i].head] - levels[best].order[levels[best].head]) < 0) {
+        best = i;
+      }
+    }
+    if (best == LEVELS && levels[(size_t)TxPriority::HEARTBEAT].count > 0) {
+      best = (size_t)TxPriority::HEARTBEAT;
+    }
+    return best;
+  }
+};
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Reed-Solomon over GF(256) (primitive polynomial 0x11D, generator roots
+// α^0 .. α^(Parity-1)). Shortened codewords: up to 255 - Parity data bytes
+// followed by Parity check bytes. Corrects up to Parity / 2 byte errors at
+// unknown positions; beyond that it usually reports failure but may
+// "correct" to another codeword, so keep a CRC inside the data.
+namespace ReedSolomon {
+
+static constexpr uint16_t PRIMITIVE = 0x11D;  // x^8 + x^4 + x^3 + x^2 + 1
+static constexpr size_t MAX_CODEWORD = 255;
+
+// Multiplication and division by logarithm. EXP is doubled so the sum of
+// two logs needs no modulo. 768 B of RAM, built on first use (byte tables
+// stay in DRAM: IRAM only allows 32-bit loads on the ESP32, and DRAM is
+// just as fast uncached).
+struct GfTables {
+  uint8_t EXP[512];
+  uint8_t LOG[256];
+
+  GfTables() {
+    uint16_t x = 1;
+    for (int i = 0; i < 255; i++) {
+      EXP[i] = (uint8_t)x;
+      EXP[i + 255] = (uint8_t)x;
+      LOG[x] = (uint8_t)i;
+      x <<= 1;
+      if (x & 0x100) x ^= PRIMITIVE;
+    }
+    EXP[510] = EXP[0];
+    EXP[511] = EXP[1];
+    LOG[0] = 0;  // Undefined; callers test for zero first
+  }
+};
+
+inline const GfTables& gf() {
+  static const GfTables tables;
+  return tables;
+}
+
+inline uint8_t mul(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) return 0;
+  const GfTables& t = gf();
+  return t.EXP[t.LOG[a] + t.LOG[b]];
+}
+
+// b must not be 0
+inline uint8_t div(uint8_t a, uint8_t b) {
+  if (a == 0) return 0;
+  const GfTables& t = gf();
+  return t.EXP[t.LOG[a] + 255 - t.LOG[b]];
+}
+
+// α^power
+inline uint8_t alphaPow(unsigned power) {
+  return gf().EXP[power % 255];
+}
+
+/**
+ * @brief Systematic encoder / errors-only decoder with Parity check bytes
+ *
+ * Stateless after construction (the generator polynomial); share one
+ * instance. Decoding uses about 3 × Parity bytes of stack.
+ */
+template <size_t Parity>
+class Codec {
+  static_assert(Parity >= 2 && Parity % 2 == 0 && Parity < MAX_CODEWORD,
+                "Parity must be even and leave room for data");
+
+public:
+  static constexpr size_t PARITY = Parity;
+  static constexpr size_t MAX_DATA = MAX_CODEWORD - Parity;
+  static constexpr size_t CORRECTABLE = Parity / 2;
+
+  Codec() {
+    // g(x) = (x - α^0)(x - α^1)...(x - α^(Parity-1)), highest power first
+    memset(generator, 0, sizeof(generator));
+    generator[0] = 1;
+    for (size_t i = 0; i < Parity; i++) {
+      uint8_t root = alphaPow(i);
+      for (size_t j = i + 1; j > 0; j--) {
+        generator[j] ^= mul(generator[j - 1], root);
+      }
+    }
+  }
+
+  /**
+   * Computes the check bytes for `len` data bytes (len <= MAX_DATA) into
+   * `parity`, which may directly follow the data.
+   */
+  void encode(const uint8_t* data, size_t len, uint8_t* parity) const {
+    uint8_t remainder[Parity] = {0};
+    for (size_t i = 0; i < len; i++) {
+      uint8_t feedback = data[i] ^ remainder[0];
+      memmove(remainder, remainder + 1, Parity - 1);
+      remainder[Parity - 1] = 0;
+      if (feedback == 0) continue;
+      for (size_t j = 0; j < Parity; j++) {
+        remainder[j] ^= mul(feedback, generator[j + 1]);
+      }
+    }
+    memcpy(parity, remainder, Parity);
+  }
+
+  /**
+   * Corrects `codeword` (data followed by the Parity check bytes, `len` in
+   * total) in place.
+   * @return bytes corrected (0 = intact), or -1 if there are more errors
+   *         than CORRECTABLE (the codeword is left unchanged)
+   */
+  int decode(uint8_t* codeword, size_t len) const {
+    if (len <= Parity || len > MAX_CODEWORD) return -1;
+
+    // Syndromes S_j = c(α^j); all zero for a codeword
+    uint8_t syndromes[Parity];
+    bool intact = true;
+    for (size_t j = 0; j < Parity; j++) {
+      uint8_t root = alphaPow(j);
+      uint8_t s = 0;
+      for (size_t i = 0; i < len; i++) s = mul(s, root) ^ codeword[i];
+      syndromes[j] = s;
+      if (s != 0) intact = false;
+    }
+    if (intact) return 0;
+
+    // Berlekamp-Massey: error locator Λ(x), lowest power first
+    uint8_t locator[Parity + 1] = {1};
+    uint8_t previous[Parity + 1] = {1};
+    size_t errors = 0;
+    size_t shift = 1;
+    uint8_t previousDiscrepancy = 1;
+    for (size_t n = 0; n < Parity; n++) {
+      uint8_t discrepancy = syndromes[n];
+      for (size_t i = 1; i <= errors; i++) discrepancy ^= mul(locator[i], syndromes[n - i]);
+      if (discrepancy == 0) {
+        shift++;
+        continue;
+      }
+      uint8_t scale = div(discrepancy, previousDiscrepancy);
+      uint8_t saved[Parity + 1];
+      memcpy(saved, locator, sizeof(saved));
+      for (size_t i = 0; i + shift <= Parity; i++) locator[i + shift] ^= mul(scale, previous[i]);
+      if (2 * errors <= n) {
+        errors = n + 1 - errors;
+        memcpy(previous, saved, sizeof(previous));
+        previousDiscrepancy = discrepancy;
+        shift = 1;
+      } else {
+        shift++;
+      }
+    }
+    if (errors > CORRECTABLE) return -1;
+
+    // Error evaluator Ω(x) = S(x)Λ(x) mod x^Parity
+    uint8_t evaluator[Parity] = {0};
+    for (size_t i = 0; i < Parity; i++) {
+      for (size_t j = 0; j <= i && j <= errors; j++) evaluator[i] ^= mul(locator[j], syndromes[i - j]);
+    }
+
+    // Chien search: byte i is wrong if Λ(X^-1) = 0 for X = α^(len-1-i);
+    // Forney gives its error value X Ω(X^-1) / Λ'(X^-1)
+    size_t positions[CORRECTABLE];
+    uint8_t values[CORRECTABLE];
+    size_t found = 0;
+    for (size_t i = 0; i < len; i++) {
+      unsigned power = (unsigned)(len - 1 - i);
+      uint8_t xInverse = alphaPow(255 - power);
+      if (evaluate(locator, errors + 1, xInverse) != 0) continue;
+      if (found == errors) return -1;
+
+      // Formal derivative: odd powers only (2 = 0 in GF(2^8))
+      uint8_t derivative = 0;
+      uint8_t xInverseSquared = mul(xInverse, xInverse);
+      uint8_t term = 1;
+      for (size_t k = 1; k <= errors; k += 2) {
+        derivative ^= mul(locator[k], term);
+        term = mul(term, xInverseSquared);
+      }
+      if (derivative == 0) return -1;
+      uint8_t omega = evaluate(evaluator, Parity, xInverse);
+      positions[found] = i;
+      values[found] = mul(alphaPow(power), div(omega, derivative));
+      found++;
+    }
+    // Fewer roots than the locator's degree: the errors lie outside the
+    // (shortened) codeword
+    if (found != errors) return -1;
+
+    for (size_t k = 0; k < found; k++) codeword[positions[k]] ^= values[k];
+    return (int)found;
+  }
+
+private:
+  uint8_t generator[Parity + 1];
+
+  // Polynomial with `count` coefficients, lowest power first, at x
+  static uint8_t evaluate(const uint8_t* poly, size_t count, uint8_t x) {
+    uint8_t result = 0;
+    for (size_t i = count; i > 0; i--) result = mul(result, x) ^ poly[i - 1];
+    return result;
+  }
+};
+
+}  // namespace ReedSolomon
@@ -40,6 +40,12 @@ enum class ReceiverOutputMode : uint8_t {
 #define LORA_SYNC_WORD        0x77     // Private network sync word (avoid LoRaWAN 0x34/0x12)
 #define LORA_PREAMBLE_LENGTH  8        // Default preamble length
 
+// Application-layer CRC-16/CCITT implementation (all bit-exact, see Crc16.h)
+#define LORA_CRC16_BITWISE 0   // 8 shift/XOR steps per byte, no table
+#define LORA_CRC16_TABLE   1   // 256-entry table, 512 B flash
+#define LORA_CRC16_SLICE4  2   // Slice-by-4, 2 KB RAM tables
+#define LORA_CRC16_IMPL    LORA_CRC16_TABLE
+
 // =============================================================================
 // LoRa32 T3 v1.6.1 — SPI pin mapping for SX1276
 // =============================================================================
@@ -63,9 +69,95 @@ enum class ReceiverOutputMode : uint8_t {
 // =============================================================================
 // Timing Configuration
 // =============================================================================
-#define MAIN_LOOP_DELAY          10   // ms — main loop yield
+#define MAIN_LOOP_DELAY          10   // ms — main loop yield (legacy loop / portal active)
 #define LORA_HEARTBEAT_INTERVAL  30000 // ms — transmitter heartbeat packet
-#define LORA_RX_POLL_INTERVAL    0     // ms — 0 = poll every loop iteration
+#define LORA_RX_POLL_INTERVAL    20    // ms — RX_SINGLE re-arm period (legacy polled receive only)
+
+// 1 = shots are coalesced into SHOT_BATCH packets: the batch goes out this
+// long after its first shot, when full, or before any other packet. Off by
+// default like LORA_FRAME_VERSION 2: receivers without SHOT_BATCH support
+// drop it as an unknown type, so enable only once every receiver is updated.
+// 0 = one SHOT_DETECTED packet per shot, sent immediately
+#define LORA_SHOT_BATCHING       0
+#define LORA_SHOT_BATCH_WINDOW_MS 250  // ms — max delay added to a shot (pairs 220 ms splits)
+
+// LoRa transmit path: packets wait in a queue (shots and session events
+// in order, then the heartbeat) until the radio is free and the duty-cycle
+// budget allows them; DIO0 (TxDone) completes each transmission.
+// 0 = endPacket() blocks the loop for the whole time on air (before/after comparison)
+#define LORA_TX_ASYNC             1
+#define LORA_TX_QUEUE_DEPTH       4        // Packets per priority level
+#define LORA_TX_TIMEOUT_MARGIN_MS 50       // ms — added to the time on air before a TX is abandoned
+#define LORA_DUTY_CYCLE_PERMILLE  10       // 1 % — EU868 sub-band 868.0–868.6 MHz; 1000 = no limit
+#define LORA_DUTY_CYCLE_WINDOW_MS 3600000  // ms — ETSI EN 300 220 observation period (1 h)
+
+// Reliable link: shot and session packets carry a per-transmitter sequence
+// number, the receiver answers each with an ACK (cumulative + selective
+// bitmap) and the transmitter resends from its TX history what was NACKed
+// or not acknowledged in time. The transmitter listens between packets and
+// the receiver transmits ACKs, both within the duty-cycle budget. Both ends
+// must agree. 0 = fire-and-forget, the receiver never transmits
+#define LORA_RELIABLE            0
+#define LORA_TX_HISTORY_DEPTH    8     // Sequenced packets kept for retransmission
+#define LORA_ACK_TIMEOUT_MS      250   // ms — resend if not acknowledged by then; no new packet meanwhile
+#define LORA_MAX_TRANSMISSIONS   4     // Per packet (first send + 3 retries), then it is counted lost
+
+// Adaptive data rate (needs LORA_RELIABLE): the receiver steps the link's
+// SF/BW through LoRaRate::TABLE (DR0 = SF7/500 kHz ... DR5 = SF12/125 kHz)
+// by the signal margin of its weakest online transmitter and announces
+// each change in a RATE_CHANGE packet. Both ends start at the rendezvous
+// rate; a transmitter whose ACKs stop returns there, then tries the
+// others. 0 = LORA_SPREADING_FACTOR / LORA_BANDWIDTH only
+#define LORA_ADAPTIVE_RATE        0
+#define LORA_RATE_RENDEZVOUS      3      // DR3 = SF10/250 kHz
+#define LORA_RATE_MARGIN_DB       10     // dB above sensitivity kept for the weakest source
+#define LORA_RATE_HYSTERESIS_DB   3      // dB extra needed to step faster
+#define LORA_RATE_HOLD_MS         60000  // ms — at a rate before stepping faster
+#define LORA_RATE_ANNOUNCEMENTS   2      // RATE_CHANGE packets per change
+#define LORA_RATE_FALLBACK_MISSES 2      // Missed ACKs in a row before a transmitter falls back
+#define LORA_RATE_FALLBACK_MS     (LORA_HEARTBEAT_INTERVAL + 10000)  // ms — source silent after a change: receiver falls back
+
+// Forward error correction: every frame (ACKs too) carries LORA_FEC_PARITY
+// Reed-Solomon check bytes and up to half that many corrupted bytes are
+// repaired instead of failing the CRC-16 (see LoRaFec.h). The SX1276 payload
+// CRC is switched off so damaged packets reach the decoder. Both ends must
+// agree. 0 = CRC-16 only
+#define LORA_FEC                  0
+#define LORA_FEC_PARITY           8      // Check bytes per frame (even); corrects 4
+
+// Frame format sent (see LoRaPacket.h); receivers decode both. 2 = compact:
+// a 2-byte hash of the sourceId, varint times and counts, and the device
+// model only in a DEVICE_INFO packet the receiver caches (a SHOT_BATCH of
+// one shot: 36 -> 17 bytes). Receivers must run firmware that knows v2.
+// 1 = full sourceId and model in every frame
+#define LORA_FRAME_VERSION           1
+#define LORA_DEVICE_INFO_INTERVAL_MS 300000  // ms — v2: DEVICE_INFO repeated for receivers that restarted
+
+// LoRa receive path: DIO0 (RxDone) ISR wakes a drain task that burst-reads the
+// FIFO into a packet ring; the main loop decodes and dispatches.
+// 0 = legacy parsePacket() polling in RX_SINGLE (before/after comparison)
+#define LORA_RX_INTERRUPT_DRIVEN 1
+#define LORA_RX_RING_SIZE        8     // Raw packets queued for the main loop (power of 2)
+#define LORA_RX_TASK_CORE        1     // Same core as the main loop; preempts it on RxDone
+#define LORA_RX_TASK_PRIORITY    5     // Above loopTask (1)
+#define LORA_RX_TASK_STACK_SIZE  3072
+#define LORA_RX_IRQ_RECHECK_MS   1000  // Drain task re-reads IRQ flags at least this often (missed edge guard)
+
+// Receiver serves several transmitters: each sourceId gets its own session,
+// shot de-duplication and timer/<sourceId>/ MQTT topics
+#define LORA_MAX_SOURCES         16    // Transmitters tracked; when full, the least recently heard offline one is evicted first
+#define LORA_SOURCE_TIMEOUT_MS   (3 * LORA_HEARTBEAT_INTERVAL)  // Silent this long = offline
+
+// Event-driven main loop: block until DIO0 / BLE callbacks signal or the next
+// deadline is due. 0 = legacy fixed MAIN_LOOP_DELAY yield (before/after
+// comparison, -DEVENT_DRIVEN_LOOP=0)
+#ifndef EVENT_DRIVEN_LOOP
+#define EVENT_DRIVEN_LOOP        1
+#endif
+#define MAIN_LOOP_IDLE_MAX_WAIT  100   // ms — longest idle block (MQTT keepalive/reconnect polling)
+
+// Per-stage shot latency histograms (BLE notify -> parse -> LoRa TX), see ShotTrace.h
+#define SHOT_TRACE_ENABLED       1
 
 // Startup delay — shorter for debug builds
 #ifdef DEBUG_BUILD
@@ -100,6 +192,11 @@ enum class ReceiverOutputMode : uint8_t {
 #define MQTT_USER        ""
 #define MQTT_PASSWORD    ""
 
+// Event payload encoding - JSON (PWA) or compact MessagePack, see MqttBinaryPayload.h
+#define MQTT_PAYLOAD_FORMAT_JSON    0
+#define MQTT_PAYLOAD_FORMAT_MSGPACK 1
+#define MQTT_PAYLOAD_FORMAT         MQTT_PAYLOAD_FORMAT_JSON
+
 // =============================================================================
 // Protocol Constants (shared with ESP32-S3-firmware)
 // =============================================================================
@@ -9,27 +9,49 @@
 
 namespace {
 BridgeApplication* gBridgeInstance = nullptr;
+LoopScheduler* gLoopScheduler = nullptr;  // For the legacy DIO0 ISR and BLE scan callback
 volatile bool gBleScanResultsReady = false;
 
+constexpr unsigned long LOOP_STATS_INTERVAL_MS = 5000;
+
 void onBleScanComplete(BLEScanResults /*results*/) {
   gBleScanResultsReady = true;
+  if (gLoopScheduler) gLoopScheduler->signal(LoopEvent::BLE_EVENT);
+}
+
+#if !LORA_RX_INTERRUPT_DRIVEN
+// SX1276 DIO0 = RxDone in receive mode — wake the main loop to poll the FIFO
+// (the interrupt-driven path has its own ISR in LoRaReceiver)
+void IRAM_ATTR onLoRaDio0() {
+  if (gLoopScheduler) gLoopScheduler->signalFromISR(LoopEvent::LORA_RX);
 }
+#endif
 }  // namespace
 
 BridgeApplication::BridgeApplication()
   : role(BridgeRole::TRANSMITTER),
-    outputMode(ReceiverOutputMode::MQTT_OUTPUT) {
+    outputMode(ReceiverOutputMode::MQTT_OUTPUT)
+#if LORA_ADAPTIVE_RATE
+    , rateController(LORA_RATE_RENDEZVOUS, LORA_RATE_MARGIN_DB * 10, LORA_RATE_HYSTERESIS_DB * 10,
+                     LORA_RATE_HOLD_MS, LORA_RATE_FALLBACK_MS)
+#endif
+{
   gBridgeInstance = this;
+  gLoopScheduler = &scheduler;
 }
 
 BridgeApplication::~BridgeApplication() {
   if (gBridgeInstance == this) gBridgeInstance = nullptr;
+  if (gLoopScheduler == &scheduler) gLoopScheduler = nullptr;
 }
 
 bool BridgeApplication::initialize() {
   Serial.begin(SERIAL_BAUD_RATE);
   Logger::setLevel(LogLevel::INFO);
 
+  // Main loop task (setup() and loop() share it)
+  scheduler.bind();
+
   LOG_SYSTEM("=== J.K. PewPew Long Range Bridge ===");
   LOG_SYSTEM("LilyGo LoRa32 T3 v1.6.1 Starting...");
 
@@ -86,7 +108,8 @@ void BridgeApplication::initTransmitter() {
   LOG_BLE("BLE Client initialized as: %s", bleName);
 
   // Initialize LoRa transmitter
-  if (!loraTx.initialize()) {
+  // TxDone wakes the loop (LoopEvent::LORA_TX)
+  if (!loraTx.initialize(&scheduler)) {
     LOG_ERROR("SYSTEM", "LoRa TX init failed");
   }
 
@@ -99,11 +122,18 @@ void BridgeApplication::initTransmitter() {
 
 void BridgeApplication::initReceiver() {
   // Initialize LoRa receiver
-  if (!loraRx.initialize()) {
+  // Queued packets wake the loop (LoopEvent::LORA_RX)
+  if (!loraRx.initialize(&scheduler)) {
     LOG_ERROR("SYSTEM", "LoRa RX init failed");
   }
   setupLoRaCallbacks();
 
+#if EVENT_DRIVEN_LOOP && !LORA_RX_INTERRUPT_DRIVEN
+  // RxDone wakes the loop immediately; LORA_RX_POLL_INTERVAL is only the re-arm period
+  pinMode(LORA_DIO0_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(LORA_DIO0_PIN), onLoRaDio0, RISING);
+#endif
+
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
     // MQTT output — needs WiFi
     mqttManager = std::unique_ptr<MqttManager>(new MqttManager());
@@ -142,8 +172,110 @@ void BridgeApplication::run() {
   updateOledStatus();
   oled.update(bridgeStatus);
 
-  // Yield to FreeRTOS
-  vTaskDelay(pdMS_TO_TICKS(MAIN_LOOP_DELAY));
+  // Phase 4: Loop diagnostics
+  unsigned long now = millis();
+  if (now - lastLoopStatsLog >= LOOP_STATS_INTERVAL_MS) {
+    lastLoopStatsLog = now;
+    LoopScheduler::Stats loopStats = scheduler.takeStats();
+    LOG_DEBUG("HEALTH", "Loop: %lu wakes (%lu event, %lu deadline) in %lu ms",
+              (unsigned long)loopStats.wakes,
+              (unsigned long)loopStats.eventWakes,
+              (unsigned long)loopStats.deadlineWakes,
+              (unsigned long)loopStats.windowMs);
+
+    // Receive losses before decode (receiver)
+    if (role == BridgeRole::RECEIVER) {
+      uint32_t overruns = loraRx.getFifoOverruns() + loraRx.getRingOverruns();
+      if (overruns != lastReportedRxOverruns) {
+        lastReportedRxOverruns = overruns;
+        LOG_WARN("LORA", "RX overruns: %lu FIFO, %lu ring (%lu received)",
+                 (unsigned long)loraRx.getFifoOverruns(),
+                 (unsigned long)loraRx.getRingOverruns(),
+                 (unsigned long)loraRx.getPacketsReceived());
+      }
+      logSources();  // Per-transmitter link state
+#if LORA_RELIABLE
+      LOG_DEBUG("HEALTH", "Reliable link: %lu ACKs sent", (unsigned long)loraRx.getAcksSent());
+#endif
+#if LORA_FEC
+      LOG_DEBUG("HEALTH", "FEC: %lu packets repaired (%lu bytes), %lu errors",
+                (unsigned long)loraRx.getFecRepairs(),
+                (unsigned long)loraRx.getFecBytesCorrected(),
+                (unsigned long)loraRx.getCrcErrors());
+#endif
+#if LORA_ADAPTIVE_RATE
+      LOG_DEBUG("HEALTH", "Data rate: DR%u (SF%u/%lukHz)", (unsigned)rateController.current(),
+                (unsigned)loraRx.getDataRate().spreadingFactor,
+                (unsigned long)(loraRx.getDataRate().bandwidthHz / 1000));
+#endif
+    }
+
+    // Transmit losses (transmitter)
+    if (role == BridgeRole::TRANSMITTER) {
+      uint32_t txLosses = loraTx.getDrops() + loraTx.getTxFailures();
+#if LORA_RELIABLE
+      txLosses += loraTx.getLost();
+#endif
+      if (txLosses != lastReportedTxLosses) {
+        lastReportedTxLosses = txLosses;
+        LOG_WARN("LORA", "TX losses: %lu dropped, %lu failed (%lu sent, airtime %lu/%lu ms)",
+                 (unsigned long)loraTx.getDrops(),
+                 (unsigned long)loraTx.getTxFailures(),
+                 (unsigned long)loraTx.getPacketsSent(),
+                 (unsigned long)loraTx.getAirtimeUsedMs(),
+                 (unsigned long)loraTx.getAirtimeBudgetMs());
+      }
+#if LORA_RELIABLE
+      LOG_DEBUG("HEALTH", "Reliable link: %lu resent, %lu lost, %u awaiting ACK",
+                (unsigned long)loraTx.getRetransmits(),
+                (unsigned long)loraTx.getLost(),
+                (unsigned)loraTx.getUnacknowledged());
+#endif
+    }
+
+    // Shot latency (transmitter: BLE notify -> parse -> LoRa TX)
+    uint32_t traceSamples = ShotTrace::getTotalSamples();
+    if (traceSamples > 0 && traceSamples != lastReportedTraceSamples) {
+      lastReportedTraceSamples = traceSamples;
+      ShotTrace::logSummary();
+    }
+  }
+
+  // Phase 5: Block until the next event or deadline
+  waitForNextEvent();
+}
+
+void BridgeApplication::waitForNextEvent() {
+#if EVENT_DRIVEN_LOOP
+  // Portal and scan handling are still polled — keep the legacy cadence there
+  if (BridgeWiFiConfig::isPortalActive() || isScanning) {
+    scheduler.scheduleIn(MAIN_LOOP_DELAY);
+  }
+
+#if !LORA_RX_INTERRUPT_DRIVEN
+  // parsePacket() runs the radio in RX_SINGLE, which times out after a few
+  // symbols — re-arm periodically; DIO0 ends the wait as soon as a packet lands
+  if (role == BridgeRole::RECEIVER) {
+    scheduler.scheduleIn(LORA_RX_POLL_INTERVAL);
+  }
+#endif
+
+  if (role == BridgeRole::TRANSMITTER) {
+    scheduler.scheduleIn(loraTx.getMsUntilDue());
+  } else {
+    scheduler.scheduleIn(loraSources.msUntilExpiry(millis(), LORA_SOURCE_TIMEOUT_MS));
+#if LORA_ADAPTIVE_RATE
+    scheduler.scheduleIn(rateController.msUntilFallback(loraSources, millis()));
+#endif
+  }
+
+  // OLED footer shows uptime in whole seconds
+  scheduler.scheduleIn(1000 - (millis() % 1000));
+
+  scheduler.wait(MAIN_LOOP_IDLE_MAX_WAIT);
+#else
+  scheduler.sleepFixed(MAIN_LOOP_DELAY);
+#endif
 }
 
 // ═════════════════════════════════════════════════════════════
@@ -273,21 +405,29 @@ void BridgeApplication::setupBleCallbacks() {
   ITimerDevice* dev = timerDevice.get();
   if (!dev) return;
 
-  dev->onShotDetected([this](const NormalizedShotData& s) { onShotDetected(s); });
+  // Handlers run on the BLE stack task; signal so the OLED reflects the change immediately
+  dev->onShotDetected([this](const NormalizedShotData& s) {
+    onShotDetected(s);
+    scheduler.signal(LoopEvent::DISPLAY_FRAME);
+  });
   dev->onSessionStarted([this](const SessionData& s) { onSessionStarted(s); });
   dev->onCountdownComplete([this](const SessionData& s) { onCountdownComplete(s); });
   dev->onSessionStopped([this](const SessionData& s) { onSessionStopped(s); });
   dev->onSessionSuspended([this](const SessionData& s) { onSessionSuspended(s); });
   dev->onSessionResumed([this](const SessionData& s) { onSessionResumed(s); });
-  dev->onConnectionStateChanged([this](DeviceConnectionState st) { onConnectionStateChanged(st); });
+  dev->onConnectionStateChanged([this](DeviceConnectionState st) {
+    onConnectionStateChanged(st);
+    scheduler.signal(LoopEvent::BLE_EVENT);
+  });
 }
 
 // ─── BLE event handlers → LoRa TX ───────────────────────────
 
 void BridgeApplication::onShotDetected(const NormalizedShotData& shot) {
+  ShotTrace::record(TraceStage::PARSED, shot.traceOriginUs);
   LOG_TIMER("Shot #%d: %.3fs (split: %.3fs)",
             shot.shotNumber, shot.absoluteTimeMs / 1000.0, shot.splitTimeMs / 1000.0);
-  loraTx.sendShotDetected(shot);
+  loraTx.sendShotDetected(shot);  // Records TraceStage::LORA_TX once the packet is sent
   bridgeStatus.shotsTx++;
   bridgeStatus.hasLastShot = true;
   bridgeStatus.lastShotNumber = shot.shotNumber;
@@ -297,6 +437,8 @@ void BridgeApplication::onShotDetected(const NormalizedShotData& shot) {
 
 void BridgeApplication::onSessionStarted(const SessionData& session) {
   LOG_TIMER("Session started: ID %u, delay %.1fs", session.sessionId, session.startDelaySeconds);
+  ShotTrace::reset();
+  lastReportedTraceSamples = 0;
   loraTx.sendSessionStarted(session.sessionId, session.startDelaySeconds);
   lastActivityTime = millis();
 }
@@ -341,8 +483,15 @@ void BridgeApplication::onConnectionStateChanged(DeviceConnectionState state) {
 // ═════════════════════════════════════════════════════════════
 
 void BridgeApplication::runReceiver() {
-  // Poll LoRa radio
+  // Decode packets drained by the LoRa RX task (or poll, in legacy mode)
   loraRx.update();
+#if LORA_RELIABLE
+  sendDueAcks();  // Those the busy mailbox held back
+#endif
+#if LORA_ADAPTIVE_RATE
+  adaptDataRate();  // After the ACKs: they are what the transmitters wait for
+#endif
+  expireSources();
 
   // Output-specific maintenance
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
@@ -353,6 +502,7 @@ void BridgeApplication::runReceiver() {
 }
 
 void BridgeApplication::setupLoRaCallbacks() {
+  loraRx.onPacketReceived([this](LoRaProtocol::ParsedPacket& p) { return onLoRaPacket(p); });
   loraRx.onShotReceived([this](const LoRaProtocol::ParsedPacket& p) { onLoRaShotReceived(p); });
   loraRx.onSessionStarted([this](const LoRaProtocol::ParsedPacket& p) { onLoRaSessionStarted(p); });
   loraRx.onSessionStopped([this](const LoRaProtocol::ParsedPacket& p) { onLoRaSessionStopped(p); });
@@ -361,13 +511,169 @@ void BridgeApplication::setupLoRaCallbacks() {
   loraRx.onSessionResumed([this](const LoRaProtocol::ParsedPacket& p) { onLoRaSessionResumed(p); });
   loraRx.onHeartbeatReceived([this](const LoRaProtocol::ParsedPacket& p) {
     LOG_DEBUG("LORA", "Heartbeat from %s (uptime %lu ms)", p.sourceId, (unsigned long)p.uptimeMs);
-    lastActivityTime = millis();
+    loraSources.recordHeartbeat(*packetSource, millis(), p.uptimeMs);
   });
 }
 
+// ─── Per-transmitter sessions ───────────────────────────────
+
+bool BridgeApplication::onLoRaPacket(LoRaProtocol::ParsedPacket& pkt) {
+  if (pkt.version == LoRaProtocol::FRAME_V2) resolveSource(pkt);
+  packetSource = &touchSource(pkt);
+#if LORA_ADAPTIVE_RATE
+  LoRaRateController::record(*packetSource, loraRx.getLastRssi(), loraRx.getLastSnr());
+#endif
+#if LORA_RELIABLE
+  if (pkt.sequenced) {
+    LoRaSource& source = *packetSource;
+    bool fresh = source.rxWindow.accept(pkt.seq, pkt.sync);
+    source.ackDue = true;  // Duplicates too: the ACK to the original may have been lost
+    sendDueAcks();         // Now, before publishing: the transmitter is waiting
+    if (!fresh) {
+      source.duplicates++;
+      bridgeStatus.duplicates++;
+      LOG_DEBUG("LORA", "Retransmission seq %u from %s dropped", pkt.seq, source.id);
+      return false;
+    }
+  }
+#endif
+  if (pkt.type == LoRaProtocol::PacketType::DEVICE_INFO &&
+      strncmp(packetSource->model, pkt.shot.deviceModel, LoRaProtocol::MODEL_LEN) != 0) {
+    strncpy(packetSource->model, pkt.shot.deviceModel, LoRaProtocol::MODEL_LEN);
+    packetSource->model[LoRaProtocol::MODEL_LEN] = '\0';
+    LOG_INFO("LORA", "Source %s timer: %s", packetSource->id,
+             packetSource->model[0] ? packetSource->model : "(none)");
+  }
+  return true;
+}
+
+// v2 frames carry only a hash of the sourceId: put back the id (and, for
+// shots, the device model) the source's DEVICE_INFO told us. Until then the
+// source goes by its placeholder id.
+void BridgeApplication::resolveSource(LoRaProtocol::ParsedPacket& pkt) {
+  if (pkt.type == LoRaProtocol::PacketType::DEVICE_INFO) {
+    char placeholder[LoRaProtocol::SOURCE_ID_LEN + 1];
+    LoRaProtocol::placeholderId(pkt.sourceHash, placeholder);
+    if (!loraSources.rename(placeholder, pkt.sourceId)) return;
+    LOG_INFO("LORA", "Source %s is %s", placeholder, pkt.sourceId);
+    if (outputMode == ReceiverOutputMode::MQTT_OUTPUT && mqttManager && mqttManager->canPublish()) {
+      mqttManager->publishSourcePresence(placeholder, false);
+      mqttManager->publishSourcePresence(pkt.sourceId, true);
+    }
+    return;
+  }
+
+  const LoRaSource* source = loraSources.findByHash(pkt.sourceHash);
+  if (!source) return;
+  memcpy(pkt.sourceId, source->id, sizeof(pkt.sourceId));
+  if (pkt.type == LoRaProtocol::PacketType::SHOT_DETECTED ||
+      pkt.type == LoRaProtocol::PacketType::SHOT_BATCH) {
+    memcpy(pkt.shot.deviceModel, source->model, sizeof(source->model));
+  }
+}
+
+LoRaSource& BridgeApplication::touchSource(const LoRaProtocol::ParsedPacket& pkt) {
+  LoRaSource& source = loraSources.touch(pkt.sourceId, millis(), loraRx.getLastRssi(),
+                                        [this](const LoRaSource& evicted) {
+    LOG_WARN("LORA", "Source table full (%u) - evicted %s source %s", (unsigned)LORA_MAX_SOURCES,
+             evicted.online ? "online" : "offline", evicted.id);
+    if (evicted.online) publishSourceOffline(evicted);
+  });
+  source.hash = pkt.sourceHash;
+  source.frameVersion = pkt.version;
+  lastActivityTime = millis();
+
+  if (!source.online) {
+    source.online = true;
+    LOG_INFO("LORA", "Source %s online (RSSI %d dBm, %u/%u online)", source.id, source.lastRssi,
+             (unsigned)loraSources.onlineCount(), (unsigned)loraSources.size());
+    if (outputMode == ReceiverOutputMode::MQTT_OUTPUT && mqttManager && mqttManager->canPublish()) {
+      mqttManager->publishSourcePresence(source.id, true);
+    }
+  }
+  return source;
+}
+
+#if LORA_RELIABLE
+void BridgeApplication::sendDueAcks() {
+  for (size_t i = 0; i < loraSources.size() && loraRx.canTransmit(); i++) {
+    LoRaSource& source = loraSources.at(i);
+    if (!source.ackDue) continue;
+    source.ackDue = false;
+    // Out of budget: the transmitter resends and gets the next ACK
+    if (!loraRx.sendAck(source.id, source.rxWindow.base, source.rxWindow.mask, source.frameVersion)) {
+      LOG_WARN("LORA", "No duty-cycle budget for the ACK to %s", source.id);
+    }
+  }
+}
+#endif
+
+#if LORA_ADAPTIVE_RATE
+void BridgeApplication::adaptDataRate() {
+  if (!loraRx.canTransmit()) return;
+  unsigned long now = millis();
+
+  // A source silent since the last change may have missed it: meet at the
+  // rendezvous rate, where a transmitter without ACKs goes too
+  if (rateController.fallbackDue(loraSources, now)) {
+    uint8_t rendezvous = rateController.getRendezvous();
+    if (loraRx.setDataRate(rendezvous)) {
+      LOG_WARN("LORA", "Source silent after the rate change - back to DR%u", (unsigned)rendezvous);
+      rateController.changed(loraSources, rendezvous, now);
+    }
+    return;
+  }
+
+  int next = rateController.decide(loraSources, now);
+  if (next == LoRaRateController::NO_CHANGE) return;
+  // Out of budget: decided again on the next packet
+  if (loraRx.announceDataRate((uint8_t)next)) {
+    LOG_INFO("LORA", "Data rate DR%u -> DR%d (SF%u/%lukHz)", (unsigned)rateController.current(), next,
+             (unsigned)LoRaRate::TABLE[next].spreadingFactor,
+             (unsigned long)(LoRaRate::TABLE[next].bandwidthHz / 1000));
+    rateController.changed(loraSources, (uint8_t)next, now);
+  }
+}
+#endif
+
+void BridgeApplication::expireSources() {
+  loraSources.expire(millis(), LORA_SOURCE_TIMEOUT_MS, [this](const LoRaSource& source) {
+    LOG_WARN("LORA", "Source %s offline (silent %lu s)",
+             source.id, (unsigned long)((millis() - source.lastHeardMs) / 1000));
+    publishSourceOffline(source);
+  });
+}
+
+void BridgeApplication::publishSourceOffline(const LoRaSource& source) {
+  if (outputMode == ReceiverOutputMode::MQTT_OUTPUT && mqttManager && mqttManager->canPublish()) {
+    mqttManager->publishSourcePresence(source.id, false);
+  }
+}
+
+void BridgeApplication::logSources() {
+  unsigned long now = millis();
+  for (size_t i = 0; i < loraSources.size(); i++) {
+    const LoRaSource& source = loraSources.at(i);
+    LOG_DEBUG("HEALTH", "Source %s %s: RSSI %d dBm, heard %lu s ago, heartbeat %s%lu s ago, "
+              "session %lu shot #%u, %lu shots %lu dup",
+              source.id, source.online ? "online" : "offline", source.lastRssi,
+              (unsigned long)((now - source.lastHeardMs) / 1000),
+              source.lastHeartbeatMs ? "" : "never/",
+              (unsigned long)(source.lastHeartbeatMs ? (now - source.lastHeartbeatMs) / 1000 : 0),
+              (unsigned long)source.sessionId, source.lastShotNumber,
+              (unsigned long)source.shots, (unsigned long)source.duplicates);
+  }
+}
+
 // ─── LoRa RX event handlers → MQTT or BLE ───────────────────
 
 void BridgeApplication::onLoRaShotReceived(const LoRaProtocol::ParsedPacket& pkt) {
+  if (!loraSources.acceptShot(*packetSource, pkt.shot)) {
+    bridgeStatus.duplicates++;
+    LOG_DEBUG("LORA", "Duplicate shot #%u from %s dropped", pkt.shot.shotNumber, pkt.sourceId);
+    return;
+  }
+
   LOG_TIMER("LoRa RX shot #%d: %.3fs (split: %.3fs) from %s",
             pkt.shot.shotNumber,
             pkt.shot.absoluteTimeMs / 1000.0,
@@ -378,11 +684,10 @@ void BridgeApplication::onLoRaShotReceived(const LoRaProtocol::ParsedPacket& pkt
   bridgeStatus.lastShotNumber = pkt.shot.shotNumber;
   bridgeStatus.lastShotTimeMs = pkt.shot.absoluteTimeMs;
   bridgeStatus.shotsRx++;
-  lastActivityTime = millis();
 
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
     if (mqttManager && mqttManager->canPublish()) {
-      mqttManager->publishShotDetected(pkt.shot);
+      mqttManager->publishShotDetected(pkt.shot, 0, pkt.sourceId);
     }
   } else {
     bleServer.sendShotDetected(pkt.shot.absoluteTimeMs, pkt.shot.shotNumber);
@@ -391,11 +696,11 @@ void BridgeApplication::onLoRaShotReceived(const LoRaProtocol::ParsedPacket& pkt
 
 void BridgeApplication::onLoRaSessionStarted(const LoRaProtocol::ParsedPacket& pkt) {
   LOG_TIMER("LoRa RX session started: ID %u, delay %.1fs", pkt.sessionId, pkt.startDelaySeconds);
-  lastActivityTime = millis();
+  loraSources.startSession(*packetSource, pkt.sessionId);
 
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
     if (mqttManager && mqttManager->canPublish()) {
-      mqttManager->publishSessionStarted(pkt.sessionId, pkt.startDelaySeconds);
+      mqttManager->publishSessionStarted(pkt.sessionId, pkt.startDelaySeconds, pkt.sourceId);
     }
   } else {
     bleServer.sendSessionStart((uint8_t)(pkt.sessionId & 0xFF));
@@ -404,11 +709,10 @@ void BridgeApplication::onLoRaSessionStarted(const LoRaProtocol::ParsedPacket& p
 
 void BridgeApplication::onLoRaSessionStopped(const LoRaProtocol::ParsedPacket& pkt) {
   LOG_TIMER("LoRa RX session stopped: ID %u, %u shots", pkt.sessionId, pkt.totalShots);
-  lastActivityTime = millis();
 
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
     if (mqttManager && mqttManager->canPublish()) {
-      mqttManager->publishSessionStopped(pkt.sessionId, pkt.totalShots, pkt.lastShotTimeMs);
+      mqttManager->publishSessionStopped(pkt.sessionId, pkt.totalShots, pkt.lastShotTimeMs, pkt.sourceId);
     }
   } else {
     bleServer.sendSessionStop((uint8_t)(pkt.sessionId & 0xFF));
@@ -417,11 +721,10 @@ void BridgeApplication::onLoRaSessionStopped(const LoRaProtocol::ParsedPacket& p
 
 void BridgeApplication::onLoRaCountdownComplete(const LoRaProtocol::ParsedPacket& pkt) {
   LOG_TIMER("LoRa RX countdown complete: ID %u", pkt.sessionId);
-  lastActivityTime = millis();
 
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
     if (mqttManager && mqttManager->canPublish()) {
-      mqttManager->publishCountdownComplete(pkt.sessionId);
+      mqttManager->publishCountdownComplete(pkt.sessionId, pkt.sourceId);
     }
   }
   // No Special Pie equivalent for countdown
@@ -429,22 +732,20 @@ void BridgeApplication::onLoRaCountdownComplete(const LoRaProtocol::ParsedPacket
 
 void BridgeApplication::onLoRaSessionSuspended(const LoRaProtocol::ParsedPacket& pkt) {
   LOG_TIMER("LoRa RX session suspended: ID %u", pkt.sessionId);
-  lastActivityTime = millis();
 
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
     if (mqttManager && mqttManager->canPublish()) {
-      mqttManager->publishSessionSuspended(pkt.sessionId);
+      mqttManager->publishSessionSuspended(pkt.sessionId, pkt.sourceId);
     }
   }
 }
 
 void BridgeApplication::onLoRaSessionResumed(const LoRaProtocol::ParsedPacket& pkt) {
   LOG_TIMER("LoRa RX session resumed: ID %u", pkt.sessionId);
-  lastActivityTime = millis();
 
   if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
     if (mqttManager && mqttManager->canPublish()) {
-      mqttManager->publishSessionResumed(pkt.sessionId);
+      mqttManager->publishSessionResumed(pkt.sessionId, pkt.sourceId);
     }
   }
 }
@@ -462,6 +763,9 @@ void BridgeApplication::updateOledStatus() {
   if (role == BridgeRole::RECEIVER) {
     bridgeStatus.lastRssi   = loraRx.getLastRssi();
     bridgeStatus.crcErrors  = loraRx.getCrcErrors();
+    bridgeStatus.sourcesOnline = (uint8_t)loraSources.onlineCount();
+    bridgeStatus.sourcesKnown  = (uint8_t)loraSources.size();
+    bridgeStatus.dataRate      = loraRx.getDataRate();
     // shotsRx is incremented in onLoRaShotReceived(), not overwritten with total packets
 
     if (outputMode == ReceiverOutputMode::MQTT_OUTPUT) {
@@ -469,6 +773,12 @@ void BridgeApplication::updateOledStatus() {
     } else {
       bridgeStatus.bleClients = bleServer.getConnectedCount();
     }
+  } else {
+    bridgeStatus.txQueueDepth   = (uint8_t)loraTx.getQueueDepth();
+    bridgeStatus.txDrops        = loraTx.getDrops();
+    bridgeStatus.airtimeUsedMs  = loraTx.getAirtimeUsedMs();
+    bridgeStatus.airtimeBudgetMs = loraTx.getAirtimeBudgetMs();
+    bridgeStatus.dataRate       = loraTx.getDataRate();
   }
   // shotsTx is incremented in onShotDetected(), not overwritten with total packets
 }
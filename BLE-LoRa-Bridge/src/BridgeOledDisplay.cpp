@@ -89,8 +89,16 @@ void OledDisplay::drawTransmitterView(const BridgeStatus& status) {
     display->drawString(0, 18, "BLE: Disconnected");
   }
 
-  // Row 2: Shot counter
-  display->drawString(0, 30, String("Shots TX: ") + String(status.shotsTx));
+  // Row 2: Shot counter + data rate
+  display->drawString(0, 30, String("TX: ") + String(status.shotsTx));
+  drawDataRate(30, status.dataRate);
+
+  // Row 3: TX queue + duty-cycle airtime (seconds used / allowed per window)
+  char txBuf[32];
+  snprintf(txBuf, sizeof(txBuf), "Q:%u Drop:%lu Air:%.1f/%lus",
+           (unsigned)status.txQueueDepth, (unsigned long)status.txDrops,
+           status.airtimeUsedMs / 1000.0f, (unsigned long)(status.airtimeBudgetMs / 1000));
+  display->drawString(0, 40, txBuf);
 }
 
 void OledDisplay::drawReceiverView(const BridgeStatus& status) {
@@ -110,8 +118,9 @@ void OledDisplay::drawReceiverView(const BridgeStatus& status) {
              status.lastShotNumber, status.lastShotTimeMs / 1000.0f);
     display->drawString(0, 18, shotBuf);
   } else {
-    display->drawString(0, 18, "Waiting for LoRa...");
+    display->drawString(0, 18, "Waiting...");
   }
+  drawDataRate(18, status.dataRate);
 
   // Row 2: Shot count + RSSI
   String row2 = String("RX:") + String(status.shotsRx);
@@ -126,6 +135,12 @@ void OledDisplay::drawReceiverView(const BridgeStatus& status) {
   } else {
     display->drawString(80, 30, String("BLE:") + String(status.bleClients));
   }
+
+  // Row 3: Transmitters online / known + de-duplicated shots
+  char srcBuf[32];
+  snprintf(srcBuf, sizeof(srcBuf), "Src:%u/%u  Dup:%lu",
+           status.sourcesOnline, status.sourcesKnown, (unsigned long)status.duplicates);
+  display->drawString(0, 40, srcBuf);
 }
 
 void OledDisplay::drawCommonFooter(const BridgeStatus& status) {
@@ -145,6 +160,23 @@ void OledDisplay::drawCommonFooter(const BridgeStatus& status) {
   display->drawString(0, 52, footer);
 }
 
+void OledDisplay::drawDataRate(int16_t y, const LoRaDataRate& rate) {
+  if (rate.spreadingFactor == 0) return;
+
+  // Right-aligned: spreading factor (each one has a single bandwidth in
+  // LoRaRate::TABLE) + what a shot waits for batching and time on air
+  char rateBuf[20];
+  uint32_t latencyMs = LoRaRate::shotLatencyMs(rate);
+  if (latencyMs < 1000) {
+    snprintf(rateBuf, sizeof(rateBuf), "SF%u %lums", (unsigned)rate.spreadingFactor, (unsigned long)latencyMs);
+  } else {
+    snprintf(rateBuf, sizeof(rateBuf), "SF%u %.1fs", (unsigned)rate.spreadingFactor, latencyMs / 1000.0f);
+  }
+  display->setTextAlignment(TEXT_ALIGN_RIGHT);
+  display->drawString(OLED_WIDTH, y, rateBuf);
+  display->setTextAlignment(TEXT_ALIGN_LEFT);
+}
+
 bool OledDisplay::statusChanged(const BridgeStatus& a, const BridgeStatus& b) const {
   // Compare all displayed fields
   if (a.role != b.role) return true;
@@ -152,6 +184,9 @@ bool OledDisplay::statusChanged(const BridgeStatus& a, const BridgeStatus& b) co
   if (a.bleConnected != b.bleConnected) return true;
   if (a.bleScanning != b.bleScanning) return true;
   if (a.shotsTx != b.shotsTx) return true;
+  if (a.txQueueDepth != b.txQueueDepth) return true;
+  if (a.txDrops != b.txDrops) return true;
+  if (a.airtimeUsedMs / 100 != b.airtimeUsedMs / 100) return true;  // Shown to 0.1 s
   if (a.shotsRx != b.shotsRx) return true;
   if (a.lastRssi != b.lastRssi) return true;
   if (a.mqttConnected != b.mqttConnected) return true;
@@ -161,7 +196,12 @@ bool OledDisplay::statusChanged(const BridgeStatus& a, const BridgeStatus& b) co
   if (a.hasLastShot != b.hasLastShot) return true;
   if (a.lastShotNumber != b.lastShotNumber) return true;
   if (a.lastShotTimeMs != b.lastShotTimeMs) return true;
+  if (a.sourcesOnline != b.sourcesOnline) return true;
+  if (a.sourcesKnown != b.sourcesKnown) return true;
+  if (a.duplicates != b.duplicates) return true;
   if (a.timerModel != b.timerModel) return true;
+  if (a.dataRate.spreadingFactor != b.dataRate.spreadingFactor) return true;
+  if (a.dataRate.bandwidthHz != b.dataRate.bandwidthHz) return true;
 
   // Uptime changes every second — throttle redraw to 1s
   if ((a.uptimeMs / 1000) != (b.uptimeMs / 1000)) return true;
@@ -154,6 +154,10 @@ bool BridgeWiFiConfig::isConnected() {
   return wifiConnected;
 }
 
+bool BridgeWiFiConfig::isPortalActive() {
+  return wifiManager.getConfigPortalActive() || wifiManager.getWebPortalActive();
+}
+
 String BridgeWiFiConfig::getLocalIP() {
   return WiFi.localIP().toString();
 }
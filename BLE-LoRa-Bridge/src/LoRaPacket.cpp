@@ -1,4 +1,6 @@
 #include "LoRaPacket.h"
+#include "Crc16.h"
+#include "common.h"
 #include <cstring>
 
 namespace LoRaProtocol {
@@ -6,26 +8,38 @@ namespace LoRaProtocol {
 // ─── CRC-16/CCITT (poly 0x1021, init 0xFFFF) ────────────────
 
 uint16_t crc16(const uint8_t* data, size_t len) {
-  uint16_t crc = 0xFFFF;
-  for (size_t i = 0; i < len; i++) {
-    crc ^= (uint16_t)data[i] << 8;
-    for (uint8_t bit = 0; bit < 8; bit++) {
-      if (crc & 0x8000) {
-        crc = (crc << 1) ^ 0x1021;
-      } else {
-        crc <<= 1;
-      }
-    }
-  }
-  return crc;
+#if LORA_CRC16_IMPL == LORA_CRC16_SLICE4
+  return Crc16::slice4(data, len);
+#elif LORA_CRC16_IMPL == LORA_CRC16_TABLE
+  return Crc16::table(data, len);
+#else
+  return Crc16::bitwise(data, len);
+#endif
 }
 
 // ─── Internal helpers ────────────────────────────────────────
 
-static size_t writeHeader(uint8_t* buf, PacketType type, const char* sourceId) {
+static void writeU16(uint8_t* buf, uint16_t val) {
+  buf[0] = (uint8_t)(val & 0xFF);
+  buf[1] = (uint8_t)((val >> 8) & 0xFF);
+}
+
+static void writeU32(uint8_t* buf, uint32_t val) {
+  buf[0] = (uint8_t)(val & 0xFF);
+  buf[1] = (uint8_t)((val >> 8) & 0xFF);
+  buf[2] = (uint8_t)((val >> 16) & 0xFF);
+  buf[3] = (uint8_t)((val >> 24) & 0xFF);
+}
+
+static size_t writeHeader(uint8_t* buf, PacketType type, const char* sourceId, uint8_t version) {
   buf[0] = MAGIC_0;
-  buf[1] = MAGIC_1;
   buf[2] = static_cast<uint8_t>(type);
+  if (version == FRAME_V2) {
+    buf[1] = VERSION_V2;
+    writeU16(&buf[3], sourceHash(sourceId));
+    return HEADER_SIZE_V2;
+  }
+  buf[1] = MAGIC_1;
   // Copy 6 bytes of source ID (pad with zeros if shorter)
   memset(&buf[3], 0, SOURCE_ID_LEN);
   size_t idLen = strlen(sourceId);
@@ -34,16 +48,24 @@ static size_t writeHeader(uint8_t* buf, PacketType type, const char* sourceId) {
   return HEADER_SIZE;
 }
 
-static void writeU16(uint8_t* buf, uint16_t val) {
-  buf[0] = (uint8_t)(val & 0xFF);
-  buf[1] = (uint8_t)((val >> 8) & 0xFF);
+// Header length of a serialized frame (before SEQ), from its version byte
+static size_t headerSize(const uint8_t* buf) {
+  return buf[1] == VERSION_V2 ? HEADER_SIZE_V2 : HEADER_SIZE;
 }
 
-static void writeU32(uint8_t* buf, uint32_t val) {
-  buf[0] = (uint8_t)(val & 0xFF);
-  buf[1] = (uint8_t)((val >> 8) & 0xFF);
-  buf[2] = (uint8_t)((val >> 16) & 0xFF);
-  buf[3] = (uint8_t)((val >> 24) & 0xFF);
+// Addressed control packets: 6 bytes, zero-padded; nullptr = all zero.
+// v2: the 2-byte hash, 0 = all
+static size_t writeDestId(uint8_t* buf, size_t pos, const char* destId, uint8_t version) {
+  if (version == FRAME_V2) {
+    writeU16(&buf[pos], destId ? sourceHash(destId) : 0);
+    return pos + 2;
+  }
+  memset(&buf[pos], 0, SOURCE_ID_LEN);
+  if (destId) {
+    size_t idLen = strlen(destId);
+    memcpy(&buf[pos], destId, idLen > SOURCE_ID_LEN ? SOURCE_ID_LEN : idLen);
+  }
+  return pos + SOURCE_ID_LEN;
 }
 
 static void writeFloat(uint8_t* buf, float val) {
@@ -70,6 +92,59 @@ static float readFloat(const uint8_t* buf) {
   return val;
 }
 
+// Unsigned LEB128. Returns bytes written (1..5).
+static size_t writeVarint(uint8_t* buf, uint32_t val) {
+  size_t n = 0;
+  while (val >= 0x80) {
+    buf[n++] = (uint8_t)(val | 0x80);
+    val >>= 7;
+  }
+  buf[n++] = (uint8_t)val;
+  return n;
+}
+
+static size_t varintSize(uint32_t val) {
+  size_t n = 1;
+  while (val >= 0x80) {
+    val >>= 7;
+    n++;
+  }
+  return n;
+}
+
+// Returns bytes consumed, or 0 if truncated / longer than 5 bytes
+static size_t readVarint(const uint8_t* buf, size_t len, uint32_t& val) {
+  val = 0;
+  for (size_t i = 0; i < len && i < 5; i++) {
+    val |= (uint32_t)(buf[i] & 0x7F) << (7 * i);
+    if (!(buf[i] & 0x80)) return i + 1;
+  }
+  return 0;
+}
+
+static size_t modelLength(const char* model) {
+  size_t len = strlen(model);
+  return len > MODEL_LEN ? MODEL_LEN : len;
+}
+
+static size_t writeModel(uint8_t* buf, const char* model) {
+  size_t modelLen = modelLength(model);
+  buf[0] = (uint8_t)modelLen;
+  memcpy(&buf[1], model, modelLen);
+  return 1 + modelLen;
+}
+
+// modelLen(1) model(modelLen) into `model` (MODEL_LEN + 1 bytes). Returns
+// bytes consumed, or 0 if truncated or too long
+static size_t readModel(const uint8_t* buf, size_t len, char* model) {
+  if (len < 1) return 0;
+  size_t modelLen = buf[0];
+  if (modelLen > MODEL_LEN || len < 1 + modelLen) return 0;
+  memcpy(model, &buf[1], modelLen);
+  model[modelLen] = '\0';
+  return 1 + modelLen;
+}
+
 static size_t appendCrc(uint8_t* buf, size_t packetLen) {
   uint16_t crcVal = crc16(buf, packetLen);
   writeU16(&buf[packetLen], crcVal);
@@ -77,16 +152,24 @@ static size_t appendCrc(uint8_t* buf, size_t packetLen) {
 }
 
 // ─── Serialization ───────────────────────────────────────────
+// Buffer checks use the v1 length, which is never shorter than v2's.
 
 size_t serializeShotDetected(uint8_t* buf, size_t bufLen,
                              const char* sourceId,
-                             const NormalizedShotData& shot) {
+                             const NormalizedShotData& shot,
+                             uint8_t version) {
   const size_t needed = HEADER_SIZE + PAYLOAD_SHOT_DETECTED + CRC_SIZE;
   if (bufLen < needed) return 0;
 
-  size_t pos = writeHeader(buf, PacketType::SHOT_DETECTED, sourceId);
+  size_t pos = writeHeader(buf, PacketType::SHOT_DETECTED, sourceId, version);
 
   writeU32(&buf[pos], shot.sessionId);        pos += 4;
+  if (version == FRAME_V2) {
+    pos += writeVarint(&buf[pos], ((uint32_t)shot.shotNumber << 1) | (shot.isFirstShot ? 1 : 0));
+    pos += writeVarint(&buf[pos], shot.absoluteTimeMs);
+    pos += writeVarint(&buf[pos], shot.splitTimeMs);
+    return appendCrc(buf, pos);
+  }
   writeU16(&buf[pos], shot.shotNumber);        pos += 2;
   writeU32(&buf[pos], shot.absoluteTimeMs);    pos += 4;
   writeU32(&buf[pos], shot.splitTimeMs);       pos += 4;
@@ -100,13 +183,79 @@ size_t serializeShotDetected(uint8_t* buf, size_t bufLen,
   return appendCrc(buf, pos);
 }
 
+// ─── Shot batch ──────────────────────────────────────────────
+
+void ShotBatch::clear() {
+  shotCount = 0;
+  encodedSize = 0;
+}
+
+bool ShotBatch::add(const NormalizedShotData& shot) {
+  size_t entrySize;
+  if (shotCount == 0) {
+    entrySize = 4 + 1 + 1 + modelLength(shot.deviceModel) + 2 + 4 + varintSize(shot.splitTimeMs);
+  } else {
+    const NormalizedShotData& last = shots[shotCount - 1];
+    if (full()) return false;
+    if (shot.sessionId != last.sessionId || shot.isFirstShot) return false;
+    if (strncmp(shot.deviceModel, last.deviceModel, MODEL_LEN) != 0) return false;
+    if (shot.shotNumber <= last.shotNumber || shot.shotNumber - last.shotNumber > 0xFF) return false;
+    if (shot.absoluteTimeMs < last.absoluteTimeMs) return false;
+    uint32_t delta = shot.absoluteTimeMs - last.absoluteTimeMs;
+    if (shot.splitTimeMs != delta) return false;
+    entrySize = 1 + varintSize(delta);
+  }
+  if (encodedSize + entrySize > MAX_PAYLOAD_SIZE) return false;
+
+  shots[shotCount++] = shot;
+  encodedSize += entrySize;
+  return true;
+}
+
+size_t serializeShotBatch(uint8_t* buf, size_t bufLen,
+                          const char* sourceId,
+                          const ShotBatch& batch,
+                          uint8_t version) {
+  if (batch.empty()) return 0;
+  const size_t needed = HEADER_SIZE + batch.payloadSize() + CRC_SIZE;
+  if (bufLen < needed) return 0;
+
+  const NormalizedShotData& first = batch.shot(0);
+  size_t pos = writeHeader(buf, PacketType::SHOT_BATCH, sourceId, version);
+
+  writeU32(&buf[pos], first.sessionId);                 pos += 4;
+  buf[pos] = (uint8_t)batch.count() | (first.isFirstShot ? BATCH_FIRST_SHOT_FLAG : 0);
+  pos += 1;
+  if (version == FRAME_V2) {
+    pos += writeVarint(&buf[pos], first.shotNumber);
+    pos += writeVarint(&buf[pos], first.absoluteTimeMs);
+  } else {
+    pos += writeModel(&buf[pos], first.deviceModel);
+    writeU16(&buf[pos], first.shotNumber);               pos += 2;
+    writeU32(&buf[pos], first.absoluteTimeMs);           pos += 4;
+  }
+  pos += writeVarint(&buf[pos], first.splitTimeMs);
+
+  for (size_t i = 1; i < batch.count(); i++) {
+    const NormalizedShotData& prev = batch.shot(i - 1);
+    const NormalizedShotData& shot = batch.shot(i);
+    buf[pos] = (uint8_t)(shot.shotNumber - prev.shotNumber);  pos += 1;
+    pos += writeVarint(&buf[pos], shot.absoluteTimeMs - prev.absoluteTimeMs);
+  }
+
+  return appendCrc(buf, pos);
+}
+
+// ─── Session events ──────────────────────────────────────────
+
 size_t serializeSessionStarted(uint8_t* buf, size_t bufLen,
                                const char* sourceId,
-                               uint32_t sessionId, float startDelaySeconds) {
+                               uint32_t sessionId, float startDelaySeconds,
+                               uint8_t version) {
   const size_t needed = HEADER_SIZE + PAYLOAD_SESSION_STARTED + CRC_SIZE;
   if (bufLen < needed) return 0;
 
-  size_t pos = writeHeader(buf, PacketType::SESSION_STARTED, sourceId);
+  size_t pos = writeHeader(buf, PacketType::SESSION_STARTED, sourceId, version);
   writeU32(&buf[pos], sessionId);              pos += 4;
   writeFloat(&buf[pos], startDelaySeconds);    pos += 4;
 
@@ -116,25 +265,30 @@ size_t serializeSessionStarted(uint8_t* buf, size_t bufLen,
 size_t serializeSessionStopped(uint8_t* buf, size_t bufLen,
                                const char* sourceId,
                                uint32_t sessionId, uint16_t totalShots,
-                               uint32_t lastShotTimeMs) {
+                               uint32_t lastShotTimeMs, uint8_t version) {
   const size_t needed = HEADER_SIZE + PAYLOAD_SESSION_STOPPED + CRC_SIZE;
   if (bufLen < needed) return 0;
 
-  size_t pos = writeHeader(buf, PacketType::SESSION_STOPPED, sourceId);
+  size_t pos = writeHeader(buf, PacketType::SESSION_STOPPED, sourceId, version);
   writeU32(&buf[pos], sessionId);              pos += 4;
-  writeU16(&buf[pos], totalShots);             pos += 2;
-  writeU32(&buf[pos], lastShotTimeMs);         pos += 4;
+  if (version == FRAME_V2) {
+    pos += writeVarint(&buf[pos], totalShots);
+    pos += writeVarint(&buf[pos], lastShotTimeMs);
+  } else {
+    writeU16(&buf[pos], totalShots);           pos += 2;
+    writeU32(&buf[pos], lastShotTimeMs);       pos += 4;
+  }
 
   return appendCrc(buf, pos);
 }
 
 size_t serializeCountdownComplete(uint8_t* buf, size_t bufLen,
                                   const char* sourceId,
-                                  uint32_t sessionId) {
+                                  uint32_t sessionId, uint8_t version) {
   const size_t needed = HEADER_SIZE + PAYLOAD_COUNTDOWN_COMPLETE + CRC_SIZE;
   if (bufLen < needed) return 0;
 
-  size_t pos = writeHeader(buf, PacketType::COUNTDOWN_COMPLETE, sourceId);
+  size_t pos = writeHeader(buf, PacketType::COUNTDOWN_COMPLETE, sourceId, version);
   writeU32(&buf[pos], sessionId);              pos += 4;
 
   return appendCrc(buf, pos);
@@ -142,11 +296,11 @@ size_t serializeCountdownComplete(uint8_t* buf, size_t bufLen,
 
 size_t serializeSessionSuspended(uint8_t* buf, size_t bufLen,
                                  const char* sourceId,
-                                 uint32_t sessionId) {
+                                 uint32_t sessionId, uint8_t version) {
   const size_t needed = HEADER_SIZE + PAYLOAD_SESSION_SUSPENDED + CRC_SIZE;
   if (bufLen < needed) return 0;
 
-  size_t pos = writeHeader(buf, PacketType::SESSION_SUSPENDED, sourceId);
+  size_t pos = writeHeader(buf, PacketType::SESSION_SUSPENDED, sourceId, version);
   writeU32(&buf[pos], sessionId);              pos += 4;
 
   return appendCrc(buf, pos);
@@ -154,11 +308,11 @@ size_t serializeSessionSuspended(uint8_t* buf, size_t bufLen,
 
 size_t serializeSessionResumed(uint8_t* buf, size_t bufLen,
                                const char* sourceId,
-                               uint32_t sessionId) {
+                               uint32_t sessionId, uint8_t version) {
   const size_t needed = HEADER_SIZE + PAYLOAD_SESSION_RESUMED + CRC_SIZE;
   if (bufLen < needed) return 0;
 
-  size_t pos = writeHeader(buf, PacketType::SESSION_RESUMED, sourceId);
+  size_t pos = writeHeader(buf, PacketType::SESSION_RESUMED, sourceId, version);
   writeU32(&buf[pos], sessionId);              pos += 4;
 
   return appendCrc(buf, pos);
@@ -166,24 +320,255 @@ size_t serializeSessionResumed(uint8_t* buf, size_t bufLen,
 
 size_t serializeHeartbeat(uint8_t* buf, size_t bufLen,
                           const char* sourceId,
-                          uint32_t uptimeMs) {
+                          uint32_t uptimeMs, uint8_t version) {
   const size_t needed = HEADER_SIZE + PAYLOAD_HEARTBEAT + CRC_SIZE;
   if (bufLen < needed) return 0;
 
-  size_t pos = writeHeader(buf, PacketType::HEARTBEAT, sourceId);
-  writeU32(&buf[pos], uptimeMs);               pos += 4;
+  size_t pos = writeHeader(buf, PacketType::HEARTBEAT, sourceId, version);
+  if (version == FRAME_V2) {
+    pos += writeVarint(&buf[pos], uptimeMs);
+  } else {
+    writeU32(&buf[pos], uptimeMs);             pos += 4;
+  }
+
+  return appendCrc(buf, pos);
+}
+
+// ─── Reliable link ───────────────────────────────────────────
+
+size_t serializeAck(uint8_t* buf, size_t bufLen,
+                    const char* sourceId, const char* destId,
+                    uint16_t base, uint32_t mask, uint8_t version) {
+  const size_t needed = HEADER_SIZE + PAYLOAD_ACK + CRC_SIZE;
+  if (bufLen < needed) return 0;
+
+  size_t pos = writeHeader(buf, PacketType::ACK, sourceId, version);
+  pos = writeDestId(buf, pos, destId, version);
+  writeU16(&buf[pos], base);                   pos += 2;
+  if (version == FRAME_V2) {
+    pos += writeVarint(&buf[pos], mask);
+  } else {
+    writeU32(&buf[pos], mask);                 pos += 4;
+  }
+
+  return appendCrc(buf, pos);
+}
+
+size_t serializeRateChange(uint8_t* buf, size_t bufLen,
+                           const char* sourceId, const char* destId, uint8_t rate,
+                           uint8_t version) {
+  const size_t needed = HEADER_SIZE + PAYLOAD_RATE_CHANGE + CRC_SIZE;
+  if (bufLen < needed) return 0;
+
+  size_t pos = writeHeader(buf, PacketType::RATE_CHANGE, sourceId, version);
+  pos = writeDestId(buf, pos, destId, version);
+  buf[pos++] = rate;
+
+  return appendCrc(buf, pos);
+}
+
+// ─── Device info (v2) ────────────────────────────────────────
+
+size_t serializeDeviceInfo(uint8_t* buf, size_t bufLen,
+                           const char* sourceId, const char* deviceModel) {
+  const size_t needed = HEADER_SIZE_V2 + PAYLOAD_DEVICE_INFO_MIN + MODEL_LEN + CRC_SIZE;
+  if (bufLen < needed) return 0;
+
+  size_t pos = writeHeader(buf, PacketType::DEVICE_INFO, sourceId, FRAME_V2);
+  memset(&buf[pos], 0, SOURCE_ID_LEN);
+  size_t idLen = strlen(sourceId);
+  memcpy(&buf[pos], sourceId, idLen > SOURCE_ID_LEN ? SOURCE_ID_LEN : idLen);
+  pos += SOURCE_ID_LEN;
+  pos += writeModel(&buf[pos], deviceModel);
 
   return appendCrc(buf, pos);
 }
 
+size_t addSequence(uint8_t* buf, size_t len, size_t bufLen, uint16_t seq, bool sync) {
+  if (len < HEADER_SIZE_V2 + CRC_SIZE || len + SEQ_SIZE > bufLen) return 0;
+  size_t headerLen = headerSize(buf);
+  if (len < headerLen + CRC_SIZE || (buf[2] & SEQ_FLAG)) return 0;
+
+  // Drop the old CRC, open a gap after the header for the sequence number
+  size_t payloadLen = len - headerLen - CRC_SIZE;
+  memmove(&buf[headerLen + SEQ_SIZE], &buf[headerLen], payloadLen);
+  buf[2] |= SEQ_FLAG | (sync ? SYNC_FLAG : 0);
+  writeU16(&buf[headerLen], seq);
+
+  return appendCrc(buf, headerLen + SEQ_SIZE + payloadLen);
+}
+
+// ─── Source addressing (v2) ──────────────────────────────────
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+uint16_t sourceHash(const char* sourceId) {
+  // A placeholder stands for the hash it shows
+  if (sourceId[0] == PLACEHOLDER_PREFIX && strlen(sourceId) == 5) {
+    uint16_t hash = 0;
+    bool valid = true;
+    for (size_t i = 1; i < 5 && valid; i++) {
+      int digit = hexDigit(sourceId[i]);
+      valid = digit >= 0;
+      hash = (uint16_t)((hash << 4) | (digit & 0x0F));
+    }
+    if (valid && hash != 0) return hash;
+  }
+
+  uint8_t id[SOURCE_ID_LEN] = {0};
+  size_t idLen = strlen(sourceId);
+  memcpy(id, sourceId, idLen > SOURCE_ID_LEN ? SOURCE_ID_LEN : idLen);
+  uint16_t hash = crc16(id, SOURCE_ID_LEN);
+  return hash != 0 ? hash : 1;
+}
+
+void placeholderId(uint16_t hash, char* out) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  out[0] = PLACEHOLDER_PREFIX;
+  for (size_t i = 0; i < 4; i++) out[1 + i] = HEX_DIGITS[(hash >> (12 - 4 * i)) & 0x0F];
+  out[5] = '\0';
+}
+
 // ─── Deserialization ─────────────────────────────────────────
 
-bool deserialize(const uint8_t* data, size_t len, ParsedPacket& out) {
-  // Minimum packet: header(9) + smallest payload(4) + crc(2) = 15
-  if (len < HEADER_SIZE + 4 + CRC_SIZE) return false;
+// Delta-encoded shots after the first in a SHOT_BATCH (both versions).
+// Returns false if the payload ends early.
+static bool readBatchDeltas(const uint8_t* payload, size_t payloadLen, size_t pos, ParsedPacket& out) {
+  for (size_t i = 1; i < out.batchCount; i++) {
+    const ParsedPacket::BatchEntry& prev = out.batch[i - 1];
+    ParsedPacket::BatchEntry* entry = &out.batch[i];
+    if (pos >= payloadLen) return false;
+    entry->shotNumber = (uint16_t)(prev.shotNumber + payload[pos]);
+    pos += 1;
+    size_t used = readVarint(&payload[pos], payloadLen - pos, entry->splitTimeMs);
+    if (used == 0) return false;
+    pos += used;
+    entry->absoluteTimeMs = prev.absoluteTimeMs + entry->splitTimeMs;
+  }
+  return true;
+}
+
+// Control packets: destId and destHash from either encoding
+static void readDestId(const uint8_t* payload, ParsedPacket& out) {
+  if (out.version == FRAME_V2) {
+    out.destHash = readU16(&payload[0]);
+    if (out.destHash == 0) {
+      out.destId[0] = '\0';
+    } else {
+      placeholderId(out.destHash, out.destId);
+    }
+    return;
+  }
+  memcpy(out.destId, &payload[0], SOURCE_ID_LEN);
+  out.destId[SOURCE_ID_LEN] = '\0';
+  out.destHash = out.destId[0] != '\0' ? sourceHash(out.destId) : 0;
+}
+
+// Reads the varint at `pos` and moves past it. False if truncated.
+static bool nextVarint(const uint8_t* payload, size_t payloadLen, size_t& pos, uint32_t& val) {
+  size_t used = readVarint(&payload[pos], payloadLen - pos, val);
+  pos += used;
+  return used != 0;
+}
+
+// v2 payloads whose layout differs from v1 (see LoRaPacket.h). Sets
+// `handled` to false for the types encoded as in v1.
+static bool deserializeV2(const uint8_t* payload, size_t payloadLen, ParsedPacket& out, bool& handled) {
+  handled = true;
+  size_t pos = 4;  // After sessionId, where there is one
+  uint32_t value;
+
+  switch (out.type) {
+    case PacketType::SHOT_DETECTED: {
+      if (payloadLen < 4 + 3) return false;
+      out.shot = NormalizedShotData();
+      out.shot.sessionId = readU32(&payload[0]);
+      if (!nextVarint(payload, payloadLen, pos, value)) return false;
+      out.shot.shotNumber = (uint16_t)(value >> 1);
+      out.shot.isFirstShot = (value & 1) != 0;
+      if (!nextVarint(payload, payloadLen, pos, out.shot.absoluteTimeMs)) return false;
+      if (!nextVarint(payload, payloadLen, pos, out.shot.splitTimeMs)) return false;
+      out.shot.timestampMs = millis();  // Local receive timestamp
+      out.sessionId = out.shot.sessionId;
+      return true;
+    }
+    case PacketType::SHOT_BATCH: {
+      if (payloadLen < 4 + 1 + 3) return false;
+      out.sessionId = readU32(&payload[0]);
+      out.batchCount = (uint8_t)(payload[4] & ~BATCH_FIRST_SHOT_FLAG);
+      out.batchStartsSession = (payload[4] & BATCH_FIRST_SHOT_FLAG) != 0;
+      if (out.batchCount == 0 || out.batchCount > MAX_BATCH_SHOTS) return false;
+      out.shot = NormalizedShotData();
+
+      pos = 5;
+      ParsedPacket::BatchEntry& first = out.batch[0];
+      if (!nextVarint(payload, payloadLen, pos, value)) return false;
+      first.shotNumber = (uint16_t)value;
+      if (!nextVarint(payload, payloadLen, pos, first.absoluteTimeMs)) return false;
+      if (!nextVarint(payload, payloadLen, pos, first.splitTimeMs)) return false;
+      return readBatchDeltas(payload, payloadLen, pos, out);
+    }
+    case PacketType::SESSION_STOPPED: {
+      if (payloadLen < 4 + 2) return false;
+      out.sessionId = readU32(&payload[0]);
+      if (!nextVarint(payload, payloadLen, pos, value)) return false;
+      out.totalShots = (uint16_t)value;
+      return nextVarint(payload, payloadLen, pos, out.lastShotTimeMs);
+    }
+    case PacketType::HEARTBEAT:
+      pos = 0;
+      return nextVarint(payload, payloadLen, pos, out.uptimeMs);
+    case PacketType::ACK: {
+      if (payloadLen < 2 + 2 + 1 || out.sequenced) return false;
+      readDestId(payload, out);
+      out.ackBase = readU16(&payload[2]);
+      return nextVarint(payload, payloadLen, pos, out.ackMask);
+    }
+    case PacketType::RATE_CHANGE: {
+      if (payloadLen < 2 + 1 || out.sequenced) return false;
+      readDestId(payload, out);
+      out.rate = payload[2];
+      return true;
+    }
+    case PacketType::DEVICE_INFO: {
+      if (payloadLen < PAYLOAD_DEVICE_INFO_MIN) return false;
+      out.shot = NormalizedShotData();
+      if (readModel(&payload[SOURCE_ID_LEN], payloadLen - SOURCE_ID_LEN, out.shot.deviceModel) == 0) return false;
+      memcpy(out.sourceId, &payload[0], SOURCE_ID_LEN);
+      out.sourceId[SOURCE_ID_LEN] = '\0';
+      // The id must be the one the header's hash stands for
+      return sourceHash(out.sourceId) == out.sourceHash;
+    }
+    default:
+      handled = false;  // Session events: sessionId(4) as in v1
+      return false;
+  }
+}
 
-  // Verify magic
-  if (data[0] != MAGIC_0 || data[1] != MAGIC_1) return false;
+bool deserialize(const uint8_t* data, size_t len, ParsedPacket& out) {
+  // Minimum packet: v2 header(5) + smallest payload(1) + crc(2) = 8
+  if (len < HEADER_SIZE_V2 + 1 + CRC_SIZE) return false;
+
+  // Verify magic and version: v1 "PW" (smallest payload 4), v2 'P' + VERSION_V2
+  size_t headerLen;
+  size_t minPayload;
+  if (data[0] != MAGIC_0) return false;
+  if (data[1] == MAGIC_1) {
+    out.version = FRAME_V1;
+    headerLen = HEADER_SIZE;
+    minPayload = 4;
+  } else if (data[1] == VERSION_V2) {
+    out.version = FRAME_V2;
+    headerLen = HEADER_SIZE_V2;
+    minPayload = 1;
+  } else {
+    return false;
+  }
+  if (len < headerLen + minPayload + CRC_SIZE) return false;
 
   // Verify CRC over everything except the last 2 bytes
   uint16_t receivedCrc = readU16(&data[len - CRC_SIZE]);
@@ -191,17 +576,38 @@ bool deserialize(const uint8_t* data, size_t len, ParsedPacket& out) {
   if (receivedCrc != computedCrc) return false;
 
   // Parse header
-  out.type = static_cast<PacketType>(data[2]);
-  memcpy(out.sourceId, &data[3], SOURCE_ID_LEN);
-  out.sourceId[SOURCE_ID_LEN] = '\0';
+  out.type = static_cast<PacketType>(data[2] & TYPE_MASK);
+  if (out.version == FRAME_V2) {
+    out.sourceHash = readU16(&data[3]);
+    placeholderId(out.sourceHash, out.sourceId);
+  } else {
+    memcpy(out.sourceId, &data[3], SOURCE_ID_LEN);
+    out.sourceId[SOURCE_ID_LEN] = '\0';
+    out.sourceHash = sourceHash(out.sourceId);
+  }
 
-  const uint8_t* payload = &data[HEADER_SIZE];
-  size_t payloadLen = len - HEADER_SIZE - CRC_SIZE;
+  out.sequenced = (data[2] & SEQ_FLAG) != 0;
+  out.sync = (data[2] & SYNC_FLAG) != 0;
+  out.seq = 0;
+  if (out.sequenced) {
+    if (len < headerLen + SEQ_SIZE + minPayload + CRC_SIZE) return false;
+    out.seq = readU16(&data[headerLen]);
+    headerLen += SEQ_SIZE;
+  }
+
+  const uint8_t* payload = &data[headerLen];
+  size_t payloadLen = len - headerLen - CRC_SIZE;
+
+  if (out.version == FRAME_V2) {
+    bool handled;
+    bool parsed = deserializeV2(payload, payloadLen, out, handled);
+    if (handled) return parsed;
+  }
 
   switch (out.type) {
     case PacketType::SHOT_DETECTED: {
       if (payloadLen < PAYLOAD_SHOT_DETECTED) return false;
-      memset(&out.shot, 0, sizeof(out.shot));
+      out.shot = NormalizedShotData();
       out.shot.sessionId      = readU32(&payload[0]);
       out.shot.shotNumber     = readU16(&payload[4]);
       out.shot.absoluteTimeMs = readU32(&payload[6]);
@@ -248,9 +654,81 @@ bool deserialize(const uint8_t* data, size_t len, ParsedPacket& out) {
       out.uptimeMs = readU32(&payload[0]);
       return true;
     }
+    case PacketType::SHOT_BATCH: {
+      if (payloadLen < PAYLOAD_SHOT_BATCH_MIN) return false;
+      out.sessionId = readU32(&payload[0]);
+      out.batchCount = (uint8_t)(payload[4] & ~BATCH_FIRST_SHOT_FLAG);
+      out.batchStartsSession = (payload[4] & BATCH_FIRST_SHOT_FLAG) != 0;
+      size_t modelLen = payload[5];
+      if (out.batchCount == 0 || out.batchCount > MAX_BATCH_SHOTS || modelLen > MODEL_LEN) return false;
+
+      size_t pos = 6;
+      if (payloadLen < pos + modelLen + 6) return false;
+      out.shot = NormalizedShotData();
+      memcpy(out.shot.deviceModel, &payload[pos], modelLen);
+      pos += modelLen;
+
+      ParsedPacket::BatchEntry* entry = &out.batch[0];
+      entry->shotNumber     = readU16(&payload[pos]);   pos += 2;
+      entry->absoluteTimeMs = readU32(&payload[pos]);   pos += 4;
+      size_t used = readVarint(&payload[pos], payloadLen - pos, entry->splitTimeMs);
+      if (used == 0) return false;
+      pos += used;
+      return readBatchDeltas(payload, payloadLen, pos, out);
+    }
+    case PacketType::ACK: {
+      if (payloadLen < PAYLOAD_ACK || out.sequenced) return false;
+      readDestId(payload, out);
+      out.ackBase = readU16(&payload[6]);
+      out.ackMask = readU32(&payload[8]);
+      return true;
+    }
+    case PacketType::RATE_CHANGE: {
+      if (payloadLen < PAYLOAD_RATE_CHANGE || out.sequenced) return false;
+      readDestId(payload, out);
+      out.rate = payload[6];
+      return true;
+    }
     default:
       return false;
   }
 }
 
+NormalizedShotData batchShot(const ParsedPacket& pkt, size_t index) {
+  NormalizedShotData shot;
+  const ParsedPacket::BatchEntry& entry = pkt.batch[index];
+  shot.sessionId      = pkt.sessionId;
+  shot.shotNumber     = entry.shotNumber;
+  shot.absoluteTimeMs = entry.absoluteTimeMs;
+  shot.splitTimeMs    = entry.splitTimeMs;
+  shot.isFirstShot    = (index == 0) && pkt.batchStartsSession;
+  memcpy(shot.deviceModel, pkt.shot.deviceModel, sizeof(shot.deviceModel));
+  shot.timestampMs    = millis();  // Local receive timestamp
+  return shot;
+}
+
+bool addressedTo(const ParsedPacket& pkt, const char* sourceId) {
+  if (pkt.destId[0] == '\0') return false;
+  if (pkt.version == FRAME_V2) return pkt.destHash == sourceHash(sourceId);
+  return strncmp(pkt.destId, sourceId, SOURCE_ID_LEN) == 0;
+}
+
+// ─── Airtime ─────────────────────────────────────────────────
+
+uint32_t timeOnAirUs(size_t length, uint8_t spreadingFactor, uint32_t bandwidthHz,
+                     uint8_t codingRate, uint16_t preambleLength) {
+  const uint32_t symbolUs = (uint32_t)(((uint64_t)1000000 << spreadingFactor) / bandwidthHz);
+  const int lowDataRate = symbolUs > 16000 ? 1 : 0;
+
+  // payloadSymbols = 8 + max(ceil((8PL - 4SF + 28 + 16CRC - 20IH) / 4(SF - 2DE)) * CR, 0)
+  int numerator = 8 * (int)length - 4 * spreadingFactor + 28 + 16;
+  int denominator = 4 * (spreadingFactor - 2 * lowDataRate);
+  int blocks = numerator > 0 ? (numerator + denominator - 1) / denominator : 0;
+  uint32_t payloadSymbols = 8 + (uint32_t)blocks * codingRate;
+
+  // Preamble is (n + 4.25) symbols
+  uint32_t preambleUs = (uint32_t)preambleLength * symbolUs + (symbolUs * 17) / 4;
+  return preambleUs + payloadSymbols * symbolUs;
+}
+
 }  // namespace LoRaProtocol
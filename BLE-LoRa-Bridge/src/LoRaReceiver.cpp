@@ -1,19 +1,227 @@
 #include "LoRaReceiver.h"
+#include "DeviceId.h"
 #include "LoRaRadio.h"
-#include "common.h"
 #include <LoRa.h>
 
-bool LoRaReceiver::initialize() {
+#if LORA_RX_INTERRUPT_DRIVEN
+namespace {
+TaskHandle_t gDrainTask = nullptr;  // For the DIO0 ISR
+
+// SX1276 DIO0 = RxDone in receive mode (TxDone while an ACK or RATE_CHANGE
+// is on air).
+// SPI cannot run in an ISR on the ESP32 (the bus is mutex-guarded), so hand
+// the FIFO read to the drain task.
+void IRAM_ATTR onLoRaRxDone() {
+  BaseType_t woken = pdFALSE;
+  if (gDrainTask) vTaskNotifyGiveFromISR(gDrainTask, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+}  // namespace
+#endif
+
+LoRaReceiver::LoRaReceiver()
+  :
+#if LORA_ADAPTIVE_RATE
+    dataRate(LoRaRate::TABLE[LORA_RATE_RENDEZVOUS]),
+#else
+    dataRate(LoRaRate::configured()),
+#endif
+    radioCrcErrors(0),
+    fifoOverruns(0),
+    ringOverruns(0)
+#if LORA_RELIABLE
+    , airtime(LORA_DUTY_CYCLE_WINDOW_MS,
+              (uint32_t)((uint64_t)LORA_DUTY_CYCLE_WINDOW_MS * 1000 * LORA_DUTY_CYCLE_PERMILLE / 1000))
+#endif
+#if LORA_RX_INTERRUPT_DRIVEN
+    , taskHandle(nullptr),
+    scheduler(nullptr),
+    validPacketsHandled(0)
+#if LORA_RELIABLE
+    , txPending(false),
+    txOnAir(false),
+    txSent(0),
+    txStartedAt(0),
+    txTimeoutMs(0)
+#endif
+#endif
+{
+}
+
+LoRaReceiver::~LoRaReceiver() {
+#if LORA_RX_INTERRUPT_DRIVEN
+  if (taskHandle) {
+    detachInterrupt(digitalPinToInterrupt(LORA_DIO0_PIN));
+    gDrainTask = nullptr;
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+  }
+#endif
+}
+
+bool LoRaReceiver::initialize(LoopScheduler* wakeScheduler) {
   if (!LoRaRadio::initialize()) {
     LOG_ERROR("LORA", "SX1276 init failed");
     return false;
   }
+#if LORA_ADAPTIVE_RATE
+  LoRaRadio::applyDataRate(dataRate);  // Rendezvous
+#endif
+
+#if LORA_RELIABLE
+  String id = deviceId.get();
+  strncpy(sourceId, id.c_str(), sizeof(sourceId) - 1);
+  sourceId[sizeof(sourceId) - 1] = '\0';
+#endif
+
+#if LORA_RX_INTERRUPT_DRIVEN
+  scheduler = wakeScheduler;
 
-  LOG_INFO("LORA", "Receiver initialized (SF%d BW%.0fkHz)",
-           LORA_SPREADING_FACTOR, LORA_BANDWIDTH / 1000.0);
+  BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "loraRx", LORA_RX_TASK_STACK_SIZE, this,
+                                              LORA_RX_TASK_PRIORITY, &taskHandle, LORA_RX_TASK_CORE);
+  if (result != pdPASS) {
+    LOG_ERROR("LORA", "Failed to create RX drain task");
+    taskHandle = nullptr;
+    return false;
+  }
+  gDrainTask = taskHandle;
+
+  // Continuous RX never times out, so there is nothing to re-arm. The
+  // radio's valid-packet counter restarts on entering RX.
+  validPacketsHandled = 0;
+  pinMode(LORA_DIO0_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(LORA_DIO0_PIN), onLoRaRxDone, RISING);
+  LoRa.receive();
+
+  LOG_INFO("LORA", "Receiver initialized (SF%u BW%lukHz, DIO0 interrupt, %u-packet ring)",
+           (unsigned)dataRate.spreadingFactor, (unsigned long)(dataRate.bandwidthHz / 1000),
+           (unsigned)ring.capacity());
+#else
+  (void)wakeScheduler;
+  LOG_INFO("LORA", "Receiver initialized (SF%u BW%lukHz, polled)",
+           (unsigned)dataRate.spreadingFactor, (unsigned long)(dataRate.bandwidthHz / 1000));
+#endif
   return true;
 }
 
+#if LORA_RX_INTERRUPT_DRIVEN
+
+void LoRaReceiver::update() {
+  RawPacket packet;
+  while (ring.pop(packet)) {
+    lastRssi = packet.rssi;
+    lastSnr = packet.snr;
+    dispatch(packet.data, packet.length);
+  }
+}
+
+void LoRaReceiver::drainFifo() {
+  // Runs on the drain task - read and queue only, no logging here
+  bool queued = false;
+
+  for (;;) {
+    uint8_t irq = LoRaRadio::readRegister(LoRaRadio::Reg::IRQ_FLAGS);
+    if (!(irq & LoRaRadio::Irq::RX_DONE)) {
+      break;
+    }
+
+    // Read the counter before clearing, so it never includes a packet whose
+    // RxDone is still to come
+    uint8_t count[2];
+    LoRaRadio::readRegisters(LoRaRadio::Reg::RX_PACKET_CNT_MSB, count, sizeof(count));
+    uint16_t validPackets = (uint16_t)((count[0] << 8) | count[1]);
+
+    // Clearing re-arms DIO0 for the next packet
+    LoRaRadio::writeRegister(LoRaRadio::Reg::IRQ_FLAGS, irq);
+
+    if (irq & LoRaRadio::Irq::PAYLOAD_CRC_ERROR) {
+      radioCrcErrors++;
+      continue;
+    }
+
+    // Every valid packet the radio finished but we did not see was
+    // overwritten in the FIFO by a later one
+    validPacketsHandled++;
+    int16_t missed = (int16_t)(validPackets - validPacketsHandled);
+    if (missed > 0) {
+      fifoOverruns += (uint32_t)missed;
+      validPacketsHandled = validPackets;
+    }
+
+    RawPacket packet;
+    packet.length = (uint8_t)LoRaRadio::readPacket(packet.data, sizeof(packet.data));
+    if (packet.length == 0) {
+      radioCrcErrors++;  // Not one of ours; counted with the other corrupt packets
+      continue;
+    }
+    packet.rssi = (int16_t)LoRa.packetRssi();
+    packet.snr = LoRa.packetSnr();
+
+    if (!ring.push(packet)) {
+      ringOverruns++;
+      continue;
+    }
+    queued = true;
+  }
+
+  if (queued && scheduler) {
+    scheduler->signal(LoopEvent::LORA_RX);
+  }
+}
+
+void LoRaReceiver::taskEntry(void* param) {
+  LoRaReceiver* self = static_cast<LoRaReceiver*>(param);
+  for (;;) {
+    // The timeout re-checks the flags in case an edge was missed while they were set
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LORA_RX_IRQ_RECHECK_MS));
+    self->drainFifo();
+#if LORA_RELIABLE
+    self->serviceTx();
+#endif
+  }
+}
+
+#if LORA_RELIABLE
+void LoRaReceiver::serviceTx() {
+  // Runs on the drain task, like drainFifo()
+  if (txOnAir) {
+    uint8_t irq = LoRaRadio::readRegister(LoRaRadio::Reg::IRQ_FLAGS);
+    bool timedOut = millis() - txStartedAt >= txTimeoutMs;
+    if (!(irq & LoRaRadio::Irq::TX_DONE) && !timedOut) return;
+    LoRaRadio::writeRegister(LoRaRadio::Reg::IRQ_FLAGS, LoRaRadio::Irq::TX_DONE);
+    txOnAir = false;
+  } else if (!txPending.load()) {
+    return;
+  }
+
+  if (txSent < txRepeats) {
+    LoRa.beginPacket();  // Leaves RX; the transmitter is listening, not sending
+    LoRa.write(txBuffer, txLength);
+    LoRaRadio::writeRegister(LoRaRadio::Reg::DIO_MAPPING_1, LoRaRadio::DIO0_TX_DONE);
+    LoRa.endPacket(true);
+    txSent++;
+    txOnAir = true;
+    txStartedAt = millis();
+    return;
+  }
+
+#if LORA_ADAPTIVE_RATE
+  if (txNextRate >= 0) {
+    LoRa.idle();
+    LoRaRadio::applyDataRate(LoRaRate::TABLE[txNextRate]);
+  }
+#endif
+  // Back to continuous RX (maps DIO0 to RxDone); the valid-packet counter
+  // restarts there
+  validPacketsHandled = 0;
+  LoRa.receive();
+  txPending.store(false);
+  if (scheduler) scheduler->signal(LoopEvent::LORA_TX);
+}
+#endif
+
+#else
+
 void LoRaReceiver::update() {
   int packetSize = LoRa.parsePacket();
   if (packetSize <= 0) return;
@@ -33,20 +241,122 @@ void LoRaReceiver::update() {
   }
 
   lastRssi = LoRa.packetRssi();
+  lastSnr = LoRa.packetSnr();
+  dispatch(rxBuffer, bytesRead);
+}
+
+#endif
+
+#if LORA_RELIABLE
+
+bool LoRaReceiver::canTransmit() const {
+#if LORA_RX_INTERRUPT_DRIVEN
+  return !txPending.load();
+#else
+  return true;
+#endif
+}
+
+bool LoRaReceiver::sendAck(const char* destId, uint16_t base, uint32_t mask, uint8_t version) {
+  if (!canTransmit()) return false;
+
+  size_t len = LoRaProtocol::serializeAck(txBuffer, sizeof(txBuffer), sourceId, destId, base, mask, version);
+  if (!queueTx(len, 1, -1)) return false;
+  acksSent++;
+  return true;
+}
+
+#if LORA_ADAPTIVE_RATE
+bool LoRaReceiver::announceDataRate(uint8_t index) {
+  if (!canTransmit() || index >= LoRaRate::COUNT) return false;
 
-  // Deserialize (includes CRC validation)
+  size_t len = LoRaProtocol::serializeRateChange(txBuffer, sizeof(txBuffer), sourceId, nullptr, index,
+                                                   LORA_FRAME_VERSION);
+  return queueTx(len, LORA_RATE_ANNOUNCEMENTS, (int8_t)index);
+}
+
+bool LoRaReceiver::setDataRate(uint8_t index) {
+  if (!canTransmit() || index >= LoRaRate::COUNT) return false;
+  return queueTx(0, 0, (int8_t)index);
+}
+#endif
+
+// Caller has checked canTransmit() and put `len` bytes in txBuffer (len 0:
+// nothing to send)
+bool LoRaReceiver::queueTx(size_t len, uint8_t repeats, int8_t nextRate) {
+  uint32_t packetAirtimeUs = len ? LoRaRate::airtimeUs(dataRate, len) : 0;
+  uint32_t totalAirtimeUs = packetAirtimeUs * repeats;
+  unsigned long now = millis();
+  if (repeats > 0 && (len == 0 || !airtime.canSend(now, totalAirtimeUs))) return false;
+  if (totalAirtimeUs > 0) airtime.record(now, totalAirtimeUs);
+
+  // From here on ACKs are sized for the new rate; the radio follows after
+  // the last repeat
+  if (nextRate >= 0) dataRate = LoRaRate::TABLE[nextRate];
+#if LORA_FEC
+  if (len > 0) {
+    LoRaFec::encode(txBuffer, len, txBuffer + len);
+    len += LoRaFec::PARITY;
+  }
+#endif
+
+#if LORA_RX_INTERRUPT_DRIVEN
+  txLength = (uint8_t)len;
+  txRepeats = repeats;
+  txNextRate = nextRate;
+  txSent = 0;
+  txTimeoutMs = packetAirtimeUs / 1000 + 1 + LORA_TX_TIMEOUT_MARGIN_MS;
+  txPending.store(true);  // Hands the mailbox to the drain task
+  xTaskNotifyGive(taskHandle);
+#else
+  // Blocks for the time on air; the next parsePacket() returns to RX
+  for (uint8_t i = 0; i < repeats; i++) {
+    LoRa.beginPacket();
+    LoRa.write(txBuffer, len);
+    LoRa.endPacket();
+  }
+#if LORA_ADAPTIVE_RATE
+  if (nextRate >= 0) {
+    LoRa.idle();
+    LoRaRadio::applyDataRate(LoRaRate::TABLE[nextRate]);
+  }
+#endif
+#endif
+  return true;
+}
+
+#endif
+
+void LoRaReceiver::dispatch(uint8_t* data, size_t length) {
+  // Repair, then deserialize (includes CRC validation)
+  int corrected;
+  size_t frameLength = LoRaFec::decode(data, length, corrected);
   LoRaProtocol::ParsedPacket pkt;
-  if (!LoRaProtocol::deserialize(rxBuffer, bytesRead, pkt)) {
+  if (frameLength == 0 || !LoRaProtocol::deserialize(data, frameLength, pkt)) {
     crcErrors++;
     LOG_WARN("LORA", "CRC/parse error (RSSI %d, %u bytes, errors: %lu)",
-             lastRssi, (unsigned)bytesRead, (unsigned long)crcErrors);
+             lastRssi, (unsigned)length, (unsigned long)crcErrors);
     return;
   }
+#if LORA_FEC
+  if (corrected > 0) {
+    fecRepairs++;
+    fecBytesCorrected += (uint32_t)corrected;
+    LOG_DEBUG("LORA", "FEC repaired %d bytes (RSSI %d, SNR %.1f)", corrected, lastRssi, lastSnr);
+  }
+#endif
 
   packetsReceived++;
   LOG_DEBUG("LORA", "RX type=0x%02X from %s (RSSI %d, total: %lu)",
             (uint8_t)pkt.type, pkt.sourceId, lastRssi, (unsigned long)packetsReceived);
 
+  // Another receiver answering or steering its transmitters
+  if (pkt.type == LoRaProtocol::PacketType::ACK ||
+      pkt.type == LoRaProtocol::PacketType::RATE_CHANGE) {
+    return;
+  }
+  if (packetCallback && !packetCallback(pkt)) return;
+
   // Dispatch to registered callbacks
   switch (pkt.type) {
     case LoRaProtocol::PacketType::SHOT_DETECTED:
@@ -70,5 +380,21 @@ void LoRaReceiver::update() {
     case LoRaProtocol::PacketType::HEARTBEAT:
       if (heartbeatCallback) heartbeatCallback(pkt);
       break;
+    case LoRaProtocol::PacketType::SHOT_BATCH: {
+      // Expand back into the individual shots the transmitter coalesced
+      if (!shotCallback) break;
+      LoRaProtocol::ParsedPacket shotPkt = pkt;
+      shotPkt.type = LoRaProtocol::PacketType::SHOT_DETECTED;
+      for (size_t i = 0; i < pkt.batchCount; i++) {
+        shotPkt.shot = LoRaProtocol::batchShot(pkt, i);
+        shotCallback(shotPkt);
+      }
+      break;
+    }
+    case LoRaProtocol::PacketType::DEVICE_INFO:
+      break;  // Only for onPacketReceived
+    case LoRaProtocol::PacketType::ACK:
+    case LoRaProtocol::PacketType::RATE_CHANGE:
+      break;  // Returned above
   }
 }
@@ -1,9 +1,71 @@
 #include "LoRaTransmitter.h"
 #include "DeviceId.h"
+#include "LoRaFec.h"
 #include "LoRaRadio.h"
-#include "common.h"
+#include "ShotTrace.h"
+#include <atomic>
+#include <esp_system.h>
 
-bool LoRaTransmitter::initialize() {
+#if LORA_RELIABLE && !LORA_TX_ASYNC
+#error "LORA_RELIABLE needs LORA_TX_ASYNC (the radio listens for ACKs between transmissions)"
+#endif
+#if LORA_ADAPTIVE_RATE && !LORA_RELIABLE
+#error "LORA_ADAPTIVE_RATE needs LORA_RELIABLE (rate changes travel on the ACK path)"
+#endif
+#if LORA_FRAME_VERSION != 1 && LORA_FRAME_VERSION != 2
+#error "LORA_FRAME_VERSION must be 1 or 2"
+#endif
+
+namespace {
+// send*() runs on the BLE stack task, update() on the main loop; the queue
+// and the pending shot batch are shared. The radio itself is only touched
+// from update().
+portMUX_TYPE txLock = portMUX_INITIALIZER_UNLOCKED;
+
+#if LORA_TX_ASYNC
+std::atomic<bool> gDio0(false);
+LoopScheduler* gTxScheduler = nullptr;  // For the DIO0 ISR
+
+// SX1276 DIO0 = TxDone while transmitting, RxDone while listening for an
+// ACK or RATE_CHANGE (LORA_RELIABLE). The flags are read and cleared over SPI in update()
+// - SPI cannot run in an ISR on the ESP32.
+void IRAM_ATTR onLoRaDio0() {
+  gDio0.store(true);
+  if (gTxScheduler) gTxScheduler->signalFromISR(LoopEvent::LORA_TX);
+}
+#endif
+
+// Shot and session packets are numbered when LORA_RELIABLE; the heartbeat
+// needs no retransmission (the next one follows anyway) unless its ACK is
+// what tells an idle transmitter the rate is still right (LORA_ADAPTIVE_RATE)
+bool isSequenced(TxPriority priority) {
+  return LORA_RELIABLE && (LORA_ADAPTIVE_RATE || priority != TxPriority::HEARTBEAT);
+}
+
+// Sets the fields enqueue() and flushShotBatch() share. Caller holds txLock
+// (for `rate`).
+void prepare(TxPacket& packet, size_t len, TxPriority priority, const LoRaDataRate& rate) {
+  packet.length = (uint8_t)len;
+  packet.sequenced = isSequenced(priority);
+  packet.airtimeUs = LoRaRate::airtimeUs(rate, len + (packet.sequenced ? LoRaProtocol::SEQ_SIZE : 0));
+}
+}  // namespace
+
+LoRaTransmitter::LoRaTransmitter()
+  : airtime(LORA_DUTY_CYCLE_WINDOW_MS,
+            (uint32_t)((uint64_t)LORA_DUTY_CYCLE_WINDOW_MS * 1000 * LORA_DUTY_CYCLE_PERMILLE / 1000)),
+#if LORA_ADAPTIVE_RATE
+    dataRate(LoRaRate::TABLE[LORA_RATE_RENDEZVOUS])
+#else
+    dataRate(LoRaRate::configured())
+#endif
+#if LORA_RELIABLE
+    , history(LORA_ACK_TIMEOUT_MS, LORA_MAX_TRANSMISSIONS)
+#endif
+{
+}
+
+bool LoRaTransmitter::initialize(LoopScheduler* wakeScheduler) {
   // Store device ID for packet source field
   String id = deviceId.get();
   strncpy(sourceId, id.c_str(), sizeof(sourceId) - 1);
@@ -14,76 +76,480 @@ bool LoRaTransmitter::initialize() {
     return false;
   }
 
-  LOG_INFO("LORA", "Transmitter initialized (SF%d BW%.0fkHz %ddBm) src=%s",
-           LORA_SPREADING_FACTOR, LORA_BANDWIDTH / 1000.0,
-           LORA_TX_POWER, sourceId);
+  scheduler = wakeScheduler;
+#if LORA_TX_ASYNC
+  gTxScheduler = wakeScheduler;
+  pinMode(LORA_DIO0_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(LORA_DIO0_PIN), onLoRaDio0, RISING);
+#endif
+#if LORA_RELIABLE
+  // A fresh random start after every reboot, flagged SYNC until acknowledged,
+  // so the receiver never mistakes new packets for old duplicates
+  nextSeq = (uint16_t)esp_random();
+#if LORA_ADAPTIVE_RATE
+  switchDataRate(rateIndex);  // Rendezvous; the receiver announces any other
+#else
+  LoRa.receive();
+#endif
+#endif
+#if LORA_FRAME_VERSION == 2
+  // Tells receivers which sourceId the frames' hash stands for
+  portENTER_CRITICAL(&txLock);
+  queueDeviceInfo(TxPriority::SESSION);
+  portEXIT_CRITICAL(&txLock);
+#endif
+
+  LOG_INFO("LORA", "Transmitter initialized (SF%u BW%lukHz %ddBm) src=%s, duty cycle %u.%u%%",
+           (unsigned)dataRate.spreadingFactor, (unsigned long)(dataRate.bandwidthHz / 1000),
+           LORA_TX_POWER, sourceId,
+           (unsigned)(LORA_DUTY_CYCLE_PERMILLE / 10), (unsigned)(LORA_DUTY_CYCLE_PERMILLE % 10));
   return true;
 }
 
 void LoRaTransmitter::update() {
-  // Send periodic heartbeat so the receiver knows we're alive
   unsigned long now = millis();
+
+  // Finish the packet on air
+  if (transmitting) {
+#if LORA_TX_ASYNC
+    bool timedOut = now - txStartedAt >= txTimeoutMs;
+    if (gDio0.exchange(false) || timedOut) {
+      uint8_t irq = LoRaRadio::readRegister(LoRaRadio::Reg::IRQ_FLAGS);
+      if (irq & LoRaRadio::Irq::TX_DONE) {
+        LoRaRadio::writeRegister(LoRaRadio::Reg::IRQ_FLAGS, LoRaRadio::Irq::TX_DONE);
+        finishTransmit(true);
+      } else if (timedOut) {
+        LoRa.idle();
+        finishTransmit(false);
+      }
+    }
+#endif
+  }
+#if LORA_RELIABLE
+  else if (gDio0.exchange(false)) {
+    receiveControl();
+  }
+#endif
+
+  portENTER_CRITICAL(&txLock);
+  if (!shotBatch.empty() && now - batchOpenedAt >= LORA_SHOT_BATCH_WINDOW_MS) {
+    flushShotBatch();
+  }
+  portEXIT_CRITICAL(&txLock);
+
+  // Send periodic heartbeat so the receiver knows we're alive. It queues
+  // behind everything else; one still waiting is not duplicated.
   if (now - lastHeartbeat >= LORA_HEARTBEAT_INTERVAL) {
-    size_t len = LoRaProtocol::serializeHeartbeat(
-        txBuffer, sizeof(txBuffer), sourceId, (uint32_t)now);
-    if (len > 0) {
-      transmitPacket(txBuffer, len);
-      LOG_DEBUG("LORA", "Heartbeat sent (uptime %lu ms)", now);
+    portENTER_CRITICAL(&txLock);
+    bool heartbeatQueued = txQueue.size(TxPriority::HEARTBEAT) > 0;
+    portEXIT_CRITICAL(&txLock);
+    if (!heartbeatQueued) {
+      TxPacket packet;
+      size_t len = LoRaProtocol::serializeHeartbeat(
+          packet.data, sizeof(packet.data), sourceId, (uint32_t)now, LORA_FRAME_VERSION);
+      enqueue(TxPriority::HEARTBEAT, packet, len);
+      LOG_DEBUG("LORA", "Heartbeat queued (uptime %lu ms)", now);
     }
     lastHeartbeat = now;
   }
+#if LORA_FRAME_VERSION == 2
+  // For receivers that started after our last DEVICE_INFO
+  portENTER_CRITICAL(&txLock);
+  if (now - deviceInfoSentAt >= LORA_DEVICE_INFO_INTERVAL_MS) {
+    queueDeviceInfo(TxPriority::HEARTBEAT);
+  }
+  portEXIT_CRITICAL(&txLock);
+#endif
+
+  if (!transmitting) {
+    startNextTransmit(now);
+  }
+}
+
+uint32_t LoRaTransmitter::getMsUntilDue() const {
+  uint32_t due = LoopScheduler::NO_DEADLINE;
+  unsigned long now = millis();
+
+  if (transmitting) {
+    // TxDone normally wakes the loop first; this is the timeout
+    unsigned long elapsed = now - txStartedAt;
+    due = elapsed >= txTimeoutMs ? 0 : (uint32_t)(txTimeoutMs - elapsed);
+  }
+
+  portENTER_CRITICAL(&txLock);
+  if (!shotBatch.empty()) {
+    unsigned long elapsed = now - batchOpenedAt;
+    uint32_t batchDue = elapsed >= LORA_SHOT_BATCH_WINDOW_MS
+      ? 0 : (uint32_t)(LORA_SHOT_BATCH_WINDOW_MS - elapsed);
+    if (batchDue < due) due = batchDue;
+  }
+  bool canStart = !transmitting;
+#if LORA_RELIABLE
+  if (canStart && awaitingAck) {
+    // The ACK (RxDone) normally wakes the loop first; this is the timeout
+    unsigned long elapsed = now - ackWaitStartedAt;
+    uint32_t ackDue = elapsed >= ackTimeoutMs ? 0 : (uint32_t)(ackTimeoutMs - elapsed);
+    if (ackDue < due) due = ackDue;
+    canStart = false;
+  }
+  if (canStart) {
+    // A resend goes before anything queued
+    const LoRaTxHistory<LORA_TX_HISTORY_DEPTH>::Entry* resend = history.peekDue(now);
+    if (resend) {
+      uint32_t resendDue = airtime.msUntilAvailable(now, resend->packet.airtimeUs);
+      if (resendDue < due) due = resendDue;
+      canStart = false;
+    } else {
+      uint32_t historyDue = history.msUntilDue(now);
+      if (historyDue < due) due = historyDue;
+    }
+  }
+#endif
+  const TxPacket* next = canStart ? txQueue.front() : nullptr;
+  uint32_t budgetDue = next ? airtime.msUntilAvailable(now, next->airtimeUs) : LoopScheduler::NO_DEADLINE;
+  portEXIT_CRITICAL(&txLock);
+
+  return budgetDue < due ? budgetDue : due;
+}
+
+size_t LoRaTransmitter::getQueueDepth() const {
+  portENTER_CRITICAL(&txLock);
+  size_t depth = txQueue.size();
+  portEXIT_CRITICAL(&txLock);
+  return depth + (transmitting ? 1 : 0);
+}
+
+uint32_t LoRaTransmitter::getDrops() const {
+  portENTER_CRITICAL(&txLock);
+  uint32_t drops = txQueue.getDrops();
+  portEXIT_CRITICAL(&txLock);
+  return drops;
 }
 
+// ─── Queueing (any task) ─────────────────────────────────────
+
 bool LoRaTransmitter::sendShotDetected(const NormalizedShotData& shot) {
+#if LORA_SHOT_BATCHING
+  bool queued = true;
+  bool flushed = false;
+  portENTER_CRITICAL(&txLock);
+#if LORA_FRAME_VERSION == 2
+  if (strncmp(shot.deviceModel, deviceModel, LoRaProtocol::MODEL_LEN) != 0) {
+    queued = announceModel(shot.deviceModel);
+    flushed = true;
+  }
+#endif
+  if (!shotBatch.add(shot)) {
+    // Can't be delta-encoded after the pending shots — queue those first
+    queued = flushShotBatch();
+    flushed = true;
+    shotBatch.add(shot);
+  }
+  if (shotBatch.count() == 1) {
+    batchOpenedAt = millis();
+  }
+  if (shotBatch.full()) {
+    queued = flushShotBatch() && queued;
+    flushed = true;
+  }
+  portEXIT_CRITICAL(&txLock);
+
+  if (flushed && scheduler) scheduler->signal(LoopEvent::LORA_TX);
+  return queued;
+#else
+#if LORA_FRAME_VERSION == 2
+  portENTER_CRITICAL(&txLock);
+  bool announced = strncmp(shot.deviceModel, deviceModel, LoRaProtocol::MODEL_LEN) == 0 ||
+                   announceModel(shot.deviceModel);
+  portEXIT_CRITICAL(&txLock);
+  if (!announced) return false;
+#endif
+  TxPacket packet;
   size_t len = LoRaProtocol::serializeShotDetected(
-      txBuffer, sizeof(txBuffer), sourceId, shot);
+      packet.data, sizeof(packet.data), sourceId, shot, LORA_FRAME_VERSION);
   if (len == 0) return false;
-  return transmitPacket(txBuffer, len);
+  packet.traceCount = 1;
+  packet.traceOriginUs[0] = shot.traceOriginUs;
+  return enqueue(TxPriority::SHOT, packet, len);
+#endif
+}
+
+// Caller holds txLock (and signals the loop afterwards if needed)
+bool LoRaTransmitter::flushShotBatch() {
+  if (shotBatch.empty()) return true;
+
+  TxPacket packet;
+  size_t len = LoRaProtocol::serializeShotBatch(
+      packet.data, sizeof(packet.data), sourceId, shotBatch, LORA_FRAME_VERSION);
+  prepare(packet, len, TxPriority::SHOT, dataRate);
+  packet.traceCount = (uint8_t)shotBatch.count();
+  for (size_t i = 0; i < shotBatch.count(); i++) {
+    packet.traceOriginUs[i] = shotBatch.shot(i).traceOriginUs;
+  }
+  shotBatch.clear();
+
+  return len > 0 && txQueue.push(TxPriority::SHOT, packet);
+}
+
+#if LORA_FRAME_VERSION == 2
+// Caller holds txLock
+bool LoRaTransmitter::queueDeviceInfo(TxPriority priority) {
+  TxPacket packet;
+  size_t len = LoRaProtocol::serializeDeviceInfo(
+      packet.data, sizeof(packet.data), sourceId, deviceModel);
+  prepare(packet, len, priority, dataRate);
+  packet.traceCount = 0;
+  deviceInfoSentAt = millis();
+  return len > 0 && txQueue.push(priority, packet);
+}
+
+// v2 shots leave out the device model, so the receiver has to learn a new
+// one before the first shot from it. The pending batch (the old model) goes
+// first. Caller holds txLock.
+bool LoRaTransmitter::announceModel(const char* model) {
+  bool queued = flushShotBatch();
+  strncpy(deviceModel, model, LoRaProtocol::MODEL_LEN);
+  deviceModel[LoRaProtocol::MODEL_LEN] = '\0';
+  return queueDeviceInfo(TxPriority::SHOT) && queued;
+}
+#endif
+
+bool LoRaTransmitter::enqueue(TxPriority priority, TxPacket& packet, size_t len) {
+  if (len == 0) return false;
+  if (priority != TxPriority::SHOT) packet.traceCount = 0;
+
+  portENTER_CRITICAL(&txLock);
+  prepare(packet, len, priority, dataRate);
+  if (priority == TxPriority::SESSION) {
+    flushShotBatch();  // Shots first, so session events never overtake them
+  }
+  bool queued = txQueue.push(priority, packet);
+  portEXIT_CRITICAL(&txLock);
+
+  if (scheduler) scheduler->signal(LoopEvent::LORA_TX);
+  return queued;
 }
 
 bool LoRaTransmitter::sendSessionStarted(uint32_t sessionId, float startDelaySeconds) {
+#if LORA_FRAME_VERSION == 2
+  // Ahead of the session, for a receiver that restarted since the last one
+  portENTER_CRITICAL(&txLock);
+  queueDeviceInfo(TxPriority::SESSION);
+  portEXIT_CRITICAL(&txLock);
+#endif
+  TxPacket packet;
   size_t len = LoRaProtocol::serializeSessionStarted(
-      txBuffer, sizeof(txBuffer), sourceId, sessionId, startDelaySeconds);
-  if (len == 0) return false;
-  return transmitPacket(txBuffer, len);
+      packet.data, sizeof(packet.data), sourceId, sessionId, startDelaySeconds, LORA_FRAME_VERSION);
+  return enqueue(TxPriority::SESSION, packet, len);
 }
 
 bool LoRaTransmitter::sendSessionStopped(uint32_t sessionId, uint16_t totalShots, uint32_t lastShotTimeMs) {
+  TxPacket packet;
   size_t len = LoRaProtocol::serializeSessionStopped(
-      txBuffer, sizeof(txBuffer), sourceId, sessionId, totalShots, lastShotTimeMs);
-  if (len == 0) return false;
-  return transmitPacket(txBuffer, len);
+      packet.data, sizeof(packet.data), sourceId, sessionId, totalShots, lastShotTimeMs, LORA_FRAME_VERSION);
+  return enqueue(TxPriority::SESSION, packet, len);
 }
 
 bool LoRaTransmitter::sendCountdownComplete(uint32_t sessionId) {
+  TxPacket packet;
   size_t len = LoRaProtocol::serializeCountdownComplete(
-      txBuffer, sizeof(txBuffer), sourceId, sessionId);
-  if (len == 0) return false;
-  return transmitPacket(txBuffer, len);
+      packet.data, sizeof(packet.data), sourceId, sessionId, LORA_FRAME_VERSION);
+  return enqueue(TxPriority::SESSION, packet, len);
 }
 
 bool LoRaTransmitter::sendSessionSuspended(uint32_t sessionId) {
+  TxPacket packet;
   size_t len = LoRaProtocol::serializeSessionSuspended(
-      txBuffer, sizeof(txBuffer), sourceId, sessionId);
-  if (len == 0) return false;
-  return transmitPacket(txBuffer, len);
+      packet.data, sizeof(packet.data), sourceId, sessionId, LORA_FRAME_VERSION);
+  return enqueue(TxPriority::SESSION, packet, len);
 }
 
 bool LoRaTransmitter::sendSessionResumed(uint32_t sessionId) {
+  TxPacket packet;
   size_t len = LoRaProtocol::serializeSessionResumed(
-      txBuffer, sizeof(txBuffer), sourceId, sessionId);
-  if (len == 0) return false;
-  return transmitPacket(txBuffer, len);
+      packet.data, sizeof(packet.data), sourceId, sessionId, LORA_FRAME_VERSION);
+  return enqueue(TxPriority::SESSION, packet, len);
 }
 
-bool LoRaTransmitter::transmitPacket(const uint8_t* data, size_t len) {
+// ─── Radio (main loop) ───────────────────────────────────────
+
+void LoRaTransmitter::startNextTransmit(unsigned long now) {
+#if LORA_RELIABLE
+  if (awaitingAck) {
+    // millis(): the wait may have started after `now` was taken
+    if (millis() - ackWaitStartedAt < ackTimeoutMs) return;  // The receiver answers in this gap
+    awaitingAck = false;
+#if LORA_ADAPTIVE_RATE
+    ackMissed();
+#endif
+  }
+
+  // Resends keep their place ahead of anything queued. history is main-loop
+  // only, so no lock.
+  LoRaTxHistory<LORA_TX_HISTORY_DEPTH>::Entry* resend = history.due(now);
+  if (resend) {
+    if (!airtime.canSend(now, resend->packet.airtimeUs)) return;
+    inFlight = resend->packet;
+    inFlight.traceCount = 0;  // Traced on the first transmission
+    history.resent(*resend, now);
+    LOG_DEBUG("LORA", "Resending seq %u (attempt %u)", resend->seq, (unsigned)resend->transmissions);
+    transmit(now);
+    return;
+  }
+#endif
+
+  portENTER_CRITICAL(&txLock);
+  const TxPacket* next = txQueue.front();
+  bool ready = next && airtime.canSend(now, next->airtimeUs);
+  bool oversized = next && next->airtimeUs > airtime.getBudgetUs();
+  if (ready) {
+    inFlight = *next;
+    txQueue.pop();
+  } else if (oversized) {
+    txQueue.dropFront();
+  }
+  portEXIT_CRITICAL(&txLock);
+
+  if (oversized) {
+    LOG_ERROR("LORA", "Packet longer than the whole duty-cycle budget, dropped");
+  }
+  if (!ready) return;  // getMsUntilDue() wakes the loop when the budget has room
+
+#if LORA_RELIABLE
+  if (inFlight.sequenced) {
+    size_t len = LoRaProtocol::addSequence(inFlight.data, inFlight.length, sizeof(inFlight.data),
+                                           nextSeq, !synced);
+    inFlight.length = (uint8_t)len;
+    history.sent(inFlight, nextSeq, now);
+    nextSeq++;
+  }
+#endif
+  transmit(now);
+}
+
+void LoRaTransmitter::transmit(unsigned long now) {
+#if LORA_ADAPTIVE_RATE
+  // Queued (or first sent) at whatever rate was current then
+  inFlight.airtimeUs = LoRaRate::airtimeUs(dataRate, inFlight.length);
+#endif
+  airtime.record(now, inFlight.airtimeUs);
   LoRa.beginPacket();
-  LoRa.write(data, len);
-  if (LoRa.endPacket()) {
-    packetsSent++;
-    LOG_DEBUG("LORA", "TX %u bytes (total: %lu)", (unsigned)len, (unsigned long)packetsSent);
-    return true;
+  LoRa.write(inFlight.data, inFlight.length);
+#if LORA_FEC
+  uint8_t parity[LoRaFec::PARITY];
+  LoRaFec::encode(inFlight.data, inFlight.length, parity);
+  LoRa.write(parity, sizeof(parity));
+#endif
+
+#if LORA_TX_ASYNC
+  gDio0.store(false);
+  LoRaRadio::writeRegister(LoRaRadio::Reg::DIO_MAPPING_1, LoRaRadio::DIO0_TX_DONE);
+  LoRa.endPacket(true);
+  transmitting = true;
+  txStartedAt = now;
+  txTimeoutMs = inFlight.airtimeUs / 1000 + 1 + LORA_TX_TIMEOUT_MARGIN_MS;
+#else
+  finishTransmit(LoRa.endPacket() == 1);
+#endif
+}
+
+void LoRaTransmitter::finishTransmit(bool success) {
+  transmitting = false;
+#if LORA_RELIABLE
+  // Listen until the next transmission; a failed numbered packet is resent
+  // from the history once its ACK timeout passes
+  gDio0.store(false);
+  LoRa.receive();  // Maps DIO0 back to RxDone
+  if (success && inFlight.sequenced) {
+    awaitingAck = true;
+    ackWaitStartedAt = millis();
   }
-  LOG_ERROR("LORA", "TX failed (%u bytes)", (unsigned)len);
-  return false;
+#endif
+  if (!success) {
+    txFailures++;
+    LOG_ERROR("LORA", "TX failed (%u bytes, %lu failures)",
+              (unsigned)inFlight.length, (unsigned long)txFailures);
+    return;
+  }
+
+  packetsSent++;
+  for (size_t i = 0; i < inFlight.traceCount; i++) {
+    ShotTrace::record(TraceStage::LORA_TX, inFlight.traceOriginUs[i]);
+  }
+  LOG_DEBUG("LORA", "TX %u bytes, %lu us on air (total: %lu)",
+            (unsigned)inFlight.length, (unsigned long)inFlight.airtimeUs,
+            (unsigned long)packetsSent);
+}
+
+#if LORA_RELIABLE
+void LoRaTransmitter::receiveControl() {
+  uint8_t irq = LoRaRadio::readRegister(LoRaRadio::Reg::IRQ_FLAGS);
+  LoRaRadio::writeRegister(LoRaRadio::Reg::IRQ_FLAGS, irq);
+  if (!(irq & LoRaRadio::Irq::RX_DONE) || (irq & LoRaRadio::Irq::PAYLOAD_CRC_ERROR)) return;
+
+  uint8_t data[LoRaFec::MAX_FRAME_SIZE];
+  size_t length = LoRaRadio::readPacket(data, sizeof(data));
+  int corrected;
+  if (length > 0) length = LoRaFec::decode(data, length, corrected);
+  LoRaProtocol::ParsedPacket pkt;
+  if (length == 0 || !LoRaProtocol::deserialize(data, length, pkt)) return;
+
+  // Other transmitters' packets and ACKs are heard too
+  bool forUs = LoRaProtocol::addressedTo(pkt, sourceId);
+#if LORA_ADAPTIVE_RATE
+  if (pkt.type == LoRaProtocol::PacketType::RATE_CHANGE && (forUs || pkt.destId[0] == '\0')) {
+    if (pkt.rate < LoRaRate::COUNT && pkt.rate != rateIndex) {
+      LOG_INFO("LORA", "Receiver %s moved the link to DR%u", pkt.sourceId, (unsigned)pkt.rate);
+      switchDataRate(pkt.rate);
+    }
+    return;
+  }
+#endif
+  if (pkt.type != LoRaProtocol::PacketType::ACK || !forUs) return;
+
+  size_t confirmed = history.acknowledge(pkt.ackBase, pkt.ackMask);
+  synced = true;
+  awaitingAck = false;
+#if LORA_ADAPTIVE_RATE
+  ackMisses = 0;
+  hunting = false;
+#endif
+  LOG_DEBUG("LORA", "ACK base %u mask 0x%08lX: %u confirmed, %u outstanding",
+            pkt.ackBase, (unsigned long)pkt.ackMask, (unsigned)confirmed, (unsigned)history.size());
+}
+#endif
+
+#if LORA_ADAPTIVE_RATE
+void LoRaTransmitter::switchDataRate(uint8_t index) {
+  rateIndex = index;
+  portENTER_CRITICAL(&txLock);
+  dataRate = LoRaRate::TABLE[index];
+  portEXIT_CRITICAL(&txLock);
+
+  // The ACK takes longer on air at slower rates; a resend is due once the
+  // longest packet and its ACK could have gone by
+  const size_t ackLength = LoRaProtocol::HEADER_SIZE + LoRaProtocol::PAYLOAD_ACK + LoRaProtocol::CRC_SIZE;
+  ackTimeoutMs = LORA_ACK_TIMEOUT_MS + LoRaRate::airtimeUs(dataRate, ackLength) / 1000;
+  history.setTimeoutMs(ackTimeoutMs + LoRaRate::airtimeUs(dataRate, LoRaProtocol::MAX_PACKET_SIZE) / 1000);
+
+  // Not transmitting here: the radio is listening
+  LoRa.idle();
+  LoRaRadio::applyDataRate(LoRaRate::TABLE[index]);
+  gDio0.store(false);
+  LoRa.receive();
+}
+
+// The receiver may have moved on without us hearing the RATE_CHANGE, or
+// fallen back to the rendezvous rate
+void LoRaTransmitter::ackMissed() {
+  if (++ackMisses < LORA_RATE_FALLBACK_MISSES) return;
+  ackMisses = 0;
+
+  uint8_t next = (!hunting && rateIndex != LORA_RATE_RENDEZVOUS)
+    ? (uint8_t)LORA_RATE_RENDEZVOUS
+    : (uint8_t)((rateIndex + 1) % LoRaRate::COUNT);
+  hunting = true;
+  LOG_WARN("LORA", "No ACK at DR%u, trying DR%u", (unsigned)rateIndex, (unsigned)next);
+  switchDataRate(next);
 }
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @brief CRC-16/CCITT implementation benchmark for BLE-LoRa Bridge
+ *
+ * Times Crc16::bitwise(), table() and slice4() on the target CPU with the
+ * cycle counter, for a SHOT_DETECTED packet and a 1 KB buffer, and checks
+ * all three agree. Use it to pick LORA_CRC16_IMPL in common.h. The native
+ * test (test_crc16) reports the same comparison in ns/byte on the host.
+ *
+ * Build: pio run -e lora-bridge-tools-crc-bench -t upload
+ * Monitor: pio device monitor -b 115200
+ */
+#include <Arduino.h>
+#include "common.h"
+#include "Crc16.h"
+#include "LoRaPacket.h"
+
+static constexpr int ITERATIONS = 2000;
+static uint8_t buffer[1024];
+
+typedef uint16_t (*CrcFn)(const uint8_t*, size_t, uint16_t);
+
+static void benchmark(const char* name, CrcFn fn, size_t len) {
+  volatile uint16_t sink = 0;  // Keeps the loop from being optimised away
+  uint32_t start = ESP.getCycleCount();
+  for (int i = 0; i < ITERATIONS; i++) {
+    sink = sink ^ fn(buffer, len, Crc16::INIT);
+  }
+  uint32_t cycles = ESP.getCycleCount() - start;
+  Serial.printf("  %-8s %5u bytes: %8.2f cycles/byte, %8lu cycles/call\n",
+                name, (unsigned)len, (double)cycles / ((double)ITERATIONS * len),
+                (unsigned long)(cycles / ITERATIONS));
+}
+
+void setup() {
+  Serial.begin(SERIAL_BAUD_RATE);
+  delay(1000);
+  Serial.println("\n=== CRC-16/CCITT Benchmark ===");
+  Serial.printf("CPU %lu MHz, LORA_CRC16_IMPL = %d\n",
+                (unsigned long)getCpuFrequencyMhz(), LORA_CRC16_IMPL);
+
+  for (size_t i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = (uint8_t)(i * 31 + 7);
+  }
+
+  // Bit-exact check before timing anything
+  for (size_t len = 0; len <= sizeof(buffer); len += 37) {
+    uint16_t expected = Crc16::bitwise(buffer, len);
+    if (Crc16::table(buffer, len) != expected || Crc16::slice4(buffer, len) != expected) {
+      Serial.printf("MISMATCH at %u bytes\n", (unsigned)len);
+      return;
+    }
+  }
+  Crc16::sliceTables();  // Build the slice tables outside the timed loop
+
+  const size_t sizes[] = { LoRaProtocol::HEADER_SIZE + LoRaProtocol::PAYLOAD_SHOT_DETECTED, sizeof(buffer) };
+  for (size_t len : sizes) {
+    benchmark("bitwise", Crc16::bitwise, len);
+    benchmark("table", Crc16::table, len);
+    benchmark("slice4", Crc16::slice4, len);
+  }
+}
+
+void loop() {
+  delay(1000);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Minimal host-side benchmark harness for the native-bench env
+ *
+ * Each case times one operation (one BLE notification, one LoRa frame)
+ * over batches of calls sized to run for at least MIN_BATCH_NS, and keeps
+ * the fastest of REPEATS batches. Heap allocations are counted by the
+ * global operator new in bench_main.cpp over the same calls.
+ *
+ * Results are compared against a baseline JSON (see bench_main.cpp):
+ * a case regresses if it is slower than the baseline by more than the
+ * tolerance, or allocates more.
+ */
+namespace Bench {
+
+// Incremented by every global operator new (bench_main.cpp)
+extern uint64_t allocations;
+
+struct Result {
+  std::string name;
+  double nsPerOp;
+  double allocsPerOp;
+};
+
+class Runner {
+public:
+  static constexpr uint64_t MIN_BATCH_NS = 20000000;  // 20 ms
+  static constexpr int REPEATS = 5;
+  static constexpr uint64_t WARMUP_OPS = 1000;
+
+  // `op(i)` performs operation i; cases cycle through their inputs with it
+  template <typename Op>
+  void run(const char* name, Op op) {
+    uint64_t i = 0;
+    for (; i < WARMUP_OPS; i++) op(i);
+
+    // Calibrate: double the batch until it takes MIN_BATCH_NS
+    uint64_t batch = 64;
+    while (timeBatch(op, i, batch) < MIN_BATCH_NS && batch < (1ull << 30)) batch *= 2;
+
+    uint64_t bestNs = UINT64_MAX;
+    for (int r = 0; r < REPEATS; r++) {
+      uint64_t ns = timeBatch(op, i, batch);
+      if (ns < bestNs) bestNs = ns;
+    }
+
+    uint64_t allocsBefore = allocations;
+    for (uint64_t n = 0; n < batch; n++) op(i++);
+    uint64_t allocs = allocations - allocsBefore;
+
+    Result result = {name, (double)bestNs / batch, (double)allocs / batch};
+    results_.push_back(result);
+  }
+
+  const std::vector<Result>& results() const { return results_; }
+
+private:
+  template <typename Op>
+  static uint64_t timeBatch(Op& op, uint64_t& i, uint64_t batch) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t n = 0; n < batch; n++) op(i++);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  }
+
+  std::vector<Result> results_;
+};
+
+// Keeps the compiler from discarding a result
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Benchmark groups (one file each)
+void parserBenchmarks(Runner& runner);  // bench_parsers.cpp
+void loraBenchmarks(Runner& runner);    // bench_lora.cpp
+
+}  // namespace Bench
@@ -0,0 +1,60 @@
+/**
+ * @file bench_lora.cpp
+ * @brief Throughput of LoRaProtocol::deserialize on the receiver
+ *
+ * Frames are built once with the bridge's serializers, then decoded in a
+ * loop (CRC check included). One op = one frame.
+ */
+
+// The bridge's common.h (LORA_CRC16_IMPL) must win the shared COMMON_H guard
+#include "../../BLE-LoRa-Bridge/include/common.h"
+#include "../../BLE-LoRa-Bridge/src/LoRaPacket.cpp"
+
+#include "BenchHarness.h"
+
+#include <cstring>
+
+namespace Bench {
+
+static NormalizedShotData makeShot(uint16_t number, uint32_t absMs, uint32_t splitMs) {
+  NormalizedShotData shot;
+  shot.sessionId = 0x12345678;
+  shot.shotNumber = number;
+  shot.absoluteTimeMs = absMs;
+  shot.splitTimeMs = splitMs;
+  shot.isFirstShot = (number == 1);
+  strncpy(shot.deviceModel, "SG Timer", sizeof(shot.deviceModel) - 1);
+  return shot;
+}
+
+static void benchFrame(Runner& runner, const char* name, const uint8_t* frame, size_t len) {
+  LoRaProtocol::ParsedPacket pkt;
+  runner.run(name, [&](uint64_t) {
+    bool ok = LoRaProtocol::deserialize(frame, len, pkt);
+    doNotOptimize(ok);
+  });
+}
+
+void loraBenchmarks(Runner& runner) {
+  const char* sourceId = "A1B2C3";
+  uint8_t buf[LoRaProtocol::MAX_PACKET_SIZE];
+  size_t len;
+
+  NormalizedShotData shot = makeShot(1, 1843, 1843);
+  len = LoRaProtocol::serializeShotDetected(buf, sizeof(buf), sourceId, shot);
+  benchFrame(runner, "LoRaProtocol::deserialize SHOT_DETECTED v1", buf, len);
+
+  len = LoRaProtocol::serializeShotDetected(buf, sizeof(buf), sourceId, shot, LoRaProtocol::FRAME_V2);
+  benchFrame(runner, "LoRaProtocol::deserialize SHOT_DETECTED v2", buf, len);
+
+  LoRaProtocol::ShotBatch batch;
+  uint32_t t = 1700;
+  for (uint16_t i = 1; i <= 12; i++, t += 215) batch.add(makeShot(i, t, i == 1 ? 1700 : 215));
+  len = LoRaProtocol::serializeShotBatch(buf, sizeof(buf), sourceId, batch);
+  benchFrame(runner, "LoRaProtocol::deserialize SHOT_BATCH(12) v1", buf, len);
+
+  len = LoRaProtocol::serializeShotBatch(buf, sizeof(buf), sourceId, batch, LoRaProtocol::FRAME_V2);
+  benchFrame(runner, "LoRaProtocol::deserialize SHOT_BATCH(12) v2", buf, len);
+}
+
+}  // namespace Bench
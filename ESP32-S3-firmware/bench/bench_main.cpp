@@ -0,0 +1,140 @@
+/**
+ * @file bench_main.cpp
+ * @brief Host benchmarks for the BLE parsers and the LoRa decoder
+ *
+ * Prints ns and heap allocations per op for every case and compares them
+ * with a stored baseline. Exits non-zero on a regression: slower than the
+ * baseline by more than BENCH_TOLERANCE percent, or more allocations.
+ *
+ * Timings depend on the host and compiler; allocation counts do not. After
+ * an intended change (or on a new machine) re-record the baseline with
+ * BENCH_UPDATE=1.
+ *
+ * Command: pio run -e native-bench -t exec
+ *
+ * Environment:
+ *   BENCH_BASELINE   baseline file (default ESP32-S3-firmware/bench/baseline.json)
+ *   BENCH_TOLERANCE  allowed slowdown in percent (default 20)
+ *   BENCH_UPDATE=1   write the results as the new baseline instead of comparing
+ */
+
+#include "BenchHarness.h"
+#include "Logger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+
+// ─── Heap accounting ─────────────────────────────────────────────
+// Counts every operator new in the binary (std::function, std::vector, ...)
+
+uint64_t Bench::allocations = 0;
+
+void* operator new(size_t size) {
+  Bench::allocations++;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// ─── Baseline file ───────────────────────────────────────────────
+// One case per line: "name": {"ns": 41.3, "allocs": 0.00}
+
+struct Baseline {
+  double nsPerOp;
+  double allocsPerOp;
+};
+
+static const char* DEFAULT_BASELINE = "ESP32-S3-firmware/bench/baseline.json";
+
+static bool loadBaseline(const char* path, std::map<std::string, Baseline>& out) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char line[256];
+  while (fgets(line, sizeof(line), f)) {
+    char name[128];
+    Baseline entry;
+    if (sscanf(line, " \"%127[^\"]\": {\"ns\": %lf, \"allocs\": %lf}",
+               name, &entry.nsPerOp, &entry.allocsPerOp) == 3) {
+      out[name] = entry;
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+static bool saveBaseline(const char* path, const std::vector<Bench::Result>& results) {
+  FILE* f = fopen(path, "w");
+  if (!f) return false;
+  fprintf(f, "{\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    fprintf(f, "  \"%s\": {\"ns\": %.1f, \"allocs\": %.2f}%s\n", results[i].name.c_str(),
+            results[i].nsPerOp, results[i].allocsPerOp, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(f, "}\n");
+  fclose(f);
+  return true;
+}
+
+int main() {
+  Logger::setLevel(LogLevel::NONE);  // Parsers log every notification
+
+  const char* env = getenv("BENCH_BASELINE");
+  const char* baselinePath = env && *env ? env : DEFAULT_BASELINE;
+  env = getenv("BENCH_TOLERANCE");
+  double tolerance = env && *env ? atof(env) : 20.0;
+  env = getenv("BENCH_UPDATE");
+  bool update = env && strcmp(env, "1") == 0;
+
+  Bench::Runner runner;
+  Bench::parserBenchmarks(runner);
+  Bench::loraBenchmarks(runner);
+  const std::vector<Bench::Result>& results = runner.results();
+
+  if (update) {
+    if (!saveBaseline(baselinePath, results)) {
+      fprintf(stderr, "Cannot write %s\n", baselinePath);
+      return 1;
+    }
+  }
+
+  std::map<std::string, Baseline> baseline;
+  bool compare = !update && loadBaseline(baselinePath, baseline);
+
+  int regressions = 0;
+  printf("\n%-46s %10s %10s %10s  %s\n", "benchmark", "ns/op", "allocs/op", "baseline", "");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Bench::Result& r = results[i];
+    std::map<std::string, Baseline>::const_iterator base = baseline.find(r.name);
+    if (!compare || base == baseline.end()) {
+      printf("%-46s %10.1f %10.2f %10s  %s\n", r.name.c_str(), r.nsPerOp, r.allocsPerOp, "-",
+             compare ? "new" : "");
+      continue;
+    }
+    double change = (r.nsPerOp / base->second.nsPerOp - 1.0) * 100.0;
+    bool slower = change > tolerance;
+    bool allocates = r.allocsPerOp > base->second.allocsPerOp + 0.005;
+    if (slower || allocates) regressions++;
+    printf("%-46s %10.1f %10.2f %10.1f  %+.0f%%%s%s\n", r.name.c_str(), r.nsPerOp, r.allocsPerOp,
+           base->second.nsPerOp, change, slower ? "  SLOWER" : "", allocates ? "  MORE ALLOCS" : "");
+  }
+
+  if (update) {
+    printf("\nBaseline written to %s\n", baselinePath);
+  } else if (!compare) {
+    printf("\nNo baseline at %s (BENCH_UPDATE=1 records one)\n", baselinePath);
+  } else if (regressions) {
+    printf("\n%d regression(s) against %s (tolerance %.0f%%)\n", regressions, baselinePath, tolerance);
+    return 1;
+  } else {
+    printf("\nNo regressions against %s (tolerance %.0f%%)\n", baselinePath, tolerance);
+  }
+  return 0;
+}
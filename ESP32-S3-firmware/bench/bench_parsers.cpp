@@ -0,0 +1,86 @@
+/**
+ * @file bench_parsers.cpp
+ * @brief Throughput of the BLE timer parsers (processTimerData)
+ *
+ * Each case feeds one device's notification stream - session start, a
+ * string of shots, session stop - through processNotification() in a loop,
+ * with the shot and session callbacks registered the way the firmware
+ * registers them. One op = one notification.
+ */
+
+#include "BenchHarness.h"
+#include "common.h"
+#include "ASNTracker.h"
+#include "Logger.h"
+#include "SGTimer.h"
+#include "SpecialPieM1A2F.h"
+#include "SpecialPieM1A2Plus.h"
+
+#include <vector>
+
+namespace Bench {
+
+typedef std::vector<std::vector<uint8_t>> Stream;
+
+static const int SHOTS_PER_STRING = 10;
+
+// SG Timer: len, event, sessionId(4 BE), ... (see SGTimer.cpp)
+static Stream sgTimerStream() {
+  const uint8_t session[4] = {0x00, 0x01, 0xE2, 0x40};
+  Stream stream;
+  stream.push_back({0x07, 0x00, session[0], session[1], session[2], session[3], 0x00, 0x1E});
+  uint32_t timeMs = 1500;
+  for (int shot = 0; shot < SHOTS_PER_STRING; shot++, timeMs += 230) {
+    stream.push_back({0x0B, 0x04, session[0], session[1], session[2], session[3],
+                      (uint8_t)(shot >> 8), (uint8_t)shot,
+                      (uint8_t)(timeMs >> 24), (uint8_t)(timeMs >> 16),
+                      (uint8_t)(timeMs >> 8), (uint8_t)timeMs});
+  }
+  stream.push_back({0x07, 0x03, session[0], session[1], session[2], session[3],
+                    0x00, (uint8_t)SHOTS_PER_STRING});
+  return stream;
+}
+
+// Special Pie framing shared by M1A2+, M1A2F and the ASN tracker:
+// F8 F9 type ... F9 F8
+static Stream specialPieStream() {
+  Stream stream;
+  stream.push_back({0xF8, 0xF9, 0x34, 0x01, 0x00, 0x00, 0xF9, 0xF8});
+  uint32_t centis = 150;
+  for (int shot = 0; shot < SHOTS_PER_STRING; shot++, centis += 23) {
+    stream.push_back({0xF8, 0xF9, 0x36, 0x00, (uint8_t)(centis / 100), (uint8_t)(centis % 100),
+                      (uint8_t)shot, 0x00, 0xF9, 0xF8});
+  }
+  stream.push_back({0xF8, 0xF9, 0x18, 0x01, 0x00, 0x00, 0xF9, 0xF8});
+  return stream;
+}
+
+static void benchDevice(Runner& runner, const char* name, BaseTimerDevice& device,
+                        Stream stream) {
+  static uint32_t shots = 0;
+  device.onShotDetected([](const NormalizedShotData& shot) { shots += shot.shotNumber; });
+  device.onSessionStarted([](const SessionData& session) { shots += session.sessionId; });
+  device.onSessionStopped([](const SessionData& session) { shots += session.totalShots; });
+
+  runner.run(name, [&](uint64_t i) {
+    std::vector<uint8_t>& frame = stream[i % stream.size()];
+    device.processNotification(frame.data(), frame.size(), (int64_t)i);
+  });
+  doNotOptimize(shots);
+}
+
+void parserBenchmarks(Runner& runner) {
+  SGTimer sgTimer;
+  benchDevice(runner, "SGTimer::processTimerData", sgTimer, sgTimerStream());
+
+  SpecialPieM1A2Plus specialPie;
+  benchDevice(runner, "SpecialPieM1A2Plus::processTimerData", specialPie, specialPieStream());
+
+  SpecialPieM1A2F specialPieF;
+  benchDevice(runner, "SpecialPieM1A2F::processTimerData", specialPieF, specialPieStream());
+
+  ASNTracker asn;
+  benchDevice(runner, "ASNTracker::processTimerData", asn, specialPieStream());
+}
+
+}  // namespace Bench
@@ -16,7 +16,7 @@ enum class ASNMessageType : uint8_t {
 class ASNTracker : public BaseTimerDevice {
 private:
   // ASN Tracker specific configuration
-  static const char* LOG_TAG;
+  static constexpr const char* LOG_TAG = "ASN-Tracker";
   static const char* CHARACTERISTIC_UUID;
 
   // BLE components
@@ -30,11 +30,8 @@ private:
   bool sessionActiveFlag;
 
   // Internal methods
-  void processTimerData(uint8_t* data, size_t length);
+  void processTimerData(uint8_t* data, size_t length) override;
 
-  // Static callback for BLE notifications
-  static void notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                           uint8_t* pData, size_t length, bool isNotify);
 
 public:
   ASNTracker();
@@ -47,7 +44,4 @@ public:
 
   // Public connection method for TimerApplication
   bool attemptConnection(BLEAdvertisedDevice* device);
-
-  // Static instance for callbacks
-  static ASNTracker* instance;
 };
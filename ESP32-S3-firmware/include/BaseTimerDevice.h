@@ -2,9 +2,11 @@
 
 #include "ITimerDevice.h"
 #include "Logger.h"
+#include "ShotTrace.h"
 #include "common.h"
 #include <BLEDevice.h>
 #include <BLEClient.h>
+#include <atomic>
 
 /**
  * @brief Base class for timer device implementations
@@ -15,6 +17,7 @@
  * - Connection state tracking
  * - Update loop with heartbeat logging
  * - Connection lost handling with automatic cleanup
+ * - BLE notify routing, so several devices can be connected at once
  *
  * Derived classes typically implement:
  * - attemptConnection(BLEAdvertisedDevice*) - Device-specific connection logic
@@ -47,6 +50,60 @@ protected:
   std::function<void(const SessionData&)> sessionResumedCallback;
   std::function<void(DeviceConnectionState)> connectionStateCallback;
 
+  // Optional hand-off for raw notifications (set when the BLE ingest task is active)
+  std::function<bool(const uint8_t*, size_t, int64_t)> notificationSink;
+
+  // Arrival time of the notification currently being parsed (stamped into traceOriginUs)
+  int64_t notifyTimestampUs;
+
+  // Device-specific protocol parser
+  virtual void processTimerData(uint8_t* data, size_t length) = 0;
+
+  // Registers for notifications on a characteristic of this device's connection.
+  // The BLE stack only takes a plain function, so every device registers the
+  // shared routeNotification() and a route table maps the characteristic back
+  // to its device - instead of a per-class static instance, which allowed one
+  // connected device per class.
+  bool subscribe(BLERemoteCharacteristic* characteristic) {
+    NotifyRoute* routes = notifyRoutes();
+    for (size_t i = 0; i < MAX_NOTIFY_ROUTES; i++) {
+      if (routes[i].characteristic.load(std::memory_order_relaxed) == nullptr) {
+        routes[i].device.store(this, std::memory_order_relaxed);
+        routes[i].characteristic.store(characteristic, std::memory_order_release);
+        characteristic->registerForNotify(routeNotification);
+        return true;
+      }
+    }
+    LOG_ERROR("BLE", "%s: no free notification route", deviceModel);
+    return false;
+  }
+
+  // Drops this device's routes - later notifications for it are ignored.
+  // Waits for a notification already being dispatched to this device, so the
+  // caller may delete it afterwards. Not from the BLE stack task.
+  void unsubscribeAll() {
+    NotifyRoute* routes = notifyRoutes();
+    for (size_t i = 0; i < MAX_NOTIFY_ROUTES; i++) {
+      if (routes[i].device.load(std::memory_order_relaxed) == this) {
+        routes[i].device.store(nullptr);
+        routes[i].characteristic.store(nullptr, std::memory_order_release);
+        while (routes[i].inUse.load() != 0) {
+          vTaskDelay(1);
+        }
+      }
+    }
+  }
+
+  // Entry point for routed BLE notifications - defers to the sink if present
+  void dispatchNotification(uint8_t* pData, size_t length) {
+    int64_t receivedUs = ShotTrace::nowUs();
+    if (notificationSink && notificationSink(pData, length, receivedUs)) {
+      return;
+    }
+    notifyTimestampUs = receivedUs;
+    processTimerData(pData, length);
+  }
+
   // Internal helper - sets state and notifies callback
   void setConnectionState(DeviceConnectionState newState) {
     if (connectionState != newState) {
@@ -57,6 +114,43 @@ protected:
     }
   }
 
+private:
+  // Written on the main loop (subscribe/unsubscribeAll), read on the BLE stack task
+  struct NotifyRoute {
+    std::atomic<BLERemoteCharacteristic*> characteristic;
+    std::atomic<BaseTimerDevice*> device;
+    std::atomic<uint8_t> inUse;  // Dispatches in progress; unsubscribeAll() waits for 0
+  };
+  static constexpr size_t MAX_NOTIFY_ROUTES = MAX_TIMER_LANES * 2;
+
+  static NotifyRoute* notifyRoutes() {
+    static NotifyRoute routes[MAX_NOTIFY_ROUTES];  // Zero-initialized: all free
+    return routes;
+  }
+
+  // Registered with the BLE stack for every subscribed characteristic. The
+  // route is marked in use before the device is read (both sequentially
+  // consistent, as is the clear in unsubscribeAll()), so either the device
+  // is seen as gone or unsubscribeAll() waits for the dispatch to finish.
+  static void routeNotification(BLERemoteCharacteristic* characteristic,
+                                uint8_t* pData, size_t length, bool /*isNotify*/) {
+    if (!pData || length == 0) {
+      return;
+    }
+    NotifyRoute* routes = notifyRoutes();
+    for (size_t i = 0; i < MAX_NOTIFY_ROUTES; i++) {
+      if (routes[i].characteristic.load(std::memory_order_acquire) == characteristic) {
+        routes[i].inUse.fetch_add(1);
+        BaseTimerDevice* device = routes[i].device.load();
+        if (device && routes[i].characteristic.load(std::memory_order_acquire) == characteristic) {
+          device->dispatchNotification(pData, length);
+        }
+        routes[i].inUse.fetch_sub(1, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
 public:
   BaseTimerDevice(const char* model)
     : pClient(nullptr),
@@ -67,7 +161,8 @@ public:
       lastHeartbeat(0),
       deviceAddress("00:00:00:00:00:00"),
       deviceName{},
-      deviceModel{} {
+      deviceModel{},
+      notifyTimestampUs(0) {
     strncpy(deviceModel, model, sizeof(deviceModel) - 1);
   }
 
@@ -77,13 +172,13 @@ public:
 
   // Common ITimerDevice implementations
   bool initialize() override {
-    LOG_INFO("Initializing %s device interface", deviceModel);
+    LOG_TIMER("Initializing %s device interface", deviceModel);
     setConnectionState(DeviceConnectionState::DISCONNECTED);
     return true;
   }
 
   bool startScanning() override {
-    LOG_INFO("Will start scanning for %s devices", deviceModel);
+    LOG_TIMER("Will start scanning for %s devices", deviceModel);
     setConnectionState(DeviceConnectionState::SCANNING);
     return true;
   }
@@ -94,6 +189,7 @@ public:
   }
 
   void disconnect() override {
+    unsubscribeAll();
     if (pClient) {
       pClient->disconnect();
       delete pClient;
@@ -153,11 +249,20 @@ public:
     connectionStateCallback = callback;
   }
 
+  void setNotificationSink(std::function<bool(const uint8_t*, size_t, int64_t)> sink) override {
+    notificationSink = sink;
+  }
+
+  void processNotification(uint8_t* data, size_t length, int64_t receivedUs) override {
+    notifyTimestampUs = receivedUs;
+    processTimerData(data, length);
+  }
+
   // Default implementations for optional features
   bool supportsRemoteStart() const override { return false; }
   bool supportsShotList() const override { return false; }
   bool supportsSessionControl() const override { return false; }
-  bool requestShotList(uint32_t sessionId) override { return false; }
+  bool requestShotList(uint32_t /*sessionId*/) override { return false; }
   bool startSession() override { return false; }
   bool stopSession() override { return false; }
 
@@ -181,6 +286,7 @@ protected:
   // Can be overridden by derived classes for device-specific cleanup
   virtual void handleConnectionLost() {
     LOG_WARN("BLE", "Connection lost");
+    unsubscribeAll();
     isConnectedFlag = false;
     pService = nullptr;
 
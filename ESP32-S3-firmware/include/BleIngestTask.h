@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ITimerDevice.h"
+#include "SpscRing.h"
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/**
+ * @brief Dedicated FreeRTOS task for BLE notification parsing
+ *
+ * The BLE stack callback only copies the raw payload into a lock-free
+ * SPSC ring and wakes this task. Parsing (processTimerData) and the
+ * resulting ITimerDevice callbacks then run here, pinned to one core,
+ * instead of on the Bluedroid task or in the main loop.
+ *
+ * Each connected timer is attached on its own lane; payloads carry the
+ * lane so one ring serves every connection. All notifications arrive on
+ * the single Bluedroid task, so the ring keeps exactly one producer.
+ *
+ * Producer: BLE stack task (via the device notification sinks)
+ * Consumer: this task
+ */
+class BleIngestTask {
+public:
+  static constexpr size_t MAX_PAYLOAD_SIZE = 32;  // Largest supported notification (bytes)
+  static constexpr size_t RING_SIZE = 16;         // Must be power of 2
+
+  BleIngestTask();
+  ~BleIngestTask();
+
+  bool start(BaseType_t core, UBaseType_t priority, uint32_t stackSize);
+
+  // Route a device's notifications through this task (replaces the lane's previous device)
+  void attach(uint8_t lane, ITimerDevice* device);
+  // Stop routing a lane - must be called before its device is destroyed
+  void detach(uint8_t lane);
+
+  // Diagnostics
+  uint32_t getProcessedCount() const { return processedCount.load(); }
+  uint32_t getDroppedCount() const { return droppedCount.load(); }
+  uint16_t getPeakDepth() const { return peakDepth.load(); }
+
+private:
+  struct RawNotification {
+    int64_t receivedUs;  // esp_timer arrival time (shot trace origin)
+    uint8_t lane;
+    uint8_t generation;
+    uint8_t length;
+    uint8_t data[MAX_PAYLOAD_SIZE];
+  };
+
+  SpscRing<RawNotification, RING_SIZE> ring;
+  TaskHandle_t taskHandle;
+  SemaphoreHandle_t deviceMutex;  // Guards device lifetime, not the data path
+  ITimerDevice* devices[MAX_TIMER_LANES];
+  std::atomic<uint8_t> generations[MAX_TIMER_LANES];  // Bumped on attach/detach to discard stale payloads
+
+  std::atomic<uint32_t> processedCount;
+  std::atomic<uint32_t> droppedCount;
+  std::atomic<uint16_t> peakDepth;
+
+  bool submit(uint8_t lane, const uint8_t* data, size_t length, int64_t receivedUs);  // Called on the BLE stack task
+  void drain();
+
+  static void taskEntry(void* param);
+};
@@ -2,6 +2,10 @@
 
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "ITimerDevice.h"
+#include "FramePacer.h"
+#include "GlyphAtlas.h"
+#include "ShadowFramebuffer.h"
+#include "TextWidthCache.h"
 #include "common.h"
 
 // Display states
@@ -31,6 +35,19 @@ struct DisplayColors {
 class DisplayManager {
 private:
   MatrixPanel_I2S_DMA* display;
+
+  // Renderers draw into target: the shadow framebuffer (diffed onto the
+  // panel by presentFrame()) or, if it could not be allocated, the panel
+  ShadowFramebuffer framebuffer;
+  Adafruit_GFX* target;
+
+  // Double-buffered output (HUB75_DOUBLE_BUFFER) and frame accounting
+  bool doubleBuffered;
+  size_t dmaBufferBytes;          // Measured DMA heap cost of display->begin()
+  unsigned long lastFlipTime;
+  int64_t pendingTraceOriginUs;   // Shot rendered but not yet on the panel
+  uint32_t framesPresented;
+  uint32_t pixelsPresented;
   DisplayState currentState;
   unsigned long lastUpdateTime;
 
@@ -55,16 +72,31 @@ private:
 
   // Marquee scrolling state (for device name in CONNECTED state)
   int16_t scrollOffset;
-  unsigned long lastScrollUpdate;
+  FramePacer scrollPacer;
   int16_t textPixelWidth;
 
   // Marquee scrolling state for startup message
   int16_t startupScrollOffset;
-  unsigned long startupLastScrollUpdate;
+  FramePacer startupScrollPacer;
   int16_t startupTextPixelWidth;
+  uint32_t startupTextRevision;   // WiFiConfig revision the width was measured for
+  uint32_t startupTextHash;
+
+  // Measured u8g2 text widths, keyed by (font, string hash)
+  TextWidthCache widthCache;
 
   static const uint16_t SCROLL_SPEED_MS = 25;  // Update scroll every 25ms
   static const uint16_t SCROLL_PAUSE_MS = 1000; // Pause at start/end
+  static const uint16_t COUNTDOWN_REFRESH_MS = 100; // Countdown redraw period
+  // A flip lands at the end of the frame being scanned out - wait at least one
+  // refresh period (+ millis() granularity) before drawing into the old front buffer
+  static const uint16_t FLIP_GUARD_MS = 1000 / HUB75_MIN_REFRESH_RATE + 2;
+
+  FramePacer countdownPacer;
+
+  // Pre-rasterized glyphs for the shot/split screens
+  GlyphAtlas labelAtlas;  // helvR10: labels and split time
+  GlyphAtlas timeAtlas;   // helvB18: absolute time
 
   // Signal that display needs to be redrawn
   void markDirty(bool clearFirst = true);
@@ -78,6 +110,16 @@ private:
   void renderSessionEnd();
   void clearDisplay();
   void clearConnectionDetailLine();
+  void buildGlyphAtlases();
+  void presentFrame();
+
+  // Exact pixel width of text in font (cached after the first measurement)
+  int16_t measureText(const uint8_t* font, const char* text);
+  void refreshStartupTextWidth();
+
+  // Draw text at baseline y from the atlas, or through u8g2 if any glyph is missing
+  void drawText(const GlyphAtlas& atlas, const uint8_t* font,
+                int16_t x, int16_t y, const char* text, uint16_t color);
 
   // Helper methods
   static void formatTime(uint32_t timeMs, char* buffer, size_t bufferSize);
@@ -99,7 +141,16 @@ public:
   void showShotData(const NormalizedShotData& shotData);
   void showSessionEnd(const SessionData& sessionData, uint16_t lastShotNumber);
 
+  // Milliseconds until update() has time-driven work to do
+  // (0 = render pending, UINT32_MAX = idle until the next show*() call)
+  uint32_t getMsUntilNextFrame() const;
+
+  // Log and reset frame/pacing counters (health check)
+  void logFrameStats();
+
   // Getters
   DisplayState getCurrentState() const { return currentState; }
   bool isInitialized() const { return display != nullptr; }
+  bool isDoubleBuffered() const { return doubleBuffered; }
+  size_t getDmaBufferBytes() const { return dmaBufferBytes; }
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Fixed-cadence frame clock for display animations
+ *
+ * Deadlines advance by whole periods from the start time rather than
+ * from "now", so a late main-loop wake does not push every following
+ * frame back. When the caller falls more than a period behind, tick()
+ * reports how many frames elapsed so animations can advance by that
+ * many steps and keep a constant speed.
+ *
+ * Times are millis() values; wrap-around safe.
+ */
+class FramePacer {
+public:
+  explicit FramePacer(uint32_t periodMs = 0)
+    : period(periodMs), nextDue(0), frames(0), skippedFrames(0), maxLatenessMs(0) {}
+
+  void setPeriod(uint32_t periodMs) { period = periodMs; }
+  uint32_t getPeriod() const { return period; }
+
+  // First frame is due one period after now
+  void start(unsigned long now) { nextDue = now + period; }
+
+  // Number of frames that became due since the last call (0 = not yet)
+  uint32_t tick(unsigned long now) {
+    if (period == 0 || (long)(now - nextDue) < 0) {
+      return 0;
+    }
+    uint32_t lateness = (uint32_t)(now - nextDue);
+    uint32_t elapsed = 1 + lateness / period;
+    nextDue += (unsigned long)elapsed * period;
+
+    frames++;
+    skippedFrames += elapsed - 1;
+    if (lateness > maxLatenessMs) {
+      maxLatenessMs = lateness;
+    }
+    return elapsed;
+  }
+
+  uint32_t msUntilNext(unsigned long now) const {
+    long remaining = (long)(nextDue - now);
+    return remaining > 0 ? (uint32_t)remaining : 0;
+  }
+
+  uint32_t getFrames() const { return frames; }
+  uint32_t getSkippedFrames() const { return skippedFrames; }
+  uint32_t getMaxLatenessMs() const { return maxLatenessMs; }
+
+  void resetStats() {
+    frames = 0;
+    skippedFrames = 0;
+    maxLatenessMs = 0;
+  }
+
+private:
+  uint32_t period;
+  unsigned long nextDue;
+  uint32_t frames;
+  uint32_t skippedFrames;
+  uint32_t maxLatenessMs;
+};
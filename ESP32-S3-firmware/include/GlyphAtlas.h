@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+
+class Adafruit_GFX;
+class U8G2_FOR_ADAFRUIT_GFX;
+
+/**
+ * @brief Pre-rasterized 1-bpp glyph cache for one u8g2 font
+ *
+ * build() draws each character of a small charset once through u8g2 into
+ * an off-screen GFXcanvas1, trims it to its bounding box and keeps the
+ * packed bits. draw() then blits cached rows to any Adafruit_GFX target
+ * (panel or shadow framebuffer) as horizontal runs, skipping the u8g2 font bitstream decode on every redraw.
+ *
+ * Output matches u8g2 in transparent font mode (setFontMode(1)): only
+ * foreground pixels are written, glyphs advance by the font's delta-x,
+ * and y is the text baseline.
+ */
+class GlyphAtlas {
+public:
+  static constexpr uint8_t MAX_GLYPHS = 24;
+  static constexpr size_t BITMAP_BYTES = 2048;
+
+  GlyphAtlas();
+
+  // Rasterize every distinct character of charset. Returns false if the
+  // glyph table or bitmap store overflowed (atlas stays unusable).
+  // Leaves u8g2 attached to the scratch canvas - caller must re-begin().
+  bool build(U8G2_FOR_ADAFRUIT_GFX& u8g2, const uint8_t* font, const char* charset);
+
+  bool isReady() const { return ready; }
+
+  // True if every character of text is cached
+  bool contains(const char* text) const;
+
+  // Draw text with its baseline at y; returns the x after the last glyph
+  int16_t draw(Adafruit_GFX* target, int16_t x, int16_t y,
+               const char* text, uint16_t color) const;
+
+  // Sum of glyph advances (cached characters only)
+  int16_t getTextWidth(const char* text) const;
+
+  uint8_t getGlyphCount() const { return glyphCount; }
+  size_t getBitmapBytesUsed() const { return bitmapUsed; }
+
+private:
+  struct Glyph {
+    int8_t xOffset;         // Left edge relative to the cursor
+    int8_t yOffset;         // Top edge relative to the baseline (negative = above)
+    uint8_t width;
+    uint8_t height;
+    uint8_t advance;        // Cursor delta-x reported by u8g2
+    uint16_t bitmapOffset;  // Into bitmap[], rows packed MSB-first, (width + 7) / 8 bytes each
+  };
+
+  // Scratch canvas used during build()
+  static constexpr int16_t CANVAS_SIZE = 32;
+  static constexpr int16_t CANVAS_ORIGIN_X = 4;
+  static constexpr int16_t CANVAS_BASELINE = 26;
+
+  Glyph glyphs[MAX_GLYPHS];
+  int8_t glyphIndex[128];   // ASCII -> glyphs[] index, -1 if not cached
+  uint8_t glyphCount;
+  uint8_t bitmap[BITMAP_BYTES];
+  uint16_t bitmapUsed;
+  bool ready;
+
+  const Glyph* find(char c) const;
+};
@@ -4,6 +4,9 @@
 #include <functional>
 #include <BLEDevice.h>
 
+// Timers one bridge can have connected at once (upper bound for the lane tag)
+constexpr uint8_t MAX_TIMER_LANES = 4;
+
 // Unified shot data structure for all timer devices
 struct NormalizedShotData {
   uint32_t sessionId = 0;
@@ -11,8 +14,10 @@ struct NormalizedShotData {
   uint32_t absoluteTimeMs = 0;    // Always in milliseconds
   uint32_t splitTimeMs = 0;       // Time since previous shot
   uint64_t timestampMs = 0;       // System timestamp when shot was detected
+  int64_t traceOriginUs = 0;      // esp_timer time the BLE notification arrived (0 = untraced)
   char deviceModel[32] = {0};     // Owned copy to avoid dangling pointers
   bool isFirstShot = false;       // True if this is the first shot in session
+  uint8_t lane = 0;               // Connection the shot came from (set by TimerApplication)
 };
 
 // Session state information
@@ -22,6 +27,7 @@ struct SessionData {
   uint16_t totalShots = 0;
   uint32_t startTimestamp = 0;
   float startDelaySeconds = 0.0f;
+  uint8_t lane = 0;               // Connection the session belongs to (set by TimerApplication)
 };
 
 // Device connection state
@@ -60,6 +66,13 @@ public:
   virtual void onSessionResumed(std::function<void(const SessionData&)> callback) = 0;
   virtual void onConnectionStateChanged(std::function<void(DeviceConnectionState)> callback) = 0;
 
+  // Raw notification hand-off (BLE ingest pipeline)
+  // The sink runs on the BLE stack task and returns true if it took the payload
+  // for deferred parsing; otherwise the device parses inline as before.
+  // receivedUs is the esp_timer arrival time, carried into traceOriginUs.
+  virtual void setNotificationSink(std::function<bool(const uint8_t*, size_t, int64_t)> sink) = 0;
+  virtual void processNotification(uint8_t* data, size_t length, int64_t receivedUs) = 0;  // Parse a deferred payload
+
   // Device capabilities
   virtual bool supportsRemoteStart() const = 0;
   virtual bool supportsShotList() const = 0;
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Allocation-free JSON field descriptor for JsonWriter::object()
+ *
+ * Built by jsonField() / jsonFieldIf() / jsonFieldIfSet(); the key must be
+ * a string literal so its length is known at compile time. Fields that are
+ * not present are skipped entirely (no key, no comma).
+ */
+template <typename T>
+struct JsonField {
+  const char* key;
+  size_t keyLength;
+  T value;
+  bool present;
+};
+
+template <size_t N, typename T>
+constexpr JsonField<T> jsonField(const char (&key)[N], T value) {
+  return JsonField<T>{ key, N - 1, value, true };
+}
+
+template <size_t N, typename T>
+constexpr JsonField<T> jsonFieldIf(bool present, const char (&key)[N], T value) {
+  return JsonField<T>{ key, N - 1, value, present };
+}
+
+// Optional string: omitted when value is nullptr
+template <size_t N>
+constexpr JsonField<const char*> jsonFieldIfSet(const char (&key)[N], const char* value) {
+  return JsonField<const char*>{ key, N - 1, value, value != nullptr };
+}
+
+/**
+ * @brief Minimal JSON encoder into a caller-owned buffer
+ *
+ * The JSON counterpart of MsgPackWriter: no allocation and no intermediate
+ * document, values are appended in order and commas are inserted
+ * automatically. Writing past the end of the buffer sets a sticky error
+ * (ok() == false); the output is always NUL-terminated.
+ *
+ * Typical use is one call per event:
+ *
+ *   w.object(jsonField("sessionId", id), jsonField("timestamp", now));
+ *
+ * Numbers: unsigned integers exactly, floats with up to 3 decimals
+ * (trailing zeros dropped; NaN, infinities and |v| >= 1e9 become null).
+ * Strings are escaped per RFC 8259.
+ */
+class JsonWriter {
+public:
+  JsonWriter(char* buffer, size_t capacity)
+    : buf(buffer), cap(capacity), len(0), failed(capacity == 0), needComma(false) {
+    if (cap) {
+      buf[0] = '\0';
+    }
+  }
+
+  bool ok() const { return !failed; }
+  size_t size() const { return len; }
+  const char* c_str() const { return buf; }
+
+  void beginObject() { open('{'); }
+  void endObject() { close('}'); }
+  void beginArray() { open('['); }
+  void endArray() { close(']'); }
+
+  // Compile-time key (string literal, no escaping needed)
+  template <size_t N>
+  void key(const char (&name)[N]) { rawKey(name, N - 1); }
+
+  // Runtime key (e.g. a stage name) - escaped like a string value
+  void dynamicKey(const char* name) {
+    separator();
+    string(name);
+    put(':');
+    needComma = false;
+  }
+
+  void value(bool v) {
+    separator();
+    if (v) {
+      put("true", 4);
+    } else {
+      put("false", 5);
+    }
+  }
+
+  void value(unsigned char v) { unsignedValue(v); }
+  void value(unsigned short v) { unsignedValue(v); }
+  void value(unsigned int v) { unsignedValue(v); }
+  void value(unsigned long v) { unsignedValue(v); }
+  void value(unsigned long long v) { unsignedValue(v); }
+
+  void value(float v) {
+    separator();
+    // v != v catches NaN without <cmath>
+    if (v != v || v >= 1e9f || v <= -1e9f) {
+      put("null", 4);
+      return;
+    }
+    if (v < 0) {
+      put('-');
+      v = -v;
+    }
+    unsigned long long scaled = (unsigned long long)(v * 1000.0f + 0.5f);
+    digits(scaled / 1000);
+    uint32_t frac = (uint32_t)(scaled % 1000);
+    if (frac) {
+      char f[4] = { '.', (char)('0' + frac / 100), (char)('0' + frac / 10 % 10), (char)('0' + frac % 10) };
+      size_t n = 4;
+      while (f[n - 1] == '0') {
+        n--;
+      }
+      put(f, n);
+    }
+  }
+
+  void value(const char* v) {
+    separator();
+    if (v) {
+      string(v);
+    } else {
+      put("null", 4);
+    }
+  }
+
+  template <typename T>
+  void field(const JsonField<T>& f) {
+    if (f.present) {
+      rawKey(f.key, f.keyLength);
+      value(f.value);
+    }
+  }
+
+  // Appends fields to the currently open object
+  void fields() {}
+
+  template <typename T, typename... Rest>
+  void fields(const JsonField<T>& first, const Rest&... rest) {
+    field(first);
+    fields(rest...);
+  }
+
+  // One complete object: {"key":value,...}
+  template <typename... Fields>
+  void object(const Fields&... f) {
+    beginObject();
+    fields(f...);
+    endObject();
+  }
+
+private:
+  char* buf;
+  size_t cap;
+  size_t len;
+  bool failed;
+  bool needComma;  // A value was written at this nesting level
+
+  void separator() {
+    if (needComma) {
+      put(',');
+    }
+    needComma = true;
+  }
+
+  void open(char c) {
+    separator();
+    put(c);
+    needComma = false;
+  }
+
+  void close(char c) {
+    put(c);
+    needComma = true;
+  }
+
+  void rawKey(const char* name, size_t n) {
+    separator();
+    put('"');
+    put(name, n);
+    put("\":", 2);
+    needComma = false;
+  }
+
+  void unsignedValue(unsigned long long v) {
+    separator();
+    digits(v);
+  }
+
+  void digits(unsigned long long v) {
+    char tmp[20];
+    size_t n = 0;
+    do {
+      tmp[sizeof(tmp) - ++n] = (char)('0' + v % 10);
+      v /= 10;
+    } while (v);
+    put(tmp + sizeof(tmp) - n, n);
+  }
+
+  void string(const char* s) {
+    put('"');
+    const char* run = s;  // Copy unescaped runs in one go
+    for (; *s; s++) {
+      unsigned char c = (unsigned char)*s;
+      if (c >= 0x20 && c != '"' && c != '\\') {
+        continue;
+      }
+      put(run, (size_t)(s - run));
+      run = s + 1;
+      escape(c);
+    }
+    put(run, (size_t)(s - run));
+    put('"');
+  }
+
+  void escape(unsigned char c) {
+    char e[6] = { '\\', 0, 0, 0, 0, 0 };
+    switch (c) {
+      case '"':  e[1] = '"';  break;
+      case '\\': e[1] = '\\'; break;
+      case '\b': e[1] = 'b';  break;
+      case '\f': e[1] = 'f';  break;
+      case '\n': e[1] = 'n';  break;
+      case '\r': e[1] = 'r';  break;
+      case '\t': e[1] = 't';  break;
+      default: {
+        static const char hex[] = "0123456789abcdef";
+        e[1] = 'u';
+        e[2] = '0';
+        e[3] = '0';
+        e[4] = hex[c >> 4];
+        e[5] = hex[c & 0x0f];
+        put(e, 6);
+        return;
+      }
+    }
+    put(e, 2);
+  }
+
+  void put(char c) { put(&c, 1); }
+
+  // Keeps one byte spare for the terminating NUL
+  void put(const char* p, size_t n) {
+    if (failed || n >= cap - len) {
+      failed = true;
+      return;
+    }
+    if (n) {
+      memcpy(buf + len, p, n);
+    }
+    len += n;
+    buf[len] = '\0';
+  }
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Fixed-size log-linear latency histogram (microseconds)
+ *
+ * Values 0-3 get exact buckets; above that every power of two is split
+ * into 4 linear sub-buckets, so percentile error is bounded at 25% of the
+ * value across the full uint32_t range. No heap, no floating point on the
+ * record path - cheap enough to call from any task.
+ *
+ * Not thread-safe on its own; ShotTrace guards it with a spinlock.
+ */
+class LatencyHistogram {
+public:
+  static constexpr uint8_t SUB_BUCKET_BITS = 2;
+  static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (32 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+  LatencyHistogram() { reset(); }
+
+  void record(uint32_t valueUs) {
+    buckets[bucketIndex(valueUs)]++;
+    if (sampleCount == 0 || valueUs < minValue) minValue = valueUs;
+    if (valueUs > maxValue) maxValue = valueUs;
+    sum += valueUs;
+    sampleCount++;
+  }
+
+  void reset() {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) buckets[i] = 0;
+    sampleCount = 0;
+    minValue = 0;
+    maxValue = 0;
+    sum = 0;
+  }
+
+  uint32_t count() const { return sampleCount; }
+  uint32_t min() const { return minValue; }
+  uint32_t max() const { return maxValue; }
+  uint32_t mean() const { return sampleCount ? (uint32_t)(sum / sampleCount) : 0; }
+
+  // Upper bound of the bucket holding the given percentile (0-100), clamped to max()
+  uint32_t percentile(uint8_t pct) const {
+    if (sampleCount == 0) return 0;
+    if (pct > 100) pct = 100;
+
+    // Rank of the sample we are looking for (1-based, rounded up)
+    uint32_t rank = (uint32_t)(((uint64_t)sampleCount * pct + 99) / 100);
+    if (rank == 0) rank = 1;
+
+    uint32_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        uint32_t upper = bucketUpperBound(i);
+        return upper < maxValue ? upper : maxValue;
+      }
+    }
+    return maxValue;
+  }
+
+  static size_t bucketIndex(uint32_t value) {
+    if (value < SUB_BUCKETS) {
+      return value;
+    }
+    uint32_t msb = 31 - (uint32_t)__builtin_clz(value);        // >= SUB_BUCKET_BITS
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    uint32_t sub = (value >> shift) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+  }
+
+  static uint32_t bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+      return (uint32_t)index;
+    }
+    uint32_t shift = (uint32_t)((index - SUB_BUCKETS) / SUB_BUCKETS);
+    uint32_t sub = (uint32_t)((index - SUB_BUCKETS) % SUB_BUCKETS);
+    uint64_t lower = (uint64_t)(SUB_BUCKETS + sub) << shift;
+    uint64_t upper = lower + ((uint64_t)1 << shift) - 1;
+    return upper > UINT32_MAX ? UINT32_MAX : (uint32_t)upper;
+  }
+
+private:
+  uint32_t buckets[BUCKET_COUNT];
+  uint32_t sampleCount;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint64_t sum;
+};
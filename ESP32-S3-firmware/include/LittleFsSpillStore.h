@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ShotJournal.h"
+
+/**
+ * @brief ShotJournal spill segment in a LittleFS file
+ *
+ * Layout: a small header followed by fixed-size JournalRecords. Records are
+ * only ever appended; consumption advances readIndex in the header, and
+ * the file is removed once everything has been consumed. The record count
+ * comes from the file size, so a reset between an append and a header
+ * update loses nothing - it can only replay already-consumed records.
+ */
+class LittleFsSpillStore : public JournalSpillStore {
+public:
+  explicit LittleFsSpillStore(uint32_t maxBytes);
+
+  // Mount LittleFS (formatting on first use) and pick up a previous spill
+  bool begin();
+
+  uint32_t count() const override { return totalRecords - readIndex; }
+  uint32_t capacity() const override { return maxRecords; }
+  bool append(const JournalRecord* records, uint32_t n) override;
+  uint32_t read(JournalRecord* out, uint32_t max) override;
+  void consume(uint32_t n) override;
+  void clear() override;
+
+private:
+  struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t readIndex;
+  };
+
+  static constexpr const char* PATH = "/shotjournal.bin";
+  static constexpr uint32_t MAGIC = 0x4C4A5453;   // "STJL"
+  static constexpr uint16_t VERSION = 2;          // 2: 32-byte deviceModel
+
+  uint32_t maxRecords;
+  uint32_t totalRecords;   // Records in the file, consumed or not
+  uint32_t readIndex;
+  bool mounted;
+
+  bool writeHeader();
+};
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Logging levels
+enum class LogLevel : uint8_t {
+  DEBUG = 0,
+  INFO = 1,
+  WARN = 2,
+  ERROR = 3,
+  NONE = 4
+};
+
+/**
+ * @brief Log line layout and printf-argument walking shared by Logger and
+ *        the host-side binary log decoder (tools/log-decode)
+ *
+ * Header-only, no Arduino dependencies. A message is rebuilt one
+ * conversion at a time from an argument source - the deferred ring
+ * record on the device, or a binary frame on the host - so both print
+ * exactly what vsnprintf() would have.
+ *
+ * Binary frame (LOG_BINARY_OUTPUT):
+ *   A5 5A | length | body (length bytes) | XOR of body
+ *   body: timestamp ms (u32 LE) | level (u8) | component address (u32 LE) |
+ *         format address (u32 LE) | conversions packed (u8) | arguments
+ * Addresses are the firmware's string literals, resolved from its ELF on
+ * the host. Arguments follow the format's conversions: signed integers as
+ * zigzag varints, unsigned integers and pointers as varints (zero-extended
+ * from the device's type width), floating point as an IEEE double (LE),
+ * strings as a length byte and the text.
+ */
+namespace LogFormat {
+
+constexpr uint8_t FRAME_SYNC_0 = 0xA5;
+constexpr uint8_t FRAME_SYNC_1 = 0x5A;
+constexpr size_t FRAME_HEADER_BYTES = 14;  // Body bytes before the arguments
+constexpr size_t MAX_FRAME_BODY = 255;
+constexpr size_t MAX_SPEC_LENGTH = 16;     // Longest conversion spec, e.g. "%-10.3lu"
+
+// Compile-time component tag hash (selects the component color)
+constexpr uint32_t hashTag(const char* tag, uint32_t hash = 0) {
+  return *tag ? hashTag(tag + 1, hash * 31 + (uint8_t)*tag) : hash;
+}
+
+inline const char* levelString(LogLevel level) {
+  switch (level) {
+    case LogLevel::DEBUG: return "DEBUG";
+    case LogLevel::INFO:  return "INFO ";
+    case LogLevel::WARN:  return "WARN ";
+    case LogLevel::ERROR: return "ERROR";
+    default: return "UNKNOWN";
+  }
+}
+
+inline const char* componentColor(uint32_t tagHash) {
+  // ANSI color codes picked by the tag hash, consistent per component
+  switch (tagHash % 6) {
+    case 0: return "\033[36m"; // Cyan
+    case 1: return "\033[33m"; // Yellow
+    case 2: return "\033[35m"; // Magenta
+    case 3: return "\033[32m"; // Green
+    case 4: return "\033[34m"; // Blue
+    case 5: return "\033[31m"; // Red
+    default: return "\033[37m"; // White
+  }
+}
+
+// Timestamp, level and component; returns the bytes written
+inline size_t formatPrefix(char* line, size_t size, uint32_t timestampMs, LogLevel level,
+                           const char* component, uint32_t tagHash) {
+  const char* levelColor = (level == LogLevel::ERROR) ? "\033[31m" :
+                          (level == LogLevel::WARN) ? "\033[33m" : "\033[37m";
+  int length = snprintf(line, size, "[%8lu] %s%s\033[0m %s%-10s\033[0m ",
+                        (unsigned long)timestampMs, levelColor, levelString(level),
+                        componentColor(tagHash), component);
+  if (length < 0) {
+    return 0;
+  }
+  return ((size_t)length < size) ? (size_t)length : size - 1;
+}
+
+// What one printf conversion takes from the argument list
+enum class ArgKind : uint8_t {
+  NONE,  // "%%"
+  INT,
+  LONG,
+  LONG_LONG,
+  SIZE,
+  INTMAX,
+  PTRDIFF,
+  DOUBLE,
+  LONG_DOUBLE,
+  STRING,
+  POINTER
+};
+
+struct Conversion {
+  const char* end;  // One past the conversion character
+  uint8_t stars;    // '*' width / precision - each takes an int before the value
+  ArgKind kind;
+  bool isSigned;    // d / i
+};
+
+// One argument, whichever kind it is
+struct ArgValue {
+  int64_t i;         // Signed integers
+  uint64_t u;        // Unsigned integers and pointers
+  long double real;
+  const char* text;  // Strings: not NUL-terminated
+  size_t length;
+};
+
+// Parses the conversion spec starting at the '%' in p. Returns false for
+// anything the packer does not handle; that text is printed literally.
+inline bool parseConversion(const char* p, Conversion& conv) {
+  const char* start = p++;
+  conv.stars = 0;
+  conv.isSigned = false;
+  if (*p == '%') {
+    conv.end = p + 1;
+    conv.kind = ArgKind::NONE;
+    return true;
+  }
+
+  while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') p++;
+  if (*p == '*') {
+    conv.stars++;
+    p++;
+  } else {
+    while (*p >= '0' && *p <= '9') p++;
+  }
+  if (*p == '.') {
+    p++;
+    if (*p == '*') {
+      conv.stars++;
+      p++;
+    } else {
+      while (*p >= '0' && *p <= '9') p++;
+    }
+  }
+
+  char modifier = 0;
+  if (*p == 'h') {
+    modifier = *p++;
+    if (*p == 'h') p++;
+  } else if (*p == 'l') {
+    modifier = *p++;
+    if (*p == 'l') {
+      modifier = 'q';
+      p++;
+    }
+  } else if (*p == 'z' || *p == 'j' || *p == 't' || *p == 'L') {
+    modifier = *p++;
+  }
+
+  switch (*p) {
+    case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'c':
+      conv.kind = modifier == 'l' ? ArgKind::LONG :
+                  modifier == 'q' ? ArgKind::LONG_LONG :
+                  modifier == 'z' ? ArgKind::SIZE :
+                  modifier == 'j' ? ArgKind::INTMAX :
+                  modifier == 't' ? ArgKind::PTRDIFF : ArgKind::INT;
+      conv.isSigned = (*p == 'd' || *p == 'i');
+      break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+      conv.kind = modifier == 'L' ? ArgKind::LONG_DOUBLE : ArgKind::DOUBLE;
+      break;
+    case 's':
+      if (modifier != 0) return false;  // No wide strings
+      conv.kind = ArgKind::STRING;
+      break;
+    case 'p':
+      conv.kind = ArgKind::POINTER;
+      break;
+    default:
+      return false;
+  }
+
+  conv.end = p + 1;
+  return (size_t)(conv.end - start) < MAX_SPEC_LENGTH;
+}
+
+template <typename T>
+int formatValue(char* out, size_t size, const char* spec, const int* stars, uint8_t starCount,
+                T value) {
+  switch (starCount) {
+    case 0:  return snprintf(out, size, spec, value);
+    case 1:  return snprintf(out, size, spec, stars[0], value);
+    default: return snprintf(out, size, spec, stars[0], stars[1], value);
+  }
+}
+
+// Integer conversions get the value back in the type the spec expects
+template <typename T>
+int formatInteger(char* out, size_t size, const char* spec, const int* stars, uint8_t starCount,
+                  const Conversion& conv, const ArgValue& value) {
+  return formatValue(out, size, spec, stars, starCount,
+                     conv.isSigned ? (T)value.i : (T)value.u);
+}
+
+/**
+ * Rebuilds the message for `format` into out (always NUL-terminated).
+ * Source supplies the arguments:
+ *   bool next(const Conversion& conv, int* stars, ArgValue& value)
+ * filling conv.stars ints and the value, or returning false once the
+ * packed arguments run out - the message is then cut with "...".
+ */
+template <typename Source>
+size_t formatMessage(const char* format, Source& source, char* out, size_t size) {
+  size_t pos = 0;
+  const char* p = format;
+  while (*p && pos + 1 < size) {
+    Conversion conv;
+    if (*p != '%' || !parseConversion(p, conv)) {
+      out[pos++] = *p++;
+      continue;
+    }
+    if (conv.kind == ArgKind::NONE) {
+      out[pos++] = '%';
+      p = conv.end;
+      continue;
+    }
+
+    char spec[MAX_SPEC_LENGTH];
+    memcpy(spec, p, conv.end - p);
+    spec[conv.end - p] = '\0';
+    p = conv.end;
+
+    char* dest = out + pos;
+    size_t room = size - pos;
+    int stars[2] = {0, 0};
+    ArgValue value;
+    int written = 0;
+    if (!source.next(conv, stars, value)) {
+      written = snprintf(dest, room, "...");
+      p = "";
+    } else {
+      switch (conv.kind) {
+        case ArgKind::INT:       written = formatInteger<int>(dest, room, spec, stars, conv.stars, conv, value); break;
+        case ArgKind::LONG:      written = formatInteger<long>(dest, room, spec, stars, conv.stars, conv, value); break;
+        case ArgKind::LONG_LONG: written = formatInteger<long long>(dest, room, spec, stars, conv.stars, conv, value); break;
+        case ArgKind::SIZE:      written = formatInteger<size_t>(dest, room, spec, stars, conv.stars, conv, value); break;
+        case ArgKind::INTMAX:    written = formatInteger<intmax_t>(dest, room, spec, stars, conv.stars, conv, value); break;
+        case ArgKind::PTRDIFF:   written = formatInteger<ptrdiff_t>(dest, room, spec, stars, conv.stars, conv, value); break;
+        case ArgKind::DOUBLE:    written = formatValue(dest, room, spec, stars, conv.stars, (double)value.real); break;
+        case ArgKind::LONG_DOUBLE: written = formatValue(dest, room, spec, stars, conv.stars, value.real); break;
+        case ArgKind::POINTER:   written = formatValue(dest, room, spec, stars, conv.stars, (void*)(uintptr_t)value.u); break;
+        case ArgKind::STRING: {
+          char text[MAX_FRAME_BODY + 1];
+          size_t length = value.length < MAX_FRAME_BODY ? value.length : MAX_FRAME_BODY;
+          memcpy(text, value.text, length);
+          text[length] = '\0';
+          written = formatValue(dest, room, spec, stars, conv.stars, (const char*)text);
+          break;
+        }
+        case ArgKind::NONE:
+          break;
+      }
+    }
+    if (written > 0) {
+      pos += ((size_t)written < room) ? (size_t)written : room - 1;
+    }
+  }
+  out[pos] = '\0';
+  return pos;
+}
+
+// ── Binary frame argument encoding ──────────────────────────────
+
+inline bool putByte(uint8_t*& p, const uint8_t* end, uint8_t value) {
+  if (p >= end) return false;
+  *p++ = value;
+  return true;
+}
+
+inline bool putVarint(uint8_t*& p, const uint8_t* end, uint64_t value) {
+  while (value >= 0x80) {
+    if (!putByte(p, end, (uint8_t)(value | 0x80))) return false;
+    value >>= 7;
+  }
+  return putByte(p, end, (uint8_t)value);
+}
+
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (p >= end) return false;
+    uint8_t byte = *p++;
+    value |= (uint64_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return true;
+  }
+  return false;
+}
+
+inline uint64_t zigzag(int64_t value) {
+  return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+  return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+inline void putU32(uint8_t* p, uint32_t value) {
+  for (int i = 0; i < 4; i++) p[i] = (uint8_t)(value >> (8 * i));
+}
+
+inline uint32_t getU32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Appends one argument (stars first) in wire form
+inline bool putArg(uint8_t*& p, const uint8_t* end, const Conversion& conv, const int* stars,
+                   const ArgValue& value) {
+  for (uint8_t i = 0; i < conv.stars; i++) {
+    if (!putVarint(p, end, zigzag(stars[i]))) return false;
+  }
+  switch (conv.kind) {
+    case ArgKind::DOUBLE:
+    case ArgKind::LONG_DOUBLE: {
+      double real = (double)value.real;
+      uint64_t bits;
+      memcpy(&bits, &real, sizeof(bits));
+      for (int i = 0; i < 8; i++) {
+        if (!putByte(p, end, (uint8_t)(bits >> (8 * i)))) return false;
+      }
+      return true;
+    }
+    case ArgKind::STRING:
+      if (value.length > 0xFF || (size_t)(end - p) < 1 + value.length) return false;
+      *p++ = (uint8_t)value.length;
+      memcpy(p, value.text, value.length);
+      p += value.length;
+      return true;
+    case ArgKind::POINTER:
+      return putVarint(p, end, value.u);
+    case ArgKind::NONE:
+      return true;
+    default:
+      return putVarint(p, end, conv.isSigned ? zigzag(value.i) : value.u);
+  }
+}
+
+// Argument source reading wire-form arguments back from a frame body
+class FrameArgs {
+public:
+  FrameArgs(const uint8_t* args, const uint8_t* end, uint8_t count)
+    : cursor(args), end(end), remaining(count) {}
+
+  bool next(const Conversion& conv, int* stars, ArgValue& value) {
+    if (remaining == 0) {
+      return false;
+    }
+    uint64_t raw = 0;
+    for (uint8_t i = 0; i < conv.stars; i++) {
+      if (!getVarint(cursor, end, raw)) return false;
+      stars[i] = (int)unzigzag(raw);
+    }
+    value = ArgValue();
+    switch (conv.kind) {
+      case ArgKind::DOUBLE:
+      case ArgKind::LONG_DOUBLE: {
+        if (end - cursor < 8) return false;
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; i++) bits |= (uint64_t)cursor[i] << (8 * i);
+        cursor += 8;
+        double real;
+        memcpy(&real, &bits, sizeof(real));
+        value.real = real;
+        break;
+      }
+      case ArgKind::STRING:
+        if (cursor >= end || (size_t)(end - cursor) < 1u + *cursor) return false;
+        value.length = *cursor++;
+        value.text = (const char*)cursor;
+        cursor += value.length;
+        break;
+      default:
+        if (!getVarint(cursor, end, raw)) return false;
+        if (conv.isSigned) {
+          value.i = unzigzag(raw);
+        } else {
+          value.u = raw;
+        }
+        break;
+    }
+    remaining--;
+    return true;
+  }
+
+private:
+  const uint8_t* cursor;
+  const uint8_t* end;
+  uint8_t remaining;
+};
+
+}  // namespace LogFormat
@@ -1,36 +1,94 @@
 #pragma once
 
 #include <Arduino.h>
+#include <type_traits>
+#include "freertos/FreeRTOS.h"
+#include "LogFormat.h"
 
-// Logging levels
-enum class LogLevel : uint8_t {
-  DEBUG = 0,
-  INFO = 1,
-  WARN = 2,
-  ERROR = 3,
-  NONE = 4
+// Lowest level compiled in (0 = DEBUG ... 4 = NONE). LOG_* calls below it
+// are removed at compile time, arguments and format strings included.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+// 1 = write binary frames (see LogFormat.h) instead of text; decode them on
+// the host with tools/log-decode and the firmware ELF
+#ifndef LOG_BINARY_OUTPUT
+#define LOG_BINARY_OUTPUT 0
+#endif
+
+// Component tag with its color hash worked out at compile time
+struct LogTag {
+  const char* name;
+  uint32_t hash;
 };
 
 // Logger configuration
+//
+// Synchronous by default: log() formats and prints on the calling task.
+// After startDeferred(), log() only records the call - timestamp, level,
+// component and format pointers, and the packed arguments - in a lock-free
+// MPSC ring, and a low-priority task formats and prints it later. Callers on
+// the BLE and main loop tasks then never wait on vsnprintf or the UART.
+// Deferred mode keeps the component and format pointers, so both must be
+// string literals (as they are at every LOG_* call site); %s arguments are
+// copied. Lines that do not fit in the ring are counted and reported.
 class Logger {
 private:
   static LogLevel currentLevel;
-  static const char* getLevelString(LogLevel level);
-  static const char* getComponentColor(const char* component);
+
+  static void vlog(LogLevel level, LogTag tag, const char* format, va_list args);
+  static void drain();
+  static void drainTaskEntry(void* param);
 
 public:
   static void setLevel(LogLevel level);
   static inline LogLevel getLevel() { return currentLevel; }
+  static void log(LogLevel level, LogTag tag, const char* format, ...);
   static void log(LogLevel level, const char* component, const char* format, ...);
+  // One line of hex bytes (first 32), e.g. for raw BLE notifications
+  static void logHex(LogLevel level, LogTag tag, const char* label, const uint8_t* data,
+                     size_t length);
+
+#if LOG_MIN_LEVEL > 0
+  static constexpr bool isCompiledIn(LogLevel level) { return (int)level >= LOG_MIN_LEVEL; }
+#else
+  static constexpr bool isCompiledIn(LogLevel) { return true; }  // Avoids an always-true compare
+#endif
+  static inline bool isEnabled(LogLevel level) { return isCompiledIn(level) && level >= currentLevel; }
 
-  // Convenience macros will be defined below
+  // Deferred mode
+  static bool startDeferred(BaseType_t core, UBaseType_t priority, uint32_t stackSize);
+  static void stopDeferred();   // Flushes, then logs synchronously again (no other task may be logging)
+  static bool isDeferred();
+  static void flush();          // Prints everything queued so far on the calling task
+  static uint32_t getDroppedCount();
 };
 
+// Component must be a constant expression (string literal or constexpr tag)
+#define LOG_TAG_OF(component) \
+  (LogTag{(component), std::integral_constant<uint32_t, LogFormat::hashTag(component)>::value})
+
+// The level check comes first, so filtered calls never evaluate their arguments
+#define LOG_AT(level, component, ...)                              \
+  do {                                                             \
+    if (Logger::isEnabled(level)) {                                \
+      Logger::log(level, LOG_TAG_OF(component), __VA_ARGS__);      \
+    }                                                              \
+  } while (0)
+
 // Logging macros for easier use
-#define LOG_DEBUG(component, ...) Logger::log(LogLevel::DEBUG, component, __VA_ARGS__)
-#define LOG_INFO(component, ...)  Logger::log(LogLevel::INFO, component, __VA_ARGS__)
-#define LOG_WARN(component, ...)  Logger::log(LogLevel::WARN, component, __VA_ARGS__)
-#define LOG_ERROR(component, ...) Logger::log(LogLevel::ERROR, component, __VA_ARGS__)
+#define LOG_DEBUG(component, ...) LOG_AT(LogLevel::DEBUG, component, __VA_ARGS__)
+#define LOG_INFO(component, ...)  LOG_AT(LogLevel::INFO, component, __VA_ARGS__)
+#define LOG_WARN(component, ...)  LOG_AT(LogLevel::WARN, component, __VA_ARGS__)
+#define LOG_ERROR(component, ...) LOG_AT(LogLevel::ERROR, component, __VA_ARGS__)
+
+#define LOG_HEX(component, label, data, length)                                        \
+  do {                                                                                 \
+    if (Logger::isEnabled(LogLevel::DEBUG)) {                                          \
+      Logger::logHex(LogLevel::DEBUG, LOG_TAG_OF(component), label, data, length);     \
+    }                                                                                  \
+  } while (0)
 
 // Component-specific logging macros
 #define LOG_DISPLAY(...) LOG_INFO("DISPLAY", __VA_ARGS__)
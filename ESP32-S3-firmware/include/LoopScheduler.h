@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Wake-up sources for the main loop (task notification bits)
+namespace LoopEvent {
+  constexpr uint32_t SHOT          = 1u << 0;  // Shot queued for display/MQTT
+  constexpr uint32_t BLE_EVENT     = 1u << 1;  // Session/connection/scan event from the BLE side
+  constexpr uint32_t LORA_RX       = 1u << 2;  // SX1276 DIO0 (RxDone)
+  constexpr uint32_t MQTT          = 1u << 3;  // MQTT work pending
+  constexpr uint32_t DISPLAY_FRAME = 1u << 4;  // Display/OLED needs a redraw
+  constexpr uint32_t LORA_TX       = 1u << 5;  // SX1276 DIO0 (TxDone)
+}
+
+/**
+ * @brief Event-driven wait for the main loop
+ *
+ * Replaces the fixed vTaskDelay(MAIN_LOOP_DELAY) at the end of run().
+ * Producers (BLE callbacks, ISRs, other tasks) set LoopEvent bits on the
+ * main task's notification value; components that need periodic service
+ * report their next deadline with scheduleIn(). wait() then blocks until
+ * either an event arrives or the earliest deadline is due.
+ *
+ * Usage per loop iteration:
+ *   scheduler.scheduleIn(display->getMsUntilNextFrame());
+ *   scheduler.wait(MAIN_LOOP_IDLE_MAX_WAIT);
+ */
+class LoopScheduler {
+public:
+  static constexpr uint32_t NO_DEADLINE = UINT32_MAX;
+
+  // Wake counters since the last takeStats()
+  struct Stats {
+    uint32_t wakes = 0;          // Total loop iterations
+    uint32_t eventWakes = 0;     // Woken by a producer
+    uint32_t deadlineWakes = 0;  // Woken by deadline / idle timeout
+    uint32_t windowMs = 0;       // Length of the measurement window
+  };
+
+  LoopScheduler();
+
+  // Must be called from the task that will call wait()
+  void bind();
+
+  // Producer side - safe from any task / from ISRs respectively
+  void signal(uint32_t events);
+  void signalFromISR(uint32_t events);
+
+  // Request a wake-up no later than delayMs from now (earliest request wins)
+  void scheduleIn(uint32_t delayMs);
+
+  // Block until events arrive or the next deadline (capped at maxWaitMs).
+  // Returns the LoopEvent bits that caused the wake (0 on timeout).
+  uint32_t wait(uint32_t maxWaitMs);
+
+  // Legacy fixed-period yield; keeps wake counters comparable
+  void sleepFixed(uint32_t delayMs);
+
+  Stats takeStats();
+
+private:
+  TaskHandle_t taskHandle;
+  uint32_t nextDelayMs;
+  Stats stats;
+  unsigned long statsWindowStart;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock-free multi-producer / single-consumer ring buffer
+ *
+ * Bounded FIFO with no heap allocation and no locks. Any number of tasks
+ * may call push() concurrently; exactly one task at a time may call pop().
+ * Each slot carries a sequence number: producers claim a slot with a CAS
+ * on the enqueue index, fill it, then publish it by bumping the slot's
+ * sequence (release); the consumer takes the slot once its sequence says
+ * it is published (acquire) and hands it back one lap ahead.
+ *
+ * A producer that has claimed a slot but not yet published it holds up
+ * the consumer at that slot until it does - pop() simply reports empty.
+ *
+ * N must be a power of 2. All N slots are usable (no guard slot).
+ */
+template <typename T, size_t N>
+class MpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscRing size must be a power of 2");
+
+public:
+  static constexpr size_t MASK = N - 1;
+
+  MpscRing() {
+    for (size_t i = 0; i < N; i++) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Producer side (any task) - returns false (item not stored) when the ring is full
+  bool push(const T& item) {
+    size_t pos = enqueueIndex.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells[pos & MASK];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueueIndex.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // Slot still holds last lap's item
+      } else {
+        pos = enqueueIndex.load(std::memory_order_relaxed);  // Another producer claimed it
+      }
+    }
+    cell->item = item;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side - returns false when the ring is empty (or the oldest slot is still being filled)
+  bool pop(T& out) {
+    Cell& cell = cells[dequeueIndex & MASK];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if ((intptr_t)sequence - (intptr_t)(dequeueIndex + 1) < 0) {
+      return false;
+    }
+    out = cell.item;
+    cell.sequence.store(dequeueIndex + N, std::memory_order_release);
+    dequeueIndex++;
+    return true;
+  }
+
+  // Consumer side snapshot - claimed slots count even if not yet published
+  size_t size() const {
+    return enqueueIndex.load(std::memory_order_acquire) - dequeueIndex;
+  }
+
+  bool empty() const { return size() == 0; }
+  static constexpr size_t capacity() { return N; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T item;
+  };
+
+  Cell cells[N];
+  std::atomic<size_t> enqueueIndex{0};  // Next slot to claim (producers)
+  size_t dequeueIndex = 0;              // Next slot to read (consumer only)
+};
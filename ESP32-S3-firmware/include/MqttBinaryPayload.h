@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ITimerDevice.h"
+#include "MsgPackWriter.h"
+
+/**
+ * @brief Binary (MessagePack) MQTT payloads - MQTT_PAYLOAD_FORMAT_MSGPACK
+ *
+ * Every payload is one schema version byte followed by a MessagePack map
+ * whose keys are the small integers below instead of JSON key names, so
+ * a shot is ~40 bytes instead of ~170. A JSON payload always starts with
+ * '{' (0x7b), so subscribers can tell the two formats apart by the first
+ * byte. Field meaning and units are the same as the JSON payloads.
+ *
+ * Keys are never renumbered; new fields get new keys, and incompatible
+ * changes bump SCHEMA_VERSION.
+ */
+namespace MqttBinaryPayload {
+
+constexpr uint8_t SCHEMA_VERSION = 1;
+
+namespace Key {
+  constexpr uint8_t TIMESTAMP = 0;
+  constexpr uint8_t SESSION_ID = 1;
+  constexpr uint8_t SHOT_NUMBER = 2;
+  constexpr uint8_t ABSOLUTE_TIME_MS = 3;
+  constexpr uint8_t SPLIT_TIME_MS = 4;
+  constexpr uint8_t DEVICE_MODEL = 5;
+  constexpr uint8_t IS_FIRST_SHOT = 6;
+  constexpr uint8_t SEQ = 7;
+  constexpr uint8_t STATE = 8;
+  constexpr uint8_t DEVICE_NAME = 9;
+  constexpr uint8_t FIRMWARE_VERSION = 10;
+  constexpr uint8_t DEVICE_ID = 11;
+  constexpr uint8_t START_DELAY_SECONDS = 12;
+  constexpr uint8_t TOTAL_SHOTS = 13;
+  constexpr uint8_t LAST_SHOT_TIME_MS = 14;
+  constexpr uint8_t SHOTS = 15;    // Batch: array of [seq, shotNumber, absoluteTimeMs, splitTimeMs, timestamp, isFirstShot]
+  constexpr uint8_t STAGES = 16;   // Latency: map of stage name -> [n, minUs, avgUs, p99Us, maxUs]
+}
+
+// One event each; strings may be nullptr (field omitted)
+void encodeShot(MsgPackWriter& w, const NormalizedShotData& shot, uint32_t seq, uint32_t timestamp);
+void encodeConnectionState(MsgPackWriter& w, const char* state, const char* deviceName,
+                           const char* deviceModel, uint32_t timestamp);
+void encodeDeviceInfo(MsgPackWriter& w, const char* deviceName, const char* deviceModel,
+                      const char* firmwareVersion, const char* deviceId, uint32_t timestamp);
+void encodeSessionStarted(MsgPackWriter& w, uint32_t sessionId, float startDelaySeconds, uint32_t timestamp);
+void encodeSessionStopped(MsgPackWriter& w, uint32_t sessionId, uint16_t totalShots,
+                          uint32_t lastShotTimeMs, uint32_t timestamp);
+// Suspended, resumed and countdown complete share this shape
+void encodeSessionEvent(MsgPackWriter& w, uint32_t sessionId, uint32_t timestamp);
+
+// Shot batch: begin, add records, then patch the record count
+size_t beginShotBatch(MsgPackWriter& w, uint32_t sessionId, const char* deviceModel);
+void addShotBatchRecord(MsgPackWriter& w, const NormalizedShotData& shot, uint32_t seq, uint32_t timestamp);
+void finishShotBatch(MsgPackWriter& w, size_t countOffset, uint16_t count);
+
+// Latency diagnostics: begin with the number of stages, then one entry each
+void beginLatency(MsgPackWriter& w, uint16_t stageCount);
+void addLatencyStage(MsgPackWriter& w, const char* name, uint32_t n, uint32_t minUs,
+                     uint32_t avgUs, uint32_t p99Us, uint32_t maxUs);
+void finishLatency(MsgPackWriter& w, uint32_t timestamp);
+
+}  // namespace MqttBinaryPayload
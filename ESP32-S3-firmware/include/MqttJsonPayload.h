@@ -0,0 +1,33 @@
+#pragma once
+
+#include "JsonWriter.h"
+
+/**
+ * @brief JSON MQTT payloads - MQTT_PAYLOAD_FORMAT_JSON
+ *
+ * Session, connection, device and diagnostics events written straight into
+ * MqttManager's preallocated buffer with JsonWriter - no JsonDocument, so
+ * publishing never touches the heap. Key names and field order match the
+ * payloads documented in docs/esp32-s3/mqtt-and-wifi.md; the binary
+ * equivalents are in MqttBinaryPayload.
+ */
+namespace MqttJsonPayload {
+
+// One event each; strings may be nullptr (field omitted)
+void encodeConnectionState(JsonWriter& w, const char* state, const char* deviceName,
+                           const char* deviceModel, uint32_t timestamp);
+void encodeDeviceInfo(JsonWriter& w, const char* deviceName, const char* deviceModel,
+                      const char* firmwareVersion, const char* deviceId, uint32_t timestamp);
+void encodeSessionStarted(JsonWriter& w, uint32_t sessionId, float startDelaySeconds, uint32_t timestamp);
+void encodeSessionStopped(JsonWriter& w, uint32_t sessionId, uint16_t totalShots,
+                          uint32_t lastShotTimeMs, uint32_t timestamp);
+// Suspended, resumed and countdown complete share this shape
+void encodeSessionEvent(JsonWriter& w, uint32_t sessionId, uint32_t timestamp);
+
+// Latency diagnostics: begin, one entry per stage, then finish
+void beginLatency(JsonWriter& w);
+void addLatencyStage(JsonWriter& w, const char* name, uint32_t n, uint32_t minUs,
+                     uint32_t avgUs, uint32_t p99Us, uint32_t maxUs);
+void finishLatency(JsonWriter& w, uint32_t timestamp);
+
+}  // namespace MqttJsonPayload
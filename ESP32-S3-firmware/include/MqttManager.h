@@ -2,6 +2,8 @@
 
 #include "ITimerDevice.h"
 #include "Logger.h"
+#include "JsonWriter.h"
+#include "MsgPackWriter.h"
 #include <memory>
 
 /**
@@ -15,6 +17,10 @@
  * - Pre-allocated JSON buffer to avoid heap fragmentation
  * - Fast path for shot publishing (most common operation)
  * - Cached WiFi connection status to reduce redundant checks
+ *
+ * Not thread-safe: the payload buffer and the PubSubClient are shared by every
+ * publish, so all calls must come from one task (the main loop). BLE-side
+ * events reach it through TimerApplication's event ring.
  */
 class MqttManager {
 private:
@@ -23,10 +29,17 @@ private:
   bool wifiWasConnected;  // Cache to detect WiFi state changes
   unsigned long lastMqttCheck;
 
-  // Pre-allocated buffer for JSON serialization (reduces heap fragmentation)
-  static constexpr size_t JSON_BUFFER_SIZE = 256;
+  // Pre-allocated payload buffer (reduces heap fragmentation) - JSON text, or
+  // MessagePack when MQTT_PAYLOAD_FORMAT selects the binary encoding
+  static constexpr size_t JSON_BUFFER_SIZE = 1024;  // Sized for a full shot batch
   char jsonBuffer[JSON_BUFFER_SIZE];
 
+  // Shot batch being built in jsonBuffer (beginShotBatch .. publishShotBatch)
+  size_t batchLength;
+  uint8_t batchCount;
+  uint32_t batchSessionId;
+  size_t batchCountOffset;   // MessagePack: shots array header to patch
+
   // Per-device MQTT topics (built at initialize() time using the device ID)
   // Format: timer/<deviceId>/<event>
   static constexpr size_t TOPIC_BUFFER_SIZE = 64;
@@ -38,7 +51,10 @@ private:
   char topicSessionSuspended[TOPIC_BUFFER_SIZE];
   char topicSessionResumed[TOPIC_BUFFER_SIZE];
   char topicShotDetected[TOPIC_BUFFER_SIZE];
+  char topicShotBatch[TOPIC_BUFFER_SIZE];
   char topicCountdownComplete[TOPIC_BUFFER_SIZE];
+  char topicShotLatency[TOPIC_BUFFER_SIZE];       // diagnostics
+  char sourceTopic[TOPIC_BUFFER_SIZE];            // Scratch for another device's topic
 
   // Unique MQTT client ID (includes device ID to avoid broker conflicts)
   static constexpr size_t CLIENT_ID_BUFFER_SIZE = 32;
@@ -58,9 +74,23 @@ private:
   // Publishes retained "online"/"offline" to the presence topic
   void publishPresence(bool online);
 
+  // ownTopic, or timer/<sourceId>/<suffix> (built in sourceTopic) when
+  // publishing on behalf of another device
+  const char* eventTopic(const char* ownTopic, const char* sourceId, const char* suffix);
+
   // Helper methods - uses pre-allocated buffer
   // retain=true → broker stores the last value for late-joining subscribers
-  bool publishJson(const char* topic, const char* jsonPayload, bool retain = false);
+  bool publishJson(const char* topic, const JsonWriter& payload, bool retain = false);
+  bool publishBinary(const char* topic, const MsgPackWriter& payload, bool retain = false);
+  bool publishPayload(const char* topic, const uint8_t* payload, size_t length, bool retain);
+
+  JsonWriter jsonWriter() {
+    return JsonWriter(jsonBuffer, JSON_BUFFER_SIZE);
+  }
+
+  MsgPackWriter payloadWriter() {
+    return MsgPackWriter(reinterpret_cast<uint8_t*>(jsonBuffer), JSON_BUFFER_SIZE);
+  }
 
 public:
   MqttManager();
@@ -79,18 +109,39 @@ public:
     return mqttConnected;  // Fast check without WiFi re-query
   }
 
-  // Event publishers - called by TimerApplication
-  void publishConnectionState(DeviceConnectionState state, const char* deviceName, const char* deviceModel);
+  // Event publishers - called by TimerApplication. sourceId publishes under
+  // timer/<sourceId>/ instead of this device's topics (the LoRa receiver
+  // relaying a remote transmitter, or a timer on a lane other than the first).
+  void publishConnectionState(DeviceConnectionState state, const char* deviceName, const char* deviceModel,
+                              const char* sourceId = nullptr);
   void publishDeviceInfo(const char* deviceName, const char* deviceModel, const char* firmwareVersion);
-  void publishSessionStarted(uint32_t sessionId, float startDelaySeconds);
-  void publishSessionStopped(uint32_t sessionId, uint16_t totalShots, uint32_t lastShotTimeMs = 0);
-  void publishSessionSuspended(uint32_t sessionId);
-  void publishSessionResumed(uint32_t sessionId);
-  void publishCountdownComplete(uint32_t sessionId);
+  void publishSessionStarted(uint32_t sessionId, float startDelaySeconds, const char* sourceId = nullptr);
+  void publishSessionStopped(uint32_t sessionId, uint16_t totalShots, uint32_t lastShotTimeMs = 0,
+                             const char* sourceId = nullptr);
+  void publishSessionSuspended(uint32_t sessionId, const char* sourceId = nullptr);
+  void publishSessionResumed(uint32_t sessionId, const char* sourceId = nullptr);
+  void publishCountdownComplete(uint32_t sessionId, const char* sourceId = nullptr);
+
+  // Retained "online"/"offline" on timer/<sourceId>/presence
+  void publishSourcePresence(const char* sourceId, bool online);
 
   // Fast shot publishing - optimized for high-frequency BLE events
-  // Returns true if published successfully
-  bool publishShotDetected(const NormalizedShotData& shotData);
+  // Returns true if published successfully. seq (journal sequence number
+  // within the session) is only included when non-zero.
+  bool publishShotDetected(const NormalizedShotData& shotData, uint32_t seq = 0, const char* sourceId = nullptr);
+
+  // Batched shot publishing - several shots of one session in a single
+  // timer/<id>/shot/batch message. Built in place in jsonBuffer, so no other
+  // publish may run between beginShotBatch() and publishShotBatch().
+  static constexpr uint8_t MAX_SHOT_BATCH = 16;
+  void beginShotBatch(uint32_t sessionId, const char* deviceModel);
+  // False if the shot belongs to another session or the batch is full
+  bool addToShotBatch(const NormalizedShotData& shotData, uint32_t seq);
+  bool publishShotBatch(const char* sourceId = nullptr);
+  uint8_t getShotBatchCount() const { return batchCount; }
+
+  // Diagnostics - per-stage shot latency from ShotTrace
+  void publishShotLatency();
 
   // Settings/status
   void reconnect();
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Minimal MessagePack encoder into a caller-owned buffer
+ *
+ * No allocation and no intermediate document: values are appended in
+ * order, each in its smallest MessagePack form. Writing past the end of
+ * the buffer sets a sticky error (ok() == false) and stops writing, so
+ * callers check once after the last value.
+ *
+ * Only the types MQTT payloads need: unsigned integers up to 32 bits,
+ * float32, bool, nil, strings, arrays and maps.
+ */
+class MsgPackWriter {
+public:
+  // len > 0 resumes writing after existing content (e.g. a batch being built)
+  MsgPackWriter(uint8_t* buffer, size_t capacity, size_t len = 0)
+    : buf(buffer), cap(capacity), len(len), failed(len > capacity) {}
+
+  bool ok() const { return !failed; }
+  size_t size() const { return len; }
+  const uint8_t* data() const { return buf; }
+
+  // Raw byte outside the MessagePack stream (payload schema version)
+  void byte(uint8_t b) { put(&b, 1); }
+
+  void nil() { byte(0xc0); }
+  void boolean(bool v) { byte(v ? 0xc3 : 0xc2); }
+
+  void uint(uint32_t v) {
+    if (v < 0x80) {
+      byte((uint8_t)v);
+    } else if (v <= 0xff) {
+      uint8_t b[2] = { 0xcc, (uint8_t)v };
+      put(b, 2);
+    } else if (v <= 0xffff) {
+      uint8_t b[3] = { 0xcd, (uint8_t)(v >> 8), (uint8_t)v };
+      put(b, 3);
+    } else {
+      uint8_t b[5] = { 0xce, (uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v };
+      put(b, 5);
+    }
+  }
+
+  void float32(float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    uint8_t b[5] = { 0xca, (uint8_t)(bits >> 24), (uint8_t)(bits >> 16), (uint8_t)(bits >> 8), (uint8_t)bits };
+    put(b, 5);
+  }
+
+  void str(const char* s) {
+    size_t n = s ? strlen(s) : 0;
+    if (n > 0xff) {
+      n = 0xff;  // Payload strings are short; truncate rather than grow the header
+    }
+    if (n < 32) {
+      byte((uint8_t)(0xa0 | n));
+    } else {
+      uint8_t b[2] = { 0xd9, (uint8_t)n };
+      put(b, 2);
+    }
+    put(reinterpret_cast<const uint8_t*>(s), n);
+  }
+
+  void array(uint16_t n) { container(0x90, 0xdc, n); }
+  void map(uint16_t n) { container(0x80, 0xde, n); }
+
+  // Array whose length is only known later: always the 3-byte form,
+  // returns the offset to hand to patchArray16()
+  size_t array16() {
+    size_t at = len;
+    uint8_t b[3] = { 0xdc, 0, 0 };
+    put(b, 3);
+    return at;
+  }
+
+  void patchArray16(size_t at, uint16_t n) {
+    if (!failed && at + 3 <= len) {
+      buf[at + 1] = (uint8_t)(n >> 8);
+      buf[at + 2] = (uint8_t)n;
+    }
+  }
+
+private:
+  uint8_t* buf;
+  size_t cap;
+  size_t len;
+  bool failed;
+
+  void container(uint8_t fix, uint8_t wide, uint16_t n) {
+    if (n < 16) {
+      byte((uint8_t)(fix | n));
+    } else {
+      uint8_t b[3] = { wide, (uint8_t)(n >> 8), (uint8_t)n };
+      put(b, 3);
+    }
+  }
+
+  void put(const uint8_t* p, size_t n) {
+    if (failed || n > cap - len) {
+      failed = true;
+      return;
+    }
+    if (n) {
+      memcpy(buf + len, p, n);
+    }
+    len += n;
+  }
+};
@@ -19,7 +19,7 @@ enum class SGTimerEvent : uint8_t {
 class SGTimer : public BaseTimerDevice {
 private:
   // SG Timer specific configuration
-  static const char* LOG_TAG;
+  static constexpr const char* LOG_TAG = "SG-TIMER";  // constexpr so LOG_* can hash it at compile time
   static const char* CHARACTERISTIC_UUID;
   static const char* SHOT_LIST_UUID;
 
@@ -35,10 +35,7 @@ private:
   bool hasLastShot;
 
   // Internal methods
-  void processTimerData(uint8_t* data, size_t length);
-  // Static callback for BLE notifications
-  static void notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                           uint8_t* pData, size_t length, bool isNotify);
+  void processTimerData(uint8_t* data, size_t length) override;
 
 public:
   SGTimer();
@@ -51,7 +48,4 @@ public:
 
   // Public connection method for TimerApplication
   bool attemptConnection(BLEAdvertisedDevice* device);
-
-  // Static instance for callbacks
-  static SGTimer* instance;
 };
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+/**
+ * @brief Off-screen RGB565 frame plus a mirror of what the panel shows
+ *
+ * Renderers draw into this canvas exactly as they would into the panel
+ * (it is an Adafruit_GFX, so u8g2 and GlyphAtlas work unchanged). Every
+ * primitive marks the 8x8 tiles it touches. present() then compares only
+ * those tiles against the mirror and pushes pixels that actually differ
+ * to the panel as same-colour horizontal runs.
+ *
+ * A full clear followed by a redraw of mostly identical content therefore
+ * costs a few cells of panel writes instead of a black frame plus a full
+ * repaint - no visible flicker, and a new shot only touches the digits
+ * that changed.
+ *
+ * With pages = 2 (HUB75 double buffering) one mirror is kept per DMA
+ * buffer. Tiles drawn since a page was last presented stay pending for
+ * that page, so after flipPage() the other buffer is brought up to date
+ * on its next present() without a full repaint.
+ */
+class ShadowFramebuffer : public Adafruit_GFX {
+public:
+  static constexpr uint8_t TILE_SIZE = 8;
+  static constexpr uint8_t MAX_TILES = 64;   // pendingTiles are uint64_t masks
+  static constexpr uint8_t MAX_PAGES = 2;
+
+  struct PresentStats {
+    uint8_t tilesTouched = 0;    // Tiles drawn into since this page was last presented
+    uint8_t tilesChanged = 0;    // Of those, tiles with at least one differing pixel
+    uint16_t pixelsPushed = 0;
+    uint16_t runsPushed = 0;     // Panel draw calls issued
+  };
+
+  // Width and height must be multiples of TILE_SIZE, at most MAX_TILES tiles;
+  // pages = number of panel buffers mirrored (1 or 2)
+  ShadowFramebuffer(int16_t w, int16_t h, uint8_t pages = 1);
+  ~ShadowFramebuffer() override;
+
+  ShadowFramebuffer(const ShadowFramebuffer&) = delete;
+  ShadowFramebuffer& operator=(const ShadowFramebuffer&) = delete;
+
+  // Allocate the frame and page mirrors (internal SRAM preferred, PSRAM
+  // fallback). All start black, matching a freshly cleared panel.
+  bool begin();
+  bool isReady() const { return frame != nullptr; }
+
+  // Adafruit_GFX drawing primitives - write the frame and mark tiles
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+
+  // Push the differences in pending tiles to the current page and update its mirror
+  PresentStats present(Adafruit_GFX& panel);
+
+  // The panel swapped buffers - subsequent presents target the other page
+  void flipPage();
+
+  // Panel was cleared behind our back - assume every page is black
+  void resetShown();
+
+  // True if anything was drawn since the last present()
+  bool hasPendingTiles() const { return drawnSincePresent; }
+  uint16_t getPixel(int16_t x, int16_t y) const;
+  uint8_t getPageCount() const { return pageCount; }
+  size_t getBufferBytes() const { return (size_t)_width * _height * sizeof(uint16_t) * (1 + pageCount); }
+
+private:
+  uint16_t* frame;                 // Composed by the renderers
+  uint16_t* shown[MAX_PAGES];      // What each panel buffer currently holds
+  uint64_t pendingTiles[MAX_PAGES];
+  uint8_t pageCount;
+  uint8_t currentPage;
+  bool drawnSincePresent;
+  uint8_t tilesX;
+  uint8_t tilesY;
+
+  void freeBuffers();
+
+  // Clip a rectangle to the frame; false if nothing is left
+  bool clip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const;
+  void markTiles(int16_t x, int16_t y, int16_t w, int16_t h);
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Arduino.h>
+#include "ITimerDevice.h"
+
+/**
+ * @brief One journaled shot - fixed size so it can be spilled to flash as-is
+ */
+struct JournalRecord {
+  uint32_t sessionId;
+  uint32_t seq;              // Per-session sequence number, 1-based
+  uint32_t absoluteTimeMs;
+  uint32_t splitTimeMs;
+  uint32_t capturedMs;       // millis() when the shot was detected
+  uint16_t shotNumber;
+  uint8_t flags;             // FLAG_* below
+  uint8_t lane;              // Timer connection the shot came from
+  int64_t traceOriginUs;     // ShotTrace origin; 0 once the shot waited out an outage
+  char deviceModel[sizeof(NormalizedShotData::deviceModel)];  // Published as-is
+
+  static constexpr uint8_t FLAG_FIRST_SHOT = 0x01;
+};
+static_assert(sizeof(JournalRecord) == 64, "JournalRecord layout is part of the flash format");
+
+/**
+ * @brief Overflow storage for the journal (flash on the device)
+ *
+ * Holds the oldest records; everything in it is older than anything still
+ * in the RAM ring. Records are consumed from the front in blocks.
+ */
+class JournalSpillStore {
+public:
+  virtual ~JournalSpillStore() {}
+
+  virtual uint32_t count() const = 0;       // Records not yet consumed
+  virtual uint32_t capacity() const = 0;
+  virtual bool append(const JournalRecord* records, uint32_t n) = 0;
+  virtual uint32_t read(JournalRecord* out, uint32_t max) = 0;   // Oldest first, does not consume
+  virtual void consume(uint32_t n) = 0;
+  virtual void clear() = 0;
+};
+
+/**
+ * @brief Store-and-forward shot journal for MQTT outages
+ *
+ * Append-only ring of JournalRecord allocated once (PSRAM preferred), so a
+ * long outage never touches the general heap. When the ring is full the
+ * oldest SPILL_BLOCK records move to the spill store; if that is full too
+ * the oldest block is dropped and counted. peek()/pop() replay strictly in
+ * append order: spilled records first, then the RAM ring.
+ *
+ * Spilled records are consumed a block at a time, so a reset mid-block
+ * replays that block again (at-least-once) - consumers dedupe on
+ * (lane, sessionId, seq). Each lane numbers its own sessions, so shots of
+ * several timers can interleave in the journal.
+ *
+ * Main-loop only; not thread-safe.
+ */
+class ShotJournal {
+public:
+  static constexpr uint16_t SPILL_BLOCK = 32;
+  static constexpr uint32_t INTERNAL_FALLBACK_CAPACITY = 128;   // Ring size without PSRAM
+
+  struct Stats {
+    uint32_t appended = 0;
+    uint32_t replayed = 0;
+    uint32_t spilled = 0;
+    uint32_t dropped = 0;
+  };
+
+  ShotJournal();
+  ~ShotJournal();
+
+  ShotJournal(const ShotJournal&) = delete;
+  ShotJournal& operator=(const ShotJournal&) = delete;
+
+  // Allocate the RAM ring; spill may be nullptr (drop instead of spilling)
+  bool begin(uint32_t ramCapacity, JournalSpillStore* spill);
+  bool isReady() const { return ring != nullptr; }
+
+  // Journal a shot, assigning the next sequence number of its lane's session
+  void append(const NormalizedShotData& shot);
+
+  // Oldest unpublished record; false if the journal is empty
+  bool peek(JournalRecord& out);
+  // Up to max oldest records, without removing them. Stops at the end of
+  // the current spill block, so a batch never mixes flash and RAM records.
+  uint16_t peekBatch(JournalRecord* out, uint16_t max);
+  // Remove the oldest record (the one peek() returns)
+  void pop();
+
+  // Outage: shots still waiting are no longer meaningful latency samples
+  void clearTraceOrigins();
+
+  uint32_t pending() const;
+  uint32_t ramCount() const { return ramSize; }
+  uint32_t spillCount() const;
+  uint32_t getRamCapacity() const { return ramCapacity; }
+  const Stats& getStats() const { return stats; }
+
+  static void toShotData(const JournalRecord& record, NormalizedShotData& out);
+
+private:
+  JournalRecord* ring;
+  uint32_t ramCapacity;
+  uint32_t ramHead;      // Oldest record
+  uint32_t ramSize;
+
+  JournalSpillStore* spill;
+  JournalRecord stage[SPILL_BLOCK];   // Block read back from the spill store
+  uint16_t stageCount;
+  uint16_t stagePos;
+
+  uint32_t currentSessionId[MAX_TIMER_LANES];
+  uint32_t nextSeq[MAX_TIMER_LANES];
+  Stats stats;
+
+  void spillOldest();
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "LatencyHistogram.h"
+
+// Pipeline stages, each measured from BLE notification arrival
+// (NormalizedShotData::traceOriginUs) to the moment the stage completes.
+enum class TraceStage : uint8_t {
+  PARSED = 0,       // Protocol parser produced the shot (BLE ingest / stack task)
+  DEQUEUED,         // Main loop popped it from the shot ring
+  RENDERED,         // renderShotData() finished writing the LED panel
+  MQTT_PUBLISHED,   // publishShotDetected() returned
+  LORA_TX,          // LoRaTransmitter finished sending the packet (bridge)
+  COUNT
+};
+
+/**
+ * @brief End-to-end shot latency tracing
+ *
+ * Producers stamp traceOriginUs with esp_timer (µs) when the BLE
+ * notification arrives; each stage then calls record() with that origin.
+ * Per-stage histograms provide min/avg/p99/max for the serial log and the
+ * MQTT diagnostics topic. Shots with traceOriginUs == 0 (e.g. relayed over
+ * LoRa) are ignored.
+ *
+ * record() may be called from any task - histograms are spinlock-guarded.
+ */
+class ShotTrace {
+public:
+  struct StageSummary {
+    uint32_t count = 0;
+    uint32_t minUs = 0;
+    uint32_t avgUs = 0;
+    uint32_t p99Us = 0;
+    uint32_t maxUs = 0;
+  };
+
+  static inline int64_t nowUs() { return esp_timer_get_time(); }
+
+  static void record(TraceStage stage, int64_t originUs);
+  static StageSummary summarize(TraceStage stage);
+  static uint32_t getTotalSamples();
+  static void reset();
+
+  // One log line per stage that has samples
+  static void logSummary();
+
+  static const char* getStageName(TraceStage stage);
+
+private:
+  static LatencyHistogram histograms[(size_t)TraceStage::COUNT];
+  static uint32_t totalSamples;
+};
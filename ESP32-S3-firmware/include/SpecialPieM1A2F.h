@@ -26,7 +26,7 @@ enum class SpecialPieMacMessageType : uint8_t {
 class SpecialPieM1A2F : public BaseTimerDevice {
 private:
   // Special Pie Timer specific configuration
-  static const char* LOG_TAG;
+  static constexpr const char* LOG_TAG = "SP-M1A2-F";
   static const char* CHARACTERISTIC_UUID;
 
   // BLE components
@@ -40,12 +40,9 @@ private:
   bool sessionActiveFlag;
 
   // Internal methods
-  void processTimerData(uint8_t* data, size_t length);
+  void processTimerData(uint8_t* data, size_t length) override;
   bool connectToMacAddress(const char* macAddress);
 
-  // Static callback for BLE notifications
-  static void notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                           uint8_t* pData, size_t length, bool isNotify);
 
 public:
   SpecialPieM1A2F();
@@ -58,7 +55,4 @@ public:
 
   // Device identification - check if advertised device matches target MAC address
   static bool matchesDevice(BLEAdvertisedDevice* device);
-
-  // Static instance for callbacks
-  static SpecialPieM1A2F* instance;
 };
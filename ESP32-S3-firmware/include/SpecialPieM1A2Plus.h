@@ -16,7 +16,7 @@ enum class SpecialPieMessageType : uint8_t {
 class SpecialPieM1A2Plus : public BaseTimerDevice {
 private:
   // Special Pie Timer specific configuration
-  static const char* LOG_TAG;
+  static constexpr const char* LOG_TAG = "SP-M1A2+";
   static const char* CHARACTERISTIC_UUID;
 
   // BLE components
@@ -30,11 +30,8 @@ private:
   bool sessionActiveFlag;
 
   // Internal methods
-  void processTimerData(uint8_t* data, size_t length);
+  void processTimerData(uint8_t* data, size_t length) override;
 
-  // Static callback for BLE notifications
-  static void notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                           uint8_t* pData, size_t length, bool isNotify);
 
 public:
   SpecialPieM1A2Plus();
@@ -47,8 +44,5 @@ public:
 
   // Public connection method for TimerApplication
   bool attemptConnection(BLEAdvertisedDevice* device);
-
-  // Static instance for callbacks
-  static SpecialPieM1A2Plus* instance;
 };
 
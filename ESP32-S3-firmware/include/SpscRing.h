@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock-free single-producer / single-consumer ring buffer
+ *
+ * Fixed-capacity FIFO with no heap allocation and no locks. Exactly one
+ * task may call push() and exactly one (other) task may call pop()/clear().
+ * Head is owned by the producer, tail by the consumer; acquire/release
+ * ordering on the indices publishes slot contents between the two tasks.
+ *
+ * N must be a power of 2. One slot is kept as a guard, so the usable
+ * capacity is N - 1.
+ */
+template <typename T, size_t N>
+class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of 2");
+
+public:
+  static constexpr size_t MASK = N - 1;
+
+  // Producer side - returns false (item not stored) when the ring is full
+  bool push(const T& item) {
+    const size_t head = headIndex.load(std::memory_order_relaxed);
+    const size_t next = (head + 1) & MASK;
+    if (next == tailIndex.load(std::memory_order_acquire)) {
+      return false;
+    }
+    slots[head] = item;
+    headIndex.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side - returns false when the ring is empty
+  bool pop(T& out) {
+    const size_t tail = tailIndex.load(std::memory_order_relaxed);
+    if (tail == headIndex.load(std::memory_order_acquire)) {
+      return false;
+    }
+    out = slots[tail];
+    tailIndex.store((tail + 1) & MASK, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side - peek at the oldest item without removing it
+  const T* front() const {
+    const size_t tail = tailIndex.load(std::memory_order_relaxed);
+    if (tail == headIndex.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slots[tail];
+  }
+
+  // Consumer side - drops everything currently queued, returns count dropped
+  size_t clear() {
+    const size_t head = headIndex.load(std::memory_order_acquire);
+    const size_t tail = tailIndex.load(std::memory_order_relaxed);
+    tailIndex.store(head, std::memory_order_release);
+    return (head - tail) & MASK;
+  }
+
+  // Safe from either side (snapshot - may be stale by the time it is used)
+  size_t size() const {
+    return (headIndex.load(std::memory_order_acquire) -
+            tailIndex.load(std::memory_order_acquire)) & MASK;
+  }
+
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() == MASK; }
+  static constexpr size_t capacity() { return MASK; }
+
+private:
+  T slots[N];
+  std::atomic<size_t> headIndex{0};  // Next slot to write (producer)
+  std::atomic<size_t> tailIndex{0};  // Next slot to read (consumer)
+};
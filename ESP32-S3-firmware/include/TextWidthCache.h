@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Small fixed-size cache of measured text widths
+ *
+ * Keyed by (font pointer, FNV-1a hash of the string). DisplayManager fills
+ * it from u8g2 getUTF8Width() once per string, so marquee decisions and
+ * wrap offsets use real font metrics without re-measuring every frame.
+ * Slots are replaced round-robin; a hash collision at worst returns the
+ * width of another string in the same font until that entry is evicted.
+ */
+class TextWidthCache {
+public:
+  static constexpr uint8_t CAPACITY = 8;
+  static constexpr int16_t MISS = -1;
+
+  TextWidthCache() { clear(); }
+
+  static uint32_t hash(const char* text) {
+    uint32_t h = 2166136261u;
+    if (text) {
+      for (const char* p = text; *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 16777619u;
+      }
+    }
+    return h;
+  }
+
+  // Cached width, or MISS
+  int16_t lookup(const void* font, uint32_t textHash) const {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+      if (entries[i].font == font && entries[i].hash == textHash) {
+        return entries[i].width;
+      }
+    }
+    return MISS;
+  }
+
+  void store(const void* font, uint32_t textHash, int16_t width) {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+      if (entries[i].font == font && entries[i].hash == textHash) {
+        entries[i].width = width;
+        return;
+      }
+    }
+    Entry& e = entries[nextSlot];
+    e.font = font;
+    e.hash = textHash;
+    e.width = width;
+    nextSlot = (uint8_t)((nextSlot + 1) % CAPACITY);
+  }
+
+  // Drop the entry for one string (e.g. text edited in place)
+  void invalidate(const void* font, uint32_t textHash) {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+      if (entries[i].font == font && entries[i].hash == textHash) {
+        entries[i] = Entry();
+      }
+    }
+  }
+
+  void clear() {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+      entries[i] = Entry();
+    }
+    nextSlot = 0;
+  }
+
+  uint8_t size() const {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+      if (entries[i].font) n++;
+    }
+    return n;
+  }
+
+private:
+  struct Entry {
+    const void* font = nullptr;
+    uint32_t hash = 0;
+    int16_t width = 0;
+  };
+
+  Entry entries[CAPACITY];
+  uint8_t nextSlot;
+};
@@ -1,38 +1,114 @@
 #pragma once
 
 #include "ITimerDevice.h"
+#include "TimerDeviceManager.h"
 #include "DisplayManager.h"
 #include "MqttManager.h"
 #include "Logger.h"
+#include "SpscRing.h"
+#include "BleIngestTask.h"
+#include "LoopScheduler.h"
+#include "ShotTrace.h"
+#include "ShotJournal.h"
+#include "LittleFsSpillStore.h"
 #include <memory>
-#include "freertos/queue.h"
 
 // Application configuration
 namespace AppConfig {
   constexpr uint32_t WATCHDOG_TIMEOUT_MS = 10000;  // 10 seconds
   constexpr uint32_t HEALTH_CHECK_INTERVAL_MS = 5000;  // 5 seconds
 
-  // FreeRTOS queue configuration for shot events
+  // Concurrent timer connections (lanes). Lane 1 publishes on this device's
+  // topics, lane n > 1 under timer/<deviceId>-L<n>/
+  constexpr uint8_t MAX_TIMER_DEVICES = 3;
+  static_assert(MAX_TIMER_DEVICES >= 1 && MAX_TIMER_DEVICES <= MAX_TIMER_LANES, "One lane per timer");
+  constexpr uint32_t SCAN_RETRY_MS = 5000;        // Between scans while no timer is connected
+  constexpr uint32_t RESCAN_INTERVAL_MS = 30000;  // Looking for more timers (never during a session)
+
+  // Lock-free SPSC ring for shot and session events (must be power of 2)
   constexpr uint16_t EVENT_QUEUE_SIZE = 32;
   constexpr uint16_t QUEUE_DEPTH_WARN_THRESHOLD = EVENT_QUEUE_SIZE / 4;  // Warn at ~25% capacity
 
   // Batch processing configuration
   constexpr uint16_t MAX_SHOTS_PER_PUBLISH_CYCLE = 8;  // Max shots to publish per loop iteration
+
+  // BLE ingest pipeline: parse notifications on a dedicated task instead of the BLE stack task
+  constexpr bool BLE_INGEST_TASK_ENABLED = true;
+  constexpr BaseType_t BLE_INGEST_TASK_CORE = 0;        // Same core as Bluedroid; main loop runs on core 1
+  constexpr UBaseType_t BLE_INGEST_TASK_PRIORITY = 5;   // Above loopTask (1), below the BLE stack
+  constexpr uint32_t BLE_INGEST_TASK_STACK_SIZE = 4096;
+
+  // Deferred logging: LOG_* calls only queue the line; a low-priority task formats
+  // and prints it, so the BLE and main loop tasks never wait on the UART
+  constexpr bool DEFERRED_LOGGING_ENABLED = true;
+  constexpr BaseType_t LOG_DRAIN_TASK_CORE = 1;          // Away from the BLE stack
+  constexpr UBaseType_t LOG_DRAIN_TASK_PRIORITY = 1;     // Same as loopTask, which mostly sleeps
+  constexpr uint32_t LOG_DRAIN_TASK_STACK_SIZE = 4096;   // snprintf with %f
+
+  // Store-and-forward shot journal: shots are published from here, in order, and
+  // survive MQTT outages (PSRAM ring, oldest records spilled to LittleFS when full)
+  constexpr bool SHOT_JOURNAL_ENABLED = true;
+  constexpr uint32_t JOURNAL_RAM_CAPACITY = 4096;            // Records (64 B each, 256 KB PSRAM)
+  constexpr uint32_t JOURNAL_SPILL_MAX_BYTES = 512 * 1024;   // LittleFS spill segment limit
+  constexpr uint32_t JOURNAL_RETRY_MS = 500;                 // Back-off after a failed replay publish
+
+  // Batched shot publishing: shots journaled within this window of the oldest
+  // unpublished one go out as a single timer/<id>/shot/batch message
+  // (0 = publish every shot on its own to shot/detected), see common.h
+  constexpr uint32_t SHOT_BATCH_MAX_LATENCY_MS = MQTT_SHOT_BATCH_WINDOW_MS;
 }
 
+// Shot or session change handed from the BLE ingest task to the main loop.
+// One ring carries both, so the main loop sees them in the order they happened.
+struct TimerEvent {
+  enum class Type : uint8_t {
+    SHOT,
+    SESSION_STARTED,
+    COUNTDOWN_COMPLETE,
+    SESSION_STOPPED,
+    SESSION_SUSPENDED,
+    SESSION_RESUMED
+  };
+
+  Type type = Type::SHOT;
+  NormalizedShotData shot;  // SHOT
+  SessionData session;      // Session changes
+};
+
 class TimerApplication {
 private:
-  std::unique_ptr<ITimerDevice> timerDevice;
+  TimerDeviceManager timers;
   std::unique_ptr<DisplayManager> displayManager;
   std::unique_ptr<MqttManager> mqttManager;
 
-  // Application state
-  bool sessionActive;
-  uint16_t lastShotNumber;
-  uint32_t lastShotTime;
+  // Application state, per lane (main loop only)
+  uint8_t activeLanes;               // Bit per lane with a session running
+  uint8_t pendingRelease;            // Lanes whose timer disconnected - released after the update pass
+  uint16_t lastShotNumber[MAX_TIMER_LANES];
+  uint32_t lastShotTime[MAX_TIMER_LANES];
+
+  // MQTT source id per lane (lane 0 uses this device's own topics)
+  static constexpr size_t LANE_SOURCE_ID_SIZE = 32;
+  char laneSourceIds[MAX_TIMER_LANES][LANE_SOURCE_ID_SIZE];
+
+  // BLE notification parsing task (pipeline mode only)
+  std::unique_ptr<BleIngestTask> bleIngest;
 
-  // FreeRTOS queue for shot events (written by BLE callback, read by main loop)
-  QueueHandle_t shotEventQueue;
+  // Shot and session events: single producer (BLE ingest/stack task), single
+  // consumer (main loop). The main loop owns display and MQTT.
+  SpscRing<TimerEvent, AppConfig::EVENT_QUEUE_SIZE> eventRing;
+  uint8_t tracedLanes;  // Producer side: lanes whose session is being traced
+
+  // Store-and-forward journal (MQTT configured and journal allocated)
+  ShotJournal journal;
+  std::unique_ptr<LittleFsSpillStore> journalSpill;
+  bool journalEnabled;
+  bool journalOutage;              // MQTT down with shots waiting
+  unsigned long journalRetryAt;    // No replay before this after a failed publish (millis)
+  unsigned long journalReplayAt;   // Next replay deadline (retry back-off or batch window)
+
+  // Main loop wake-ups (shots, BLE events, display frame deadlines)
+  LoopScheduler scheduler;
 
   // Diagnostics
   uint16_t maxQueueDepth;
@@ -54,23 +130,42 @@ private:
   // MQTT warning throttle
   unsigned long lastMqttWarningTime;
 
-  // Event handlers
+  // Shot latency trace reporting (serial + MQTT diagnostics)
+  uint32_t lastReportedTraceSamples;
+
+  // Device callbacks (BLE ingest task) - queue for the main loop
   void onShotDetected(const NormalizedShotData& shotData);
-  void onSessionStarted(const SessionData& sessionData);
-  void onCountdownComplete(const SessionData& sessionData);
-  void onSessionStopped(const SessionData& sessionData);
-  void onSessionSuspended(const SessionData& sessionData);
-  void onSessionResumed(const SessionData& sessionData);
-  void onConnectionStateChanged(DeviceConnectionState state);
+  void onSessionEvent(TimerEvent::Type type, const SessionData& sessionData);
+
+  // Event handlers (main loop)
+  void handleSessionStarted(const SessionData& sessionData);
+  void handleCountdownComplete(const SessionData& sessionData);
+  void handleSessionStopped(const SessionData& sessionData);
+  void handleSessionSuspended(const SessionData& sessionData);
+  void handleSessionResumed(const SessionData& sessionData);
+  void onConnectionStateChanged(uint8_t lane, DeviceConnectionState state);
 
   // Helper methods
-  void setupCallbacks();
+  template <typename Timer>
+  bool connectTimer(BLEAdvertisedDevice* advertised, const char* label);
+  void setupCallbacks(uint8_t lane);
+  void releaseTimerDevice(uint8_t lane);
+  void releaseDisconnectedDevices();
+  const char* laneSourceId(uint8_t lane) const { return lane == 0 ? nullptr : laneSourceIds[lane]; }
   void logShotData(const NormalizedShotData& shotData);
   void performHealthCheck();
+  void reportShotLatency();
   void updateActivityTime();
   void scanForDevices();
   void processScanResults();
-  void publishQueuedEvents();
+  void processQueuedEvents();
+  void applyQueuedEvents(uint16_t maxEvents);
+  void initializeJournal();
+  void journalShot(const NormalizedShotData& shot);
+  void replayJournal(bool closeBatch = false);
+  bool publishJournalBatch(bool closeBatch);
+  uint32_t getMsUntilJournalReplay() const;
+  void waitForNextEvent();
 
 public:
   TimerApplication();
@@ -80,7 +175,8 @@ public:
   void run();
 
   // Getters for debugging/monitoring
-  bool isSessionActive() const { return sessionActive; }
+  bool isSessionActive() const { return activeLanes != 0; }
+  uint8_t getConnectedTimerCount() const { return timers.count(); }
   DisplayManager* getDisplayManager() const { return displayManager.get(); }
   MqttManager* getMqttManager() const { return mqttManager.get(); }
 
@@ -88,4 +184,7 @@ public:
   bool isHealthy() const;
   bool isRuntimeReady() const;
   unsigned long getUptimeMs() const;
+
+  // Wake the main loop (safe from any task)
+  void signalLoop(uint32_t events) { scheduler.signal(events); }
 };
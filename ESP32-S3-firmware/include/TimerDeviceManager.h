@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ITimerDevice.h"
+#include <memory>
+
+/**
+ * @brief Concurrent timer connections, one per lane
+ *
+ * Owns up to getCapacity() ITimerDevice instances, each on a fixed lane
+ * index (0 .. capacity-1). The lane is what tags NormalizedShotData and
+ * SessionData, routes BleIngestTask payloads and picks the MQTT topics, so
+ * a timer keeps its lane for as long as it stays connected. A timer that
+ * reconnects gets its previous lane back when that lane is still free.
+ *
+ * Main-loop only; not thread-safe.
+ */
+class TimerDeviceManager {
+public:
+  explicit TimerDeviceManager(uint8_t capacity);
+
+  TimerDeviceManager(const TimerDeviceManager&) = delete;
+  TimerDeviceManager& operator=(const TimerDeviceManager&) = delete;
+
+  // Lane holding the timer at this address; -1 if none
+  int findLane(const BLEAddress& address) const;
+  // Lane for a new connection to this address; -1 if all lanes are taken
+  int freeLane(const BLEAddress& address) const;
+
+  // Place a device on a free lane (takes ownership)
+  void assign(uint8_t lane, std::unique_ptr<ITimerDevice> device, const BLEAddress& address);
+  // Remove a lane's device - the caller destroys it
+  std::unique_ptr<ITimerDevice> take(uint8_t lane);
+
+  ITimerDevice* get(uint8_t lane) const { return lane < capacity ? lanes[lane].device.get() : nullptr; }
+
+  uint8_t count() const;
+  bool isFull() const { return count() == capacity; }
+  uint8_t getCapacity() const { return capacity; }
+
+private:
+  static constexpr size_t ADDRESS_SIZE = 18;  // "AA:BB:CC:DD:EE:FF"
+
+  struct Lane {
+    std::unique_ptr<ITimerDevice> device;
+    char address[ADDRESS_SIZE];  // Last timer on this lane, kept after it leaves
+  };
+
+  Lane lanes[MAX_TIMER_LANES];
+  uint8_t capacity;
+
+  static void formatAddress(const BLEAddress& address, char* out);
+};
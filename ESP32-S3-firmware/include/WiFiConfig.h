@@ -21,6 +21,7 @@ private:
   static char mqtt_password[41];
   static char timer_type[7];
   static char startup_text[41];
+  static uint32_t startupTextRevision;  // Bumped whenever startup_text is rewritten
 
   // Configuration constants
   static constexpr unsigned long CONNECTION_CHECK_INTERVAL = 5000;  // Check every 5 seconds
@@ -65,6 +66,12 @@ public:
    */
   static bool isConnected();
 
+  /**
+   * @brief Check if the configuration portal is running
+   * The portal needs frequent update() calls while active
+   */
+  static bool isPortalActive();
+
   /**
    * @brief Get the local IP address as string
    */
@@ -90,4 +97,10 @@ public:
   static const char* getMqttPassword();
   static int getTimerType();
   static const char* getStartupText();
+
+  /**
+   * @brief Changes whenever the startup text is (re)loaded or saved
+   * Lets the display drop cached measurements of the old text.
+   */
+  static uint32_t getStartupTextRevision();
 };
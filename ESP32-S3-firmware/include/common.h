@@ -25,10 +25,45 @@
 // Display scrolling settings
 #define MARQUEE_SCROLL_GAP_PIXELS 60 // Gap between repeated text in marquee scroll
 
+// Shot/split screens blit pre-rasterized glyphs instead of decoding u8g2 fonts
+// per frame (see GlyphAtlas.h). 0 = always draw through u8g2.
+#define GLYPH_ATLAS_ENABLED 1
+
+// Render into an off-screen RGB565 frame and push only changed pixels to the
+// panel (see ShadowFramebuffer.h). 0 = draw straight into the live DMA buffer.
+#define SHADOW_FRAMEBUFFER_ENABLED 1
+
+// HUB75 refresh floor (Hz) - also bounds how long a page flip takes to land
+#define HUB75_MIN_REFRESH_RATE 120
+
+// Draw into a back DMA buffer and flip at the frame boundary (tear-free
+// marquee/countdown). Doubles the HUB75 DMA buffer memory - the measured
+// cost is logged at startup. Requires SHADOW_FRAMEBUFFER_ENABLED.
+#define HUB75_DOUBLE_BUFFER 0
+
 // =============================================================================
 // Timing Configuration
 // =============================================================================
-#define MAIN_LOOP_DELAY 10              // Main loop delay in milliseconds
+#define MAIN_LOOP_DELAY 10              // Main loop delay in milliseconds (legacy loop / portal active)
+
+// Event-driven main loop: block until a producer signals (shot, BLE event)
+// or the next display frame deadline. 0 = legacy fixed MAIN_LOOP_DELAY yield,
+// kept for before/after wake-count and latency comparison (-DEVENT_DRIVEN_LOOP=0).
+#ifndef EVENT_DRIVEN_LOOP
+#define EVENT_DRIVEN_LOOP 1
+#endif
+#define MAIN_LOOP_IDLE_MAX_WAIT 100     // Longest idle block (MQTT keepalive/reconnect polling)
+
+// Batched shot publishing window (ms): shots journaled within it go out as one
+// timer/<id>/shot/batch message. 0 = every shot on its own to shot/detected.
+// Off until every subscriber expands shot/batch - the PWA display and the
+// mqtt-simulator still listen on shot/detected only.
+#ifndef MQTT_SHOT_BATCH_WINDOW_MS
+#define MQTT_SHOT_BATCH_WINDOW_MS 0
+#endif
+
+// Per-stage shot latency histograms (BLE notify -> parse/queue/render/MQTT), see ShotTrace.h
+#define SHOT_TRACE_ENABLED 1
 
 // Startup message delay - shorter for debug builds to speed up development
 #ifdef DEBUG_BUILD
@@ -73,6 +108,11 @@
 #define MQTT_USER ""
 #define MQTT_PASSWORD ""
 
+// Event payload encoding - JSON (PWA) or compact MessagePack, see MqttBinaryPayload.h
+#define MQTT_PAYLOAD_FORMAT_JSON    0
+#define MQTT_PAYLOAD_FORMAT_MSGPACK 1
+#define MQTT_PAYLOAD_FORMAT         MQTT_PAYLOAD_FORMAT_JSON
+
 // =============================================================================
 // Protocol Constants
 // =============================================================================
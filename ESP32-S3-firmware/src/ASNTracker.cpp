@@ -3,13 +3,10 @@
 #include "common.h"
 
 // Static constants
-const char *ASNTracker::LOG_TAG = "ASN-Tracker";
+constexpr const char* ASNTracker::LOG_TAG;
 const char *ASNTracker::SERVICE_UUID = "E5A10001-F1A2-4B63-9F8C-D7B781E35E2A";
 const char *ASNTracker::CHARACTERISTIC_UUID = "E5A10002-F1A2-4B63-9F8C-D7B781E35E2A";
 
-// Static instance for callbacks
-ASNTracker* ASNTracker::instance = nullptr;
-
 ASNTracker::ASNTracker() :
   BaseTimerDevice("ASN Tracker"),
   pNotifyCharacteristic(nullptr),
@@ -18,12 +15,10 @@ ASNTracker::ASNTracker() :
   hasPreviousShot(false),
   currentSessionId(0),
   sessionActiveFlag(false) {
-  instance = this;
 }
 
 ASNTracker::~ASNTracker() {
   disconnect();
-  instance = nullptr;
 }
 
 // Static method to check if advertised device is an ASN Tracker
@@ -94,7 +89,7 @@ bool ASNTracker::attemptConnection(BLEAdvertisedDevice* device) {
         // Check if characteristic can notify
         if (pNotifyCharacteristic->canNotify()) {
           LOG_INFO(LOG_TAG, "Registering for notifications");
-          pNotifyCharacteristic->registerForNotify(notifyCallback);
+          subscribe(pNotifyCharacteristic);
           LOG_INFO(LOG_TAG, "Successfully registered for notifications - listening for events");
           isConnectedFlag = true;
           lastHeartbeat = millis();
@@ -134,27 +129,13 @@ bool ASNTracker::attemptConnection(BLEAdvertisedDevice* device) {
   return false;
 }
 
-// Static notification callback
-void ASNTracker::notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                                          uint8_t* pData, size_t length, bool isNotify) {
-  if (instance && pData && length > 0) {
-    instance->processTimerData(pData, length);
-  }
-}
-
 void ASNTracker::processTimerData(uint8_t* pData, size_t length) {
   if (!pData || length == 0) {
     LOG_WARN(LOG_TAG, "Invalid data received (null or empty)");
     return;
   }
 
-  if (Logger::getLevel() <= LogLevel::DEBUG) {
-    LOG_DEBUG(LOG_TAG, "Notification received (%d bytes)", length);
-    for (size_t i = 0; i < length; i++) {
-      Serial.printf("%02X ", pData[i]);
-    }
-    Serial.println();
-  }
+  LOG_HEX(LOG_TAG, "Notification received", pData, length);
 
   // ASN Tracker Protocol:
   // [F8] [F9] [MESSAGE_TYPE] [DATA...] [F9] [F8]
@@ -265,6 +246,7 @@ void ASNTracker::processTimerData(uint8_t* pData, size_t length) {
         shotData.absoluteTimeMs = absoluteTimeMs;
         shotData.splitTimeMs = splitTimeMs;
         shotData.timestampMs = millis();
+        shotData.traceOriginUs = notifyTimestampUs;
         strncpy(shotData.deviceModel, deviceModel, sizeof(shotData.deviceModel) - 1);
         shotData.deviceModel[sizeof(shotData.deviceModel) - 1] = '\0';
         shotData.isFirstShot = isFirstShot;
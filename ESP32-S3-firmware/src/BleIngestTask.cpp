@@ -0,0 +1,131 @@
+#include "BleIngestTask.h"
+#include "Logger.h"
+
+BleIngestTask::BleIngestTask()
+  : taskHandle(nullptr),
+    deviceMutex(nullptr),
+    processedCount(0),
+    droppedCount(0),
+    peakDepth(0) {
+  for (uint8_t lane = 0; lane < MAX_TIMER_LANES; lane++) {
+    devices[lane] = nullptr;
+    generations[lane] = 0;
+  }
+}
+
+BleIngestTask::~BleIngestTask() {
+  for (uint8_t lane = 0; lane < MAX_TIMER_LANES; lane++) {
+    detach(lane);
+  }
+  if (taskHandle) {
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+  }
+  if (deviceMutex) {
+    vSemaphoreDelete(deviceMutex);
+    deviceMutex = nullptr;
+  }
+}
+
+bool BleIngestTask::start(BaseType_t core, UBaseType_t priority, uint32_t stackSize) {
+  if (taskHandle) {
+    return true;
+  }
+
+  deviceMutex = xSemaphoreCreateMutex();
+  if (!deviceMutex) {
+    LOG_ERROR("BLE", "Failed to create ingest mutex");
+    return false;
+  }
+
+  BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "bleIngest", stackSize, this,
+                                              priority, &taskHandle, core);
+  if (result != pdPASS) {
+    LOG_ERROR("BLE", "Failed to create ingest task");
+    taskHandle = nullptr;
+    return false;
+  }
+
+  LOG_BLE("Ingest task started on core %d (priority %u)", (int)core, (unsigned)priority);
+  return true;
+}
+
+void BleIngestTask::attach(uint8_t lane, ITimerDevice* newDevice) {
+  if (!taskHandle || !newDevice || lane >= MAX_TIMER_LANES) {
+    return;
+  }
+
+  xSemaphoreTake(deviceMutex, portMAX_DELAY);
+  devices[lane] = newDevice;
+  generations[lane]++;
+  xSemaphoreGive(deviceMutex);
+
+  newDevice->setNotificationSink([this, lane](const uint8_t* data, size_t length, int64_t receivedUs) {
+    return submit(lane, data, length, receivedUs);
+  });
+}
+
+void BleIngestTask::detach(uint8_t lane) {
+  if (!deviceMutex || lane >= MAX_TIMER_LANES) {
+    return;
+  }
+
+  // Waits for an in-flight parse to finish so the device can be destroyed safely.
+  // The device's sink is left in place - anything it still submits carries the
+  // old generation and is discarded by drain().
+  xSemaphoreTake(deviceMutex, portMAX_DELAY);
+  devices[lane] = nullptr;
+  generations[lane]++;
+  xSemaphoreGive(deviceMutex);
+}
+
+bool BleIngestTask::submit(uint8_t lane, const uint8_t* data, size_t length, int64_t receivedUs) {
+  // Runs on the BLE stack task - copy and wake only, no logging here
+  if (length == 0 || length > MAX_PAYLOAD_SIZE) {
+    droppedCount++;
+    return true;
+  }
+
+  RawNotification note;
+  note.receivedUs = receivedUs;
+  note.lane = lane;
+  note.generation = generations[lane].load();
+  note.length = (uint8_t)length;
+  memcpy(note.data, data, length);
+
+  if (!ring.push(note)) {
+    droppedCount++;
+    return true;
+  }
+
+  uint16_t depth = (uint16_t)ring.size();
+  if (depth > peakDepth.load()) {
+    peakDepth = depth;
+  }
+
+  xTaskNotifyGive(taskHandle);
+  return true;
+}
+
+void BleIngestTask::drain() {
+  RawNotification note;
+  while (ring.pop(note)) {
+    xSemaphoreTake(deviceMutex, portMAX_DELAY);
+    ITimerDevice* device = devices[note.lane];
+    if (device && note.generation == generations[note.lane].load()) {
+      device->processNotification(note.data, note.length, note.receivedUs);
+      processedCount++;
+    } else {
+      droppedCount++;  // Payload belongs to a device that has since been released
+    }
+    xSemaphoreGive(deviceMutex);
+  }
+}
+
+void BleIngestTask::taskEntry(void* param) {
+  BleIngestTask* self = static_cast<BleIngestTask*>(param);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->drain();
+  }
+}
@@ -1,8 +1,14 @@
 #include "DisplayManager.h"
 #include "WiFiConfig.h"
 #include "Logger.h"
+#include "ShotTrace.h"
 #include <stdio.h>
 #include <U8g2_for_Adafruit_GFX.h>
+#include <esp_heap_caps.h>
+
+#if HUB75_DOUBLE_BUFFER && !SHADOW_FRAMEBUFFER_ENABLED
+#error "HUB75_DOUBLE_BUFFER needs SHADOW_FRAMEBUFFER_ENABLED to keep both DMA buffers in sync"
+#endif
 
 U8G2_FOR_ADAFRUIT_GFX u8g2_for_adafruit_gfx;
 
@@ -34,8 +40,18 @@ const uint16_t DisplayColors::GRAY = 0x8410;       // 128, 128, 128
 
 DisplayManager::DisplayManager()
   : display(nullptr),
+    framebuffer(PANEL_WIDTH * PANEL_CHAIN, PANEL_HEIGHT, HUB75_DOUBLE_BUFFER ? 2 : 1),
+    target(nullptr),
+    doubleBuffered(false),
+    dmaBufferBytes(0),
+    lastFlipTime(0),
+    pendingTraceOriginUs(0),
+    framesPresented(0),
+    pixelsPresented(0),
     currentState(DisplayState::STARTUP),
     lastUpdateTime(0),
+    lastShotData{},
+    currentSessionData{},
     connectionState(DeviceConnectionState::DISCONNECTED),
     deviceName(nullptr),
     countdownStartTime(0),
@@ -46,13 +62,14 @@ DisplayManager::DisplayManager()
     cachedAbsoluteTimeMs(0xFFFFFFFF),
     cachedSplitTimeMs(0xFFFFFFFF),
     scrollOffset(0),
-    lastScrollUpdate(0),
+    scrollPacer(SCROLL_SPEED_MS),
     textPixelWidth(0),
     startupScrollOffset(0),
-    startupLastScrollUpdate(0),
+    startupScrollPacer(SCROLL_SPEED_MS),
     startupTextPixelWidth(0),
-    lastShotData{},
-    currentSessionData{} {
+    startupTextRevision(0),
+    startupTextHash(0),
+    countdownPacer(COUNTDOWN_REFRESH_MS) {
   // Structs now have default member initializers - no memset needed
 }
 
@@ -82,7 +99,21 @@ bool DisplayManager::initialize() {
   mxconfig.i2sspeed = HUB75_I2S_CFG::HZ_20M;  // Higher clock speed for better refresh
 
   // Optimize for better refresh rate and color depth
-  mxconfig.min_refresh_rate = 120;       // Higher refresh rate reduces flicker/scanlines
+  mxconfig.min_refresh_rate = HUB75_MIN_REFRESH_RATE;  // Higher refresh rate reduces flicker/scanlines
+
+  // Shadow framebuffer first: double buffering is only safe with it
+  bool framebufferReady = false;
+#if SHADOW_FRAMEBUFFER_ENABLED
+  framebufferReady = framebuffer.begin();
+  if (framebufferReady) {
+    LOG_DISPLAY("Shadow framebuffer: %u bytes", (unsigned)framebuffer.getBufferBytes());
+  } else {
+    LOG_WARN("DISPLAY", "Shadow framebuffer allocation failed, drawing to panel directly");
+  }
+#endif
+
+  doubleBuffered = HUB75_DOUBLE_BUFFER && framebufferReady;
+  mxconfig.double_buff = doubleBuffered;
 
   display = new MatrixPanel_I2S_DMA(mxconfig);
   if (!display) {
@@ -90,18 +121,118 @@ bool DisplayManager::initialize() {
     return false;
   }
 
+  // DMA-capable heap consumed by the panel's frame buffers and descriptors
+  size_t dmaFreeBefore = heap_caps_get_free_size(MALLOC_CAP_DMA);
   display->begin();
+  size_t dmaFreeAfter = heap_caps_get_free_size(MALLOC_CAP_DMA);
+  dmaBufferBytes = dmaFreeBefore > dmaFreeAfter ? dmaFreeBefore - dmaFreeAfter : 0;
+  LOG_DISPLAY("HUB75 DMA buffers: %u bytes (%s), %u bytes DMA heap left",
+              (unsigned)dmaBufferBytes, doubleBuffered ? "double-buffered" : "single buffer",
+              (unsigned)dmaFreeAfter);
 
   display->setBrightness8(200); // Slightly lower brightness helps reduce scanlines
   display->clearScreen();
   display->setTextWrap(false);
-  u8g2_for_adafruit_gfx.begin(*display);
+
+  target = framebufferReady ? static_cast<Adafruit_GFX*>(&framebuffer) : display;
+  u8g2_for_adafruit_gfx.begin(*target);
+
+  buildGlyphAtlases();
 
   showStartup();
   LOG_DISPLAY("HUB75 panels initialized successfully");
   return true;
 }
 
+void DisplayManager::buildGlyphAtlases() {
+#if GLYPH_ATLAS_ENABLED
+  // Characters used by the waiting/shot/session-end screens
+  static const char* const LABEL_CHARSET = "0123456789:. ShotsSplit";
+  static const char* const TIME_CHARSET = "0123456789:.";
+
+  bool ok = labelAtlas.build(u8g2_for_adafruit_gfx, u8g2_font_helvR10_tf, LABEL_CHARSET) &&
+            timeAtlas.build(u8g2_for_adafruit_gfx, u8g2_font_helvB18_tf, TIME_CHARSET);
+
+  // build() rasterizes into a scratch canvas - point u8g2 back at the draw target
+  u8g2_for_adafruit_gfx.begin(*target);
+
+  if (ok) {
+    LOG_DISPLAY("Glyph atlas ready: %u + %u glyphs, %u bytes",
+                labelAtlas.getGlyphCount(), timeAtlas.getGlyphCount(),
+                (unsigned)(labelAtlas.getBitmapBytesUsed() + timeAtlas.getBitmapBytesUsed()));
+  } else {
+    LOG_WARN("DISPLAY", "Glyph atlas build failed, shot screens fall back to u8g2");
+  }
+#endif
+}
+
+void DisplayManager::drawText(const GlyphAtlas& atlas, const uint8_t* font,
+                              int16_t x, int16_t y, const char* text, uint16_t color) {
+  if (atlas.contains(text)) {
+    atlas.draw(target, x, y, text, color);
+    return;
+  }
+
+  u8g2_for_adafruit_gfx.setFontMode(1);
+  u8g2_for_adafruit_gfx.setFontDirection(0);
+  u8g2_for_adafruit_gfx.setFont(font);
+  u8g2_for_adafruit_gfx.setForegroundColor(color);
+  u8g2_for_adafruit_gfx.setCursor(x, y);
+  u8g2_for_adafruit_gfx.print(text);
+}
+
+void DisplayManager::presentFrame() {
+  if (target != &framebuffer || !framebuffer.hasPendingTiles()) {
+    return;
+  }
+
+  unsigned long now = millis();
+  if (doubleBuffered && now - lastFlipTime < FLIP_GUARD_MS) {
+    // Previous flip may not have landed - the back buffer could still be
+    // on screen. getMsUntilNextFrame() wakes the loop when it is safe.
+    return;
+  }
+
+  ShadowFramebuffer::PresentStats stats = framebuffer.present(*display);
+  if (doubleBuffered) {
+    display->flipDMABuffer();
+    framebuffer.flipPage();
+    lastFlipTime = now;
+  }
+
+  framesPresented++;
+  pixelsPresented += stats.pixelsPushed;
+
+  if (currentState == DisplayState::SHOWING_SHOT) {
+    LOG_DEBUG("DISPLAY", "Shot frame: %u/%u tiles changed, %u px in %u runs",
+              stats.tilesChanged, stats.tilesTouched, stats.pixelsPushed, stats.runsPushed);
+  }
+}
+
+void DisplayManager::logFrameStats() {
+  uint32_t maxLateMs = scrollPacer.getMaxLatenessMs();
+  if (startupScrollPacer.getMaxLatenessMs() > maxLateMs) {
+    maxLateMs = startupScrollPacer.getMaxLatenessMs();
+  }
+  if (countdownPacer.getMaxLatenessMs() > maxLateMs) {
+    maxLateMs = countdownPacer.getMaxLatenessMs();
+  }
+
+  LOG_DEBUG("DISPLAY", "Frames: %lu presented (%lu px), pacing %lu ticks / %lu skipped, max %lu ms late",
+            (unsigned long)framesPresented,
+            (unsigned long)pixelsPresented,
+            (unsigned long)(scrollPacer.getFrames() + startupScrollPacer.getFrames() + countdownPacer.getFrames()),
+            (unsigned long)(scrollPacer.getSkippedFrames() + startupScrollPacer.getSkippedFrames() +
+                            countdownPacer.getSkippedFrames()),
+            (unsigned long)maxLateMs);
+
+  framesPresented = 0;
+  pixelsPresented = 0;
+  scrollPacer.resetStats();
+  startupScrollPacer.resetStats();
+  countdownPacer.resetStats();
+}
+
 void DisplayManager::markDirty(bool clearFirst) {
   displayDirty = true;
   needsClear = clearFirst;
@@ -113,16 +244,23 @@ void DisplayManager::update() {
 
   switch (currentState) {
     case DisplayState::STARTUP:
+      // Startup text edited (NVS load or portal save) - re-measure and restart the marquee
+      if (WiFiConfig::getStartupTextRevision() != startupTextRevision) {
+        refreshStartupTextWidth();
+        startupScrollOffset = 0;
+        markDirty(true);
+      }
+
       // Update marquee scroll position for startup message
-      if (currentTime - startupLastScrollUpdate >= SCROLL_SPEED_MS) {
-        startupScrollOffset++;
+      if (uint32_t steps = startupScrollPacer.tick(currentTime)) {
+        // Advance by every elapsed frame so a late wake keeps the scroll speed
+        startupScrollOffset += steps;
 
         // Reset when text has scrolled completely off screen
         if (startupScrollOffset > startupTextPixelWidth + MARQUEE_SCROLL_GAP_PIXELS) {
           startupScrollOffset = 0; // Reset to start
         }
 
-        startupLastScrollUpdate = currentTime;
         markDirty(false); // Mark dirty WITHOUT full clear - we'll clear just the text area
       }
 
@@ -149,15 +287,14 @@ void DisplayManager::update() {
       // Update marquee scroll position if needed (only in CONNECTED state)
       if (currentState == DisplayState::CONNECTED && deviceName && textPixelWidth > (PANEL_WIDTH * PANEL_CHAIN) - 8) {
         // Text is too long and needs scrolling
-        if (currentTime - lastScrollUpdate >= SCROLL_SPEED_MS) {
-          scrollOffset++;
+        if (uint32_t steps = scrollPacer.tick(currentTime)) {
+          scrollOffset += steps;
 
           // Reset when text has scrolled completely off screen
           if (scrollOffset > textPixelWidth + MARQUEE_SCROLL_GAP_PIXELS) {
             scrollOffset = 0; // Reset to start
           }
 
-          lastScrollUpdate = currentTime;
           displayDirty = true;
           needsClear = false;
         }
@@ -176,13 +313,12 @@ void DisplayManager::update() {
 
     case DisplayState::COUNTDOWN:
       // Update countdown display frequently for smooth countdown
-      if (displayDirty || currentTime - lastUpdateTime >= 100) {  // Update every 100ms
+      if (countdownPacer.tick(currentTime) || displayDirty) {
         // Always clear for countdown to prevent text overlap artifacts
         clearDisplay();
         needsClear = false;
         renderCountdown();
         displayDirty = false;
-        lastUpdateTime = currentTime;
       }
       break;
 
@@ -205,6 +341,7 @@ void DisplayManager::update() {
         }
         renderShotData();
         displayDirty = false;
+        pendingTraceOriginUs = lastShotData.traceOriginUs;
       }
       break;
 
@@ -219,6 +356,83 @@ void DisplayManager::update() {
       }
       break;
   }
+
+  // Push whatever the renderers changed to the panel
+  presentFrame();
+
+  // A shot counts as rendered once its pixels reached the panel
+  if (pendingTraceOriginUs != 0 && !(target == &framebuffer && framebuffer.hasPendingTiles())) {
+    ShotTrace::record(TraceStage::RENDERED, pendingTraceOriginUs);
+    pendingTraceOriginUs = 0;
+  }
+}
+
+uint32_t DisplayManager::getMsUntilNextFrame() const {
+  if (displayDirty) {
+    return 0;
+  }
+
+  unsigned long currentTime = millis();
+
+  // Rendered frame waiting for the previous page flip to land
+  if (target == &framebuffer && framebuffer.hasPendingTiles()) {
+    unsigned long sinceFlip = currentTime - lastFlipTime;
+    return sinceFlip >= FLIP_GUARD_MS ? 0 : (uint32_t)(FLIP_GUARD_MS - sinceFlip);
+  }
+
+  // Milliseconds left until 'start + period', 0 if already due
+  auto remaining = [currentTime](unsigned long start, uint32_t period) -> uint32_t {
+    unsigned long elapsed = currentTime - start;
+    return elapsed >= period ? 0 : (uint32_t)(period - elapsed);
+  };
+
+  switch (currentState) {
+    case DisplayState::STARTUP: {
+      uint32_t scroll = startupScrollPacer.msUntilNext(currentTime);
+      uint32_t transition = remaining(lastUpdateTime, STARTUP_MESSAGE_DELAY + 1);
+      return scroll < transition ? scroll : transition;
+    }
+
+    case DisplayState::CONNECTED:
+      if (deviceName && textPixelWidth > (PANEL_WIDTH * PANEL_CHAIN) - 8) {
+        return scrollPacer.msUntilNext(currentTime);
+      }
+      return UINT32_MAX;
+
+    case DisplayState::COUNTDOWN:
+      return countdownPacer.msUntilNext(currentTime);
+
+    default:
+      return UINT32_MAX;
+  }
+}
+
+int16_t DisplayManager::measureText(const uint8_t* font, const char* text) {
+  if (!text || !text[0]) {
+    return 0;
+  }
+
+  const uint32_t textHash = TextWidthCache::hash(text);
+  int16_t width = widthCache.lookup(font, textHash);
+  if (width == TextWidthCache::MISS) {
+    u8g2_for_adafruit_gfx.setFont(font);
+    width = u8g2_for_adafruit_gfx.getUTF8Width(text);
+    widthCache.store(font, textHash, width);
+  }
+  return width;
+}
+
+void DisplayManager::refreshStartupTextWidth() {
+  // startup_text is edited in place - drop the width of the previous content
+  widthCache.invalidate(u8g2_font_luRS18_tr, startupTextHash);
+
+  const char* startupText = WiFiConfig::getStartupText();
+  startupTextRevision = WiFiConfig::getStartupTextRevision();
+  startupTextHash = TextWidthCache::hash(startupText);
+  startupTextPixelWidth = measureText(u8g2_font_luRS18_tr, startupText);
+
+  LOG_DISPLAY("Startup text: \"%s\"", startupText);
+  LOG_DISPLAY("Text length: %d chars, width: %d pixels", strlen(startupText), startupTextPixelWidth);
 }
 
 void DisplayManager::showStartup() {
@@ -228,15 +442,9 @@ void DisplayManager::showStartup() {
   // Reset startup scroll state
   // Start with text at left edge (offset 0)
   startupScrollOffset = 0;
-  startupLastScrollUpdate = millis();
+  startupScrollPacer.start(millis());
 
-  // Calculate text width for scrolling
-  // Uses character count estimate: ~15 pixels per char for u8g2_font_luRS18_tr
-  // This is reliable for embedded systems and avoids font metric overhead
-  const char *startupText = WiFiConfig::getStartupText();
-  startupTextPixelWidth = strlen(startupText) * 15;
-  LOG_DISPLAY("Startup text: \"%s\"", startupText);
-  LOG_DISPLAY("Text length: %d chars, estimated width: %d pixels", strlen(startupText), startupTextPixelWidth);
+  refreshStartupTextWidth();
 
   markDirty(true);  // Signal display update needed with clear
 }
@@ -247,8 +455,8 @@ void DisplayManager::showConnectionState(DeviceConnectionState state, const char
 
   // Reset scroll when state changes
   scrollOffset = 0;
-  lastScrollUpdate = millis();
-  textPixelWidth = 0;
+  scrollPacer.start(millis());
+  textPixelWidth = name ? measureText(u8g2_font_helvR10_tf, name) : 0;
 
   switch (state) {
     case DeviceConnectionState::DISCONNECTED:
@@ -278,6 +486,7 @@ void DisplayManager::showCountdown(const SessionData& sessionData) {
   countdownStartTime = millis();
   countdownDurationSeconds = sessionData.startDelaySeconds;
   lastUpdateTime = millis();
+  countdownPacer.start(lastUpdateTime);
   markDirty(true);  // Signal display update needed with clear
   LOG_DISPLAY("Starting countdown: %.1fs", countdownDurationSeconds);
 }
@@ -319,7 +528,10 @@ void DisplayManager::showSessionEnd(const SessionData& sessionData, uint16_t las
 }
 
 void DisplayManager::clearDisplay() {
-  if (display) {
+  if (target == &framebuffer) {
+    // Only clears the composed frame - presentFrame() pushes the difference
+    framebuffer.fillScreen(0);
+  } else if (display) {
     display->clearScreen();
     // display->fillScreen(0); // Black background
   }
@@ -333,7 +545,7 @@ void DisplayManager::clearConnectionDetailLine() {
   const int16_t displayWidth = PANEL_WIDTH * PANEL_CHAIN;
   const int16_t lineTop = 16;   // Covers baseline at y=28 for helvR10 font
   const int16_t lineHeight = 16;
-  display->fillRect(0, lineTop, displayWidth, lineHeight, 0);
+  target->fillRect(0, lineTop, displayWidth, lineHeight, 0);
 }
 
 uint16_t DisplayManager::color565(uint8_t r, uint8_t g, uint8_t b) const {
@@ -351,7 +563,7 @@ void DisplayManager::renderStartupMessage() {
   const int16_t lineTop = 10;
   const int16_t lineHeight = 22;
   const int16_t displayWidth = PANEL_WIDTH * PANEL_CHAIN;
-  display->fillRect(0, lineTop, displayWidth, lineHeight, 0);
+  target->fillRect(0, lineTop, displayWidth, lineHeight, 0);
 
   u8g2_for_adafruit_gfx.setFontMode(1);
   u8g2_for_adafruit_gfx.setFontDirection(0);
@@ -427,13 +639,6 @@ void DisplayManager::renderConnectionStatus() {
 
     u8g2_for_adafruit_gfx.setForegroundColor(DisplayColors::WHITE);
 
-    // Calculate text width if not already done
-    if (textPixelWidth == 0) {
-      // Uses character count estimate: ~10 pixels per char for u8g2_font_helvR10_tf
-      // This is reliable for embedded systems and avoids font metric overhead
-      textPixelWidth = strlen(deviceName) * 10;
-    }
-
     // If text fits on screen, just display it normally
     if (textPixelWidth <= displayWidth - 8)
     {
@@ -505,8 +710,16 @@ void DisplayManager::renderCountdown() {
   u8g2_for_adafruit_gfx.setForegroundColor(countdownColor);
   u8g2_for_adafruit_gfx.setFont(u8g2_font_luRS18_tr);
 
-  // Center the countdown number
-  int16_t textWidth = strlen(timeBuffer) * 18;  // Approximate width
+  // Center the countdown number. Digits share one advance width in this font,
+  // so measure the shape ("0.00" / "00.0") - two cache entries instead of a
+  // new string every refresh evicting the marquee widths
+  char widthPattern[sizeof(timeBuffer)];
+  size_t i = 0;
+  for (; timeBuffer[i]; i++) {
+    widthPattern[i] = (timeBuffer[i] >= '0' && timeBuffer[i] <= '9') ? '0' : timeBuffer[i];
+  }
+  widthPattern[i] = '\0';
+  int16_t textWidth = measureText(u8g2_font_luRS18_tr, widthPattern);
   int16_t xPos = (PANEL_WIDTH * PANEL_CHAIN - textWidth) / 2;
   if (xPos < 0) xPos = 0;
 
@@ -517,20 +730,9 @@ void DisplayManager::renderCountdown() {
 void DisplayManager::renderWaitingForShots() {
   if (!display) return;
 
-  u8g2_for_adafruit_gfx.setFontMode(1);
-  u8g2_for_adafruit_gfx.setFontDirection(0);
-  u8g2_for_adafruit_gfx.setForegroundColor(DisplayColors::WHITE);
-
-  u8g2_for_adafruit_gfx.setFont(u8g2_font_helvR10_tf);
-  u8g2_for_adafruit_gfx.setCursor(0, 12);
-  u8g2_for_adafruit_gfx.print(F("Shots: 0"));
-
-  u8g2_for_adafruit_gfx.setCursor(0, 28);
-  u8g2_for_adafruit_gfx.print(F("Split: 0:00"));
-
-  u8g2_for_adafruit_gfx.setFont(u8g2_font_helvB18_tf);
-  u8g2_for_adafruit_gfx.setCursor(65, 25);
-  u8g2_for_adafruit_gfx.print(F("00:00"));
+  drawText(labelAtlas, u8g2_font_helvR10_tf, 0, 12, "Shots: 0", DisplayColors::WHITE);
+  drawText(labelAtlas, u8g2_font_helvR10_tf, 0, 28, "Split: 0:00", DisplayColors::WHITE);
+  drawText(timeAtlas, u8g2_font_helvB18_tf, 65, 25, "00:00", DisplayColors::WHITE);
 }
 
 void DisplayManager::renderShotData() {
@@ -539,23 +741,15 @@ void DisplayManager::renderShotData() {
   char timeBuffer[16];
   char splitBuffer[16];
   char shotBuffer[32];
+  char splitLine[32];
   formatTime(lastShotData.absoluteTimeMs, timeBuffer, sizeof(timeBuffer));
   formatSplitTime(lastShotData.splitTimeMs, splitBuffer, sizeof(splitBuffer));
-
-  u8g2_for_adafruit_gfx.setFont(u8g2_font_helvR10_tf);
-  u8g2_for_adafruit_gfx.setForegroundColor(DisplayColors::YELLOW);
-  u8g2_for_adafruit_gfx.setCursor(0, 12);
   snprintf(shotBuffer, sizeof(shotBuffer), "Shots: %d", lastShotData.shotNumber);
-  u8g2_for_adafruit_gfx.print(shotBuffer);
-
-  u8g2_for_adafruit_gfx.setCursor(0, 28);
-  u8g2_for_adafruit_gfx.print(F("Split: "));
-  u8g2_for_adafruit_gfx.print(splitBuffer);
+  snprintf(splitLine, sizeof(splitLine), "Split: %s", splitBuffer);
 
-  u8g2_for_adafruit_gfx.setFont(u8g2_font_helvB18_tf);
-  u8g2_for_adafruit_gfx.setForegroundColor(DisplayColors::GREEN);
-  u8g2_for_adafruit_gfx.setCursor(65, 25);
-  u8g2_for_adafruit_gfx.print(timeBuffer);
+  drawText(labelAtlas, u8g2_font_helvR10_tf, 0, 12, shotBuffer, DisplayColors::YELLOW);
+  drawText(labelAtlas, u8g2_font_helvR10_tf, 0, 28, splitLine, DisplayColors::YELLOW);
+  drawText(timeAtlas, u8g2_font_helvB18_tf, 65, 25, timeBuffer, DisplayColors::GREEN);
 }
 
 void DisplayManager::renderSessionEnd() {
@@ -564,20 +758,12 @@ void DisplayManager::renderSessionEnd() {
   char timeBuffer[16];
   char shotBuffer[32];
   formatTime(lastShotData.absoluteTimeMs, timeBuffer, sizeof(timeBuffer));
-
-  u8g2_for_adafruit_gfx.setFont(u8g2_font_helvR10_tf);
-  u8g2_for_adafruit_gfx.setForegroundColor(DisplayColors::RED);
-  u8g2_for_adafruit_gfx.setCursor(0, 12);
-  u8g2_for_adafruit_gfx.print(F("ENDED"));
-
-  u8g2_for_adafruit_gfx.setCursor(0, 28);
   snprintf(shotBuffer, sizeof(shotBuffer), "Shots: %d", lastShotData.shotNumber);
-  u8g2_for_adafruit_gfx.print(shotBuffer);
 
-  u8g2_for_adafruit_gfx.setFont(u8g2_font_helvB18_tf);
-  u8g2_for_adafruit_gfx.setForegroundColor(DisplayColors::RED);
-  u8g2_for_adafruit_gfx.setCursor(65, 25);
-  u8g2_for_adafruit_gfx.print(timeBuffer);
+  // "ENDED" is not in the atlas - drawn through u8g2
+  drawText(labelAtlas, u8g2_font_helvR10_tf, 0, 12, "ENDED", DisplayColors::RED);
+  drawText(labelAtlas, u8g2_font_helvR10_tf, 0, 28, shotBuffer, DisplayColors::RED);
+  drawText(timeAtlas, u8g2_font_helvB18_tf, 65, 25, timeBuffer, DisplayColors::RED);
 }
 
 void DisplayManager::formatTime(uint32_t timeMs, char* buffer, size_t bufferSize) {
@@ -0,0 +1,170 @@
+#include "GlyphAtlas.h"
+#include "Logger.h"
+#include <Adafruit_GFX.h>
+#include <U8g2_for_Adafruit_GFX.h>
+
+GlyphAtlas::GlyphAtlas()
+  : glyphs{},
+    glyphCount(0),
+    bitmapUsed(0),
+    ready(false) {
+  memset(glyphIndex, -1, sizeof(glyphIndex));
+}
+
+bool GlyphAtlas::build(U8G2_FOR_ADAFRUIT_GFX& u8g2, const uint8_t* font, const char* charset) {
+  ready = false;
+  glyphCount = 0;
+  bitmapUsed = 0;
+  memset(glyphIndex, -1, sizeof(glyphIndex));
+
+  GFXcanvas1 canvas(CANVAS_SIZE, CANVAS_SIZE);
+  if (!canvas.getBuffer()) {
+    LOG_ERROR("DISPLAY", "Glyph atlas canvas allocation failed");
+    return false;
+  }
+
+  u8g2.begin(canvas);
+  u8g2.setFont(font);
+  u8g2.setFontMode(1);
+  u8g2.setFontDirection(0);
+  u8g2.setForegroundColor(1);
+
+  for (const char* p = charset; *p; p++) {
+    char c = *p;
+    if ((uint8_t)c >= sizeof(glyphIndex) || glyphIndex[(uint8_t)c] >= 0) {
+      continue;  // Non-ASCII or duplicate
+    }
+    if (glyphCount >= MAX_GLYPHS) {
+      LOG_ERROR("DISPLAY", "Glyph atlas full at '%c'", c);
+      return false;
+    }
+
+    canvas.fillScreen(0);
+    int16_t advance = u8g2.drawGlyph(CANVAS_ORIGIN_X, CANVAS_BASELINE, (uint16_t)c);
+
+    // Trim to the bounding box of lit pixels
+    int16_t minX = CANVAS_SIZE, minY = CANVAS_SIZE, maxX = -1, maxY = -1;
+    for (int16_t y = 0; y < CANVAS_SIZE; y++) {
+      for (int16_t x = 0; x < CANVAS_SIZE; x++) {
+        if (canvas.getPixel(x, y)) {
+          if (x < minX) minX = x;
+          if (x > maxX) maxX = x;
+          if (y < minY) minY = y;
+          if (y > maxY) maxY = y;
+        }
+      }
+    }
+
+    Glyph& g = glyphs[glyphCount];
+    g.advance = (uint8_t)(advance > 0 ? advance : 0);
+    g.bitmapOffset = bitmapUsed;
+
+    if (maxX < 0) {
+      // Blank glyph (space) - advance only
+      g.xOffset = 0;
+      g.yOffset = 0;
+      g.width = 0;
+      g.height = 0;
+    } else {
+      g.xOffset = (int8_t)(minX - CANVAS_ORIGIN_X);
+      g.yOffset = (int8_t)(minY - CANVAS_BASELINE);
+      g.width = (uint8_t)(maxX - minX + 1);
+      g.height = (uint8_t)(maxY - minY + 1);
+
+      size_t rowBytes = (g.width + 7) / 8;
+      size_t glyphBytes = rowBytes * g.height;
+      if (bitmapUsed + glyphBytes > BITMAP_BYTES) {
+        LOG_ERROR("DISPLAY", "Glyph atlas bitmap store full at '%c'", c);
+        return false;
+      }
+
+      uint8_t* dst = &bitmap[bitmapUsed];
+      memset(dst, 0, glyphBytes);
+      for (uint8_t row = 0; row < g.height; row++) {
+        for (uint8_t col = 0; col < g.width; col++) {
+          if (canvas.getPixel(minX + col, minY + row)) {
+            dst[row * rowBytes + (col >> 3)] |= (uint8_t)(0x80 >> (col & 7));
+          }
+        }
+      }
+      bitmapUsed += glyphBytes;
+    }
+
+    glyphIndex[(uint8_t)c] = (int8_t)glyphCount;
+    glyphCount++;
+  }
+
+  ready = true;
+  return true;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::find(char c) const {
+  if ((uint8_t)c >= sizeof(glyphIndex)) {
+    return nullptr;
+  }
+  int8_t idx = glyphIndex[(uint8_t)c];
+  return idx >= 0 ? &glyphs[idx] : nullptr;
+}
+
+bool GlyphAtlas::contains(const char* text) const {
+  if (!ready || !text) {
+    return false;
+  }
+  for (const char* p = text; *p; p++) {
+    if (!find(*p)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int16_t GlyphAtlas::draw(Adafruit_GFX* target, int16_t x, int16_t y,
+                         const char* text, uint16_t color) const {
+  if (!target || !text) {
+    return x;
+  }
+
+  for (const char* p = text; *p; p++) {
+    const Glyph* g = find(*p);
+    if (!g) {
+      continue;
+    }
+
+    const uint8_t* src = &bitmap[g->bitmapOffset];
+    const size_t rowBytes = (g->width + 7) / 8;
+    const int16_t left = x + g->xOffset;
+    const int16_t top = y + g->yOffset;
+
+    // Emit each row as horizontal runs - one target write per run
+    for (uint8_t row = 0; row < g->height; row++) {
+      const uint8_t* bits = src + row * rowBytes;
+      int16_t runStart = -1;
+      for (uint8_t col = 0; col <= g->width; col++) {
+        bool lit = col < g->width && (bits[col >> 3] & (0x80 >> (col & 7)));
+        if (lit && runStart < 0) {
+          runStart = col;
+        } else if (!lit && runStart >= 0) {
+          target->drawFastHLine(left + runStart, top + row, col - runStart, color);
+          runStart = -1;
+        }
+      }
+    }
+
+    x += g->advance;
+  }
+  return x;
+}
+
+int16_t GlyphAtlas::getTextWidth(const char* text) const {
+  int16_t width = 0;
+  if (!text) {
+    return width;
+  }
+  for (const char* p = text; *p; p++) {
+    const Glyph* g = find(*p);
+    if (g) {
+      width += g->advance;
+    }
+  }
+  return width;
+}
@@ -0,0 +1,128 @@
+#include "LittleFsSpillStore.h"
+#include "Logger.h"
+#include <LittleFS.h>
+
+LittleFsSpillStore::LittleFsSpillStore(uint32_t maxBytes)
+  : maxRecords((maxBytes > sizeof(Header) ? maxBytes - sizeof(Header) : 0) / sizeof(JournalRecord)),
+    totalRecords(0),
+    readIndex(0),
+    mounted(false) {
+}
+
+bool LittleFsSpillStore::begin() {
+  if (!LittleFS.begin(/*formatOnFail=*/true)) {
+    LOG_ERROR("JOURNAL", "LittleFS mount failed - journal spill disabled");
+    return false;
+  }
+  mounted = true;
+
+  if (!LittleFS.exists(PATH)) {
+    return true;
+  }
+
+  // Resume a spill left over from before a reset
+  File f = LittleFS.open(PATH, "r");
+  Header header = {};
+  bool valid = f && f.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header) &&
+               header.magic == MAGIC && header.version == VERSION &&
+               header.recordSize == sizeof(JournalRecord);
+  if (valid) {
+    totalRecords = (uint32_t)((f.size() - sizeof(Header)) / sizeof(JournalRecord));
+    readIndex = header.readIndex <= totalRecords ? header.readIndex : totalRecords;
+  }
+  if (f) {
+    f.close();
+  }
+
+  if (!valid || count() == 0) {
+    clear();
+  } else {
+    LOG_SYSTEM("Journal spill: %lu unpublished shots recovered from flash", (unsigned long)count());
+  }
+  return true;
+}
+
+bool LittleFsSpillStore::writeHeader() {
+  File f = LittleFS.open(PATH, "r+");
+  if (!f) {
+    return false;
+  }
+  Header header = { MAGIC, VERSION, (uint16_t)sizeof(JournalRecord), readIndex };
+  bool ok = f.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header);
+  f.close();
+  return ok;
+}
+
+bool LittleFsSpillStore::append(const JournalRecord* records, uint32_t n) {
+  if (!mounted || n == 0 || count() + n > maxRecords) {
+    return false;
+  }
+
+  if (totalRecords == 0) {
+    // New segment - header first so the write below only ever extends a valid file
+    File f = LittleFS.open(PATH, "w");
+    if (!f) {
+      return false;
+    }
+    Header header = { MAGIC, VERSION, (uint16_t)sizeof(JournalRecord), 0 };
+    bool ok = f.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header);
+    f.close();
+    if (!ok) {
+      return false;
+    }
+    readIndex = 0;
+  }
+
+  // Write right after the last whole record rather than appending: a partial
+  // write leaves a torn record at the end of the file, and the next append
+  // must overwrite it or every later record would be read at the wrong offset.
+  // (The size-derived count in begin() already ignores a torn tail.)
+  File f = LittleFS.open(PATH, "r+");
+  if (!f) {
+    return false;
+  }
+  const size_t bytes = (size_t)n * sizeof(JournalRecord);
+  size_t written = 0;
+  if (f.seek(sizeof(Header) + (size_t)totalRecords * sizeof(JournalRecord))) {
+    written = f.write(reinterpret_cast<const uint8_t*>(records), bytes);
+  }
+  f.close();
+
+  totalRecords += (uint32_t)(written / sizeof(JournalRecord));
+  return written == bytes;
+}
+
+uint32_t LittleFsSpillStore::read(JournalRecord* out, uint32_t max) {
+  const uint32_t n = count() < max ? count() : max;
+  if (!mounted || n == 0) {
+    return 0;
+  }
+
+  File f = LittleFS.open(PATH, "r");
+  if (!f) {
+    return 0;
+  }
+  size_t got = 0;
+  if (f.seek(sizeof(Header) + (size_t)readIndex * sizeof(JournalRecord))) {
+    got = f.read(reinterpret_cast<uint8_t*>(out), (size_t)n * sizeof(JournalRecord));
+  }
+  f.close();
+  return (uint32_t)(got / sizeof(JournalRecord));
+}
+
+void LittleFsSpillStore::consume(uint32_t n) {
+  readIndex = (n < count()) ? readIndex + n : totalRecords;
+  if (count() == 0) {
+    clear();
+  } else if (!writeHeader()) {
+    LOG_WARN("JOURNAL", "Failed to persist spill read position");
+  }
+}
+
+void LittleFsSpillStore::clear() {
+  if (mounted && LittleFS.exists(PATH)) {
+    LittleFS.remove(PATH);
+  }
+  totalRecords = 0;
+  readIndex = 0;
+}
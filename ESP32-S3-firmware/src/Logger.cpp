@@ -1,63 +1,422 @@
 #include "Logger.h"
+#include "MpscRing.h"
 #include <stdarg.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 
 LogLevel Logger::currentLevel = LogLevel::INFO;
 
-void Logger::setLevel(LogLevel level) {
-  currentLevel = level;
+namespace {
+
+using LogFormat::ArgKind;
+using LogFormat::ArgValue;
+using LogFormat::Conversion;
+
+constexpr size_t MESSAGE_SIZE = 256;              // Longest message text (both modes)
+constexpr size_t LINE_SIZE = MESSAGE_SIZE + 64;   // Plus timestamp, level and component prefix
+constexpr size_t RECORD_ARG_BYTES = 100;          // Packed arguments per deferred line
+constexpr size_t RING_SIZE = 64;                  // Deferred lines (must be power of 2), ~8 KB heap
+constexpr size_t MAX_HEX_BYTES = 32;              // logHex() shows at most this many bytes
+
+// Room for the message after a prefix of `used` bytes
+size_t messageRoom(size_t used) {
+  return (LINE_SIZE - used < MESSAGE_SIZE) ? LINE_SIZE - used : MESSAGE_SIZE;
+}
+
+// One deferred (or binary) log() call
+struct LogRecord {
+  uint32_t timestampMs;
+  uint32_t tagHash;
+  const char* component;
+  const char* format;
+  LogLevel level;
+  uint8_t argLength;  // Bytes used in args
+  uint8_t argCount;   // Conversions packed - fewer than the format has means args ran out of room
+  uint8_t args[RECORD_ARG_BYTES];
+};
+
+typedef MpscRing<LogRecord, RING_SIZE> LogRing;
+
+std::atomic<LogRing*> deferredRing(nullptr);  // Set while deferred mode is running
+TaskHandle_t drainTask = nullptr;
+SemaphoreHandle_t drainMutex = nullptr;       // One consumer at a time (drain task or flush())
+std::atomic<uint32_t> droppedLines(0);
+uint32_t reportedDrops = 0;                   // Consumer side
+
+template <typename T>
+bool packValue(LogRecord& record, T value) {
+  if (record.argLength + sizeof(T) > RECORD_ARG_BYTES) {
+    return false;
+  }
+  memcpy(record.args + record.argLength, &value, sizeof(T));
+  record.argLength += sizeof(T);
+  return true;
 }
 
-const char* Logger::getLevelString(LogLevel level) {
-  switch (level) {
-    case LogLevel::DEBUG: return "DEBUG";
-    case LogLevel::INFO:  return "INFO ";
-    case LogLevel::WARN:  return "WARN ";
-    case LogLevel::ERROR: return "ERROR";
-    default: return "UNKNOWN";
+// Strings are copied (length byte + text, truncated to the room left) -
+// the caller's buffer is usually gone by the time the line is printed
+bool packString(LogRecord& record, const char* text) {
+  if (!text) {
+    text = "(null)";
+  }
+  size_t room = RECORD_ARG_BYTES - record.argLength;
+  if (room < 1) {
+    return false;
+  }
+  size_t length = strnlen(text, room - 1);
+  record.args[record.argLength++] = (uint8_t)length;
+  memcpy(record.args + record.argLength, text, length);
+  record.argLength += length;
+  return true;
+}
+
+// Walks record.format and packs the matching arguments by value. Stops at
+// the first one that does not fit; the printed message is cut there.
+void packArgs(LogRecord& record, va_list args) {
+  record.argLength = 0;
+  record.argCount = 0;
+
+  const char* p = record.format;
+  while (*p) {
+    Conversion conv;
+    if (*p != '%' || !LogFormat::parseConversion(p, conv)) {
+      p++;
+      continue;
+    }
+    p = conv.end;
+    if (conv.kind == ArgKind::NONE) {
+      continue;
+    }
+
+    bool packed = true;
+    for (uint8_t i = 0; i < conv.stars && packed; i++) {
+      packed = packValue(record, va_arg(args, int));
+    }
+    if (packed) {
+      switch (conv.kind) {
+        case ArgKind::INT:         packed = packValue(record, va_arg(args, int)); break;
+        case ArgKind::LONG:        packed = packValue(record, va_arg(args, long)); break;
+        case ArgKind::LONG_LONG:   packed = packValue(record, va_arg(args, long long)); break;
+        case ArgKind::SIZE:        packed = packValue(record, va_arg(args, size_t)); break;
+        case ArgKind::INTMAX:      packed = packValue(record, va_arg(args, intmax_t)); break;
+        case ArgKind::PTRDIFF:     packed = packValue(record, va_arg(args, ptrdiff_t)); break;
+        case ArgKind::DOUBLE:      packed = packValue(record, va_arg(args, double)); break;
+        case ArgKind::LONG_DOUBLE: packed = packValue(record, va_arg(args, long double)); break;
+        case ArgKind::STRING:      packed = packString(record, va_arg(args, const char*)); break;
+        case ArgKind::POINTER:     packed = packValue(record, va_arg(args, void*)); break;
+        case ArgKind::NONE:        break;
+      }
+    }
+    if (!packed) {
+      return;
+    }
+    record.argCount++;
   }
 }
 
-const char* Logger::getComponentColor(const char* component) {
-  // Simple hash to assign consistent colors to components
-  uint32_t hash = 0;
-  for (const char* p = component; *p; p++) {
-    hash = hash * 31 + *p;
+// Argument source over a record's packed arguments (see LogFormat::formatMessage)
+class RecordArgs {
+public:
+  explicit RecordArgs(const LogRecord& record)
+    : cursor(record.args), remaining(record.argCount) {}
+
+  bool next(const Conversion& conv, int* stars, ArgValue& value) {
+    if (remaining == 0) {
+      return false;
+    }
+    remaining--;
+    for (uint8_t i = 0; i < conv.stars; i++) {
+      stars[i] = read<int>();
+    }
+    value = ArgValue();
+    switch (conv.kind) {
+      case ArgKind::INT:         loadInteger<int>(value); break;
+      case ArgKind::LONG:        loadInteger<long>(value); break;
+      case ArgKind::LONG_LONG:   loadInteger<long long>(value); break;
+      case ArgKind::SIZE:        loadInteger<size_t>(value); break;
+      case ArgKind::INTMAX:      loadInteger<intmax_t>(value); break;
+      case ArgKind::PTRDIFF:     loadInteger<ptrdiff_t>(value); break;
+      case ArgKind::DOUBLE:      value.real = read<double>(); break;
+      case ArgKind::LONG_DOUBLE: value.real = read<long double>(); break;
+      case ArgKind::POINTER:     value.u = (uintptr_t)read<void*>(); break;
+      case ArgKind::STRING:
+        value.length = *cursor++;
+        value.text = (const char*)cursor;
+        cursor += value.length;
+        break;
+      case ArgKind::NONE:
+        break;
+    }
+    return true;
+  }
+
+private:
+  const uint8_t* cursor;
+  uint8_t remaining;
+
+  template <typename T>
+  T read() {
+    T value;
+    memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+  }
+
+  // Signed and zero-extended forms, so either kind of conversion gets the device's value
+  template <typename T>
+  void loadInteger(ArgValue& value) {
+    T raw = read<T>();
+    value.i = (int64_t)raw;
+    value.u = (uint64_t)(typename std::make_unsigned<T>::type)raw;
+  }
+};
+
+#if LOG_BINARY_OUTPUT
+// Binary frame for a record (layout in LogFormat.h); returns its length
+size_t encodeFrame(const LogRecord& record, uint8_t* frame) {
+  uint8_t* body = frame + 3;
+  const uint8_t* end = body + LogFormat::MAX_FRAME_BODY;
+  LogFormat::putU32(body, record.timestampMs);
+  body[4] = (uint8_t)record.level;
+  LogFormat::putU32(body + 5, (uint32_t)(uintptr_t)record.component);
+  LogFormat::putU32(body + 9, (uint32_t)(uintptr_t)record.format);
+
+  uint8_t* p = body + LogFormat::FRAME_HEADER_BYTES;
+  uint8_t count = 0;
+  RecordArgs source(record);
+  for (const char* f = record.format; *f;) {
+    Conversion conv;
+    if (*f != '%' || !LogFormat::parseConversion(f, conv)) {
+      f++;
+      continue;
+    }
+    f = conv.end;
+    if (conv.kind == ArgKind::NONE) {
+      continue;
+    }
+    int stars[2] = {0, 0};
+    ArgValue value;
+    uint8_t* mark = p;
+    if (!source.next(conv, stars, value) || !LogFormat::putArg(p, end, conv, stars, value)) {
+      p = mark;
+      break;
+    }
+    count++;
   }
+  body[13] = count;
 
-  // Return ANSI color codes based on hash
-  switch (hash % 6) {
-    case 0: return "\033[36m"; // Cyan
-    case 1: return "\033[33m"; // Yellow
-    case 2: return "\033[35m"; // Magenta
-    case 3: return "\033[32m"; // Green
-    case 4: return "\033[34m"; // Blue
-    case 5: return "\033[31m"; // Red
-    default: return "\033[37m"; // White
+  size_t length = p - body;
+  uint8_t check = 0;
+  for (size_t i = 0; i < length; i++) {
+    check ^= body[i];
   }
+  frame[0] = LogFormat::FRAME_SYNC_0;
+  frame[1] = LogFormat::FRAME_SYNC_1;
+  frame[2] = (uint8_t)length;
+  body[length] = check;
+  return length + 4;
+}
+#endif
+
+// Prints one record - a text line, or a binary frame for the host decoder
+void writeRecord(const LogRecord& record) {
+#if LOG_BINARY_OUTPUT
+  uint8_t frame[LogFormat::MAX_FRAME_BODY + 4];
+  size_t length = encodeFrame(record, frame);
+  Serial.write(frame, length);
+#else
+  char line[LINE_SIZE];
+  size_t length = LogFormat::formatPrefix(line, sizeof(line), record.timestampMs, record.level,
+                                          record.component, record.tagHash);
+  RecordArgs source(record);
+  LogFormat::formatMessage(record.format, source, line + length, messageRoom(length));
+  Serial.println(line);
+#endif
+}
+
+void fillRecord(LogRecord& record, LogLevel level, LogTag tag, const char* format) {
+  record.timestampMs = millis();
+  record.tagHash = tag.hash;
+  record.component = tag.name;
+  record.format = format;
+  record.level = level;
+  record.argLength = 0;
+  record.argCount = 0;
+}
+
+}  // namespace
+
+void Logger::setLevel(LogLevel level) {
+  currentLevel = level;
+}
+
+void Logger::log(LogLevel level, LogTag tag, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  vlog(level, tag, format, args);
+  va_end(args);
 }
 
 void Logger::log(LogLevel level, const char* component, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  vlog(level, LogTag{component, LogFormat::hashTag(component)}, format, args);
+  va_end(args);
+}
+
+void Logger::vlog(LogLevel level, LogTag tag, const char* format, va_list args) {
   if (level < currentLevel) {
     return;
   }
 
-  // Print timestamp
-  Serial.printf("[%8lu] ", millis());
+  // Deferred: record the call and let the drain task format it.
+  // Binary output records it too, and writes the record instead of text.
+  LogRing* ring = deferredRing.load(std::memory_order_acquire);
+  if (ring || LOG_BINARY_OUTPUT) {
+    LogRecord record;
+    fillRecord(record, level, tag, format);
+    packArgs(record, args);
 
-  // Print level with color
-  const char* levelColor = (level == LogLevel::ERROR) ? "\033[31m" :
-                          (level == LogLevel::WARN) ? "\033[33m" : "\033[37m";
-  Serial.printf("%s%s\033[0m ", levelColor, getLevelString(level));
+    if (!ring) {
+      writeRecord(record);
+    } else if (!ring->push(record)) {
+      droppedLines++;
+    } else {
+      xTaskNotifyGive(drainTask);
+    }
+    return;
+  }
 
-  // Print component with color
-  Serial.printf("%s%-10s\033[0m ", getComponentColor(component), component);
+  char line[LINE_SIZE];
+  size_t length = LogFormat::formatPrefix(line, sizeof(line), millis(), level, tag.name, tag.hash);
 
   // Print the actual message
-  va_list args;
-  va_start(args, format);
-  char buffer[256];
-  vsnprintf(buffer, sizeof(buffer), format, args);
-  va_end(args);
+  vsnprintf(line + length, messageRoom(length), format, args);
+  Serial.println(line);
+}
+
+void Logger::logHex(LogLevel level, LogTag tag, const char* label, const uint8_t* data,
+                    size_t length) {
+  static const char DIGITS[] = "0123456789ABCDEF";
+  char hex[MAX_HEX_BYTES * 3 + 4];
+  size_t pos = 0;
+  size_t shown = length < MAX_HEX_BYTES ? length : MAX_HEX_BYTES;
+  for (size_t i = 0; i < shown; i++) {
+    hex[pos++] = DIGITS[data[i] >> 4];
+    hex[pos++] = DIGITS[data[i] & 0x0F];
+    hex[pos++] = ' ';
+  }
+  if (shown < length) {
+    memcpy(hex + pos, "...", 3);
+    pos += 3;
+  } else if (pos > 0) {
+    pos--;  // Trailing space
+  }
+  hex[pos] = '\0';
+
+  log(level, tag, "%s (%u bytes): %s", label, (unsigned)length, hex);
+}
+
+bool Logger::startDeferred(BaseType_t core, UBaseType_t priority, uint32_t stackSize) {
+  if (deferredRing.load()) {
+    return true;
+  }
+
+  drainMutex = xSemaphoreCreateMutex();
+  LogRing* ring = new (std::nothrow) LogRing();
+  if (!drainMutex || !ring) {
+    LOG_ERROR("LOGGER", "Failed to allocate deferred log ring");
+    delete ring;
+    if (drainMutex) {
+      vSemaphoreDelete(drainMutex);
+      drainMutex = nullptr;
+    }
+    return false;
+  }
+
+  BaseType_t result = xTaskCreatePinnedToCore(drainTaskEntry, "logDrain", stackSize, nullptr,
+                                              priority, &drainTask, core);
+  if (result != pdPASS) {
+    LOG_ERROR("LOGGER", "Failed to create log drain task");
+    drainTask = nullptr;
+    delete ring;
+    vSemaphoreDelete(drainMutex);
+    drainMutex = nullptr;
+    return false;
+  }
+
+  deferredRing.store(ring, std::memory_order_release);
+  LOG_INFO("LOGGER", "Deferred logging on core %d (priority %u, %u lines)",
+           (int)core, (unsigned)priority, (unsigned)RING_SIZE);
+  return true;
+}
+
+void Logger::stopDeferred() {
+  LogRing* ring = deferredRing.load();
+  if (!ring) {
+    return;
+  }
+
+  flush();
+  deferredRing.store(nullptr, std::memory_order_release);
+
+  // Holding the mutex keeps the drain task from being deleted mid-line
+  xSemaphoreTake(drainMutex, portMAX_DELAY);
+  vTaskDelete(drainTask);
+  drainTask = nullptr;
+  xSemaphoreGive(drainMutex);
+  vSemaphoreDelete(drainMutex);
+  drainMutex = nullptr;
+  delete ring;
+}
+
+bool Logger::isDeferred() {
+  return deferredRing.load() != nullptr;
+}
+
+void Logger::flush() {
+  drain();
+}
+
+uint32_t Logger::getDroppedCount() {
+  return droppedLines.load();
+}
+
+void Logger::drain() {
+  LogRing* ring = deferredRing.load(std::memory_order_acquire);
+  if (!ring) {
+    return;
+  }
+
+  xSemaphoreTake(drainMutex, portMAX_DELAY);
 
-  Serial.println(buffer);
-}
\ No newline at end of file
+  LogRecord record;
+  while (ring->pop(record)) {
+    writeRecord(record);
+  }
+
+  // Report lines lost to a full ring once they have been counted
+  uint32_t dropped = droppedLines.load();
+  if (dropped != reportedDrops) {
+    if (isEnabled(LogLevel::WARN)) {
+      fillRecord(record, LogLevel::WARN, LOG_TAG_OF("LOGGER"), "%lu log lines dropped (ring full)");
+      packValue(record, (unsigned long)(dropped - reportedDrops));
+      record.argCount = 1;
+      writeRecord(record);
+    }
+    reportedDrops = dropped;
+  }
+
+  xSemaphoreGive(drainMutex);
+}
+
+void Logger::drainTaskEntry(void* /*param*/) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    drain();
+  }
+}
@@ -0,0 +1,68 @@
+#include "LoopScheduler.h"
+
+LoopScheduler::LoopScheduler()
+  : taskHandle(nullptr),
+    nextDelayMs(NO_DEADLINE),
+    statsWindowStart(0) {
+}
+
+void LoopScheduler::bind() {
+  taskHandle = xTaskGetCurrentTaskHandle();
+  statsWindowStart = millis();
+}
+
+void LoopScheduler::signal(uint32_t events) {
+  if (taskHandle) {
+    xTaskNotify(taskHandle, events, eSetBits);
+  }
+}
+
+void IRAM_ATTR LoopScheduler::signalFromISR(uint32_t events) {
+  if (!taskHandle) {
+    return;
+  }
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  xTaskNotifyFromISR(taskHandle, events, eSetBits, &higherPriorityTaskWoken);
+  if (higherPriorityTaskWoken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+void LoopScheduler::scheduleIn(uint32_t delayMs) {
+  if (delayMs < nextDelayMs) {
+    nextDelayMs = delayMs;
+  }
+}
+
+uint32_t LoopScheduler::wait(uint32_t maxWaitMs) {
+  uint32_t timeoutMs = (nextDelayMs < maxWaitMs) ? nextDelayMs : maxWaitMs;
+  nextDelayMs = NO_DEADLINE;
+
+  uint32_t events = 0;
+  // Clear all bits on exit so each producer signal causes at most one extra pass
+  xTaskNotifyWait(0, UINT32_MAX, &events, pdMS_TO_TICKS(timeoutMs));
+
+  stats.wakes++;
+  if (events != 0) {
+    stats.eventWakes++;
+  } else {
+    stats.deadlineWakes++;
+  }
+  return events;
+}
+
+void LoopScheduler::sleepFixed(uint32_t delayMs) {
+  nextDelayMs = NO_DEADLINE;
+  vTaskDelay(pdMS_TO_TICKS(delayMs));
+  stats.wakes++;
+  stats.deadlineWakes++;
+}
+
+LoopScheduler::Stats LoopScheduler::takeStats() {
+  unsigned long now = millis();
+  Stats result = stats;
+  result.windowMs = now - statsWindowStart;
+  stats = Stats();
+  statsWindowStart = now;
+  return result;
+}
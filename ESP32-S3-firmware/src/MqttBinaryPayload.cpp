@@ -0,0 +1,120 @@
+#include "MqttBinaryPayload.h"
+
+namespace MqttBinaryPayload {
+
+namespace {
+void header(MsgPackWriter& w, uint16_t fields) {
+  w.byte(SCHEMA_VERSION);
+  w.map(fields);
+}
+
+void optionalString(MsgPackWriter& w, uint8_t key, const char* value) {
+  if (value) {
+    w.uint(key);
+    w.str(value);
+  }
+}
+}
+
+void encodeShot(MsgPackWriter& w, const NormalizedShotData& shot, uint32_t seq, uint32_t timestamp) {
+  header(w, seq ? 8 : 7);
+  w.uint(Key::SESSION_ID);       w.uint(shot.sessionId);
+  w.uint(Key::SHOT_NUMBER);      w.uint(shot.shotNumber);
+  w.uint(Key::ABSOLUTE_TIME_MS); w.uint(shot.absoluteTimeMs);
+  w.uint(Key::SPLIT_TIME_MS);    w.uint(shot.splitTimeMs);
+  w.uint(Key::DEVICE_MODEL);     w.str(shot.deviceModel[0] ? shot.deviceModel : "unknown");
+  w.uint(Key::IS_FIRST_SHOT);    w.boolean(shot.isFirstShot);
+  w.uint(Key::TIMESTAMP);        w.uint(timestamp);
+  if (seq) {
+    w.uint(Key::SEQ);            w.uint(seq);
+  }
+}
+
+void encodeConnectionState(MsgPackWriter& w, const char* state, const char* deviceName,
+                           const char* deviceModel, uint32_t timestamp) {
+  header(w, 2 + (deviceName ? 1 : 0) + (deviceModel ? 1 : 0));
+  w.uint(Key::STATE); w.str(state);
+  optionalString(w, Key::DEVICE_NAME, deviceName);
+  optionalString(w, Key::DEVICE_MODEL, deviceModel);
+  w.uint(Key::TIMESTAMP); w.uint(timestamp);
+}
+
+void encodeDeviceInfo(MsgPackWriter& w, const char* deviceName, const char* deviceModel,
+                      const char* firmwareVersion, const char* deviceId, uint32_t timestamp) {
+  header(w, 2 + (deviceName ? 1 : 0) + (deviceModel ? 1 : 0) + (firmwareVersion ? 1 : 0));
+  optionalString(w, Key::DEVICE_NAME, deviceName);
+  optionalString(w, Key::DEVICE_MODEL, deviceModel);
+  optionalString(w, Key::FIRMWARE_VERSION, firmwareVersion);
+  w.uint(Key::DEVICE_ID); w.str(deviceId);
+  w.uint(Key::TIMESTAMP); w.uint(timestamp);
+}
+
+void encodeSessionStarted(MsgPackWriter& w, uint32_t sessionId, float startDelaySeconds, uint32_t timestamp) {
+  header(w, 3);
+  w.uint(Key::SESSION_ID);          w.uint(sessionId);
+  w.uint(Key::START_DELAY_SECONDS); w.float32(startDelaySeconds);
+  w.uint(Key::TIMESTAMP);           w.uint(timestamp);
+}
+
+void encodeSessionStopped(MsgPackWriter& w, uint32_t sessionId, uint16_t totalShots,
+                          uint32_t lastShotTimeMs, uint32_t timestamp) {
+  header(w, lastShotTimeMs > 0 ? 4 : 3);
+  w.uint(Key::SESSION_ID);  w.uint(sessionId);
+  w.uint(Key::TOTAL_SHOTS); w.uint(totalShots);
+  if (lastShotTimeMs > 0) {
+    w.uint(Key::LAST_SHOT_TIME_MS); w.uint(lastShotTimeMs);
+  }
+  w.uint(Key::TIMESTAMP);   w.uint(timestamp);
+}
+
+void encodeSessionEvent(MsgPackWriter& w, uint32_t sessionId, uint32_t timestamp) {
+  header(w, 2);
+  w.uint(Key::SESSION_ID); w.uint(sessionId);
+  w.uint(Key::TIMESTAMP);  w.uint(timestamp);
+}
+
+size_t beginShotBatch(MsgPackWriter& w, uint32_t sessionId, const char* deviceModel) {
+  header(w, 3);
+  w.uint(Key::SESSION_ID);   w.uint(sessionId);
+  w.uint(Key::DEVICE_MODEL); w.str(deviceModel && deviceModel[0] ? deviceModel : "unknown");
+  w.uint(Key::SHOTS);
+  return w.array16();
+}
+
+void addShotBatchRecord(MsgPackWriter& w, const NormalizedShotData& shot, uint32_t seq, uint32_t timestamp) {
+  w.array(6);
+  w.uint(seq);
+  w.uint(shot.shotNumber);
+  w.uint(shot.absoluteTimeMs);
+  w.uint(shot.splitTimeMs);
+  w.uint(timestamp);
+  w.uint(shot.isFirstShot ? 1 : 0);
+}
+
+void finishShotBatch(MsgPackWriter& w, size_t countOffset, uint16_t count) {
+  w.patchArray16(countOffset, count);
+}
+
+void beginLatency(MsgPackWriter& w, uint16_t stageCount) {
+  header(w, 2);
+  w.uint(Key::STAGES);
+  w.map(stageCount);
+}
+
+void addLatencyStage(MsgPackWriter& w, const char* name, uint32_t n, uint32_t minUs,
+                     uint32_t avgUs, uint32_t p99Us, uint32_t maxUs) {
+  w.str(name);
+  w.array(5);
+  w.uint(n);
+  w.uint(minUs);
+  w.uint(avgUs);
+  w.uint(p99Us);
+  w.uint(maxUs);
+}
+
+void finishLatency(MsgPackWriter& w, uint32_t timestamp) {
+  w.uint(Key::TIMESTAMP);
+  w.uint(timestamp);
+}
+
+}  // namespace MqttBinaryPayload
@@ -0,0 +1,63 @@
+#include "MqttJsonPayload.h"
+
+namespace MqttJsonPayload {
+
+void encodeConnectionState(JsonWriter& w, const char* state, const char* deviceName,
+                           const char* deviceModel, uint32_t timestamp) {
+  w.object(jsonField("state", state),
+           jsonFieldIfSet("deviceName", deviceName),
+           jsonFieldIfSet("deviceModel", deviceModel),
+           jsonField("timestamp", timestamp));
+}
+
+void encodeDeviceInfo(JsonWriter& w, const char* deviceName, const char* deviceModel,
+                      const char* firmwareVersion, const char* deviceId, uint32_t timestamp) {
+  w.object(jsonFieldIfSet("deviceName", deviceName),
+           jsonFieldIfSet("deviceModel", deviceModel),
+           jsonFieldIfSet("firmwareVersion", firmwareVersion),
+           jsonField("deviceId", deviceId),
+           jsonField("timestamp", timestamp));
+}
+
+void encodeSessionStarted(JsonWriter& w, uint32_t sessionId, float startDelaySeconds, uint32_t timestamp) {
+  w.object(jsonField("sessionId", sessionId),
+           jsonField("startDelaySeconds", startDelaySeconds),
+           jsonField("timestamp", timestamp));
+}
+
+void encodeSessionStopped(JsonWriter& w, uint32_t sessionId, uint16_t totalShots,
+                          uint32_t lastShotTimeMs, uint32_t timestamp) {
+  w.object(jsonField("sessionId", sessionId),
+           jsonField("totalShots", totalShots),
+           jsonFieldIf(lastShotTimeMs > 0, "lastShotTimeMs", lastShotTimeMs),
+           jsonField("timestamp", timestamp));
+}
+
+void encodeSessionEvent(JsonWriter& w, uint32_t sessionId, uint32_t timestamp) {
+  w.object(jsonField("sessionId", sessionId),
+           jsonField("timestamp", timestamp));
+}
+
+void beginLatency(JsonWriter& w) {
+  w.beginObject();
+  w.key("stages");
+  w.beginObject();
+}
+
+void addLatencyStage(JsonWriter& w, const char* name, uint32_t n, uint32_t minUs,
+                     uint32_t avgUs, uint32_t p99Us, uint32_t maxUs) {
+  w.dynamicKey(name);
+  w.object(jsonField("n", n),
+           jsonField("minUs", minUs),
+           jsonField("avgUs", avgUs),
+           jsonField("p99Us", p99Us),
+           jsonField("maxUs", maxUs));
+}
+
+void finishLatency(JsonWriter& w, uint32_t timestamp) {
+  w.endObject();
+  w.fields(jsonField("timestamp", timestamp));
+  w.endObject();
+}
+
+}  // namespace MqttJsonPayload
@@ -1,10 +1,12 @@
 #include "MqttManager.h"
 #include "WiFiConfig.h"
 #include "DeviceId.h"
+#include "ShotTrace.h"
+#include "MqttBinaryPayload.h"
+#include "MqttJsonPayload.h"
 #include "common.h"
 #include <WiFi.h>
 #include <PubSubClient.h>
-#include <ArduinoJson.h>
 
 // Global static for PubSubClient (required for callback)
 static WiFiClient espClient;
@@ -13,6 +15,21 @@ static PubSubClient mqttClient(espClient);
 // Connection state strings for MQTT - static to avoid repeated string construction
 // (Topic strings are built per-device in buildTopics())
 
+// Event topic suffixes under timer/<deviceId>/
+namespace TopicSuffix {
+  const char* PRESENCE           = "presence";
+  const char* CONNECTION_STATE   = "connection/state";
+  const char* DEVICE_INFO        = "device/info";
+  const char* SESSION_STARTED    = "session/started";
+  const char* SESSION_STOPPED    = "session/stopped";
+  const char* SESSION_SUSPENDED  = "session/suspended";
+  const char* SESSION_RESUMED    = "session/resumed";
+  const char* SHOT_DETECTED      = "shot/detected";
+  const char* SHOT_BATCH         = "shot/batch";
+  const char* COUNTDOWN_COMPLETE = "countdown/complete";
+  const char* SHOT_LATENCY       = "diagnostics/latency";
+}
+
 namespace ConnectionStates {
   const char* DISCONNECTED = "DISCONNECTED";
   const char* SCANNING = "SCANNING";
@@ -41,7 +58,11 @@ static const char* connectionStateToString(DeviceConnectionState state) {
 MqttManager::MqttManager()
   : mqttConnected(false),
     wifiWasConnected(false),
-    lastMqttCheck(0) {
+    lastMqttCheck(0),
+    batchLength(0),
+    batchCount(0),
+    batchSessionId(0),
+    batchCountOffset(0) {
   // Zero-initialise all topic buffers
   memset(topicPresence, 0, sizeof(topicPresence));
   memset(topicConnectionState, 0, sizeof(topicConnectionState));
@@ -51,7 +72,10 @@ MqttManager::MqttManager()
   memset(topicSessionSuspended, 0, sizeof(topicSessionSuspended));
   memset(topicSessionResumed, 0, sizeof(topicSessionResumed));
   memset(topicShotDetected, 0, sizeof(topicShotDetected));
+  memset(topicShotBatch, 0, sizeof(topicShotBatch));
   memset(topicCountdownComplete, 0, sizeof(topicCountdownComplete));
+  memset(topicShotLatency, 0, sizeof(topicShotLatency));
+  memset(sourceTopic, 0, sizeof(sourceTopic));
   memset(mqttClientId, 0, sizeof(mqttClientId));
 }
 
@@ -59,21 +83,29 @@ void MqttManager::buildTopics(const char* devId) {
   // All event topics are scoped under timer/<deviceId>/
   // Retained topics (presence, connection/state, device/info) allow late-joining
   // displays to receive the current state immediately upon subscription.
-  snprintf(topicPresence,        TOPIC_BUFFER_SIZE, "timer/%s/presence",          devId);
-  snprintf(topicConnectionState, TOPIC_BUFFER_SIZE, "timer/%s/connection/state",  devId);
-  snprintf(topicDeviceInfo,      TOPIC_BUFFER_SIZE, "timer/%s/device/info",       devId);
-  snprintf(topicSessionStarted,  TOPIC_BUFFER_SIZE, "timer/%s/session/started",   devId);
-  snprintf(topicSessionStopped,  TOPIC_BUFFER_SIZE, "timer/%s/session/stopped",   devId);
-  snprintf(topicSessionSuspended,TOPIC_BUFFER_SIZE, "timer/%s/session/suspended", devId);
-  snprintf(topicSessionResumed,  TOPIC_BUFFER_SIZE, "timer/%s/session/resumed",   devId);
-  snprintf(topicShotDetected,    TOPIC_BUFFER_SIZE, "timer/%s/shot/detected",     devId);
-  snprintf(topicCountdownComplete,TOPIC_BUFFER_SIZE,"timer/%s/countdown/complete",devId);
+  snprintf(topicPresence,         TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::PRESENCE);
+  snprintf(topicConnectionState,  TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::CONNECTION_STATE);
+  snprintf(topicDeviceInfo,       TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::DEVICE_INFO);
+  snprintf(topicSessionStarted,   TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::SESSION_STARTED);
+  snprintf(topicSessionStopped,   TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::SESSION_STOPPED);
+  snprintf(topicSessionSuspended, TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::SESSION_SUSPENDED);
+  snprintf(topicSessionResumed,   TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::SESSION_RESUMED);
+  snprintf(topicShotDetected,     TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::SHOT_DETECTED);
+  snprintf(topicShotBatch,        TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::SHOT_BATCH);
+  snprintf(topicCountdownComplete,TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::COUNTDOWN_COMPLETE);
+  snprintf(topicShotLatency,      TOPIC_BUFFER_SIZE, "timer/%s/%s", devId, TopicSuffix::SHOT_LATENCY);
   // Unique per-device client ID prevents broker from dropping duplicate connections
   snprintf(mqttClientId, CLIENT_ID_BUFFER_SIZE, "pewpew-%s", devId);
   LOG_DEBUG("MQTT", "Topics built for device: %s", devId);
   LOG_DEBUG("MQTT", "Presence topic: %s", topicPresence);
 }
 
+const char* MqttManager::eventTopic(const char* ownTopic, const char* sourceId, const char* suffix) {
+  if (!sourceId) return ownTopic;
+  snprintf(sourceTopic, TOPIC_BUFFER_SIZE, "timer/%s/%s", sourceId, suffix);
+  return sourceTopic;
+}
+
 void MqttManager::publishPresence(bool online) {
   // Retained + QoS 1 so the broker stores the last value.
   // Any display that subscribes later immediately receives the current state.
@@ -82,6 +114,15 @@ void MqttManager::publishPresence(bool online) {
   LOG_INFO("MQTT", "Presence: %s", payload);
 }
 
+void MqttManager::publishSourcePresence(const char* sourceId, bool online) {
+  // Retained like our own presence, but there is no LWT for a LoRa source:
+  // the receiver publishes "offline" when the source falls silent.
+  const char* payload = online ? "online" : "offline";
+  publishPayload(eventTopic(topicPresence, sourceId, TopicSuffix::PRESENCE),
+                 (const uint8_t*)payload, strlen(payload), /*retain=*/true);
+  LOG_INFO("MQTT", "Presence of %s: %s", sourceId, payload);
+}
+
 MqttManager::~MqttManager() {
   if (mqttConnected) {
     disconnectMqtt();
@@ -108,8 +149,8 @@ bool MqttManager::initialize() {
   // Set MQTT broker details
   mqttClient.setServer(mqttServer, mqttPort);
 
-  // Set a reasonable buffer size for our messages
-  mqttClient.setBufferSize(512);
+  // Room for a full shot batch plus topic and MQTT header
+  mqttClient.setBufferSize(JSON_BUFFER_SIZE + TOPIC_BUFFER_SIZE + 16);
 
   // Shorter socket timeout for faster failure detection
   mqttClient.setSocketTimeout(3);  // 3 seconds
@@ -250,7 +291,23 @@ void MqttManager::update() {
   }
 }
 
-bool MqttManager::publishJson(const char* topic, const char* jsonPayload, bool retain) {
+bool MqttManager::publishJson(const char* topic, const JsonWriter& payload, bool retain) {
+  if (!payload.ok()) {
+    LOG_ERROR("MQTT", "JSON payload buffer overflow for %s", topic);
+    return false;
+  }
+  return publishPayload(topic, reinterpret_cast<const uint8_t*>(payload.c_str()), payload.size(), retain);
+}
+
+bool MqttManager::publishBinary(const char* topic, const MsgPackWriter& payload, bool retain) {
+  if (!payload.ok()) {
+    LOG_ERROR("MQTT", "Binary payload buffer overflow for %s", topic);
+    return false;
+  }
+  return publishPayload(topic, payload.data(), payload.size(), retain);
+}
+
+bool MqttManager::publishPayload(const char* topic, const uint8_t* payload, size_t length, bool retain) {
   // Fast path - check connection status (already cached)
   if (!mqttConnected) {
     return false;
@@ -266,7 +323,7 @@ bool MqttManager::publishJson(const char* topic, const char* jsonPayload, bool r
   // retain=true → broker stores the last value and delivers it immediately
   // to any new subscriber ("late joiners"), enabling displays that power-on
   // after the device to see the current state without any re-publish.
-  if (mqttClient.publish(topic, jsonPayload, retain)) {
+  if (mqttClient.publish(topic, payload, length, retain)) {
     LOG_DEBUG("MQTT", "Published to %s (retain=%s)", topic, retain ? "y" : "n");
     return true;
   }
@@ -275,83 +332,83 @@ bool MqttManager::publishJson(const char* topic, const char* jsonPayload, bool r
   return false;
 }
 
-void MqttManager::publishConnectionState(DeviceConnectionState state, const char* deviceName, const char* deviceModel) {
-  JsonDocument doc;
-  doc["state"] = connectionStateToString(state);
-  if (deviceName) {
-    doc["deviceName"] = deviceName;
-  }
-  if (deviceModel) {
-    doc["deviceModel"] = deviceModel;
-  }
-  doc["timestamp"] = millis();
-
-  serializeJson(doc, jsonBuffer, JSON_BUFFER_SIZE);
+void MqttManager::publishConnectionState(DeviceConnectionState state, const char* deviceName, const char* deviceModel,
+                                         const char* sourceId) {
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeConnectionState(w, connectionStateToString(state), deviceName, deviceModel, millis());
+  publishBinary(eventTopic(topicConnectionState, sourceId, TopicSuffix::CONNECTION_STATE), w, /*retain=*/true);
+#else
+  JsonWriter w = jsonWriter();
+  MqttJsonPayload::encodeConnectionState(w, connectionStateToString(state), deviceName, deviceModel, millis());
   // Retained: displays that connect later see the current BLE connection state.
-  publishJson(topicConnectionState, jsonBuffer, /*retain=*/true);
+  publishJson(eventTopic(topicConnectionState, sourceId, TopicSuffix::CONNECTION_STATE), w, /*retain=*/true);
+#endif
 }
 
 void MqttManager::publishDeviceInfo(const char* deviceName, const char* deviceModel, const char* firmwareVersion) {
-  JsonDocument doc;
-  if (deviceName) {
-    doc["deviceName"] = deviceName;
-  }
-  if (deviceModel) {
-    doc["deviceModel"] = deviceModel;
-  }
-  if (firmwareVersion) {
-    doc["firmwareVersion"] = firmwareVersion;
-  }
-  doc["deviceId"] = deviceId.get().c_str();  // Embed deviceId so displays can identify the source
-  doc["timestamp"] = millis();
-
-  serializeJson(doc, jsonBuffer, JSON_BUFFER_SIZE);
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeDeviceInfo(w, deviceName, deviceModel, firmwareVersion, deviceId.get().c_str(), millis());
+  publishBinary(topicDeviceInfo, w, /*retain=*/true);
+#else
+  JsonWriter w = jsonWriter();
+  // Embed deviceId so displays can identify the source
+  MqttJsonPayload::encodeDeviceInfo(w, deviceName, deviceModel, firmwareVersion, deviceId.get().c_str(), millis());
   // Retained: late-joining displays learn device identity without a re-announce.
-  publishJson(topicDeviceInfo, jsonBuffer, /*retain=*/true);
+  publishJson(topicDeviceInfo, w, /*retain=*/true);
+#endif
 }
 
-void MqttManager::publishSessionStarted(uint32_t sessionId, float startDelaySeconds) {
-  JsonDocument doc;
-  doc["sessionId"] = sessionId;
-  doc["startDelaySeconds"] = startDelaySeconds;
-  doc["timestamp"] = millis();
-
-  serializeJson(doc, jsonBuffer, JSON_BUFFER_SIZE);
-  publishJson(topicSessionStarted, jsonBuffer);  // ephemeral event - not retained
+void MqttManager::publishSessionStarted(uint32_t sessionId, float startDelaySeconds, const char* sourceId) {
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeSessionStarted(w, sessionId, startDelaySeconds, millis());
+  publishBinary(eventTopic(topicSessionStarted, sourceId, TopicSuffix::SESSION_STARTED), w);
+#else
+  JsonWriter w = jsonWriter();
+  MqttJsonPayload::encodeSessionStarted(w, sessionId, startDelaySeconds, millis());
+  publishJson(eventTopic(topicSessionStarted, sourceId, TopicSuffix::SESSION_STARTED), w);  // ephemeral event - not retained
+#endif
 }
 
-void MqttManager::publishSessionStopped(uint32_t sessionId, uint16_t totalShots, uint32_t lastShotTimeMs) {
-  JsonDocument doc;
-  doc["sessionId"] = sessionId;
-  doc["totalShots"] = totalShots;
-  if (lastShotTimeMs > 0) {
-    doc["lastShotTimeMs"] = lastShotTimeMs;
-  }
-  doc["timestamp"] = millis();
-
-  serializeJson(doc, jsonBuffer, JSON_BUFFER_SIZE);
-  publishJson(topicSessionStopped, jsonBuffer);  // ephemeral event - not retained
+void MqttManager::publishSessionStopped(uint32_t sessionId, uint16_t totalShots, uint32_t lastShotTimeMs, const char* sourceId) {
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeSessionStopped(w, sessionId, totalShots, lastShotTimeMs, millis());
+  publishBinary(eventTopic(topicSessionStopped, sourceId, TopicSuffix::SESSION_STOPPED), w);
+#else
+  JsonWriter w = jsonWriter();
+  MqttJsonPayload::encodeSessionStopped(w, sessionId, totalShots, lastShotTimeMs, millis());
+  publishJson(eventTopic(topicSessionStopped, sourceId, TopicSuffix::SESSION_STOPPED), w);  // ephemeral event - not retained
+#endif
 }
 
-void MqttManager::publishSessionSuspended(uint32_t sessionId) {
-  JsonDocument doc;
-  doc["sessionId"] = sessionId;
-  doc["timestamp"] = millis();
-
-  serializeJson(doc, jsonBuffer, JSON_BUFFER_SIZE);
-  publishJson(topicSessionSuspended, jsonBuffer);
+void MqttManager::publishSessionSuspended(uint32_t sessionId, const char* sourceId) {
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeSessionEvent(w, sessionId, millis());
+  publishBinary(eventTopic(topicSessionSuspended, sourceId, TopicSuffix::SESSION_SUSPENDED), w);
+#else
+  JsonWriter w = jsonWriter();
+  MqttJsonPayload::encodeSessionEvent(w, sessionId, millis());
+  publishJson(eventTopic(topicSessionSuspended, sourceId, TopicSuffix::SESSION_SUSPENDED), w);
+#endif
 }
 
-void MqttManager::publishSessionResumed(uint32_t sessionId) {
-  JsonDocument doc;
-  doc["sessionId"] = sessionId;
-  doc["timestamp"] = millis();
-
-  serializeJson(doc, jsonBuffer, JSON_BUFFER_SIZE);
-  publishJson(topicSessionResumed, jsonBuffer);
+void MqttManager::publishSessionResumed(uint32_t sessionId, const char* sourceId) {
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeSessionEvent(w, sessionId, millis());
+  publishBinary(eventTopic(topicSessionResumed, sourceId, TopicSuffix::SESSION_RESUMED), w);
+#else
+  JsonWriter w = jsonWriter();
+  MqttJsonPayload::encodeSessionEvent(w, sessionId, millis());
+  publishJson(eventTopic(topicSessionResumed, sourceId, TopicSuffix::SESSION_RESUMED), w);
+#endif
 }
 
-bool MqttManager::publishShotDetected(const NormalizedShotData& shotData) {
+bool MqttManager::publishShotDetected(const NormalizedShotData& shotData, uint32_t seq, const char* sourceId) {
   // OPTIMIZED: This is the hot path for fast BLE events
   // Uses pre-allocated buffer and minimal overhead
 
@@ -361,26 +418,47 @@ bool MqttManager::publishShotDetected(const NormalizedShotData& shotData) {
     return false;
   }
 
+  // timestamp is when the shot was detected, so journal replays keep their original time
+  unsigned long timestamp = shotData.timestampMs ? (unsigned long)shotData.timestampMs : millis();
+
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeShot(w, shotData, seq, timestamp);
+  if (!w.ok()) {
+    LOG_ERROR("MQTT", "Shot payload buffer overflow");
+    return false;
+  }
+  const uint8_t* payload = w.data();
+  size_t length = w.size();
+#else
   // Build JSON directly using snprintf - avoids JsonDocument heap allocation
-  // Format: {"sessionId":N,"shotNumber":N,"absoluteTimeMs":N,"splitTimeMs":N,"deviceModel":"X","isFirstShot":B,"timestamp":N}
+  // Format: {"sessionId":N,"shotNumber":N,"absoluteTimeMs":N,"splitTimeMs":N,"deviceModel":"X","isFirstShot":B,"timestamp":N[,"seq":N]}
   int len = snprintf(jsonBuffer, JSON_BUFFER_SIZE,
-    "{\"sessionId\":%lu,\"shotNumber\":%u,\"absoluteTimeMs\":%lu,\"splitTimeMs\":%lu,\"deviceModel\":\"%s\",\"isFirstShot\":%s,\"timestamp\":%lu}",
+    "{\"sessionId\":%lu,\"shotNumber\":%u,\"absoluteTimeMs\":%lu,\"splitTimeMs\":%lu,\"deviceModel\":\"%s\",\"isFirstShot\":%s,\"timestamp\":%lu",
     (unsigned long)shotData.sessionId,
     shotData.shotNumber,
     (unsigned long)shotData.absoluteTimeMs,
     (unsigned long)shotData.splitTimeMs,
     shotData.deviceModel ? shotData.deviceModel : "unknown",
     shotData.isFirstShot ? "true" : "false",
-    (unsigned long)millis()
+    timestamp
   );
+  if (len > 0 && len < (int)JSON_BUFFER_SIZE) {
+    len += seq ? snprintf(jsonBuffer + len, JSON_BUFFER_SIZE - len, ",\"seq\":%lu}", (unsigned long)seq)
+               : snprintf(jsonBuffer + len, JSON_BUFFER_SIZE - len, "}");
+  }
 
   if (len < 0 || len >= (int)JSON_BUFFER_SIZE) {
     LOG_ERROR("MQTT", "Shot JSON buffer overflow");
     return false;
   }
 
+  const uint8_t* payload = reinterpret_cast<const uint8_t*>(jsonBuffer);
+  size_t length = (size_t)len;
+#endif
+
   // Publish with minimal overhead
-  if (mqttClient.publish(topicShotDetected, jsonBuffer)) {
+  if (mqttClient.publish(eventTopic(topicShotDetected, sourceId, TopicSuffix::SHOT_DETECTED), payload, length, false)) {
     LOG_DEBUG("MQTT", "Shot #%u published", shotData.shotNumber);
     return true;
   }
@@ -389,13 +467,139 @@ bool MqttManager::publishShotDetected(const NormalizedShotData& shotData) {
   return false;
 }
 
-void MqttManager::publishCountdownComplete(uint32_t sessionId) {
-  JsonDocument doc;
-  doc["sessionId"] = sessionId;
-  doc["timestamp"] = millis();
+void MqttManager::beginShotBatch(uint32_t sessionId, const char* deviceModel) {
+  batchCount = 0;
+  batchSessionId = sessionId;
+
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  batchCountOffset = MqttBinaryPayload::beginShotBatch(w, sessionId, deviceModel);
+  batchLength = w.ok() ? w.size() : 0;
+#else
+  // Format: {"sessionId":N,"deviceModel":"X","shots":[[seq,shotNumber,absoluteTimeMs,splitTimeMs,timestamp,isFirstShot],...]}
+  int len = snprintf(jsonBuffer, JSON_BUFFER_SIZE, "{\"sessionId\":%lu,\"deviceModel\":\"%s\",\"shots\":[",
+                     (unsigned long)sessionId, deviceModel && deviceModel[0] ? deviceModel : "unknown");
+  batchLength = (len > 0 && len < (int)JSON_BUFFER_SIZE) ? (size_t)len : 0;
+#endif
+}
+
+bool MqttManager::addToShotBatch(const NormalizedShotData& shotData, uint32_t seq) {
+  if (batchLength == 0 || batchCount >= MAX_SHOT_BATCH || shotData.sessionId != batchSessionId) {
+    return false;
+  }
+
+  unsigned long timestamp = shotData.timestampMs ? (unsigned long)shotData.timestampMs : millis();
+
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w(reinterpret_cast<uint8_t*>(jsonBuffer), JSON_BUFFER_SIZE, batchLength);
+  MqttBinaryPayload::addShotBatchRecord(w, shotData, seq, timestamp);
+  if (!w.ok()) {
+    return false;  // Buffer full - nothing past batchLength is published
+  }
+  batchLength = w.size();
+#else
+  // Keep room for the closing "]}"
+  const size_t room = JSON_BUFFER_SIZE - batchLength - 2;
+  int len = snprintf(jsonBuffer + batchLength, room, "%s[%lu,%u,%lu,%lu,%lu,%u]",
+                     batchCount ? "," : "",
+                     (unsigned long)seq,
+                     shotData.shotNumber,
+                     (unsigned long)shotData.absoluteTimeMs,
+                     (unsigned long)shotData.splitTimeMs,
+                     timestamp,
+                     shotData.isFirstShot ? 1u : 0u);
+  if (len < 0 || (size_t)len >= room) {
+    jsonBuffer[batchLength] = '\0';
+    return false;
+  }
+  batchLength += len;
+#endif
+
+  batchCount++;
+  return true;
+}
+
+bool MqttManager::publishShotBatch(const char* sourceId) {
+  if (batchCount == 0) {
+    return false;
+  }
+
+  // Fast fail if not connected
+  if (!mqttConnected || !mqttClient.connected()) {
+    mqttConnected = false;
+    return false;
+  }
+
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w(reinterpret_cast<uint8_t*>(jsonBuffer), JSON_BUFFER_SIZE, batchLength);
+  MqttBinaryPayload::finishShotBatch(w, batchCountOffset, batchCount);
+  size_t length = batchLength;
+#else
+  memcpy(jsonBuffer + batchLength, "]}", 3);
+  size_t length = batchLength + 2;
+#endif
+
+  if (mqttClient.publish(eventTopic(topicShotBatch, sourceId, TopicSuffix::SHOT_BATCH), reinterpret_cast<const uint8_t*>(jsonBuffer), length, false)) {
+    LOG_DEBUG("MQTT", "Shot batch published (%u shots, %u bytes)", batchCount, (unsigned)length);
+    return true;
+  }
+
+  LOG_ERROR("MQTT", "Failed to publish shot batch (%u shots)", batchCount);
+  return false;
+}
+
+void MqttManager::publishShotLatency() {
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  // Map length comes first in MessagePack - count the stages that saw shots
+  ShotTrace::StageSummary summaries[(size_t)TraceStage::COUNT];
+  uint16_t stageCount = 0;
+  for (size_t i = 0; i < (size_t)TraceStage::COUNT; i++) {
+    summaries[i] = ShotTrace::summarize((TraceStage)i);
+    if (summaries[i].count > 0) {
+      stageCount++;
+    }
+  }
+
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::beginLatency(w, stageCount);
+  for (size_t i = 0; i < (size_t)TraceStage::COUNT; i++) {
+    const ShotTrace::StageSummary& summary = summaries[i];
+    if (summary.count > 0) {
+      MqttBinaryPayload::addLatencyStage(w, ShotTrace::getStageName((TraceStage)i), summary.count,
+                                         summary.minUs, summary.avgUs, summary.p99Us, summary.maxUs);
+    }
+  }
+  MqttBinaryPayload::finishLatency(w, millis());
+  publishBinary(topicShotLatency, w);  // diagnostics - not retained
+#else
+  JsonWriter w = jsonWriter();
+  MqttJsonPayload::beginLatency(w);
+
+  // Only stages that saw shots - keeps the payload within JSON_BUFFER_SIZE
+  for (size_t i = 0; i < (size_t)TraceStage::COUNT; i++) {
+    TraceStage stage = (TraceStage)i;
+    ShotTrace::StageSummary summary = ShotTrace::summarize(stage);
+    if (summary.count == 0) {
+      continue;
+    }
+    MqttJsonPayload::addLatencyStage(w, ShotTrace::getStageName(stage), summary.count,
+                                     summary.minUs, summary.avgUs, summary.p99Us, summary.maxUs);
+  }
+  MqttJsonPayload::finishLatency(w, millis());
+  publishJson(topicShotLatency, w);  // diagnostics - not retained
+#endif
+}
 
-  serializeJson(doc, jsonBuffer, JSON_BUFFER_SIZE);
-  publishJson(topicCountdownComplete, jsonBuffer);
+void MqttManager::publishCountdownComplete(uint32_t sessionId, const char* sourceId) {
+#if MQTT_PAYLOAD_FORMAT == MQTT_PAYLOAD_FORMAT_MSGPACK
+  MsgPackWriter w = payloadWriter();
+  MqttBinaryPayload::encodeSessionEvent(w, sessionId, millis());
+  publishBinary(eventTopic(topicCountdownComplete, sourceId, TopicSuffix::COUNTDOWN_COMPLETE), w);
+#else
+  JsonWriter w = jsonWriter();
+  MqttJsonPayload::encodeSessionEvent(w, sessionId, millis());
+  publishJson(eventTopic(topicCountdownComplete, sourceId, TopicSuffix::COUNTDOWN_COMPLETE), w);
+#endif
 }
 
 void MqttManager::reconnect() {
@@ -3,14 +3,11 @@
 #include "common.h"
 
 // Static constants - Service UUIDs for device discovery
-const char* SGTimer::LOG_TAG = "SG-TIMER";
+constexpr const char* SGTimer::LOG_TAG;
 const char* SGTimer::SERVICE_UUID = "7520FFFF-14D2-4CDA-8B6B-697C554C9311";
 const char* SGTimer::CHARACTERISTIC_UUID = "75200001-14D2-4CDA-8B6B-697C554C9311";
 const char* SGTimer::SHOT_LIST_UUID = "75200004-14D2-4CDA-8B6B-697C554C9311";
 
-// Static instance for callbacks
-SGTimer* SGTimer::instance = nullptr;
-
 SGTimer::SGTimer() :
   BaseTimerDevice("SG Timer"),
   pEventCharacteristic(nullptr),
@@ -20,12 +17,10 @@ SGTimer::SGTimer() :
   lastShotSeconds(0),
   lastShotHundredths(0),
   hasLastShot(false) {
-  instance = this;
 }
 
 SGTimer::~SGTimer() {
   disconnect();
-  instance = nullptr;
 }
 
 // Static method to check if advertised device is an SG Timer
@@ -113,7 +108,7 @@ bool SGTimer::attemptConnection(BLEAdvertisedDevice* device) {
         // Check if characteristic can notify
         if (pEventCharacteristic->canNotify()) {
           LOG_INFO(LOG_TAG, "Registering for notifications");
-          pEventCharacteristic->registerForNotify(notifyCallback);
+          subscribe(pEventCharacteristic);
           LOG_INFO(LOG_TAG, "Successfully registered for notifications - listening for events");
           isConnectedFlag = true;
           lastHeartbeat = millis();
@@ -152,27 +147,13 @@ bool SGTimer::attemptConnection(BLEAdvertisedDevice* device) {
   }
 }
 
-// Static notification callback
-void SGTimer::notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                                  uint8_t* pData, size_t length, bool isNotify) {
-  if (instance && pData && length > 0) {
-    instance->processTimerData(pData, length);
-  }
-}
-
 void SGTimer::processTimerData(uint8_t* pData, size_t length) {
   if (!pData || length == 0) {
     LOG_WARN(LOG_TAG, "Invalid data received (null or empty)");
     return;
   }
 
-  if (Logger::getLevel() <= LogLevel::DEBUG) {
-    LOG_DEBUG(LOG_TAG, "Notification received (%d bytes)", length);
-    for (size_t i = 0; i < length; i++) {
-      Serial.printf("%02X ", pData[i]);
-    }
-    Serial.println();
-  }
+  LOG_HEX(LOG_TAG, "Notification received", pData, length);
 
   // Parse event based on API documentation
   if (length >= 2) {
@@ -299,6 +280,7 @@ void SGTimer::processTimerData(uint8_t* pData, size_t length) {
           shotData.absoluteTimeMs = shot_time_ms;
           shotData.splitTimeMs = splitTime;
           shotData.timestampMs = millis();
+          shotData.traceOriginUs = notifyTimestampUs;
           strncpy(shotData.deviceModel, deviceModel, sizeof(shotData.deviceModel) - 1);
           shotData.deviceModel[sizeof(shotData.deviceModel) - 1] = '\0';
           shotData.isFirstShot = isFirstShot;
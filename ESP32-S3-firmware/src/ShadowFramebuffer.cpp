@@ -0,0 +1,226 @@
+#include "ShadowFramebuffer.h"
+#include <esp_heap_caps.h>
+
+ShadowFramebuffer::ShadowFramebuffer(int16_t w, int16_t h, uint8_t pages)
+  : Adafruit_GFX(w, h),
+    frame(nullptr),
+    shown{},
+    pendingTiles{},
+    pageCount(pages < 1 ? 1 : (pages > MAX_PAGES ? MAX_PAGES : pages)),
+    currentPage(0),
+    drawnSincePresent(false),
+    tilesX((uint8_t)(w / TILE_SIZE)),
+    tilesY((uint8_t)(h / TILE_SIZE)) {
+}
+
+ShadowFramebuffer::~ShadowFramebuffer() {
+  freeBuffers();
+}
+
+void ShadowFramebuffer::freeBuffers() {
+  if (frame) {
+    heap_caps_free(frame);
+    frame = nullptr;
+  }
+  for (uint8_t page = 0; page < MAX_PAGES; page++) {
+    if (shown[page]) {
+      heap_caps_free(shown[page]);
+      shown[page] = nullptr;
+    }
+  }
+}
+
+bool ShadowFramebuffer::begin() {
+  if (frame) {
+    return true;
+  }
+  if ((_width % TILE_SIZE) || (_height % TILE_SIZE) || tilesX * tilesY > MAX_TILES) {
+    return false;
+  }
+
+  const size_t bytes = (size_t)_width * _height * sizeof(uint16_t);
+
+  // The diff walks these on every present - keep them in internal RAM if possible
+  auto allocate = [bytes]() -> uint16_t* {
+    void* p = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!p) {
+      p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (p) {
+      memset(p, 0, bytes);
+    }
+    return static_cast<uint16_t*>(p);
+  };
+
+  frame = allocate();
+  bool ok = frame != nullptr;
+  for (uint8_t page = 0; ok && page < pageCount; page++) {
+    shown[page] = allocate();
+    ok = shown[page] != nullptr;
+  }
+  if (!ok) {
+    freeBuffers();
+    return false;
+  }
+
+  currentPage = 0;
+  drawnSincePresent = false;
+  for (uint8_t page = 0; page < MAX_PAGES; page++) {
+    pendingTiles[page] = 0;
+  }
+  return true;
+}
+
+bool ShadowFramebuffer::clip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+  if (!frame || w <= 0 || h <= 0) {
+    return false;
+  }
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _width) w = _width - x;
+  if (y + h > _height) h = _height - y;
+  return w > 0 && h > 0;
+}
+
+void ShadowFramebuffer::markTiles(int16_t x, int16_t y, int16_t w, int16_t h) {
+  const uint8_t tx0 = x / TILE_SIZE;
+  const uint8_t tx1 = (x + w - 1) / TILE_SIZE;
+  const uint8_t ty0 = y / TILE_SIZE;
+  const uint8_t ty1 = (y + h - 1) / TILE_SIZE;
+
+  uint64_t mask = 0;
+  for (uint8_t ty = ty0; ty <= ty1; ty++) {
+    for (uint8_t tx = tx0; tx <= tx1; tx++) {
+      mask |= (uint64_t)1 << (ty * tilesX + tx);
+    }
+  }
+  for (uint8_t page = 0; page < pageCount; page++) {
+    pendingTiles[page] |= mask;
+  }
+  drawnSincePresent = true;
+}
+
+void ShadowFramebuffer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!frame || x < 0 || y < 0 || x >= _width || y >= _height) {
+    return;
+  }
+  frame[y * _width + x] = color;
+
+  // Hot path for u8g2 glyph rendering - skip the rectangle walk
+  const uint64_t bit = (uint64_t)1 << ((y / TILE_SIZE) * tilesX + (x / TILE_SIZE));
+  for (uint8_t page = 0; page < pageCount; page++) {
+    pendingTiles[page] |= bit;
+  }
+  drawnSincePresent = true;
+}
+
+void ShadowFramebuffer::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void ShadowFramebuffer::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void ShadowFramebuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (!clip(x, y, w, h)) {
+    return;
+  }
+  for (int16_t row = y; row < y + h; row++) {
+    uint16_t* p = &frame[row * _width + x];
+    for (int16_t i = 0; i < w; i++) {
+      p[i] = color;
+    }
+  }
+  markTiles(x, y, w, h);
+}
+
+void ShadowFramebuffer::fillScreen(uint16_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+uint16_t ShadowFramebuffer::getPixel(int16_t x, int16_t y) const {
+  if (!frame || x < 0 || y < 0 || x >= _width || y >= _height) {
+    return 0;
+  }
+  return frame[y * _width + x];
+}
+
+void ShadowFramebuffer::flipPage() {
+  if (pageCount > 1) {
+    currentPage ^= 1;
+  }
+}
+
+void ShadowFramebuffer::resetShown() {
+  if (!frame) {
+    return;
+  }
+  for (uint8_t page = 0; page < pageCount; page++) {
+    memset(shown[page], 0, (size_t)_width * _height * sizeof(uint16_t));
+  }
+  // Anything non-black in the frame has to be pushed again
+  markTiles(0, 0, _width, _height);
+}
+
+ShadowFramebuffer::PresentStats ShadowFramebuffer::present(Adafruit_GFX& panel) {
+  PresentStats stats;
+  if (!frame) {
+    return stats;
+  }
+
+  uint16_t* mirror = shown[currentPage];
+  uint64_t pending = pendingTiles[currentPage];
+  pendingTiles[currentPage] = 0;
+  drawnSincePresent = false;
+
+  while (pending) {
+    const uint8_t tile = (uint8_t)__builtin_ctzll(pending);
+    pending &= pending - 1;
+    stats.tilesTouched++;
+
+    const int16_t x0 = (tile % tilesX) * TILE_SIZE;
+    const int16_t y0 = (tile / tilesX) * TILE_SIZE;
+    bool tileChanged = false;
+
+    for (int16_t y = y0; y < y0 + TILE_SIZE; y++) {
+      uint16_t* src = &frame[y * _width];
+      uint16_t* dst = &mirror[y * _width];
+      int16_t x = x0;
+      while (x < x0 + TILE_SIZE) {
+        if (src[x] == dst[x]) {
+          x++;
+          continue;
+        }
+
+        // Extend the run over differing pixels of the same colour
+        const uint16_t color = src[x];
+        int16_t end = x + 1;
+        while (end < x0 + TILE_SIZE && src[end] == color && dst[end] != color) {
+          end++;
+        }
+
+        const int16_t len = end - x;
+        if (len == 1) {
+          panel.drawPixel(x, y, color);
+        } else {
+          panel.drawFastHLine(x, y, len, color);
+        }
+        for (int16_t i = x; i < end; i++) {
+          dst[i] = color;
+        }
+
+        stats.pixelsPushed += len;
+        stats.runsPushed++;
+        tileChanged = true;
+        x = end;
+      }
+    }
+
+    if (tileChanged) {
+      stats.tilesChanged++;
+    }
+  }
+
+  return stats;
+}
@@ -0,0 +1,203 @@
+#include "ShotJournal.h"
+#include <esp_heap_caps.h>
+
+ShotJournal::ShotJournal()
+  : ring(nullptr),
+    ramCapacity(0),
+    ramHead(0),
+    ramSize(0),
+    spill(nullptr),
+    stage{},
+    stageCount(0),
+    stagePos(0) {
+  for (uint8_t lane = 0; lane < MAX_TIMER_LANES; lane++) {
+    currentSessionId[lane] = 0;
+    nextSeq[lane] = 1;
+  }
+}
+
+ShotJournal::~ShotJournal() {
+  if (ring) {
+    heap_caps_free(ring);
+    ring = nullptr;
+  }
+}
+
+bool ShotJournal::begin(uint32_t capacity, JournalSpillStore* spillStore) {
+  if (ring || capacity < SPILL_BLOCK) {
+    return ring != nullptr;
+  }
+
+  // One allocation for the lifetime of the journal - PSRAM first, it is the bulk store
+  void* p = heap_caps_malloc((size_t)capacity * sizeof(JournalRecord), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!p) {
+    // No PSRAM - keep a small internal ring and lean on the spill store
+    capacity = INTERNAL_FALLBACK_CAPACITY < capacity ? INTERNAL_FALLBACK_CAPACITY : capacity;
+    p = heap_caps_malloc((size_t)capacity * sizeof(JournalRecord), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  }
+  if (!p) {
+    return false;
+  }
+
+  ring = static_cast<JournalRecord*>(p);
+  ramCapacity = capacity;
+  ramHead = 0;
+  ramSize = 0;
+  spill = spillStore;
+  stageCount = 0;
+  stagePos = 0;
+  return true;
+}
+
+uint32_t ShotJournal::spillCount() const {
+  // Staged records are still counted by the store until the block is consumed
+  return spill ? spill->count() - stagePos : 0;
+}
+
+uint32_t ShotJournal::pending() const {
+  return spillCount() + ramSize;
+}
+
+void ShotJournal::append(const NormalizedShotData& shot) {
+  if (!ring) {
+    return;
+  }
+
+  uint8_t lane = shot.lane < MAX_TIMER_LANES ? shot.lane : 0;
+  if (shot.sessionId != currentSessionId[lane]) {
+    currentSessionId[lane] = shot.sessionId;
+    nextSeq[lane] = 1;
+  }
+
+  if (ramSize == ramCapacity) {
+    spillOldest();
+  }
+
+  JournalRecord& r = ring[(ramHead + ramSize) % ramCapacity];
+  r.sessionId = shot.sessionId;
+  r.seq = nextSeq[lane]++;
+  r.absoluteTimeMs = shot.absoluteTimeMs;
+  r.splitTimeMs = shot.splitTimeMs;
+  r.capturedMs = (uint32_t)shot.timestampMs;
+  r.shotNumber = shot.shotNumber;
+  r.flags = shot.isFirstShot ? JournalRecord::FLAG_FIRST_SHOT : 0;
+  r.lane = lane;
+  r.traceOriginUs = shot.traceOriginUs;
+  strncpy(r.deviceModel, shot.deviceModel, sizeof(r.deviceModel) - 1);
+  r.deviceModel[sizeof(r.deviceModel) - 1] = '\0';
+
+  ramSize++;
+  stats.appended++;
+}
+
+void ShotJournal::spillOldest() {
+  // Move (or drop) one block from the front of the ring, written in place
+  // as at most two contiguous segments
+  const uint32_t n = ramSize < SPILL_BLOCK ? ramSize : SPILL_BLOCK;
+  const uint32_t first = ramCapacity - ramHead < n ? ramCapacity - ramHead : n;
+  for (uint32_t i = 0; i < n; i++) {
+    ring[(ramHead + i) % ramCapacity].traceOriginUs = 0;   // Meaningless once persisted
+  }
+
+  bool spilled = spill && spill->count() + n <= spill->capacity() &&
+                 spill->append(&ring[ramHead], first) &&
+                 (first == n || spill->append(&ring[0], n - first));
+  if (spilled) {
+    stats.spilled += n;
+  } else {
+    stats.dropped += n;
+  }
+
+  ramHead = (ramHead + n) % ramCapacity;
+  ramSize -= n;
+}
+
+bool ShotJournal::peek(JournalRecord& out) {
+  if (spill && spill->count() > 0) {
+    if (stagePos == stageCount) {
+      stageCount = (uint16_t)spill->read(stage, SPILL_BLOCK);
+      stagePos = 0;
+    }
+    if (stagePos < stageCount) {
+      out = stage[stagePos];
+      return true;
+    }
+    // Unreadable spill - give up on it rather than stall the RAM ring
+    stats.dropped += spill->count();
+    spill->clear();
+    stageCount = 0;
+    stagePos = 0;
+  }
+
+  if (ramSize == 0) {
+    return false;
+  }
+  out = ring[ramHead];
+  return true;
+}
+
+uint16_t ShotJournal::peekBatch(JournalRecord* out, uint16_t max) {
+  JournalRecord first;
+  if (max == 0 || !peek(first)) {   // Loads the next spill block if needed
+    return 0;
+  }
+
+  uint16_t n = 0;
+  if (stagePos < stageCount) {
+    while (n < max && stagePos + n < stageCount) {
+      out[n] = stage[stagePos + n];
+      n++;
+    }
+    return n;
+  }
+
+  while (n < max && n < ramSize) {
+    out[n] = ring[(ramHead + n) % ramCapacity];
+    n++;
+  }
+  return n;
+}
+
+void ShotJournal::pop() {
+  JournalRecord head;
+  if (!peek(head)) {   // Also stages the next spill block, so pop() never skips it
+    return;
+  }
+
+  if (stagePos < stageCount) {
+    stagePos++;
+    stats.replayed++;
+    if (stagePos == stageCount) {
+      spill->consume(stageCount);
+      stageCount = 0;
+      stagePos = 0;
+    }
+    return;
+  }
+
+  if (ramSize > 0) {
+    ramHead = (ramHead + 1) % ramCapacity;
+    ramSize--;
+    stats.replayed++;
+  }
+}
+
+void ShotJournal::clearTraceOrigins() {
+  for (uint32_t i = 0; i < ramSize; i++) {
+    ring[(ramHead + i) % ramCapacity].traceOriginUs = 0;
+  }
+}
+
+void ShotJournal::toShotData(const JournalRecord& record, NormalizedShotData& out) {
+  out = NormalizedShotData();
+  out.sessionId = record.sessionId;
+  out.shotNumber = record.shotNumber;
+  out.absoluteTimeMs = record.absoluteTimeMs;
+  out.splitTimeMs = record.splitTimeMs;
+  out.timestampMs = record.capturedMs;
+  out.traceOriginUs = record.traceOriginUs;
+  out.isFirstShot = (record.flags & JournalRecord::FLAG_FIRST_SHOT) != 0;
+  out.lane = record.lane;
+  strncpy(out.deviceModel, record.deviceModel, sizeof(out.deviceModel) - 1);
+  out.deviceModel[sizeof(out.deviceModel) - 1] = '\0';
+}
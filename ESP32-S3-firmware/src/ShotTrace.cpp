@@ -0,0 +1,95 @@
+#include "ShotTrace.h"
+#include "Logger.h"
+#include "common.h"
+#include "freertos/FreeRTOS.h"
+
+namespace {
+portMUX_TYPE traceLock = portMUX_INITIALIZER_UNLOCKED;
+
+const char* const STAGE_NAMES[(size_t)TraceStage::COUNT] = {
+  "parsed",
+  "dequeued",
+  "rendered",
+  "mqtt",
+  "loraTx"
+};
+}
+
+LatencyHistogram ShotTrace::histograms[(size_t)TraceStage::COUNT];
+uint32_t ShotTrace::totalSamples = 0;
+
+void ShotTrace::record(TraceStage stage, int64_t originUs) {
+#if SHOT_TRACE_ENABLED
+  if (originUs <= 0 || stage >= TraceStage::COUNT) {
+    return;
+  }
+
+  int64_t elapsed = nowUs() - originUs;
+  uint32_t elapsedUs = elapsed < 0 ? 0 : (elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed);
+
+  portENTER_CRITICAL(&traceLock);
+  histograms[(size_t)stage].record(elapsedUs);
+  totalSamples++;
+  portEXIT_CRITICAL(&traceLock);
+#else
+  (void)stage;
+  (void)originUs;
+#endif
+}
+
+ShotTrace::StageSummary ShotTrace::summarize(TraceStage stage) {
+  StageSummary summary;
+  if (stage >= TraceStage::COUNT) {
+    return summary;
+  }
+
+  portENTER_CRITICAL(&traceLock);
+  const LatencyHistogram& h = histograms[(size_t)stage];
+  summary.count = h.count();
+  summary.minUs = h.min();
+  summary.avgUs = h.mean();
+  summary.p99Us = h.percentile(99);
+  summary.maxUs = h.max();
+  portEXIT_CRITICAL(&traceLock);
+
+  return summary;
+}
+
+uint32_t ShotTrace::getTotalSamples() {
+  portENTER_CRITICAL(&traceLock);
+  uint32_t total = totalSamples;
+  portEXIT_CRITICAL(&traceLock);
+  return total;
+}
+
+void ShotTrace::reset() {
+  portENTER_CRITICAL(&traceLock);
+  for (size_t i = 0; i < (size_t)TraceStage::COUNT; i++) {
+    histograms[i].reset();
+  }
+  totalSamples = 0;
+  portEXIT_CRITICAL(&traceLock);
+}
+
+void ShotTrace::logSummary() {
+  for (size_t i = 0; i < (size_t)TraceStage::COUNT; i++) {
+    StageSummary s = summarize((TraceStage)i);
+    if (s.count == 0) {
+      continue;
+    }
+    LOG_INFO("TRACE", "%-8s n=%lu min=%lu avg=%lu p99=%lu max=%lu us",
+             STAGE_NAMES[i],
+             (unsigned long)s.count,
+             (unsigned long)s.minUs,
+             (unsigned long)s.avgUs,
+             (unsigned long)s.p99Us,
+             (unsigned long)s.maxUs);
+  }
+}
+
+const char* ShotTrace::getStageName(TraceStage stage) {
+  if (stage >= TraceStage::COUNT) {
+    return "unknown";
+  }
+  return STAGE_NAMES[(size_t)stage];
+}
@@ -5,13 +5,10 @@
 #include <string>
 
 // Static constants
-const char* SpecialPieM1A2F::LOG_TAG = "SP-M1A2-F";
+constexpr const char* SpecialPieM1A2F::LOG_TAG;
 const char* SpecialPieM1A2F::SERVICE_UUID = "0000FFF0-0000-1000-8000-00805F9B34FB";
 const char* SpecialPieM1A2F::CHARACTERISTIC_UUID = "0000FFF1-0000-1000-8000-00805F9B34FB";
 
-// Static instance for callbacks
-SpecialPieM1A2F* SpecialPieM1A2F::instance = nullptr;
-
 SpecialPieM1A2F::SpecialPieM1A2F() :
   BaseTimerDevice("SP M1A2 Timer"),
   pNotifyCharacteristic(nullptr),
@@ -20,12 +17,10 @@ SpecialPieM1A2F::SpecialPieM1A2F() :
   hasPreviousShot(false),
   currentSessionId(0),
   sessionActiveFlag(false) {
-  instance = this;
 }
 
 SpecialPieM1A2F::~SpecialPieM1A2F() {
   disconnect();
-  instance = nullptr;
 }
 
 // Static method to check if advertised device matches SP M1A2 Timer name pattern
@@ -122,7 +117,7 @@ bool SpecialPieM1A2F::connectToMacAddress(const char* macAddress) {
 
         if (pNotifyCharacteristic->canNotify()) {
           LOG_INFO(LOG_TAG, "Registering for notifications...");
-          pNotifyCharacteristic->registerForNotify(notifyCallback);
+          subscribe(pNotifyCharacteristic);
           LOG_INFO(LOG_TAG, "Successfully registered for timer event notifications!");
 
           isConnectedFlag = true;
@@ -169,27 +164,13 @@ bool SpecialPieM1A2F::connectToMacAddress(const char* macAddress) {
   return false;
 }
 
-// Static notification callback
-void SpecialPieM1A2F::notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                                              uint8_t* pData, size_t length, bool isNotify) {
-  if (instance && pData && length > 0) {
-    instance->processTimerData(pData, length);
-  }
-}
-
 void SpecialPieM1A2F::processTimerData(uint8_t* pData, size_t length) {
   if (!pData || length == 0) {
     LOG_WARN(LOG_TAG, "Invalid data received");
     return;
   }
 
-  if (Logger::getLevel() <= LogLevel::DEBUG) {
-    LOG_DEBUG(LOG_TAG, "Notification (%d bytes)", length);
-    for (size_t i = 0; i < length; i++) {
-      Serial.printf("%02X ", pData[i]);
-    }
-    Serial.println();
-  }
+  LOG_HEX(LOG_TAG, "Notification", pData, length);
 
   // Special Pie Timer Protocol:
   // [F8] [F9] [MESSAGE_TYPE] [DATA...] [F9] [F8]
@@ -289,6 +270,7 @@ void SpecialPieM1A2F::processTimerData(uint8_t* pData, size_t length) {
           shotData.absoluteTimeMs = absoluteTimeMs;
           shotData.splitTimeMs = splitTimeMs;
           shotData.timestampMs = millis();
+          shotData.traceOriginUs = notifyTimestampUs;
           strncpy(shotData.deviceModel, deviceModel, sizeof(shotData.deviceModel) - 1);
           shotData.deviceModel[sizeof(shotData.deviceModel) - 1] = '\0';
           shotData.isFirstShot = isFirstShot;
@@ -3,13 +3,10 @@
 #include "common.h"
 
 // Static constants
-const char* SpecialPieM1A2Plus::LOG_TAG = "SP-M1A2+";
+constexpr const char* SpecialPieM1A2Plus::LOG_TAG;
 const char* SpecialPieM1A2Plus::SERVICE_UUID = "0000FFF0-0000-1000-8000-00805F9B34FB";
 const char* SpecialPieM1A2Plus::CHARACTERISTIC_UUID = "0000FFF1-0000-1000-8000-00805F9B34FB";
 
-// Static instance for callbacks
-SpecialPieM1A2Plus* SpecialPieM1A2Plus::instance = nullptr;
-
 SpecialPieM1A2Plus::SpecialPieM1A2Plus() :
   BaseTimerDevice("Special Pie Timer"),
   pNotifyCharacteristic(nullptr),
@@ -18,12 +15,10 @@ SpecialPieM1A2Plus::SpecialPieM1A2Plus() :
   hasPreviousShot(false),
   currentSessionId(0),
   sessionActiveFlag(false) {
-  instance = this;
 }
 
 SpecialPieM1A2Plus::~SpecialPieM1A2Plus() {
   disconnect();
-  instance = nullptr;
 }
 
 // Static method to check if advertised device is a Special Pie Timer (UUID-based)
@@ -96,7 +91,7 @@ bool SpecialPieM1A2Plus::attemptConnection(BLEAdvertisedDevice* device) {
         // Check if characteristic can notify
         if (pNotifyCharacteristic->canNotify()) {
           LOG_INFO(LOG_TAG, "Registering for notifications");
-          pNotifyCharacteristic->registerForNotify(notifyCallback);
+          subscribe(pNotifyCharacteristic);
           LOG_INFO(LOG_TAG, "Successfully registered for notifications - listening for events");
           isConnectedFlag = true;
           lastHeartbeat = millis();
@@ -136,27 +131,13 @@ bool SpecialPieM1A2Plus::attemptConnection(BLEAdvertisedDevice* device) {
   return false;
 }
 
-// Static notification callback
-void SpecialPieM1A2Plus::notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
-                                          uint8_t* pData, size_t length, bool isNotify) {
-  if (instance && pData && length > 0) {
-    instance->processTimerData(pData, length);
-  }
-}
-
 void SpecialPieM1A2Plus::processTimerData(uint8_t* pData, size_t length) {
   if (!pData || length == 0) {
     LOG_WARN(LOG_TAG, "Invalid data received (null or empty)");
     return;
   }
 
-  if (Logger::getLevel() <= LogLevel::DEBUG) {
-    LOG_DEBUG(LOG_TAG, "Notification received (%d bytes)", length);
-    for (size_t i = 0; i < length; i++) {
-      Serial.printf("%02X ", pData[i]);
-    }
-    Serial.println();
-  }
+  LOG_HEX(LOG_TAG, "Notification received", pData, length);
 
   // Special Pie Timer Protocol:
   // [F8] [F9] [MESSAGE_TYPE] [DATA...] [F9] [F8]
@@ -267,6 +248,7 @@ void SpecialPieM1A2Plus::processTimerData(uint8_t* pData, size_t length) {
         shotData.absoluteTimeMs = absoluteTimeMs;
         shotData.splitTimeMs = splitTimeMs;
         shotData.timestampMs = millis();
+        shotData.traceOriginUs = notifyTimestampUs;
         strncpy(shotData.deviceModel, deviceModel, sizeof(shotData.deviceModel) - 1);
         shotData.deviceModel[sizeof(shotData.deviceModel) - 1] = '\0';
         shotData.isFirstShot = isFirstShot;
@@ -4,6 +4,7 @@
 #include "SpecialPieM1A2F.h"
 #include "ASNTracker.h"
 #include "WiFiConfig.h"
+#include "DeviceId.h"
 #include "common.h"
 #include <BLEDevice.h>
 
@@ -12,16 +13,37 @@ TimerApplication* gTimerApplicationInstance = nullptr;
 volatile bool gBleScanResultsReady = false;
 
 void onBleScanComplete(BLEScanResults /*scanResults*/) {
-  (void)gTimerApplicationInstance;
   gBleScanResultsReady = true;
+  if (gTimerApplicationInstance) {
+    gTimerApplicationInstance->signalLoop(LoopEvent::BLE_EVENT);
+  }
+}
+
+uint8_t laneBit(uint8_t lane) {
+  return (uint8_t)(1u << lane);
+}
+
+// Devices don't know their lane - stamp it on everything they report
+template <typename Data>
+Data onLane(const Data& data, uint8_t lane) {
+  Data tagged = data;
+  tagged.lane = lane;
+  return tagged;
 }
 }
 
 TimerApplication::TimerApplication()
-  : sessionActive(false),
-    lastShotNumber(0),
-    lastShotTime(0),
-    shotEventQueue(nullptr),
+  : timers(AppConfig::MAX_TIMER_DEVICES),
+    activeLanes(0),
+    pendingRelease(0),
+    lastShotNumber{},
+    lastShotTime{},
+    laneSourceIds{},
+    tracedLanes(0),
+    journalEnabled(false),
+    journalOutage(false),
+    journalRetryAt(0),
+    journalReplayAt(0),
     maxQueueDepth(0),
     totalShotsQueued(0),
     totalShotsPublished(0),
@@ -33,7 +55,8 @@ TimerApplication::TimerApplication()
     lastHealthCheck(0),
     lastActivityTime(0),
     hadDeviceConnected(false),
-    lastMqttWarningTime(0) {
+    lastMqttWarningTime(0),
+    lastReportedTraceSamples(0) {
   gTimerApplicationInstance = this;
 }
 
@@ -42,14 +65,19 @@ TimerApplication::~TimerApplication() {
     gTimerApplicationInstance = nullptr;
   }
 
-  if (shotEventQueue) {
-    vQueueDelete(shotEventQueue);
-    shotEventQueue = nullptr;
+  // Detach before the devices go away; smart pointers handle the rest
+  for (uint8_t lane = 0; lane < timers.getCapacity(); lane++) {
+    releaseTimerDevice(lane);
   }
-  // Smart pointers will handle cleanup automatically
 }
 
 bool TimerApplication::initialize() {
+  if (AppConfig::DEFERRED_LOGGING_ENABLED) {
+    Logger::startDeferred(AppConfig::LOG_DRAIN_TASK_CORE,
+                          AppConfig::LOG_DRAIN_TASK_PRIORITY,
+                          AppConfig::LOG_DRAIN_TASK_STACK_SIZE);
+  }
+
   LOG_SYSTEM("=== SG Shot Timer BLE Bridge ===");
   LOG_SYSTEM("ESP32-S3 DevKit-C Starting...");
 
@@ -58,12 +86,8 @@ bool TimerApplication::initialize() {
   // Non-blocking mode keeps startup responsive even without WiFi credentials.
   WiFiConfig::initialize();
 
-  // Create FreeRTOS queue for shot events
-  shotEventQueue = xQueueCreate(AppConfig::EVENT_QUEUE_SIZE, sizeof(NormalizedShotData));
-  if (!shotEventQueue) {
-    LOG_ERROR("SYSTEM", "Failed to create shot event queue");
-    return false;
-  }
+  // Main loop task (setup() and loop() share it) - producers signal it via the scheduler
+  scheduler.bind();
 
   // Initialize display manager
   displayManager = std::unique_ptr<DisplayManager>(new DisplayManager());
@@ -80,16 +104,35 @@ bool TimerApplication::initialize() {
     if (!mqttManager->initialize()) {
       LOG_SYSTEM("MQTT disabled - server not configured");
       // Non-fatal - continue without MQTT
+    } else if (AppConfig::SHOT_JOURNAL_ENABLED) {
+      initializeJournal();
     }
   } else {
     LOG_SYSTEM("MQTT disabled (TIMER_TYPE=%d)", TIMER_TYPE);
   }
 
+  // Timers past the first publish as timer/<deviceId>-L<n>/
+  for (uint8_t lane = 1; lane < MAX_TIMER_LANES; lane++) {
+    snprintf(laneSourceIds[lane], LANE_SOURCE_ID_SIZE, "%s-L%u", deviceId.get().c_str(), (unsigned)(lane + 1));
+  }
+
   // Initialize BLE only if timer type is BLE
   if (TIMER_TYPE == TIMER_TYPE_BLE) {
     BLEDevice::init(BLE_DEVICE_NAME);
     LOG_BLE("ESP32-S3 BLE Client initialized");
-    LOG_SYSTEM("Ready to scan for timer devices (SG Timer or Special Pie Timer)");
+
+    // Pipeline mode: parse notifications on a dedicated task pinned to the BLE core
+    if (AppConfig::BLE_INGEST_TASK_ENABLED) {
+      bleIngest = std::unique_ptr<BleIngestTask>(new BleIngestTask());
+      if (!bleIngest->start(AppConfig::BLE_INGEST_TASK_CORE,
+                            AppConfig::BLE_INGEST_TASK_PRIORITY,
+                            AppConfig::BLE_INGEST_TASK_STACK_SIZE)) {
+        LOG_WARN("BLE", "Ingest task unavailable - parsing on BLE stack task");
+        bleIngest.reset();
+      }
+    }
+    LOG_SYSTEM("Ready to scan for timer devices (SG Timer or Special Pie Timer), up to %u at once",
+               (unsigned)timers.getCapacity());
   } else {
     // MQTT client not implemented yet
     LOG_SYSTEM("BLE disabled - Timer Type: MQTT");
@@ -121,21 +164,27 @@ void TimerApplication::run() {
       processScanResults();
     }
 
-    if (!timerDevice) {
+    if (!timers.isFull()) {
       scanForDevices();
     }
 
     // Process BLE events - this may trigger callbacks that enqueue shots
-    if (timerDevice) {
-      timerDevice->update();
+    for (uint8_t lane = 0; lane < timers.getCapacity(); lane++) {
+      ITimerDevice* device = timers.get(lane);
+      if (device) {
+        device->update();
+      }
     }
+
+    // Timers that lost their link during update() - safe to destroy now
+    releaseDisconnectedDevices();
   }
 
   // ============================================================
-  // PHASE 3: MQTT Queue Processing (Batch publish)
+  // PHASE 3: Shot Queue Processing (display + batch publish)
   // ============================================================
   // Process queued events AFTER BLE update to minimize latency
-  publishQueuedEvents();
+  processQueuedEvents();
 
   // MQTT connection maintenance
   if (mqttManager) {
@@ -154,95 +203,182 @@ void TimerApplication::run() {
   // ============================================================
   performHealthCheck();
 
-  // Yield to FreeRTOS scheduler
-  vTaskDelay(pdMS_TO_TICKS(MAIN_LOOP_DELAY));
+  // ============================================================
+  // PHASE 6: Block until the next event or deadline
+  // ============================================================
+  waitForNextEvent();
+}
+
+void TimerApplication::waitForNextEvent() {
+#if EVENT_DRIVEN_LOOP
+  // Portal and scan handling are still polled - keep the legacy cadence there
+  if (WiFiConfig::isPortalActive() || isScanning) {
+    scheduler.scheduleIn(MAIN_LOOP_DELAY);
+  }
+
+  // Events left over from a capped batch - run again now
+  if (!eventRing.empty()) {
+    scheduler.scheduleIn(0);
+  }
+
+  // Journal backlog: now, or when the retry back-off / batch window ends
+  scheduler.scheduleIn(getMsUntilJournalReplay());
+
+  if (displayManager) {
+    scheduler.scheduleIn(displayManager->getMsUntilNextFrame());
+  }
+
+  // Startup message must clear before the first scan is attempted
+  unsigned long sinceStartup = millis() - startupTime;
+  if (sinceStartup < STARTUP_MESSAGE_DELAY) {
+    scheduler.scheduleIn(STARTUP_MESSAGE_DELAY - sinceStartup);
+  }
+
+  scheduler.wait(MAIN_LOOP_IDLE_MAX_WAIT);
+#else
+  scheduler.sleepFixed(MAIN_LOOP_DELAY);
+#endif
 }
 
-void TimerApplication::setupCallbacks() {
-  ITimerDevice* device = timerDevice.get();
+void TimerApplication::setupCallbacks(uint8_t lane) {
+  ITimerDevice* device = timers.get(lane);
   if (!device) return;
 
-  device->onShotDetected([this](const NormalizedShotData& shotData) {
-    onShotDetected(shotData);
+  device->onShotDetected([this, lane](const NormalizedShotData& shotData) {
+    onShotDetected(onLane(shotData, lane));
   });
 
-  device->onSessionStarted([this](const SessionData& sessionData) {
-    onSessionStarted(sessionData);
+  // Session changes queue behind this lane's shots; the main loop applies them
+  device->onSessionStarted([this, lane](const SessionData& sessionData) {
+    onSessionEvent(TimerEvent::Type::SESSION_STARTED, onLane(sessionData, lane));
   });
 
-  device->onCountdownComplete([this](const SessionData& sessionData) {
-    onCountdownComplete(sessionData);
+  device->onCountdownComplete([this, lane](const SessionData& sessionData) {
+    onSessionEvent(TimerEvent::Type::COUNTDOWN_COMPLETE, onLane(sessionData, lane));
   });
 
-  device->onSessionStopped([this](const SessionData& sessionData) {
-    onSessionStopped(sessionData);
+  device->onSessionStopped([this, lane](const SessionData& sessionData) {
+    onSessionEvent(TimerEvent::Type::SESSION_STOPPED, onLane(sessionData, lane));
   });
 
-  device->onSessionSuspended([this](const SessionData& sessionData) {
-    onSessionSuspended(sessionData);
+  device->onSessionSuspended([this, lane](const SessionData& sessionData) {
+    onSessionEvent(TimerEvent::Type::SESSION_SUSPENDED, onLane(sessionData, lane));
   });
 
-  device->onSessionResumed([this](const SessionData& sessionData) {
-    onSessionResumed(sessionData);
+  device->onSessionResumed([this, lane](const SessionData& sessionData) {
+    onSessionEvent(TimerEvent::Type::SESSION_RESUMED, onLane(sessionData, lane));
   });
 
-  device->onConnectionStateChanged([this](DeviceConnectionState state) {
-    onConnectionStateChanged(state);
+  // Fired from update()/attemptConnection() - already on the main loop
+  device->onConnectionStateChanged([this, lane](DeviceConnectionState state) {
+    onConnectionStateChanged(lane, state);
+    scheduler.signal(LoopEvent::BLE_EVENT);
   });
+
+  if (bleIngest) {
+    bleIngest->attach(lane, device);
+  }
+}
+
+void TimerApplication::releaseTimerDevice(uint8_t lane) {
+  // Ingest task must stop touching the device before it is destroyed
+  if (bleIngest) {
+    bleIngest->detach(lane);
+  }
+  std::unique_ptr<ITimerDevice> device = timers.take(lane);
+  if (device) {
+    // Its teardown must not report back into a lane that may be reused
+    device->onConnectionStateChanged(nullptr);
+  }
+  pendingRelease &= (uint8_t)~laneBit(lane);
+}
+
+void TimerApplication::releaseDisconnectedDevices() {
+  for (uint8_t lane = 0; pendingRelease != 0 && lane < timers.getCapacity(); lane++) {
+    if (pendingRelease & laneBit(lane)) {
+      releaseTimerDevice(lane);
+      LOG_BLE("Lane %u free - %u timer(s) still connected", (unsigned)(lane + 1), (unsigned)timers.count());
+    }
+  }
 }
 
 void TimerApplication::onShotDetected(const NormalizedShotData& shotData) {
-  // Update application state
-  lastShotNumber = shotData.shotNumber;
-  lastShotTime = shotData.absoluteTimeMs;
-  updateActivityTime();
+  ShotTrace::record(TraceStage::PARSED, shotData.traceOriginUs);
   logShotData(shotData);
 
   // ============================================================
-  // CRITICAL: Enqueue for async MQTT publishing using ring buffer
-  // This is called from BLE callback context - must be fast!
-  // Only queue if MQTT is available - don't buffer when unavailable
+  // CRITICAL: Hand off to the main loop through the lock-free ring
+  // This is called from the BLE ingest (or BLE stack) task - must be fast!
+  // Every lane is parsed on that one task, so the ring keeps one producer.
+  // Display, MQTT and application state belong to the main loop; it is
+  // woken immediately.
   // ============================================================
-  // Only publish to MQTT if TIMER_TYPE == TIMER_TYPE_BLE and connected to MQTT broker
-  bool shouldPublishMqtt = (TIMER_TYPE == TIMER_TYPE_BLE) && mqttManager && mqttManager->canPublish();
-
-  if (shouldPublishMqtt) {
-    if (xQueueSend(shotEventQueue, &shotData, 0) == pdTRUE) {
-      totalShotsQueued++;
-
-      // Track max queue depth for diagnostics
-      uint16_t depth = (uint16_t)uxQueueMessagesWaiting(shotEventQueue);
-      if (depth > maxQueueDepth) {
-        maxQueueDepth = depth;
-        if (maxQueueDepth > AppConfig::QUEUE_DEPTH_WARN_THRESHOLD) {
-          LOG_WARN("QUEUE", "Peak queue depth: %u/%u", maxQueueDepth, AppConfig::EVENT_QUEUE_SIZE);
-        }
+  TimerEvent event;
+  event.shot = shotData;
+  if (eventRing.push(event)) {
+    totalShotsQueued++;
+
+    // Track max queue depth for diagnostics
+    uint16_t depth = (uint16_t)eventRing.size();
+    if (depth > maxQueueDepth) {
+      maxQueueDepth = depth;
+      if (maxQueueDepth > AppConfig::QUEUE_DEPTH_WARN_THRESHOLD) {
+        LOG_WARN("QUEUE", "Peak queue depth: %u/%u", maxQueueDepth, AppConfig::EVENT_QUEUE_SIZE);
       }
-    } else {
-      // Queue full - this indicates MQTT can't keep up
-      publishFailures++;
-      LOG_ERROR("QUEUE", "Buffer full! Shot #%u dropped (failures: %lu)",
-                shotData.shotNumber, (unsigned long)publishFailures);
     }
+  } else {
+    // Ring full - main loop can't keep up
+    publishFailures++;
+    LOG_ERROR("QUEUE", "Buffer full! Shot #%u dropped (failures: %lu)",
+              shotData.shotNumber, (unsigned long)publishFailures);
   }
 
-  // Update display immediately (regardless of MQTT queue)
-  if (sessionActive && displayManager) {
-    displayManager->showShotData(shotData);
+  scheduler.signal(LoopEvent::SHOT);
+}
+
+void TimerApplication::onSessionEvent(TimerEvent::Type type, const SessionData& sessionData) {
+  // Latency histograms cover one session at a time (overlapping sessions share
+  // them). Reset here, before this session's first shot is parsed, rather than
+  // when the main loop gets to the event.
+  uint8_t bit = laneBit(sessionData.lane);
+  if (type == TimerEvent::Type::SESSION_STARTED) {
+    if ((tracedLanes & (uint8_t)~bit) == 0) {
+      ShotTrace::reset();
+    }
+    tracedLanes |= bit;
+  } else if (type == TimerEvent::Type::SESSION_STOPPED) {
+    tracedLanes &= (uint8_t)~bit;
   }
+
+  // Same ring as the shots, so a session never ends ahead of its last shots
+  TimerEvent event;
+  event.type = type;
+  event.session = sessionData;
+  if (!eventRing.push(event)) {
+    publishFailures++;
+    LOG_ERROR("QUEUE", "Buffer full! Session event %u dropped (lane %u)",
+              (unsigned)type, (unsigned)(sessionData.lane + 1));
+  }
+
+  // Session changes update the display - wake the loop to render
+  scheduler.signal(LoopEvent::BLE_EVENT);
 }
 
-void TimerApplication::onSessionStarted(const SessionData& sessionData) {
-  LOG_TIMER("Session started: ID %u, Countdown: %.1fs",
-            sessionData.sessionId, sessionData.startDelaySeconds);
+void TimerApplication::handleSessionStarted(const SessionData& sessionData) {
+  LOG_TIMER("Session started: ID %u, Countdown: %.1fs (lane %u)",
+            sessionData.sessionId, sessionData.startDelaySeconds, (unsigned)(sessionData.lane + 1));
 
-  sessionActive = true;
-  lastShotNumber = 0;
-  lastShotTime = 0;
+  if ((activeLanes & (uint8_t)~laneBit(sessionData.lane)) == 0) {
+    lastReportedTraceSamples = 0;  // Histograms were reset by the producer
+  }
+  activeLanes |= laneBit(sessionData.lane);
+  lastShotNumber[sessionData.lane] = 0;
+  lastShotTime[sessionData.lane] = 0;
 
   // Publish directly (session events are infrequent)
   if (mqttManager && mqttManager->canPublish()) {
-    mqttManager->publishSessionStarted(sessionData.sessionId, sessionData.startDelaySeconds);
+    mqttManager->publishSessionStarted(sessionData.sessionId, sessionData.startDelaySeconds,
+                                       laneSourceId(sessionData.lane));
   }
 
   if (displayManager) {
@@ -254,11 +390,11 @@ void TimerApplication::onSessionStarted(const SessionData& sessionData) {
   }
 }
 
-void TimerApplication::onCountdownComplete(const SessionData& sessionData) {
-  LOG_TIMER("Countdown complete - ready for shots");
+void TimerApplication::handleCountdownComplete(const SessionData& sessionData) {
+  LOG_TIMER("Countdown complete - ready for shots (lane %u)", (unsigned)(sessionData.lane + 1));
 
   if (mqttManager && mqttManager->canPublish()) {
-    mqttManager->publishCountdownComplete(sessionData.sessionId);
+    mqttManager->publishCountdownComplete(sessionData.sessionId, laneSourceId(sessionData.lane));
   }
 
   if (displayManager) {
@@ -266,47 +402,42 @@ void TimerApplication::onCountdownComplete(const SessionData& sessionData) {
   }
 }
 
-void TimerApplication::onSessionStopped(const SessionData& sessionData) {
-  LOG_TIMER("Session stopped: ID %u, Total shots: %d",
-            sessionData.sessionId, sessionData.totalShots);
-
-  sessionActive = false;
+void TimerApplication::handleSessionStopped(const SessionData& sessionData) {
+  LOG_TIMER("Session stopped: ID %u, Total shots: %d (lane %u)",
+            sessionData.sessionId, sessionData.totalShots, (unsigned)(sessionData.lane + 1));
 
-  // Clear any remaining queued shots on session end
-  // Stale shots arriving after session end should be discarded
-  UBaseType_t remaining = uxQueueMessagesWaiting(shotEventQueue);
-  if (remaining > 0) {
-    LOG_WARN("QUEUE", "Discarding %u queued shots on session end", (unsigned)remaining);
-    xQueueReset(shotEventQueue);
-  }
+  // Shots queued ahead of this event have already been displayed and journaled;
+  // any that arrive after it are journaled only
+  activeLanes &= (uint8_t)~laneBit(sessionData.lane);
 
-  // Publish session ended directly (not queued)
+  // Publish session ended directly (not journaled)
   if (mqttManager && mqttManager->canPublish()) {
-    mqttManager->publishSessionStopped(sessionData.sessionId, sessionData.totalShots, lastShotTime);
+    mqttManager->publishSessionStopped(sessionData.sessionId, sessionData.totalShots,
+                                       lastShotTime[sessionData.lane], laneSourceId(sessionData.lane));
   }
 
   if (displayManager) {
-    displayManager->showSessionEnd(sessionData, lastShotNumber);
+    displayManager->showSessionEnd(sessionData, lastShotNumber[sessionData.lane]);
   }
 }
 
-void TimerApplication::onSessionSuspended(const SessionData& sessionData) {
-  LOG_TIMER("Session suspended: ID %u, Total shots: %d",
-            sessionData.sessionId, sessionData.totalShots);
+void TimerApplication::handleSessionSuspended(const SessionData& sessionData) {
+  LOG_TIMER("Session suspended: ID %u, Total shots: %d (lane %u)",
+            sessionData.sessionId, sessionData.totalShots, (unsigned)(sessionData.lane + 1));
 
   if (mqttManager && mqttManager->canPublish()) {
-    mqttManager->publishSessionSuspended(sessionData.sessionId);
+    mqttManager->publishSessionSuspended(sessionData.sessionId, laneSourceId(sessionData.lane));
   }
 }
 
-void TimerApplication::onSessionResumed(const SessionData& sessionData) {
-  LOG_TIMER("Session resumed: ID %u, Total shots: %d",
-            sessionData.sessionId, sessionData.totalShots);
+void TimerApplication::handleSessionResumed(const SessionData& sessionData) {
+  LOG_TIMER("Session resumed: ID %u, Total shots: %d (lane %u)",
+            sessionData.sessionId, sessionData.totalShots, (unsigned)(sessionData.lane + 1));
 
-  sessionActive = true;
+  activeLanes |= laneBit(sessionData.lane);
 
   if (mqttManager && mqttManager->canPublish()) {
-    mqttManager->publishSessionResumed(sessionData.sessionId);
+    mqttManager->publishSessionResumed(sessionData.sessionId, laneSourceId(sessionData.lane));
   }
 
   if (displayManager) {
@@ -314,10 +445,14 @@ void TimerApplication::onSessionResumed(const SessionData& sessionData) {
   }
 }
 
-void TimerApplication::onConnectionStateChanged(DeviceConnectionState state) {
-  LOG_BLE("Connection state changed: %d", (int)state);
+void TimerApplication::onConnectionStateChanged(uint8_t lane, DeviceConnectionState state) {
+  LOG_BLE("Connection state changed: %d (lane %u)", (int)state, (unsigned)(lane + 1));
   updateActivityTime();
 
+  // Apply what this lane reported before the link changed, so e.g. its last
+  // shots and session end still come ahead of the disconnect
+  applyQueuedEvents(AppConfig::EVENT_QUEUE_SIZE);
+
   if (state == DeviceConnectionState::CONNECTED) {
     hadDeviceConnected = true;
   }
@@ -325,24 +460,26 @@ void TimerApplication::onConnectionStateChanged(DeviceConnectionState state) {
   // Get device info for MQTT publish
   const char* deviceName = nullptr;
   const char* deviceModel = nullptr;
-  if (timerDevice) {
-    deviceName = timerDevice->getDeviceName();
-    deviceModel = timerDevice->getDeviceModel();
+  ITimerDevice* device = timers.get(lane);
+  if (device) {
+    deviceName = device->getDeviceName();
+    deviceModel = device->getDeviceModel();
   }
 
   if (mqttManager && mqttManager->canPublish()) {
-    mqttManager->publishConnectionState(state, deviceName, deviceModel);
+    mqttManager->publishConnectionState(state, deviceName, deviceModel, laneSourceId(lane));
   }
 
   // Handle disconnection
   if (state == DeviceConnectionState::DISCONNECTED) {
-    if (sessionActive) {
-      sessionActive = false;
-    }
-    timerDevice.reset();  // Clean up so we can scan again
+    activeLanes &= (uint8_t)~laneBit(lane);
+    // The device is still inside its own callback - clean up after the
+    // update pass so we can scan again
+    pendingRelease |= laneBit(lane);
   }
 
-  if (displayManager) {
+  // Another lane's session keeps the screen
+  if (displayManager && activeLanes == 0) {
     displayManager->showConnectionState(state, deviceName);
   }
 }
@@ -364,14 +501,17 @@ void TimerApplication::performHealthCheck() {
 
   // Check component health
   bool displayHealthy = displayManager && displayManager->isInitialized();
-  bool timerHealthy = timerDevice != nullptr;
+  uint8_t connectedTimers = timers.count();
 
   if (!displayHealthy) {
     LOG_ERROR("HEALTH", "Display manager not healthy");
   }
 
-  if (!timerHealthy && hadDeviceConnected) {
+  if (connectedTimers == 0 && hadDeviceConnected) {
     LOG_ERROR("HEALTH", "Timer device lost connection");
+  } else if (connectedTimers > 0) {
+    LOG_DEBUG("HEALTH", "Timers: %u/%u connected, sessions on lanes 0x%02X",
+              (unsigned)connectedTimers, (unsigned)timers.getCapacity(), (unsigned)activeLanes);
   }
 
   // Activity timeout warning
@@ -382,50 +522,146 @@ void TimerApplication::performHealthCheck() {
   // Queue metrics (only if there's been activity)
   if (totalShotsQueued > 0) {
     LOG_DEBUG("HEALTH", "Queue: %u/%u, Published: %lu/%lu, Failures: %lu, Peak: %u",
-              (unsigned)uxQueueMessagesWaiting(shotEventQueue), AppConfig::EVENT_QUEUE_SIZE,
+              (unsigned)eventRing.size(), AppConfig::EVENT_QUEUE_SIZE,
               (unsigned long)totalShotsPublished,
               (unsigned long)totalShotsQueued,
               (unsigned long)publishFailures,
               maxQueueDepth);
   }
 
+  if (journalEnabled && journal.getStats().appended > 0) {
+    const ShotJournal::Stats& js = journal.getStats();
+    LOG_DEBUG("HEALTH", "Journal: %lu pending (%lu RAM, %lu flash), appended %lu, replayed %lu, spilled %lu, dropped %lu",
+              (unsigned long)journal.pending(), (unsigned long)journal.ramCount(),
+              (unsigned long)journal.spillCount(), (unsigned long)js.appended,
+              (unsigned long)js.replayed, (unsigned long)js.spilled, (unsigned long)js.dropped);
+  }
+
+  if (bleIngest && bleIngest->getProcessedCount() > 0) {
+    LOG_DEBUG("HEALTH", "BLE ingest: processed %lu, dropped %lu, peak %u/%u",
+              (unsigned long)bleIngest->getProcessedCount(),
+              (unsigned long)bleIngest->getDroppedCount(),
+              bleIngest->getPeakDepth(), (unsigned)(BleIngestTask::RING_SIZE - 1));
+  }
+
+  // Loop wake-ups and shot-to-render latency over the last interval
+  LoopScheduler::Stats loopStats = scheduler.takeStats();
+  LOG_DEBUG("HEALTH", "Loop: %lu wakes (%lu event, %lu deadline) in %lu ms",
+            (unsigned long)loopStats.wakes,
+            (unsigned long)loopStats.eventWakes,
+            (unsigned long)loopStats.deadlineWakes,
+            (unsigned long)loopStats.windowMs);
+
+  if (displayManager) {
+    displayManager->logFrameStats();
+  }
+
+  reportShotLatency();
+
   LOG_DEBUG("HEALTH", "Uptime: %lu ms, Free heap: %u bytes",
             getUptimeMs(), ESP.getFreeHeap());
 }
 
+void TimerApplication::reportShotLatency() {
+  // Only when new shots were traced since the last report
+  uint32_t samples = ShotTrace::getTotalSamples();
+  if (samples == 0 || samples == lastReportedTraceSamples) {
+    return;
+  }
+  lastReportedTraceSamples = samples;
+
+  ShotTrace::logSummary();
+
+  if (mqttManager && mqttManager->canPublish()) {
+    mqttManager->publishShotLatency();
+  }
+}
+
 void TimerApplication::updateActivityTime() {
   lastActivityTime = millis();
 }
 
-void TimerApplication::publishQueuedEvents() {
-  // Fast path - nothing to publish
-  if (!shotEventQueue || uxQueueMessagesWaiting(shotEventQueue) == 0) {
-    return;
+void TimerApplication::processQueuedEvents() {
+  applyQueuedEvents(AppConfig::MAX_SHOTS_PER_PUBLISH_CYCLE);
+
+  if (journalEnabled) {
+    replayJournal();
   }
+}
 
-  // Check MQTT availability
-  bool mqttReady = mqttManager && mqttManager->canPublish();
-
-  if (!mqttReady) {
-    // MQTT not available - discard buffered events (don't queue when offline)
-    UBaseType_t discarded = uxQueueMessagesWaiting(shotEventQueue);
-    if (discarded > 0) {
-      xQueueReset(shotEventQueue);
-      LOG_DEBUG("QUEUE", "MQTT unavailable - discarded %u queued shots", (unsigned)discarded);
-    }
+void TimerApplication::applyQueuedEvents(uint16_t maxEvents) {
+  // Fast path - nothing queued
+  if (eventRing.empty()) {
     return;
   }
 
+  // Check MQTT availability
+  // Only publish to MQTT if TIMER_TYPE == TIMER_TYPE_BLE and connected to MQTT broker
+  bool mqttReady = (TIMER_TYPE == TIMER_TYPE_BLE) && mqttManager && mqttManager->canPublish();
+
   // ============================================================
-  // BATCH PUBLISH: Process multiple shots per loop iteration
-  // This is the key optimization for fast BLE events
+  // BATCH PROCESS: Handle multiple events per loop iteration, in the
+  // order they were queued. This is the key optimization for fast BLE events
   // ============================================================
   uint16_t processed = 0;
-  NormalizedShotData shot;
-  while (xQueueReceive(shotEventQueue, &shot, 0) == pdTRUE &&
-         processed < AppConfig::MAX_SHOTS_PER_PUBLISH_CYCLE) {
+  uint16_t discarded = 0;
+  TimerEvent event;
+  while (processed < maxEvents && eventRing.pop(event)) {
+    processed++;
+
+    // Shots waiting out the batch window go ahead of the session change
+    if (event.type != TimerEvent::Type::SHOT && journalEnabled) {
+      replayJournal(/*closeBatch=*/true);
+    }
+
+    switch (event.type) {
+      case TimerEvent::Type::SHOT:
+        break;
+      case TimerEvent::Type::SESSION_STARTED:
+        handleSessionStarted(event.session);
+        continue;
+      case TimerEvent::Type::COUNTDOWN_COMPLETE:
+        handleCountdownComplete(event.session);
+        continue;
+      case TimerEvent::Type::SESSION_STOPPED:
+        handleSessionStopped(event.session);
+        continue;
+      case TimerEvent::Type::SESSION_SUSPENDED:
+        handleSessionSuspended(event.session);
+        continue;
+      case TimerEvent::Type::SESSION_RESUMED:
+        handleSessionResumed(event.session);
+        continue;
+    }
+
+    const NormalizedShotData& shot = event.shot;
+    ShotTrace::record(TraceStage::DEQUEUED, shot.traceOriginUs);
+
+    lastShotNumber[shot.lane] = shot.shotNumber;
+    lastShotTime[shot.lane] = shot.absoluteTimeMs;
+    updateActivityTime();
+
+    // Display first - it must not wait on the network. Shots that arrive
+    // after their session stopped are only journaled.
+    if ((activeLanes & laneBit(shot.lane)) && displayManager) {
+      displayManager->showShotData(shot);
+    }
+
+    if (journalEnabled) {
+      // Published in order from the journal
+      journalShot(shot);
+      continue;
+    }
+
+    if (!mqttReady) {
+      // MQTT not available - discard (don't buffer when offline)
+      discarded++;
+      continue;
+    }
+
     // Attempt to publish
-    if (mqttManager->publishShotDetected(shot)) {
+    if (mqttManager->publishShotDetected(shot, 0, laneSourceId(shot.lane))) {
+      ShotTrace::record(TraceStage::MQTT_PUBLISHED, shot.traceOriginUs);
       totalShotsPublished++;
       LOG_DEBUG("QUEUE", "Published shot #%u", shot.shotNumber);
     } else {
@@ -435,19 +671,168 @@ void TimerApplication::publishQueuedEvents() {
       // Stop processing this cycle - let MQTT reconnect
       break;
     }
+  }
 
-    processed++;
+  if (discarded > 0) {
+    LOG_DEBUG("QUEUE", "MQTT unavailable - discarded %u queued shots", discarded);
   }
 
   // Log batch processing stats
   if (processed > 1) {
-    LOG_DEBUG("QUEUE", "Batch published %u shots", processed);
+    LOG_DEBUG("QUEUE", "Batch processed %u events", processed);
+  }
+}
+
+void TimerApplication::initializeJournal() {
+  journalSpill = std::unique_ptr<LittleFsSpillStore>(new LittleFsSpillStore(AppConfig::JOURNAL_SPILL_MAX_BYTES));
+  if (!journalSpill->begin()) {
+    journalSpill.reset();  // RAM-only journal
+  }
+
+  if (!journal.begin(AppConfig::JOURNAL_RAM_CAPACITY, journalSpill.get())) {
+    LOG_ERROR("JOURNAL", "Shot journal allocation failed - shots are not buffered while offline");
+    journalSpill.reset();
+    return;
+  }
+
+  journalEnabled = true;
+  LOG_SYSTEM("Shot journal: %lu records in RAM, flash spill %s",
+             (unsigned long)journal.getRamCapacity(), journalSpill ? "enabled" : "disabled");
+}
+
+void TimerApplication::journalShot(const NormalizedShotData& shot) {
+  if (!journalOutage) {
+    journal.append(shot);
+    return;
+  }
+
+  // Delivery waits for the broker - keep it out of the latency histograms
+  NormalizedShotData offline = shot;
+  offline.traceOriginUs = 0;
+  journal.append(offline);
+}
+
+uint32_t TimerApplication::getMsUntilJournalReplay() const {
+  if (!journalEnabled || journal.pending() == 0 || !mqttManager || !mqttManager->canPublish()) {
+    return UINT32_MAX;
+  }
+  long remaining = (long)(journalReplayAt - millis());
+  return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+void TimerApplication::replayJournal(bool closeBatch) {
+  if (journal.pending() == 0) {
+    return;
+  }
+
+  if (!mqttManager->canPublish()) {
+    if (!journalOutage) {
+      journalOutage = true;
+      journal.clearTraceOrigins();
+      LOG_WARN("QUEUE", "MQTT unavailable - journaling shots (%lu pending)", (unsigned long)journal.pending());
+    }
+    return;
+  }
+
+  unsigned long now = millis();
+  if ((long)(now - journalRetryAt) < 0) {
+    journalReplayAt = journalRetryAt;
+    return;
+  }
+  journalReplayAt = now;
+
+  if (AppConfig::SHOT_BATCH_MAX_LATENCY_MS > 0) {
+    publishJournalBatch(closeBatch);
+  } else {
+    // Oldest first; a record only leaves the journal once the broker client accepted it
+    uint16_t published = 0;
+    JournalRecord record;
+    NormalizedShotData shot;
+    while (published < AppConfig::MAX_SHOTS_PER_PUBLISH_CYCLE && journal.peek(record)) {
+      ShotJournal::toShotData(record, shot);
+      if (!mqttManager->publishShotDetected(shot, record.seq, laneSourceId(record.lane))) {
+        publishFailures++;
+        journalRetryAt = journalReplayAt = millis() + AppConfig::JOURNAL_RETRY_MS;
+        LOG_WARN("QUEUE", "Failed to publish shot #%u - retrying in %lu ms",
+                 shot.shotNumber, (unsigned long)AppConfig::JOURNAL_RETRY_MS);
+        return;
+      }
+
+      journal.pop();
+      ShotTrace::record(TraceStage::MQTT_PUBLISHED, shot.traceOriginUs);
+      totalShotsPublished++;
+      published++;
+      LOG_DEBUG("QUEUE", "Published shot #%u (seq %lu)", shot.shotNumber, (unsigned long)record.seq);
+    }
+  }
+
+  if (journalOutage && journal.pending() == 0) {
+    journalOutage = false;
+    LOG_SYSTEM("Shot journal replay complete");
+  }
+}
+
+bool TimerApplication::publishJournalBatch(bool closeBatch) {
+  JournalRecord records[MqttManager::MAX_SHOT_BATCH];
+  uint16_t count = journal.peekBatch(records, MqttManager::MAX_SHOT_BATCH);
+  if (count == 0) {
+    return false;
+  }
+
+  // Hold the batch open until the oldest shot has waited out the window, unless
+  // it is already full or being closed early. A capture time "in the future"
+  // is from before a reset.
+  unsigned long now = millis();
+  unsigned long due = records[0].capturedMs + AppConfig::SHOT_BATCH_MAX_LATENCY_MS;
+  long wait = (long)(due - now);
+  if (!closeBatch && count < MqttManager::MAX_SHOT_BATCH && wait > 0 &&
+      (uint32_t)wait <= AppConfig::SHOT_BATCH_MAX_LATENCY_MS) {
+    journalReplayAt = due;
+    return false;
+  }
+
+  NormalizedShotData shot;
+  bool ok;
+  uint16_t batched = 0;
+  const char* sourceId = laneSourceId(records[0].lane);
+  if (count == 1 || records[1].sessionId != records[0].sessionId || records[1].lane != records[0].lane) {
+    // Lone shot - keep it on the per-shot topic
+    ShotJournal::toShotData(records[0], shot);
+    ok = mqttManager->publishShotDetected(shot, records[0].seq, sourceId);
+    batched = 1;
+  } else {
+    mqttManager->beginShotBatch(records[0].sessionId, records[0].deviceModel);
+    for (uint16_t i = 0; i < count; i++) {
+      ShotJournal::toShotData(records[i], shot);
+      if (records[i].lane != records[0].lane || !mqttManager->addToShotBatch(shot, records[i].seq)) {
+        break;  // Next lane or session (or buffer full) goes in the next message
+      }
+      batched++;
+    }
+    ok = batched > 0 && mqttManager->publishShotBatch(sourceId);
+  }
+
+  if (!ok) {
+    publishFailures++;
+    journalRetryAt = journalReplayAt = millis() + AppConfig::JOURNAL_RETRY_MS;
+    LOG_WARN("QUEUE", "Failed to publish %u shots - retrying in %lu ms",
+             batched, (unsigned long)AppConfig::JOURNAL_RETRY_MS);
+    return false;
+  }
+
+  for (uint16_t i = 0; i < batched; i++) {
+    journal.pop();
+    ShotTrace::record(TraceStage::MQTT_PUBLISHED, records[i].traceOriginUs);
   }
+  totalShotsPublished += batched;
+  LOG_DEBUG("QUEUE", "Published %u shots (seq %lu-%lu)", batched,
+            (unsigned long)records[0].seq, (unsigned long)records[batched - 1].seq);
+  return true;
 }
 
 bool TimerApplication::isHealthy() const {
   bool displayHealthy = displayManager && displayManager->isInitialized();
-  bool timerHealthy = timerDevice != nullptr;
+  bool timerHealthy = timers.count() > 0;
   bool activityHealthy = (millis() - lastActivityTime) < AppConfig::WATCHDOG_TIMEOUT_MS;
 
   return displayHealthy && timerHealthy && activityHealthy;
@@ -459,7 +844,7 @@ unsigned long TimerApplication::getUptimeMs() const {
 
 bool TimerApplication::isRuntimeReady() const {
   bool displayHealthy = displayManager && displayManager->isInitialized();
-  bool timerHealthy = timerDevice != nullptr;
+  bool timerHealthy = timers.count() > 0;
 
   return displayHealthy && timerHealthy;
 }
@@ -472,8 +857,16 @@ void TimerApplication::scanForDevices() {
     return;
   }
 
-  // Throttle scan attempts - wait 5 seconds between full scan cycles
-  if (isScanning || (now - lastScanAttempt < 5000)) {
+  // A scan competes with the open links for radio time - never during a session
+  if (isSessionActive()) {
+    return;
+  }
+
+  // Throttle scan attempts - retry quickly until a timer is connected, then
+  // only look for more now and then
+  bool anyConnected = timers.count() > 0;
+  unsigned long interval = anyConnected ? AppConfig::RESCAN_INTERVAL_MS : AppConfig::SCAN_RETRY_MS;
+  if (isScanning || (now - lastScanAttempt < interval)) {
     return;
   }
 
@@ -481,12 +874,16 @@ void TimerApplication::scanForDevices() {
   isScanning = true;
   scanResultsReady = false;
 
-  if (displayManager) {
-    displayManager->showConnectionState(DeviceConnectionState::SCANNING, nullptr);
+  if (anyConnected) {
+    LOG_BLE("Scanning for more timer devices (%u/%u connected)",
+            (unsigned)timers.count(), (unsigned)timers.getCapacity());
+  } else {
+    if (displayManager) {
+      displayManager->showConnectionState(DeviceConnectionState::SCANNING, nullptr);
+    }
+    LOG_SYSTEM("Scanning for compatible timer devices...");
   }
 
-  LOG_SYSTEM("Scanning for compatible timer devices...");
-
   // Unified BLE scan for all device types (MAC-based and UUID-based)
   BLEScan* pScan = BLEDevice::getScan();
   pScan->setActiveScan(true);
@@ -501,7 +898,28 @@ void TimerApplication::scanForDevices() {
     return;
   }
 
-  LOG_SYSTEM("BLE scan started (non-blocking)");
+  LOG_BLE("BLE scan started (non-blocking)");
+}
+
+template <typename Timer>
+bool TimerApplication::connectTimer(BLEAdvertisedDevice* advertised, const char* label) {
+  int lane = timers.freeLane(advertised->getAddress());
+  if (lane < 0) {
+    return false;
+  }
+
+  Timer* device = new Timer();
+  timers.assign((uint8_t)lane, std::unique_ptr<ITimerDevice>(device), advertised->getAddress());
+  setupCallbacks((uint8_t)lane);
+
+  if (device->initialize() && device->attemptConnection(advertised)) {
+    LOG_SYSTEM("Successfully connected to %s (lane %d)", label, lane + 1);
+    return true;
+  }
+
+  LOG_ERROR("TIMER", "Failed to connect to %s", label);
+  releaseTimerDevice((uint8_t)lane);
+  return false;
 }
 
 void TimerApplication::processScanResults() {
@@ -511,87 +929,42 @@ void TimerApplication::processScanResults() {
   BLEScanResults foundDevices = pScan->getResults();
   LOG_SYSTEM("Scan complete - found %d devices", foundDevices.getCount());
 
-  bool deviceFound = false;
-
-  // Check each discovered device against all known device types
-  for (int i = 0; i < foundDevices.getCount(); i++) {
+  // Check each discovered device against all known device types, connecting
+  // every timer not connected yet until all lanes are taken
+  for (int i = 0; i < foundDevices.getCount() && !timers.isFull(); i++) {
     BLEAdvertisedDevice device = foundDevices.getDevice(i);
+    if (timers.findLane(device.getAddress()) >= 0) {
+      continue;  // Already connected
+    }
 
     // Try MAC-based Special Pie Timer first (highest priority)
     if (SpecialPieM1A2F::matchesDevice(&device)) {
       LOG_SYSTEM("Found MAC-based Special Pie Timer (MAC: %s)",
                  device.getAddress().toString().c_str());
-
-      SpecialPieM1A2F* macDevice = new SpecialPieM1A2F();
-      timerDevice = std::unique_ptr<ITimerDevice>(macDevice);
-      setupCallbacks();
-
-      if (timerDevice->initialize() && macDevice->attemptConnection(&device)) {
-        LOG_SYSTEM("Successfully connected to Special Pie Timer (MAC-based)");
-        deviceFound = true;
-        break;
-      } else {
-        LOG_ERROR("TIMER", "Failed to connect to MAC-based Special Pie Timer");
-        timerDevice.reset();
-      }
+      connectTimer<SpecialPieM1A2F>(&device, "Special Pie Timer (MAC-based)");
     }
     // Try SG Timer
     else if (SGTimer::matchesDevice(&device)) {
       LOG_SYSTEM("Found SG Timer (UUID-based)");
-
-      SGTimer* sgDevice = new SGTimer();
-      timerDevice = std::unique_ptr<ITimerDevice>(sgDevice);
-      setupCallbacks();
-
-      if (timerDevice->initialize() && sgDevice->attemptConnection(&device)) {
-        LOG_SYSTEM("Successfully connected to SG Timer");
-        deviceFound = true;
-        break;
-      } else {
-        LOG_ERROR("TIMER", "Failed to connect to SG Timer");
-        timerDevice.reset();
-      }
+      connectTimer<SGTimer>(&device, "SG Timer");
     }
     // Try UUID-based Special Pie Timer
     else if (SpecialPieM1A2Plus::matchesDevice(&device)) {
       LOG_SYSTEM("Found UUID-based Special Pie Timer");
-
-      SpecialPieM1A2Plus* specialPieDevice = new SpecialPieM1A2Plus();
-      timerDevice = std::unique_ptr<ITimerDevice>(specialPieDevice);
-      setupCallbacks();
-
-      if (timerDevice->initialize() && specialPieDevice->attemptConnection(&device)) {
-        LOG_SYSTEM("Successfully connected to Special Pie Timer");
-        deviceFound = true;
-        break;
-      } else {
-        LOG_ERROR("TIMER", "Failed to connect to Special Pie Timer");
-        timerDevice.reset();
-      }
+      connectTimer<SpecialPieM1A2Plus>(&device, "Special Pie Timer");
     }
     // Try ASN Tracker
     else if (ASNTracker::matchesDevice(&device)) {
       LOG_SYSTEM("Found ASN Tracker");
-
-      ASNTracker* asnDevice = new ASNTracker();
-      timerDevice = std::unique_ptr<ITimerDevice>(asnDevice);
-      setupCallbacks();
-
-      if (timerDevice->initialize() && asnDevice->attemptConnection(&device)) {
-        LOG_SYSTEM("Successfully connected to ASN Tracker");
-        deviceFound = true;
-        break;
-      } else {
-        LOG_ERROR("TIMER", "Failed to connect to ASN Tracker");
-        timerDevice.reset();
-      }
+      connectTimer<ASNTracker>(&device, "ASN Tracker");
     }
   }
 
   pScan->clearResults();
 
-  if (!deviceFound) {
-    LOG_SYSTEM("No compatible timer devices found. Will retry in 5 seconds...");
+  if (timers.count() == 0) {
+    LOG_SYSTEM("No compatible timer devices found. Will retry in %lu seconds...",
+               (unsigned long)(AppConfig::SCAN_RETRY_MS / 1000));
   }
 
   isScanning = false;
@@ -0,0 +1,74 @@
+#include "TimerDeviceManager.h"
+#include <string.h>
+
+TimerDeviceManager::TimerDeviceManager(uint8_t maxDevices)
+  : capacity(maxDevices < MAX_TIMER_LANES ? maxDevices : MAX_TIMER_LANES) {
+  for (uint8_t lane = 0; lane < MAX_TIMER_LANES; lane++) {
+    lanes[lane].address[0] = '\0';
+  }
+}
+
+void TimerDeviceManager::formatAddress(const BLEAddress& address, char* out) {
+  strncpy(out, address.toString().c_str(), ADDRESS_SIZE - 1);
+  out[ADDRESS_SIZE - 1] = '\0';
+}
+
+int TimerDeviceManager::findLane(const BLEAddress& address) const {
+  char wanted[ADDRESS_SIZE];
+  formatAddress(address, wanted);
+  for (uint8_t lane = 0; lane < capacity; lane++) {
+    if (lanes[lane].device && strcmp(lanes[lane].address, wanted) == 0) {
+      return lane;
+    }
+  }
+  return -1;
+}
+
+int TimerDeviceManager::freeLane(const BLEAddress& address) const {
+  char wanted[ADDRESS_SIZE];
+  formatAddress(address, wanted);
+
+  // Same timer back on its old lane, so its topics don't move
+  for (uint8_t lane = 0; lane < capacity; lane++) {
+    if (!lanes[lane].device && strcmp(lanes[lane].address, wanted) == 0) {
+      return lane;
+    }
+  }
+  // Then a lane no other timer has used
+  for (uint8_t lane = 0; lane < capacity; lane++) {
+    if (!lanes[lane].device && lanes[lane].address[0] == '\0') {
+      return lane;
+    }
+  }
+  for (uint8_t lane = 0; lane < capacity; lane++) {
+    if (!lanes[lane].device) {
+      return lane;
+    }
+  }
+  return -1;
+}
+
+void TimerDeviceManager::assign(uint8_t lane, std::unique_ptr<ITimerDevice> device, const BLEAddress& address) {
+  if (lane >= capacity) {
+    return;
+  }
+  lanes[lane].device = std::move(device);
+  formatAddress(address, lanes[lane].address);
+}
+
+std::unique_ptr<ITimerDevice> TimerDeviceManager::take(uint8_t lane) {
+  if (lane >= capacity) {
+    return nullptr;
+  }
+  return std::move(lanes[lane].device);
+}
+
+uint8_t TimerDeviceManager::count() const {
+  uint8_t n = 0;
+  for (uint8_t lane = 0; lane < capacity; lane++) {
+    if (lanes[lane].device) {
+      n++;
+    }
+  }
+  return n;
+}
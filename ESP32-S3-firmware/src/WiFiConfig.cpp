@@ -47,6 +47,7 @@ char WiFiConfig::mqtt_user[41] = MQTT_USER;
 char WiFiConfig::mqtt_password[41] = MQTT_PASSWORD;
 char WiFiConfig::timer_type[7] = "";
 char WiFiConfig::startup_text[41] = STARTUP_TEXT;
+uint32_t WiFiConfig::startupTextRevision = 0;
 
 // Persistent WiFiManager custom parameters (required for non-blocking portal)
 WiFiManagerParameter* WiFiConfig::customMqttServer = nullptr;
@@ -74,6 +75,7 @@ void WiFiConfig::loadConfiguration() {
   prefs.getString("mqtt_pass",   MQTT_PASSWORD).toCharArray(mqtt_password, sizeof(mqtt_password));
   snprintf(timer_type, sizeof(timer_type), "%d", prefs.getInt("timer_type", TIMER_TYPE));
   prefs.getString("startup_text", STARTUP_TEXT).toCharArray(startup_text, sizeof(startup_text));
+  startupTextRevision++;
 
   prefs.end();
 
@@ -144,6 +146,7 @@ void WiFiConfig::initialize() {
     copyIfProvided(mqtt_password, sizeof(mqtt_password), customMqttPassword, "mqtt_password");
     copyIfProvided(timer_type,    sizeof(timer_type),    customTimerType,    "timer_type");
     copyIfProvided(startup_text,  sizeof(startup_text),  customStartupText,  "startup_text");
+    startupTextRevision++;
     WiFiConfig::saveConfiguration();
   });
 
@@ -228,6 +231,10 @@ bool WiFiConfig::isConnected() {
   return (WiFi.status() == WL_CONNECTED);
 }
 
+bool WiFiConfig::isPortalActive() {
+  return wifiManager.getConfigPortalActive() || wifiManager.getWebPortalActive();
+}
+
 String WiFiConfig::getLocalIP() {
   if (isConnected()) {
     return WiFi.localIP().toString();
@@ -273,6 +280,7 @@ void WiFiConfig::resetWiFiSettings() {
   LOG_SYSTEM("Resetting WiFi settings");
   wifiManager.resetSettings();
   wifiConnected = false;
+  Logger::flush();  // Print queued lines before the reset
   ESP.restart();
 }
 
@@ -300,3 +308,7 @@ int WiFiConfig::getTimerType() {
 const char* WiFiConfig::getStartupText() {
   return startup_text[0] ? startup_text : STARTUP_TEXT;
 }
+
+uint32_t WiFiConfig::getStartupTextRevision() {
+  return startupTextRevision;
+}
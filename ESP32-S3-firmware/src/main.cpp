@@ -13,7 +13,11 @@ void setup() {
   Serial.begin(SERIAL_BAUD_RATE);
 
   // Set logging level
+#ifdef DEBUG_BUILD
+  Logger::setLevel(LogLevel::DEBUG);
+#else
   Logger::setLevel(LogLevel::INFO);
+#endif
 
   deviceId.initialize();
 
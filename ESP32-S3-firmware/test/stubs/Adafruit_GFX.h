@@ -0,0 +1,75 @@
+/**
+ * @file Adafruit_GFX.h
+ * @brief Minimal Adafruit_GFX base class stub for native (host) testing.
+ *
+ * Mirrors the virtual drawing primitives of the real library so that
+ * off-screen canvases (ShadowFramebuffer) and recording panels can be
+ * exercised without hardware. Default implementations decompose into
+ * drawPixel() like the real base class.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+class Adafruit_GFX {
+public:
+  Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+  virtual ~Adafruit_GFX() {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+  }
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+  }
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) drawFastHLine(x, y + i, w, color);
+  }
+  virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+  void setTextWrap(bool) {}
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+protected:
+  int16_t _width;
+  int16_t _height;
+};
+
+// 1-bit off-screen canvas (GlyphAtlas scratch surface)
+class GFXcanvas1 : public Adafruit_GFX {
+public:
+  GFXcanvas1(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), buffer(new uint8_t[((w + 7) / 8) * h]()) {}
+  GFXcanvas1(const GFXcanvas1&) = delete;
+  GFXcanvas1& operator=(const GFXcanvas1&) = delete;
+  ~GFXcanvas1() { delete[] buffer; }
+
+  uint8_t* getBuffer() const { return buffer; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t* byte = &buffer[y * ((_width + 7) / 8) + x / 8];
+    if (color) {
+      *byte |= (uint8_t)(0x80 >> (x & 7));
+    } else {
+      *byte &= (uint8_t)~(0x80 >> (x & 7));
+    }
+  }
+
+  bool getPixel(int16_t x, int16_t y) const {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return false;
+    return (buffer[y * ((_width + 7) / 8) + x / 8] & (0x80 >> (x & 7))) != 0;
+  }
+
+  void fillScreen(uint16_t color) override {
+    memset(buffer, color ? 0xFF : 0x00, ((_width + 7) / 8) * _height);
+  }
+
+private:
+  uint8_t* buffer;
+};
@@ -12,6 +12,7 @@
 #include <cstdio>
 #include <cstdarg>
 #include <cstring>
+#include <functional>
 #include <string>
 
 // ── Arduino-compatible type aliases ──────────────────────────────
@@ -26,10 +27,26 @@ namespace ArduinoMock {
   inline void setMillis(unsigned long ms) { millisValue() = ms; }
   inline void advanceMillis(unsigned long delta) { millisValue() += delta; }
   inline void resetMillis() { millisValue() = 0; }
+
+  // The calling task blocks for up to `ms`; `woken` (may be empty) ends the
+  // wait early. A simulation installs sleepHook() to run other work (BLE
+  // notifications, ...) in that time; without one the clock just advances.
+  typedef std::function<void(unsigned long ms, const std::function<bool()>& woken)> SleepHook;
+  inline SleepHook& sleepHook() {
+    static SleepHook hook;
+    return hook;
+  }
+  inline void sleep(unsigned long ms, const std::function<bool()>& woken = nullptr) {
+    if (sleepHook()) {
+      sleepHook()(ms, woken);
+    } else {
+      millisValue() += ms;
+    }
+  }
 }
 
 inline unsigned long millis() { return ArduinoMock::millisValue(); }
-inline void delay(unsigned long ms) { ArduinoMock::millisValue() += ms; }
+inline void delay(unsigned long ms) { ArduinoMock::sleep(ms); }
 
 // ── Minimal Serial stub (output goes to stderr) ─────────────────
 class HardwareSerial {
@@ -49,6 +66,7 @@ public:
   void print(const char* s)   { fprintf(stderr, "%s", s); }
 
   size_t write(uint8_t c) { fputc(c, stderr); return 1; }
+  size_t write(const uint8_t* data, size_t size) { return fwrite(data, 1, size, stderr); }
 };
 
 // Single global instance (matches Arduino runtime)
@@ -64,6 +82,7 @@ public:
   String() = default;
   String(const char* s) : _data(s ? s : "") {}
   String(const std::string& s) : _data(s) {}
+  explicit String(int value) : _data(std::to_string(value)) {}
   String(const String&) = default;
   String& operator=(const String&) = default;
 
@@ -71,6 +90,14 @@ public:
 
   const char* c_str() const { return _data.c_str(); }
   size_t length() const     { return _data.length(); }
+  bool isEmpty() const      { return _data.empty(); }
+
+  void toCharArray(char* buf, size_t size) const {
+    if (!buf || size == 0) return;
+    size_t n = _data.length() < size - 1 ? _data.length() : size - 1;
+    memcpy(buf, _data.data(), n);
+    buf[n] = '\0';
+  }
 
   bool startsWith(const char* prefix) const {
     if (!prefix) return false;
@@ -102,10 +129,13 @@ public:
 class EspClass {
 public:
   uint32_t getFreeHeap() { return 300000; }
+  void restart() {}
 };
 
 inline EspClass ESP;
 
+#define IRAM_ATTR
+
 // ── FreeRTOS stubs ──────────────────────────────────────────────
 #define pdMS_TO_TICKS(ms) (ms)
-inline void vTaskDelay(unsigned long) {}
+inline void vTaskDelay(unsigned long ticks) { ArduinoMock::sleep(ticks); }
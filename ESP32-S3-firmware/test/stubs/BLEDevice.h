@@ -5,12 +5,21 @@
  * Provides type-compatible stubs for all BLE classes used by the firmware.
  * Methods are no-ops or return safe defaults — only protocol parsing
  * logic needs to work, not actual BLE communication.
+ *
+ * A simulation can script a peer through BLEMock: devices the scan finds,
+ * the services the peer exposes, whether it is in range, and notify()
+ * to deliver a notification through the registered callback. Each client
+ * has its own service and characteristic, so several peers can be
+ * connected at once; notifyPeer() delivers to one of them by address.
  */
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <cstring>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 // ── Forward declarations ────────────────────────────────────────
 class BLEClient;
@@ -43,14 +52,67 @@ public:
   bool operator==(const BLEAddress& other) const { return _addr == other._addr; }
 };
 
+typedef void (*notify_callback)(BLERemoteCharacteristic*, uint8_t*, size_t, bool);
+
+// ── Scriptable peer (simulation hooks) ──────────────────────────
+namespace BLEMock {
+  inline std::vector<BLEAdvertisedDevice>& advertised();  // Defined below BLEAdvertisedDevice
+
+  // Service UUIDs the connected peer exposes (getService() finds only these)
+  inline std::vector<std::string>& services() {
+    static std::vector<std::string> uuids;
+    return uuids;
+  }
+  // Peer in range: scans see it, connects succeed, links stay up
+  inline bool& inRange() {
+    static bool up = true;
+    return up;
+  }
+  // Peers out of range while others stay reachable (by address)
+  inline std::vector<std::string>& outOfRangePeers() {
+    static std::vector<std::string> peers;
+    return peers;
+  }
+  inline bool peerInRange(const std::string& address) {
+    const std::vector<std::string>& away = outOfRangePeers();
+    return inRange() && std::find(away.begin(), away.end(), address) == away.end();
+  }
+  // Most recent subscription - notify() delivers here; clear to end it
+  inline notify_callback& notifyCallback() {
+    static notify_callback callback = nullptr;
+    return callback;
+  }
+  inline BLERemoteCharacteristic*& notifyCharacteristic() {
+    static BLERemoteCharacteristic* characteristic = nullptr;
+    return characteristic;
+  }
+  // Every live subscription, for notifyPeer()
+  inline std::vector<BLERemoteCharacteristic*>& subscriptions() {
+    static std::vector<BLERemoteCharacteristic*> subscribed;
+    return subscribed;
+  }
+  inline void reset();
+  inline bool notify(const uint8_t* data, size_t length);
+  inline bool notifyPeer(const std::string& address, const uint8_t* data, size_t length);
+  inline void unsubscribe(BLERemoteCharacteristic* characteristic);
+}
+
 // ── BLERemoteCharacteristic ─────────────────────────────────────
 class BLERemoteCharacteristic {
 public:
+  std::string peer;                    // Address of the connected peer
+  notify_callback callback = nullptr;  // Set by registerForNotify()
+
   bool canNotify() { return true; }
   bool canRead()   { return true; }
 
-  void registerForNotify(
-    void (*callback)(BLERemoteCharacteristic*, uint8_t*, size_t, bool)) {}
+  void registerForNotify(notify_callback cb) {
+    BLEMock::unsubscribe(this);
+    callback = cb;
+    BLEMock::subscriptions().push_back(this);
+    BLEMock::notifyCallback() = cb;
+    BLEMock::notifyCharacteristic() = this;
+  }
 
   std::string readValue() { return ""; }
   BLEUUID getUUID() { return BLEUUID(); }
@@ -59,26 +121,41 @@ public:
 // ── BLERemoteService ────────────────────────────────────────────
 class BLERemoteService {
 public:
-  BLERemoteCharacteristic* getCharacteristic(const char* uuid) { return nullptr; }
-  BLERemoteCharacteristic* getCharacteristic(const BLEUUID& uuid) { return nullptr; }
+  // Scripted services expose every characteristic (one per client)
+  BLERemoteCharacteristic* getCharacteristic(const char*) { return &characteristic; }
+  BLERemoteCharacteristic* getCharacteristic(const BLEUUID&) { return &characteristic; }
+
+  BLERemoteCharacteristic characteristic;
 };
 
 // ── BLEClient ───────────────────────────────────────────────────
 class BLEClient {
   bool _connected = false;
+  BLERemoteService _service;
 public:
-  bool connect(BLEAdvertisedDevice* device) { _connected = true; return true; }
-  bool connect(BLEAddress addr) { _connected = true; return true; }
+  ~BLEClient() { BLEMock::unsubscribe(&_service.characteristic); }
+
+  bool connect(BLEAdvertisedDevice* device);
+  bool connect(BLEAddress addr) {
+    _service.characteristic.peer = addr.toString();
+    _connected = BLEMock::peerInRange(addr.toString());
+    return _connected;
+  }
   void disconnect() { _connected = false; }
-  bool isConnected() { return _connected; }
-  BLERemoteService* getService(const char* uuid) { return nullptr; }
-  BLERemoteService* getService(const BLEUUID& uuid) { return nullptr; }
+  bool isConnected() { return _connected && BLEMock::peerInRange(_service.characteristic.peer); }
+  BLERemoteService* getService(const char* uuid) { return getService(BLEUUID(uuid)); }
+  BLERemoteService* getService(const BLEUUID& uuid) {
+    for (const std::string& exposed : BLEMock::services()) {
+      if (BLEUUID(exposed) == uuid) return &_service;
+    }
+    return nullptr;
+  }
 };
 
 // ── BLEScanResults ──────────────────────────────────────────────
 class BLEScanResults {
 public:
-  int getCount() { return 0; }
+  int getCount();
   BLEAdvertisedDevice getDevice(int idx);
 };
 
@@ -88,13 +165,13 @@ public:
   void setActiveScan(bool) {}
   void setInterval(uint16_t) {}
   void setWindow(uint16_t) {}
-  bool start(uint32_t duration, void (*scanCompleteCB)(BLEScanResults), bool is_continue = false) {
+  bool start(uint32_t, void (*scanCompleteCB)(BLEScanResults), bool = false) {
     if (scanCompleteCB) {
       scanCompleteCB(BLEScanResults());
     }
     return true;
   }
-  BLEScanResults start(uint32_t duration, bool is_continue = false) { return BLEScanResults(); }
+  BLEScanResults start(uint32_t, bool = false) { return BLEScanResults(); }
   BLEScanResults getResults() { return BLEScanResults(); }
   void stop() {}
   void clearResults() {}
@@ -122,8 +199,69 @@ public:
   BLEAddress getAddress() { return _addr; }
 };
 
-// Deferred definition (needs BLEAdvertisedDevice to be complete)
-inline BLEAdvertisedDevice BLEScanResults::getDevice(int idx) { return BLEAdvertisedDevice(); }
+// Deferred definitions (need BLEAdvertisedDevice to be complete)
+inline std::vector<BLEAdvertisedDevice>& BLEMock::advertised() {
+  static std::vector<BLEAdvertisedDevice> devices;
+  return devices;
+}
+
+inline bool BLEClient::connect(BLEAdvertisedDevice* device) {
+  return connect(device->getAddress());
+}
+
+inline void BLEMock::reset() {
+  advertised().clear();
+  services().clear();
+  inRange() = true;
+  notifyCallback() = nullptr;
+  notifyCharacteristic() = nullptr;
+  subscriptions().clear();
+  outOfRangePeers().clear();
+}
+
+inline void BLEMock::unsubscribe(BLERemoteCharacteristic* characteristic) {
+  std::vector<BLERemoteCharacteristic*>& subscribed = subscriptions();
+  for (size_t i = 0; i < subscribed.size(); i++) {
+    if (subscribed[i] == characteristic) {
+      subscribed.erase(subscribed.begin() + i);
+      break;
+    }
+  }
+  if (notifyCharacteristic() == characteristic) {
+    notifyCharacteristic() = nullptr;
+    notifyCallback() = nullptr;
+  }
+}
+
+// Delivers a notification as the BLE stack would; false if nothing is subscribed
+inline bool BLEMock::notify(const uint8_t* data, size_t length) {
+  if (!notifyCallback() || !notifyCharacteristic() || !inRange()) return false;
+  std::vector<uint8_t> copy(data, data + length);
+  notifyCallback()(notifyCharacteristic(), copy.data(), copy.size(), true);
+  return true;
+}
+
+// Same, for the subscription on the link to one peer
+inline bool BLEMock::notifyPeer(const std::string& address, const uint8_t* data, size_t length) {
+  if (!peerInRange(address)) return false;
+  for (BLERemoteCharacteristic* characteristic : subscriptions()) {
+    if (characteristic->peer == address && characteristic->callback) {
+      std::vector<uint8_t> copy(data, data + length);
+      characteristic->callback(characteristic, copy.data(), copy.size(), true);
+      return true;
+    }
+  }
+  return false;
+}
+
+inline int BLEScanResults::getCount() {
+  return BLEMock::inRange() ? (int)BLEMock::advertised().size() : 0;
+}
+
+inline BLEAdvertisedDevice BLEScanResults::getDevice(int idx) {
+  if (idx < 0 || idx >= getCount()) return BLEAdvertisedDevice();
+  return BLEMock::advertised()[idx];
+}
 
 // ── BLEDevice (static API) ──────────────────────────────────────
 class BLEDevice {
@@ -0,0 +1,63 @@
+/**
+ * @file ESP32-HUB75-MatrixPanel-I2S-DMA.h
+ * @brief HUB75 DMA panel stub for native testing.
+ *
+ * Accepts the configuration the firmware sets and counts the pixels
+ * pushed to the panel, so a test can see frames land without hardware.
+ */
+#pragma once
+
+#include <cstdint>
+#include "Adafruit_GFX.h"
+
+struct HUB75_I2S_CFG {
+  enum shift_driver { SHIFTREG = 0, FM6124, FM6126A, ICN2038S, MBI5124, SM5266P };
+  enum clk_speed { HZ_8M = 8000000, HZ_10M = 10000000, HZ_15M = 15000000, HZ_20M = 20000000 };
+
+  struct i2s_pins {
+    int8_t r1, g1, b1, r2, g2, b2, a, b, c, d, e, lat, oe, clk;
+  };
+
+  uint16_t mx_width;
+  uint16_t mx_height;
+  uint16_t chain_length;
+  i2s_pins gpio;
+  shift_driver driver;
+  clk_speed i2sspeed;
+  bool double_buff;
+  uint8_t latch_blanking;
+  bool clkphase;
+  uint16_t min_refresh_rate;
+
+  HUB75_I2S_CFG(uint16_t width = 64, uint16_t height = 32, uint16_t chain = 1)
+    : mx_width(width), mx_height(height), chain_length(chain), gpio(),
+      driver(SHIFTREG), i2sspeed(HZ_8M), double_buff(false), latch_blanking(1),
+      clkphase(true), min_refresh_rate(60) {}
+};
+
+class MatrixPanel_I2S_DMA : public Adafruit_GFX {
+public:
+  explicit MatrixPanel_I2S_DMA(const HUB75_I2S_CFG& config)
+    : Adafruit_GFX(config.mx_width * config.chain_length, config.mx_height),
+      config(config), pixelsDrawn(0), flips(0) {}
+
+  bool begin() { return true; }
+  void setBrightness8(uint8_t) {}
+  void clearScreen() {}
+  void flipDMABuffer() { flips++; }
+
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) const {
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+  }
+
+  void drawPixel(int16_t, int16_t, uint16_t) override { pixelsDrawn++; }
+
+  // Test introspection
+  uint32_t getPixelsDrawn() const { return pixelsDrawn; }
+  uint32_t getFlips() const { return flips; }
+
+private:
+  HUB75_I2S_CFG config;
+  uint32_t pixelsDrawn;
+  uint32_t flips;
+};
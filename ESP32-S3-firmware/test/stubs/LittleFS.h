@@ -0,0 +1,119 @@
+/**
+ * @file LittleFS.h
+ * @brief In-memory LittleFS stub for native testing.
+ *
+ * Files live in a map keyed by path for the lifetime of the process;
+ * LittleFSMock::reset() wipes them, LittleFSMock::mountFails() makes
+ * begin() fail and LittleFSMock::writeBudget() caps the bytes later writes
+ * may store (a short write, as on a full partition).
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace LittleFSMock {
+typedef std::vector<uint8_t> Data;
+
+inline std::map<std::string, std::shared_ptr<Data>>& files() {
+  static std::map<std::string, std::shared_ptr<Data>> all;
+  return all;
+}
+inline bool& mountFails() {
+  static bool fails = false;
+  return fails;
+}
+inline size_t& writeBudget() {
+  static size_t budget = std::numeric_limits<size_t>::max();
+  return budget;
+}
+inline void reset() {
+  files().clear();
+  mountFails() = false;
+  writeBudget() = std::numeric_limits<size_t>::max();
+}
+}  // namespace LittleFSMock
+
+class File {
+public:
+  File() : pos(0), append(false) {}
+  File(std::shared_ptr<LittleFSMock::Data> data, size_t pos, bool append)
+    : data(data), pos(pos), append(append) {}
+
+  explicit operator bool() const { return data != nullptr; }
+
+  size_t read(uint8_t* buf, size_t size) {
+    if (!data || pos >= data->size()) return 0;
+    size_t n = data->size() - pos < size ? data->size() - pos : size;
+    memcpy(buf, data->data() + pos, n);
+    pos += n;
+    return n;
+  }
+
+  size_t write(const uint8_t* buf, size_t size) {
+    if (!data) return 0;
+    if (append) pos = data->size();
+    size_t& budget = LittleFSMock::writeBudget();
+    if (size > budget) size = budget;
+    budget -= size;
+    if (pos + size > data->size()) data->resize(pos + size);
+    memcpy(data->data() + pos, buf, size);
+    pos += size;
+    return size;
+  }
+
+  bool seek(uint32_t offset) {
+    if (!data || offset > data->size()) return false;
+    pos = offset;
+    return true;
+  }
+
+  size_t size() const { return data ? data->size() : 0; }
+  void close() { data.reset(); }
+
+private:
+  std::shared_ptr<LittleFSMock::Data> data;
+  size_t pos;
+  bool append;
+};
+
+class LittleFSFS {
+public:
+  bool begin(bool formatOnFail = false) {
+    (void)formatOnFail;
+    return !LittleFSMock::mountFails();
+  }
+
+  bool exists(const char* path) { return LittleFSMock::files().count(path) != 0; }
+
+  bool remove(const char* path) { return LittleFSMock::files().erase(path) != 0; }
+
+  File open(const char* path, const char* mode) {
+    auto& files = LittleFSMock::files();
+    auto it = files.find(path);
+    std::string m = mode ? mode : "r";
+    if (m == "w") {
+      auto data = std::make_shared<LittleFSMock::Data>();
+      files[path] = data;
+      return File(data, 0, false);
+    }
+    if (m == "a") {
+      if (it == files.end()) {
+        it = files.emplace(path, std::make_shared<LittleFSMock::Data>()).first;
+      }
+      return File(it->second, it->second->size(), true);
+    }
+    // "r" / "r+" - the file must exist
+    if (it == files.end()) {
+      return File();
+    }
+    return File(it->second, 0, false);
+  }
+};
+
+inline LittleFSFS LittleFS;
@@ -0,0 +1,66 @@
+/**
+ * @file Preferences.h
+ * @brief NVS Preferences stub for native testing.
+ *
+ * All instances share one in-memory store, so a test can preset values
+ * (e.g. the MQTT server) with PreferencesMock::set() before the firmware
+ * reads them.
+ */
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include "Arduino.h"
+
+namespace PreferencesMock {
+inline std::map<std::string, std::string>& store() {
+  static std::map<std::string, std::string> values;
+  return values;
+}
+inline void set(const char* ns, const char* key, const char* value) {
+  store()[std::string(ns) + "/" + key] = value;
+}
+inline void reset() { store().clear(); }
+}  // namespace PreferencesMock
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false) {
+    ns = name ? name : "";
+    (void)readOnly;
+    return true;
+  }
+  void end() {}
+
+  String getString(const char* key, const String& defaultValue = String()) {
+    auto it = PreferencesMock::store().find(path(key));
+    return it == PreferencesMock::store().end() ? defaultValue : String(it->second);
+  }
+  size_t putString(const char* key, const String& value) {
+    PreferencesMock::store()[path(key)] = value.c_str();
+    return value.length();
+  }
+
+  int32_t getInt(const char* key, int32_t defaultValue = 0) {
+    auto it = PreferencesMock::store().find(path(key));
+    return it == PreferencesMock::store().end() ? defaultValue : (int32_t)atoi(it->second.c_str());
+  }
+  size_t putInt(const char* key, int32_t value) {
+    PreferencesMock::store()[path(key)] = std::to_string(value);
+    return sizeof(value);
+  }
+
+  bool clear() {
+    std::string prefix = ns + "/";
+    auto& values = PreferencesMock::store();
+    for (auto it = values.begin(); it != values.end();) {
+      it = it->first.compare(0, prefix.size(), prefix) == 0 ? values.erase(it) : std::next(it);
+    }
+    return true;
+  }
+
+private:
+  std::string ns;
+  std::string path(const char* key) const { return ns + "/" + key; }
+};
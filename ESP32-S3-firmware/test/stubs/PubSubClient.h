@@ -0,0 +1,93 @@
+/**
+ * @file PubSubClient.h
+ * @brief PubSubClient stub for native testing.
+ *
+ * Records every accepted publish in PubSubMock::published(). The broker is
+ * reachable unless a test sets PubSubMock::brokerUp() = false; a dropped
+ * broker (or WiFi link) ends the session until the firmware reconnects.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "WiFi.h"
+
+namespace PubSubMock {
+struct Message {
+  std::string topic;
+  std::string payload;
+  bool retain;
+  unsigned long atMs;
+};
+
+inline std::vector<Message>& published() {
+  static std::vector<Message> messages;
+  return messages;
+}
+inline bool& brokerUp() {
+  static bool up = true;
+  return up;
+}
+inline void reset() {
+  published().clear();
+  brokerUp() = true;
+}
+}  // namespace PubSubMock
+
+#define MQTT_CONNECTION_TIMEOUT -4
+#define MQTT_DISCONNECTED       -1
+#define MQTT_CONNECTED           0
+
+class PubSubClient {
+public:
+  explicit PubSubClient(WiFiClient&) : session(false), lastState(MQTT_DISCONNECTED) {}
+
+  PubSubClient& setServer(const char*, uint16_t) { return *this; }
+  bool setBufferSize(uint16_t) { return true; }
+  PubSubClient& setSocketTimeout(uint16_t) { return *this; }
+  PubSubClient& setKeepAlive(uint16_t) { return *this; }
+
+  bool connect(const char* id, const char* willTopic, uint8_t willQos, bool willRetain,
+               const char* willMessage) {
+    return connect(id, nullptr, nullptr, willTopic, willQos, willRetain, willMessage);
+  }
+  bool connect(const char*, const char*, const char*, const char*, uint8_t, bool, const char*) {
+    session = reachable();
+    lastState = session ? MQTT_CONNECTED : MQTT_CONNECTION_TIMEOUT;
+    return session;
+  }
+
+  bool connected() {
+    if (session && !reachable()) {
+      session = false;
+      lastState = MQTT_CONNECTION_TIMEOUT;
+    }
+    return session;
+  }
+
+  bool loop() { return connected(); }
+
+  void disconnect() {
+    session = false;
+    lastState = MQTT_DISCONNECTED;
+  }
+
+  int state() { return lastState; }
+
+  bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retain) {
+    if (!connected()) {
+      return false;
+    }
+    PubSubMock::published().push_back(
+      {topic, std::string(reinterpret_cast<const char*>(payload), length), retain, millis()});
+    return true;
+  }
+
+private:
+  bool session;
+  int lastState;
+
+  static bool reachable() { return PubSubMock::brokerUp() && WiFiMock::connected(); }
+};
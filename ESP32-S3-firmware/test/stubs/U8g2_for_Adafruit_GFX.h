@@ -0,0 +1,72 @@
+/**
+ * @file U8g2_for_Adafruit_GFX.h
+ * @brief u8g2 text renderer stub for native testing.
+ *
+ * Fonts are two-byte stand-ins {advance, height}; every glyph renders as
+ * a deterministic pattern inside its box (blank for space), so glyph
+ * atlases, width measurement and frame diffs behave like the real
+ * renderer without the font tables.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "Adafruit_GFX.h"
+
+static const uint8_t u8g2_font_helvR10_tf[] = {7, 10};
+static const uint8_t u8g2_font_helvB10_tf[] = {7, 10};
+static const uint8_t u8g2_font_helvB18_tf[] = {12, 18};
+static const uint8_t u8g2_font_luRS12_tr[]  = {8, 12};
+static const uint8_t u8g2_font_luRS18_tr[]  = {12, 18};
+
+class U8G2_FOR_ADAFRUIT_GFX {
+public:
+  U8G2_FOR_ADAFRUIT_GFX()
+    : gfx(nullptr), font(u8g2_font_helvR10_tf), color(1), cursorX(0), cursorY(0) {}
+
+  void begin(Adafruit_GFX& target) { gfx = &target; }
+  void setFont(const uint8_t* f) { font = f; }
+  void setFontMode(uint8_t) {}
+  void setFontDirection(uint8_t) {}
+  void setForegroundColor(uint16_t c) { color = c; }
+  void setCursor(int16_t x, int16_t y) {
+    cursorX = x;
+    cursorY = y;
+  }
+
+  int16_t drawGlyph(int16_t x, int16_t y, uint16_t code) {
+    const int16_t advance = font[0];
+    const int16_t height = font[1];
+    if (!gfx || code == ' ') {
+      return advance;
+    }
+    // Box of (advance - 1) x height ending on the baseline, patterned by code
+    for (int16_t row = 0; row < height; row++) {
+      for (int16_t col = 0; col < advance - 1; col++) {
+        if (row == 0 || ((code >> ((row + col) % 8)) & 1)) {
+          gfx->drawPixel(x + col, y - height + 1 + row, color);
+        }
+      }
+    }
+    return advance;
+  }
+
+  size_t print(const char* text) {
+    size_t n = 0;
+    for (const char* p = text; p && *p; p++, n++) {
+      cursorX += drawGlyph(cursorX, cursorY, (uint8_t)*p);
+    }
+    return n;
+  }
+
+  int16_t getUTF8Width(const char* text) {
+    return text ? (int16_t)(strlen(text) * font[0]) : 0;
+  }
+
+private:
+  Adafruit_GFX* gfx;
+  const uint8_t* font;
+  uint16_t color;
+  int16_t cursorX;
+  int16_t cursorY;
+};
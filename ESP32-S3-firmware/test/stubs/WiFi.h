@@ -0,0 +1,62 @@
+/**
+ * @file WiFi.h
+ * @brief Minimal ESP32 WiFi stub for native testing.
+ *
+ * The station is connected unless a test drops the link with
+ * WiFiMock::connected() = false.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "Arduino.h"
+
+namespace WiFiMock {
+inline bool& connected() {
+  static bool up = true;
+  return up;
+}
+}  // namespace WiFiMock
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+  WIFI_POWER_19_5dBm = 78,
+  WIFI_POWER_MINUS_1dBm = -4
+} wifi_power_t;
+
+class IPAddress {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets{a, b, c, d} {}
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buf);
+  }
+
+private:
+  uint8_t octets[4];
+};
+
+class WiFiClient {};
+
+class WiFiClass {
+public:
+  wl_status_t status() { return WiFiMock::connected() ? WL_CONNECTED : WL_DISCONNECTED; }
+  IPAddress localIP() { return IPAddress(192, 168, 1, 50); }
+  IPAddress gatewayIP() { return IPAddress(192, 168, 1, 1); }
+  IPAddress dnsIP() { return IPAddress(192, 168, 1, 1); }
+  IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+  String SSID() { return String("native"); }
+  int8_t RSSI() { return -50; }
+  bool setTxPower(wifi_power_t) { return true; }
+  bool disconnect(bool = false, bool = false) { return true; }
+};
+
+inline WiFiClass WiFi;
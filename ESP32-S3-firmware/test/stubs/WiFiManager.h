@@ -0,0 +1,38 @@
+/**
+ * @file WiFiManager.h
+ * @brief WiFiManager stub for native testing - no portal, never blocks.
+ */
+#pragma once
+
+#include <functional>
+#include <string>
+#include "WiFi.h"
+
+class WiFiManagerParameter {
+public:
+  WiFiManagerParameter(const char* id, const char* label, const char* defaultValue, int length)
+    : value(defaultValue ? defaultValue : "") {
+    (void)id;
+    (void)label;
+    (void)length;
+  }
+  const char* getValue() const { return value.c_str(); }
+
+private:
+  std::string value;
+};
+
+class WiFiManager {
+public:
+  void addParameter(WiFiManagerParameter*) {}
+  void setSaveParamsCallback(std::function<void()>) {}
+  void setConnectTimeout(unsigned long) {}
+  void setConfigPortalTimeout(unsigned long) {}
+  void setConfigPortalBlocking(bool) {}
+  bool autoConnect(const char*) { return WiFiMock::connected(); }
+  bool startConfigPortal(const char*) { return false; }
+  void process() {}
+  bool getConfigPortalActive() { return false; }
+  bool getWebPortalActive() { return false; }
+  void resetSettings() {}
+};
@@ -0,0 +1,19 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief ESP-IDF capability allocator stub for native (host) testing.
+ *
+ * All capabilities map to the host heap.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+
+inline void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void heap_caps_free(void* ptr) { free(ptr); }
+inline size_t heap_caps_get_free_size(uint32_t) { return 0; }
@@ -0,0 +1,23 @@
+/**
+ * @file esp_mac.h
+ * @brief ESP-IDF MAC address stub for native testing - fixed station MAC.
+ */
+#pragma once
+
+#include <cstdint>
+
+typedef enum {
+  ESP_MAC_WIFI_STA = 0,
+  ESP_MAC_BT = 2
+} esp_mac_type_t;
+
+inline int esp_read_mac(uint8_t* mac, esp_mac_type_t type) {
+  static const uint8_t STA[6] = {0x24, 0x6F, 0x28, 0x12, 0x34, 0x56};
+  for (int i = 0; i < 6; i++) {
+    mac[i] = STA[i];
+  }
+  if (type == ESP_MAC_BT) {
+    mac[5] += 2;
+  }
+  return 0;
+}
@@ -0,0 +1,9 @@
+/**
+ * @file esp_system.h
+ * @brief ESP-IDF system stub for native testing - deterministic "hardware" random.
+ */
+#pragma once
+
+#include <cstdint>
+
+inline uint32_t esp_random() { return 0x5EED1234u; }
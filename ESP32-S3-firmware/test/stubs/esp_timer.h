@@ -0,0 +1,13 @@
+/**
+ * @file esp_timer.h
+ * @brief Minimal esp_timer stub for native (host) testing.
+ *
+ * Microsecond clock derived from the controllable millis() mock so
+ * tests that advance millis() see a consistent esp_timer_get_time().
+ */
+#pragma once
+
+#include <cstdint>
+#include "Arduino.h"
+
+inline int64_t esp_timer_get_time() { return (int64_t)millis() * 1000; }
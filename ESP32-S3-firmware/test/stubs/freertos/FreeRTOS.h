@@ -0,0 +1,35 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Minimal FreeRTOS stub for native (host) testing.
+ *
+ * Single-threaded model: tasks are registered but never run on their own,
+ * critical sections are no-ops, and a blocking wait on the calling task
+ * sleeps through ArduinoMock::sleep() so a simulation decides what happens
+ * meanwhile (see freertos/task.h).
+ */
+#pragma once
+
+#include <cstdint>
+#include "Arduino.h"
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdFAIL  0
+#define pdPASS  1
+#define portMAX_DELAY UINT32_MAX
+
+// ── Spinlocks (portMUX) ─────────────────────────────────────────
+struct portMUX_TYPE {
+  int owner;
+};
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux)     ((void)(mux))
+#define portEXIT_CRITICAL(mux)      ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux)  ((void)(mux))
+#define portYIELD_FROM_ISR()        ((void)0)
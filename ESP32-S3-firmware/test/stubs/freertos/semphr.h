@@ -0,0 +1,30 @@
+/**
+ * @file semphr.h
+ * @brief FreeRTOS mutex stub for native testing (single-threaded: never blocks).
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+namespace FreeRtosMock {
+struct Mutex {
+  int held;
+};
+}  // namespace FreeRtosMock
+
+typedef FreeRtosMock::Mutex* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new FreeRtosMock::Mutex{0}; }
+inline void vSemaphoreDelete(SemaphoreHandle_t mutex) { delete mutex; }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t) {
+  if (!mutex) return pdFALSE;
+  mutex->held++;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex) {
+  if (!mutex || mutex->held == 0) return pdFALSE;
+  mutex->held--;
+  return pdTRUE;
+}
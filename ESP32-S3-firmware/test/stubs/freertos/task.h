@@ -0,0 +1,130 @@
+/**
+ * @file task.h
+ * @brief FreeRTOS task and task-notification stub for native testing.
+ *
+ * xTaskCreatePinnedToCore() records the task without running it; a test
+ * runs its work directly (e.g. BleIngestTask::drain()) when
+ * FreeRtosMock::takeNotifications() says it was woken. The calling
+ * task is always the main loop task. Its blocking waits sleep through
+ * ArduinoMock::sleep() and end early once a notification arrives.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+namespace FreeRtosMock {
+
+struct Task {
+  const char* name;
+  void (*entry)(void*);
+  void* param;
+  uint32_t notifyBits;   // xTaskNotify(eSetBits)
+  uint32_t notifyCount;  // xTaskNotifyGive
+};
+
+inline Task& mainTask() {
+  static Task task = {"loopTask", nullptr, nullptr, 0, 0};
+  return task;
+}
+
+// Makes the next xTaskCreatePinnedToCore() calls fail
+inline bool& failTaskCreate() {
+  static bool fail = false;
+  return fail;
+}
+
+// What ulTaskNotifyTake(pdTRUE, ...) would return on a recorded task
+inline uint32_t takeNotifications(Task* task) {
+  if (!task) return 0;
+  uint32_t count = task->notifyCount;
+  task->notifyCount = 0;
+  return count;
+}
+
+inline void reset() {
+  mainTask().notifyBits = 0;
+  mainTask().notifyCount = 0;
+  failTaskCreate() = false;
+}
+
+}  // namespace FreeRtosMock
+
+typedef FreeRtosMock::Task* TaskHandle_t;
+
+enum eNotifyAction {
+  eNoAction = 0,
+  eSetBits,
+  eIncrement,
+  eSetValueWithOverwrite,
+  eSetValueWithoutOverwrite
+};
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*entry)(void*), const char* name, uint32_t,
+                                          void* param, UBaseType_t, TaskHandle_t* handle,
+                                          BaseType_t) {
+  if (FreeRtosMock::failTaskCreate()) {
+    return pdFAIL;
+  }
+  TaskHandle_t task = new FreeRtosMock::Task{name, entry, param, 0, 0};
+  if (handle) {
+    *handle = task;
+  }
+  return pdPASS;
+}
+
+inline void vTaskDelete(TaskHandle_t task) {
+  if (task && task != &FreeRtosMock::mainTask()) {
+    delete task;
+  }
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return &FreeRtosMock::mainTask(); }
+
+inline BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+  if (!task) return pdFAIL;
+  switch (action) {
+    case eSetBits:  task->notifyBits |= value; break;
+    case eIncrement: task->notifyBits++; break;
+    case eSetValueWithOverwrite:
+    case eSetValueWithoutOverwrite: task->notifyBits = value; break;
+    case eNoAction: break;
+  }
+  return pdPASS;
+}
+
+inline BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                                     BaseType_t* higherPriorityTaskWoken) {
+  if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+  return xTaskNotify(task, value, action);
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  if (!task) return pdFAIL;
+  task->notifyCount++;
+  return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  FreeRtosMock::Task& self = FreeRtosMock::mainTask();
+  if (self.notifyCount == 0 && ticks > 0) {
+    ArduinoMock::sleep(ticks, [&self]() { return self.notifyCount != 0; });
+  }
+  uint32_t count = self.notifyCount;
+  if (count > 0) {
+    self.notifyCount = clearOnExit ? 0 : count - 1;
+  }
+  return count;
+}
+
+inline BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t* value,
+                                  TickType_t ticks) {
+  FreeRtosMock::Task& self = FreeRtosMock::mainTask();
+  self.notifyBits &= ~clearOnEntry;
+  if (self.notifyBits == 0 && ticks > 0) {
+    ArduinoMock::sleep(ticks, [&self]() { return self.notifyBits != 0; });
+  }
+  uint32_t bits = self.notifyBits;
+  if (value) *value = bits;
+  self.notifyBits &= ~clearOnExit;
+  return bits != 0 ? pdTRUE : pdFALSE;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file test_binary_log.cpp
+ * @brief Native tests for compile-time log filtering and binary log frames.
+ *
+ * Logger.cpp is built here as the binlog firmware would be, but with
+ * LOG_MIN_LEVEL at INFO so that stripping can be checked as well. The
+ * frames it writes are fed back through the host decoder from
+ * tools/log-decode, with a string table built from the literals the test
+ * logged, and must decode to the line the text build would print.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_binary_log
+ */
+
+#define LOG_MIN_LEVEL 1
+#define LOG_BINARY_OUTPUT 1
+
+#include <gtest/gtest.h>
+#include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../../src/Logger.cpp"
+#include "../../tools/log-decode/LogDecoder.h"
+
+// Component tags and formats are named so the test can register the exact
+// pointers the frames carry
+constexpr const char* TIMER_TAG = "SGTimer";
+constexpr const char* MQTT_TAG = "MQTT";
+const char* const FMT_FOUND = "SG Timer found: %s (%s)";
+const char* const FMT_SESSION = "SESSION_STARTED - ID: %u, Delay: %.1fs";
+const char* const FMT_EVENT = "Unknown event ID: 0x%02X";
+const char* const FMT_CONNECT = "Connect failed, rc=%d (%-8s|%8s)";
+const char* const FMT_MIXED = "%c%c %5.2f%% %08lX %lld %zu %*d|%-*s|%.*s %p";
+
+// Stands in for the firmware ELF: host pointer (low 32 bits) -> string
+class LiteralTable : public LogDecode::StringTable {
+public:
+  void add(const char* text) { strings[(uint32_t)(uintptr_t)text] = text; }
+
+  const char* lookup(uint32_t address) const override {
+    auto it = strings.find(address);
+    return it == strings.end() ? nullptr : it->second;
+  }
+
+private:
+  std::map<uint32_t, const char*> strings;
+};
+
+std::string expectedLine(uint32_t timestampMs, LogLevel level, const char* component,
+                         const char* format, ...) {
+  char line[LINE_SIZE];
+  size_t used = LogFormat::formatPrefix(line, sizeof(line), timestampMs, level, component,
+                                        LogFormat::hashTag(component));
+  va_list args;
+  va_start(args, format);
+  vsnprintf(line + used, messageRoom(used), format, args);
+  va_end(args);
+  return std::string(line) + "\n";
+}
+
+class BinaryLogTest : public ::testing::Test {
+protected:
+  LiteralTable table;
+
+  void SetUp() override {
+    FreeRtosMock::reset();
+    ArduinoMock::setMillis(4321);
+    Logger::setLevel(LogLevel::DEBUG);
+    for (const char* text : {TIMER_TAG, MQTT_TAG, FMT_FOUND, FMT_SESSION, FMT_EVENT,
+                             FMT_CONNECT, FMT_MIXED}) {
+      table.add(text);
+    }
+  }
+
+  void TearDown() override {
+    Logger::stopDeferred();
+    Logger::setLevel(LogLevel::INFO);
+  }
+
+  template <typename Calls>
+  static std::string captured(Calls calls) {
+    testing::internal::CaptureStderr();
+    calls();
+    return testing::internal::GetCapturedStderr();
+  }
+
+  std::string decode(const std::string& raw, LogDecode::Decoder& decoder) {
+    std::string out;
+    decoder.feed((const uint8_t*)raw.data(), raw.size(), out);
+    return out;
+  }
+
+  std::string decode(const std::string& raw) {
+    LogDecode::Decoder decoder(table);
+    return decode(raw, decoder);
+  }
+};
+
+// ═════════════════════════════════════════════════════════════════
+//  Compile-time filtering and tags
+// ═════════════════════════════════════════════════════════════════
+
+static_assert(!Logger::isCompiledIn(LogLevel::DEBUG), "DEBUG is below LOG_MIN_LEVEL");
+static_assert(Logger::isCompiledIn(LogLevel::INFO), "INFO is compiled in");
+static_assert(LOG_TAG_OF("SGTimer").hash == LogFormat::hashTag("SGTimer"), "");
+
+TEST(LogTag, CompileTimeHashMatchesRuntimeHash) {
+  std::string runtime = "SGTimer";
+  EXPECT_EQ(LOG_TAG_OF(TIMER_TAG).hash, LogFormat::hashTag(runtime.c_str()));
+  EXPECT_STREQ(LOG_TAG_OF(TIMER_TAG).name, "SGTimer");
+  EXPECT_NE(LOG_TAG_OF("MQTT").hash, LOG_TAG_OF("SGTimer").hash);
+}
+
+TEST_F(BinaryLogTest, StrippedLevelDoesNotEvaluateArguments) {
+  int evaluated = 0;
+  std::string out = captured([&] {
+    LOG_DEBUG("TEST", "value %d", ++evaluated);
+    LOG_HEX("TEST", "payload", (++evaluated, (const uint8_t*)"ab"), 2);
+  });
+  EXPECT_EQ(evaluated, 0);
+  EXPECT_EQ(out, "");
+}
+
+TEST_F(BinaryLogTest, FilteredLevelDoesNotEvaluateArguments) {
+  int evaluated = 0;
+  Logger::setLevel(LogLevel::WARN);
+  std::string out = captured([&] {
+    LOG_INFO("TEST", "value %d", ++evaluated);
+  });
+  EXPECT_EQ(evaluated, 0);
+  EXPECT_EQ(out, "");
+
+  captured([&] { LOG_WARN("TEST", "value %d", ++evaluated); });
+  EXPECT_EQ(evaluated, 1);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Frames round trip through the decoder
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(BinaryLogTest, FramesDecodeToTheTextLine) {
+  const char* address = "aa:bb:cc:dd:ee:ff";
+  void* pointer = (void*)(uintptr_t)0x3FC9A0B4;
+  std::string raw = captured([&] {
+    LOG_INFO(TIMER_TAG, FMT_FOUND, address, "SG-SST4A");
+    LOG_INFO(TIMER_TAG, FMT_SESSION, 12u, 3 * 0.1);
+    LOG_WARN(TIMER_TAG, FMT_EVENT, 0x1Fu);
+    LOG_ERROR(MQTT_TAG, FMT_CONNECT, -4, "left", "right");
+    LOG_INFO(TIMER_TAG, FMT_MIXED, 'o', 'k', 99.5, 0xBEEFul, -1234567890123ll, (size_t)77,
+             6, -42, 5, "ab", 3, "truncate", pointer);
+  });
+  ASSERT_FALSE(raw.empty());
+  EXPECT_EQ(raw.find("SG Timer found"), std::string::npos);  // Formats never leave the device
+
+  std::string expected =
+    expectedLine(4321, LogLevel::INFO, TIMER_TAG, FMT_FOUND, address, "SG-SST4A") +
+    expectedLine(4321, LogLevel::INFO, TIMER_TAG, FMT_SESSION, 12u, 3 * 0.1) +
+    expectedLine(4321, LogLevel::WARN, TIMER_TAG, FMT_EVENT, 0x1Fu) +
+    expectedLine(4321, LogLevel::ERROR, MQTT_TAG, FMT_CONNECT, -4, "left", "right") +
+    expectedLine(4321, LogLevel::INFO, TIMER_TAG, FMT_MIXED, 'o', 'k', 99.5, 0xBEEFul,
+                 -1234567890123ll, (size_t)77, 6, -42, 5, "ab", 3, "truncate", pointer);
+
+  LogDecode::Decoder decoder(table);
+  EXPECT_EQ(decode(raw, decoder), expected);
+  EXPECT_EQ(decoder.getStats().frames, 5u);
+  EXPECT_EQ(decoder.getStats().badFrames, 0u);
+  EXPECT_EQ(decoder.getStats().unknownStrings, 0u);
+}
+
+TEST_F(BinaryLogTest, FramesAreSmallerThanTheText) {
+  std::string raw = captured([&] { LOG_INFO(TIMER_TAG, FMT_SESSION, 12u, 0.3); });
+  // 3 sync/length bytes + 14 header + varint(12) + 8-byte double + checksum
+  EXPECT_EQ(raw.size(), 3u + 14u + 1u + 8u + 1u);
+  EXPECT_LT(raw.size(), decode(raw).size());
+}
+
+TEST_F(BinaryLogTest, TextAroundFramesPassesThrough) {
+  std::string raw = "ets Jun  8 2016 00:22:57\r\n" +
+                    captured([&] { LOG_WARN(TIMER_TAG, FMT_EVENT, 0x42u); }) +
+                    "E (123) idf: \xA5 stray sync byte\n";
+  EXPECT_EQ(decode(raw), "ets Jun  8 2016 00:22:57\r\n" +
+                         expectedLine(4321, LogLevel::WARN, TIMER_TAG, FMT_EVENT, 0x42u) +
+                         "E (123) idf: \xA5 stray sync byte\n");
+}
+
+TEST_F(BinaryLogTest, CorruptFrameIsDroppedAndDecodingResumes) {
+  std::string first = captured([&] { LOG_WARN(TIMER_TAG, FMT_EVENT, 0x01u); });
+  std::string second = captured([&] { LOG_WARN(TIMER_TAG, FMT_EVENT, 0x02u); });
+  first[8] ^= 0x10;  // Inside the body
+
+  LogDecode::Decoder decoder(table);
+  EXPECT_EQ(decode(first + second, decoder),
+            expectedLine(4321, LogLevel::WARN, TIMER_TAG, FMT_EVENT, 0x02u));
+  EXPECT_EQ(decoder.getStats().badFrames, 1u);
+  EXPECT_EQ(decoder.getStats().frames, 1u);
+}
+
+TEST_F(BinaryLogTest, FramesSplitAcrossReadsDecode) {
+  std::string raw = captured([&] { LOG_ERROR(MQTT_TAG, FMT_CONNECT, -4, "left", "right"); });
+  LogDecode::Decoder decoder(table);
+  std::string out;
+  for (char c : raw) {
+    decoder.feed((const uint8_t*)&c, 1, out);
+  }
+  EXPECT_EQ(out, expectedLine(4321, LogLevel::ERROR, MQTT_TAG, FMT_CONNECT, -4, "left", "right"));
+}
+
+TEST_F(BinaryLogTest, UnknownStringsAreReportedNotGuessed) {
+  std::string raw = captured([&] { LOG_WARN("NEW", "Not in this table: %u", 7u); });
+  LogDecode::Decoder decoder(table);
+  std::string out = decode(raw, decoder);
+  EXPECT_NE(out.find("?         "), std::string::npos) << out;
+  EXPECT_NE(out.find("<unknown format 0x"), std::string::npos) << out;
+  EXPECT_NE(out.find(", 1 args>"), std::string::npos) << out;
+  EXPECT_EQ(decoder.getStats().unknownStrings, 1u);
+}
+
+TEST_F(BinaryLogTest, HexDumpIsOneFrame) {
+  const uint8_t payload[] = {0x01, 0xAB, 0x00, 0xFF};
+  table.add("BLE");
+  table.add("%s (%u bytes): %s");
+  table.add("Notification");
+  Logger::setLevel(LogLevel::INFO);
+  std::string raw = captured([&] {
+    Logger::logHex(LogLevel::INFO, LOG_TAG_OF("BLE"), "Notification", payload, sizeof(payload));
+  });
+  std::string out = decode(raw);
+  EXPECT_NE(out.find("Notification (4 bytes): 01 AB 00 FF\n"), std::string::npos) << out;
+}
+
+TEST_F(BinaryLogTest, DeferredModeWritesFramesFromTheDrain) {
+  ASSERT_TRUE(Logger::startDeferred(1, 1, 4096));
+  captured([] { Logger::flush(); });  // Start-up line
+
+  std::string raw = captured([&] {
+    LOG_INFO(TIMER_TAG, FMT_SESSION, 3u, 1.5);
+    LOG_WARN(TIMER_TAG, FMT_EVENT, 0x07u);
+  });
+  EXPECT_EQ(raw, "");  // Nothing written by the callers
+
+  raw = captured([] { Logger::flush(); });
+  EXPECT_EQ(decode(raw), expectedLine(4321, LogLevel::INFO, TIMER_TAG, FMT_SESSION, 3u, 1.5) +
+                         expectedLine(4321, LogLevel::WARN, TIMER_TAG, FMT_EVENT, 0x07u));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Firmware ELF string table
+// ═════════════════════════════════════════════════════════════════
+
+// Minimal ELF32: null section, .rodata at 0x3C010000 holding the strings,
+// .bss (NOBITS) overlapping nothing
+std::vector<uint8_t> buildElf(const std::string& rodata) {
+  const uint32_t shoff = 0x40;
+  std::vector<uint8_t> image(shoff + 3 * 0x28, 0);
+  memcpy(image.data(), "\x7F" "ELF\x01\x01\x01", 7);
+  LogFormat::putU32(&image[0x20], shoff);
+  image[0x2E] = 0x28;  // e_shentsize
+  image[0x30] = 3;     // e_shnum
+
+  uint32_t dataOffset = (uint32_t)image.size();
+  image.insert(image.end(), rodata.begin(), rodata.end());
+
+  uint8_t* rodataHeader = &image[shoff + 0x28];
+  LogFormat::putU32(rodataHeader + 4, 1);         // SHT_PROGBITS
+  LogFormat::putU32(rodataHeader + 8, 0x2);       // SHF_ALLOC
+  LogFormat::putU32(rodataHeader + 12, 0x3C010000);
+  LogFormat::putU32(rodataHeader + 16, dataOffset);
+  LogFormat::putU32(rodataHeader + 20, (uint32_t)rodata.size());
+
+  uint8_t* bssHeader = &image[shoff + 0x50];
+  LogFormat::putU32(bssHeader + 4, 8);            // SHT_NOBITS
+  LogFormat::putU32(bssHeader + 8, 0x3);          // SHF_ALLOC | SHF_WRITE
+  LogFormat::putU32(bssHeader + 12, 0x3FC80000);
+  LogFormat::putU32(bssHeader + 16, 0);
+  LogFormat::putU32(bssHeader + 20, 0x1000);
+  return image;
+}
+
+TEST(ElfImage, LooksUpStringsByFirmwareAddress) {
+  std::string rodata("SGTimer\0Shot %u at %.2fs\0unterminated", 37);
+  LogDecode::ElfImage elf;
+  ASSERT_TRUE(elf.load(buildElf(rodata)));
+  EXPECT_EQ(elf.sectionCount(), 1u);  // .bss has no contents
+
+  EXPECT_STREQ(elf.lookup(0x3C010000), "SGTimer");
+  EXPECT_STREQ(elf.lookup(0x3C010008), "Shot %u at %.2fs");
+  EXPECT_STREQ(elf.lookup(0x3C010010), "at %.2fs");  // Tail of a merged string
+  EXPECT_EQ(elf.lookup(0x3C010019), nullptr);        // No NUL before the section ends
+  EXPECT_EQ(elf.lookup(0x3C010000 + 37), nullptr);
+  EXPECT_EQ(elf.lookup(0x3FC80000), nullptr);
+}
+
+TEST(ElfImage, RejectsOtherFiles) {
+  LogDecode::ElfImage elf;
+  EXPECT_FALSE(elf.load(std::vector<uint8_t>(64, 0)));
+  std::vector<uint8_t> elf64 = buildElf("x");
+  elf64[4] = 2;  // ELFCLASS64
+  EXPECT_FALSE(elf.load(elf64));
+}
+
+TEST(ElfImage, DecodesAHandBuiltFrame) {
+  std::string rodata("SGTimer\0Shot %u at %.2fs\0", 25);
+  LogDecode::ElfImage elf;
+  ASSERT_TRUE(elf.load(buildElf(rodata)));
+
+  uint8_t body[64];
+  LogFormat::putU32(body, 90061);
+  body[4] = (uint8_t)LogLevel::INFO;
+  LogFormat::putU32(body + 5, 0x3C010000);
+  LogFormat::putU32(body + 9, 0x3C010008);
+  body[13] = 2;
+  uint8_t* p = body + LogFormat::FRAME_HEADER_BYTES;
+  LogFormat::putVarint(p, body + sizeof(body), 300);
+  double seconds = 1.25;
+  uint64_t bits;
+  memcpy(&bits, &seconds, sizeof(bits));
+  for (int i = 0; i < 8; i++) *p++ = (uint8_t)(bits >> (8 * i));
+
+  LogDecode::Decoder decoder(elf);
+  std::string line;
+  ASSERT_TRUE(decoder.decodeBody(body, p - body, line));
+  EXPECT_EQ(line + "\n", expectedLine(90061, LogLevel::INFO, "SGTimer", "Shot %u at %.2fs",
+                                      300u, 1.25));
+}
@@ -0,0 +1,308 @@
+/**
+ * @file test_deferred_logger.cpp
+ * @brief Native tests for deferred logging and the MPSC ring behind it.
+ *
+ * The MpscRing template is tested standalone first, including a
+ * four-producer threaded run. The Logger tests then compare deferred
+ * output with what the synchronous path prints for the same calls:
+ * the drain task is recorded but never run by the FreeRTOS stub, so
+ * each test prints the queue itself with Logger::flush().
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_deferred_logger
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MpscRing.h"
+#include "../../src/Logger.cpp"
+
+// ═════════════════════════════════════════════════════════════════
+//  MpscRing
+// ═════════════════════════════════════════════════════════════════
+
+struct Item {
+  uint32_t producer;
+  uint32_t sequence;
+};
+
+TEST(MpscRing, InitiallyEmpty) {
+  MpscRing<Item, 8> ring;
+  Item out{};
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.size(), 0u);
+  EXPECT_FALSE(ring.pop(out));
+}
+
+TEST(MpscRing, EverySlotIsUsable) {
+  MpscRing<Item, 8> ring;
+  for (uint32_t i = 0; i < 8; i++) {
+    EXPECT_TRUE(ring.push({0, i}));
+  }
+  EXPECT_EQ(ring.size(), 8u);
+  EXPECT_FALSE(ring.push({0, 8}));  // Full - item not stored
+
+  Item out{};
+  ASSERT_TRUE(ring.pop(out));
+  EXPECT_EQ(out.sequence, 0u);
+  EXPECT_TRUE(ring.push({0, 8}));   // Freed slot is reusable on the next lap
+}
+
+TEST(MpscRing, FifoOrderAcrossManyLaps) {
+  MpscRing<Item, 4> ring;
+  uint32_t next = 0;
+  for (uint32_t i = 0; i < 1000; i++) {
+    ASSERT_TRUE(ring.push({0, i}));
+    if (i % 3 == 2) {
+      Item out{};
+      while (ring.pop(out)) {
+        ASSERT_EQ(out.sequence, next++);
+      }
+    }
+  }
+  Item out{};
+  while (ring.pop(out)) {
+    ASSERT_EQ(out.sequence, next++);
+  }
+  EXPECT_EQ(next, 1000u);
+}
+
+TEST(MpscRing, ConcurrentProducersSingleConsumer) {
+  // Four producer threads, one consumer - every item arrives exactly once,
+  // and each producer's items arrive in the order it pushed them
+  MpscRing<Item, 16> ring;
+  constexpr uint32_t PRODUCERS = 4;
+  constexpr uint32_t PER_PRODUCER = 50000;
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < PRODUCERS; p++) {
+    producers.emplace_back([&ring, p]() {
+      for (uint32_t i = 0; i < PER_PRODUCER; i++) {
+        while (!ring.push({p, i})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  uint32_t next[PRODUCERS] = {0, 0, 0, 0};
+  uint32_t received = 0;
+  Item out{};
+  while (received < PRODUCERS * PER_PRODUCER) {
+    if (ring.pop(out)) {
+      ASSERT_LT(out.producer, PRODUCERS);
+      ASSERT_EQ(out.sequence, next[out.producer]);
+      next[out.producer]++;
+      received++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  EXPECT_TRUE(ring.empty());
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Deferred Logger
+// ═════════════════════════════════════════════════════════════════
+
+class DeferredLoggerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    FreeRtosMock::reset();
+    ArduinoMock::setMillis(1234);
+    Logger::setLevel(LogLevel::DEBUG);
+  }
+
+  void TearDown() override {
+    Logger::stopDeferred();
+    Logger::setLevel(LogLevel::INFO);
+  }
+
+  // One call of every conversion the firmware uses, plus the odd ones
+  static void logSample() {
+    const char* address = "aa:bb:cc:dd:ee:ff";
+    LOG_INFO("SGTimer", "SG Timer found: %s (%s)", address, "SG-SST4A");
+    LOG_DEBUG("HEALTH", "Queue: %u/%u, Published: %lu/%lu, Peak: %u",
+              3u, 32u, 41ul, 44ul, 7u);
+    LOG_WARN("SGTimer", "Unknown event ID: 0x%02X", 0x1Fu);
+    LOG_INFO("SGTimer", "SESSION_STARTED - ID: %u, Delay: %.1fs", 12u, 3 * 0.1);
+    LOG_ERROR("MQTT", "Connect failed, rc=%d (%-8s|%8s)", -4, "left", "right");
+    LOG_INFO("TRACE", "%c%c %5.2f%% %08lX %lld %zu %*d|%-*s|%.*s",
+             'o', 'k', 99.5, 0xBEEFul, -1234567890123ll, (size_t)77, 6, -42, 5, "ab", 3,
+             "truncate");
+    LOG_SYSTEM("No arguments at all");
+  }
+
+  static std::string logSynchronously(void (*calls)()) {
+    testing::internal::CaptureStderr();
+    calls();
+    return testing::internal::GetCapturedStderr();
+  }
+
+  static std::string flushed() {
+    testing::internal::CaptureStderr();
+    Logger::flush();
+    return testing::internal::GetCapturedStderr();
+  }
+
+  static bool start() {
+    return Logger::startDeferred(1, 1, 4096);
+  }
+
+  static size_t countLines(const std::string& text) {
+    size_t lines = 0;
+    for (char c : text) {
+      lines += (c == '\n');
+    }
+    return lines;
+  }
+};
+
+TEST_F(DeferredLoggerTest, StartsAndStops) {
+  EXPECT_FALSE(Logger::isDeferred());
+  ASSERT_TRUE(start());
+  EXPECT_TRUE(Logger::isDeferred());
+  EXPECT_TRUE(start());  // Already running
+  Logger::stopDeferred();
+  EXPECT_FALSE(Logger::isDeferred());
+}
+
+TEST_F(DeferredLoggerTest, MatchesSynchronousOutput) {
+  std::string expected = logSynchronously(logSample);
+  ASSERT_EQ(countLines(expected), 7u);
+
+  ASSERT_TRUE(start());
+  flushed();  // Start-up line
+  testing::internal::CaptureStderr();
+  logSample();
+  EXPECT_EQ(testing::internal::GetCapturedStderr(), "");  // Nothing printed by the callers
+
+  EXPECT_EQ(flushed(), expected);
+  EXPECT_EQ(flushed(), "");
+}
+
+TEST_F(DeferredLoggerTest, CallersWakeTheDrainTask) {
+  ASSERT_TRUE(start());
+  ASSERT_NE(drainTask, nullptr);
+  FreeRtosMock::takeNotifications(drainTask);
+
+  LOG_INFO("TEST", "one");
+  LOG_INFO("TEST", "two");
+  EXPECT_EQ(FreeRtosMock::takeNotifications(drainTask), 2u);
+}
+
+TEST_F(DeferredLoggerTest, TimestampIsTakenAtLogTime) {
+  ASSERT_TRUE(start());
+  flushed();
+  ArduinoMock::setMillis(100);
+  LOG_INFO("TEST", "queued");
+  ArduinoMock::setMillis(5000);
+
+  std::string out = flushed();
+  EXPECT_NE(out.find("[     100]"), std::string::npos) << out;
+  EXPECT_NE(out.find("queued"), std::string::npos);
+}
+
+TEST_F(DeferredLoggerTest, StringArgumentsAreCopied) {
+  ASSERT_TRUE(start());
+  flushed();
+  char name[16];
+  strcpy(name, "original");
+  LOG_INFO("TEST", "name=%s", name);
+  strcpy(name, "overwritten");
+
+  std::string out = flushed();
+  EXPECT_NE(out.find("name=original"), std::string::npos) << out;
+}
+
+TEST_F(DeferredLoggerTest, NullStringPrintsPlaceholder) {
+  ASSERT_TRUE(start());
+  flushed();
+  const char* missing = nullptr;
+  LOG_INFO("TEST", "value=%s", missing);
+  EXPECT_NE(flushed().find("value=(null)"), std::string::npos);
+}
+
+TEST_F(DeferredLoggerTest, LevelIsCheckedAtLogTime) {
+  ASSERT_TRUE(start());
+  flushed();
+  Logger::setLevel(LogLevel::WARN);
+  LOG_INFO("TEST", "filtered");
+  LOG_WARN("TEST", "kept");
+  Logger::setLevel(LogLevel::DEBUG);
+
+  std::string out = flushed();
+  EXPECT_EQ(out.find("filtered"), std::string::npos);
+  EXPECT_NE(out.find("kept"), std::string::npos);
+}
+
+TEST_F(DeferredLoggerTest, OversizedArgumentsAreCut) {
+  // Three long strings overflow the per-line argument space: the second one is
+  // truncated to fit, the third cannot be packed and the message ends there
+  ASSERT_TRUE(start());
+  flushed();
+  std::string longText(80, 'x');
+  LOG_INFO("TEST", "a=%s b=%s c=%s end", longText.c_str(), longText.c_str(), longText.c_str());
+
+  std::string out = flushed();
+  EXPECT_NE(out.find("a=" + longText + " b=x"), std::string::npos) << out;
+  EXPECT_NE(out.find(" c=...\n"), std::string::npos) << out;
+  EXPECT_EQ(out.find("end"), std::string::npos);
+}
+
+TEST_F(DeferredLoggerTest, FullRingCountsAndReportsDrops) {
+  ASSERT_TRUE(start());
+  flushed();
+  uint32_t droppedBefore = Logger::getDroppedCount();
+
+  for (uint32_t i = 0; i < RING_SIZE + 10; i++) {
+    LOG_INFO("TEST", "line %u", (unsigned)i);
+  }
+  EXPECT_EQ(Logger::getDroppedCount() - droppedBefore, 10u);
+
+  std::string out = flushed();
+  EXPECT_EQ(countLines(out), RING_SIZE + 1);  // Every queued line plus the drop report
+  EXPECT_NE(out.find("line 0\n"), std::string::npos);
+  EXPECT_NE(out.find("line 63\n"), std::string::npos);
+  EXPECT_EQ(out.find("line 64\n"), std::string::npos);
+  EXPECT_NE(out.find("10 log lines dropped"), std::string::npos);
+
+  // Reported once
+  EXPECT_EQ(flushed(), "");
+}
+
+TEST_F(DeferredLoggerTest, StopPrintsWhatIsQueued) {
+  ASSERT_TRUE(start());
+  flushed();
+  LOG_INFO("TEST", "before stop");
+
+  testing::internal::CaptureStderr();
+  Logger::stopDeferred();
+  EXPECT_NE(testing::internal::GetCapturedStderr().find("before stop"), std::string::npos);
+
+  // Back to synchronous
+  testing::internal::CaptureStderr();
+  LOG_INFO("TEST", "after stop");
+  EXPECT_NE(testing::internal::GetCapturedStderr().find("after stop"), std::string::npos);
+}
+
+TEST_F(DeferredLoggerTest, StaysSynchronousWhenTaskCannotStart) {
+  FreeRtosMock::failTaskCreate() = true;
+  testing::internal::CaptureStderr();
+  EXPECT_FALSE(start());
+  EXPECT_NE(testing::internal::GetCapturedStderr().find("Failed to create log drain task"),
+            std::string::npos);
+  EXPECT_FALSE(Logger::isDeferred());
+
+  testing::internal::CaptureStderr();
+  LOG_INFO("TEST", "printed now");
+  EXPECT_NE(testing::internal::GetCapturedStderr().find("printed now"), std::string::npos);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file test_frame_pacer.cpp
+ * @brief Native tests for the display frame pacing clock.
+ *
+ * Tests FramePacer (header-only), which drives the marquee scroll and
+ * countdown redraw cadence in DisplayManager: fixed-period deadlines,
+ * catch-up after late wakes, and millis() wrap-around.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_frame_pacer
+ */
+
+#include <gtest/gtest.h>
+#include <climits>
+#include <cstdint>
+#include "FramePacer.h"
+
+// ═════════════════════════════════════════════════════════════════
+//  Cadence
+// ═════════════════════════════════════════════════════════════════
+
+TEST(FramePacerCadence, FirstFrameIsDueOnePeriodAfterStart) {
+  FramePacer pacer(25);
+  pacer.start(1000);
+
+  EXPECT_EQ(pacer.tick(1000), 0u);
+  EXPECT_EQ(pacer.tick(1024), 0u);
+  EXPECT_EQ(pacer.msUntilNext(1010), 15u);
+  EXPECT_EQ(pacer.tick(1025), 1u);
+}
+
+TEST(FramePacerCadence, SlightlyLateWakeDoesNotShiftLaterDeadlines) {
+  FramePacer pacer(25);
+  pacer.start(0);
+
+  EXPECT_EQ(pacer.tick(30), 1u);          // 5 ms late
+  EXPECT_EQ(pacer.msUntilNext(30), 20u);  // Next still due at 50, not 55
+  EXPECT_EQ(pacer.tick(50), 1u);
+}
+
+TEST(FramePacerCadence, LongStallReportsEveryElapsedFrame) {
+  FramePacer pacer(25);
+  pacer.start(0);
+
+  EXPECT_EQ(pacer.tick(110), 4u);         // Frames due at 25, 50, 75, 100
+  EXPECT_EQ(pacer.getSkippedFrames(), 3u);
+  EXPECT_EQ(pacer.getMaxLatenessMs(), 85u);
+  EXPECT_EQ(pacer.msUntilNext(110), 15u); // Back on the 125 grid
+}
+
+TEST(FramePacerCadence, ZeroPeriodNeverTicks) {
+  FramePacer pacer;
+  pacer.start(0);
+  EXPECT_EQ(pacer.tick(1000), 0u);
+}
+
+TEST(FramePacerCadence, OverdueFrameHasNoWait) {
+  FramePacer pacer(100);
+  pacer.start(0);
+  EXPECT_EQ(pacer.msUntilNext(150), 0u);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Stats and wrap-around
+// ═════════════════════════════════════════════════════════════════
+
+TEST(FramePacerStats, ResetClearsCounters) {
+  FramePacer pacer(10);
+  pacer.start(0);
+  pacer.tick(35);
+  EXPECT_EQ(pacer.getFrames(), 1u);
+
+  pacer.resetStats();
+  EXPECT_EQ(pacer.getFrames(), 0u);
+  EXPECT_EQ(pacer.getSkippedFrames(), 0u);
+  EXPECT_EQ(pacer.getMaxLatenessMs(), 0u);
+}
+
+TEST(FramePacerStats, MillisWrapAroundKeepsCadence) {
+  FramePacer pacer(25);
+  const unsigned long nearWrap = ULONG_MAX - 10;
+  pacer.start(nearWrap);                  // Due 14 ms after the wrap
+
+  EXPECT_EQ(pacer.tick(nearWrap + 5), 0u);
+  EXPECT_EQ(pacer.msUntilNext(nearWrap + 5), 20u);
+  EXPECT_EQ(pacer.tick(nearWrap + 25), 1u);
+}
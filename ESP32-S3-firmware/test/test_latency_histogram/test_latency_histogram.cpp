@@ -0,0 +1,120 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Native tests for the log-linear latency histogram.
+ *
+ * Tests LatencyHistogram (header-only), which backs the per-stage
+ * shot latency statistics in ShotTrace: bucket mapping, min/avg/max
+ * tracking and percentile estimation.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_latency_histogram
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "LatencyHistogram.h"
+
+// ═════════════════════════════════════════════════════════════════
+//  Bucket mapping
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LatencyHistogramBuckets, SmallValuesHaveExactBuckets) {
+  for (uint32_t v = 0; v < LatencyHistogram::SUB_BUCKETS; v++) {
+    EXPECT_EQ(LatencyHistogram::bucketIndex(v), v);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(v), v);
+  }
+}
+
+TEST(LatencyHistogramBuckets, ValueFallsWithinItsBucketBounds) {
+  const uint32_t samples[] = { 4, 5, 7, 8, 15, 100, 999, 1000, 1024, 65535, 1000000, UINT32_MAX };
+  for (uint32_t v : samples) {
+    size_t idx = LatencyHistogram::bucketIndex(v);
+    ASSERT_LT(idx, LatencyHistogram::BUCKET_COUNT);
+    EXPECT_LE(v, LatencyHistogram::bucketUpperBound(idx)) << "value " << v;
+    EXPECT_GT(v, LatencyHistogram::bucketUpperBound(idx - 1)) << "value " << v;
+  }
+}
+
+TEST(LatencyHistogramBuckets, RelativeErrorBoundedAtQuarter) {
+  // Upper bound never exceeds the value by more than 25%
+  for (uint32_t v = 4; v < 200000; v += 97) {
+    uint32_t upper = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(v));
+    EXPECT_LE((uint64_t)upper * 4, (uint64_t)v * 5) << "value " << v;
+  }
+}
+
+TEST(LatencyHistogramBuckets, MaxValueMapsToLastBucket) {
+  EXPECT_EQ(LatencyHistogram::bucketIndex(UINT32_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+  EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::BUCKET_COUNT - 1), UINT32_MAX);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Statistics
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LatencyHistogramStats, EmptyHistogramReportsZero) {
+  LatencyHistogram h;
+  EXPECT_EQ(h.count(), 0u);
+  EXPECT_EQ(h.min(), 0u);
+  EXPECT_EQ(h.max(), 0u);
+  EXPECT_EQ(h.mean(), 0u);
+  EXPECT_EQ(h.percentile(99), 0u);
+}
+
+TEST(LatencyHistogramStats, TracksMinMaxMean) {
+  LatencyHistogram h;
+  h.record(300);
+  h.record(100);
+  h.record(200);
+
+  EXPECT_EQ(h.count(), 3u);
+  EXPECT_EQ(h.min(), 100u);
+  EXPECT_EQ(h.max(), 300u);
+  EXPECT_EQ(h.mean(), 200u);
+}
+
+TEST(LatencyHistogramStats, P99IgnoresSingleOutlierInHundred) {
+  LatencyHistogram h;
+  for (int i = 0; i < 99; i++) {
+    h.record(1000);
+  }
+  h.record(50000);  // One slow shot
+
+  uint32_t p99 = h.percentile(99);
+  EXPECT_GE(p99, 1000u);
+  EXPECT_LE(p99, 1250u);           // Within the 25% bucket error
+  EXPECT_EQ(h.percentile(100), 50000u);
+}
+
+TEST(LatencyHistogramStats, P99ReportsTailWhenTwoPercentAreSlow) {
+  LatencyHistogram h;
+  for (int i = 0; i < 98; i++) {
+    h.record(1000);
+  }
+  h.record(40000);
+  h.record(40000);
+
+  uint32_t p99 = h.percentile(99);
+  EXPECT_GE(p99, 40000u);
+  EXPECT_LE(p99, 40000u);          // Clamped to the observed max
+}
+
+TEST(LatencyHistogramStats, PercentileNeverExceedsMax) {
+  LatencyHistogram h;
+  h.record(5);
+  EXPECT_EQ(h.percentile(50), 5u);
+  EXPECT_EQ(h.percentile(99), 5u);
+}
+
+TEST(LatencyHistogramStats, ResetClearsEverything) {
+  LatencyHistogram h;
+  h.record(1234);
+  h.reset();
+
+  EXPECT_EQ(h.count(), 0u);
+  EXPECT_EQ(h.max(), 0u);
+  EXPECT_EQ(h.percentile(99), 0u);
+
+  h.record(10);
+  EXPECT_EQ(h.min(), 10u);
+}
@@ -0,0 +1,416 @@
+/**
+ * @file test_lora_compact_frame.cpp
+ * @brief Native tests for the compact v2 LoRa frame (BLE-LoRa Bridge).
+ *
+ * Tests the v2 round trip of every packet type, DEVICE_INFO, decoding v1
+ * and v2 side by side, the 2-byte source hash and placeholder ids, ACK
+ * addressing by hash, truncated varints, and prints the frame size, time
+ * on air and shots per duty-cycle budget of v1 against v2.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_lora_compact_frame
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// The bridge's common.h first, as in the bridge build (both share the
+// COMMON_H guard, so the display firmware's one is skipped)
+#include "../../../BLE-LoRa-Bridge/include/common.h"
+#include "../../../BLE-LoRa-Bridge/src/LoRaPacket.cpp"
+#include "LoRaDataRate.h"
+
+using namespace LoRaProtocol;
+
+static const char* SOURCE = "A1B2C3";
+
+static NormalizedShotData makeShot(uint16_t number, uint32_t absMs, uint32_t splitMs,
+                                   const char* model = "SG Timer GO") {
+  NormalizedShotData shot;
+  shot.sessionId = 0x12345678;
+  shot.shotNumber = number;
+  shot.absoluteTimeMs = absMs;
+  shot.splitTimeMs = splitMs;
+  shot.isFirstShot = (number == 1);
+  strncpy(shot.deviceModel, model, sizeof(shot.deviceModel) - 1);
+  return shot;
+}
+
+// A frame cut short with a valid CRC, so only the payload checks can reject it
+static size_t truncate(uint8_t* buf, size_t len, size_t payloadBytesDropped) {
+  size_t cut = len - CRC_SIZE - payloadBytesDropped;
+  uint16_t crc = crc16(buf, cut);
+  buf[cut] = (uint8_t)(crc & 0xFF);
+  buf[cut + 1] = (uint8_t)(crc >> 8);
+  return cut + CRC_SIZE;
+}
+
+static void expectV2From(const ParsedPacket& pkt, const char* sourceId) {
+  char placeholder[SOURCE_ID_LEN + 1];
+  placeholderId(sourceHash(sourceId), placeholder);
+  EXPECT_EQ(pkt.version, FRAME_V2);
+  EXPECT_EQ(pkt.sourceHash, sourceHash(sourceId));
+  EXPECT_STREQ(pkt.sourceId, placeholder);  // Until the receiver resolves it
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Round trip
+// ═════════════════════════════════════════════════════════════════
+
+TEST(CompactFrameRoundTrip, ShotDetectedWithoutModel) {
+  NormalizedShotData shot = makeShot(1, 1843, 1843);
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotDetected(buf, sizeof(buf), SOURCE, shot, FRAME_V2);
+  // sessionId(4) + (1<<1|1)(1) + 1843(2) + 1843(2)
+  EXPECT_EQ(len, HEADER_SIZE_V2 + 9 + CRC_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  expectV2From(pkt, SOURCE);
+  EXPECT_EQ(pkt.type, PacketType::SHOT_DETECTED);
+  EXPECT_EQ(pkt.shot.sessionId, shot.sessionId);
+  EXPECT_EQ(pkt.shot.shotNumber, 1u);
+  EXPECT_TRUE(pkt.shot.isFirstShot);
+  EXPECT_EQ(pkt.shot.absoluteTimeMs, 1843u);
+  EXPECT_EQ(pkt.shot.splitTimeMs, 1843u);
+  EXPECT_STREQ(pkt.shot.deviceModel, "");  // From DEVICE_INFO instead
+}
+
+TEST(CompactFrameRoundTrip, ShotDetectedWidestValuesFit) {
+  NormalizedShotData shot = makeShot(0xFFFF, 0xFFFFFFFFu, 0xFFFFFFFFu);
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotDetected(buf, sizeof(buf), SOURCE, shot, FRAME_V2);
+  EXPECT_EQ(len, HEADER_SIZE_V2 + PAYLOAD_SHOT_DETECTED_V2_MAX + CRC_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.shot.shotNumber, 0xFFFFu);
+  EXPECT_FALSE(pkt.shot.isFirstShot);
+  EXPECT_EQ(pkt.shot.absoluteTimeMs, 0xFFFFFFFFu);
+  EXPECT_EQ(pkt.shot.splitTimeMs, 0xFFFFFFFFu);
+}
+
+TEST(CompactFrameRoundTrip, ShotBatchExpandsToOriginalShots) {
+  ShotBatch batch;
+  uint32_t t = 1700;
+  for (uint16_t i = 1; i <= 8; i++) {
+    ASSERT_TRUE(batch.add(makeShot(i, t, i == 1 ? 1700 : 215)));
+    t += 215;
+  }
+  uint8_t v1[MAX_PACKET_SIZE];
+  uint8_t v2[MAX_PACKET_SIZE];
+  size_t v1Len = serializeShotBatch(v1, sizeof(v1), SOURCE, batch);
+  size_t v2Len = serializeShotBatch(v2, sizeof(v2), SOURCE, batch, FRAME_V2);
+  ASSERT_GT(v2Len, 0u);
+  // Header, the model and the fixed-width first shot
+  EXPECT_EQ(v1Len - v2Len, (HEADER_SIZE - HEADER_SIZE_V2) + 1 + strlen("SG Timer GO") + 3);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(v2, v2Len, pkt));
+  expectV2From(pkt, SOURCE);
+  EXPECT_EQ(pkt.type, PacketType::SHOT_BATCH);
+  ASSERT_EQ(pkt.batchCount, 8u);
+  EXPECT_TRUE(pkt.batchStartsSession);
+  for (size_t i = 0; i < batch.count(); i++) {
+    NormalizedShotData got = batchShot(pkt, i);
+    EXPECT_EQ(got.sessionId, batch.shot(i).sessionId);
+    EXPECT_EQ(got.shotNumber, batch.shot(i).shotNumber);
+    EXPECT_EQ(got.absoluteTimeMs, batch.shot(i).absoluteTimeMs);
+    EXPECT_EQ(got.splitTimeMs, batch.shot(i).splitTimeMs);
+    EXPECT_EQ(got.isFirstShot, batch.shot(i).isFirstShot);
+  }
+}
+
+TEST(CompactFrameRoundTrip, SessionEvents) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  ParsedPacket pkt;
+
+  size_t len = serializeSessionStarted(buf, sizeof(buf), SOURCE, 77, 2.5f, FRAME_V2);
+  EXPECT_EQ(len, HEADER_SIZE_V2 + PAYLOAD_SESSION_STARTED + CRC_SIZE);
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  expectV2From(pkt, SOURCE);
+  EXPECT_EQ(pkt.type, PacketType::SESSION_STARTED);
+  EXPECT_EQ(pkt.sessionId, 77u);
+  EXPECT_FLOAT_EQ(pkt.startDelaySeconds, 2.5f);
+
+  len = serializeSessionStopped(buf, sizeof(buf), SOURCE, 77, 12, 9120, FRAME_V2);
+  EXPECT_EQ(len, HEADER_SIZE_V2 + 4 + 1 + 2 + CRC_SIZE);
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::SESSION_STOPPED);
+  EXPECT_EQ(pkt.sessionId, 77u);
+  EXPECT_EQ(pkt.totalShots, 12u);
+  EXPECT_EQ(pkt.lastShotTimeMs, 9120u);
+
+  const PacketType fourByte[] = {PacketType::COUNTDOWN_COMPLETE, PacketType::SESSION_SUSPENDED,
+                                 PacketType::SESSION_RESUMED};
+  for (PacketType type : fourByte) {
+    if (type == PacketType::COUNTDOWN_COMPLETE) {
+      len = serializeCountdownComplete(buf, sizeof(buf), SOURCE, 78, FRAME_V2);
+    } else if (type == PacketType::SESSION_SUSPENDED) {
+      len = serializeSessionSuspended(buf, sizeof(buf), SOURCE, 78, FRAME_V2);
+    } else {
+      len = serializeSessionResumed(buf, sizeof(buf), SOURCE, 78, FRAME_V2);
+    }
+    EXPECT_EQ(len, HEADER_SIZE_V2 + 4 + CRC_SIZE);
+    ASSERT_TRUE(deserialize(buf, len, pkt));
+    EXPECT_EQ(pkt.type, type);
+    EXPECT_EQ(pkt.sessionId, 78u);
+  }
+}
+
+TEST(CompactFrameRoundTrip, HeartbeatAckAndRateChange) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  ParsedPacket pkt;
+
+  size_t len = serializeHeartbeat(buf, sizeof(buf), SOURCE, 30000, FRAME_V2);
+  EXPECT_EQ(len, HEADER_SIZE_V2 + 3 + CRC_SIZE);
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::HEARTBEAT);
+  EXPECT_EQ(pkt.uptimeMs, 30000u);
+
+  len = serializeAck(buf, sizeof(buf), "RX0001", SOURCE, 513, 0x5, FRAME_V2);
+  EXPECT_EQ(len, HEADER_SIZE_V2 + 2 + 2 + 1 + CRC_SIZE);
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::ACK);
+  EXPECT_EQ(pkt.destHash, sourceHash(SOURCE));
+  EXPECT_EQ(pkt.ackBase, 513u);
+  EXPECT_EQ(pkt.ackMask, 0x5u);
+
+  len = serializeRateChange(buf, sizeof(buf), "RX0001", nullptr, 4, FRAME_V2);
+  EXPECT_EQ(len, HEADER_SIZE_V2 + 2 + 1 + CRC_SIZE);
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::RATE_CHANGE);
+  EXPECT_EQ(pkt.destHash, 0u);
+  EXPECT_STREQ(pkt.destId, "");
+  EXPECT_EQ(pkt.rate, 4u);
+}
+
+TEST(CompactFrameRoundTrip, DeviceInfoNamesTheHash) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeDeviceInfo(buf, sizeof(buf), SOURCE, "SG Timer GO");
+  EXPECT_EQ(len, HEADER_SIZE_V2 + PAYLOAD_DEVICE_INFO_MIN + strlen("SG Timer GO") + CRC_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.version, FRAME_V2);
+  EXPECT_EQ(pkt.type, PacketType::DEVICE_INFO);
+  EXPECT_STREQ(pkt.sourceId, SOURCE);
+  EXPECT_EQ(pkt.sourceHash, sourceHash(SOURCE));
+  EXPECT_STREQ(pkt.shot.deviceModel, "SG Timer GO");
+
+  // Before any timer connects
+  len = serializeDeviceInfo(buf, sizeof(buf), SOURCE, "");
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_STREQ(pkt.shot.deviceModel, "");
+}
+
+TEST(CompactFrameRoundTrip, DeviceInfoWithForeignHashRejected) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeDeviceInfo(buf, sizeof(buf), SOURCE, "SG Timer GO");
+  buf[3] ^= 0x01;  // Hash no longer that of the id inside
+  uint16_t crc = crc16(buf, len - CRC_SIZE);
+  buf[len - 2] = (uint8_t)(crc & 0xFF);
+  buf[len - 1] = (uint8_t)(crc >> 8);
+
+  ParsedPacket pkt;
+  EXPECT_FALSE(deserialize(buf, len, pkt));
+}
+
+TEST(CompactFrameRoundTrip, SequenceNumberAfterShortHeader) {
+  NormalizedShotData shot = makeShot(3, 2400, 260);
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotDetected(buf, sizeof(buf), SOURCE, shot, FRAME_V2);
+  size_t seqLen = addSequence(buf, len, sizeof(buf), 0xBEEF, true);
+  ASSERT_EQ(seqLen, len + SEQ_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, seqLen, pkt));
+  expectV2From(pkt, SOURCE);
+  EXPECT_TRUE(pkt.sequenced);
+  EXPECT_TRUE(pkt.sync);
+  EXPECT_EQ(pkt.seq, 0xBEEFu);
+  EXPECT_EQ(pkt.shot.shotNumber, 3u);
+  EXPECT_EQ(pkt.shot.splitTimeMs, 260u);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Coexistence with v1
+// ═════════════════════════════════════════════════════════════════
+
+TEST(CompactFrameVersions, BothVersionsDecodeToTheSameShot) {
+  NormalizedShotData shot = makeShot(5, 3100, 240);
+  uint8_t v1[MAX_PACKET_SIZE];
+  uint8_t v2[MAX_PACKET_SIZE];
+  size_t v1Len = serializeShotDetected(v1, sizeof(v1), SOURCE, shot);
+  size_t v2Len = serializeShotDetected(v2, sizeof(v2), SOURCE, shot, FRAME_V2);
+  EXPECT_EQ(v1[1], MAGIC_1);
+  EXPECT_EQ(v2[1], VERSION_V2);
+
+  ParsedPacket a;
+  ParsedPacket b;
+  ASSERT_TRUE(deserialize(v1, v1Len, a));
+  ASSERT_TRUE(deserialize(v2, v2Len, b));
+  EXPECT_EQ(a.version, FRAME_V1);
+  EXPECT_STREQ(a.sourceId, SOURCE);
+  EXPECT_EQ(a.sourceHash, b.sourceHash);  // Computed for v1
+  EXPECT_EQ(a.shot.shotNumber, b.shot.shotNumber);
+  EXPECT_EQ(a.shot.absoluteTimeMs, b.shot.absoluteTimeMs);
+  EXPECT_EQ(a.shot.splitTimeMs, b.shot.splitTimeMs);
+  EXPECT_EQ(a.shot.isFirstShot, b.shot.isFirstShot);
+  EXPECT_STREQ(a.shot.deviceModel, "SG Timer GO");
+}
+
+TEST(CompactFrameVersions, UnknownVersionRejected) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeHeartbeat(buf, sizeof(buf), SOURCE, 1000, FRAME_V2);
+  const uint8_t versions[] = {0x00, 0x10, 0x21, 0x30, 0xF0};
+  for (uint8_t version : versions) {
+    buf[1] = version;
+    uint16_t crc = crc16(buf, len - CRC_SIZE);
+    buf[len - 2] = (uint8_t)(crc & 0xFF);
+    buf[len - 1] = (uint8_t)(crc >> 8);
+    ParsedPacket pkt;
+    EXPECT_FALSE(deserialize(buf, len, pkt)) << "version byte 0x" << std::hex << (int)version;
+  }
+}
+
+TEST(CompactFrameVersions, DeviceInfoTypeInV1FrameRejected) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeHeartbeat(buf, sizeof(buf), SOURCE, 1000);
+  buf[2] = (uint8_t)PacketType::DEVICE_INFO;
+  uint16_t crc = crc16(buf, len - CRC_SIZE);
+  buf[len - 2] = (uint8_t)(crc & 0xFF);
+  buf[len - 1] = (uint8_t)(crc >> 8);
+  ParsedPacket pkt;
+  EXPECT_FALSE(deserialize(buf, len, pkt));
+}
+
+TEST(CompactFrameVersions, TruncatedVarintsRejected) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  ParsedPacket pkt;
+
+  NormalizedShotData shot = makeShot(2, 100000, 300);
+  size_t len = serializeShotDetected(buf, sizeof(buf), SOURCE, shot, FRAME_V2);
+  for (size_t dropped = 1; dropped < len - HEADER_SIZE_V2 - CRC_SIZE; dropped++) {
+    uint8_t copy[MAX_PACKET_SIZE];
+    memcpy(copy, buf, len);
+    size_t cut = truncate(copy, len, dropped);
+    EXPECT_FALSE(deserialize(copy, cut, pkt)) << dropped << " bytes dropped";
+  }
+
+  len = serializeSessionStopped(buf, sizeof(buf), SOURCE, 9, 300, 200000, FRAME_V2);
+  len = truncate(buf, len, 1);
+  EXPECT_FALSE(deserialize(buf, len, pkt));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Source hash and addressing
+// ═════════════════════════════════════════════════════════════════
+
+TEST(CompactFrameSource, HashNeverZeroAndPlaceholderMapsBack) {
+  uint32_t lcg = 12345;
+  for (int i = 0; i < 20000; i++) {
+    lcg = lcg * 1103515245u + 12345u;
+    char id[SOURCE_ID_LEN + 1];
+    snprintf(id, sizeof(id), "%06X", (unsigned)(lcg >> 8) & 0xFFFFFF);
+    uint16_t hash = sourceHash(id);
+    ASSERT_NE(hash, 0u) << id;
+
+    char placeholder[SOURCE_ID_LEN + 1];
+    placeholderId(hash, placeholder);
+    EXPECT_EQ(placeholder[0], PLACEHOLDER_PREFIX);
+    EXPECT_EQ(strlen(placeholder), 5u);
+    EXPECT_EQ(sourceHash(placeholder), hash) << placeholder;
+  }
+  EXPECT_NE(sourceHash(""), 0u);
+  EXPECT_NE(sourceHash("~0000"), 0u);  // Not a hash: hashed like any id
+}
+
+TEST(CompactFrameSource, SixteenBaysHaveDistinctHashes) {
+  uint16_t hashes[LORA_MAX_SOURCES];
+  for (int i = 0; i < LORA_MAX_SOURCES; i++) {
+    char id[SOURCE_ID_LEN + 1];
+    snprintf(id, sizeof(id), "BAY%03d", i);
+    hashes[i] = sourceHash(id);
+    for (int j = 0; j < i; j++) EXPECT_NE(hashes[i], hashes[j]) << id;
+  }
+}
+
+TEST(CompactFrameSource, AckAddressedByIdOrHash) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  ParsedPacket pkt;
+  const uint8_t versions[] = {FRAME_V1, FRAME_V2};
+  for (uint8_t version : versions) {
+    size_t len = serializeAck(buf, sizeof(buf), "RX0001", SOURCE, 1, 0, version);
+    ASSERT_TRUE(deserialize(buf, len, pkt));
+    EXPECT_TRUE(addressedTo(pkt, SOURCE)) << "v" << (int)version;
+    EXPECT_FALSE(addressedTo(pkt, "D4E5F6")) << "v" << (int)version;
+
+    len = serializeRateChange(buf, sizeof(buf), "RX0001", nullptr, 2, version);
+    ASSERT_TRUE(deserialize(buf, len, pkt));
+    EXPECT_FALSE(addressedTo(pkt, SOURCE)) << "broadcast, v" << (int)version;
+    EXPECT_STREQ(pkt.destId, "");
+  }
+
+  // The receiver answers a source it only knows by placeholder
+  char placeholder[SOURCE_ID_LEN + 1];
+  placeholderId(sourceHash(SOURCE), placeholder);
+  size_t len = serializeAck(buf, sizeof(buf), "RX0001", placeholder, 1, 0, FRAME_V2);
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_TRUE(addressedTo(pkt, SOURCE));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Airtime
+// ═════════════════════════════════════════════════════════════════
+
+TEST(CompactFrameAirtime, EveryTypeIsSmallerAndShotsPerBudgetGrow) {
+  uint8_t v1[MAX_PACKET_SIZE];
+  uint8_t v2[MAX_PACKET_SIZE];
+  NormalizedShotData shot = makeShot(14, 6890, 231);
+  ShotBatch one;
+  one.add(shot);
+
+  struct Frame { const char* name; size_t v1; size_t v2; };
+  Frame frames[] = {
+    {"SHOT_DETECTED", serializeShotDetected(v1, sizeof(v1), SOURCE, shot),
+                      serializeShotDetected(v2, sizeof(v2), SOURCE, shot, FRAME_V2)},
+    {"SHOT_BATCH (1)", serializeShotBatch(v1, sizeof(v1), SOURCE, one),
+                       serializeShotBatch(v2, sizeof(v2), SOURCE, one, FRAME_V2)},
+    {"SESSION_STARTED", serializeSessionStarted(v1, sizeof(v1), SOURCE, 1, 3.0f),
+                        serializeSessionStarted(v2, sizeof(v2), SOURCE, 1, 3.0f, FRAME_V2)},
+    {"SESSION_STOPPED", serializeSessionStopped(v1, sizeof(v1), SOURCE, 1, 14, 6890),
+                        serializeSessionStopped(v2, sizeof(v2), SOURCE, 1, 14, 6890, FRAME_V2)},
+    {"HEARTBEAT", serializeHeartbeat(v1, sizeof(v1), SOURCE, 3600000),
+                  serializeHeartbeat(v2, sizeof(v2), SOURCE, 3600000, FRAME_V2)},
+    {"ACK", serializeAck(v1, sizeof(v1), "RX0001", SOURCE, 9, 0),
+            serializeAck(v2, sizeof(v2), "RX0001", SOURCE, 9, 0, FRAME_V2)},
+  };
+
+  const uint32_t budgetUs = (uint32_t)((uint64_t)LORA_DUTY_CYCLE_WINDOW_MS * LORA_DUTY_CYCLE_PERMILLE);
+  const uint8_t rates[] = {0, LORA_RATE_RENDEZVOUS, LoRaRate::COUNT - 1};
+  printf("  %-16s %5s %5s", "frame (bytes)", "v1", "v2");
+  for (uint8_t r : rates) printf("  DR%u v1/v2 ms", (unsigned)r);
+  printf("\n");
+  for (const Frame& frame : frames) {
+    EXPECT_LT(frame.v2, frame.v1) << frame.name;
+    printf("  %-16s %5zu %5zu", frame.name, frame.v1, frame.v2);
+    for (uint8_t r : rates) {
+      printf("  %6.1f/%6.1f", LoRaRate::airtimeUs(LoRaRate::TABLE[r], frame.v1) / 1000.0,
+             LoRaRate::airtimeUs(LoRaRate::TABLE[r], frame.v2) / 1000.0);
+    }
+    printf("\n");
+  }
+
+  // One-shot batches, the common case with a slow string
+  for (uint8_t r : rates) {
+    uint32_t v1Us = LoRaRate::airtimeUs(LoRaRate::TABLE[r], frames[1].v1);
+    uint32_t v2Us = LoRaRate::airtimeUs(LoRaRate::TABLE[r], frames[1].v2);
+    EXPECT_LT(v2Us, v1Us);
+    printf("  DR%u: %lu shots per %u.%u%% budget (v1: %lu)\n", (unsigned)r,
+           (unsigned long)(budgetUs / v2Us), (unsigned)(LORA_DUTY_CYCLE_PERMILLE / 10),
+           (unsigned)(LORA_DUTY_CYCLE_PERMILLE % 10), (unsigned long)(budgetUs / v1Us));
+  }
+}
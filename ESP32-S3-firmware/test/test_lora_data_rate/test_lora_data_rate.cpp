@@ -0,0 +1,234 @@
+/**
+ * @file test_lora_data_rate.cpp
+ * @brief Native tests for the BLE-LoRa Bridge adaptive data rate (LORA_ADAPTIVE_RATE).
+ *
+ * Tests the LoRaRate table (ordering, sensitivity, signal estimate), the
+ * RATE_CHANGE packet, and LoRaRateController: stepping slower and faster
+ * with margin, hysteresis and hold time, the weakest online source
+ * governing the shared rate, and the fallback to the rendezvous rate when
+ * a source goes quiet after a change. Prints time on air and shot latency
+ * per rate.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_lora_data_rate
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// The bridge's common.h first, as in the bridge build (both share the
+// COMMON_H guard, so the display firmware's one is skipped)
+#include "../../../BLE-LoRa-Bridge/include/common.h"
+#include "../../../BLE-LoRa-Bridge/src/LoRaPacket.cpp"
+#include "LoRaDataRate.h"
+
+using namespace LoRaProtocol;
+
+typedef LoRaSourceTable<4> Table;
+
+static constexpr uint8_t RENDEZVOUS = 3;
+static constexpr int16_t MARGIN = 100;      // 10 dB
+static constexpr int16_t HYSTERESIS = 30;   // 3 dB
+static constexpr uint32_t HOLD_MS = 60000;
+static constexpr uint32_t FALLBACK_MS = 40000;
+
+static LoRaRateController makeController() {
+  return LoRaRateController(RENDEZVOUS, MARGIN, HYSTERESIS, HOLD_MS, FALLBACK_MS);
+}
+
+// An online source with `samples` packets at `signal` dBm (SNR positive)
+static LoRaSource& addSource(Table& table, const char* id, int signal, int samples, uint32_t nowMs) {
+  LoRaSource& source = table.touch(id, nowMs, signal);
+  source.online = true;
+  for (int i = 0; i < samples; i++) LoRaRateController::record(source, signal, 5.0f);
+  return source;
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Rate table
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaRate, TableSlowerIsMoreSensitive) {
+  const size_t len = HEADER_SIZE + PAYLOAD_SHOT_DETECTED + CRC_SIZE;
+  for (uint8_t i = 1; i < LoRaRate::COUNT; i++) {
+    EXPECT_LT(LoRaRate::SENSITIVITY_DBM10[i], LoRaRate::SENSITIVITY_DBM10[i - 1]) << "DR" << (int)i;
+    EXPECT_GT(LoRaRate::airtimeUs(LoRaRate::TABLE[i], len),
+              LoRaRate::airtimeUs(LoRaRate::TABLE[i - 1], len)) << "DR" << (int)i;
+  }
+  EXPECT_EQ(LoRaRate::SENSITIVITY_DBM10[0], -1185);
+  EXPECT_EQ(LoRaRate::SENSITIVITY_DBM10[LoRaRate::COUNT - 1], -1370);
+}
+
+TEST(LoRaRate, SignalAddsNegativeSnrOnly) {
+  EXPECT_EQ(LoRaRate::signalDbm10(-80, 9.5f), -800);
+  EXPECT_EQ(LoRaRate::signalDbm10(-118, -7.25f), -1253);
+  EXPECT_EQ(LoRaRate::signalDbm10(-120, 0.0f), -1200);
+}
+
+TEST(LoRaRate, ShotLatencyIncludesBatchWindow) {
+  uint32_t fastest = LoRaRate::shotLatencyMs(LoRaRate::TABLE[0]);
+  uint32_t slowest = LoRaRate::shotLatencyMs(LoRaRate::TABLE[LoRaRate::COUNT - 1]);
+  EXPECT_GE(fastest, LORA_SHOT_BATCHING ? (uint32_t)LORA_SHOT_BATCH_WINDOW_MS : 0u);
+  EXPECT_GT(slowest, fastest + 1000);  // SF12/125 kHz: over a second on air
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  RATE_CHANGE packet
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaRateWire, BroadcastRoundTrip) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeRateChange(buf, sizeof(buf), "RX0001", nullptr, 4);
+  ASSERT_EQ(len, HEADER_SIZE + PAYLOAD_RATE_CHANGE + CRC_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::RATE_CHANGE);
+  EXPECT_FALSE(pkt.sequenced);
+  EXPECT_STREQ(pkt.sourceId, "RX0001");
+  EXPECT_STREQ(pkt.destId, "");
+  EXPECT_EQ(pkt.rate, 4);
+}
+
+TEST(LoRaRateWire, AddressedAndRejectedWhenSequenced) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeRateChange(buf, sizeof(buf), "RX0001", "TX0001", 2);
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_STREQ(pkt.destId, "TX0001");
+
+  size_t seqLen = addSequence(buf, len, sizeof(buf), 1, false);
+  EXPECT_FALSE(deserialize(buf, seqLen, pkt));
+  EXPECT_EQ(serializeRateChange(buf, len - 1, "RX0001", nullptr, 2), 0u);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  LoRaRateController
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaRateController, StartsAtRendezvousWithoutSources) {
+  Table table;
+  LoRaRateController controller = makeController();
+  EXPECT_EQ(controller.current(), RENDEZVOUS);
+  EXPECT_EQ(controller.decide(table, HOLD_MS), LoRaRateController::NO_CHANGE);
+  EXPECT_EQ(controller.msUntilFallback(table, 0), UINT32_MAX);
+}
+
+TEST(LoRaRateController, MovingAverageFollowsSignal) {
+  Table table;
+  LoRaSource& source = addSource(table, "AAAAAA", -100, 1, 0);
+  EXPECT_EQ(source.signalDbm10, -1000);
+  for (int i = 0; i < 30; i++) LoRaRateController::record(source, -80, 5.0f);
+  EXPECT_NEAR(source.signalDbm10, -800, 5);
+  EXPECT_EQ(source.linkSamples, 31);
+}
+
+TEST(LoRaRateController, StrongLinkStepsFasterAfterHold) {
+  Table table;
+  LoRaRateController controller = makeController();
+  addSource(table, "AAAAAA", -80, LoRaRateController::MIN_SAMPLES, 0);
+
+  EXPECT_EQ(controller.decide(table, HOLD_MS - 1), LoRaRateController::NO_CHANGE);
+  ASSERT_EQ(controller.decide(table, HOLD_MS), RENDEZVOUS - 1);
+  controller.changed(table, RENDEZVOUS - 1, HOLD_MS);
+
+  // Samples start over at the new rate
+  EXPECT_EQ(controller.decide(table, 3 * HOLD_MS), LoRaRateController::NO_CHANGE);
+  LoRaSource* source = table.find("AAAAAA");
+  for (int i = 0; i < LoRaRateController::MIN_SAMPLES; i++) LoRaRateController::record(*source, -80, 5.0f);
+  EXPECT_EQ(controller.decide(table, 3 * HOLD_MS), RENDEZVOUS - 2);
+}
+
+TEST(LoRaRateController, WeakLinkStepsSlowerWithoutHold) {
+  Table table;
+  LoRaRateController controller = makeController();
+  controller.changed(table, 0, 1000);
+  // SF7/500 kHz sensitivity -118.5 dBm: -112 dBm leaves 6.5 dB
+  addSource(table, "AAAAAA", -112, LoRaRateController::MIN_SAMPLES, 1000);
+  EXPECT_EQ(controller.decide(table, 1001), 1);
+}
+
+TEST(LoRaRateController, HysteresisKeepsMarginalLinkSteady) {
+  Table table;
+  LoRaRateController controller = makeController();
+  controller.changed(table, 1, 0);
+  // DR1 -121 dBm, DR0 -118.5 dBm: -107 dBm has 14 dB now, 11.5 dB faster
+  addSource(table, "AAAAAA", -107, LoRaRateController::MIN_SAMPLES, 0);
+  EXPECT_EQ(controller.decide(table, HOLD_MS), LoRaRateController::NO_CHANGE);
+
+  // 13.5 dB at DR0 is enough
+  LoRaSource* source = table.find("AAAAAA");
+  source->signalDbm10 = -1050;
+  EXPECT_EQ(controller.decide(table, HOLD_MS), 0);
+}
+
+TEST(LoRaRateController, WeakestOnlineSourceGoverns) {
+  Table table;
+  LoRaRateController controller = makeController();
+  addSource(table, "NEAR01", -70, LoRaRateController::MIN_SAMPLES, 0);
+  addSource(table, "FAR001", -122, LoRaRateController::MIN_SAMPLES, 0);
+  // FAR001 has 7 dB at DR3 (-129 dBm)
+  EXPECT_EQ(controller.decide(table, HOLD_MS), RENDEZVOUS + 1);
+
+  // Offline sources don't count
+  table.find("FAR001")->online = false;
+  EXPECT_EQ(controller.decide(table, HOLD_MS), RENDEZVOUS - 1);
+}
+
+TEST(LoRaRateController, UnsampledSourceBlocksFasterOnly) {
+  Table table;
+  LoRaRateController controller = makeController();
+  addSource(table, "NEAR01", -70, LoRaRateController::MIN_SAMPLES, 0);
+  addSource(table, "NEW001", -70, LoRaRateController::MIN_SAMPLES - 1, 0);
+  EXPECT_EQ(controller.decide(table, HOLD_MS), LoRaRateController::NO_CHANGE);
+
+  // A weak sampled source still steps slower
+  addSource(table, "FAR001", -125, LoRaRateController::MIN_SAMPLES, 0);
+  EXPECT_EQ(controller.decide(table, HOLD_MS), RENDEZVOUS + 1);
+}
+
+TEST(LoRaRateController, SlowestRateIsFloor) {
+  Table table;
+  LoRaRateController controller = makeController();
+  controller.changed(table, LoRaRate::COUNT - 1, 0);
+  addSource(table, "FAR001", -135, LoRaRateController::MIN_SAMPLES, 0);
+  EXPECT_EQ(controller.decide(table, HOLD_MS), LoRaRateController::NO_CHANGE);
+}
+
+TEST(LoRaRateController, SilentSourceAfterChangeTriggersFallback) {
+  Table table;
+  LoRaRateController controller = makeController();
+  addSource(table, "AAAAAA", -80, LoRaRateController::MIN_SAMPLES, 1000);
+  addSource(table, "BBBBBB", -80, LoRaRateController::MIN_SAMPLES, 5000);
+  controller.changed(table, 1, 10000);
+
+  EXPECT_EQ(controller.msUntilFallback(table, 10000), FALLBACK_MS);
+  table.touch("AAAAAA", 20000, -80);  // Heard at the new rate
+  EXPECT_EQ(controller.msUntilFallback(table, 20000), FALLBACK_MS - 10000);
+  EXPECT_FALSE(controller.fallbackDue(table, 10000 + FALLBACK_MS - 1));
+  EXPECT_TRUE(controller.fallbackDue(table, 10000 + FALLBACK_MS));  // BBBBBB never was
+
+  controller.changed(table, RENDEZVOUS, 10000 + FALLBACK_MS);
+  EXPECT_FALSE(controller.fallbackDue(table, 10 * FALLBACK_MS));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Rate table summary (printed, not asserted)
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaRateBenchmark, AirtimeAndLatencyPerRate) {
+  const size_t shotLen = HEADER_SIZE + PAYLOAD_SHOT_DETECTED + CRC_SIZE;
+  const size_t ackLen = HEADER_SIZE + PAYLOAD_ACK + CRC_SIZE;
+  printf("\n  DR  SF/BW        sensitivity  shot on air  ACK on air  shot latency\n");
+  for (uint8_t i = 0; i < LoRaRate::COUNT; i++) {
+    const LoRaDataRate& rate = LoRaRate::TABLE[i];
+    printf("  %u   SF%-2u/%3lu kHz  %6.1f dBm  %8.1f ms  %7.1f ms  %8lu ms\n",
+           (unsigned)i, (unsigned)rate.spreadingFactor, (unsigned long)(rate.bandwidthHz / 1000),
+           LoRaRate::SENSITIVITY_DBM10[i] / 10.0,
+           LoRaRate::airtimeUs(rate, shotLen) / 1000.0,
+           LoRaRate::airtimeUs(rate, ackLen) / 1000.0,
+           (unsigned long)LoRaRate::shotLatencyMs(rate));
+  }
+}
@@ -0,0 +1,357 @@
+/**
+ * @file test_lora_fec.cpp
+ * @brief Native tests for the BLE-LoRa Bridge forward error correction (LORA_FEC).
+ *
+ * Tests the GF(256) arithmetic and the Reed-Solomon codec in ReedSolomon.h:
+ * intact codewords, correcting up to Parity / 2 byte errors anywhere
+ * (check bytes included), refusing more, and a repaired LoRa shot frame
+ * passing the CRC-16. Prints encode/decode cost per frame and a loss curve
+ * of CRC-16 only against FEC over a random bit-error channel.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_lora_fec
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// The bridge's common.h first, as in the bridge build (both share the
+// COMMON_H guard, so the display firmware's one is skipped)
+#include "../../../BLE-LoRa-Bridge/include/common.h"
+#include "../../../BLE-LoRa-Bridge/src/LoRaPacket.cpp"
+#include "LoRaFec.h"
+#include "ReedSolomon.h"
+
+using namespace LoRaProtocol;
+
+typedef ReedSolomon::Codec<8> Rs8;
+
+// Deterministic pseudo-random numbers (LCG), so failures reproduce
+static uint32_t nextRandom(uint32_t& state) {
+  state = state * 1103515245u + 12345u;
+  return state >> 8;
+}
+
+static std::vector<uint8_t> pattern(size_t len, uint32_t seed) {
+  std::vector<uint8_t> data(len);
+  for (size_t i = 0; i < len; i++) data[i] = (uint8_t)nextRandom(seed);
+  return data;
+}
+
+// Data followed by its check bytes
+template <size_t Parity>
+static std::vector<uint8_t> codeword(const ReedSolomon::Codec<Parity>& codec, size_t dataLen, uint32_t seed) {
+  std::vector<uint8_t> word = pattern(dataLen, seed);
+  word.resize(dataLen + Parity);
+  codec.encode(word.data(), dataLen, word.data() + dataLen);
+  return word;
+}
+
+// Flips `count` distinct bytes to other values
+static void corruptBytes(std::vector<uint8_t>& data, size_t count, uint32_t& state) {
+  std::vector<bool> hit(data.size(), false);
+  while (count > 0) {
+    size_t pos = nextRandom(state) % data.size();
+    if (hit[pos]) continue;
+    hit[pos] = true;
+    data[pos] ^= (uint8_t)(1 + nextRandom(state) % 255);
+    count--;
+  }
+}
+
+static NormalizedShotData makeShot(uint16_t number, uint32_t absMs) {
+  NormalizedShotData shot;
+  shot.sessionId = 42;
+  shot.shotNumber = number;
+  shot.absoluteTimeMs = absMs;
+  shot.splitTimeMs = 250;
+  shot.isFirstShot = (number == 1);
+  strncpy(shot.deviceModel, "SG Timer GO", sizeof(shot.deviceModel) - 1);
+  shot.deviceModel[sizeof(shot.deviceModel) - 1] = '\0';
+  return shot;
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  GF(256)
+// ═════════════════════════════════════════════════════════════════
+
+TEST(GaloisField, AlphaGeneratesAllNonZeroElements) {
+  std::vector<bool> seen(256, false);
+  for (unsigned i = 0; i < 255; i++) {
+    uint8_t value = ReedSolomon::alphaPow(i);
+    ASSERT_NE(value, 0);
+    ASSERT_FALSE(seen[value]) << "α^" << i << " repeats";
+    seen[value] = true;
+  }
+  EXPECT_EQ(ReedSolomon::alphaPow(255), 1);
+}
+
+TEST(GaloisField, MultiplyMatchesCarrylessReference) {
+  for (unsigned a = 0; a < 256; a++) {
+    for (unsigned b = 0; b < 256; b += 7) {
+      // Shift-and-add, reduced by the primitive polynomial
+      unsigned product = 0, x = a;
+      for (unsigned bits = b; bits; bits >>= 1) {
+        if (bits & 1) product ^= x;
+        x <<= 1;
+        if (x & 0x100) x ^= ReedSolomon::PRIMITIVE;
+      }
+      ASSERT_EQ(ReedSolomon::mul((uint8_t)a, (uint8_t)b), product) << a << " * " << b;
+    }
+  }
+}
+
+TEST(GaloisField, DivideInvertsMultiply) {
+  for (unsigned a = 0; a < 256; a++) {
+    for (unsigned b = 1; b < 256; b++) {
+      ASSERT_EQ(ReedSolomon::div(ReedSolomon::mul((uint8_t)a, (uint8_t)b), (uint8_t)b), a);
+    }
+  }
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Codec
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ReedSolomonCodec, IntactCodewordDecodesUnchanged) {
+  Rs8 codec;
+  const size_t lengths[] = { 1, 44, MAX_PACKET_SIZE, Rs8::MAX_DATA };
+  for (size_t len : lengths) {
+    std::vector<uint8_t> word = codeword(codec, len, (uint32_t)len);
+    std::vector<uint8_t> original = word;
+    EXPECT_EQ(codec.decode(word.data(), word.size()), 0) << len << " bytes";
+    EXPECT_EQ(word, original);
+  }
+}
+
+TEST(ReedSolomonCodec, CorrectsUpToHalfTheParityAnywhere) {
+  Rs8 codec;
+  uint32_t state = 1;
+  for (int trial = 0; trial < 2000; trial++) {
+    size_t len = 1 + nextRandom(state) % 120;
+    std::vector<uint8_t> word = codeword(codec, len, state);
+    std::vector<uint8_t> original = word;
+    size_t errors = 1 + trial % Rs8::CORRECTABLE;
+    corruptBytes(word, errors, state);
+
+    ASSERT_EQ(codec.decode(word.data(), word.size()), (int)errors) << "trial " << trial;
+    ASSERT_EQ(word, original) << "trial " << trial;
+  }
+}
+
+TEST(ReedSolomonCodec, OtherParitySizes) {
+  ReedSolomon::Codec<2> rs2;
+  ReedSolomon::Codec<16> rs16;
+  uint32_t state = 7;
+  for (int trial = 0; trial < 200; trial++) {
+    std::vector<uint8_t> word2 = codeword(rs2, 50, state);
+    std::vector<uint8_t> original2 = word2;
+    corruptBytes(word2, 1, state);
+    ASSERT_EQ(rs2.decode(word2.data(), word2.size()), 1);
+    ASSERT_EQ(word2, original2);
+
+    std::vector<uint8_t> word16 = codeword(rs16, 50, state);
+    std::vector<uint8_t> original16 = word16;
+    corruptBytes(word16, 8, state);
+    ASSERT_EQ(rs16.decode(word16.data(), word16.size()), 8);
+    ASSERT_EQ(word16, original16);
+  }
+}
+
+TEST(ReedSolomonCodec, TooManyErrorsLeaveTheCodewordUnchanged) {
+  Rs8 codec;
+  uint32_t state = 3;
+  int refused = 0;
+  const int trials = 2000;
+  for (int trial = 0; trial < trials; trial++) {
+    std::vector<uint8_t> word = codeword(codec, 44, state);
+    corruptBytes(word, Rs8::CORRECTABLE + 1 + trial % 4, state);
+    std::vector<uint8_t> corrupted = word;
+    int result = codec.decode(word.data(), word.size());
+    if (result < 0) {
+      ASSERT_EQ(word, corrupted);
+      refused++;
+    } else {
+      // Decoded to a different codeword: the CRC-16 inside has to catch it
+      ASSERT_LE(result, (int)Rs8::CORRECTABLE);
+    }
+  }
+  // Short codewords leave most error patterns far from any other codeword
+  EXPECT_GT(refused, trials * 95 / 100);
+}
+
+TEST(ReedSolomonCodec, RejectsBadLengths) {
+  Rs8 codec;
+  uint8_t word[ReedSolomon::MAX_CODEWORD + 1] = {0};
+  EXPECT_EQ(codec.decode(word, Rs8::PARITY), -1);
+  EXPECT_EQ(codec.decode(word, sizeof(word)), -1);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  LoRa frames
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaFec, RepairedShotFramePassesCrc) {
+  Rs8 codec;
+  uint8_t frame[MAX_PACKET_SIZE + Rs8::PARITY];
+  size_t len = serializeShotDetected(frame, MAX_PACKET_SIZE, "TX0001", makeShot(3, 4567));
+  ASSERT_GT(len, 0u);
+  codec.encode(frame, len, frame + len);
+
+  // Header, payload and CRC bytes
+  frame[0] ^= 0xFF;
+  frame[3] ^= 0x10;
+  frame[len / 2] ^= 0x01;
+  frame[len - 1] ^= 0x80;
+  ParsedPacket pkt;
+  EXPECT_FALSE(deserialize(frame, len, pkt));
+
+  EXPECT_EQ(codec.decode(frame, len + Rs8::PARITY), 4);
+  ASSERT_TRUE(deserialize(frame, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::SHOT_DETECTED);
+  EXPECT_EQ(pkt.shot.shotNumber, 3);
+  EXPECT_EQ(pkt.shot.absoluteTimeMs, 4567u);
+}
+
+TEST(LoRaFec, ParityFollowsTheBuildFlag) {
+  EXPECT_EQ(LoRaFec::PARITY, LORA_FEC ? (size_t)LORA_FEC_PARITY : 0u);
+  EXPECT_EQ(LoRaFec::MAX_FRAME_SIZE, MAX_PACKET_SIZE + LoRaFec::PARITY);
+  EXPECT_LE(LoRaFec::MAX_FRAME_SIZE, ReedSolomon::MAX_CODEWORD);
+
+  uint8_t frame[LoRaFec::MAX_FRAME_SIZE];
+  size_t len = serializeShotDetected(frame, MAX_PACKET_SIZE, "TX0001", makeShot(1, 100));
+  LoRaFec::encode(frame, len, frame + len);
+  frame[5] ^= 0x42;
+  int corrected = -1;
+  size_t decoded = LoRaFec::decode(frame, len + LoRaFec::PARITY, corrected);
+  ParsedPacket pkt;
+  if (LORA_FEC) {
+    EXPECT_EQ(decoded, len);
+    EXPECT_EQ(corrected, 1);
+    EXPECT_TRUE(deserialize(frame, decoded, pkt));
+  } else {
+    // Passed through untouched: the CRC-16 rejects it
+    EXPECT_EQ(decoded, len);
+    EXPECT_EQ(corrected, 0);
+    EXPECT_FALSE(deserialize(frame, decoded, pkt));
+  }
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Benchmark
+// ═════════════════════════════════════════════════════════════════
+// Not a pass/fail timing test: prints ns per frame so the cost is
+// visible in the test log. Host numbers only; the ESP32 is slower by
+// roughly its clock ratio.
+
+template <typename Fn>
+static double nsPerCall(Fn fn, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) fn(i);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+TEST(LoRaFecBenchmark, NsPerFrame) {
+  Rs8 codec;
+  ReedSolomon::gf();  // Build outside the timed loop
+  volatile int sink = 0;  // Keeps the loops from being optimised away
+
+  const size_t sizes[] = { 44, MAX_PACKET_SIZE };  // One-shot frame, largest frame
+  for (size_t len : sizes) {
+    std::vector<uint8_t> clean = codeword(codec, len, 11);
+    std::vector<uint8_t> damaged = clean;
+    uint32_t state = 5;
+    corruptBytes(damaged, Rs8::CORRECTABLE, state);
+    std::vector<uint8_t> work(clean.size());
+    const int iterations = 20000;
+
+    double encode = nsPerCall([&](int i) {
+      clean[0] = (uint8_t)i;
+      codec.encode(clean.data(), len, work.data());
+      sink = sink + work[0];
+    }, iterations);
+    clean = codeword(codec, len, 11);
+    double decodeClean = nsPerCall([&](int) {
+      memcpy(work.data(), clean.data(), clean.size());
+      sink = sink + codec.decode(work.data(), work.size());
+    }, iterations);
+    double decodeRepair = nsPerCall([&](int) {
+      memcpy(work.data(), damaged.data(), damaged.size());
+      sink = sink + codec.decode(work.data(), work.size());
+    }, iterations);
+
+    printf("  %3zu + %zu bytes: encode %7.0f ns, decode intact %7.0f ns, %zu errors %7.0f ns\n",
+           len, Rs8::PARITY, encode, decodeClean, Rs8::CORRECTABLE, decodeRepair);
+    EXPECT_GT(encode, 0.0);
+  }
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Loss curve
+// ═════════════════════════════════════════════════════════════════
+// A one-shot frame through a channel that flips each bit independently
+// with probability `ber`. CRC-16 only: any flipped bit loses the frame
+// (the SX1276 payload CRC drops it first). FEC: the longer frame is
+// decoded and must then pass the CRC-16. Real LoRa errors come in bursts
+// of a symbol (SF bits) at a time, which the byte-oriented code handles
+// about as well as single bits, so this is a fair first-order comparison.
+
+struct LossPoint {
+  int crcDelivered;
+  int fecDelivered;
+  int fecUndetected;  // Passed the CRC-16 with the wrong content
+};
+
+static LossPoint simulate(double ber, int trials, uint32_t seed) {
+  Rs8 codec;
+  LossPoint point = {0, 0, 0};
+  const uint32_t threshold = (uint32_t)(ber * 16777216.0);  // nextRandom() is 24 bits
+  for (int trial = 0; trial < trials; trial++) {
+    NormalizedShotData shot = makeShot((uint16_t)(trial + 1), (uint32_t)trial * 731u);
+    uint8_t sent[MAX_PACKET_SIZE + Rs8::PARITY];
+    size_t len = serializeShotDetected(sent, MAX_PACKET_SIZE, "TX0001", shot);
+    codec.encode(sent, len, sent + len);
+
+    uint8_t received[sizeof(sent)];
+    memcpy(received, sent, len + Rs8::PARITY);
+    for (size_t bit = 0; bit < (len + Rs8::PARITY) * 8; bit++) {
+      if ((nextRandom(seed) & 0xFFFFFF) < threshold) received[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+    }
+
+    ParsedPacket pkt;
+    if (memcmp(received, sent, len) == 0 && deserialize(received, len, pkt)) point.crcDelivered++;
+
+    if (codec.decode(received, len + Rs8::PARITY) >= 0 && deserialize(received, len, pkt)) {
+      if (pkt.shot.shotNumber == shot.shotNumber && pkt.shot.absoluteTimeMs == shot.absoluteTimeMs) {
+        point.fecDelivered++;
+      } else {
+        point.fecUndetected++;
+      }
+    }
+  }
+  return point;
+}
+
+TEST(LoRaFecLossCurve, FecDeliversAtLeastAsMuch) {
+  const double bers[] = { 0.0, 1e-4, 3e-4, 1e-3, 3e-3, 1e-2, 2e-2 };
+  const int trials = 2000;
+  printf("  BER       CRC-16 only   FEC (+%zu bytes)\n", Rs8::PARITY);
+  for (double ber : bers) {
+    LossPoint point = simulate(ber, trials, 99);
+    printf("  %-8.0e  %6.2f %%      %6.2f %%\n", ber,
+           100.0 * point.crcDelivered / trials, 100.0 * point.fecDelivered / trials);
+    EXPECT_GE(point.fecDelivered, point.crcDelivered) << "BER " << ber;
+    EXPECT_EQ(point.fecUndetected, 0) << "BER " << ber;
+  }
+
+  // Where a shot frame averages about one flipped bit, CRC-16 alone loses
+  // most of them and FEC almost none
+  LossPoint point = simulate(3e-3, trials, 123);
+  EXPECT_LT(point.crcDelivered, trials * 40 / 100);
+  EXPECT_GT(point.fecDelivered, trials * 95 / 100);
+}
@@ -0,0 +1,550 @@
+/**
+ * @file test_lora_reliable.cpp
+ * @brief Native tests for the BLE-LoRa Bridge reliable link (LORA_RELIABLE).
+ *
+ * Tests the sequence-number field and ACK packet on the wire, the
+ * receiver's LoRaRxWindow (duplicates, reordering, SYNC restarts, wrap)
+ * and the transmitter's LoRaTxHistory (cumulative and selective ACKs,
+ * timeouts, retry limit). A host-side link simulation then runs shot
+ * strings over a channel with configurable packet loss, once
+ * fire-and-forget and once with ACK/retransmission scheduled the way
+ * LoRaTransmitter does it, and prints the delivered-shot ratio and the
+ * latency retransmission adds.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_lora_reliable
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// The bridge's common.h first, as in the bridge build (both share the
+// COMMON_H guard, so the display firmware's one is skipped)
+#include "../../../BLE-LoRa-Bridge/include/common.h"
+#include "../../../BLE-LoRa-Bridge/src/LoRaPacket.cpp"
+#include "LoRaArq.h"
+
+using namespace LoRaProtocol;
+
+static NormalizedShotData makeShot(uint16_t number, uint32_t absMs, uint32_t sessionId = 42) {
+  NormalizedShotData shot;
+  shot.sessionId = sessionId;
+  shot.shotNumber = number;
+  shot.absoluteTimeMs = absMs;
+  shot.splitTimeMs = 250;
+  shot.isFirstShot = (number == 1);
+  strncpy(shot.deviceModel, "SG Timer GO", sizeof(shot.deviceModel) - 1);
+  shot.deviceModel[sizeof(shot.deviceModel) - 1] = '\0';
+  return shot;
+}
+
+static TxPacket makePacket(uint8_t tag) {
+  TxPacket packet;
+  packet.length = 1;
+  packet.data[0] = tag;
+  packet.airtimeUs = 20000;
+  packet.sequenced = true;
+  packet.traceCount = 0;
+  return packet;
+}
+
+typedef LoRaTxHistory<8> History;
+
+// ═════════════════════════════════════════════════════════════════
+//  Wire format
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaReliableWire, SequencedShotRoundTrip) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  NormalizedShotData shot = makeShot(7, 12345);
+  size_t len = serializeShotDetected(buf, sizeof(buf), "TX0001", shot);
+  ASSERT_GT(len, 0u);
+
+  size_t seqLen = addSequence(buf, len, sizeof(buf), 0xBEEF, true);
+  ASSERT_EQ(seqLen, len + SEQ_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, seqLen, pkt));
+  EXPECT_EQ(pkt.type, PacketType::SHOT_DETECTED);
+  EXPECT_TRUE(pkt.sequenced);
+  EXPECT_TRUE(pkt.sync);
+  EXPECT_EQ(pkt.seq, 0xBEEF);
+  EXPECT_STREQ(pkt.sourceId, "TX0001");
+  EXPECT_EQ(pkt.shot.shotNumber, 7);
+  EXPECT_EQ(pkt.shot.absoluteTimeMs, 12345u);
+  EXPECT_STREQ(pkt.shot.deviceModel, "SG Timer GO");
+}
+
+TEST(LoRaReliableWire, UnsequencedPacketUnchanged) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeHeartbeat(buf, sizeof(buf), "TX0001", 5000);
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::HEARTBEAT);
+  EXPECT_FALSE(pkt.sequenced);
+  EXPECT_FALSE(pkt.sync);
+  EXPECT_EQ(pkt.uptimeMs, 5000u);
+}
+
+TEST(LoRaReliableWire, SequencedBatchRoundTrip) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  ShotBatch batch;
+  for (uint16_t n = 1; n <= 3; n++) ASSERT_TRUE(batch.add(makeShot(n, n * 250)));
+  size_t len = serializeShotBatch(buf, sizeof(buf), "TX0001", batch);
+  size_t seqLen = addSequence(buf, len, sizeof(buf), 9, false);
+  ASSERT_EQ(seqLen, len + SEQ_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, seqLen, pkt));
+  EXPECT_EQ(pkt.type, PacketType::SHOT_BATCH);
+  EXPECT_FALSE(pkt.sync);
+  EXPECT_EQ(pkt.seq, 9);
+  ASSERT_EQ(pkt.batchCount, 3u);
+  EXPECT_EQ(batchShot(pkt, 2).absoluteTimeMs, 750u);
+}
+
+TEST(LoRaReliableWire, AddSequenceRejectsSecondSequenceAndSmallBuffer) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeSessionStarted(buf, sizeof(buf), "TX0001", 3, 2.5f);
+  EXPECT_EQ(addSequence(buf, len, len + 1, 1, false), 0u);
+  size_t seqLen = addSequence(buf, len, sizeof(buf), 1, false);
+  ASSERT_GT(seqLen, 0u);
+  EXPECT_EQ(addSequence(buf, seqLen, sizeof(buf), 2, false), 0u);
+}
+
+TEST(LoRaReliableWire, SequenceIsCoveredByCrc) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeSessionStopped(buf, sizeof(buf), "TX0001", 3, 10, 9000);
+  size_t seqLen = addSequence(buf, len, sizeof(buf), 100, false);
+  buf[HEADER_SIZE] ^= 0x01;
+  ParsedPacket pkt;
+  EXPECT_FALSE(deserialize(buf, seqLen, pkt));
+}
+
+TEST(LoRaReliableWire, AckRoundTrip) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeAck(buf, sizeof(buf), "RX0001", "TX0001", 0xFFFE, 0x80000005u);
+  ASSERT_EQ(len, HEADER_SIZE + PAYLOAD_ACK + CRC_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::ACK);
+  EXPECT_FALSE(pkt.sequenced);
+  EXPECT_STREQ(pkt.sourceId, "RX0001");
+  EXPECT_STREQ(pkt.destId, "TX0001");
+  EXPECT_EQ(pkt.ackBase, 0xFFFE);
+  EXPECT_EQ(pkt.ackMask, 0x80000005u);
+}
+
+TEST(LoRaReliableWire, SequencedAckRejected) {
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeAck(buf, sizeof(buf), "RX0001", "TX0001", 1, 0);
+  size_t seqLen = addSequence(buf, len, sizeof(buf), 1, false);
+  ParsedPacket pkt;
+  EXPECT_FALSE(deserialize(buf, seqLen, pkt));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  LoRaRxWindow
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaRxWindow, InOrderAdvancesBase) {
+  LoRaRxWindow window;
+  window.reset();
+  for (uint16_t seq = 500; seq < 510; seq++) EXPECT_TRUE(window.accept(seq, seq == 500));
+  EXPECT_EQ(window.base, 510);
+  EXPECT_EQ(window.mask, 0u);
+  EXPECT_FALSE(window.accept(509, false));
+  EXPECT_FALSE(window.accept(500, true));  // Resent first packet, still SYNC
+}
+
+TEST(LoRaRxWindow, GapIsReportedAndFilledOnce) {
+  LoRaRxWindow window;
+  window.reset();
+  EXPECT_TRUE(window.accept(10, true));
+  EXPECT_TRUE(window.accept(12, false));
+  EXPECT_TRUE(window.accept(14, false));
+  EXPECT_EQ(window.base, 11);
+  EXPECT_EQ(window.mask, 0x5u);  // 12 and 14 received, 11 and 13 missing
+
+  EXPECT_TRUE(window.accept(11, false));
+  EXPECT_EQ(window.base, 13);
+  EXPECT_EQ(window.mask, 0x1u);
+  EXPECT_FALSE(window.accept(14, false));
+  EXPECT_TRUE(window.accept(13, false));
+  EXPECT_EQ(window.base, 15);
+  EXPECT_EQ(window.mask, 0u);
+}
+
+TEST(LoRaRxWindow, SequenceWrap) {
+  LoRaRxWindow window;
+  window.reset();
+  EXPECT_TRUE(window.accept(0xFFFE, true));
+  EXPECT_TRUE(window.accept(0x0000, false));
+  EXPECT_TRUE(window.accept(0xFFFF, false));
+  EXPECT_EQ(window.base, 1);
+  EXPECT_FALSE(window.accept(0xFFFF, false));
+}
+
+TEST(LoRaRxWindow, SyncFromRebootedTransmitterRestarts) {
+  LoRaRxWindow window;
+  window.reset();
+  for (uint16_t seq = 100; seq < 150; seq++) window.accept(seq, seq == 100);
+  // Rebooted: a new random start just below the old numbers
+  EXPECT_TRUE(window.accept(140, true));
+  EXPECT_EQ(window.base, 141);
+  EXPECT_TRUE(window.accept(141, true));
+  EXPECT_FALSE(window.accept(140, true));
+}
+
+TEST(LoRaRxWindow, FarJumpRestarts) {
+  LoRaRxWindow window;
+  window.reset();
+  window.accept(100, true);
+  EXPECT_TRUE(window.accept(100 + 2 * LoRaArq::WINDOW, false));
+  EXPECT_EQ(window.base, 101 + 2 * LoRaArq::WINDOW);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  LoRaTxHistory
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaTxHistory, CumulativeAckConfirmsAll) {
+  History history(250, 4);
+  for (uint16_t seq = 0; seq < 5; seq++) history.sent(makePacket((uint8_t)seq), seq, 0);
+  EXPECT_EQ(history.acknowledge(3, 0), 3u);
+  EXPECT_EQ(history.size(), 2u);
+  EXPECT_EQ(history.acknowledge(5, 0), 2u);
+  EXPECT_TRUE(history.empty());
+  EXPECT_EQ(history.due(10000), nullptr);
+}
+
+TEST(LoRaTxHistory, SelectiveAckResendsOnlyTheGapAtOnce) {
+  History history(250, 4);
+  for (uint16_t seq = 10; seq < 14; seq++) history.sent(makePacket((uint8_t)seq), seq, 0);
+  // 10 received, 11 lost, 12 and 13 received
+  EXPECT_EQ(history.acknowledge(11, 0x3u), 3u);
+  ASSERT_EQ(history.size(), 1u);
+
+  History::Entry* entry = history.due(1);  // NACKed: no need to wait for the timeout
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->seq, 11);
+  EXPECT_EQ(entry->packet.data[0], 11);
+  history.resent(*entry, 1);
+  EXPECT_EQ(history.due(2), nullptr);
+  EXPECT_EQ(history.getRetransmits(), 1u);
+}
+
+TEST(LoRaTxHistory, NewestUnacknowledgedWaitsForTimeout) {
+  History history(250, 4);
+  history.sent(makePacket(1), 1, 1000);
+  history.sent(makePacket(2), 2, 1100);
+  // ACK to 1 only: 2 may still be answered
+  history.acknowledge(2, 0);
+  EXPECT_EQ(history.due(1200), nullptr);
+  EXPECT_EQ(history.msUntilDue(1200), 150u);
+  EXPECT_EQ(history.peekDue(1349), nullptr);
+  ASSERT_NE(history.peekDue(1350), nullptr);
+  ASSERT_NE(history.due(1350), nullptr);
+  EXPECT_EQ(history.due(1350)->seq, 2);
+}
+
+TEST(LoRaTxHistory, GivesUpAfterMaxTransmissions) {
+  History history(100, 3);
+  history.sent(makePacket(1), 1, 0);
+  uint32_t now = 0;
+  for (int attempt = 2; attempt <= 3; attempt++) {
+    now += 100;
+    History::Entry* entry = history.due(now);
+    ASSERT_NE(entry, nullptr);
+    history.resent(*entry, now);
+  }
+  EXPECT_EQ(history.due(now + 100), nullptr);
+  EXPECT_TRUE(history.empty());
+  EXPECT_EQ(history.getLost(), 1u);
+  EXPECT_EQ(history.getRetransmits(), 2u);
+}
+
+TEST(LoRaTxHistory, FullHistoryGivesUpOldest) {
+  LoRaTxHistory<2> history(250, 4);
+  history.sent(makePacket(1), 1, 0);
+  history.sent(makePacket(2), 2, 0);
+  history.sent(makePacket(3), 3, 0);
+  EXPECT_EQ(history.size(), 2u);
+  EXPECT_EQ(history.getLost(), 1u);
+  EXPECT_EQ(history.acknowledge(1, 0x3u), 2u);  // 2 and 3
+}
+
+TEST(LoRaTxHistory, StaleAckIsHarmless) {
+  History history(250, 4);
+  history.sent(makePacket(5), 5, 0);
+  history.sent(makePacket(6), 6, 0);
+  history.acknowledge(6, 0);
+  EXPECT_EQ(history.acknowledge(5, 0), 0u);  // Older ACK arriving late
+  EXPECT_EQ(history.size(), 1u);
+  EXPECT_EQ(history.due(10), nullptr);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Link simulation
+// ═════════════════════════════════════════════════════════════════
+//
+// 1 ms ticks. A frame reaches the other side when its time on air ends,
+// unless the channel drops it (independently per frame, both directions).
+// The transmitter side follows LoRaTransmitter::startNextTransmit(): wait
+// for the ACK, resends first, then the next queued packet. The receiver
+// side follows BridgeApplication::onLoRaPacket(): every sequenced packet is
+// ACKed after RX_TURNAROUND_MS, only new ones are published. One
+// SHOT_DETECTED per shot; the duty-cycle budget is not simulated.
+
+namespace {
+
+constexpr uint32_t RX_TURNAROUND_MS = 5;  // Drain task + main loop until the ACK starts
+constexpr uint32_t SHOTS_PER_STRING = 10;
+constexpr uint32_t SPLIT_MS = 250;
+constexpr uint32_t STRING_GAP_MS = 3000;
+constexpr uint32_t STRINGS = 100;
+
+uint32_t airtimeMs(size_t len) {
+  uint32_t us = timeOnAirUs(len, LORA_SPREADING_FACTOR, (uint32_t)LORA_BANDWIDTH,
+                            LORA_CODING_RATE, LORA_PREAMBLE_LENGTH);
+  return (us + 999) / 1000;
+}
+
+struct Frame {
+  uint32_t arrivesAt;
+  uint8_t length;
+  uint8_t data[MAX_PACKET_SIZE];
+};
+
+struct SimResult {
+  uint32_t shots = 0;
+  uint32_t delivered = 0;
+  uint32_t duplicatePublishes = 0;
+  uint32_t dataFrames = 0;
+  uint32_t ackFrames = 0;
+  std::vector<uint32_t> latencyMs;  // Shot to publish, delivered shots
+
+  double ratio() const { return shots ? (double)delivered / shots : 0.0; }
+  uint32_t percentile(double p) const {
+    if (latencyMs.empty()) return 0;
+    std::vector<uint32_t> sorted = latencyMs;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+  }
+  double mean() const {
+    if (latencyMs.empty()) return 0;
+    double sum = 0;
+    for (uint32_t ms : latencyMs) sum += ms;
+    return sum / latencyMs.size();
+  }
+};
+
+class LinkSim {
+public:
+  LinkSim(double lossRate, bool reliable, uint32_t seed)
+    : lossRate(lossRate), reliable(reliable), rng(seed),
+      history(LORA_ACK_TIMEOUT_MS, LORA_MAX_TRANSMISSIONS) {
+    window.reset();
+  }
+
+  SimResult run() {
+    const uint32_t stringMs = SHOTS_PER_STRING * SPLIT_MS + STRING_GAP_MS;
+    const uint32_t endMs = STRINGS * stringMs + 10000;  // Let the last retries finish
+    published.assign(STRINGS * SHOTS_PER_STRING, 0);
+
+    for (uint32_t now = 0; now < endMs; now++) {
+      uint32_t inString = now % stringMs;
+      uint32_t string = now / stringMs;
+      if (string < STRINGS && inString % SPLIT_MS == 0 && inString / SPLIT_MS < SHOTS_PER_STRING) {
+        queueShot(string, inString / SPLIT_MS, now);
+      }
+      deliver(now);
+      runTransmitter(now);
+    }
+    return result;
+  }
+
+private:
+  bool lost() {
+    rng = rng * 1103515245u + 12345u;  // LCG - deterministic across platforms
+    return ((rng >> 16) & 0x7FFF) < lossRate * 0x8000;
+  }
+
+  void send(std::vector<Frame>& link, const uint8_t* data, size_t len, uint32_t now) {
+    if (lost()) return;
+    Frame frame;
+    frame.arrivesAt = now + airtimeMs(len);
+    frame.length = (uint8_t)len;
+    memcpy(frame.data, data, len);
+    link.push_back(frame);
+  }
+
+  void queueShot(uint32_t string, uint32_t index, uint32_t now) {
+    // Shot numbers are unique across the run so each one can be tracked
+    uint16_t id = (uint16_t)(string * SHOTS_PER_STRING + index);
+    NormalizedShotData shot = makeShot((uint16_t)(index + 1), now, (uint32_t)string + 1);
+    shot.shotNumber = id;
+    shot.isFirstShot = (index == 0);
+    TxPacket packet;
+    packet.length = (uint8_t)serializeShotDetected(packet.data, sizeof(packet.data), "TX0001", shot);
+    packet.sequenced = reliable;
+    packet.traceCount = 0;
+    queue.push_back(packet);
+    result.shots++;
+  }
+
+  // ─── Transmitter (LoRaTransmitter) ───
+
+  void runTransmitter(uint32_t now) {
+    if (now < txBusyUntil) return;
+    if (onAir) {
+      onAir = false;
+      if (inFlight.sequenced) {
+        awaitingAck = true;
+        ackWaitStartedAt = now;
+      }
+    }
+    if (awaitingAck) {
+      if (now - ackWaitStartedAt < LORA_ACK_TIMEOUT_MS) return;
+      awaitingAck = false;
+    }
+
+    History::Entry* resend = history.due(now);
+    if (resend) {
+      inFlight = resend->packet;
+      history.resent(*resend, now);
+      transmit(now);
+      return;
+    }
+    if (queue.empty()) return;
+
+    inFlight = queue.front();
+    queue.pop_front();
+    if (inFlight.sequenced) {
+      inFlight.length = (uint8_t)addSequence(inFlight.data, inFlight.length, sizeof(inFlight.data),
+                                             nextSeq, !synced);
+      history.sent(inFlight, nextSeq, now);
+      nextSeq++;
+    }
+    transmit(now);
+  }
+
+  void transmit(uint32_t now) {
+    send(toReceiver, inFlight.data, inFlight.length, now);
+    onAir = true;
+    txBusyUntil = now + airtimeMs(inFlight.length);
+    result.dataFrames++;
+  }
+
+  void receiveAck(const ParsedPacket& pkt) {
+    ASSERT_EQ(pkt.type, PacketType::ACK);
+    ASSERT_STREQ(pkt.destId, "TX0001");
+    history.acknowledge(pkt.ackBase, pkt.ackMask);
+    synced = true;
+    awaitingAck = false;
+  }
+
+  // ─── Receiver (BridgeApplication) ───
+
+  void receive(const ParsedPacket& pkt, uint32_t now) {
+    if (pkt.sequenced) {
+      bool fresh = window.accept(pkt.seq, pkt.sync);
+      uint8_t ack[MAX_PACKET_SIZE];
+      size_t len = serializeAck(ack, sizeof(ack), "RX0001", pkt.sourceId, window.base, window.mask);
+      send(toTransmitter, ack, len, now + RX_TURNAROUND_MS);
+      result.ackFrames++;
+      if (!fresh) return;
+    }
+
+    uint16_t id = pkt.shot.shotNumber;
+    if (published[id]++) {
+      result.duplicatePublishes++;
+      return;
+    }
+    result.delivered++;
+    result.latencyMs.push_back(now - pkt.shot.absoluteTimeMs);
+  }
+
+  void deliver(uint32_t now) {
+    for (size_t i = 0; i < toReceiver.size(); ) {
+      if (toReceiver[i].arrivesAt != now) { i++; continue; }
+      ParsedPacket pkt;
+      ASSERT_TRUE(deserialize(toReceiver[i].data, toReceiver[i].length, pkt));
+      toReceiver.erase(toReceiver.begin() + i);
+      receive(pkt, now);
+    }
+    for (size_t i = 0; i < toTransmitter.size(); ) {
+      if (toTransmitter[i].arrivesAt != now) { i++; continue; }
+      ParsedPacket pkt;
+      ASSERT_TRUE(deserialize(toTransmitter[i].data, toTransmitter[i].length, pkt));
+      toTransmitter.erase(toTransmitter.begin() + i);
+      receiveAck(pkt);
+    }
+  }
+
+  double lossRate;
+  bool reliable;
+  uint32_t rng;
+  SimResult result;
+
+  // Transmitter
+  std::deque<TxPacket> queue;
+  LoRaTxHistory<LORA_TX_HISTORY_DEPTH> history;
+  TxPacket inFlight;
+  bool onAir = false;
+  uint32_t txBusyUntil = 0;
+  uint16_t nextSeq = 0xFFF0;  // Wraps during the run
+  bool synced = false;
+  bool awaitingAck = false;
+  uint32_t ackWaitStartedAt = 0;
+
+  // Receiver
+  LoRaRxWindow window;
+  std::vector<uint8_t> published;
+
+  std::vector<Frame> toReceiver;
+  std::vector<Frame> toTransmitter;
+};
+
+SimResult simulate(double lossRate, bool reliable) {
+  return LinkSim(lossRate, reliable, 20240611u).run();
+}
+
+}  // namespace
+
+TEST(LoRaReliableSim, LosslessLinkDeliversEverythingOnce) {
+  for (bool reliable : {false, true}) {
+    SimResult r = simulate(0.0, reliable);
+    EXPECT_EQ(r.delivered, r.shots) << (reliable ? "reliable" : "fire-and-forget");
+    EXPECT_EQ(r.duplicatePublishes, 0u);
+    EXPECT_EQ(r.dataFrames, r.shots);
+  }
+}
+
+TEST(LoRaReliableSim, DeliveryAndLatencyUnderLoss) {
+  const double lossRates[] = {0.0, 0.05, 0.10, 0.20, 0.30};
+  printf("  loss | fire-and-forget | reliable: delivered  latency mean/p95/max ms  frames data+ack\n");
+  for (double loss : lossRates) {
+    SimResult plain = simulate(loss, false);
+    SimResult arq = simulate(loss, true);
+    printf("  %3.0f%% |         %6.2f%% |           %6.2f%%  %6.1f / %4u / %4u      %5u + %5u\n",
+           loss * 100, plain.ratio() * 100, arq.ratio() * 100,
+           arq.mean(), arq.percentile(0.95), arq.percentile(1.0),
+           (unsigned)arq.dataFrames, (unsigned)arq.ackFrames);
+
+    EXPECT_EQ(arq.duplicatePublishes, 0u) << loss;
+    EXPECT_GE(arq.ratio(), plain.ratio()) << loss;
+    if (loss > 0) {
+      EXPECT_GT(arq.ratio(), plain.ratio()) << loss;
+    }
+    if (loss <= 0.10) {
+      EXPECT_GE(arq.ratio(), 0.995) << loss;
+    }
+  }
+}
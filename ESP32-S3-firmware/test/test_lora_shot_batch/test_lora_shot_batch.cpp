@@ -0,0 +1,293 @@
+/**
+ * @file test_lora_shot_batch.cpp
+ * @brief Native tests for the SHOT_BATCH LoRa packet (BLE-LoRa Bridge).
+ *
+ * Tests LoRaProtocol::ShotBatch acceptance rules, the delta-encoded wire
+ * format round trip through deserialize()/batchShot(), corrupt-frame
+ * rejection, and the airtime saving over one SHOT_DETECTED per shot at
+ * the bridge's radio settings.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_lora_shot_batch
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// The bridge's common.h first, as in the bridge build (both share the
+// COMMON_H guard, so the display firmware's one is skipped)
+#include "../../../BLE-LoRa-Bridge/include/common.h"
+#include "../../../BLE-LoRa-Bridge/src/LoRaPacket.cpp"
+
+using namespace LoRaProtocol;
+
+// Bridge radio settings
+static constexpr uint8_t  SF = LORA_SPREADING_FACTOR;
+static constexpr uint32_t BW = (uint32_t)LORA_BANDWIDTH;
+static constexpr uint8_t  CR = LORA_CODING_RATE;
+static constexpr uint16_t PREAMBLE = LORA_PREAMBLE_LENGTH;
+
+static NormalizedShotData makeShot(uint16_t number, uint32_t absMs, uint32_t splitMs,
+                                   uint32_t sessionId = 42, const char* model = "SG Timer GO") {
+  NormalizedShotData shot;
+  shot.sessionId = sessionId;
+  shot.shotNumber = number;
+  shot.absoluteTimeMs = absMs;
+  shot.splitTimeMs = splitMs;
+  shot.isFirstShot = (number == 1);
+  strncpy(shot.deviceModel, model, sizeof(shot.deviceModel) - 1);
+  return shot;
+}
+
+// A rapid string: first shot after the draw, then even splits
+static std::vector<NormalizedShotData> makeString(size_t shots, uint32_t drawMs, uint32_t splitMs) {
+  std::vector<NormalizedShotData> out;
+  uint32_t t = drawMs;
+  for (size_t i = 0; i < shots; i++) {
+    uint32_t split = (i == 0) ? drawMs : splitMs;
+    if (i > 0) t += splitMs;
+    out.push_back(makeShot((uint16_t)(i + 1), t, split));
+  }
+  return out;
+}
+
+static void expectSameShot(const NormalizedShotData& got, const NormalizedShotData& want) {
+  EXPECT_EQ(got.sessionId, want.sessionId);
+  EXPECT_EQ(got.shotNumber, want.shotNumber);
+  EXPECT_EQ(got.absoluteTimeMs, want.absoluteTimeMs);
+  EXPECT_EQ(got.splitTimeMs, want.splitTimeMs);
+  EXPECT_EQ(got.isFirstShot, want.isFirstShot);
+  EXPECT_STREQ(got.deviceModel, want.deviceModel);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Round trip
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShotBatchRoundTrip, TenShotStringExpandsToOriginalShots) {
+  std::vector<NormalizedShotData> string = makeString(10, 1840, 230);
+  ShotBatch batch;
+  for (const auto& shot : string) ASSERT_TRUE(batch.add(shot));
+
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotBatch(buf, sizeof(buf), "A1B2C3", batch);
+  ASSERT_GT(len, 0u);
+  EXPECT_EQ(len, HEADER_SIZE + batch.payloadSize() + CRC_SIZE);
+
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  EXPECT_EQ(pkt.type, PacketType::SHOT_BATCH);
+  EXPECT_STREQ(pkt.sourceId, "A1B2C3");
+  ASSERT_EQ(pkt.batchCount, 10);
+  for (size_t i = 0; i < string.size(); i++) {
+    expectSameShot(batchShot(pkt, i), string[i]);
+  }
+}
+
+TEST(ShotBatchRoundTrip, MidStringBatchIsNotFirstShot) {
+  ShotBatch batch;
+  ASSERT_TRUE(batch.add(makeShot(5, 3000, 250)));
+  ASSERT_TRUE(batch.add(makeShot(6, 3250, 250)));
+
+  uint8_t buf[MAX_PACKET_SIZE];
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, serializeShotBatch(buf, sizeof(buf), "TX0001", batch), pkt));
+  EXPECT_FALSE(batchShot(pkt, 0).isFirstShot);
+  EXPECT_FALSE(batchShot(pkt, 1).isFirstShot);
+  EXPECT_EQ(batchShot(pkt, 0).splitTimeMs, 250u);
+}
+
+TEST(ShotBatchRoundTrip, LargeDeltasAndFullBatchFitInMaxPacket) {
+  // Worst case: 16-char model, 5-byte varints everywhere
+  ShotBatch batch;
+  uint32_t t = 0x0FFFFFFF;
+  ASSERT_TRUE(batch.add(makeShot(100, t, 0xFFFFFFFF, 7, "0123456789ABCDEFXYZ")));
+  for (uint16_t n = 101; !batch.full(); n++) {
+    t += 0x10000000;
+    ASSERT_TRUE(batch.add(makeShot(n, t, 0x10000000, 7, "0123456789ABCDEFXYZ")));
+  }
+  EXPECT_EQ(batch.payloadSize(), MAX_PAYLOAD_SIZE);
+
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotBatch(buf, sizeof(buf), "TX0001", batch);
+  ASSERT_EQ(len, MAX_PACKET_SIZE - SEQ_SIZE);  // Largest unsequenced packet
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, len, pkt));
+  ASSERT_EQ(pkt.batchCount, MAX_BATCH_SHOTS);
+  EXPECT_STREQ(batchShot(pkt, 0).deviceModel, "0123456789ABCDEF");  // Truncated like SHOT_DETECTED
+  EXPECT_EQ(batchShot(pkt, 0).splitTimeMs, 0xFFFFFFFFu);
+  EXPECT_EQ(batchShot(pkt, MAX_BATCH_SHOTS - 1).absoluteTimeMs, t);
+}
+
+TEST(ShotBatchRoundTrip, ShotNumberGapsWithinRange) {
+  ShotBatch batch;
+  ASSERT_TRUE(batch.add(makeShot(1, 1000, 1000)));
+  ASSERT_TRUE(batch.add(makeShot(4, 1500, 500)));      // Timer dropped two shots
+  ASSERT_TRUE(batch.add(makeShot(259, 1600, 100)));    // Gap of 255 still fits
+  EXPECT_FALSE(batch.add(makeShot(515, 1700, 100)));   // 256 does not
+
+  uint8_t buf[MAX_PACKET_SIZE];
+  ParsedPacket pkt;
+  ASSERT_TRUE(deserialize(buf, serializeShotBatch(buf, sizeof(buf), "TX0001", batch), pkt));
+  EXPECT_EQ(batchShot(pkt, 1).shotNumber, 4);
+  EXPECT_EQ(batchShot(pkt, 2).shotNumber, 259);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Batch acceptance
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShotBatchAdd, RejectsShotsThatCannotBeDeltaEncoded) {
+  ShotBatch batch;
+  ASSERT_TRUE(batch.add(makeShot(3, 2000, 300)));
+
+  EXPECT_FALSE(batch.add(makeShot(4, 2300, 300, 43)));               // Other session
+  EXPECT_FALSE(batch.add(makeShot(4, 2300, 300, 42, "Other")));      // Other model
+  EXPECT_FALSE(batch.add(makeShot(3, 2300, 300)));                   // Same shot number
+  EXPECT_FALSE(batch.add(makeShot(2, 2300, 300)));                   // Going back
+  EXPECT_FALSE(batch.add(makeShot(4, 1900, 100)));                   // Time going back
+  EXPECT_FALSE(batch.add(makeShot(4, 2300, 250)));                   // Split != time delta
+  NormalizedShotData restart = makeShot(4, 2300, 300);
+  restart.isFirstShot = true;
+  EXPECT_FALSE(batch.add(restart));                                  // New string
+  EXPECT_EQ(batch.count(), 1u);
+
+  EXPECT_TRUE(batch.add(makeShot(4, 2300, 300)));
+  EXPECT_EQ(batch.count(), 2u);
+}
+
+TEST(ShotBatchAdd, StopsAtMaxShots) {
+  ShotBatch batch;
+  std::vector<NormalizedShotData> string = makeString(MAX_BATCH_SHOTS + 1, 1500, 200);
+  for (size_t i = 0; i < MAX_BATCH_SHOTS; i++) ASSERT_TRUE(batch.add(string[i]));
+  EXPECT_TRUE(batch.full());
+  EXPECT_FALSE(batch.add(string[MAX_BATCH_SHOTS]));
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(batch.payloadSize(), 0u);
+  EXPECT_TRUE(batch.add(string[MAX_BATCH_SHOTS]));
+}
+
+TEST(ShotBatchAdd, EmptyBatchDoesNotSerialize) {
+  ShotBatch batch;
+  uint8_t buf[MAX_PACKET_SIZE];
+  EXPECT_EQ(serializeShotBatch(buf, sizeof(buf), "TX0001", batch), 0u);
+}
+
+TEST(ShotBatchAdd, BufferTooSmallDoesNotSerialize) {
+  ShotBatch batch;
+  ASSERT_TRUE(batch.add(makeShot(1, 1000, 1000)));
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t needed = HEADER_SIZE + batch.payloadSize() + CRC_SIZE;
+  EXPECT_EQ(serializeShotBatch(buf, needed - 1, "TX0001", batch), 0u);
+  EXPECT_EQ(serializeShotBatch(buf, needed, "TX0001", batch), needed);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Corrupt frames
+// ═════════════════════════════════════════════════════════════════
+
+// Re-seal a modified frame so only the payload check can reject it
+static size_t reseal(uint8_t* buf, size_t payloadLen) {
+  return appendCrc(buf, HEADER_SIZE + payloadLen);
+}
+
+TEST(ShotBatchCorrupt, BadCountOrModelLengthRejected) {
+  ShotBatch batch;
+  ASSERT_TRUE(batch.add(makeShot(1, 1000, 1000)));
+  ASSERT_TRUE(batch.add(makeShot(2, 1200, 200)));
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotBatch(buf, sizeof(buf), "TX0001", batch);
+  size_t payloadLen = len - HEADER_SIZE - CRC_SIZE;
+  ParsedPacket pkt;
+
+  uint8_t frame[MAX_PACKET_SIZE];
+  memcpy(frame, buf, len);
+  frame[HEADER_SIZE + 4] = BATCH_FIRST_SHOT_FLAG;  // Zero shots
+  EXPECT_FALSE(deserialize(frame, reseal(frame, payloadLen), pkt));
+
+  memcpy(frame, buf, len);
+  frame[HEADER_SIZE + 4] = (uint8_t)(MAX_BATCH_SHOTS + 1);
+  EXPECT_FALSE(deserialize(frame, reseal(frame, payloadLen), pkt));
+
+  memcpy(frame, buf, len);
+  frame[HEADER_SIZE + 4] = 3;  // Claims one more shot than is encoded
+  EXPECT_FALSE(deserialize(frame, reseal(frame, payloadLen), pkt));
+
+  memcpy(frame, buf, len);
+  frame[HEADER_SIZE + 5] = (uint8_t)(MODEL_LEN + 1);
+  EXPECT_FALSE(deserialize(frame, reseal(frame, payloadLen), pkt));
+}
+
+TEST(ShotBatchCorrupt, TruncatedVarintRejected) {
+  ShotBatch batch;
+  ASSERT_TRUE(batch.add(makeShot(1, 1000, 1000)));
+  ASSERT_TRUE(batch.add(makeShot(2, 1300, 300)));  // 300 needs two varint bytes
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotBatch(buf, sizeof(buf), "TX0001", batch);
+  size_t payloadLen = len - HEADER_SIZE - CRC_SIZE;
+
+  ParsedPacket pkt;
+  EXPECT_FALSE(deserialize(buf, reseal(buf, payloadLen - 1), pkt));
+}
+
+TEST(ShotBatchCorrupt, FlippedBitFailsCrc) {
+  std::vector<NormalizedShotData> string = makeString(6, 1500, 250);
+  ShotBatch batch;
+  for (const auto& shot : string) ASSERT_TRUE(batch.add(shot));
+  uint8_t buf[MAX_PACKET_SIZE];
+  size_t len = serializeShotBatch(buf, sizeof(buf), "TX0001", batch);
+
+  ParsedPacket pkt;
+  for (size_t i = 0; i < len; i++) {
+    buf[i] ^= 0x10;
+    EXPECT_FALSE(deserialize(buf, len, pkt)) << "byte " << i;
+    buf[i] ^= 0x10;
+  }
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Airtime
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShotBatchAirtime, TimeOnAirMatchesDatasheetExamples) {
+  // SF7 / 500 kHz: 256 us symbols. 42-byte SHOT_DETECTED:
+  // preamble 12.25 sym + 8 + ceil((336 - 28 + 28 + 16) / 28) * 5 = 73 sym
+  EXPECT_EQ(timeOnAirUs(42, 7, 500000, 5, 8), 3136u + 73u * 256u);
+  // SF12 / 125 kHz uses low data rate optimisation (32.768 ms symbols)
+  // preamble 12.25 sym + 8 + ceil((80 - 48 + 28 + 16) / 40) * 5 = 18 sym
+  EXPECT_EQ(timeOnAirUs(10, 12, 125000, 5, 8), 401408u + 18u * 32768u);
+}
+
+TEST(ShotBatchAirtime, TenShotStringUsesLessThanHalfTheAirtime) {
+  std::vector<NormalizedShotData> string = makeString(10, 1700, 220);
+  uint8_t buf[MAX_PACKET_SIZE];
+
+  uint32_t singleUs = 0;
+  for (const auto& shot : string) {
+    size_t len = serializeShotDetected(buf, sizeof(buf), "TX0001", shot);
+    singleUs += timeOnAirUs(len, SF, BW, CR, PREAMBLE);
+  }
+
+  // One batch per window, from one shot per batch up to the whole string
+  for (size_t perBatch = 1; perBatch <= string.size(); perBatch++) {
+    uint32_t batchedUs = 0;
+    for (size_t start = 0; start < string.size(); start += perBatch) {
+      ShotBatch batch;
+      for (size_t i = start; i < start + perBatch && i < string.size(); i++) {
+        ASSERT_TRUE(batch.add(string[i]));
+      }
+      size_t len = serializeShotBatch(buf, sizeof(buf), "TX0001", batch);
+      batchedUs += timeOnAirUs(len, SF, BW, CR, PREAMBLE);
+    }
+    printf("  %2zu shots/batch: %6.2f ms airtime per shot (SHOT_DETECTED: %6.2f ms)\n",
+           perBatch, batchedUs / 1000.0 / string.size(), singleUs / 1000.0 / string.size());
+    if (perBatch >= 2) {
+      EXPECT_LT(batchedUs * 2, singleUs) << perBatch << " shots per batch";
+    }
+  }
+}
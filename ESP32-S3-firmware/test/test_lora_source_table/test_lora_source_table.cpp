@@ -0,0 +1,292 @@
+/**
+ * @file test_lora_source_table.cpp
+ * @brief Native tests for the BLE-LoRa Bridge per-transmitter session table.
+ *
+ * Tests LoRaSourceTable: lookup by sourceId and by v2 source hash,
+ * renaming a placeholder, eviction when full (offline first), per-source shot
+ * de-duplication (window, restarts, late shots) and the offline timeout
+ * the receiver publishes as presence.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_lora_source_table
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "LoRaSourceTable.h"
+
+static NormalizedShotData makeShot(uint32_t sessionId, uint16_t shotNumber, bool isFirstShot = false) {
+  NormalizedShotData shot;
+  shot.sessionId = sessionId;
+  shot.shotNumber = shotNumber;
+  shot.absoluteTimeMs = shotNumber * 1000u;
+  shot.isFirstShot = isFirstShot;
+  return shot;
+}
+
+static std::string sourceName(int i) {
+  char id[8];
+  snprintf(id, sizeof(id), "BAY%03d", i);
+  return id;
+}
+
+typedef LoRaSourceTable<16> Table;
+
+// ═════════════════════════════════════════════════════════════════
+//  Lookup and eviction
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaSourceTable, TouchAddsOncePerSource) {
+  Table table;
+  EXPECT_EQ(table.find("A1B2C3"), nullptr);
+
+  LoRaSource& a = table.touch("A1B2C3", 100, -80);
+  table.touch("D4E5F6", 110, -95);
+  LoRaSource& again = table.touch("A1B2C3", 120, -82);
+
+  EXPECT_EQ(&a, &again);
+  EXPECT_EQ(table.size(), 2u);
+  EXPECT_STREQ(a.id, "A1B2C3");
+  EXPECT_EQ(a.packets, 2u);
+  EXPECT_EQ(a.lastRssi, -82);
+  EXPECT_EQ(a.lastHeardMs, 120u);
+  EXPECT_FALSE(a.online);  // The owner announces it
+}
+
+TEST(LoRaSourceTable, SixteenSourcesKeptApart) {
+  Table table;
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 16; i++) {
+      LoRaSource& source = table.touch(sourceName(i).c_str(), round * 100 + i, -60 - i);
+      EXPECT_TRUE(table.acceptShot(source, makeShot(7, (uint16_t)(round + 1))));
+    }
+  }
+  EXPECT_EQ(table.size(), 16u);
+  EXPECT_EQ(table.getEvictions(), 0u);
+  for (int i = 0; i < 16; i++) {
+    const LoRaSource* source = table.find(sourceName(i).c_str());
+    ASSERT_NE(source, nullptr);
+    EXPECT_EQ(source->shots, 3u);
+    EXPECT_EQ(source->lastShotNumber, 3u);
+    EXPECT_EQ(source->lastRssi, -60 - i);
+  }
+}
+
+TEST(LoRaSourceTable, FullTableEvictsLeastRecentlyHeard) {
+  Table table;
+  for (int i = 0; i < 16; i++) table.touch(sourceName(i).c_str(), 1000 + i, -70);
+  table.touch(sourceName(0).c_str(), 2000, -70);  // BAY001 is now the oldest
+
+  LoRaSource& newcomer = table.touch("NEW001", 3000, -90);
+  EXPECT_EQ(table.size(), 16u);
+  EXPECT_EQ(table.getEvictions(), 1u);
+  EXPECT_EQ(table.find(sourceName(1).c_str()), nullptr);
+  EXPECT_NE(table.find(sourceName(0).c_str()), nullptr);
+  EXPECT_EQ(newcomer.packets, 1u);  // Fresh entry
+  EXPECT_EQ(newcomer.shots, 0u);
+}
+
+TEST(LoRaSourceTable, FullTableEvictsOfflineBeforeOnline) {
+  Table table;
+  for (int i = 0; i < 16; i++) table.touch(sourceName(i).c_str(), 1000 + i, -70);
+  for (size_t i = 0; i < table.size(); i++) table.at(i).online = true;
+  table.at(5).online = false;  // BAY005, heard after BAY000..BAY004
+
+  std::vector<std::string> evicted;
+  auto collect = [&evicted](const LoRaSource& s) { evicted.push_back(s.id); };
+  table.touch("NEW001", 3000, -90, collect);
+  ASSERT_EQ(evicted.size(), 1u);
+  EXPECT_EQ(evicted[0], sourceName(5));
+  EXPECT_NE(table.find(sourceName(0).c_str()), nullptr);
+}
+
+TEST(LoRaSourceTable, EvictedOnlineSourceIsReported) {
+  Table table;
+  for (int i = 0; i < 16; i++) table.touch(sourceName(i).c_str(), 1000 + i, -70);
+  for (size_t i = 0; i < table.size(); i++) table.at(i).online = true;
+
+  std::vector<std::string> evicted;
+  bool wasOnline = false;
+  table.touch("NEW001", 3000, -90, [&](const LoRaSource& s) {
+    evicted.push_back(s.id);
+    wasOnline = s.online;
+  });
+  ASSERT_EQ(evicted.size(), 1u);
+  EXPECT_EQ(evicted[0], sourceName(0));  // Least recently heard
+  EXPECT_TRUE(wasOnline);                // The owner publishes it offline
+  EXPECT_EQ(table.onlineCount(), 15u);
+  EXPECT_EQ(table.getEvictions(), 1u);
+
+  // No callback while there is room or the source is known
+  table.touch("NEW001", 3100, -90, [&](const LoRaSource& s) { evicted.push_back(s.id); });
+  EXPECT_EQ(evicted.size(), 1u);
+}
+
+TEST(LoRaSourceTable, EvictionAgeSurvivesMillisWrap) {
+  LoRaSourceTable<2> table;
+  table.touch("OLD000", 0xFFFFFF00u, -70);
+  table.touch("NEW000", 0x00000100u, -70);  // Heard after the wrap
+  table.touch("THIRD0", 0x00000200u, -70);
+  EXPECT_EQ(table.find("OLD000"), nullptr);
+  EXPECT_NE(table.find("NEW000"), nullptr);
+}
+
+TEST(LoRaSourceTable, FindByHashSkipsPlaceholders) {
+  Table table;
+  LoRaSource& placeholder = table.touch("~1234", 100, -70);
+  placeholder.hash = 0x1234;
+  EXPECT_EQ(table.findByHash(0x1234), nullptr);  // Not named yet
+
+  LoRaSource& named = table.touch("A1B2C3", 110, -70);
+  named.hash = 0x1234;
+  EXPECT_EQ(table.findByHash(0x1234), &named);
+  EXPECT_EQ(table.findByHash(0x4321), nullptr);
+}
+
+TEST(LoRaSourceTable, RenameKeepsState) {
+  Table table;
+  LoRaSource& source = table.touch("~1234", 100, -70);
+  EXPECT_TRUE(table.acceptShot(source, makeShot(7, 1, true)));
+
+  EXPECT_TRUE(table.rename("~1234", "A1B2C3"));
+  EXPECT_EQ(table.find("~1234"), nullptr);
+  EXPECT_EQ(table.find("A1B2C3"), &source);
+  EXPECT_EQ(table.size(), 1u);
+  EXPECT_FALSE(table.acceptShot(source, makeShot(7, 1, true)));  // Still a duplicate
+}
+
+TEST(LoRaSourceTable, RenameNeedsFreeTargetAndExistingSource) {
+  Table table;
+  table.touch("~1234", 100, -70);
+  table.touch("A1B2C3", 110, -70);
+  EXPECT_FALSE(table.rename("~1234", "A1B2C3"));
+  EXPECT_FALSE(table.rename("~9999", "D4E5F6"));
+  EXPECT_NE(table.find("~1234"), nullptr);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Shot de-duplication
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaSourceTable, RepeatedShotIsDuplicate) {
+  Table table;
+  LoRaSource& source = table.touch("A1B2C3", 0, -80);
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 1, true)));
+  EXPECT_FALSE(table.acceptShot(source, makeShot(5, 1, true)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 2)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 3)));
+  EXPECT_FALSE(table.acceptShot(source, makeShot(5, 3)));
+  EXPECT_FALSE(table.acceptShot(source, makeShot(5, 2)));
+  EXPECT_EQ(source.shots, 3u);
+  EXPECT_EQ(source.duplicates, 3u);
+  EXPECT_EQ(source.lastShotNumber, 3u);
+}
+
+TEST(LoRaSourceTable, SameShotFromTwoSourcesIsNotDuplicate) {
+  Table table;
+  LoRaSource& a = table.touch("AAAAAA", 0, -80);
+  LoRaSource& b = table.touch("BBBBBB", 0, -80);
+  EXPECT_TRUE(table.acceptShot(a, makeShot(5, 1, true)));
+  EXPECT_TRUE(table.acceptShot(b, makeShot(5, 1, true)));
+}
+
+TEST(LoRaSourceTable, LateShotInsideWindowAcceptedOnce) {
+  Table table;
+  LoRaSource& source = table.touch("A1B2C3", 0, -80);
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 1, true)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 4)));  // 2 and 3 missing
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 3)));
+  EXPECT_FALSE(table.acceptShot(source, makeShot(5, 3)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 2)));
+  EXPECT_EQ(source.lastShotNumber, 4u);  // Late shots don't move the newest
+}
+
+TEST(LoRaSourceTable, ShotsOlderThanWindowRejected) {
+  Table table;
+  LoRaSource& source = table.touch("A1B2C3", 0, -80);
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 1, true)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 2 + Table::SHOT_WINDOW)));
+  EXPECT_FALSE(table.acceptShot(source, makeShot(5, 2)));  // Just outside
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 3)));   // Just inside
+}
+
+TEST(LoRaSourceTable, NewSessionStartsOver) {
+  Table table;
+  LoRaSource& source = table.touch("A1B2C3", 0, -80);
+  for (uint16_t n = 1; n <= 5; n++) EXPECT_TRUE(table.acceptShot(source, makeShot(5, n, n == 1)));
+
+  // Shot numbers repeat in the next session
+  EXPECT_TRUE(table.acceptShot(source, makeShot(6, 1, true)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(6, 2)));
+  EXPECT_EQ(source.sessionId, 6u);
+
+  // Same session id after SESSION_STARTED (Special Pie ids are one byte)
+  table.startSession(source, 6);
+  EXPECT_TRUE(table.acceptShot(source, makeShot(6, 1, true)));
+}
+
+TEST(LoRaSourceTable, FirstShotBelowNewestRestartsWithoutSessionStart) {
+  Table table;
+  LoRaSource& source = table.touch("A1B2C3", 0, -80);
+  for (uint16_t n = 1; n <= 5; n++) table.acceptShot(source, makeShot(5, n, n == 1));
+  // New string, its SESSION_STARTED lost
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 1, true)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 2)));
+  EXPECT_EQ(source.lastShotNumber, 2u);
+}
+
+TEST(LoRaSourceTable, ShotNumberWrapIsAhead) {
+  Table table;
+  LoRaSource& source = table.touch("A1B2C3", 0, -80);
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 65535)));
+  EXPECT_TRUE(table.acceptShot(source, makeShot(5, 0)));
+  EXPECT_FALSE(table.acceptShot(source, makeShot(5, 65535)));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Liveness
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaSourceTable, SilentSourceGoesOfflineOnce) {
+  Table table;
+  const uint32_t timeout = 90000;
+  LoRaSource& a = table.touch("AAAAAA", 1000, -80);
+  LoRaSource& b = table.touch("BBBBBB", 5000, -80);
+  a.online = true;
+  b.online = true;
+  EXPECT_EQ(table.msUntilExpiry(6000, timeout), 85000u);
+
+  std::vector<std::string> offline;
+  auto collect = [&offline](const LoRaSource& s) { offline.push_back(s.id); };
+
+  EXPECT_EQ(table.expire(1000 + timeout - 1, timeout, collect), 0u);
+  EXPECT_EQ(table.expire(1000 + timeout, timeout, collect), 1u);
+  EXPECT_EQ(table.expire(1000 + timeout + 1, timeout, collect), 0u);
+  ASSERT_EQ(offline.size(), 1u);
+  EXPECT_EQ(offline[0], "AAAAAA");
+  EXPECT_EQ(table.onlineCount(), 1u);
+  EXPECT_EQ(table.msUntilExpiry(1000 + timeout, timeout), 4000u);
+
+  // Heard again: the owner brings it back online
+  table.touch("AAAAAA", 200000, -80);
+  EXPECT_FALSE(a.online);
+}
+
+TEST(LoRaSourceTable, NoExpiryWithoutOnlineSources) {
+  Table table;
+  table.touch("AAAAAA", 0, -80);
+  EXPECT_EQ(table.msUntilExpiry(1000, 90000), UINT32_MAX);
+}
+
+TEST(LoRaSourceTable, HeartbeatRecordsUptime) {
+  Table table;
+  LoRaSource& source = table.touch("AAAAAA", 4000, -80);
+  EXPECT_EQ(source.lastHeartbeatMs, 0u);
+  table.recordHeartbeat(source, 4000, 123456);
+  EXPECT_EQ(source.lastHeartbeatMs, 4000u);
+  EXPECT_EQ(source.uptimeMs, 123456u);
+}
@@ -0,0 +1,221 @@
+/**
+ * @file test_lora_tx_queue.cpp
+ * @brief Native tests for the BLE-LoRa Bridge transmit queue and duty-cycle budget.
+ *
+ * Tests LoRaTxQueue (queue order, heartbeat last, per-level drops) and
+ * AirtimeBudget (sliding-window accounting and the wait until a packet
+ * fits) - the two header-only pieces LoRaTransmitter schedules with.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_lora_tx_queue
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "AirtimeBudget.h"
+#include "LoRaTxQueue.h"
+
+static TxPacket makePacket(uint8_t tag, uint32_t airtimeUs = 20000) {
+  TxPacket packet;
+  packet.length = 1;
+  packet.data[0] = tag;
+  packet.airtimeUs = airtimeUs;
+  packet.traceCount = 0;
+  return packet;
+}
+
+// EU868 g1: 1 % of an hour
+static constexpr uint32_t HOUR_MS = 3600000;
+static constexpr uint32_t MINUTE_MS = 60000;
+static constexpr uint32_t BUDGET_US = 36000000;
+
+// ═════════════════════════════════════════════════════════════════
+//  LoRaTxQueue
+// ═════════════════════════════════════════════════════════════════
+
+TEST(LoRaTxQueue, EmptyQueue) {
+  LoRaTxQueue<4> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.front(), nullptr);
+  queue.pop();  // No-op
+  queue.dropFront();
+  EXPECT_EQ(queue.getDrops(), 0u);
+}
+
+TEST(LoRaTxQueue, HeartbeatWaitsForShotsAndSessionEvents) {
+  LoRaTxQueue<4> queue;
+  ASSERT_TRUE(queue.push(TxPriority::HEARTBEAT, makePacket(3)));
+  ASSERT_TRUE(queue.push(TxPriority::SESSION, makePacket(1)));
+  ASSERT_TRUE(queue.push(TxPriority::SHOT, makePacket(2)));
+  EXPECT_EQ(queue.size(), 3u);
+
+  uint8_t order[3];
+  for (int i = 0; i < 3; i++) {
+    ASSERT_NE(queue.front(), nullptr);
+    order[i] = queue.front()->data[0];
+    queue.pop();
+  }
+  EXPECT_EQ(order[0], 1);
+  EXPECT_EQ(order[1], 2);
+  EXPECT_EQ(order[2], 3);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(LoRaTxQueue, FifoWithinLevelAcrossWrap) {
+  LoRaTxQueue<3> queue;
+  uint8_t next = 0;
+  uint8_t expected = 0;
+  for (int round = 0; round < 10; round++) {
+    while (queue.size(TxPriority::SHOT) < 3) {
+      ASSERT_TRUE(queue.push(TxPriority::SHOT, makePacket(next++)));
+    }
+    queue.pop();
+    queue.pop();
+    expected += 2;
+    EXPECT_EQ(queue.front()->data[0], expected);
+  }
+}
+
+TEST(LoRaTxQueue, FullLevelDropsNewestOnly) {
+  LoRaTxQueue<2> queue;
+  ASSERT_TRUE(queue.push(TxPriority::SESSION, makePacket(1)));
+  ASSERT_TRUE(queue.push(TxPriority::SESSION, makePacket(2)));
+  EXPECT_FALSE(queue.push(TxPriority::SESSION, makePacket(3)));
+  EXPECT_EQ(queue.getDrops(), 1u);
+
+  // Other levels are unaffected
+  EXPECT_TRUE(queue.push(TxPriority::SHOT, makePacket(4)));
+  EXPECT_EQ(queue.size(), 3u);
+
+  EXPECT_EQ(queue.front()->data[0], 1);
+  queue.pop();
+  EXPECT_EQ(queue.front()->data[0], 2);
+  queue.pop();
+  EXPECT_EQ(queue.front()->data[0], 4);
+}
+
+TEST(LoRaTxQueue, DropFrontCounts) {
+  LoRaTxQueue<2> queue;
+  ASSERT_TRUE(queue.push(TxPriority::HEARTBEAT, makePacket(1)));
+  ASSERT_TRUE(queue.push(TxPriority::SESSION, makePacket(2)));
+  queue.dropFront();
+  EXPECT_EQ(queue.getDrops(), 1u);
+  EXPECT_EQ(queue.front()->data[0], 1);
+}
+
+TEST(LoRaTxQueue, ShotArrivingDuringBacklogJumpsAheadOfHeartbeat) {
+  LoRaTxQueue<4> queue;
+  ASSERT_TRUE(queue.push(TxPriority::HEARTBEAT, makePacket(9)));
+  ASSERT_TRUE(queue.push(TxPriority::SESSION, makePacket(5)));
+  queue.pop();  // Session event goes on air
+  ASSERT_TRUE(queue.push(TxPriority::SHOT, makePacket(1)));
+  EXPECT_EQ(queue.front()->data[0], 1);
+}
+
+TEST(LoRaTxQueue, SessionStartedIsNotOvertakenByItsShots) {
+  LoRaTxQueue<4> queue;
+  ASSERT_TRUE(queue.push(TxPriority::SHOT, makePacket(1)));     // Last shot of the old session
+  ASSERT_TRUE(queue.push(TxPriority::SESSION, makePacket(2)));  // SESSION_STARTED
+  ASSERT_TRUE(queue.push(TxPriority::SHOT, makePacket(3)));
+  ASSERT_TRUE(queue.push(TxPriority::SHOT, makePacket(4)));
+  ASSERT_TRUE(queue.push(TxPriority::SESSION, makePacket(5)));  // SESSION_STOPPED
+
+  for (uint8_t expected = 1; expected <= 5; expected++) {
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(queue.front()->data[0], expected);
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  AirtimeBudget
+// ═════════════════════════════════════════════════════════════════
+
+TEST(AirtimeBudget, FreshBudgetAllowsUpToLimit) {
+  AirtimeBudget budget(HOUR_MS, BUDGET_US);
+  EXPECT_EQ(budget.usedUs(0), 0u);
+  EXPECT_TRUE(budget.canSend(0, BUDGET_US));
+  EXPECT_FALSE(budget.canSend(0, BUDGET_US + 1));
+  EXPECT_EQ(budget.msUntilAvailable(0, BUDGET_US + 1), AirtimeBudget::NEVER);
+}
+
+TEST(AirtimeBudget, RecordsAccumulateWithinWindow) {
+  AirtimeBudget budget(HOUR_MS, BUDGET_US);
+  uint32_t now = 5 * MINUTE_MS;
+  for (int i = 0; i < 100; i++) {
+    budget.record(now + i * 1000, 20000);
+  }
+  EXPECT_EQ(budget.usedUs(now + 100 * 1000), 2000000u);
+  EXPECT_TRUE(budget.canSend(now + 100 * 1000, BUDGET_US - 2000000));
+  EXPECT_FALSE(budget.canSend(now + 100 * 1000, BUDGET_US - 2000000 + 1));
+}
+
+TEST(AirtimeBudget, AirtimeLeavesAfterTheWindow) {
+  AirtimeBudget budget(HOUR_MS, BUDGET_US);
+  uint32_t t0 = 10 * MINUTE_MS + 30000;  // Mid-slot
+  budget.record(t0, 1000000);
+
+  // Counted for at least a full window, at most one slot longer
+  EXPECT_EQ(budget.usedUs(t0 + HOUR_MS - 1), 1000000u);
+  EXPECT_EQ(budget.usedUs(t0 + HOUR_MS + MINUTE_MS), 0u);
+}
+
+TEST(AirtimeBudget, ExhaustedBudgetWaitsForOldestSlot) {
+  AirtimeBudget budget(HOUR_MS, BUDGET_US);
+  // 20 s in minute 0, 16 s in minute 30: budget full
+  budget.record(0, 20000000);
+  budget.record(30 * MINUTE_MS, 16000000);
+  uint32_t now = 45 * MINUTE_MS;
+  EXPECT_FALSE(budget.canSend(now, 20000));
+
+  uint32_t wait = budget.msUntilAvailable(now, 20000);
+  // Minute 0 expires when slot 61 begins
+  EXPECT_EQ(wait, 61 * MINUTE_MS - now);
+  EXPECT_FALSE(budget.canSend(now + wait - 1, 20000));
+  EXPECT_TRUE(budget.canSend(now + wait, 20000));
+}
+
+TEST(AirtimeBudget, WaitSkipsSlotsThatDoNotFreeEnough) {
+  AirtimeBudget budget(HOUR_MS, BUDGET_US);
+  budget.record(0, 1000000);                   // 1 s
+  budget.record(10 * MINUTE_MS, 35000000);     // 35 s
+  uint32_t now = 20 * MINUTE_MS;
+
+  // 2 s needs the 35 s slot gone, not just the 1 s one
+  uint32_t wait = budget.msUntilAvailable(now, 2000000);
+  EXPECT_EQ(wait, 71 * MINUTE_MS - now);
+  EXPECT_TRUE(budget.canSend(now + wait, 2000000));
+
+  // 0.5 s only needs the 1 s slot gone
+  EXPECT_EQ(budget.msUntilAvailable(now, 500000), 61 * MINUTE_MS - now);
+}
+
+TEST(AirtimeBudget, SustainedShotTrafficStaysUnderOnePercent) {
+  // A shot batch every 2 s for two hours, checked against a true sliding hour
+  AirtimeBudget budget(HOUR_MS, BUDGET_US);
+  const uint32_t airtime = 25000;
+  std::vector<std::pair<uint32_t, uint32_t>> sent;
+  uint32_t skipped = 0;
+  for (uint32_t t = 0; t < 2 * HOUR_MS; t += 2000) {
+    if (budget.canSend(t, airtime)) {
+      budget.record(t, airtime);
+      sent.push_back(std::make_pair(t, airtime));
+    } else {
+      skipped++;
+    }
+  }
+  // 1.25 % offered load, so some packets must wait
+  EXPECT_GT(skipped, 0u);
+
+  for (size_t i = 0; i < sent.size(); i++) {
+    uint64_t inWindow = 0;
+    for (size_t j = i; j < sent.size() && sent[j].first < sent[i].first + HOUR_MS; j++) {
+      inWindow += sent[j].second;
+    }
+    ASSERT_LE(inWindow, BUDGET_US) << "window starting at " << sent[i].first;
+  }
+}
@@ -0,0 +1,357 @@
+/**
+ * @file test_mqtt_binary_payload.cpp
+ * @brief Native tests for the MessagePack MQTT payload encoding.
+ *
+ * Tests MsgPackWriter (header-only) against the MessagePack spec byte
+ * forms, and MqttBinaryPayload by decoding every event payload with the
+ * reference decoder below - the same thing a subscriber has to do when
+ * MQTT_PAYLOAD_FORMAT selects the binary encoding.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_mqtt_binary_payload
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../../src/MqttBinaryPayload.cpp"
+
+using namespace MqttBinaryPayload;
+
+// ─── Reference MessagePack decoder ───────────────────────────────
+
+struct MsgValue {
+  enum Type { NIL, BOOL, UINT, FLOAT, STR, ARRAY, MAP } type = NIL;
+  bool b = false;
+  uint64_t u = 0;
+  float f = 0.0f;
+  std::string s;
+  std::vector<MsgValue> items;                        // ARRAY
+  std::vector<std::pair<MsgValue, MsgValue>> entries; // MAP
+
+  // Map lookup by integer key; nullptr if absent
+  const MsgValue* get(uint64_t key) const {
+    for (const auto& e : entries) {
+      if (e.first.type == UINT && e.first.u == key) return &e.second;
+    }
+    return nullptr;
+  }
+  const MsgValue* get(const std::string& key) const {
+    for (const auto& e : entries) {
+      if (e.first.type == STR && e.first.s == key) return &e.second;
+    }
+    return nullptr;
+  }
+};
+
+static uint64_t readBE(const uint8_t*& p, int n) {
+  uint64_t v = 0;
+  for (int i = 0; i < n; i++) v = (v << 8) | *p++;
+  return v;
+}
+
+static bool decode(const uint8_t*& p, const uint8_t* end, MsgValue& out) {
+  if (p >= end) return false;
+  uint8_t t = *p++;
+  auto need = [&](size_t n) { return (size_t)(end - p) >= n; };
+
+  if (t < 0x80) { out.type = MsgValue::UINT; out.u = t; return true; }
+  if (t == 0xc0) { out.type = MsgValue::NIL; return true; }
+  if (t == 0xc2 || t == 0xc3) { out.type = MsgValue::BOOL; out.b = t == 0xc3; return true; }
+  if (t >= 0xcc && t <= 0xce) {
+    int n = 1 << (t - 0xcc);
+    if (!need(n)) return false;
+    out.type = MsgValue::UINT;
+    out.u = readBE(p, n);
+    return true;
+  }
+  if (t == 0xca) {
+    if (!need(4)) return false;
+    uint32_t bits = (uint32_t)readBE(p, 4);
+    out.type = MsgValue::FLOAT;
+    memcpy(&out.f, &bits, 4);
+    return true;
+  }
+
+  size_t len;
+  if ((t & 0xe0) == 0xa0 || t == 0xd9) {
+    if (t == 0xd9) { if (!need(1)) return false; len = *p++; } else { len = t & 0x1f; }
+    if (!need(len)) return false;
+    out.type = MsgValue::STR;
+    out.s.assign(reinterpret_cast<const char*>(p), len);
+    p += len;
+    return true;
+  }
+  if ((t & 0xf0) == 0x90 || t == 0xdc) {
+    if (t == 0xdc) { if (!need(2)) return false; len = (size_t)readBE(p, 2); } else { len = t & 0x0f; }
+    out.type = MsgValue::ARRAY;
+    out.items.resize(len);
+    for (auto& item : out.items) {
+      if (!decode(p, end, item)) return false;
+    }
+    return true;
+  }
+  if ((t & 0xf0) == 0x80 || t == 0xde) {
+    if (t == 0xde) { if (!need(2)) return false; len = (size_t)readBE(p, 2); } else { len = t & 0x0f; }
+    out.type = MsgValue::MAP;
+    out.entries.resize(len);
+    for (auto& e : out.entries) {
+      if (!decode(p, end, e.first) || !decode(p, end, e.second)) return false;
+    }
+    return true;
+  }
+  return false;  // Type the firmware never emits
+}
+
+// Check the version byte, decode the map, and require it to span the payload
+static bool decodePayload(const MsgPackWriter& w, MsgValue& out) {
+  const uint8_t* p = w.data();
+  const uint8_t* end = p + w.size();
+  if (!w.ok() || p == end || *p++ != SCHEMA_VERSION) return false;
+  return decode(p, end, out) && p == end && out.type == MsgValue::MAP;
+}
+
+static std::vector<uint8_t> bytes(const MsgPackWriter& w) {
+  return std::vector<uint8_t>(w.data(), w.data() + w.size());
+}
+
+static NormalizedShotData makeShot() {
+  NormalizedShotData shot;
+  shot.sessionId = 1698012345;
+  shot.shotNumber = 3;
+  shot.absoluteTimeMs = 4820;
+  shot.splitTimeMs = 1234;
+  shot.timestampMs = 51234;
+  shot.isFirstShot = false;
+  strncpy(shot.deviceModel, "SGTimer Sport", sizeof(shot.deviceModel) - 1);
+  return shot;
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Writer byte forms
+// ═════════════════════════════════════════════════════════════════
+
+TEST(MsgPackWriterForms, UnsignedIntegersUseSmallestForm) {
+  uint8_t buf[32];
+  MsgPackWriter w(buf, sizeof(buf));
+  w.uint(0x7f);
+  w.uint(0x80);
+  w.uint(0x1234);
+  w.uint(0x12345678);
+
+  std::vector<uint8_t> expected = { 0x7f, 0xcc, 0x80, 0xcd, 0x12, 0x34, 0xce, 0x12, 0x34, 0x56, 0x78 };
+  EXPECT_EQ(bytes(w), expected);
+}
+
+TEST(MsgPackWriterForms, StringsUseFixstrThenStr8) {
+  uint8_t buf[64];
+  MsgPackWriter w(buf, sizeof(buf));
+  w.str("abc");
+  EXPECT_EQ(buf[0], 0xa3);
+
+  std::string longText(40, 'x');
+  MsgPackWriter w2(buf, sizeof(buf));
+  w2.str(longText.c_str());
+  EXPECT_EQ(buf[0], 0xd9);
+  EXPECT_EQ(buf[1], 40);
+  EXPECT_EQ(w2.size(), 42u);
+}
+
+TEST(MsgPackWriterForms, ScalarsAndContainers) {
+  uint8_t buf[32];
+  MsgPackWriter w(buf, sizeof(buf));
+  w.nil();
+  w.boolean(true);
+  w.boolean(false);
+  w.float32(1.5f);
+  w.array(2);
+  w.map(20);
+
+  std::vector<uint8_t> expected = { 0xc0, 0xc3, 0xc2, 0xca, 0x3f, 0xc0, 0x00, 0x00, 0x92, 0xde, 0x00, 0x14 };
+  EXPECT_EQ(bytes(w), expected);
+}
+
+TEST(MsgPackWriterForms, Array16PlaceholderIsPatched) {
+  uint8_t buf[8];
+  MsgPackWriter w(buf, sizeof(buf));
+  size_t at = w.array16();
+  w.patchArray16(at, 0x0102);
+
+  std::vector<uint8_t> expected = { 0xdc, 0x01, 0x02 };
+  EXPECT_EQ(bytes(w), expected);
+}
+
+TEST(MsgPackWriterForms, OverflowIsStickyAndWritesNothingPastCapacity) {
+  uint8_t buf[4] = { 0, 0, 0, 0xee };
+  MsgPackWriter w(buf, 3);
+  w.uint(1);
+  w.uint(0x1234);   // Needs 3 bytes, only 2 left
+  w.uint(2);        // Would fit, but the writer already failed
+
+  EXPECT_FALSE(w.ok());
+  EXPECT_EQ(w.size(), 1u);
+  EXPECT_EQ(buf[3], 0xee);
+}
+
+TEST(MsgPackWriterForms, ResumesAfterExistingContent) {
+  uint8_t buf[8] = { 0x91 };
+  MsgPackWriter w(buf, sizeof(buf), 1);
+  w.uint(5);
+
+  std::vector<uint8_t> expected = { 0x91, 0x05 };
+  EXPECT_EQ(bytes(w), expected);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Event payloads
+// ═════════════════════════════════════════════════════════════════
+
+TEST(MqttBinaryPayloadEvents, ShotRoundTrips) {
+  uint8_t buf[128];
+  MsgPackWriter w(buf, sizeof(buf));
+  encodeShot(w, makeShot(), 3, 51234);
+
+  MsgValue m;
+  ASSERT_TRUE(decodePayload(w, m));
+  EXPECT_EQ(m.get(Key::SESSION_ID)->u, 1698012345u);
+  EXPECT_EQ(m.get(Key::SHOT_NUMBER)->u, 3u);
+  EXPECT_EQ(m.get(Key::ABSOLUTE_TIME_MS)->u, 4820u);
+  EXPECT_EQ(m.get(Key::SPLIT_TIME_MS)->u, 1234u);
+  EXPECT_EQ(m.get(Key::DEVICE_MODEL)->s, "SGTimer Sport");
+  EXPECT_FALSE(m.get(Key::IS_FIRST_SHOT)->b);
+  EXPECT_EQ(m.get(Key::TIMESTAMP)->u, 51234u);
+  EXPECT_EQ(m.get(Key::SEQ)->u, 3u);
+}
+
+TEST(MqttBinaryPayloadEvents, ShotWithoutSeqOmitsTheField) {
+  uint8_t buf[128];
+  MsgPackWriter w(buf, sizeof(buf));
+  encodeShot(w, makeShot(), 0, 51234);
+
+  MsgValue m;
+  ASSERT_TRUE(decodePayload(w, m));
+  EXPECT_EQ(m.get(Key::SEQ), nullptr);
+  EXPECT_EQ(m.entries.size(), 7u);
+}
+
+TEST(MqttBinaryPayloadEvents, ShotIsSeveralTimesSmallerThanJson) {
+  NormalizedShotData shot = makeShot();
+  uint8_t buf[128];
+  MsgPackWriter w(buf, sizeof(buf));
+  encodeShot(w, shot, 3, 51234);
+
+  // Same fields as MqttManager's JSON shot payload
+  char json[256];
+  int jsonLen = snprintf(json, sizeof(json),
+    "{\"sessionId\":%u,\"shotNumber\":%u,\"absoluteTimeMs\":%u,\"splitTimeMs\":%u,\"deviceModel\":\"%s\",\"isFirstShot\":false,\"timestamp\":%u,\"seq\":%u}",
+    shot.sessionId, shot.shotNumber, shot.absoluteTimeMs, shot.splitTimeMs, shot.deviceModel, 51234u, 3u);
+
+  EXPECT_LE(w.size(), 48u);
+  EXPECT_GE((size_t)jsonLen, w.size() * 3);
+}
+
+TEST(MqttBinaryPayloadEvents, ConnectionStateOmitsMissingStrings) {
+  uint8_t buf[128];
+  MsgPackWriter w(buf, sizeof(buf));
+  encodeConnectionState(w, "scanning", nullptr, nullptr, 1000);
+
+  MsgValue m;
+  ASSERT_TRUE(decodePayload(w, m));
+  EXPECT_EQ(m.get(Key::STATE)->s, "scanning");
+  EXPECT_EQ(m.get(Key::DEVICE_NAME), nullptr);
+  EXPECT_EQ(m.get(Key::DEVICE_MODEL), nullptr);
+  EXPECT_EQ(m.get(Key::TIMESTAMP)->u, 1000u);
+}
+
+TEST(MqttBinaryPayloadEvents, DeviceInfoCarriesDeviceId) {
+  uint8_t buf[128];
+  MsgPackWriter w(buf, sizeof(buf));
+  encodeDeviceInfo(w, "SG-SST4AB", "SGTimer Sport", "1.2.0", "A1B2C3", 2000);
+
+  MsgValue m;
+  ASSERT_TRUE(decodePayload(w, m));
+  EXPECT_EQ(m.get(Key::DEVICE_NAME)->s, "SG-SST4AB");
+  EXPECT_EQ(m.get(Key::FIRMWARE_VERSION)->s, "1.2.0");
+  EXPECT_EQ(m.get(Key::DEVICE_ID)->s, "A1B2C3");
+}
+
+TEST(MqttBinaryPayloadEvents, SessionEvents) {
+  uint8_t buf[64];
+  MsgValue m;
+
+  MsgPackWriter started(buf, sizeof(buf));
+  encodeSessionStarted(started, 42, 3.0f, 10);
+  ASSERT_TRUE(decodePayload(started, m));
+  EXPECT_EQ(m.get(Key::SESSION_ID)->u, 42u);
+  EXPECT_FLOAT_EQ(m.get(Key::START_DELAY_SECONDS)->f, 3.0f);
+
+  MsgPackWriter stopped(buf, sizeof(buf));
+  encodeSessionStopped(stopped, 42, 12, 0, 20);
+  ASSERT_TRUE(decodePayload(stopped, m = MsgValue()));
+  EXPECT_EQ(m.get(Key::TOTAL_SHOTS)->u, 12u);
+  EXPECT_EQ(m.get(Key::LAST_SHOT_TIME_MS), nullptr);
+
+  MsgPackWriter resumed(buf, sizeof(buf));
+  encodeSessionEvent(resumed, 42, 30);
+  ASSERT_TRUE(decodePayload(resumed, m = MsgValue()));
+  EXPECT_EQ(m.entries.size(), 2u);
+  EXPECT_EQ(m.get(Key::TIMESTAMP)->u, 30u);
+}
+
+TEST(MqttBinaryPayloadEvents, ShotBatchRoundTrips) {
+  uint8_t buf[256];
+  MsgPackWriter w(buf, sizeof(buf));
+  size_t countAt = beginShotBatch(w, 42, "SGTimer Sport");
+
+  NormalizedShotData shot = makeShot();
+  for (uint16_t i = 1; i <= 3; i++) {
+    shot.shotNumber = i;
+    shot.isFirstShot = i == 1;
+    addShotBatchRecord(w, shot, i, 50000 + i);
+  }
+  finishShotBatch(w, countAt, 3);
+
+  MsgValue m;
+  ASSERT_TRUE(decodePayload(w, m));
+  const MsgValue* shots = m.get(Key::SHOTS);
+  ASSERT_NE(shots, nullptr);
+  ASSERT_EQ(shots->items.size(), 3u);
+  const MsgValue& first = shots->items[0];
+  ASSERT_EQ(first.items.size(), 6u);
+  EXPECT_EQ(first.items[0].u, 1u);       // seq
+  EXPECT_EQ(first.items[1].u, 1u);       // shotNumber
+  EXPECT_EQ(first.items[2].u, 4820u);    // absoluteTimeMs
+  EXPECT_EQ(first.items[4].u, 50001u);   // timestamp
+  EXPECT_EQ(first.items[5].u, 1u);       // isFirstShot
+  EXPECT_EQ(shots->items[2].items[5].u, 0u);
+}
+
+TEST(MqttBinaryPayloadEvents, LatencyStagesByName) {
+  uint8_t buf[128];
+  MsgPackWriter w(buf, sizeof(buf));
+  beginLatency(w, 2);
+  addLatencyStage(w, "parsed", 24, 41, 58, 79, 83);
+  addLatencyStage(w, "mqtt", 24, 612, 1450, 4095, 4410);
+  finishLatency(w, 183220);
+
+  MsgValue m;
+  ASSERT_TRUE(decodePayload(w, m));
+  const MsgValue* stages = m.get(Key::STAGES);
+  ASSERT_NE(stages, nullptr);
+  const MsgValue* mqtt = stages->get(std::string("mqtt"));
+  ASSERT_NE(mqtt, nullptr);
+  EXPECT_EQ(mqtt->items[3].u, 4095u);
+  EXPECT_EQ(m.get(Key::TIMESTAMP)->u, 183220u);
+}
+
+TEST(MqttBinaryPayloadEvents, FirstByteDistinguishesFromJson) {
+  uint8_t buf[64];
+  MsgPackWriter w(buf, sizeof(buf));
+  encodeSessionEvent(w, 1, 1);
+
+  EXPECT_EQ(buf[0], SCHEMA_VERSION);
+  EXPECT_NE(buf[0], '{');
+}
@@ -0,0 +1,354 @@
+/**
+ * @file test_mqtt_json_payload.cpp
+ * @brief Native tests and benchmark for the allocation-free JSON MQTT payloads.
+ *
+ * Tests JsonWriter (header-only) formatting and escaping, MqttJsonPayload
+ * against the documented payload strings, and that encoding never touches
+ * the heap. When ArduinoJson is available (the native-tests env pulls it
+ * in), the benchmark also runs the JsonDocument code these encoders
+ * replaced and checks the output is byte-for-byte identical.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_mqtt_json_payload
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "../../src/MqttJsonPayload.cpp"
+
+#if __has_include(<ArduinoJson.h>)
+#include <ArduinoJson.h>
+#define HAVE_ARDUINOJSON 1
+#else
+#define HAVE_ARDUINOJSON 0
+#endif
+
+using namespace MqttJsonPayload;
+
+// ─── Heap accounting ─────────────────────────────────────────────
+// Counts every operator new in the test binary; ArduinoJson allocates
+// through malloc, so its documents are counted by CountingAllocator.
+
+static size_t heapAllocations = 0;
+
+void* operator new(size_t size) {
+  heapAllocations++;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+static std::string encoded(const JsonWriter& w) {
+  return std::string(w.c_str(), w.size());
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Writer formatting
+// ═════════════════════════════════════════════════════════════════
+
+TEST(JsonWriterFormat, UnsignedIntegers) {
+  char buf[64];
+  JsonWriter w(buf, sizeof(buf));
+  w.object(jsonField("a", (uint16_t)0), jsonField("b", (uint32_t)4294967295u),
+           jsonField("c", 18446744073709551615ull));
+  EXPECT_EQ(encoded(w), "{\"a\":0,\"b\":4294967295,\"c\":18446744073709551615}");
+}
+
+TEST(JsonWriterFormat, FloatsUseUpToThreeDecimals) {
+  char buf[96];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginArray();
+  w.value(3.0f);
+  w.value(2.5f);
+  w.value(0.125f);
+  w.value(1.0004f);  // Rounds to whole milliseconds
+  w.value(-0.75f);
+  w.value(0.0f / 0.0f);
+  w.value(1e10f);
+  w.endArray();
+  EXPECT_EQ(encoded(w), "[3,2.5,0.125,1,-0.75,null,null]");
+}
+
+TEST(JsonWriterFormat, BooleansAndNull) {
+  char buf[32];
+  JsonWriter w(buf, sizeof(buf));
+  w.object(jsonField("t", true), jsonField("f", false), jsonField("n", (const char*)nullptr));
+  EXPECT_EQ(encoded(w), "{\"t\":true,\"f\":false,\"n\":null}");
+}
+
+TEST(JsonWriterFormat, StringsAreEscaped) {
+  char buf[96];
+  JsonWriter w(buf, sizeof(buf));
+  w.object(jsonField("s", "say \"hi\"\\ \n\t\x01 done"));
+  EXPECT_EQ(encoded(w), "{\"s\":\"say \\\"hi\\\"\\\\ \\n\\t\\u0001 done\"}");
+}
+
+TEST(JsonWriterFormat, AbsentFieldsLeaveNoComma) {
+  char buf[64];
+  JsonWriter w(buf, sizeof(buf));
+  w.object(jsonFieldIfSet("a", nullptr), jsonField("b", 1u), jsonFieldIf(false, "c", 2u),
+           jsonFieldIfSet("d", nullptr));
+  EXPECT_EQ(encoded(w), "{\"b\":1}");
+}
+
+TEST(JsonWriterFormat, NestedObjectsAndDynamicKeys) {
+  char buf[64];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginObject();
+  w.key("outer");
+  w.beginObject();
+  w.dynamicKey("x\"y");
+  w.object(jsonField("n", 1u));
+  w.dynamicKey("z");
+  w.beginArray();
+  w.endArray();
+  w.endObject();
+  w.fields(jsonField("last", 2u));
+  w.endObject();
+  EXPECT_EQ(encoded(w), "{\"outer\":{\"x\\\"y\":{\"n\":1},\"z\":[]},\"last\":2}");
+}
+
+TEST(JsonWriterFormat, OverflowIsStickyAndStaysTerminated) {
+  char buf[8];
+  memset(buf, 'x', sizeof(buf));
+  JsonWriter w(buf, sizeof(buf));
+  w.object(jsonField("sessionId", 1u));
+
+  EXPECT_FALSE(w.ok());
+  EXPECT_LT(w.size(), sizeof(buf));
+  EXPECT_EQ(buf[w.size()], '\0');
+
+  w.value(1u);
+  EXPECT_FALSE(w.ok());
+}
+
+TEST(JsonWriterFormat, ExactFitLeavesRoomForTerminator) {
+  const char expected[] = "{\"a\":1}";
+  char buf[sizeof(expected)];
+  JsonWriter w(buf, sizeof(buf));
+  w.object(jsonField("a", 1u));
+  ASSERT_TRUE(w.ok());
+  EXPECT_STREQ(buf, expected);
+
+  char small[sizeof(expected) - 1];
+  JsonWriter tight(small, sizeof(small));
+  tight.object(jsonField("a", 1u));
+  EXPECT_FALSE(tight.ok());
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Event payloads
+// ═════════════════════════════════════════════════════════════════
+
+TEST(MqttJsonPayloadEvents, ConnectionState) {
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf));
+  encodeConnectionState(w, "CONNECTED", "SG-SST4XXXXX", "SG Timer", 12345);
+  EXPECT_EQ(encoded(w),
+            "{\"state\":\"CONNECTED\",\"deviceName\":\"SG-SST4XXXXX\","
+            "\"deviceModel\":\"SG Timer\",\"timestamp\":12345}");
+
+  JsonWriter bare(buf, sizeof(buf));
+  encodeConnectionState(bare, "SCANNING", nullptr, nullptr, 7);
+  EXPECT_EQ(encoded(bare), "{\"state\":\"SCANNING\",\"timestamp\":7}");
+}
+
+TEST(MqttJsonPayloadEvents, DeviceInfo) {
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf));
+  encodeDeviceInfo(w, "SG-SST4XXXXX", "SG Timer", "1.2.3", "a1b2c3d4", 99);
+  EXPECT_EQ(encoded(w),
+            "{\"deviceName\":\"SG-SST4XXXXX\",\"deviceModel\":\"SG Timer\","
+            "\"firmwareVersion\":\"1.2.3\",\"deviceId\":\"a1b2c3d4\",\"timestamp\":99}");
+
+  JsonWriter noFirmware(buf, sizeof(buf));
+  encodeDeviceInfo(noFirmware, "SG-SST4XXXXX", "SG Timer", nullptr, "a1b2c3d4", 99);
+  EXPECT_EQ(encoded(noFirmware).find("firmwareVersion"), std::string::npos);
+}
+
+TEST(MqttJsonPayloadEvents, SessionStartedAndStopped) {
+  char buf[256];
+  JsonWriter started(buf, sizeof(buf));
+  encodeSessionStarted(started, 1234567890, 3.0f, 42);
+  EXPECT_EQ(encoded(started), "{\"sessionId\":1234567890,\"startDelaySeconds\":3,\"timestamp\":42}");
+
+  JsonWriter stopped(buf, sizeof(buf));
+  encodeSessionStopped(stopped, 1234567890, 5, 4500, 43);
+  EXPECT_EQ(encoded(stopped),
+            "{\"sessionId\":1234567890,\"totalShots\":5,\"lastShotTimeMs\":4500,\"timestamp\":43}");
+
+  JsonWriter empty(buf, sizeof(buf));
+  encodeSessionStopped(empty, 1234567890, 0, 0, 44);
+  EXPECT_EQ(encoded(empty), "{\"sessionId\":1234567890,\"totalShots\":0,\"timestamp\":44}");
+}
+
+TEST(MqttJsonPayloadEvents, SessionEvent) {
+  char buf[64];
+  JsonWriter w(buf, sizeof(buf));
+  encodeSessionEvent(w, 77, 88);
+  EXPECT_EQ(encoded(w), "{\"sessionId\":77,\"timestamp\":88}");
+}
+
+TEST(MqttJsonPayloadEvents, LatencyStagesByName) {
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf));
+  beginLatency(w);
+  addLatencyStage(w, "ble", 10, 1, 2, 3, 4);
+  addLatencyStage(w, "mqtt", 10, 500, 900, 4095, 5000);
+  finishLatency(w, 183220);
+  EXPECT_EQ(encoded(w),
+            "{\"stages\":{\"ble\":{\"n\":10,\"minUs\":1,\"avgUs\":2,\"p99Us\":3,\"maxUs\":4},"
+            "\"mqtt\":{\"n\":10,\"minUs\":500,\"avgUs\":900,\"p99Us\":4095,\"maxUs\":5000}},"
+            "\"timestamp\":183220}");
+
+  JsonWriter none(buf, sizeof(buf));
+  beginLatency(none);
+  finishLatency(none, 1);
+  EXPECT_EQ(encoded(none), "{\"stages\":{},\"timestamp\":1}");
+}
+
+TEST(MqttJsonPayloadEvents, EncodingNeverAllocates) {
+  char buf[1024];
+  size_t before = heapAllocations;
+  for (int i = 0; i < 100; i++) {
+    JsonWriter w(buf, sizeof(buf));
+    encodeConnectionState(w, "CONNECTED", "SG-SST4XXXXX", "SG Timer", (uint32_t)i);
+    JsonWriter d(buf, sizeof(buf));
+    encodeDeviceInfo(d, "SG-SST4XXXXX", "SG Timer", "1.2.3", "a1b2c3d4", (uint32_t)i);
+    JsonWriter s(buf, sizeof(buf));
+    encodeSessionStopped(s, 1, 5, 4500, (uint32_t)i);
+    JsonWriter l(buf, sizeof(buf));
+    beginLatency(l);
+    addLatencyStage(l, "mqtt", 10, 500, 900, 4095, 5000);
+    finishLatency(l, (uint32_t)i);
+  }
+  EXPECT_EQ(heapAllocations, before);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Benchmark vs. JsonDocument
+// ═════════════════════════════════════════════════════════════════
+// Not a pass/fail timing test: prints ns/event and heap allocations per
+// event so regressions are visible in the test log. Asserts only what is
+// deterministic - allocation counts and identical output.
+
+static const int BENCH_ITERATIONS = 20000;
+
+template <typename Fn>
+static double nsPerEvent(Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) {
+    fn((uint32_t)i);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / BENCH_ITERATIONS;
+}
+
+static char benchBuffer[1024];
+static volatile size_t benchSink = 0;  // Keeps the encoders from being optimised away
+
+static void writerConnection(uint32_t t) {
+  JsonWriter w(benchBuffer, sizeof(benchBuffer));
+  encodeConnectionState(w, "CONNECTED", "SG-SST4XXXXX", "SG Timer", t);
+  benchSink = benchSink + w.size();
+}
+
+static void writerSessionStopped(uint32_t t) {
+  JsonWriter w(benchBuffer, sizeof(benchBuffer));
+  encodeSessionStopped(w, 1234567890, 5, 4500, t);
+  benchSink = benchSink + w.size();
+}
+
+TEST(MqttJsonPayloadBenchmark, JsonWriter) {
+  size_t before = heapAllocations;
+  double connection = nsPerEvent(writerConnection);
+  double stopped = nsPerEvent(writerSessionStopped);
+  EXPECT_EQ(heapAllocations, before);
+
+  printf("  JsonWriter:   connection %7.1f ns/event, session/stopped %7.1f ns/event, 0 allocations\n",
+         connection, stopped);
+}
+
+#if HAVE_ARDUINOJSON
+
+// Counts JsonDocument pool allocations (ArduinoJson uses malloc, not new)
+struct CountingAllocator : ArduinoJson::Allocator {
+  size_t allocations = 0;
+  void* allocate(size_t size) override {
+    allocations++;
+    return malloc(size);
+  }
+  void deallocate(void* p) override { free(p); }
+  void* reallocate(void* p, size_t size) override {
+    allocations++;
+    return realloc(p, size);
+  }
+};
+
+static CountingAllocator countingAllocator;
+
+// The JsonDocument code MqttJsonPayload replaced, field for field
+static size_t documentConnection(uint32_t t) {
+  JsonDocument doc(&countingAllocator);
+  doc["state"] = "CONNECTED";
+  doc["deviceName"] = "SG-SST4XXXXX";
+  doc["deviceModel"] = "SG Timer";
+  doc["timestamp"] = t;
+  size_t n = serializeJson(doc, benchBuffer, sizeof(benchBuffer));
+  benchSink = benchSink + n;
+  return n;
+}
+
+static size_t documentSessionStopped(uint32_t t) {
+  JsonDocument doc(&countingAllocator);
+  doc["sessionId"] = 1234567890u;
+  doc["totalShots"] = (uint16_t)5;
+  doc["lastShotTimeMs"] = 4500u;
+  doc["timestamp"] = t;
+  size_t n = serializeJson(doc, benchBuffer, sizeof(benchBuffer));
+  benchSink = benchSink + n;
+  return n;
+}
+
+TEST(MqttJsonPayloadBenchmark, MatchesJsonDocumentOutput) {
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf));
+  encodeConnectionState(w, "CONNECTED", "SG-SST4XXXXX", "SG Timer", 12345);
+  size_t n = documentConnection(12345);
+  EXPECT_EQ(encoded(w), std::string(benchBuffer, n));
+
+  JsonWriter s(buf, sizeof(buf));
+  encodeSessionStopped(s, 1234567890, 5, 4500, 43);
+  n = documentSessionStopped(43);
+  EXPECT_EQ(encoded(s), std::string(benchBuffer, n));
+
+  JsonDocument doc;
+  doc["sessionId"] = 1u;
+  doc["startDelaySeconds"] = 2.5f;
+  doc["timestamp"] = 3u;
+  n = serializeJson(doc, benchBuffer, sizeof(benchBuffer));
+  JsonWriter started(buf, sizeof(buf));
+  encodeSessionStarted(started, 1, 2.5f, 3);
+  EXPECT_EQ(encoded(started), std::string(benchBuffer, n));
+}
+
+TEST(MqttJsonPayloadBenchmark, JsonDocument) {
+  countingAllocator.allocations = 0;
+  double connection = nsPerEvent(documentConnection);
+  double stopped = nsPerEvent(documentSessionStopped);
+  double perEvent = (double)countingAllocator.allocations / (2.0 * BENCH_ITERATIONS);
+  EXPECT_GT(countingAllocator.allocations, 0u);
+
+  printf("  JsonDocument: connection %7.1f ns/event, session/stopped %7.1f ns/event, %.1f allocations/event\n",
+         connection, stopped, perEvent);
+}
+
+#endif  // HAVE_ARDUINOJSON
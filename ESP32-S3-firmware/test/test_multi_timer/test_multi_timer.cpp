@@ -0,0 +1,441 @@
+/**
+ * @file test_multi_timer.cpp
+ * @brief Native tests for several timers connected to one bridge at once.
+ *
+ * Tests the pieces that let TimerApplication serve a multi-lane bay:
+ * TimerDeviceManager lane assignment, BLE notify routing to the right
+ * device instance (and the wait for an in-flight notification before a
+ * device is released), per-lane BleIngestTask hand-off, and the full
+ * application connecting two SG Timers from one scan and publishing each
+ * on its own MQTT topics. Peers are scripted through the BLE stub.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_multi_timer
+ */
+
+// ── Standard headers FIRST (before access-specifier override) ───
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ── Batched shot publishing is off by default; the batch tests need it ─
+#define MQTT_SHOT_BATCH_WINDOW_MS 20
+
+// ── Override access specifiers so tests can drive the ingest task ─
+#define private   public
+#define protected public
+
+// ── Include real source files (stubs resolve Arduino/BLE/WiFi/MQTT headers) ─
+#include "../../src/Logger.cpp"
+#include "../../src/ShotTrace.cpp"
+#include "../../src/SGTimer.cpp"
+#include "../../src/SpecialPieM1A2Plus.cpp"
+#include "../../src/SpecialPieM1A2F.cpp"
+#include "../../src/ASNTracker.cpp"
+#include "../../src/BleIngestTask.cpp"
+#include "../../src/TimerDeviceManager.cpp"
+#include "../../src/LoopScheduler.cpp"
+#include "../../src/ShotJournal.cpp"
+#include "../../src/LittleFsSpillStore.cpp"
+#include "../../src/ShadowFramebuffer.cpp"
+#include "../../src/GlyphAtlas.cpp"
+#include "../../src/DisplayManager.cpp"
+#include "../../src/MqttJsonPayload.cpp"
+#include "../../src/MqttBinaryPayload.cpp"
+#include "../../src/DeviceId.cpp"
+#include "../../src/WiFiConfig.cpp"
+#include "../../src/MqttManager.cpp"
+#include "../../src/TimerApplication.cpp"
+
+#undef private
+#undef protected
+
+// ─── Scripted peers ──────────────────────────────────────────────
+
+static const char* const LANE_A = "C4:4F:33:00:00:0A";
+static const char* const LANE_B = "C4:4F:33:00:00:0B";
+
+static void advertiseSgTimer(const char* address, const char* name) {
+  BLEAdvertisedDevice peer;
+  peer.setAddress(address);
+  peer.setName(name);
+  peer.setServiceUUID(SGTimer::SERVICE_UUID);
+  BLEMock::advertised().push_back(peer);
+}
+
+static std::vector<uint8_t> sgSessionStart(uint32_t sessionId) {
+  return {0x07, 0x00, (uint8_t)(sessionId >> 24), (uint8_t)(sessionId >> 16),
+          (uint8_t)(sessionId >> 8), (uint8_t)sessionId, 0x00, 0x00};
+}
+
+static std::vector<uint8_t> sgShot(uint32_t sessionId, uint16_t index, uint32_t timeMs) {
+  return {0x0B, 0x04, (uint8_t)(sessionId >> 24), (uint8_t)(sessionId >> 16),
+          (uint8_t)(sessionId >> 8), (uint8_t)sessionId, (uint8_t)(index >> 8), (uint8_t)index,
+          (uint8_t)(timeMs >> 24), (uint8_t)(timeMs >> 16), (uint8_t)(timeMs >> 8), (uint8_t)timeMs};
+}
+
+static bool notifyPeer(const char* address, const std::vector<uint8_t>& payload) {
+  return BLEMock::notifyPeer(address, payload.data(), payload.size());
+}
+
+// SG Timer connected straight through attemptConnection(), shots collected
+struct ConnectedSgTimer {
+  SGTimer device;
+  std::vector<NormalizedShotData> shots;
+
+  bool connect(const char* address) {
+    advertiseSgTimer(address, "SG-SST4A12345");
+    device.onShotDetected([this](const NormalizedShotData& shot) { shots.push_back(shot); });
+    BLEAdvertisedDevice peer = BLEMock::advertised().back();
+    return device.initialize() && device.attemptConnection(&peer);
+  }
+};
+
+class MultiTimerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    Logger::setLevel(LogLevel::NONE);  // Suppress log noise
+    ArduinoMock::resetMillis();
+    ArduinoMock::sleepHook() = nullptr;
+    FreeRtosMock::reset();
+    BLEMock::reset();
+    BLEMock::services().push_back(SGTimer::SERVICE_UUID);
+    PubSubMock::reset();
+    WiFiMock::connected() = true;
+    LittleFSMock::reset();
+    PreferencesMock::reset();
+    PreferencesMock::set("wifi-config", "mqtt_server", "192.168.1.10");
+  }
+
+  void TearDown() override {
+    ArduinoMock::resetMillis();
+  }
+};
+
+// ═════════════════════════════════════════════════════════════════
+//  Lane assignment
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(MultiTimerTest, NewTimersTakeTheLowestUnusedLane) {
+  TimerDeviceManager timers(3);
+  EXPECT_EQ(timers.freeLane(BLEAddress(LANE_A)), 0);
+  timers.assign(0, std::unique_ptr<ITimerDevice>(new SGTimer()), BLEAddress(LANE_A));
+
+  EXPECT_EQ(timers.freeLane(BLEAddress(LANE_B)), 1);
+  EXPECT_EQ(timers.findLane(BLEAddress(LANE_A)), 0);
+  EXPECT_EQ(timers.findLane(BLEAddress(LANE_B)), -1);
+  EXPECT_EQ(timers.count(), 1u);
+}
+
+TEST_F(MultiTimerTest, ReconnectingTimerGetsItsLaneBack) {
+  TimerDeviceManager timers(3);
+  timers.assign(0, std::unique_ptr<ITimerDevice>(new SGTimer()), BLEAddress(LANE_A));
+  timers.assign(1, std::unique_ptr<ITimerDevice>(new SGTimer()), BLEAddress(LANE_B));
+  EXPECT_NE(timers.take(0), nullptr);
+
+  // A stranger avoids the lane A last used; A itself returns to it
+  EXPECT_EQ(timers.freeLane(BLEAddress("C4:4F:33:00:00:0C")), 2);
+  EXPECT_EQ(timers.freeLane(BLEAddress(LANE_A)), 0);
+  EXPECT_EQ(timers.findLane(BLEAddress(LANE_A)), -1);  // Not connected any more
+}
+
+TEST_F(MultiTimerTest, FullManagerHasNoFreeLane) {
+  TimerDeviceManager timers(2);
+  timers.assign(0, std::unique_ptr<ITimerDevice>(new SGTimer()), BLEAddress(LANE_A));
+  timers.assign(1, std::unique_ptr<ITimerDevice>(new SGTimer()), BLEAddress(LANE_B));
+
+  EXPECT_TRUE(timers.isFull());
+  EXPECT_EQ(timers.freeLane(BLEAddress("C4:4F:33:00:00:0C")), -1);
+  EXPECT_EQ(timers.get(2), nullptr);
+}
+
+TEST_F(MultiTimerTest, CapacityIsCappedAtTheLaneLimit) {
+  TimerDeviceManager timers(10);
+  EXPECT_EQ(timers.getCapacity(), MAX_TIMER_LANES);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Notification routing
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(MultiTimerTest, SameModelTimersParseOnlyTheirOwnNotifications) {
+  ConnectedSgTimer a, b;
+  ASSERT_TRUE(a.connect(LANE_A));
+  ASSERT_TRUE(b.connect(LANE_B));
+
+  ASSERT_TRUE(notifyPeer(LANE_A, sgShot(1, 0, 1500)));
+  ASSERT_TRUE(notifyPeer(LANE_B, sgShot(2, 0, 1700)));
+  ASSERT_TRUE(notifyPeer(LANE_B, sgShot(2, 1, 1900)));
+
+  ASSERT_EQ(a.shots.size(), 1u);
+  EXPECT_EQ(a.shots[0].sessionId, 1u);
+  ASSERT_EQ(b.shots.size(), 2u);
+  EXPECT_EQ(b.shots[1].splitTimeMs, 200u);  // B's split state untouched by A
+}
+
+TEST_F(MultiTimerTest, DisconnectedTimerLeavesTheOtherRouted) {
+  ConnectedSgTimer a, b;
+  ASSERT_TRUE(a.connect(LANE_A));
+  ASSERT_TRUE(b.connect(LANE_B));
+
+  a.device.disconnect();
+
+  EXPECT_FALSE(notifyPeer(LANE_A, sgShot(1, 0, 1500)));
+  EXPECT_TRUE(notifyPeer(LANE_B, sgShot(2, 0, 1700)));
+  EXPECT_TRUE(a.shots.empty());
+  EXPECT_EQ(b.shots.size(), 1u);
+}
+
+TEST_F(MultiTimerTest, UnsubscribeWaitsForADispatchInProgress) {
+  ConnectedSgTimer a;
+  ASSERT_TRUE(a.connect(LANE_A));
+
+  BaseTimerDevice::NotifyRoute* route = nullptr;
+  BaseTimerDevice::NotifyRoute* routes = BaseTimerDevice::notifyRoutes();
+  for (size_t i = 0; i < BaseTimerDevice::MAX_NOTIFY_ROUTES; i++) {
+    if (routes[i].device.load() == &a.device) route = &routes[i];
+  }
+  ASSERT_NE(route, nullptr);
+
+  // The BLE stack task is inside routeNotification() for this device and
+  // finishes 5 ms later
+  route->inUse.fetch_add(1);
+  unsigned long waitedMs = 0;
+  ArduinoMock::sleepHook() = [&](unsigned long ms, const std::function<bool()>&) {
+    waitedMs += ms;
+    if (waitedMs == 5) route->inUse.fetch_sub(1);
+  };
+
+  a.device.disconnect();
+
+  EXPECT_EQ(waitedMs, 5u);  // Safe to delete the device only now
+  EXPECT_EQ(route->device.load(), nullptr);
+  EXPECT_FALSE(notifyPeer(LANE_A, sgShot(1, 0, 1500)));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  BLE ingest lanes
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(MultiTimerTest, IngestHandsEachPayloadToItsLanesDevice) {
+  ConnectedSgTimer a, b;
+  ASSERT_TRUE(a.connect(LANE_A));
+  ASSERT_TRUE(b.connect(LANE_B));
+  BleIngestTask ingest;
+  ASSERT_TRUE(ingest.start(0, 5, 4096));
+  ingest.attach(0, &a.device);
+  ingest.attach(1, &b.device);
+
+  notifyPeer(LANE_B, sgShot(2, 0, 1700));
+  notifyPeer(LANE_A, sgShot(1, 0, 1500));
+  EXPECT_TRUE(a.shots.empty());  // Parsing waits for the ingest task
+  ingest.drain();
+
+  ASSERT_EQ(a.shots.size(), 1u);
+  ASSERT_EQ(b.shots.size(), 1u);
+  EXPECT_EQ(a.shots[0].sessionId, 1u);
+  EXPECT_EQ(b.shots[0].sessionId, 2u);
+  EXPECT_EQ(ingest.getProcessedCount(), 2u);
+}
+
+TEST_F(MultiTimerTest, DetachingOneLaneDropsOnlyItsQueuedPayloads) {
+  ConnectedSgTimer a, b;
+  ASSERT_TRUE(a.connect(LANE_A));
+  ASSERT_TRUE(b.connect(LANE_B));
+  BleIngestTask ingest;
+  ASSERT_TRUE(ingest.start(0, 5, 4096));
+  ingest.attach(0, &a.device);
+  ingest.attach(1, &b.device);
+
+  notifyPeer(LANE_A, sgShot(1, 0, 1500));
+  notifyPeer(LANE_B, sgShot(2, 0, 1700));
+  ingest.detach(0);
+  ingest.drain();
+
+  EXPECT_TRUE(a.shots.empty());
+  EXPECT_EQ(b.shots.size(), 1u);
+  EXPECT_EQ(ingest.getDroppedCount(), 1u);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Application
+// ═════════════════════════════════════════════════════════════════
+
+class MultiTimerAppTest : public MultiTimerTest {
+protected:
+  static constexpr unsigned long TIMEOUT_MS = 120000;
+
+  void SetUp() override {
+    MultiTimerTest::SetUp();
+    advertiseSgTimer(LANE_A, "SG-SST4A00001");
+    advertiseSgTimer(LANE_B, "SG-SST4A00002");
+    deviceId.initialize();
+  }
+
+  // Main loop passes until done() or the virtual clock runs out
+  static bool runUntil(TimerApplication& app, const std::function<bool()>& done,
+                       unsigned long timeoutMs = TIMEOUT_MS) {
+    unsigned long until = millis() + timeoutMs;
+    while (!done() && millis() < until) {
+      app.run();
+      runIngest(app);
+    }
+    return done();
+  }
+
+  // What the ingest task would do as soon as it is woken
+  static void runIngest(TimerApplication& app) {
+    if (app.bleIngest && FreeRtosMock::takeNotifications(app.bleIngest->taskHandle) > 0) {
+      app.bleIngest->drain();
+    }
+  }
+
+  static void deliver(TimerApplication& app, const char* address, const std::vector<uint8_t>& payload) {
+    ASSERT_TRUE(notifyPeer(address, payload));
+    runIngest(app);
+  }
+
+  static size_t published(const std::string& topic) {
+    size_t n = 0;
+    for (const PubSubMock::Message& m : PubSubMock::published()) {
+      if (m.topic == topic) n++;
+    }
+    return n;
+  }
+
+  static std::string ownTopic(const char* suffix) {
+    return std::string("timer/") + deviceId.get().c_str() + "/" + suffix;
+  }
+
+  static std::string laneTopic(int lane, const char* suffix) {
+    return std::string("timer/") + deviceId.get().c_str() + "-L" + std::to_string(lane) + "/" + suffix;
+  }
+};
+
+TEST_F(MultiTimerAppTest, OneScanConnectsEveryTimerInRange) {
+  TimerApplication app;
+  ASSERT_TRUE(app.initialize());
+
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 2; }));
+  EXPECT_EQ(app.timers.findLane(BLEAddress(LANE_A)), 0);
+  EXPECT_EQ(app.timers.findLane(BLEAddress(LANE_B)), 1);
+  EXPECT_TRUE(app.isRuntimeReady());
+}
+
+TEST_F(MultiTimerAppTest, EachLanePublishesOnItsOwnTopics) {
+  TimerApplication app;
+  ASSERT_TRUE(app.initialize());
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 2; }));
+
+  deliver(app, LANE_A, sgSessionStart(100));
+  deliver(app, LANE_B, sgSessionStart(200));
+  app.run();
+  EXPECT_TRUE(app.isSessionActive());
+  deliver(app, LANE_A, sgShot(100, 0, 1500));
+  deliver(app, LANE_B, sgShot(200, 0, 1600));
+
+  ASSERT_TRUE(runUntil(app, [&]() { return app.totalShotsPublished == 2; }, 5000));
+
+  EXPECT_EQ(published(ownTopic("session/started")), 1u);
+  EXPECT_EQ(published(laneTopic(2, "session/started")), 1u);
+  EXPECT_EQ(published(ownTopic("shot/detected")), 1u);
+  EXPECT_EQ(published(laneTopic(2, "shot/detected")), 1u);
+  EXPECT_GE(published(laneTopic(2, "connection/state")), 1u);
+
+  for (const PubSubMock::Message& m : PubSubMock::published()) {
+    if (m.topic == laneTopic(2, "shot/detected")) {
+      EXPECT_NE(m.payload.find("200"), std::string::npos) << m.payload;  // Lane B's session
+    }
+  }
+}
+
+TEST_F(MultiTimerAppTest, LostTimerFreesItsLaneAndTheOtherKeepsStreaming) {
+  TimerApplication app;
+  ASSERT_TRUE(app.initialize());
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 2; }));
+
+  BLEMock::outOfRangePeers().push_back(LANE_B);
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 1; }, 5000));
+  EXPECT_EQ(app.timers.get(1), nullptr);
+  EXPECT_GE(published(laneTopic(2, "connection/state")), 2u);  // connected, then disconnected
+
+  deliver(app, LANE_A, sgSessionStart(100));
+  deliver(app, LANE_A, sgShot(100, 0, 1500));
+  ASSERT_TRUE(runUntil(app, [&]() { return app.totalShotsPublished == 1; }, 5000));
+  EXPECT_EQ(published(ownTopic("shot/detected")), 1u);
+}
+
+TEST_F(MultiTimerAppTest, ReturningTimerIsReconnectedOnItsLaneBetweenSessions) {
+  TimerApplication app;
+  ASSERT_TRUE(app.initialize());
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 2; }));
+  BLEMock::outOfRangePeers().push_back(LANE_A);
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 1; }, 5000));
+  BLEMock::outOfRangePeers().clear();
+
+  // No rescan while lane 2 is mid-session
+  deliver(app, LANE_B, sgSessionStart(200));
+  runUntil(app, []() { return false; }, AppConfig::RESCAN_INTERVAL_MS + 1000);
+  EXPECT_EQ(app.getConnectedTimerCount(), 1u);
+
+  deliver(app, LANE_B, {0x07, 0x03, 0x00, 0x00, 0x00, 0xC8, 0x00, 0x00});  // Session 200 stopped
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 2; },
+                       AppConfig::RESCAN_INTERVAL_MS + 1000));
+  EXPECT_EQ(app.timers.findLane(BLEAddress(LANE_A)), 0);
+}
+
+TEST_F(MultiTimerAppTest, SessionEventsAreAppliedOnTheMainLoopInOrderWithShots) {
+  TimerApplication app;
+  ASSERT_TRUE(app.initialize());
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 2; }));
+  PubSubMock::published().clear();
+
+  // Parsed on the ingest task - nothing reaches MQTT or the display from there
+  deliver(app, LANE_A, sgSessionStart(100));
+  deliver(app, LANE_A, sgShot(100, 0, 1500));
+  deliver(app, LANE_A, sgShot(100, 1, 1800));
+  deliver(app, LANE_A, {0x07, 0x03, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00});  // Session 100 stopped
+  EXPECT_TRUE(PubSubMock::published().empty());
+  EXPECT_FALSE(app.isSessionActive());
+  EXPECT_EQ(app.eventRing.size(), 4u);
+
+  ASSERT_TRUE(runUntil(app, [&]() { return app.totalShotsPublished == 2; }, 5000));
+  EXPECT_FALSE(app.isSessionActive());
+  EXPECT_EQ(app.lastShotNumber[0], 2u);  // Both shots counted before the session end
+  EXPECT_EQ(app.lastShotTime[0], 1800u);
+  EXPECT_EQ(published(ownTopic("session/started")), 1u);
+  EXPECT_EQ(published(ownTopic("session/stopped")), 1u);
+}
+
+TEST_F(MultiTimerAppTest, SessionEndClosesTheOpenShotBatchFirst) {
+  TimerApplication app;
+  ASSERT_TRUE(app.initialize());
+  ASSERT_TRUE(runUntil(app, [&]() { return app.getConnectedTimerCount() == 2; }));
+  deliver(app, LANE_A, sgSessionStart(100));
+  ASSERT_TRUE(runUntil(app, [&]() { return published(ownTopic("session/started")) == 1; }, 5000));
+  PubSubMock::published().clear();
+
+  // Journaled inside the batch window, then the other lane and this one change session
+  deliver(app, LANE_A, sgShot(100, 0, 1500));
+  deliver(app, LANE_A, sgShot(100, 1, 1800));
+  app.run();
+  EXPECT_EQ(app.totalShotsPublished, 0u);
+  deliver(app, LANE_B, sgSessionStart(200));
+  deliver(app, LANE_A, {0x07, 0x03, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00});  // Session 100 stopped
+  app.run();
+
+  // One intact batch, on the wire ahead of both session messages
+  const std::vector<PubSubMock::Message>& messages = PubSubMock::published();
+  ASSERT_EQ(messages.size(), 3u);
+  EXPECT_EQ(messages[0].topic, ownTopic("shot/batch"));
+  EXPECT_EQ(messages[0].payload.find("{\"sessionId\":100,"), 0u) << messages[0].payload;
+  EXPECT_NE(messages[0].payload.find("\"shots\":[[1,1,1500,"), std::string::npos) << messages[0].payload;
+  EXPECT_NE(messages[0].payload.find("],[2,2,1800,"), std::string::npos) << messages[0].payload;
+  EXPECT_EQ(messages[0].payload.substr(messages[0].payload.size() - 2), "]}");
+  EXPECT_EQ(messages[1].topic, laneTopic(2, "session/started"));
+  EXPECT_EQ(messages[2].topic, ownTopic("session/stopped"));
+}
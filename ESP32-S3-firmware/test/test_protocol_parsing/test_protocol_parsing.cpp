@@ -126,6 +126,34 @@ TEST_F(SGTimerProtocolTest, ShotDetected_FirstShot) {
   EXPECT_EQ(receivedShot.sessionId, 1u);
 }
 
+TEST_F(SGTimerProtocolTest, ShotDetected_CarriesNotificationArrivalTime) {
+  // Deferred (ingest task) path: arrival time travels with the payload
+  uint8_t pkt[] = {
+    0x0B, 0x04,
+    0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00,
+    0x00, 0x00, 0x05, 0xDC
+  };
+  device.processNotification(pkt, sizeof(pkt), 123456);
+
+  EXPECT_TRUE(callbackCalled);
+  EXPECT_EQ(receivedShot.traceOriginUs, 123456);
+}
+
+TEST_F(SGTimerProtocolTest, ShotDetected_InlineDispatchStampsArrivalTime) {
+  // No sink: parsed inline, stamped from esp_timer (stub = millis * 1000)
+  uint8_t pkt[] = {
+    0x0B, 0x04,
+    0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00,
+    0x00, 0x00, 0x05, 0xDC
+  };
+  device.dispatchNotification(pkt, sizeof(pkt));
+
+  EXPECT_TRUE(callbackCalled);
+  EXPECT_EQ(receivedShot.traceOriginUs, 1000000);
+}
+
 TEST_F(SGTimerProtocolTest, ShotDetected_SplitTimeCalculation) {
   // First shot at 1500 ms
   uint8_t shot1[] = {
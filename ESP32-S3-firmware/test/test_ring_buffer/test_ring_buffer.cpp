@@ -3,13 +3,14 @@
  * @brief Native tests for the shot event ring buffer logic.
  *
  * Tests the power-of-2 ring buffer used in TimerApplication for
- * lock-free BLE→MQTT shot event queuing. The formulas are taken
- * directly from TimerApplication.h (AppConfig namespace).
+ * lock-free BLE→main loop shot event queuing. The index math is
+ * tested standalone first, then the real SpscRing template from
+ * SpscRing.h (header-only, no hardware dependencies) including a
+ * two-thread producer/consumer run.
  *
- * We test the math standalone rather than including TimerApplication.h
- * (which pulls in DisplayManager, MqttManager, and many hardware
- * dependencies). This keeps the test lightweight and isolates the
- * ring buffer logic.
+ * We don't include TimerApplication.h (which pulls in DisplayManager,
+ * MqttManager, and many hardware dependencies). This keeps the test
+ * lightweight and isolates the ring buffer logic.
  *
  * Runner:  GoogleTest (native)
  * Command: pio test -e native-tests --filter test_ring_buffer
@@ -18,6 +19,9 @@
 #include <gtest/gtest.h>
 #include <cstdint>
 #include <cstring>
+#include <thread>
+
+#include "SpscRing.h"
 
 // ═════════════════════════════════════════════════════════════════
 //  Ring buffer logic — mirrors TimerApplication.h exactly
@@ -250,7 +254,7 @@ TEST(RingBuffer, ClearByMovingTailToHead) {
   }
   EXPECT_EQ(RingBuffer::queueSize(head, tail), 15);
 
-  // Clear queue (as done in TimerApplication::onSessionStopped)
+  // Clear queue (consumer discards everything queued)
   tail = head;
 
   EXPECT_TRUE(RingBuffer::queueEmpty(head, tail));
@@ -262,3 +266,101 @@ int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
+
+// ═════════════════════════════════════════════════════════════════
+//  SpscRing template (SpscRing.h)
+// ═════════════════════════════════════════════════════════════════
+
+TEST(SpscRing, InitiallyEmpty) {
+  SpscRing<ShotEvent, 32> ring;
+  ShotEvent out{};
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.size(), 0u);
+  EXPECT_EQ(ring.front(), nullptr);
+  EXPECT_FALSE(ring.pop(out));
+}
+
+TEST(SpscRing, CapacityIsSizeMinusOne) {
+  SpscRing<ShotEvent, 32> ring;
+  EXPECT_EQ(ring.capacity(), 31u);
+
+  for (uint16_t i = 0; i < 31; i++) {
+    EXPECT_TRUE(ring.push({i, i * 100u}));
+  }
+  EXPECT_TRUE(ring.full());
+  EXPECT_FALSE(ring.push({99, 9900}));  // Rejected, not overwritten
+  EXPECT_EQ(ring.size(), 31u);
+}
+
+TEST(SpscRing, FifoOrderAcrossWraparound) {
+  SpscRing<ShotEvent, 8> ring;
+  ShotEvent out{};
+  uint16_t nextExpected = 1;
+
+  // Push/pop in uneven batches so indices wrap several times
+  for (uint16_t shot = 1; shot <= 50; shot++) {
+    ASSERT_TRUE(ring.push({shot, shot * 10u}));
+    if (shot % 3 == 0) {
+      while (ring.pop(out)) {
+        EXPECT_EQ(out.shotNumber, nextExpected);
+        EXPECT_EQ(out.timeMs, nextExpected * 10u);
+        nextExpected++;
+      }
+    }
+  }
+  while (ring.pop(out)) {
+    EXPECT_EQ(out.shotNumber, nextExpected++);
+  }
+  EXPECT_EQ(nextExpected, 51);
+}
+
+TEST(SpscRing, FrontPeeksWithoutRemoving) {
+  SpscRing<ShotEvent, 4> ring;
+  ring.push({7, 700});
+  ASSERT_NE(ring.front(), nullptr);
+  EXPECT_EQ(ring.front()->shotNumber, 7);
+  EXPECT_EQ(ring.size(), 1u);
+}
+
+TEST(SpscRing, ClearReturnsDroppedCount) {
+  SpscRing<ShotEvent, 16> ring;
+  for (uint16_t i = 0; i < 5; i++) {
+    ring.push({i, 0});
+  }
+  EXPECT_EQ(ring.clear(), 5u);
+  EXPECT_TRUE(ring.empty());
+
+  // Still usable after clear
+  ShotEvent out{};
+  ring.push({42, 4200});
+  ASSERT_TRUE(ring.pop(out));
+  EXPECT_EQ(out.shotNumber, 42);
+}
+
+TEST(SpscRing, ConcurrentProducerConsumer) {
+  // One producer thread, one consumer thread - every item arrives once, in order
+  SpscRing<ShotEvent, 32> ring;
+  constexpr uint32_t TOTAL = 100000;
+
+  std::thread producer([&ring]() {
+    for (uint32_t i = 0; i < TOTAL; i++) {
+      ShotEvent ev{(uint16_t)(i & 0xFFFF), i};
+      while (!ring.push(ev)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t expected = 0;
+  ShotEvent out{};
+  while (expected < TOTAL) {
+    if (ring.pop(out)) {
+      ASSERT_EQ(out.timeMs, expected);
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ring.empty());
+}
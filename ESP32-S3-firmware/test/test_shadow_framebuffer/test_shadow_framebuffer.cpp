@@ -0,0 +1,267 @@
+/**
+ * @file test_shadow_framebuffer.cpp
+ * @brief Native tests for the shadow framebuffer diff engine.
+ *
+ * Tests ShadowFramebuffer, which DisplayManager renders into before
+ * pushing only changed pixels to the HUB75 panel: tile tracking,
+ * clipping, run coalescing and the "clear + redraw" no-op case.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_shadow_framebuffer
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "../../src/ShadowFramebuffer.cpp"
+
+// ─── Recording panel ─────────────────────────────────────────────
+
+class RecordingPanel : public Adafruit_GFX {
+public:
+  RecordingPanel(int16_t w, int16_t h) : Adafruit_GFX(w, h), pixels(w * h, 0) {}
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    pixels[y * _width + x] = color;
+    pixelCalls++;
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    for (int16_t i = 0; i < w; i++) pixels[y * _width + x + i] = color;
+    hlineCalls++;
+  }
+
+  uint16_t at(int16_t x, int16_t y) const { return pixels[y * _width + x]; }
+  int calls() const { return pixelCalls + hlineCalls; }
+  void resetCounters() { pixelCalls = 0; hlineCalls = 0; }
+
+  std::vector<uint16_t> pixels;
+  int pixelCalls = 0;
+  int hlineCalls = 0;
+};
+
+class ShadowFramebufferTest : public ::testing::Test {
+protected:
+  static constexpr int16_t W = 128;
+  static constexpr int16_t H = 32;
+
+  ShadowFramebuffer fb{W, H};
+  RecordingPanel panel{W, H};
+
+  void SetUp() override { ASSERT_TRUE(fb.begin()); }
+
+  bool panelMatchesFrame() const {
+    for (int16_t y = 0; y < H; y++)
+      for (int16_t x = 0; x < W; x++)
+        if (panel.at(x, y) != fb.getPixel(x, y)) return false;
+    return true;
+  }
+};
+
+// ═════════════════════════════════════════════════════════════════
+//  Allocation and geometry
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShadowFramebufferSetup, RejectsSizesThatAreNotWholeTiles) {
+  ShadowFramebuffer fb(100, 32);
+  EXPECT_FALSE(fb.begin());
+  EXPECT_FALSE(fb.isReady());
+}
+
+TEST(ShadowFramebufferSetup, RejectsMoreTilesThanTheMaskHolds) {
+  ShadowFramebuffer fb(256, 32);   // 32 x 4 = 128 tiles
+  EXPECT_FALSE(fb.begin());
+}
+
+TEST_F(ShadowFramebufferTest, StartsBlackWithNothingPending) {
+  EXPECT_TRUE(fb.isReady());
+  EXPECT_FALSE(fb.hasPendingTiles());
+  EXPECT_EQ(fb.getPixel(0, 0), 0);
+  EXPECT_EQ(fb.getBufferBytes(), (size_t)W * H * 2 * 2);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Diffing
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(ShadowFramebufferTest, SinglePixelTouchesOneTile) {
+  fb.drawPixel(10, 10, 0xFFFF);
+  auto stats = fb.present(panel);
+
+  EXPECT_EQ(stats.tilesTouched, 1);
+  EXPECT_EQ(stats.tilesChanged, 1);
+  EXPECT_EQ(stats.pixelsPushed, 1);
+  EXPECT_EQ(panel.pixelCalls, 1);
+  EXPECT_EQ(panel.at(10, 10), 0xFFFF);
+  EXPECT_FALSE(fb.hasPendingTiles());
+}
+
+TEST_F(ShadowFramebufferTest, SameColourPixelsCoalesceIntoRuns) {
+  fb.drawFastHLine(0, 5, 8, 0x07E0);   // Exactly one tile row
+  auto stats = fb.present(panel);
+
+  EXPECT_EQ(stats.runsPushed, 1);
+  EXPECT_EQ(panel.hlineCalls, 1);
+  EXPECT_EQ(stats.pixelsPushed, 8);
+}
+
+TEST_F(ShadowFramebufferTest, RunsSplitAtTileBoundaries) {
+  fb.drawFastHLine(4, 0, 8, 0x07E0);   // Spans tiles 0 and 1
+  auto stats = fb.present(panel);
+
+  EXPECT_EQ(stats.tilesChanged, 2);
+  EXPECT_EQ(stats.runsPushed, 2);
+  EXPECT_TRUE(panelMatchesFrame());
+}
+
+TEST_F(ShadowFramebufferTest, ClearAndRedrawIdenticalFramePushesNothing) {
+  fb.fillRect(20, 4, 30, 20, 0xF800);
+  fb.present(panel);
+  panel.resetCounters();
+
+  // The old renderer pattern: full clear, then draw the same content
+  fb.fillScreen(0);
+  fb.fillRect(20, 4, 30, 20, 0xF800);
+  auto stats = fb.present(panel);
+
+  EXPECT_EQ(stats.tilesTouched, 64);
+  EXPECT_EQ(stats.tilesChanged, 0);
+  EXPECT_EQ(stats.pixelsPushed, 0);
+  EXPECT_EQ(panel.calls(), 0);
+}
+
+TEST_F(ShadowFramebufferTest, OnlyChangedDigitCellIsPushed) {
+  // Two "digits" in separate cells
+  fb.fillRect(64, 8, 6, 10, 0x07E0);
+  fb.fillRect(80, 8, 6, 10, 0x07E0);
+  fb.present(panel);
+  panel.resetCounters();
+
+  // Redraw with the second digit changed
+  fb.fillScreen(0);
+  fb.fillRect(64, 8, 6, 10, 0x07E0);
+  fb.fillRect(80, 8, 3, 10, 0x07E0);
+  auto stats = fb.present(panel);
+
+  EXPECT_EQ(stats.tilesChanged, 2);    // Column x=80..87, rows 8..15 and 16..23
+  EXPECT_EQ(stats.pixelsPushed, 30);   // 3 px wide x 10 rows cleared
+  EXPECT_TRUE(panelMatchesFrame());
+}
+
+TEST_F(ShadowFramebufferTest, ChangedColourIsPushed) {
+  fb.fillRect(0, 0, 8, 8, 0xFFFF);
+  fb.present(panel);
+  fb.fillRect(0, 0, 8, 8, 0xF800);
+  auto stats = fb.present(panel);
+
+  EXPECT_EQ(stats.pixelsPushed, 64);
+  EXPECT_EQ(stats.runsPushed, 8);
+  EXPECT_EQ(panel.at(7, 7), 0xF800);
+}
+
+TEST_F(ShadowFramebufferTest, ResetShownRepushesNonBlackContent) {
+  fb.fillRect(0, 0, 16, 8, 0xFFFF);
+  fb.present(panel);
+
+  // Panel cleared externally
+  std::fill(panel.pixels.begin(), panel.pixels.end(), 0);
+  fb.resetShown();
+  EXPECT_TRUE(fb.hasPendingTiles());
+
+  auto stats = fb.present(panel);
+  EXPECT_EQ(stats.pixelsPushed, 128);
+  EXPECT_TRUE(panelMatchesFrame());
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Clipping
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(ShadowFramebufferTest, OffscreenDrawingIsClipped) {
+  fb.drawPixel(-1, 0, 0xFFFF);
+  fb.drawPixel(W, 0, 0xFFFF);
+  fb.drawPixel(0, H, 0xFFFF);
+  EXPECT_FALSE(fb.hasPendingTiles());
+
+  fb.fillRect(-4, -4, 8, 8, 0xFFFF);   // Only the 4x4 corner is visible
+  auto stats = fb.present(panel);
+  EXPECT_EQ(stats.tilesTouched, 1);
+  EXPECT_EQ(stats.pixelsPushed, 16);
+}
+
+TEST_F(ShadowFramebufferTest, MarqueeTextPartlyOffscreenStaysInBounds) {
+  fb.fillRect(120, 10, 40, 4, 0x07E0);   // Scrolled off the right edge
+  auto stats = fb.present(panel);
+  EXPECT_EQ(stats.pixelsPushed, 8 * 4);
+  EXPECT_TRUE(panelMatchesFrame());
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Double-buffered pages
+// ═════════════════════════════════════════════════════════════════
+
+class DoubleBufferedFramebufferTest : public ::testing::Test {
+protected:
+  static constexpr int16_t W = 128;
+  static constexpr int16_t H = 32;
+
+  ShadowFramebuffer fb{W, H, 2};
+  RecordingPanel pages[2]{{W, H}, {W, H}};
+  int back = 0;
+
+  void SetUp() override { ASSERT_TRUE(fb.begin()); }
+
+  // Present into the back page, then flip like DisplayManager does
+  ShadowFramebuffer::PresentStats presentAndFlip() {
+    auto stats = fb.present(pages[back]);
+    fb.flipPage();
+    back ^= 1;
+    return stats;
+  }
+
+  bool pageMatchesFrame(int page) const {
+    for (int16_t y = 0; y < H; y++)
+      for (int16_t x = 0; x < W; x++)
+        if (pages[page].at(x, y) != fb.getPixel(x, y)) return false;
+    return true;
+  }
+};
+
+TEST_F(DoubleBufferedFramebufferTest, MirrorsOnePerPage) {
+  EXPECT_EQ(fb.getPageCount(), 2);
+  EXPECT_EQ(fb.getBufferBytes(), (size_t)W * H * 2 * 3);
+}
+
+TEST_F(DoubleBufferedFramebufferTest, OtherPageCatchesUpOnItsNextPresent) {
+  fb.fillRect(0, 0, 16, 8, 0xFFFF);
+  presentAndFlip();                   // Page 0 gets the rectangle
+  EXPECT_TRUE(pageMatchesFrame(0));
+  EXPECT_FALSE(pageMatchesFrame(1));
+
+  // Next frame draws somewhere else; page 1 must also receive the rectangle
+  fb.drawPixel(100, 20, 0xF800);
+  presentAndFlip();
+  EXPECT_TRUE(pageMatchesFrame(1));
+}
+
+TEST_F(DoubleBufferedFramebufferTest, NothingPendingAfterPresentEvenIfOtherPageIsStale) {
+  fb.drawPixel(5, 5, 0xFFFF);
+  presentAndFlip();
+  EXPECT_FALSE(fb.hasPendingTiles());
+}
+
+TEST_F(DoubleBufferedFramebufferTest, SteadyContentConvergesToNoPushes) {
+  for (int frame = 0; frame < 3; frame++) {
+    fb.fillScreen(0);
+    fb.fillRect(64, 8, 20, 16, 0x07E0);
+    presentAndFlip();
+  }
+  EXPECT_TRUE(pageMatchesFrame(0));
+  EXPECT_TRUE(pageMatchesFrame(1));
+
+  fb.fillScreen(0);
+  fb.fillRect(64, 8, 20, 16, 0x07E0);
+  auto stats = presentAndFlip();
+  EXPECT_EQ(stats.pixelsPushed, 0);
+}
@@ -0,0 +1,529 @@
+/**
+ * @file test_shot_journal.cpp
+ * @brief Native tests for the store-and-forward shot journal.
+ *
+ * Tests ShotJournal, which TimerApplication publishes shots from so they
+ * survive MQTT outages: per-lane, per-session sequence numbers, replay
+ * order across the spill store and the RAM ring, batch peeks, overflow and
+ * drop accounting.
+ * ShotJournal runs against an in-memory spill store; LittleFsSpillStore
+ * is tested on its own over the LittleFS stub (recovery, short writes).
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_shot_journal
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "../../src/Logger.cpp"
+#include "../../src/ShotJournal.cpp"
+#include "../../src/LittleFsSpillStore.cpp"
+
+// ─── In-memory spill store ───────────────────────────────────────
+
+class MemorySpillStore : public JournalSpillStore {
+public:
+  explicit MemorySpillStore(uint32_t maxRecords) : maxRecords(maxRecords) {}
+
+  uint32_t count() const override { return (uint32_t)(records.size() - readIndex); }
+  uint32_t capacity() const override { return maxRecords; }
+
+  bool append(const JournalRecord* in, uint32_t n) override {
+    appendCalls++;
+    records.insert(records.end(), in, in + n);
+    return true;
+  }
+
+  uint32_t read(JournalRecord* out, uint32_t max) override {
+    uint32_t n = count() < max ? count() : max;
+    for (uint32_t i = 0; i < n; i++) {
+      out[i] = records[readIndex + i];
+    }
+    return n;
+  }
+
+  void consume(uint32_t n) override {
+    consumeCalls++;
+    readIndex += n;
+  }
+
+  void clear() override {
+    records.clear();
+    readIndex = 0;
+  }
+
+  std::vector<JournalRecord> records;
+  uint32_t readIndex = 0;
+  uint32_t maxRecords;
+  int appendCalls = 0;
+  int consumeCalls = 0;
+};
+
+static NormalizedShotData makeShot(uint32_t sessionId, uint16_t shotNumber) {
+  NormalizedShotData shot;
+  shot.sessionId = sessionId;
+  shot.shotNumber = shotNumber;
+  shot.absoluteTimeMs = shotNumber * 1000u;
+  shot.splitTimeMs = 1000;
+  shot.timestampMs = 50000u + shotNumber;
+  shot.traceOriginUs = 123456;
+  shot.isFirstShot = shotNumber == 1;
+  strncpy(shot.deviceModel, "SG Timer Sport", sizeof(shot.deviceModel) - 1);
+  return shot;
+}
+
+// Pop everything, returning shot numbers in replay order
+static std::vector<uint16_t> drain(ShotJournal& journal) {
+  std::vector<uint16_t> out;
+  JournalRecord record;
+  while (journal.peek(record)) {
+    out.push_back(record.shotNumber);
+    journal.pop();
+  }
+  return out;
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Append and replay
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShotJournalReplay, EmptyJournalHasNothingToPeek) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+
+  JournalRecord record;
+  EXPECT_FALSE(journal.peek(record));
+  EXPECT_EQ(journal.pending(), 0u);
+}
+
+TEST(ShotJournalReplay, AppendBeforeBeginIsIgnored) {
+  ShotJournal journal;
+  journal.append(makeShot(1, 1));
+
+  EXPECT_FALSE(journal.isReady());
+  EXPECT_EQ(journal.pending(), 0u);
+}
+
+TEST(ShotJournalReplay, PeekDoesNotRemoveUntilPop) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  journal.append(makeShot(1, 1));
+
+  JournalRecord record;
+  ASSERT_TRUE(journal.peek(record));
+  ASSERT_TRUE(journal.peek(record));
+  EXPECT_EQ(journal.pending(), 1u);
+
+  journal.pop();
+  EXPECT_EQ(journal.pending(), 0u);
+  EXPECT_EQ(journal.getStats().replayed, 1u);
+}
+
+TEST(ShotJournalReplay, RoundTripPreservesShotFields) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  journal.append(makeShot(42, 1));
+
+  JournalRecord record;
+  ASSERT_TRUE(journal.peek(record));
+  NormalizedShotData shot;
+  ShotJournal::toShotData(record, shot);
+
+  EXPECT_EQ(shot.sessionId, 42u);
+  EXPECT_EQ(shot.shotNumber, 1u);
+  EXPECT_EQ(shot.absoluteTimeMs, 1000u);
+  EXPECT_EQ(shot.splitTimeMs, 1000u);
+  EXPECT_EQ(shot.timestampMs, 50001u);
+  EXPECT_EQ(shot.traceOriginUs, 123456);
+  EXPECT_TRUE(shot.isFirstShot);
+  EXPECT_STREQ(shot.deviceModel, "SG Timer Sport");
+}
+
+TEST(ShotJournalReplay, FullLengthDeviceModelIsKept) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  NormalizedShotData shot = makeShot(1, 1);
+  const char longModel[] = "A very long timer model name here";
+  static_assert(sizeof(longModel) > sizeof(shot.deviceModel), "Model must fill the field");
+  memcpy(shot.deviceModel, longModel, sizeof(shot.deviceModel) - 1);
+  shot.deviceModel[sizeof(shot.deviceModel) - 1] = '\0';
+  journal.append(shot);
+
+  // Published exactly as the pre-journal path sent it
+  JournalRecord record;
+  ASSERT_TRUE(journal.peek(record));
+  NormalizedShotData replayed;
+  ShotJournal::toShotData(record, replayed);
+  EXPECT_STREQ(replayed.deviceModel, shot.deviceModel);
+  EXPECT_EQ(strlen(replayed.deviceModel), sizeof(shot.deviceModel) - 1);
+}
+
+TEST(ShotJournalReplay, ClearTraceOriginsZeroesWaitingRecords) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  journal.append(makeShot(1, 1));
+  journal.clearTraceOrigins();
+
+  JournalRecord record;
+  ASSERT_TRUE(journal.peek(record));
+  EXPECT_EQ(record.traceOriginUs, 0);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Batch peek
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShotJournalBatch, PeekBatchReturnsOldestWithoutRemoving) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  for (uint16_t i = 1; i <= 5; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  JournalRecord batch[16];
+  ASSERT_EQ(journal.peekBatch(batch, 16), 5u);
+  EXPECT_EQ(batch[0].shotNumber, 1u);
+  EXPECT_EQ(batch[4].shotNumber, 5u);
+  EXPECT_EQ(journal.pending(), 5u);
+}
+
+TEST(ShotJournalBatch, PeekBatchIsCappedAtMax) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  for (uint16_t i = 1; i <= 20; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  JournalRecord batch[16];
+  EXPECT_EQ(journal.peekBatch(batch, 16), 16u);
+  EXPECT_EQ(journal.peekBatch(batch, 0), 0u);
+}
+
+TEST(ShotJournalBatch, PeekBatchFollowsTheRingWrap) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(32, nullptr));
+  for (uint16_t i = 1; i <= 30; i++) {
+    journal.append(makeShot(1, i));
+  }
+  for (int i = 0; i < 28; i++) {
+    journal.pop();
+  }
+  for (uint16_t i = 31; i <= 34; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  JournalRecord batch[16];
+  ASSERT_EQ(journal.peekBatch(batch, 16), 6u);
+  for (uint16_t i = 0; i < 6; i++) {
+    EXPECT_EQ(batch[i].shotNumber, i + 29);
+  }
+}
+
+TEST(ShotJournalBatch, PeekBatchStopsAtTheEndOfASpillBlock) {
+  MemorySpillStore spill(1024);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(32, &spill));
+  for (uint16_t i = 1; i <= 40; i++) {
+    journal.append(makeShot(1, i));
+  }
+  for (int i = 0; i < 28; i++) {
+    journal.pop();
+  }
+
+  JournalRecord batch[16];
+  ASSERT_EQ(journal.peekBatch(batch, 16), 4u);   // Spilled shots 29..32
+  EXPECT_EQ(batch[3].shotNumber, 32u);
+  for (int i = 0; i < 4; i++) {
+    journal.pop();
+  }
+  ASSERT_EQ(journal.peekBatch(batch, 16), 8u);   // RAM shots 33..40
+  EXPECT_EQ(batch[0].shotNumber, 33u);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Sequence numbers
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShotJournalSequence, NumbersAreConsecutiveWithinASession) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  for (uint16_t i = 1; i <= 3; i++) {
+    journal.append(makeShot(7, i));
+  }
+
+  JournalRecord record;
+  for (uint32_t expected = 1; expected <= 3; expected++) {
+    ASSERT_TRUE(journal.peek(record));
+    EXPECT_EQ(record.seq, expected);
+    journal.pop();
+  }
+}
+
+TEST(ShotJournalSequence, NewSessionRestartsAtOne) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  journal.append(makeShot(7, 1));
+  journal.append(makeShot(7, 2));
+  journal.append(makeShot(8, 1));
+
+  JournalRecord record;
+  journal.pop();
+  journal.pop();
+  ASSERT_TRUE(journal.peek(record));
+  EXPECT_EQ(record.sessionId, 8u);
+  EXPECT_EQ(record.seq, 1u);
+}
+
+TEST(ShotJournalSequence, InterleavedLanesKeepTheirOwnSequence) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  NormalizedShotData laneTwo = makeShot(9, 1);
+  laneTwo.lane = 1;
+  journal.append(makeShot(7, 1));
+  journal.append(laneTwo);
+  journal.append(makeShot(7, 2));
+  laneTwo.shotNumber = 2;
+  journal.append(laneTwo);
+
+  const uint8_t lanes[] = {0, 1, 0, 1};
+  const uint32_t seqs[] = {1, 1, 2, 2};
+  JournalRecord record;
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(journal.peek(record));
+    EXPECT_EQ(record.lane, lanes[i]);
+    EXPECT_EQ(record.seq, seqs[i]);
+    NormalizedShotData shot;
+    ShotJournal::toShotData(record, shot);
+    EXPECT_EQ(shot.lane, lanes[i]);
+    journal.pop();
+  }
+}
+
+TEST(ShotJournalSequence, SequenceContinuesWhileShotsAreSpilled) {
+  MemorySpillStore spill(1024);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(32, &spill));
+  for (uint16_t i = 1; i <= 40; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  JournalRecord record;
+  for (uint32_t expected = 1; expected <= 40; expected++) {
+    ASSERT_TRUE(journal.peek(record));
+    EXPECT_EQ(record.seq, expected);
+    journal.pop();
+  }
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Spill and overflow
+// ═════════════════════════════════════════════════════════════════
+
+TEST(ShotJournalSpill, FullRingSpillsOldestBlock) {
+  MemorySpillStore spill(1024);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, &spill));
+  for (uint16_t i = 1; i <= 65; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  EXPECT_EQ(spill.count(), ShotJournal::SPILL_BLOCK);
+  EXPECT_EQ(spill.records.front().shotNumber, 1u);
+  EXPECT_EQ(journal.ramCount(), 65u - ShotJournal::SPILL_BLOCK);
+  EXPECT_EQ(journal.pending(), 65u);
+  EXPECT_EQ(journal.getStats().spilled, ShotJournal::SPILL_BLOCK);
+}
+
+TEST(ShotJournalSpill, SpilledRecordsLoseTheirTraceOrigin) {
+  MemorySpillStore spill(1024);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(32, &spill));
+  for (uint16_t i = 1; i <= 33; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  for (const JournalRecord& r : spill.records) {
+    EXPECT_EQ(r.traceOriginUs, 0);
+  }
+}
+
+TEST(ShotJournalSpill, ReplayIsInAppendOrderAcrossSpillAndRam) {
+  MemorySpillStore spill(1024);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(48, &spill));
+  for (uint16_t i = 1; i <= 200; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  std::vector<uint16_t> order = drain(journal);
+  ASSERT_EQ(order.size(), 200u);
+  for (uint16_t i = 0; i < 200; i++) {
+    EXPECT_EQ(order[i], i + 1);
+  }
+  EXPECT_EQ(journal.pending(), 0u);
+  EXPECT_EQ(spill.count(), 0u);
+}
+
+TEST(ShotJournalSpill, WrappedRingSpillsInTwoSegments) {
+  MemorySpillStore spill(1024);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(40, &spill));
+
+  // Move the ring head so the next spilled block straddles the end
+  for (uint16_t i = 1; i <= 20; i++) {
+    journal.append(makeShot(1, i));
+  }
+  for (int i = 0; i < 20; i++) {
+    journal.pop();
+  }
+  for (uint16_t i = 21; i <= 61; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  EXPECT_EQ(spill.appendCalls, 2);
+  std::vector<uint16_t> order = drain(journal);
+  ASSERT_EQ(order.size(), 41u);
+  for (uint16_t i = 0; i < 41; i++) {
+    EXPECT_EQ(order[i], i + 21);
+  }
+}
+
+TEST(ShotJournalSpill, SpillIsConsumedOncePerBlock) {
+  MemorySpillStore spill(1024);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(32, &spill));
+  for (uint16_t i = 1; i <= 64; i++) {
+    journal.append(makeShot(1, i));
+  }
+  ASSERT_EQ(spill.count(), 32u);
+
+  JournalRecord record;
+  for (int i = 0; i < 31; i++) {
+    ASSERT_TRUE(journal.peek(record));
+    journal.pop();
+  }
+  EXPECT_EQ(spill.consumeCalls, 0);
+  EXPECT_EQ(journal.spillCount(), 1u);
+
+  ASSERT_TRUE(journal.peek(record));
+  journal.pop();
+  EXPECT_EQ(spill.consumeCalls, 1);
+  EXPECT_EQ(spill.count(), 0u);
+}
+
+TEST(ShotJournalSpill, WithoutSpillStoreOldestBlockIsDropped) {
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(64, nullptr));
+  for (uint16_t i = 1; i <= 65; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  EXPECT_EQ(journal.getStats().dropped, ShotJournal::SPILL_BLOCK);
+  JournalRecord record;
+  ASSERT_TRUE(journal.peek(record));
+  EXPECT_EQ(record.shotNumber, ShotJournal::SPILL_BLOCK + 1);
+}
+
+TEST(ShotJournalSpill, FullSpillStoreDropsInsteadOfGrowing) {
+  MemorySpillStore spill(32);
+  ShotJournal journal;
+  ASSERT_TRUE(journal.begin(32, &spill));
+  for (uint16_t i = 1; i <= 96; i++) {
+    journal.append(makeShot(1, i));
+  }
+
+  EXPECT_EQ(spill.count(), 32u);
+  EXPECT_EQ(journal.getStats().spilled, 32u);
+  EXPECT_EQ(journal.getStats().dropped, 32u);
+  EXPECT_EQ(journal.pending(), 64u);
+}
+
+TEST(ShotJournalSpill, RejectsRingSmallerThanOneBlock) {
+  ShotJournal journal;
+  EXPECT_FALSE(journal.begin(ShotJournal::SPILL_BLOCK - 1, nullptr));
+  EXPECT_FALSE(journal.isReady());
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  LittleFS spill store
+// ═════════════════════════════════════════════════════════════════
+
+class LittleFsSpillTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    Logger::setLevel(LogLevel::NONE);
+    LittleFSMock::reset();
+  }
+
+  void TearDown() override {
+    LittleFSMock::reset();
+  }
+
+  static std::vector<JournalRecord> makeRecords(uint32_t firstSeq, uint32_t n) {
+    std::vector<JournalRecord> records(n);
+    for (uint32_t i = 0; i < n; i++) {
+      memset(&records[i], 0, sizeof(JournalRecord));
+      records[i].sessionId = 7;
+      records[i].seq = firstSeq + i;
+      records[i].shotNumber = (uint16_t)(firstSeq + i);
+    }
+    return records;
+  }
+
+  static std::vector<uint32_t> readSeqs(LittleFsSpillStore& store) {
+    std::vector<JournalRecord> out(store.count());
+    uint32_t n = store.read(out.data(), (uint32_t)out.size());
+    std::vector<uint32_t> seqs;
+    for (uint32_t i = 0; i < n; i++) {
+      seqs.push_back(out[i].seq);
+    }
+    return seqs;
+  }
+};
+
+TEST_F(LittleFsSpillTest, UnconsumedRecordsSurviveAReset) {
+  {
+    LittleFsSpillStore store(4096);
+    ASSERT_TRUE(store.begin());
+    std::vector<JournalRecord> records = makeRecords(1, 4);
+    ASSERT_TRUE(store.append(records.data(), 4));
+    store.consume(1);
+  }
+
+  LittleFsSpillStore store(4096);
+  ASSERT_TRUE(store.begin());
+  EXPECT_EQ(readSeqs(store), (std::vector<uint32_t>{2, 3, 4}));
+}
+
+TEST_F(LittleFsSpillTest, ShortWriteCountsOnlyWholeRecords) {
+  LittleFsSpillStore store(4096);
+  ASSERT_TRUE(store.begin());
+  std::vector<JournalRecord> records = makeRecords(1, 1);
+  ASSERT_TRUE(store.append(records.data(), 1));
+
+  // Room for one and a half more records
+  LittleFSMock::writeBudget() = sizeof(JournalRecord) * 3 / 2;
+  records = makeRecords(2, 3);
+  EXPECT_FALSE(store.append(records.data(), 3));
+  EXPECT_EQ(store.count(), 2u);
+}
+
+TEST_F(LittleFsSpillTest, AppendAfterAShortWriteOverwritesTheTornRecord) {
+  LittleFsSpillStore store(4096);
+  ASSERT_TRUE(store.begin());
+  std::vector<JournalRecord> records = makeRecords(1, 2);
+  LittleFSMock::writeBudget() = sizeof(JournalRecord) * 3 / 2;
+  EXPECT_FALSE(store.append(records.data(), 2));
+
+  LittleFSMock::writeBudget() = SIZE_MAX;
+  records = makeRecords(2, 2);
+  ASSERT_TRUE(store.append(records.data(), 2));
+  EXPECT_EQ(readSeqs(store), (std::vector<uint32_t>{1, 2, 3}));
+
+  // The file ends on a record boundary, so a reset recovers the same records
+  LittleFsSpillStore recovered(4096);
+  ASSERT_TRUE(recovered.begin());
+  EXPECT_EQ(readSeqs(recovered), (std::vector<uint32_t>{1, 2, 3}));
+}
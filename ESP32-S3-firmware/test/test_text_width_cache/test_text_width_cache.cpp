@@ -0,0 +1,121 @@
+/**
+ * @file test_text_width_cache.cpp
+ * @brief Native tests for the measured text width cache.
+ *
+ * Tests TextWidthCache (header-only), which DisplayManager fills from
+ * u8g2 getUTF8Width() for marquee scroll decisions: keying by font and
+ * string hash, round-robin replacement and invalidation of edited text.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_text_width_cache
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include "TextWidthCache.h"
+
+// Distinct addresses standing in for u8g2 font tables
+static const uint8_t fontSmall[1] = { 0 };
+static const uint8_t fontLarge[1] = { 0 };
+
+// ═════════════════════════════════════════════════════════════════
+//  Hashing
+// ═════════════════════════════════════════════════════════════════
+
+TEST(TextWidthCacheHash, MatchesFnv1aReference) {
+  EXPECT_EQ(TextWidthCache::hash(""), 2166136261u);
+  EXPECT_EQ(TextWidthCache::hash("a"), 0xE40C292Cu);
+  EXPECT_EQ(TextWidthCache::hash("foobar"), 0xBF9CF968u);
+}
+
+TEST(TextWidthCacheHash, NullIsTreatedAsEmpty) {
+  EXPECT_EQ(TextWidthCache::hash(nullptr), TextWidthCache::hash(""));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Lookup / store
+// ═════════════════════════════════════════════════════════════════
+
+TEST(TextWidthCacheLookup, MissUntilStored) {
+  TextWidthCache cache;
+  uint32_t h = TextWidthCache::hash("J.K. PewPew Timer");
+  EXPECT_EQ(cache.lookup(fontLarge, h), TextWidthCache::MISS);
+
+  cache.store(fontLarge, h, 211);
+  EXPECT_EQ(cache.lookup(fontLarge, h), 211);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(TextWidthCacheLookup, SameTextDifferentFontIsSeparateEntry) {
+  TextWidthCache cache;
+  uint32_t h = TextWidthCache::hash("SG-SST4A12345");
+  cache.store(fontSmall, h, 98);
+  cache.store(fontLarge, h, 160);
+
+  EXPECT_EQ(cache.lookup(fontSmall, h), 98);
+  EXPECT_EQ(cache.lookup(fontLarge, h), 160);
+}
+
+TEST(TextWidthCacheLookup, StoringExistingKeyUpdatesInPlace) {
+  TextWidthCache cache;
+  uint32_t h = TextWidthCache::hash("abc");
+  cache.store(fontSmall, h, 10);
+  cache.store(fontSmall, h, 12);
+
+  EXPECT_EQ(cache.lookup(fontSmall, h), 12);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(TextWidthCacheLookup, OldestEntryIsReplacedWhenFull) {
+  TextWidthCache cache;
+  char text[16];
+  for (int i = 0; i <= TextWidthCache::CAPACITY; i++) {
+    snprintf(text, sizeof(text), "name-%d", i);
+    cache.store(fontSmall, TextWidthCache::hash(text), (int16_t)i);
+  }
+
+  EXPECT_EQ(cache.size(), TextWidthCache::CAPACITY);
+  EXPECT_EQ(cache.lookup(fontSmall, TextWidthCache::hash("name-0")), TextWidthCache::MISS);
+  EXPECT_EQ(cache.lookup(fontSmall, TextWidthCache::hash("name-1")), 1);
+  EXPECT_EQ(cache.lookup(fontSmall, TextWidthCache::hash("name-8")), 8);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Invalidation
+// ═════════════════════════════════════════════════════════════════
+
+TEST(TextWidthCacheInvalidate, EditedStartupTextIsRemeasured) {
+  TextWidthCache cache;
+  char startupText[41] = "J.K. PewPew Timer";
+
+  uint32_t oldHash = TextWidthCache::hash(startupText);
+  cache.store(fontLarge, oldHash, 211);
+
+  // Portal edits the buffer in place
+  snprintf(startupText, sizeof(startupText), "Range 3");
+  cache.invalidate(fontLarge, oldHash);
+
+  EXPECT_EQ(cache.lookup(fontLarge, oldHash), TextWidthCache::MISS);
+  EXPECT_EQ(cache.lookup(fontLarge, TextWidthCache::hash(startupText)), TextWidthCache::MISS);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(TextWidthCacheInvalidate, OnlyMatchingFontIsDropped) {
+  TextWidthCache cache;
+  uint32_t h = TextWidthCache::hash("READY");
+  cache.store(fontSmall, h, 50);
+  cache.store(fontLarge, h, 80);
+
+  cache.invalidate(fontLarge, h);
+  EXPECT_EQ(cache.lookup(fontSmall, h), 50);
+  EXPECT_EQ(cache.lookup(fontLarge, h), TextWidthCache::MISS);
+}
+
+TEST(TextWidthCacheInvalidate, ClearEmptiesEverything) {
+  TextWidthCache cache;
+  cache.store(fontSmall, 1, 1);
+  cache.store(fontLarge, 2, 2);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
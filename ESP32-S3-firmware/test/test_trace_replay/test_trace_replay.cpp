@@ -0,0 +1,836 @@
+/**
+ * @file test_trace_replay.cpp
+ * @brief Deterministic BLE trace replay through the full TimerApplication pipeline.
+ *
+ * A trace is a timestamped list of BLE notifications (plus link events)
+ * relative to the moment the timer connected. The replay engine runs the
+ * real application - scan, connect, BleIngestTask, parser, shot ring,
+ * ShotJournal, MqttManager and DisplayManager - against the host stubs on
+ * a virtual clock: whenever the main loop blocks, the clock jumps to the
+ * next trace event instead of waiting. A whole match replays in well under
+ * a second, and identical traces give identical reports.
+ *
+ * Trace CSV (one event per line, '#' starts a comment):
+ *   time_ms,device,sg-timer|special-pie|special-pie-f|asn   (time 0, first line)
+ *   time_ms,notify,<hex payload>
+ *   time_ms,mqtt,up|down        broker reachable / unreachable
+ *   time_ms,wifi,up|down        station link
+ *   time_ms,ble,up|down         timer in range / out of range (subscription lost)
+ *   time_ms,stall,<ms>          BLE ingest task held off for <ms>
+ *
+ * Set REPLAY_TRACE=<file.csv> to replay a field capture and print its report.
+ *
+ * Runner:  GoogleTest (native)
+ * Command: pio test -e native-tests --filter test_trace_replay
+ */
+
+// ── Standard headers FIRST (before access-specifier override) ───
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ── Override access specifiers so the harness can read pipeline counters ─
+#define private   public
+#define protected public
+
+// ── Include real source files (stubs resolve Arduino/BLE/WiFi/MQTT headers) ─
+#include "../../src/Logger.cpp"
+#include "../../src/SGTimer.cpp"
+#include "../../src/SpecialPieM1A2Plus.cpp"
+#include "../../src/SpecialPieM1A2F.cpp"
+#include "../../src/ASNTracker.cpp"
+#include "../../src/BleIngestTask.cpp"
+#include "../../src/TimerDeviceManager.cpp"
+#include "../../src/LoopScheduler.cpp"
+#include "../../src/ShotJournal.cpp"
+#include "../../src/LittleFsSpillStore.cpp"
+#include "../../src/ShadowFramebuffer.cpp"
+#include "../../src/GlyphAtlas.cpp"
+#include "../../src/DisplayManager.cpp"
+#include "../../src/MqttJsonPayload.cpp"
+#include "../../src/MqttBinaryPayload.cpp"
+#include "../../src/DeviceId.cpp"
+#include "../../src/WiFiConfig.cpp"
+#include "../../src/MqttManager.cpp"
+#include "../../src/TimerApplication.cpp"
+
+#undef private
+#undef protected
+
+// ═════════════════════════════════════════════════════════════════
+//  ShotTrace link seam (replaces src/ShotTrace.cpp)
+// ═════════════════════════════════════════════════════════════════
+//
+// Same histograms as the firmware, but reset() - called at every session
+// start - is ignored so the report covers the whole replay.
+
+LatencyHistogram ShotTrace::histograms[(size_t)TraceStage::COUNT];
+uint32_t ShotTrace::totalSamples = 0;
+
+void ShotTrace::record(TraceStage stage, int64_t originUs) {
+  if (originUs <= 0 || stage >= TraceStage::COUNT) {
+    return;
+  }
+  int64_t elapsed = nowUs() - originUs;
+  histograms[(size_t)stage].record(elapsed < 0 ? 0 : (uint32_t)elapsed);
+  totalSamples++;
+}
+
+ShotTrace::StageSummary ShotTrace::summarize(TraceStage stage) {
+  StageSummary summary;
+  const LatencyHistogram& h = histograms[(size_t)stage];
+  summary.count = h.count();
+  summary.minUs = h.min();
+  summary.avgUs = h.mean();
+  summary.p99Us = h.percentile(99);
+  summary.maxUs = h.max();
+  return summary;
+}
+
+uint32_t ShotTrace::getTotalSamples() { return totalSamples; }
+
+void ShotTrace::reset() {}
+
+void ShotTrace::logSummary() {}
+
+const char* ShotTrace::getStageName(TraceStage stage) {
+  static const char* const NAMES[(size_t)TraceStage::COUNT] = {
+    "parsed", "dequeued", "rendered", "mqtt", "loraTx"
+  };
+  return stage < TraceStage::COUNT ? NAMES[(size_t)stage] : "unknown";
+}
+
+static void clearShotTrace() {
+  for (LatencyHistogram& h : ShotTrace::histograms) {
+    h.reset();
+  }
+  ShotTrace::totalSamples = 0;
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Trace format
+// ═════════════════════════════════════════════════════════════════
+
+enum class TraceEventKind { NOTIFY, MQTT, WIFI, BLE, STALL };
+
+struct TraceEvent {
+  uint32_t atMs = 0;             // Relative to the timer connection
+  TraceEventKind kind = TraceEventKind::NOTIFY;
+  std::vector<uint8_t> payload;  // NOTIFY
+  uint32_t value = 0;            // MQTT/WIFI/BLE: 1 = up; STALL: duration (ms)
+
+  bool operator==(const TraceEvent& other) const {
+    return atMs == other.atMs && kind == other.kind && payload == other.payload &&
+           value == other.value;
+  }
+};
+
+struct Trace {
+  std::string device = "sg-timer";
+  std::vector<TraceEvent> events;
+
+  void add(uint32_t atMs, TraceEventKind kind, uint32_t value = 0,
+           std::vector<uint8_t> payload = std::vector<uint8_t>()) {
+    TraceEvent e;
+    e.atMs = atMs;
+    e.kind = kind;
+    e.value = value;
+    e.payload = payload;
+    events.push_back(e);
+  }
+
+  void notify(uint32_t atMs, std::vector<uint8_t> payload) {
+    add(atMs, TraceEventKind::NOTIFY, 0, payload);
+  }
+
+  // Events added out of order keep their relative order at equal times
+  void sort() {
+    std::stable_sort(events.begin(), events.end(),
+                     [](const TraceEvent& a, const TraceEvent& b) { return a.atMs < b.atMs; });
+  }
+
+  uint32_t durationMs() const { return events.empty() ? 0 : events.back().atMs; }
+
+  std::string toCsv() const {
+    std::ostringstream out;
+    out << "# time_ms,event,arg\n";
+    out << "0,device," << device << "\n";
+    for (const TraceEvent& e : events) {
+      out << e.atMs << ",";
+      switch (e.kind) {
+        case TraceEventKind::NOTIFY: {
+          out << "notify,";
+          char hex[3];
+          for (uint8_t b : e.payload) {
+            snprintf(hex, sizeof(hex), "%02X", b);
+            out << hex;
+          }
+          break;
+        }
+        case TraceEventKind::MQTT:  out << "mqtt," << (e.value ? "up" : "down"); break;
+        case TraceEventKind::WIFI:  out << "wifi," << (e.value ? "up" : "down"); break;
+        case TraceEventKind::BLE:   out << "ble," << (e.value ? "up" : "down"); break;
+        case TraceEventKind::STALL: out << "stall," << e.value; break;
+      }
+      out << "\n";
+    }
+    return out.str();
+  }
+
+  // Returns false with a "line N: ..." message on malformed input
+  static bool parse(const std::string& text, Trace& trace, std::string& error) {
+    trace = Trace();
+    std::istringstream in(text);
+    std::string line;
+    int lineNo = 0;
+    uint32_t lastMs = 0;
+
+    while (std::getline(in, line)) {
+      lineNo++;
+      size_t comment = line.find('#');
+      if (comment != std::string::npos) line.erase(comment);
+      line.erase(std::remove_if(line.begin(), line.end(),
+                                [](char c) { return c == ' ' || c == '\t' || c == '\r'; }),
+                 line.end());
+      if (line.empty()) continue;
+
+      size_t c1 = line.find(',');
+      size_t c2 = c1 == std::string::npos ? c1 : line.find(',', c1 + 1);
+      if (c2 == std::string::npos) {
+        error = "line " + std::to_string(lineNo) + ": expected time_ms,event,arg";
+        return false;
+      }
+      std::string time = line.substr(0, c1);
+      std::string event = line.substr(c1 + 1, c2 - c1 - 1);
+      std::string arg = line.substr(c2 + 1);
+
+      char* end = nullptr;
+      unsigned long atMs = strtoul(time.c_str(), &end, 10);
+      if (time.empty() || *end != '\0' || atMs < lastMs) {
+        error = "line " + std::to_string(lineNo) + ": bad or decreasing time '" + time + "'";
+        return false;
+      }
+      lastMs = (uint32_t)atMs;
+
+      bool ok = true;
+      if (event == "device") {
+        trace.device = arg;
+      } else if (event == "notify") {
+        std::vector<uint8_t> payload;
+        ok = arg.size() % 2 == 0 && !arg.empty();
+        for (size_t i = 0; ok && i < arg.size(); i += 2) {
+          char byte[3] = {arg[i], arg[i + 1], '\0'};
+          char* hexEnd = nullptr;
+          payload.push_back((uint8_t)strtoul(byte, &hexEnd, 16));
+          ok = *hexEnd == '\0';
+        }
+        trace.notify((uint32_t)atMs, payload);
+      } else if (event == "mqtt" || event == "wifi" || event == "ble") {
+        ok = arg == "up" || arg == "down";
+        TraceEventKind kind = event == "mqtt" ? TraceEventKind::MQTT :
+                              event == "wifi" ? TraceEventKind::WIFI : TraceEventKind::BLE;
+        trace.add((uint32_t)atMs, kind, arg == "up" ? 1 : 0);
+      } else if (event == "stall") {
+        unsigned long ms = strtoul(arg.c_str(), &end, 10);
+        ok = !arg.empty() && *end == '\0';
+        trace.add((uint32_t)atMs, TraceEventKind::STALL, (uint32_t)ms);
+      } else {
+        ok = false;
+      }
+
+      if (!ok) {
+        error = "line " + std::to_string(lineNo) + ": bad event '" + event + "," + arg + "'";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static bool load(const std::string& path, Trace& trace, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+      error = "cannot open " + path;
+      return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return parse(text.str(), trace, error);
+  }
+
+  bool save(const std::string& path) const {
+    std::ofstream file(path);
+    file << toCsv();
+    return (bool)file;
+  }
+};
+
+// ═════════════════════════════════════════════════════════════════
+//  Synthetic matches
+// ═════════════════════════════════════════════════════════════════
+
+struct MatchPlan {
+  std::string device = "sg-timer";
+  int strings = 10;
+  int shotsPerString = 20;
+  uint32_t firstEventMs = 2000;  // After the connection
+  uint32_t drawMs = 1500;        // Beep to first shot
+  uint32_t minSplitMs = 150;
+  uint32_t maxSplitMs = 450;
+  uint32_t gapMs = 30000;        // Stop to next string's start
+};
+
+// Deterministic splits (LCG) so every run of a plan is the same trace
+static Trace makeMatch(const MatchPlan& plan) {
+  Trace trace;
+  trace.device = plan.device;
+  uint32_t seed = 12345;
+  auto nextSplit = [&]() {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t span = plan.maxSplitMs - plan.minSplitMs + 1;
+    return plan.minSplitMs + (seed >> 16) % span;
+  };
+
+  const bool sg = plan.device == "sg-timer";
+  uint32_t t = plan.firstEventMs;
+  for (int s = 0; s < plan.strings; s++) {
+    uint32_t sessionId = 100000 + s;
+    uint8_t id[4] = {(uint8_t)(sessionId >> 24), (uint8_t)(sessionId >> 16),
+                     (uint8_t)(sessionId >> 8), (uint8_t)sessionId};
+
+    // SG Timer: 3.0 s start delay then SESSION_SET_BEGIN; Special Pie starts on the beep
+    uint32_t beep = t;
+    if (sg) {
+      trace.notify(t, {0x07, 0x00, id[0], id[1], id[2], id[3], 0x00, 0x1E});
+      beep = t + 3000;
+      trace.notify(beep, {0x05, 0x05, id[0], id[1], id[2], id[3]});
+    } else {
+      trace.notify(t, {0xF8, 0xF9, 0x34, (uint8_t)s, 0x00, 0x00, 0xF9, 0xF8});
+    }
+
+    uint32_t shotMs = plan.drawMs;
+    for (int n = 0; n < plan.shotsPerString; n++) {
+      if (n > 0) shotMs += nextSplit();
+      if (sg) {
+        trace.notify(beep + shotMs, {0x0B, 0x04, id[0], id[1], id[2], id[3],
+                                     (uint8_t)(n >> 8), (uint8_t)n,
+                                     (uint8_t)(shotMs >> 24), (uint8_t)(shotMs >> 16),
+                                     (uint8_t)(shotMs >> 8), (uint8_t)shotMs});
+      } else {
+        trace.notify(beep + shotMs, {0xF8, 0xF9, 0x36, 0x00, (uint8_t)(shotMs / 1000),
+                                     (uint8_t)(shotMs % 1000 / 10), (uint8_t)n, 0x00,
+                                     0xF9, 0xF8});
+      }
+    }
+
+    uint32_t stop = beep + shotMs + 2000;
+    if (sg) {
+      trace.notify(stop, {0x07, 0x03, id[0], id[1], id[2], id[3],
+                          (uint8_t)(plan.shotsPerString >> 8), (uint8_t)plan.shotsPerString});
+    } else {
+      trace.notify(stop, {0xF8, 0xF9, 0x18, (uint8_t)s, 0x00, 0x00, 0xF9, 0xF8});
+    }
+    t = stop + plan.gapMs;
+  }
+  return trace;
+}
+
+// Time (relative to the connection) of shot `shot` (0-based) in string `string`
+static uint32_t shotTime(const Trace& trace, int string, int shot) {
+  int strings = -1;
+  int shots = 0;
+  for (const TraceEvent& e : trace.events) {
+    if (e.kind != TraceEventKind::NOTIFY || e.payload.size() < 2) continue;
+    bool start = e.payload[1] == 0x00 || (e.payload[0] == 0xF8 && e.payload[2] == 0x34);
+    bool isShot = e.payload[1] == 0x04 || (e.payload[0] == 0xF8 && e.payload[2] == 0x36);
+    if (start) {
+      strings++;
+      shots = 0;
+    } else if (isShot && strings == string && shots++ == shot) {
+      return e.atMs;
+    }
+  }
+  return 0;
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Replay engine
+// ═════════════════════════════════════════════════════════════════
+
+struct ReplayReport {
+  bool connected = false;
+  uint32_t notifications = 0;      // Delivered to the subscribed notify callback
+  uint32_t notificationsLost = 0;  // Timer out of range / not subscribed
+  uint32_t ingestProcessed = 0;
+  uint32_t ingestDropped = 0;      // BleIngestTask ring full (or stale device)
+  uint32_t shotsParsed = 0;
+  uint32_t shotsQueued = 0;
+  uint32_t ringDrops = 0;          // Shot ring full
+  uint32_t shotsPublished = 0;
+  uint32_t journalDropped = 0;
+  uint32_t journalPending = 0;
+  uint32_t mqttMessages = 0;
+  uint32_t shotMessages = 0;       // shot/detected
+  uint32_t batchMessages = 0;      // shot/batch
+  uint32_t loopIterations = 0;
+  ShotTrace::StageSummary stages[(size_t)TraceStage::COUNT];
+  unsigned long virtualMs = 0;     // Connection to end of the drain period
+  double wallMs = 0;
+
+  // Everything but wall time - identical traces must give identical strings
+  std::string toString() const {
+    std::ostringstream out;
+    char line[160];
+    out << "connected       : " << (connected ? "yes" : "no") << "\n";
+    out << "notifications   : " << notifications << " delivered, " << notificationsLost << " lost\n";
+    out << "ble ingest      : " << ingestProcessed << " processed, " << ingestDropped << " dropped\n";
+    out << "shots           : " << shotsParsed << " parsed, " << shotsQueued << " queued, "
+        << ringDrops << " ring drops, " << shotsPublished << " published\n";
+    out << "journal         : " << journalDropped << " dropped, " << journalPending << " pending\n";
+    out << "mqtt            : " << mqttMessages << " messages (" << shotMessages
+        << " shot/detected, " << batchMessages << " shot/batch)\n";
+    out << "main loop       : " << loopIterations << " iterations\n";
+    for (size_t i = 0; i < (size_t)TraceStage::COUNT; i++) {
+      const ShotTrace::StageSummary& s = stages[i];
+      if (s.count == 0) continue;
+      snprintf(line, sizeof(line),
+               "latency %-8s: n=%-4lu min=%.3f avg=%.3f p99=%.3f max=%.3f ms\n",
+               ShotTrace::getStageName((TraceStage)i), (unsigned long)s.count,
+               s.minUs / 1000.0, s.avgUs / 1000.0, s.p99Us / 1000.0, s.maxUs / 1000.0);
+      out << line;
+    }
+    snprintf(line, sizeof(line), "virtual time    : %.1f s\n", virtualMs / 1000.0);
+    out << line;
+    return out.str();
+  }
+};
+
+class TraceReplay {
+public:
+  static constexpr unsigned long CONNECT_TIMEOUT_MS = 60000;  // Startup + scan + connect
+  static constexpr unsigned long DRAIN_MS = 10000;            // After the last event
+  static constexpr uint32_t MAX_IDLE_PASSES = 10000;          // Loop passes without clock progress
+
+  ReplayReport run(const Trace& trace) {
+    ReplayReport report;
+    resetWorld();
+    if (!advertise(trace.device)) {
+      ADD_FAILURE() << "unknown device '" << trace.device << "'";
+      return report;
+    }
+
+    events = &trace.events;
+    next = 0;
+    started = false;
+    originMs = 0;
+    stallUntil = 0;
+    out = &report;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    {
+      TimerApplication timerApp;
+      app = &timerApp;
+      ArduinoMock::sleepHook() = [this](unsigned long ms, const std::function<bool()>& woken) {
+        sleep(ms, woken);
+      };
+
+      deviceId.initialize();
+      EXPECT_TRUE(timerApp.initialize());
+
+      // Trace time 0 = notifications subscribed
+      while (!BLEMock::notifyCallback() && millis() < CONNECT_TIMEOUT_MS) {
+        timerApp.run();
+      }
+      report.connected = BLEMock::notifyCallback() != nullptr;
+      started = true;
+      originMs = millis();
+
+      const unsigned long endMs = originMs + trace.durationMs() + DRAIN_MS;
+      unsigned long lastMs = millis();
+      uint32_t idlePasses = 0;
+      while (report.connected && (next < events->size() || millis() < endMs)) {
+        timerApp.run();
+        report.loopIterations++;
+        idlePasses = millis() == lastMs ? idlePasses + 1 : 0;
+        lastMs = millis();
+        if (idlePasses > MAX_IDLE_PASSES) {
+          ADD_FAILURE() << "main loop spinning at " << millis() << " ms";
+          break;
+        }
+      }
+
+      collect(timerApp, report);
+      ArduinoMock::sleepHook() = nullptr;
+      app = nullptr;
+    }
+    report.wallMs = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - wallStart).count();
+    return report;
+  }
+
+private:
+  TimerApplication* app = nullptr;
+  const std::vector<TraceEvent>* events = nullptr;
+  size_t next = 0;
+  bool started = false;
+  unsigned long originMs = 0;
+  unsigned long stallUntil = 0;
+  ReplayReport* out = nullptr;
+
+  static void resetWorld() {
+    ArduinoMock::resetMillis();
+    ArduinoMock::sleepHook() = nullptr;
+    FreeRtosMock::reset();
+    BLEMock::reset();
+    PubSubMock::reset();
+    WiFiMock::connected() = true;
+    LittleFSMock::reset();
+    PreferencesMock::reset();
+    PreferencesMock::set("wifi-config", "mqtt_server", "192.168.1.10");
+    clearShotTrace();
+  }
+
+  static bool advertise(const std::string& device) {
+    BLEAdvertisedDevice peer;
+    peer.setAddress("C4:4F:33:12:34:56");
+    const char* service = nullptr;
+    if (device == "sg-timer") {
+      peer.setName("SG-SST4A12345");
+      service = SGTimer::SERVICE_UUID;
+    } else if (device == "special-pie") {
+      peer.setName("SPTimer");
+      service = SpecialPieM1A2Plus::SERVICE_UUID;
+    } else if (device == "special-pie-f") {
+      peer.setName("SP M1A2 Timer 2196");
+      BLEMock::services().push_back(SpecialPieM1A2F::SERVICE_UUID);
+      BLEMock::advertised().push_back(peer);
+      return true;
+    } else if (device == "asn") {
+      peer.setName("ASN Tracker");
+      service = ASNTracker::SERVICE_UUID;
+    } else {
+      return false;
+    }
+    peer.setServiceUUID(service);
+    BLEMock::services().push_back(service);
+    BLEMock::advertised().push_back(peer);
+    return true;
+  }
+
+  // Blocking call on the main task: jump the clock from event to event until
+  // the wait is satisfied (`woken`) or times out
+  void sleep(unsigned long ms, const std::function<bool()>& woken) {
+    const unsigned long deadline = millis() + ms;
+    for (;;) {
+      deliverDue();
+      if (woken && woken()) {
+        return;
+      }
+      unsigned long due = nextDueMs();
+      if (due >= deadline) {
+        ArduinoMock::setMillis(deadline);
+        deliverDue();
+        return;
+      }
+      ArduinoMock::setMillis(due);
+    }
+  }
+
+  unsigned long nextDueMs() const {
+    unsigned long due = ULONG_MAX;
+    if (started && next < events->size()) {
+      due = originMs + (*events)[next].atMs;
+    }
+    if (stallUntil > millis() && stallUntil < due) {
+      due = stallUntil;
+    }
+    return due;
+  }
+
+  void deliverDue() {
+    while (started && next < events->size() && originMs + (*events)[next].atMs <= millis()) {
+      deliver((*events)[next++]);
+    }
+    runIngestTask();
+  }
+
+  void deliver(const TraceEvent& e) {
+    switch (e.kind) {
+      case TraceEventKind::NOTIFY:
+        // BLE stack task: the device's notify callback copies into the ingest ring
+        if (BLEMock::notify(e.payload.data(), e.payload.size())) {
+          out->notifications++;
+        } else {
+          out->notificationsLost++;
+        }
+        runIngestTask();
+        break;
+      case TraceEventKind::MQTT:
+        PubSubMock::brokerUp() = e.value != 0;
+        break;
+      case TraceEventKind::WIFI:
+        WiFiMock::connected() = e.value != 0;
+        break;
+      case TraceEventKind::BLE:
+        BLEMock::inRange() = e.value != 0;
+        if (!e.value) {
+          BLEMock::notifyCallback() = nullptr;  // Subscription ends with the link
+        }
+        break;
+      case TraceEventKind::STALL:
+        stallUntil = millis() + e.value;
+        break;
+    }
+  }
+
+  // The ingest task outranks the main loop: it runs as soon as it is woken,
+  // unless a stall event is holding it off
+  void runIngestTask() {
+    if (!app || !app->bleIngest || millis() < stallUntil) {
+      return;
+    }
+    if (FreeRtosMock::takeNotifications(app->bleIngest->taskHandle) > 0) {
+      app->bleIngest->drain();
+    }
+  }
+
+  void collect(TimerApplication& timerApp, ReplayReport& report) const {
+    if (timerApp.bleIngest) {
+      report.ingestProcessed = timerApp.bleIngest->getProcessedCount();
+      report.ingestDropped = timerApp.bleIngest->getDroppedCount();
+    }
+    for (size_t i = 0; i < (size_t)TraceStage::COUNT; i++) {
+      report.stages[i] = ShotTrace::summarize((TraceStage)i);
+    }
+    report.shotsParsed = report.stages[(size_t)TraceStage::PARSED].count;
+    report.shotsQueued = timerApp.totalShotsQueued;
+    report.ringDrops = report.shotsParsed - report.shotsQueued;
+    report.shotsPublished = timerApp.totalShotsPublished;
+    report.journalDropped = timerApp.journal.getStats().dropped;
+    report.journalPending = timerApp.journal.pending();
+
+    for (const PubSubMock::Message& m : PubSubMock::published()) {
+      report.mqttMessages++;
+      if (m.topic.find("/shot/detected") != std::string::npos) report.shotMessages++;
+      if (m.topic.find("/shot/batch") != std::string::npos) report.batchMessages++;
+    }
+    report.virtualMs = millis() - originMs;
+  }
+};
+
+// ═════════════════════════════════════════════════════════════════
+//  Fixture
+// ═════════════════════════════════════════════════════════════════
+
+class TraceReplayTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    Logger::setLevel(LogLevel::NONE);  // Suppress log noise
+  }
+
+  void TearDown() override {
+    ArduinoMock::sleepHook() = nullptr;
+    ArduinoMock::resetMillis();
+  }
+
+  ReplayReport replay(const Trace& trace) {
+    ReplayReport report = TraceReplay().run(trace);
+    std::cout << report.toString();
+    printf("wall time       : %.1f ms (%.0fx real time)\n", report.wallMs,
+           report.wallMs > 0 ? report.virtualMs / report.wallMs : 0.0);
+    return report;
+  }
+
+  static const ShotTrace::StageSummary& stage(const ReplayReport& r, TraceStage s) {
+    return r.stages[(size_t)s];
+  }
+};
+
+// ═════════════════════════════════════════════════════════════════
+//  Trace format
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(TraceReplayTest, CsvRoundTripsEveryEventKind) {
+  Trace trace = makeMatch(MatchPlan());
+  trace.add(5000, TraceEventKind::MQTT, 0);
+  trace.add(6000, TraceEventKind::WIFI, 1);
+  trace.add(7000, TraceEventKind::BLE, 0);
+  trace.add(8000, TraceEventKind::STALL, 250);
+  trace.sort();
+
+  Trace parsed;
+  std::string error;
+  ASSERT_TRUE(Trace::parse(trace.toCsv(), parsed, error)) << error;
+  EXPECT_EQ(parsed.device, trace.device);
+  EXPECT_TRUE(parsed.events == trace.events);
+}
+
+TEST_F(TraceReplayTest, SaveAndLoadFile) {
+  Trace trace = makeMatch(MatchPlan());
+  std::string path = ::testing::TempDir() + "trace_replay_roundtrip.csv";
+  ASSERT_TRUE(trace.save(path));
+
+  Trace loaded;
+  std::string error;
+  ASSERT_TRUE(Trace::load(path, loaded, error)) << error;
+  EXPECT_TRUE(loaded.events == trace.events);
+  std::remove(path.c_str());
+}
+
+TEST_F(TraceReplayTest, ParseSkipsCommentsAndBlankLines) {
+  Trace trace;
+  std::string error;
+  ASSERT_TRUE(Trace::parse("# field capture\n\n0,device,asn\n"
+                           "100, notify, F8F9340100 00F9F8  # start\n"
+                           "200,mqtt,down\n", trace, error)) << error;
+  EXPECT_EQ(trace.device, "asn");
+  ASSERT_EQ(trace.events.size(), 2u);
+  EXPECT_EQ(trace.events[0].payload.size(), 8u);
+  EXPECT_EQ(trace.events[1].kind, TraceEventKind::MQTT);
+}
+
+TEST_F(TraceReplayTest, ParseRejectsMalformedLinesWithLineNumber) {
+  Trace trace;
+  std::string error;
+  EXPECT_FALSE(Trace::parse("0,device,sg-timer\n10,notify,0G\n", trace, error));
+  EXPECT_NE(error.find("line 2"), std::string::npos) << error;
+  EXPECT_FALSE(Trace::parse("100,mqtt,up\n50,mqtt,down\n", trace, error));
+  EXPECT_NE(error.find("decreasing"), std::string::npos) << error;
+  EXPECT_FALSE(Trace::parse("10,teleport,now\n", trace, error));
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Pipeline replay
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(TraceReplayTest, CleanMatchPublishesEveryShotFasterThanRealTime) {
+  ReplayReport r = replay(makeMatch(MatchPlan()));  // 10 strings x 20 shots
+
+  ASSERT_TRUE(r.connected);
+  EXPECT_EQ(r.notificationsLost, 0u);
+  EXPECT_EQ(r.ingestDropped, 0u);
+  EXPECT_EQ(r.ingestProcessed, r.notifications);
+  EXPECT_EQ(r.shotsParsed, 200u);
+  EXPECT_EQ(r.shotsQueued, 200u);
+  EXPECT_EQ(r.ringDrops, 0u);
+  EXPECT_EQ(r.shotsPublished, 200u);
+  EXPECT_EQ(r.journalDropped, 0u);
+  EXPECT_EQ(r.journalPending, 0u);
+  EXPECT_GT(r.shotMessages + r.batchMessages, 0u);
+  if (AppConfig::SHOT_BATCH_MAX_LATENCY_MS == 0) {
+    // Default build: every shot on shot/detected, the topic the PWA display reads
+    EXPECT_EQ(r.shotMessages, 200u);
+    EXPECT_EQ(r.batchMessages, 0u);
+  }
+
+  // Every shot reaches every stage; the journal batch window bounds MQTT latency
+  EXPECT_EQ(stage(r, TraceStage::DEQUEUED).count, 200u);
+  EXPECT_EQ(stage(r, TraceStage::MQTT_PUBLISHED).count, 200u);
+  EXPECT_GT(stage(r, TraceStage::RENDERED).count, 0u);
+  EXPECT_LE(stage(r, TraceStage::MQTT_PUBLISHED).maxUs,
+            (AppConfig::SHOT_BATCH_MAX_LATENCY_MS + MAIN_LOOP_IDLE_MAX_WAIT) * 1000);
+
+  EXPECT_GT(r.virtualMs, 300000u);
+  EXPECT_LT(r.wallMs, (double)r.virtualMs);
+}
+
+TEST_F(TraceReplayTest, ReplayIsDeterministic) {
+  Trace trace = makeMatch(MatchPlan());
+  std::string first = TraceReplay().run(trace).toString();
+  std::string second = TraceReplay().run(trace).toString();
+  EXPECT_EQ(first, second);
+}
+
+TEST_F(TraceReplayTest, SpecialPieMatch) {
+  MatchPlan plan;
+  plan.device = "special-pie";
+  plan.strings = 3;
+  ReplayReport r = replay(makeMatch(plan));
+
+  ASSERT_TRUE(r.connected);
+  EXPECT_EQ(r.shotsParsed, 60u);
+  EXPECT_EQ(r.shotsPublished, 60u);
+  EXPECT_EQ(r.journalPending, 0u);
+}
+
+TEST_F(TraceReplayTest, MqttOutageIsJournaledAndReplayed) {
+  Trace trace = makeMatch(MatchPlan());
+  trace.add(shotTime(trace, 2, 0) - 5000, TraceEventKind::MQTT, 0);
+  trace.add(shotTime(trace, 6, 0) - 5000, TraceEventKind::MQTT, 1);
+  trace.sort();
+  ReplayReport r = replay(trace);
+
+  ASSERT_TRUE(r.connected);
+  EXPECT_EQ(r.shotsParsed, 200u);
+  EXPECT_EQ(r.ringDrops, 0u);
+  EXPECT_EQ(r.shotsPublished, 200u);
+  EXPECT_EQ(r.journalDropped, 0u);
+  EXPECT_EQ(r.journalPending, 0u);
+  // Shots held through the outage are not traced to MQTT
+  EXPECT_LT(stage(r, TraceStage::MQTT_PUBLISHED).count, 200u);
+}
+
+TEST_F(TraceReplayTest, IngestStallDuringBurstDropsAndReports) {
+  MatchPlan plan;
+  plan.strings = 1;
+  plan.shotsPerString = 30;
+  plan.minSplitMs = 10;
+  plan.maxSplitMs = 10;
+  Trace trace = makeMatch(plan);
+  trace.add(shotTime(trace, 0, 0) - 1, TraceEventKind::STALL, 1000);
+  trace.sort();
+  ReplayReport r = replay(trace);
+
+  ASSERT_TRUE(r.connected);
+  EXPECT_EQ(r.ingestDropped, (uint32_t)(30 - (BleIngestTask::RING_SIZE - 1)));
+  EXPECT_EQ(r.ingestProcessed + r.ingestDropped, r.notifications);
+  EXPECT_EQ(r.shotsParsed, (uint32_t)(BleIngestTask::RING_SIZE - 1));
+  EXPECT_EQ(r.shotsPublished, r.shotsParsed);
+  // The held-off shots waited out the stall before parsing
+  EXPECT_GE(stage(r, TraceStage::PARSED).maxUs, 800000u);
+}
+
+TEST_F(TraceReplayTest, TimerDropoutLosesNotificationsThenReconnects) {
+  Trace trace = makeMatch(MatchPlan());
+  uint32_t down = shotTime(trace, 4, 9) + 1;  // After the 10th shot of string 5
+  trace.add(down, TraceEventKind::BLE, 0);
+  trace.add(down + 8000, TraceEventKind::BLE, 1);
+  trace.sort();
+  ReplayReport r = replay(trace);
+
+  ASSERT_TRUE(r.connected);
+  EXPECT_EQ(r.notificationsLost, 11u);  // 10 shots + stop
+  EXPECT_EQ(r.shotsParsed, 190u);
+  EXPECT_EQ(r.shotsPublished, 190u);
+  EXPECT_EQ(r.journalPending, 0u);
+}
+
+// ═════════════════════════════════════════════════════════════════
+//  Field captures
+// ═════════════════════════════════════════════════════════════════
+
+TEST_F(TraceReplayTest, ReplayCaptureFromEnvironment) {
+  const char* path = getenv("REPLAY_TRACE");
+  if (!path || !*path) {
+    GTEST_SKIP() << "set REPLAY_TRACE=<capture.csv> to replay a field trace";
+  }
+
+  Trace trace;
+  std::string error;
+  ASSERT_TRUE(Trace::load(path, trace, error)) << error;
+  ReplayReport r = replay(trace);
+
+  ASSERT_TRUE(r.connected);
+  EXPECT_EQ(r.journalPending, 0u);
+}
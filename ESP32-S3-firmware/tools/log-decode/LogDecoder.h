@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "LogFormat.h"
+
+/**
+ * @brief Host-side decoder for LOG_BINARY_OUTPUT serial captures
+ *
+ * The firmware writes each log call as a binary frame (see LogFormat.h)
+ * holding the addresses of its component and format string literals and
+ * the raw arguments. The decoder looks those addresses up in the firmware
+ * ELF, rebuilds the message with the same LogFormat code the device uses
+ * for text output, and prints the line the text build would have printed.
+ * Bytes outside frames (boot ROM, ESP-IDF logs) pass through unchanged.
+ */
+namespace LogDecode {
+
+// Firmware address -> NUL-terminated string
+class StringTable {
+public:
+  virtual ~StringTable() {}
+  virtual const char* lookup(uint32_t address) const = 0;
+};
+
+// Loaded sections of a 32-bit little-endian ELF (ESP32 firmware image)
+class ElfImage : public StringTable {
+public:
+  bool load(std::vector<uint8_t> bytes) {
+    image.swap(bytes);
+    sections.clear();
+    if (image.size() < 0x34 || memcmp(image.data(), "\x7F" "ELF", 4) != 0 ||
+        image[4] != 1 /* ELFCLASS32 */ || image[5] != 1 /* little-endian */) {
+      return false;
+    }
+
+    uint32_t shoff = LogFormat::getU32(&image[0x20]);
+    uint16_t shentsize = get16(0x2E);
+    uint16_t shnum = get16(0x30);
+    if (shentsize < 0x28 || shoff + (uint64_t)shnum * shentsize > image.size()) {
+      return false;
+    }
+
+    for (uint16_t i = 0; i < shnum; i++) {
+      const uint8_t* header = &image[shoff + (size_t)i * shentsize];
+      uint32_t type = LogFormat::getU32(header + 4);
+      uint32_t flags = LogFormat::getU32(header + 8);
+      Section section;
+      section.address = LogFormat::getU32(header + 12);
+      section.offset = LogFormat::getU32(header + 16);
+      section.size = LogFormat::getU32(header + 20);
+      // SHF_ALLOC sections with file contents (not SHT_NOBITS)
+      if ((flags & 0x2) && type != 8 && section.address != 0 &&
+          (uint64_t)section.offset + section.size <= image.size()) {
+        sections.push_back(section);
+      }
+    }
+    return !sections.empty();
+  }
+
+  bool loadFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+      return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[65536];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    fclose(file);
+    return load(std::move(bytes));
+  }
+
+  const char* lookup(uint32_t address) const override {
+    for (const Section& section : sections) {
+      if (address >= section.address && address - section.address < section.size) {
+        const char* text = (const char*)&image[section.offset + (address - section.address)];
+        size_t room = section.size - (address - section.address);
+        return memchr(text, '\0', room) ? text : nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t sectionCount() const { return sections.size(); }
+
+private:
+  struct Section {
+    uint32_t address;
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  std::vector<uint8_t> image;
+  std::vector<Section> sections;
+
+  uint16_t get16(size_t offset) const {
+    return (uint16_t)(image[offset] | (image[offset + 1] << 8));
+  }
+};
+
+class Decoder {
+public:
+  static constexpr size_t MESSAGE_SIZE = 256;  // Same limit as the device's text output
+
+  struct Stats {
+    uint32_t frames;
+    uint32_t badFrames;       // Checksum or layout errors
+    uint32_t unknownStrings;  // Address not in the ELF (stale or wrong image)
+  };
+
+  explicit Decoder(const StringTable& strings) : strings(strings), state(State::TEXT), stats() {}
+
+  // Feeds captured bytes; decoded lines and pass-through text are appended to out
+  void feed(const uint8_t* data, size_t length, std::string& out) {
+    for (size_t i = 0; i < length; i++) {
+      step(data[i], out);
+    }
+  }
+
+  // One frame body -> log line (no newline); false if the body is malformed
+  bool decodeBody(const uint8_t* body, size_t length, std::string& line) {
+    if (length < LogFormat::FRAME_HEADER_BYTES || body[4] > (uint8_t)LogLevel::ERROR) {
+      return false;
+    }
+    uint32_t timestampMs = LogFormat::getU32(body);
+    LogLevel level = (LogLevel)body[4];
+    uint32_t componentAddress = LogFormat::getU32(body + 5);
+    uint32_t formatAddress = LogFormat::getU32(body + 9);
+
+    const char* component = strings.lookup(componentAddress);
+    const char* format = strings.lookup(formatAddress);
+    if (!component || !format) {
+      stats.unknownStrings++;
+    }
+
+    char text[MESSAGE_SIZE + 64];
+    size_t used = LogFormat::formatPrefix(text, sizeof(text), timestampMs, level,
+                                          component ? component : "?",
+                                          component ? LogFormat::hashTag(component) : 0);
+    if (format) {
+      LogFormat::FrameArgs args(body + LogFormat::FRAME_HEADER_BYTES, body + length, body[13]);
+      LogFormat::formatMessage(format, args, text + used, MESSAGE_SIZE);
+    } else {
+      snprintf(text + used, MESSAGE_SIZE, "<unknown format 0x%08X, %u args>",
+               (unsigned)formatAddress, (unsigned)body[13]);
+    }
+    line = text;
+    return true;
+  }
+
+  const Stats& getStats() const { return stats; }
+
+private:
+  enum class State { TEXT, SYNC, LENGTH, BODY, CHECK };
+
+  const StringTable& strings;
+  State state;
+  uint8_t body[LogFormat::MAX_FRAME_BODY];
+  size_t bodyLength;
+  size_t received;
+  Stats stats;
+
+  void step(uint8_t byte, std::string& out) {
+    switch (state) {
+      case State::TEXT:
+        if (byte == LogFormat::FRAME_SYNC_0) {
+          state = State::SYNC;
+        } else {
+          out.push_back((char)byte);
+        }
+        break;
+      case State::SYNC:
+        if (byte == LogFormat::FRAME_SYNC_1) {
+          state = State::LENGTH;
+        } else {
+          // Not a frame after all
+          out.push_back((char)LogFormat::FRAME_SYNC_0);
+          state = State::TEXT;
+          step(byte, out);
+        }
+        break;
+      case State::LENGTH:
+        bodyLength = byte;
+        received = 0;
+        state = bodyLength > 0 ? State::BODY : State::CHECK;
+        break;
+      case State::BODY:
+        body[received++] = byte;
+        if (received == bodyLength) {
+          state = State::CHECK;
+        }
+        break;
+      case State::CHECK: {
+        state = State::TEXT;
+        uint8_t check = 0;
+        for (size_t i = 0; i < bodyLength; i++) {
+          check ^= body[i];
+        }
+        std::string line;
+        if (check != byte || !decodeBody(body, bodyLength, line)) {
+          stats.badFrames++;
+          break;
+        }
+        stats.frames++;
+        out += line;
+        out += '\n';
+        break;
+      }
+    }
+  }
+};
+
+}  // namespace LogDecode
@@ -0,0 +1,57 @@
+/**
+ * @file log-decode.cpp
+ * @brief Prints the log lines of a LOG_BINARY_OUTPUT firmware capture.
+ *
+ * Usage: log-decode <firmware.elf> [capture.bin]
+ *
+ * Reads the capture, or stdin when none is given (e.g. piped from the
+ * serial port), and writes the decoded lines to stdout as they arrive.
+ * The ELF must be the image the board is running - string addresses
+ * from any other build decode as "<unknown format ...>".
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "LogDecoder.h"
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "Usage: %s <firmware.elf> [capture.bin]\n", argv[0]);
+    return 2;
+  }
+
+  LogDecode::ElfImage elf;
+  if (!elf.loadFile(argv[1])) {
+    fprintf(stderr, "%s: not a readable 32-bit little-endian ELF\n", argv[1]);
+    return 1;
+  }
+
+  FILE* input = stdin;
+  if (argc == 3) {
+    input = fopen(argv[2], "rb");
+    if (!input) {
+      fprintf(stderr, "%s: cannot open\n", argv[2]);
+      return 1;
+    }
+  }
+
+  LogDecode::Decoder decoder(elf);
+  uint8_t buffer[4096];
+  std::string out;
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), input)) > 0) {
+    out.clear();
+    decoder.feed(buffer, n, out);
+    fwrite(out.data(), 1, out.size(), stdout);
+    fflush(stdout);
+  }
+  if (input != stdin) {
+    fclose(input);
+  }
+
+  const LogDecode::Decoder::Stats& stats = decoder.getStats();
+  fprintf(stderr, "%u frames, %u bad, %u with unknown strings\n",
+          (unsigned)stats.frames, (unsigned)stats.badFrames, (unsigned)stats.unknownStrings);
+  return 0;
+}